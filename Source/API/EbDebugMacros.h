@@ -87,6 +87,7 @@ extern "C" {
 #define DEBUG_STARTUP_MG_SIZE   0
 #define DEBUG_SEGMENT_QP        0
 #define DEBUG_ROI               0
+#define DEBUG_ENCDEC_PARALLEL   0 // Prints the per picture EncDec parallel efficiency
 #ifdef __cplusplus
 }
 #endif // __cplusplus
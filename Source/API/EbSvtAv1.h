@@ -115,6 +115,10 @@ typedef struct EbBufferHeaderType {
     double cb_ssim;
 
     struct SvtMetadataArray *metadata;
+
+    // luma MS-SSIM, reported with luma_ssim when stat_report is enabled.
+    // Added in SVT_AV1_ENC_ABI_VERSION 1, which grew the struct by 8 bytes
+    double luma_ms_ssim;
 } EbBufferHeaderType;
 
 typedef struct EbComponentType {
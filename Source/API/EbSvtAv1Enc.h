@@ -18,6 +18,7 @@ extern "C" {
 
 #include <stdint.h>
 #include "EbSvtAv1.h"
+#include "EbSvtAv1ExtFrameBuf.h"
 #include <stdlib.h>
 #include <stdio.h>
 
@@ -28,7 +29,7 @@ extern "C" {
  * has been modified, and reset anytime the major API version has
  * been changed. Used to keep track if a field has been added or not.
  */
-#define SVT_AV1_ENC_ABI_VERSION 0
+#define SVT_AV1_ENC_ABI_VERSION 1
 
 //***HME***
 
@@ -153,10 +154,46 @@ typedef enum SvtAv1IntraRefreshType {
 typedef enum {
     SVT_AV1_STREAM_INFO_START                = 1,
     SVT_AV1_STREAM_INFO_FIRST_PASS_STATS_OUT = SVT_AV1_STREAM_INFO_START,
+    SVT_AV1_STREAM_INFO_MEMORY_USAGE, // SvtAv1MemoryUsage of the initialized encoder
+    SVT_AV1_STREAM_INFO_FIRST_PASS_STATS_CHUNK, // SvtAv1FixedBuf, first pass stats completed since the previous call
+    SVT_AV1_STREAM_INFO_ME_CACHE_STATS, // SvtAv1MeCacheStats of the encode so far
 
     SVT_AV1_STREAM_INFO_END,
 } SVT_AV1_STREAM_INFO_ID;
 
+/** Subsystems the encoder memory is accounted to
+*/
+typedef enum SvtAv1MemoryCategory {
+    SVT_AV1_MEM_PICTURES, // input pictures, picture control sets and reconstructed pictures
+    SVT_AV1_MEM_REFERENCES, // reference pictures and the reference list
+    SVT_AV1_MEM_LOOKAHEAD, // picture analysis references, motion estimation and TPL buffers
+    SVT_AV1_MEM_MODE_DECISION, // mode decision and encode-decode contexts
+    SVT_AV1_MEM_OTHER, // the other stage contexts, fifos and tables
+    SVT_AV1_MEM_CATEGORIES
+} SvtAv1MemoryCategory;
+
+/** Heap memory allocated while setting up an encoder, in bytes. Frees are not
+ * subtracted, so this is the cumulative allocation of svt_av1_enc_set_parameter()
+ * and svt_av1_enc_init(), temporaries included. The pools are allocated once and
+ * reused for the whole encode, so this bounds the steady state footprint apart
+ * from small per-picture allocations.
+*/
+typedef struct SvtAv1MemoryUsage {
+    uint64_t total;
+    uint64_t category[SVT_AV1_MEM_CATEGORIES];
+} SvtAv1MemoryUsage;
+
+/** Reuse of motion estimation results across the coding loops of the auto
+ * superres search (superres_mode 4 with the dual or full denom search). A loop
+ * that searches a picture at a scaling already searched by an earlier loop
+ * takes the stored results instead of running motion estimation again.
+*/
+typedef struct SvtAv1MeCacheStats {
+    uint64_t hits; // motion estimation passes served from the cache
+    uint64_t misses; // motion estimation passes run again at a new scaling
+    uint64_t peak_bytes; // most memory held by the cached results at once
+} SvtAv1MeCacheStats;
+
 /*!\brief Generic fixed size buffer structure
  *
  * This structure is able to hold a reference to any fixed size buffer.
@@ -166,6 +203,30 @@ typedef struct SvtAv1FixedBuf {
     uint64_t sz; /**< Length of the buffer, in chars */
 } SvtAv1FixedBuf; /**< alias for struct aom_fixed_buf */
 
+/** Versioned first pass stats stream
+ *
+ * A SvtAv1FirstPassStats header followed by one record_size record per frame
+ * in display order and a last record holding the totals. The first pass hands
+ * it out incrementally through SVT_AV1_STREAM_INFO_FIRST_PASS_STATS_CHUNK: the
+ * first chunk starts with the header and every chunk ends on a record, so the
+ * chunks can be appended to a file as they come. A chunk stays valid until the
+ * next call, and the encoder drops the records it has handed out, so
+ * SVT_AV1_STREAM_INFO_FIRST_PASS_STATS_OUT is not available once chunks are
+ * taken. The records are fixed size, so the final pass indexes them in place
+ * and the whole file can be memory mapped as rc_stats_buffer rather than read
+ * into memory. The final pass writes to the records, so map it copy-on-write.
+ * The final pass also accepts the header-less stats of
+ * SVT_AV1_STREAM_INFO_FIRST_PASS_STATS_OUT.
+ */
+#define SVT_AV1_FIRST_PASS_STATS_MAGIC 0x50465653 /* "SVFP" */
+#define SVT_AV1_FIRST_PASS_STATS_VERSION 1
+typedef struct SvtAv1FirstPassStats {
+    uint32_t magic; // SVT_AV1_FIRST_PASS_STATS_MAGIC
+    uint32_t version; // SVT_AV1_FIRST_PASS_STATS_VERSION
+    uint32_t header_size; // bytes before the first record, a multiple of 8
+    uint32_t record_size; // bytes of each record
+} SvtAv1FirstPassStats;
+
 /** Indicates how an S-Frame should be inserted.
 */
 typedef enum EbSFrameMode {
@@ -1085,11 +1146,40 @@ typedef struct EbSvtAv1EncConfiguration {
      */
     double psy_rd;
 
+    /**
+     * @brief Share the cores between the pipeline stages instead of relying on the
+     * per-stage thread counts: every parallel stage gets up to one thread per core and
+     * a thread only runs while it holds one of the cores of a shared pool.
+     * 0: per-stage threads
+     * 1: shared core pool
+     * Default is 0.
+     */
+    uint8_t core_pool;
+
+    /**
+     * @brief Hand the pictures between the pipeline stages through lock-free rings, with
+     * consumers polling briefly before they sleep, instead of the mutex protected queues.
+     * 0: mutex protected queues
+     * 1: lock-free rings
+     * Default is 0.
+     */
+    uint8_t lock_free_queues;
+
+    /**
+     * @brief Memory budget of the encoder in MB, as estimated by svt_av1_enc_estimate_memory().
+     * When the default buffer configuration does not fit, the level of parallelism is lowered
+     * first, then the lookahead mini-gops. If the smallest configuration still does not fit, the
+     * encoder is created with it and a warning.
+     * 0: no budget
+     * Default is 0.
+     */
+    uint32_t max_memory_mb;
+
     /*Add 128 Byte Padding to Struct to avoid changing the size of the public configuration struct*/
 #if CLN_LP_LVLS
-    uint8_t padding[128 - sizeof(Bool) - 2 * sizeof(uint8_t) - sizeof(uint32_t)];
+    uint8_t padding[128 - sizeof(Bool) - 4 * sizeof(uint8_t) - 2 * sizeof(uint32_t)];
 #else
-    uint8_t padding[128 - 3 * sizeof(Bool) - 11 * sizeof(uint8_t) - sizeof(int8_t) - sizeof(double)];
+    uint8_t padding[128 - 3 * sizeof(Bool) - 13 * sizeof(uint8_t) - sizeof(int8_t) - sizeof(double) - sizeof(uint32_t)];
 #endif
 
 } EbSvtAv1EncConfiguration;
@@ -1170,6 +1260,32 @@ EB_API EbErrorType svt_av1_enc_stream_header_release(EbBufferHeaderType *stream_
      * @ *p_buffer           Header pointer, picture buffer. */
 EB_API EbErrorType svt_av1_enc_send_picture(EbComponentType *svt_enc_component, EbBufferHeaderType *p_buffer);
 
+/* OPTIONAL: Borrow an input picture from the encoder pool (zero-copy input).
+     * (*p_buffer)->p_buffer points to an EbSvtIOFormat whose planes are the padded
+     * encoder buffers. Write the visible samples using its strides, fill the other
+     * header fields as usual and pass the header to svt_av1_enc_send_picture(),
+     * which then skips the input copy. The header belongs to the library, it must
+     * not be touched once sent. Pictures borrowed but never sent are returned to
+     * the pool by svt_av1_enc_deinit().
+     * Only 8-bit input is supported, resolution changes on the fly are not.
+     *
+     * Parameter:
+     * @ *svt_enc_component  Encoder handler.
+     * @ **p_buffer          Borrowed picture header. */
+EB_API EbErrorType svt_av1_enc_get_input_buffer(EbComponentType *svt_enc_component, EbBufferHeaderType **p_buffer);
+
+/* OPTIONAL: Set the callback signalling that a picture sent with zero-copy input
+     * went back to the encoder pool. frame_buf->buffer is the luma plane returned by
+     * svt_av1_enc_get_input_buffer(). The callback runs on an encoder thread and
+     * must not call back into the library.
+     *
+     * Parameter:
+     * @ *svt_enc_component  Encoder handler.
+     * @ release_cb          Release callback, NULL to disable.
+     * @ *private_data       Passed back to release_cb. */
+EB_API EbErrorType svt_av1_enc_set_input_release_cb(EbComponentType *svt_enc_component, EbReleaseFrameBuffer release_cb,
+                                                    void *private_data);
+
 /**
  * @brief Step 5: Receive packet.
  * This function will become blocking if either pic_send_done is set to 1 or if we are in low-delay (pred-struct=1).
@@ -1204,6 +1320,16 @@ EB_API EbErrorType svt_av1_get_recon(EbComponentType *svt_enc_component, EbBuffe
      * @ *info         output, the type depends on id */
 EB_API EbErrorType svt_av1_enc_get_stream_info(EbComponentType *svt_enc_component, uint32_t stream_info_id, void *info);
 
+/* OPTIONAL: Estimate the memory svt_av1_enc_init() would allocate for a configuration,
+     * without creating the encoder. The pool sizes are derived exactly as the encoder does,
+     * the per-picture and per-thread buffer sizes are modelled. The thread counts
+     * follow the cores of the calling host unless level_of_parallelism is set.
+     *
+     * Parameter:
+     * @ *config_struct  Encoder configuration, as it would be passed to svt_av1_enc_set_parameter().
+     * @ *usage          output, estimated memory by subsystem. */
+EB_API EbErrorType svt_av1_enc_estimate_memory(const EbSvtAv1EncConfiguration *config_struct, SvtAv1MemoryUsage *usage);
+
 /* STEP 6: Deinitialize encoder library.
      *
      * Parameter:
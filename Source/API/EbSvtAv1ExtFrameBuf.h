@@ -20,7 +20,8 @@ extern "C" {
 
 /*!\brief External frame buffer
  *
- * This structure holds allocated frame buffers used by the decoder.
+ * This structure holds allocated frame buffers used by the decoder. The encoder
+ * uses it to signal the release of zero-copy input pictures.
  */
 typedef struct EbExtFrameBuf {
     /* Pointer to the memory allocates externally for the codec
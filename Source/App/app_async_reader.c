@@ -0,0 +1,309 @@
+/*
+* Copyright (c) 2024, Alliance for Open Media. All rights reserved
+*
+* This source code is subject to the terms of the BSD 2 Clause License and
+* the Alliance for Open Media Patent License 1.0. If the BSD 2 Clause License
+* was not distributed with this source code in the LICENSE file, you can
+* obtain it at https://www.aomedia.org/license/software-license. If the Alliance for Open
+* Media Patent License 1.0 was not distributed with this source code in the
+* PATENTS file, you can obtain it at https://www.aomedia.org/license/patent-license.
+*/
+
+#include "app_async_reader.h"
+
+#ifdef _WIN32
+
+AsyncReader *svt_async_reader_open(int fd, uint64_t data_offset, bool y4m, uint64_t frame_size, uint32_t depth) {
+    (void)fd;
+    (void)data_offset;
+    (void)y4m;
+    (void)frame_size;
+    (void)depth;
+    return NULL;
+}
+const uint8_t *svt_async_reader_next(AsyncReader *reader) {
+    (void)reader;
+    return NULL;
+}
+const char *svt_async_reader_backend(const AsyncReader *reader) {
+    (void)reader;
+    return "none";
+}
+void svt_async_reader_close(AsyncReader *reader) { (void)reader; }
+
+#else
+
+#include <errno.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#ifdef LIBURING_FOUND
+#include <liburing.h>
+#endif
+
+#define ASYNC_READ_MAX_WORKERS 4
+#define Y4M_FRAME_HDR_MAX 256
+
+typedef enum AsyncSlotState {
+    ASYNC_SLOT_IDLE,
+    ASYNC_SLOT_PENDING, // queued, not yet picked up by a worker
+    ASYNC_SLOT_BUSY, // read in progress
+    ASYNC_SLOT_READY,
+    ASYNC_SLOT_ERROR,
+} AsyncSlotState;
+
+typedef struct AsyncSlot {
+    uint8_t       *buf;
+    uint64_t       frame; // frame number in the output order
+    uint64_t       offset; // file offset of the frame data
+    uint64_t       done; // bytes read so far
+    AsyncSlotState state;
+} AsyncSlot;
+
+struct AsyncReader {
+    int        fd;
+    uint64_t   data_offset;
+    uint64_t   frame_hdr;
+    uint64_t   frame_size;
+    uint64_t   frames_in_file;
+    uint32_t   depth;
+    AsyncSlot *slots;
+    uint64_t   next_frame; // next frame handed to the caller
+#ifdef LIBURING_FOUND
+    bool            use_uring;
+    struct io_uring ring;
+    uint32_t        in_flight;
+#endif
+    // thread pool fallback
+    pthread_t       workers[ASYNC_READ_MAX_WORKERS];
+    uint32_t        num_workers;
+    pthread_mutex_t mutex;
+    pthread_cond_t  cond;
+    uint64_t        next_job; // next frame to be picked up by a worker
+    bool            quit;
+};
+
+static bool read_full(int fd, uint8_t *buf, uint64_t size, uint64_t offset) {
+    while (size) {
+        const ssize_t ret = pread(fd, buf, size, (off_t)offset);
+        if (ret < 0 && errno == EINTR)
+            continue;
+        if (ret <= 0)
+            return false;
+        buf += ret;
+        offset += ret;
+        size -= ret;
+    }
+    return true;
+}
+
+static void *async_reader_worker(void *arg) {
+    AsyncReader *r = (AsyncReader *)arg;
+
+    pthread_mutex_lock(&r->mutex);
+    for (;;) {
+        AsyncSlot *slot = &r->slots[r->next_job % r->depth];
+        while (!r->quit && !(slot->state == ASYNC_SLOT_PENDING && slot->frame == r->next_job)) {
+            pthread_cond_wait(&r->cond, &r->mutex);
+            slot = &r->slots[r->next_job % r->depth];
+        }
+        if (r->quit)
+            break;
+        slot->state = ASYNC_SLOT_BUSY;
+        r->next_job++;
+        pthread_mutex_unlock(&r->mutex);
+
+        const bool ok = read_full(r->fd, slot->buf, r->frame_size, slot->offset);
+
+        pthread_mutex_lock(&r->mutex);
+        slot->state = ok ? ASYNC_SLOT_READY : ASYNC_SLOT_ERROR;
+        pthread_cond_broadcast(&r->cond);
+    }
+    pthread_mutex_unlock(&r->mutex);
+    return NULL;
+}
+
+#ifdef LIBURING_FOUND
+static bool uring_submit(AsyncReader *r, AsyncSlot *slot) {
+    struct io_uring_sqe *sqe = io_uring_get_sqe(&r->ring);
+    if (!sqe)
+        return false;
+    io_uring_prep_read(
+        sqe, r->fd, slot->buf + slot->done, (unsigned)(r->frame_size - slot->done), slot->offset + slot->done);
+    io_uring_sqe_set_data(sqe, slot);
+    if (io_uring_submit(&r->ring) < 0)
+        return false;
+    r->in_flight++;
+    return true;
+}
+
+/* Reaps one completion, short reads are resubmitted for the remainder */
+static bool uring_reap(AsyncReader *r) {
+    struct io_uring_cqe *cqe;
+    int                  ret;
+    while ((ret = io_uring_wait_cqe(&r->ring, &cqe)) == -EINTR) {}
+    if (ret < 0)
+        return false;
+    AsyncSlot *slot = (AsyncSlot *)io_uring_cqe_get_data(cqe);
+    const int  res  = cqe->res;
+    io_uring_cqe_seen(&r->ring, cqe);
+    r->in_flight--;
+
+    if (res <= 0)
+        slot->state = ASYNC_SLOT_ERROR;
+    else if ((slot->done += res) == r->frame_size)
+        slot->state = ASYNC_SLOT_READY;
+    else if (!uring_submit(r, slot))
+        slot->state = ASYNC_SLOT_ERROR;
+    return true;
+}
+#endif
+
+static void async_reader_request(AsyncReader *r, uint64_t frame) {
+    AsyncSlot *slot = &r->slots[frame % r->depth];
+    slot->frame     = frame;
+    slot->offset    = r->data_offset + (frame % r->frames_in_file) * (r->frame_hdr + r->frame_size) + r->frame_hdr;
+    slot->done      = 0;
+#ifdef LIBURING_FOUND
+    if (r->use_uring) {
+        slot->state = uring_submit(r, slot) ? ASYNC_SLOT_BUSY : ASYNC_SLOT_ERROR;
+        return;
+    }
+#endif
+    pthread_mutex_lock(&r->mutex);
+    slot->state = ASYNC_SLOT_PENDING;
+    pthread_cond_broadcast(&r->cond);
+    pthread_mutex_unlock(&r->mutex);
+}
+
+AsyncReader *svt_async_reader_open(int fd, uint64_t data_offset, bool y4m, uint64_t frame_size, uint32_t depth) {
+    struct stat st;
+    if (!frame_size || !depth || fstat(fd, &st) || !S_ISREG(st.st_mode))
+        return NULL;
+
+    uint64_t frame_hdr = 0;
+    if (y4m) {
+        char hdr[Y4M_FRAME_HDR_MAX];
+        if (pread(fd, hdr, sizeof(hdr), (off_t)data_offset) < (ssize_t)sizeof("FRAME") ||
+            strncmp(hdr, "FRAME", sizeof("FRAME") - 1))
+            return NULL;
+        const char *eol = memchr(hdr, '\n', sizeof(hdr));
+        if (!eol)
+            return NULL;
+        frame_hdr = eol - hdr + 1;
+    }
+    if ((uint64_t)st.st_size < data_offset)
+        return NULL;
+    const uint64_t frames_in_file = ((uint64_t)st.st_size - data_offset) / (frame_hdr + frame_size);
+    if (!frames_in_file)
+        return NULL;
+
+    AsyncReader *r = calloc(1, sizeof(*r));
+    if (!r)
+        return NULL;
+    r->fd             = fd;
+    r->data_offset    = data_offset;
+    r->frame_hdr      = frame_hdr;
+    r->frame_size     = frame_size;
+    r->frames_in_file = frames_in_file;
+    r->depth          = depth > ASYNC_READ_MAX_DEPTH ? ASYNC_READ_MAX_DEPTH : depth;
+    r->slots          = calloc(r->depth, sizeof(*r->slots));
+    if (!r->slots) {
+        free(r);
+        return NULL;
+    }
+    for (uint32_t i = 0; i < r->depth; i++) {
+        r->slots[i].buf = malloc(frame_size);
+        if (!r->slots[i].buf) {
+            svt_async_reader_close(r);
+            return NULL;
+        }
+    }
+#if defined(__linux__)
+    posix_fadvise(fd, 0, 0, POSIX_FADV_SEQUENTIAL);
+#endif
+
+#ifdef LIBURING_FOUND
+    r->use_uring = io_uring_queue_init(r->depth, &r->ring, 0) == 0;
+    if (!r->use_uring)
+#endif
+    {
+        pthread_mutex_init(&r->mutex, NULL);
+        pthread_cond_init(&r->cond, NULL);
+        const uint32_t num_workers = r->depth < ASYNC_READ_MAX_WORKERS ? r->depth : ASYNC_READ_MAX_WORKERS;
+        for (; r->num_workers < num_workers; r->num_workers++) {
+            if (pthread_create(&r->workers[r->num_workers], NULL, async_reader_worker, r))
+                break;
+        }
+        if (!r->num_workers) {
+            svt_async_reader_close(r);
+            return NULL;
+        }
+    }
+
+    for (uint32_t i = 0; i < r->depth; i++) async_reader_request(r, i);
+    return r;
+}
+
+const uint8_t *svt_async_reader_next(AsyncReader *r) {
+    // the previous frame has been consumed, reuse its slot for the frame `depth` ahead
+    if (r->next_frame)
+        async_reader_request(r, r->next_frame - 1 + r->depth);
+
+    AsyncSlot *slot = &r->slots[r->next_frame % r->depth];
+#ifdef LIBURING_FOUND
+    if (r->use_uring) {
+        while (slot->state == ASYNC_SLOT_BUSY)
+            if (!uring_reap(r))
+                return NULL;
+    } else
+#endif
+    {
+        pthread_mutex_lock(&r->mutex);
+        while (slot->state == ASYNC_SLOT_PENDING || slot->state == ASYNC_SLOT_BUSY)
+            pthread_cond_wait(&r->cond, &r->mutex);
+        pthread_mutex_unlock(&r->mutex);
+    }
+    if (slot->state != ASYNC_SLOT_READY)
+        return NULL;
+    r->next_frame++;
+    return slot->buf;
+}
+
+const char *svt_async_reader_backend(const AsyncReader *r) {
+#ifdef LIBURING_FOUND
+    if (r->use_uring)
+        return "io_uring";
+#endif
+    (void)r;
+    return "threads";
+}
+
+void svt_async_reader_close(AsyncReader *r) {
+    if (!r)
+        return;
+#ifdef LIBURING_FOUND
+    if (r->use_uring) {
+        // buffers must outlive the reads still owned by the kernel
+        while (r->in_flight && uring_reap(r)) {}
+        io_uring_queue_exit(&r->ring);
+    }
+#endif
+    if (r->num_workers) {
+        pthread_mutex_lock(&r->mutex);
+        r->quit = true;
+        pthread_cond_broadcast(&r->cond);
+        pthread_mutex_unlock(&r->mutex);
+        for (uint32_t i = 0; i < r->num_workers; i++) pthread_join(r->workers[i], NULL);
+        pthread_mutex_destroy(&r->mutex);
+        pthread_cond_destroy(&r->cond);
+    }
+    for (uint32_t i = 0; i < r->depth; i++) free(r->slots[i].buf);
+    free(r->slots);
+    free(r);
+}
+
+#endif // _WIN32
@@ -0,0 +1,37 @@
+/*
+* Copyright (c) 2024, Alliance for Open Media. All rights reserved
+*
+* This source code is subject to the terms of the BSD 2 Clause License and
+* the Alliance for Open Media Patent License 1.0. If the BSD 2 Clause License
+* was not distributed with this source code in the LICENSE file, you can
+* obtain it at https://www.aomedia.org/license/software-license. If the Alliance for Open
+* Media Patent License 1.0 was not distributed with this source code in the
+* PATENTS file, you can obtain it at https://www.aomedia.org/license/patent-license.
+*/
+
+#ifndef EbAppAsyncReader_h
+#define EbAppAsyncReader_h
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#define ASYNC_READ_MAX_DEPTH 64
+
+/*
+ * Read-ahead reader for fixed size frames of a seekable input file. Keeps `depth` frames in
+ * flight, using io_uring when built with liburing and a pool of reader threads otherwise.
+ */
+typedef struct AsyncReader AsyncReader;
+
+/*
+ * data_offset is the start of the first frame (after the y4m stream header). When y4m is set, the
+ * size of the per-frame "FRAME" delimiter is taken from the first frame and assumed constant.
+ * Returns NULL when the file cannot be read that way, the caller then keeps the synchronous reader.
+ */
+AsyncReader *svt_async_reader_open(int fd, uint64_t data_offset, bool y4m, uint64_t frame_size, uint32_t depth);
+/* Returns the next frame, valid until the following call. Loops back to the first frame at the end of the file */
+const uint8_t *svt_async_reader_next(AsyncReader *reader);
+const char    *svt_async_reader_backend(const AsyncReader *reader);
+void           svt_async_reader_close(AsyncReader *reader);
+
+#endif // EbAppAsyncReader_h
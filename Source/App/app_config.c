@@ -26,6 +26,7 @@
 #else
 #include <unistd.h>
 #include <sys/file.h>
+#include <sys/mman.h>
 #endif
 
 #include "app_output_ivf.h"
@@ -58,6 +59,7 @@
 #define HEIGHT_TOKEN "-h"
 #define NUMBER_OF_PICTURES_TOKEN "-n"
 #define BUFFERED_INPUT_TOKEN "--nb"
+#define ASYNC_READ_TOKEN "--async-read"
 #define NO_PROGRESS_TOKEN "--no-progress" // tbd if it should be removed
 #define PROGRESS_TOKEN "--progress"
 #define QP_TOKEN "-q"
@@ -143,6 +145,9 @@
 #define THREAD_MGMNT "--lp"
 #define PIN_TOKEN "--pin"
 #define TARGET_SOCKET "--ss"
+#define CORE_POOL_TOKEN "--core-pool"
+#define LOCK_FREE_QUEUES_TOKEN "--lock-free-queues"
+#define MAX_MEMORY_TOKEN "--max-memory-mb"
 #define RESTRICTED_MOTION_VECTOR "--rmv"
 
 //double dash
@@ -483,6 +488,9 @@ static EbErrorType set_cfg_frames_to_be_skipped(EbConfig *cfg, const char *token
 static EbErrorType set_buffered_input(EbConfig *cfg, const char *token, const char *value) {
     return str_to_int(token, value, &cfg->buffered_input);
 }
+static EbErrorType set_async_read(EbConfig *cfg, const char *token, const char *value) {
+    return str_to_int(token, value, &cfg->async_read);
+}
 static EbErrorType set_cfg_force_key_frames(EbConfig *cfg, const char *token, const char *value) {
     (void)token;
     struct forced_key_frames fkf;
@@ -778,6 +786,11 @@ ConfigEntry config_entry_global_options[] = {
      "Buffer `n` input frames into memory and use them to encode, default is -1 [-1: no frames "
      "buffered, 1-`(2^31)-1`]",
      set_buffered_input},
+    {SINGLE_INPUT,
+     ASYNC_READ_TOKEN,
+     "Read `n` input frames ahead on background threads (io_uring when available) instead of "
+     "reading on the encoding thread, seekable files only, default is 0 [0: off, 1-64]",
+     set_async_read},
     {SINGLE_INPUT,
      ENCODER_COLOR_FORMAT,
      "Color format, only yuv420 is supported at this time, default is 1 [0: yuv400, 1: yuv420, 2: "
@@ -849,6 +862,21 @@ ConfigEntry config_entry_global_options[] = {
      "Specifies which socket to run on, assumes a max of two sockets. Refer to Appendix A.1 of the "
      "user guide, default is -1 [-1, 0, -1]",
      set_cfg_generic_token},
+    {SINGLE_INPUT,
+     CORE_POOL_TOKEN,
+     "Share --lp cores between all pipeline stages, running more stage threads than cores so idle stages "
+     "hand their core to busy ones, default is 0 [0-1]",
+     set_cfg_generic_token},
+    {SINGLE_INPUT,
+     LOCK_FREE_QUEUES_TOKEN,
+     "Pass the pictures between pipeline stages through lock-free queues instead of mutex protected ones, "
+     "default is 0 [0-1]",
+     set_cfg_generic_token},
+    {SINGLE_INPUT,
+     MAX_MEMORY_TOKEN,
+     "Memory budget in MB, lowers the parallelism then the lookahead until the estimated encoder memory "
+     "fits, default is 0 (no budget) [0-4294967295]",
+     set_cfg_generic_token},
     // Termination
     {SINGLE_INPUT, NULL, NULL, NULL}};
 
@@ -1355,6 +1383,7 @@ ConfigEntry config_entry[] = {
     {SINGLE_INPUT, NUMBER_OF_PICTURES_TOKEN, "FrameToBeEncoded", set_cfg_frames_to_be_encoded},
     {SINGLE_INPUT, NUMBER_OF_PICTURES_LONG_TOKEN, "FrameToBeEncoded", set_cfg_frames_to_be_encoded},
     {SINGLE_INPUT, BUFFERED_INPUT_TOKEN, "BufferedInput", set_buffered_input},
+    {SINGLE_INPUT, ASYNC_READ_TOKEN, "AsyncRead", set_async_read},
 
     {SINGLE_INPUT, NUMBER_OF_PICTURES_TO_SKIP, "FrameToBeSkipped", set_cfg_frames_to_be_skipped},
 
@@ -1386,6 +1415,9 @@ ConfigEntry config_entry[] = {
     {SINGLE_INPUT, THREAD_MGMNT, "LogicalProcessors", set_cfg_generic_token},
     {SINGLE_INPUT, PIN_TOKEN, "PinnedExecution", set_cfg_generic_token},
     {SINGLE_INPUT, TARGET_SOCKET, "TargetSocket", set_cfg_generic_token},
+    {SINGLE_INPUT, CORE_POOL_TOKEN, "CorePool", set_cfg_generic_token},
+    {SINGLE_INPUT, LOCK_FREE_QUEUES_TOKEN, "LockFreeQueues", set_cfg_generic_token},
+    {SINGLE_INPUT, MAX_MEMORY_TOKEN, "MaxMemoryMb", set_cfg_generic_token},
 
     // Rate Control Options
     {SINGLE_INPUT, RATE_CONTROL_ENABLE_TOKEN, "RateControlMode", set_cfg_generic_token},
@@ -1616,6 +1648,21 @@ void svt_config_dtor(EbConfig *app_cfg) {
         app_cfg->output_stat_file = (FILE *)NULL;
     }
 
+    if (app_cfg->stats_in_mapped) {
+#ifdef _WIN32
+        UnmapViewOfFile(app_cfg->stats_in.buf);
+#else
+        munmap(app_cfg->stats_in.buf, app_cfg->stats_in.sz);
+#endif
+    } else
+        free(app_cfg->stats_in.buf);
+    app_cfg->stats_in.buf = NULL;
+
+    if (app_cfg->input_stat_file) {
+        fclose(app_cfg->input_stat_file);
+        app_cfg->input_stat_file = (FILE *)NULL;
+    }
+
     if (app_cfg->roi_map_file) {
         fclose(app_cfg->roi_map_file);
         app_cfg->roi_map_file = (FILE *)NULL;
@@ -1819,7 +1866,8 @@ static EbErrorType read_config_file(EbConfig *app_cfg, const char *config_path,
     return return_error;
 }
 
-/* get config->rc_stats_buffer from config->input_stat_file */
+/* get config->rc_stats_buffer from config->input_stat_file, the library indexes the records in
+ * place so the file is mapped copy-on-write rather than read into memory when possible */
 Bool load_twopass_stats_in(EbConfig *cfg) {
     EbSvtAv1EncConfiguration *config = &cfg->config;
 #ifdef _WIN32
@@ -1831,21 +1879,42 @@ Bool load_twopass_stats_in(EbConfig *cfg) {
     struct stat file_stat;
     int         ret         = fstat(fd, &file_stat);
 #endif
-    if (ret) {
+    if (ret || file_stat.st_size == 0) {
         return FALSE;
     }
-    config->rc_stats_buffer.buf = malloc(file_stat.st_size);
-    if (config->rc_stats_buffer.buf) {
-        config->rc_stats_buffer.sz = (uint64_t)file_stat.st_size;
-        if (fread(config->rc_stats_buffer.buf, 1, file_stat.st_size, cfg->input_stat_file) !=
-            (size_t)file_stat.st_size) {
-            return FALSE;
-        }
-        if (file_stat.st_size == 0) {
+    cfg->stats_in.sz = (uint64_t)file_stat.st_size;
+#ifdef _WIN32
+    HANDLE map = CreateFileMapping(get_file_handle(cfg->input_stat_file), NULL, PAGE_WRITECOPY, 0, 0, NULL);
+    if (map) {
+        cfg->stats_in.buf = MapViewOfFile(map, FILE_MAP_COPY, 0, 0, 0);
+        CloseHandle(map);
+    }
+#else
+    cfg->stats_in.buf = mmap(NULL, file_stat.st_size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+    if (cfg->stats_in.buf == MAP_FAILED)
+        cfg->stats_in.buf = NULL;
+#endif
+    cfg->stats_in_mapped = cfg->stats_in.buf != NULL;
+    if (!cfg->stats_in.buf) {
+        cfg->stats_in.buf = malloc(file_stat.st_size);
+        if (!cfg->stats_in.buf ||
+            fread(cfg->stats_in.buf, 1, file_stat.st_size, cfg->input_stat_file) != (size_t)file_stat.st_size) {
             return FALSE;
         }
     }
-    return config->rc_stats_buffer.buf != NULL;
+    config->rc_stats_buffer = cfg->stats_in;
+    return TRUE;
+}
+static EbErrorType open_stats_in(EbConfig *app_cfg, const char *stats, uint32_t channel_number) {
+    if (!fopen_and_lock(&app_cfg->input_stat_file, stats, FALSE)) {
+        fprintf(app_cfg->error_log_file, "Error instance %u: can't read stats file %s for read\n", channel_number + 1, stats);
+        return EB_ErrorBadParameter;
+    }
+    if (!load_twopass_stats_in(app_cfg)) {
+        fprintf(app_cfg->error_log_file, "Error instance %u: can't load file %s\n", channel_number + 1, stats);
+        return EB_ErrorBadParameter;
+    }
+    return EB_ErrorNone;
 }
 EbErrorType handle_stats_file(EbConfig *app_cfg, EncPass enc_pass, const SvtAv1FixedBuf *rc_stats_buffer,
                               uint32_t channel_number) {
@@ -1862,19 +1931,8 @@ EbErrorType handle_stats_file(EbConfig *app_cfg, EncPass enc_pass, const SvtAv1F
             }
         }
         // Final pass
-        else if (app_cfg->config.pass == 2) {
-            if (!fopen_and_lock(&app_cfg->input_stat_file, stats, FALSE)) {
-                fprintf(app_cfg->error_log_file,
-                        "Error instance %u: can't read stats file %s for read\n",
-                        channel_number + 1,
-                        stats);
-                return EB_ErrorBadParameter;
-            }
-            if (!load_twopass_stats_in(app_cfg)) {
-                fprintf(app_cfg->error_log_file, "Error instance %u: can't load file %s\n", channel_number + 1, stats);
-                return EB_ErrorBadParameter;
-            }
-        }
+        else if (app_cfg->config.pass == 2)
+            return open_stats_in(app_cfg, stats, channel_number);
         break;
     }
 
@@ -1893,6 +1951,9 @@ EbErrorType handle_stats_file(EbConfig *app_cfg, EncPass enc_pass, const SvtAv1F
         break;
     }
     case ENC_SECOND_PASS: {
+        // the first pass wrote the stats file out, map it rather than keeping a copy
+        if (app_cfg->stats)
+            return open_stats_in(app_cfg, app_cfg->stats, channel_number);
         if (!rc_stats_buffer->sz) {
             fprintf(app_cfg->error_log_file,
                     "Error instance %u: combined multi passes need stats in for the final pass \n",
@@ -1949,6 +2010,14 @@ static EbErrorType app_verify_config(EbConfig *app_cfg, uint32_t channel_number)
         return_error = EB_ErrorBadParameter;
     }
 
+    if (app_cfg->async_read < 0 || app_cfg->async_read > ASYNC_READ_MAX_DEPTH) {
+        fprintf(app_cfg->error_log_file,
+                "Error instance %u: Invalid async_read. async_read must be in the range [0 - %d]\n",
+                channel_number + 1,
+                ASYNC_READ_MAX_DEPTH);
+        return_error = EB_ErrorBadParameter;
+    }
+
     if (app_cfg->buffered_input > app_cfg->frames_to_be_encoded) {
         fprintf(app_cfg->error_log_file,
                 "Error instance %u: Invalid buffered_input. buffered_input must be less or equal "
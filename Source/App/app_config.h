@@ -22,6 +22,7 @@
 #endif
 
 #include "EbSvtAv1Enc.h"
+#include "app_async_reader.h"
 
 #ifdef _WIN32
 #define WIN32_LEAN_AND_MEAN
@@ -93,6 +94,7 @@ typedef struct EbPerformanceContext {
     double sum_luma_ssim;
     double sum_cr_ssim;
     double sum_cb_ssim;
+    double sum_luma_ms_ssim;
 
     uint64_t sum_qp;
 
@@ -136,6 +138,8 @@ typedef struct EbConfig {
     const char *stats;
     FILE       *input_stat_file;
     FILE       *output_stat_file;
+    SvtAv1FixedBuf stats_in; // contents of input_stat_file
+    Bool        stats_in_mapped; // stats_in maps input_stat_file rather than holding a copy
     Bool        y4m_input;
     char        y4m_buf[9];
 
@@ -156,6 +160,9 @@ typedef struct EbConfig {
     int32_t   frames_encoded;
     int32_t   buffered_input;
     uint8_t **sequence_buffer;
+    // frames read ahead by async_reader, reset to 0 when falling back to the synchronous readers
+    int32_t      async_read;
+    AsyncReader *async_reader;
 
     uint32_t injector_frame_rate;
     uint32_t injector;
@@ -218,6 +225,7 @@ typedef enum MultiPassModes {
 
 typedef struct EncApp {
     SvtAv1FixedBuf rc_twopasses_stats;
+    uint64_t       rc_twopasses_stats_capability;
 } EncApp;
 EbConfig *svt_config_ctor();
 void      svt_config_dtor(EbConfig *app_cfg);
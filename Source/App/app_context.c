@@ -92,7 +92,7 @@ static EbErrorType allocate_input_buffers(EbConfig *app_cfg) {
         return EB_ErrorInsufficientResources;
 
     // Allocate frame buffer for the p_buffer
-    if (app_cfg->buffered_input == -1 && !app_cfg->mmap.enable &&
+    if (app_cfg->buffered_input == -1 && !app_cfg->mmap.enable && !app_cfg->async_read &&
         allocate_frame_buffer(app_cfg, p_buffer) != EB_ErrorNone) {
         free(p_buffer);
         free(app_cfg->input_buffer_pool);
@@ -368,7 +368,7 @@ fail:
 static void deallocate_buffers(EbConfig *app_cfg) {
     // Deallocate input buffers
     if (app_cfg->input_buffer_pool) {
-        if (app_cfg->buffered_input == -1 && !app_cfg->mmap.enable) {
+        if (app_cfg->buffered_input == -1 && !app_cfg->mmap.enable && !app_cfg->async_read) {
             EbSvtIOFormat *input_ptr = (EbSvtIOFormat *)app_cfg->input_buffer_pool->p_buffer;
             if (input_ptr) {
                 free(input_ptr->luma);
@@ -98,9 +98,44 @@ typedef struct EncContext {
     int32_t    total_frames;
 } EncContext;
 
+// initialize the read-ahead reader, falls back to the other readers when the input does not allow it
+static void init_async_reader(EbConfig* app_cfg) {
+    app_cfg->async_reader = NULL;
+    if (!app_cfg->async_read)
+        return;
+    const uint8_t color_format  = app_cfg->config.encoder_color_format;
+    const uint8_t subsampling_x = (color_format == EB_YUV444 ? 1 : 2) - 1;
+    const uint8_t subsampling_y = ((color_format == EB_YUV444 || color_format == EB_YUV422) ? 1 : 2) - 1;
+    const uint64_t chroma_width  = (app_cfg->input_padded_width + subsampling_x) >> subsampling_x;
+    const uint64_t chroma_height = (app_cfg->input_padded_height + subsampling_y) >> subsampling_y;
+    const uint64_t frame_size    = ((uint64_t)app_cfg->input_padded_width * app_cfg->input_padded_height +
+                                 2 * chroma_width * chroma_height)
+        << (app_cfg->config.encoder_bit_depth > 8);
+#ifdef _WIN32
+    const int fd = _fileno(app_cfg->input_file);
+#else
+    const int fd = fileno(app_cfg->input_file);
+#endif
+    // pipes and preloaded inputs keep their readers
+    if (app_cfg->buffered_input == -1 && !app_cfg->input_file_is_fifo && app_cfg->input_file != stdin)
+        app_cfg->async_reader = svt_async_reader_open(
+            fd, app_cfg->mmap.y4m_seq_hdr, app_cfg->y4m_input, frame_size, (uint32_t)app_cfg->async_read);
+    if (!app_cfg->async_reader) {
+        fputs("[SVT-Warning]: Asynchronous read-ahead is not available for this input, reading synchronously\n",
+              stderr);
+        app_cfg->async_read = 0;
+    }
+}
+
+static void deinit_async_reader(EbConfig* app_cfg) {
+    svt_async_reader_close(app_cfg->async_reader);
+    app_cfg->async_reader = NULL;
+}
+
 //initilize memory mapped file handler
 static void init_memory_file_map(EbConfig* app_cfg) {
-    app_cfg->mmap.enable = app_cfg->buffered_input == -1 && !app_cfg->input_file_is_fifo;
+    app_cfg->mmap.enable = app_cfg->buffered_input == -1 && !app_cfg->input_file_is_fifo &&
+        !app_cfg->async_reader;
 
     if (!app_cfg->mmap.enable)
         return;
@@ -224,6 +259,7 @@ static EbErrorType enc_context_ctor(EncApp* enc_app, EncContext* enc_context, in
                       sizeof(forced_keyframes->frames[0]),
                       compar_uint64);
             }
+            init_async_reader(app_cfg);
             init_memory_file_map(app_cfg);
             init_reader(app_cfg);
 
@@ -249,6 +285,7 @@ static void enc_context_dctor(EncContext* enc_context) {
     for (int32_t inst_cnt = enc_context->num_channels - 1; inst_cnt >= 0; --inst_cnt) {
         EncChannel* c = enc_context->channels + inst_cnt;
         deinit_memory_file_map(c->app_cfg);
+        deinit_async_reader(c->app_cfg);
         enc_channel_dctor(c, inst_cnt);
     }
 
@@ -288,12 +325,12 @@ static void print_summary(const EncContext* const enc_context) {
                 fprintf(app_cfg->stat_file,
                         "Total Frames\tAverage QP  \tY-PSNR   \tU-PSNR   "
                         "\tV-PSNR\t\t| \tY-PSNR   \tU-PSNR   \tV-PSNR   \t|"
-                        "\tY-SSIM   \tU-SSIM   \tV-SSIM   "
+                        "\tY-SSIM   \tU-SSIM   \tV-SSIM   \tY-MS-SSIM"
                         "\t|\tBitrate\n");
                 fprintf(app_cfg->stat_file,
                         "%10ld  \t   %2.2f    \t%3.2f dB\t%3.2f dB\t%3.2f dB  "
                         "\t|\t%3.2f dB\t%3.2f dB\t%3.2f dB \t|\t%1.5f \t%1.5f "
-                        "\t%1.5f\t\t|\t%.2f kbps\n",
+                        "\t%1.5f \t%1.5f\t|\t%.2f kbps\n",
                         (long int)frame_count,
                         (float)app_cfg->performance_context.sum_qp / frame_count,
                         (float)app_cfg->performance_context.sum_luma_psnr / frame_count,
@@ -305,6 +342,7 @@ static void print_summary(const EncContext* const enc_context) {
                         (float)app_cfg->performance_context.sum_luma_ssim / frame_count,
                         (float)app_cfg->performance_context.sum_cb_ssim / frame_count,
                         (float)app_cfg->performance_context.sum_cr_ssim / frame_count,
+                        (float)app_cfg->performance_context.sum_luma_ms_ssim / frame_count,
                         ((double)(app_cfg->performance_context.byte_count << 3) * frame_rate /
                          (app_cfg->frames_encoded * 1000)));
             }
@@ -330,10 +368,10 @@ static void print_summary(const EncContext* const enc_context) {
                 fprintf(stderr,
                         "Average "
                         "QP\tY-PSNR\t\tU-PSNR\t\tV-PSNR\t\t|\tY-PSNR\t\tU-"
-                        "PSNR\t\tV-PSNR\t\t|\tY-SSIM\tU-SSIM\tV-SSIM\n");
+                        "PSNR\t\tV-PSNR\t\t|\tY-SSIM\tU-SSIM\tV-SSIM\tY-MS-SSIM\n");
                 fprintf(stderr,
                         "%11.2f\t%4.2f dB\t%4.2f dB\t%4.2f dB\t|\t%4.2f "
-                        "dB\t%4.2f dB\t%4.2f dB\t|\t%1.5f\t%1.5f\t%1.5f\n",
+                        "dB\t%4.2f dB\t%4.2f dB\t|\t%1.5f\t%1.5f\t%1.5f\t%1.5f\n",
                         (float)app_cfg->performance_context.sum_qp / frame_count,
                         (float)app_cfg->performance_context.sum_luma_psnr / frame_count,
                         (float)app_cfg->performance_context.sum_cb_psnr / frame_count,
@@ -343,7 +381,8 @@ static void print_summary(const EncContext* const enc_context) {
                         (float)(get_psnr((app_cfg->performance_context.sum_cr_sse / frame_count), max_chroma_sse)),
                         (float)app_cfg->performance_context.sum_luma_ssim / frame_count,
                         (float)app_cfg->performance_context.sum_cb_ssim / frame_count,
-                        (float)app_cfg->performance_context.sum_cr_ssim / frame_count);
+                        (float)app_cfg->performance_context.sum_cr_ssim / frame_count,
+                        (float)app_cfg->performance_context.sum_luma_ms_ssim / frame_count);
             }
 
             fflush(stdout);
@@ -478,6 +517,11 @@ static EbErrorType encode(EncApp* enc_app, EncContext* enc_context) {
     }
     print_summary(enc_context);
     print_performance(enc_context);
+    // a failed channel fails the pass, so a second pass never runs on partial stats
+    for (uint32_t inst_cnt = 0; inst_cnt < num_channels; ++inst_cnt) {
+        if (enc_context->channels[inst_cnt].exit_cond & APP_ExitConditionError)
+            return_error = EB_ErrorUndefined;
+    }
     return return_error;
 }
 
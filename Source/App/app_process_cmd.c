@@ -18,6 +18,7 @@
 #include <string.h>
 #include <math.h>
 #include <ctype.h>
+#include <inttypes.h>
 #if defined(LIBDOVI_FOUND) || defined(LIBHDR10PLUS_RS_FOUND)
 #include "EbSvtAv1Metadata.h"
 #endif
@@ -761,9 +762,44 @@ static void buffered_read_input_frames(EbConfig *app_cfg, uint8_t is_16bit, EbBu
     header_ptr->n_filled_len = (uint32_t)(luma_size + 2 * chroma_size);
 }
 
+static void async_read_input_frames(EbConfig *app_cfg, uint8_t is_16bit, EbBufferHeaderType *header_ptr) {
+    const uint32_t input_padded_width  = app_cfg->input_padded_width;
+    const uint32_t input_padded_height = app_cfg->input_padded_height;
+    EbSvtIOFormat *input_ptr           = (EbSvtIOFormat *)header_ptr->p_buffer;
+
+    const uint8_t color_format  = app_cfg->config.encoder_color_format;
+    const uint8_t subsampling_x = (color_format == EB_YUV444 ? 1 : 2) - 1;
+    const uint8_t subsampling_y = ((color_format == EB_YUV444 || color_format == EB_YUV422) ? 1 : 2) - 1;
+    const uint64_t chroma_width = (app_cfg->input_padded_width + subsampling_x) >> subsampling_x;
+    const uint64_t chroma_height = (app_cfg->input_padded_height + subsampling_y) >> subsampling_y;
+
+    input_ptr->y_stride  = input_padded_width;
+    input_ptr->cr_stride = chroma_width;
+    input_ptr->cb_stride = chroma_width;
+
+    const size_t luma_size   = ((size_t)input_padded_width * input_padded_height) << is_16bit;
+    const size_t chroma_size = chroma_width * chroma_height << is_16bit;
+
+    // the frame stays valid until the next call, svt_av1_enc_send_picture() copies it before that
+    uint8_t *base = (uint8_t *)svt_async_reader_next(app_cfg->async_reader);
+    if (!base) {
+        fprintf(app_cfg->error_log_file, "Error: failed to read frame %" PRIu64 "\n", app_cfg->processed_frame_count);
+        header_ptr->n_filled_len = 0;
+        app_cfg->stop_encoder    = TRUE;
+        return;
+    }
+    input_ptr->luma = base;
+    input_ptr->cb   = base + luma_size;
+    input_ptr->cr   = base + luma_size + chroma_size;
+
+    header_ptr->n_filled_len = (uint32_t)(luma_size + 2 * chroma_size);
+}
+
 void init_reader(EbConfig *app_cfg) {
     if (app_cfg->buffered_input != -1) {
         read_input = buffered_read_input_frames;
+    } else if (app_cfg->async_reader) {
+        read_input = async_read_input_frames;
     } else if (app_cfg->mmap.enable) {
         read_input = mmap_read_input_frames;
     } else {
@@ -777,7 +813,7 @@ void init_reader(EbConfig *app_cfg) {
 void process_output_statistics_buffer(EbBufferHeaderType *header_ptr, EbConfig *app_cfg) {
     uint32_t max_luma_value = (app_cfg->config.encoder_bit_depth == 8) ? 255 : 1023;
     uint64_t picture_stream_size, luma_sse, cr_sse, cb_sse, picture_number, picture_qp;
-    double   luma_ssim, cr_ssim, cb_ssim;
+    double   luma_ssim, cr_ssim, cb_ssim, luma_ms_ssim;
     double   temp_var, luma_psnr, cb_psnr, cr_psnr;
     uint32_t source_width  = app_cfg->config.source_width;
     uint32_t source_height = app_cfg->config.source_height;
@@ -791,6 +827,7 @@ void process_output_statistics_buffer(EbBufferHeaderType *header_ptr, EbConfig *
     luma_ssim           = header_ptr->luma_ssim;
     cr_ssim             = header_ptr->cr_ssim;
     cb_ssim             = header_ptr->cb_ssim;
+    luma_ms_ssim        = header_ptr->luma_ms_ssim;
 
     temp_var = (double)max_luma_value * max_luma_value * (source_width * source_height);
 
@@ -814,6 +851,7 @@ void process_output_statistics_buffer(EbBufferHeaderType *header_ptr, EbConfig *
     app_cfg->performance_context.sum_luma_ssim += luma_ssim;
     app_cfg->performance_context.sum_cr_ssim += cr_ssim;
     app_cfg->performance_context.sum_cb_ssim += cb_ssim;
+    app_cfg->performance_context.sum_luma_ms_ssim += luma_ms_ssim;
 
     // Write statistic Data to file
     if (app_cfg->stat_file) {
@@ -821,7 +859,7 @@ void process_output_statistics_buffer(EbBufferHeaderType *header_ptr, EbConfig *
                 "Picture Number: %4d\t QP: %4d  [ "
                 "PSNR-Y: %.2f dB,\tPSNR-U: %.2f dB,\tPSNR-V: %.2f "
                 "dB,\tMSE-Y: %.2f,\tMSE-U: %.2f,\tMSE-V: %.2f,\t"
-                "SSIM-Y: %.5f,\tSSIM-U: %.5f,\tSSIM-V: %.5f"
+                "SSIM-Y: %.5f,\tSSIM-U: %.5f,\tSSIM-V: %.5f,\tMS-SSIM-Y: %.5f"
                 " ]\t %6d bytes\n",
                 (int)picture_number,
                 (int)picture_qp,
@@ -834,12 +872,50 @@ void process_output_statistics_buffer(EbBufferHeaderType *header_ptr, EbConfig *
                 luma_ssim,
                 cb_ssim,
                 cr_ssim,
+                luma_ms_ssim,
                 (int)picture_stream_size);
     }
 
     return;
 }
 
+/* appends the first pass stats completed so far to the stats file, or to the stats a combined
+ * multi-pass encode without stats file keeps in memory for its final pass */
+static EbErrorType write_first_pass_stats(EncApp *enc_app, EbConfig *app_cfg) {
+    SvtAv1FixedBuf    chunk;
+    const EbErrorType ret = svt_av1_enc_get_stream_info(
+        app_cfg->svt_encoder_handle, SVT_AV1_STREAM_INFO_FIRST_PASS_STATS_CHUNK, &chunk);
+    if (ret == EB_ErrorInsufficientResources) {
+        fprintf(stderr, "\n[SVT-Error]: Out of memory reading the first pass stats\n");
+        return ret;
+    }
+    if (ret != EB_ErrorNone || !chunk.sz)
+        return EB_ErrorNone;
+    if (app_cfg->output_stat_file) {
+        // flushed so a full disk fails the first pass instead of the second one
+        if (fwrite(chunk.buf, 1, chunk.sz, app_cfg->output_stat_file) != chunk.sz ||
+            fflush(app_cfg->output_stat_file)) {
+            fprintf(stderr, "\n[SVT-Error]: Failed to write the first pass stats file\n");
+            return EB_ErrorUndefined;
+        }
+        return EB_ErrorNone;
+    }
+    SvtAv1FixedBuf *stats = &enc_app->rc_twopasses_stats;
+    if (stats->sz + chunk.sz > enc_app->rc_twopasses_stats_capability) {
+        const uint64_t capability = (stats->sz + chunk.sz) * 3 / 2;
+        void          *buf        = realloc(stats->buf, capability);
+        if (!buf) {
+            fprintf(stderr, "\n[SVT-Error]: Out of memory storing the first pass stats\n");
+            return EB_ErrorInsufficientResources;
+        }
+        stats->buf                             = buf;
+        enc_app->rc_twopasses_stats_capability = capability;
+    }
+    memcpy((uint8_t *)stats->buf + stats->sz, chunk.buf, chunk.sz);
+    stats->sz += chunk.sz;
+    return EB_ErrorNone;
+}
+
 void process_output_stream_buffer(EncChannel *channel, EncApp *enc_app, int32_t *frame_count) {
     EbConfig            *app_cfg    = channel->app_cfg;
     AppPortActiveType   *port_state = &app_cfg->output_stream_port_active;
@@ -882,20 +958,9 @@ void process_output_stream_buffer(EncChannel *channel, EncApp *enc_app, int32_t
                 // Release the output buffer
                 svt_av1_enc_release_out_buffer(&header_ptr);
 
-                if (app_cfg->config.pass == ENC_FIRST_PASS) {
-                    SvtAv1FixedBuf first_pass_stat;
-                    EbErrorType    ret = svt_av1_enc_get_stream_info(
-                        component_handle, SVT_AV1_STREAM_INFO_FIRST_PASS_STATS_OUT, &first_pass_stat);
-                    if (ret == EB_ErrorNone) {
-                        if (app_cfg->output_stat_file) {
-                            fwrite(first_pass_stat.buf, 1, first_pass_stat.sz, app_cfg->output_stat_file);
-                        }
-                        enc_app->rc_twopasses_stats.buf = realloc(enc_app->rc_twopasses_stats.buf, first_pass_stat.sz);
-                        if (enc_app->rc_twopasses_stats.buf) {
-                            memcpy(enc_app->rc_twopasses_stats.buf, first_pass_stat.buf, first_pass_stat.sz);
-                            enc_app->rc_twopasses_stats.sz = first_pass_stat.sz;
-                        }
-                    }
+                if (app_cfg->config.pass == ENC_FIRST_PASS && write_first_pass_stats(enc_app, app_cfg) != EB_ErrorNone) {
+                    channel->exit_cond_output = APP_ExitConditionError;
+                    return;
                 }
             } else {
                 is_alt_ref = (flags & EB_BUFFERFLAG_IS_ALT_REF);
@@ -938,6 +1003,10 @@ void process_output_stream_buffer(EncChannel *channel, EncApp *enc_app, int32_t
                 return_value = APP_ExitConditionNone;
                 // Release the output buffer
                 svt_av1_enc_release_out_buffer(&header_ptr);
+                if (app_cfg->config.pass == ENC_FIRST_PASS && write_first_pass_stats(enc_app, app_cfg) != EB_ErrorNone) {
+                    channel->exit_cond_output = APP_ExitConditionError;
+                    return;
+                }
 
                 ++*frame_count;
             }
@@ -1077,22 +1146,9 @@ void process_output_stream_buffer(EncChannel *channel, EncApp *enc_app, int32_t
             // Release the output buffer
             svt_av1_enc_release_out_buffer(&header_ptr);
 
-            if (flags & EB_BUFFERFLAG_EOS) {
-                if (app_cfg->config.pass == ENC_FIRST_PASS) {
-                    SvtAv1FixedBuf first_pass_stat;
-                    EbErrorType    ret = svt_av1_enc_get_stream_info(
-                        component_handle, SVT_AV1_STREAM_INFO_FIRST_PASS_STATS_OUT, &first_pass_stat);
-                    if (ret == EB_ErrorNone) {
-                        if (app_cfg->output_stat_file) {
-                            fwrite(first_pass_stat.buf, 1, first_pass_stat.sz, app_cfg->output_stat_file);
-                        }
-                        enc_app->rc_twopasses_stats.buf = realloc(enc_app->rc_twopasses_stats.buf, first_pass_stat.sz);
-                        if (enc_app->rc_twopasses_stats.buf) {
-                            memcpy(enc_app->rc_twopasses_stats.buf, first_pass_stat.buf, first_pass_stat.sz);
-                            enc_app->rc_twopasses_stats.sz = first_pass_stat.sz;
-                        }
-                    }
-                }
+            if (app_cfg->config.pass == ENC_FIRST_PASS && write_first_pass_stats(enc_app, app_cfg) != EB_ErrorNone) {
+                channel->exit_cond_output = APP_ExitConditionError;
+                return;
             }
             ++*frame_count;
 
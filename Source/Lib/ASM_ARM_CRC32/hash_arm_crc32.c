@@ -0,0 +1,40 @@
+/*
+ * Copyright (c) 2024, Alliance for Open Media. All rights reserved
+ *
+ * This source code is subject to the terms of the BSD 2 Clause License and
+ * the Alliance for Open Media Patent License 1.0. If the BSD 2 Clause License
+ * was not distributed with this source code in the LICENSE file, you can
+ * obtain it at https://www.aomedia.org/license/software-license. If the Alliance for Open
+ * Media Patent License 1.0 was not distributed with this source code in the
+ * PATENTS file, you can obtain it at https://www.aomedia.org/license/patent-license.
+ */
+
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#else
+#include <arm_acle.h>
+#endif
+
+#include <string.h>
+#include "aom_dsp_rtcd.h"
+#include "definitions.h"
+
+#define CRC_LOOP(op, crc, type, buf, len) \
+    while ((len) >= sizeof(type)) {       \
+        type v;                           \
+        memcpy(&v, (buf), sizeof(v));     \
+        (crc) = op((crc), v);             \
+        (len) -= sizeof(type);            \
+        (buf) += sizeof(type);            \
+    }
+
+uint32_t svt_av1_get_crc32c_value_arm_crc32(void *crc_calculator, uint8_t *p, size_t length) {
+    (void)crc_calculator;
+    const uint8_t *buf = p;
+    uint32_t       crc = 0xFFFFFFFF;
+    CRC_LOOP(__crc32cd, crc, uint64_t, buf, length)
+    CRC_LOOP(__crc32cw, crc, uint32_t, buf, length)
+    CRC_LOOP(__crc32ch, crc, uint16_t, buf, length)
+    CRC_LOOP(__crc32cb, crc, uint8_t, buf, length)
+    return crc ^ 0xFFFFFFFF;
+}
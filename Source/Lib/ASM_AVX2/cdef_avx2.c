@@ -24,18 +24,10 @@
 #define _mm256_setr_m128i(/* __m128i */ lo, /* __m128i */ hi) _mm256_set_m128i((hi), (lo))
 #endif
 
-/* Search for the best luma+chroma strength to add as an option, knowing we
-already selected nb_strengths options. */
-uint64_t svt_search_one_dual_avx2(int *lev0, int *lev1, int nb_strengths, uint64_t **mse[2], int sb_count, int start_gi,
-                                  int end_gi) {
-    DECLARE_ALIGNED(32, uint64_t, tot_mse[TOTAL_STRENGTHS][TOTAL_STRENGTHS]);
-    uint64_t  best_tot_mse    = (uint64_t)1 << 62;
-    int       best_id0        = 0;
-    int       best_id1        = 0;
+void svt_search_one_dual_tot_mse_avx2(int *lev0, int *lev1, int nb_strengths, uint64_t **mse[2], int sb_count,
+                                      int start_gi, int end_gi, uint64_t *tot_mse) {
     const int total_strengths = end_gi;
 
-    memset(tot_mse, 0, sizeof(tot_mse));
-
     for (int i = 0; i < sb_count; i++) {
         uint64_t best_mse = (uint64_t)1 << 62;
         /* Find best mse among already selected options. */
@@ -48,18 +40,33 @@ uint64_t svt_search_one_dual_avx2(int *lev0, int *lev1, int nb_strengths, uint64
         /* Find best mse when adding each possible new option. */
         //assert(~total_strengths % 4);
         for (int j = start_gi; j < total_strengths; ++j) { // process by 4x4
-            __m256i tmp = _mm256_set1_epi64x(mse[0][i][j]);
+            __m256i   tmp = _mm256_set1_epi64x(mse[0][i][j]);
+            uint64_t *tot = tot_mse + j * TOTAL_STRENGTHS;
             for (int k = 0; k < total_strengths; k += 4) {
                 __m256i v_mse = _mm256_loadu_si256((const __m256i *)&mse[1][i][k]);
-                __m256i v_tot = _mm256_loadu_si256((const __m256i *)&tot_mse[j][k]);
+                __m256i v_tot = _mm256_loadu_si256((const __m256i *)&tot[k]);
                 __m256i curr  = _mm256_add_epi64(tmp, v_mse);
                 __m256i mask  = _mm256_cmpgt_epi64(best_mse_, curr);
                 v_tot         = _mm256_add_epi64(
                     v_tot, _mm256_or_si256(_mm256_andnot_si256(mask, best_mse_), _mm256_and_si256(mask, curr)));
-                _mm256_storeu_si256((__m256i *)&tot_mse[j][k], v_tot);
+                _mm256_storeu_si256((__m256i *)&tot[k], v_tot);
             }
         }
     }
+}
+
+/* Search for the best luma+chroma strength to add as an option, knowing we
+already selected nb_strengths options. */
+uint64_t svt_search_one_dual_avx2(int *lev0, int *lev1, int nb_strengths, uint64_t **mse[2], int sb_count, int start_gi,
+                                  int end_gi) {
+    DECLARE_ALIGNED(32, uint64_t, tot_mse[TOTAL_STRENGTHS][TOTAL_STRENGTHS]);
+    uint64_t  best_tot_mse    = (uint64_t)1 << 62;
+    int       best_id0        = 0;
+    int       best_id1        = 0;
+    const int total_strengths = end_gi;
+
+    memset(tot_mse, 0, sizeof(tot_mse));
+    svt_search_one_dual_tot_mse_avx2(lev0, lev1, nb_strengths, mse, sb_count, start_gi, end_gi, tot_mse[0]);
     for (int j = start_gi; j < total_strengths; j++) {
         for (int k = start_gi; k < total_strengths; k++) {
             if (tot_mse[j][k] < best_tot_mse) {
@@ -157,3 +157,54 @@ void svt_compute_interm_var_four8x8_avx2_intrin(uint8_t *input_samples, uint16_t
 
     _mm256_storeu_si256((__m256i *)(mean_of_squared8x8_blocks), ymm_result);
 }
+
+// Sums of squares of the two 8-sample groups in each 128-bit lane, accumulated as 32-bit
+static INLINE void accumulate_squares_8x2_avx2(const __m256i in, __m256i *squared_lo, __m256i *squared_hi) {
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i lo   = _mm256_unpacklo_epi8(in, zero);
+    const __m256i hi   = _mm256_unpackhi_epi8(in, zero);
+    *squared_lo        = _mm256_add_epi32(*squared_lo, _mm256_madd_epi16(lo, lo));
+    *squared_hi        = _mm256_add_epi32(*squared_hi, _mm256_madd_epi16(hi, hi));
+}
+
+// Reduces the per-lane partial sums to one 64-bit total per 8x8 block, blocks in column order
+static INLINE __m256i reduce_squares_8x2_avx2(const __m256i squared_lo, const __m256i squared_hi) {
+    // lane 0: b0 b0 b1 b1, lane 1: b2 b2 b3 b3
+    __m256i sum = _mm256_hadd_epi32(squared_lo, squared_hi);
+    // lane 0: b0 b1 b0 b1, lane 1: b2 b3 b2 b3
+    sum = _mm256_hadd_epi32(sum, sum);
+    sum = _mm256_permute4x64_epi64(sum, 0x08);
+    return _mm256_cvtepu32_epi64(_mm256_castsi256_si128(sum));
+}
+
+void svt_compute_mean_8x8_64x64_avx2(uint8_t *input_samples, uint32_t input_stride, Bool subsample,
+                                     uint64_t *mean_of8x8_blocks, uint64_t *mean_of_squared8x8_blocks) {
+    const uint32_t step          = subsample ? 2 : 1;
+    const int      mean_shift    = subsample ? 3 : 2;
+    const int      squared_shift = subsample ? 11 : 10;
+    const __m256i  zero          = _mm256_setzero_si256();
+
+    for (uint32_t blk_row = 0; blk_row < 8; blk_row++) {
+        __m256i sum_0 = zero, sum_1 = zero;
+        __m256i squared_0_lo = zero, squared_0_hi = zero, squared_1_lo = zero, squared_1_hi = zero;
+
+        for (uint32_t y = 0; y < 8; y += step) {
+            const __m256i in_0 = _mm256_loadu_si256((const __m256i *)input_samples);
+            const __m256i in_1 = _mm256_loadu_si256((const __m256i *)(input_samples + 32));
+            sum_0              = _mm256_add_epi64(sum_0, _mm256_sad_epu8(in_0, zero));
+            sum_1              = _mm256_add_epi64(sum_1, _mm256_sad_epu8(in_1, zero));
+            accumulate_squares_8x2_avx2(in_0, &squared_0_lo, &squared_0_hi);
+            accumulate_squares_8x2_avx2(in_1, &squared_1_lo, &squared_1_hi);
+            input_samples += step * input_stride;
+        }
+
+        _mm256_storeu_si256((__m256i *)(mean_of8x8_blocks + 0), _mm256_slli_epi64(sum_0, mean_shift));
+        _mm256_storeu_si256((__m256i *)(mean_of8x8_blocks + 4), _mm256_slli_epi64(sum_1, mean_shift));
+        _mm256_storeu_si256((__m256i *)(mean_of_squared8x8_blocks + 0),
+                            _mm256_slli_epi64(reduce_squares_8x2_avx2(squared_0_lo, squared_0_hi), squared_shift));
+        _mm256_storeu_si256((__m256i *)(mean_of_squared8x8_blocks + 4),
+                            _mm256_slli_epi64(reduce_squares_8x2_avx2(squared_1_lo, squared_1_hi), squared_shift));
+        mean_of8x8_blocks += 8;
+        mean_of_squared8x8_blocks += 8;
+    }
+}
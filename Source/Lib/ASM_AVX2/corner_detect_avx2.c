@@ -0,0 +1,66 @@
+/*
+ * Copyright (c) 2016, Alliance for Open Media. All rights reserved
+ *
+ * This source code is subject to the terms of the BSD 2 Clause License and
+ * the Alliance for Open Media Patent License 1.0. If the BSD 2 Clause License
+ * was not distributed with this source code in the LICENSE file, you can
+ * obtain it at https://www.aomedia.org/license/software-license. If the Alliance for Open
+ * Media Patent License 1.0 was not distributed with this source code in the
+ * PATENTS file, you can obtain it at https://www.aomedia.org/license/patent-license.
+ */
+
+#include <immintrin.h>
+#include "aom_dsp_rtcd.h"
+#include "corner_detect.h"
+
+/* Scores 16 corners at once, one corner per 16-bit lane. The circle pixels are
+ * gathered into planes so that the cyclic 9-pixel window minimum (bright arcs)
+ * and maximum (dark arcs) are built from min/max over windows of 2, 4 and 8. */
+void svt_av1_fast9_score_avx2(const uint8_t *im, int stride, const int *corners_xy, int num_corners, int b,
+                              int *scores) {
+    int offsets[16];
+    svt_av1_fast9_circle_offsets(offsets, stride);
+    const __m256i one = _mm256_set1_epi16(1);
+    const __m256i vb  = _mm256_set1_epi16((int16_t)b);
+
+    int n = 0;
+    for (; n + 16 <= num_corners; n += 16) {
+        DECLARE_ALIGNED(16, uint8_t, pix[17][16]);
+        for (int i = 0; i < 16; i++) {
+            const uint8_t *p = im + corners_xy[2 * (n + i) + 1] * stride + corners_xy[2 * (n + i)];
+            pix[16][i]       = p[0];
+            for (int k = 0; k < 16; k++) pix[k][i] = p[offsets[k]];
+        }
+        const __m256i c = _mm256_cvtepu8_epi16(_mm_load_si128((const __m128i *)pix[16]));
+        __m256i       d[16], mn[16], mx[16];
+        for (int k = 0; k < 16; k++)
+            d[k] = _mm256_sub_epi16(_mm256_cvtepu8_epi16(_mm_load_si128((const __m128i *)pix[k])), c);
+        for (int k = 0; k < 16; k++) {
+            mn[k] = _mm256_min_epi16(d[k], d[(k + 1) & 15]);
+            mx[k] = _mm256_max_epi16(d[k], d[(k + 1) & 15]);
+        }
+        for (int w = 2; w <= 4; w <<= 1) {
+            __m256i mn_w[16], mx_w[16];
+            for (int k = 0; k < 16; k++) {
+                mn_w[k] = _mm256_min_epi16(mn[k], mn[(k + w) & 15]);
+                mx_w[k] = _mm256_max_epi16(mx[k], mx[(k + w) & 15]);
+            }
+            for (int k = 0; k < 16; k++) {
+                mn[k] = mn_w[k];
+                mx[k] = mx_w[k];
+            }
+        }
+        __m256i bright = _mm256_set1_epi16(-255);
+        __m256i dark   = _mm256_set1_epi16(255);
+        for (int k = 0; k < 16; k++) {
+            bright = _mm256_max_epi16(bright, _mm256_min_epi16(mn[k], d[(k + 8) & 15]));
+            dark   = _mm256_min_epi16(dark, _mm256_max_epi16(mx[k], d[(k + 8) & 15]));
+        }
+        const __m256i s     = _mm256_max_epi16(bright, _mm256_sub_epi16(_mm256_setzero_si256(), dark));
+        const __m256i score = _mm256_max_epi16(vb, _mm256_sub_epi16(s, one));
+        _mm256_storeu_si256((__m256i *)(scores + n), _mm256_cvtepi16_epi32(_mm256_castsi256_si128(score)));
+        _mm256_storeu_si256((__m256i *)(scores + n + 8), _mm256_cvtepi16_epi32(_mm256_extracti128_si256(score, 1)));
+    }
+    if (n < num_corners)
+        svt_av1_fast9_score_c(im, stride, corners_xy + 2 * n, num_corners - n, b, scores + n);
+}
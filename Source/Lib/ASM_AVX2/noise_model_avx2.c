@@ -242,3 +242,53 @@ void svt_aom_flat_block_finder_extract_block_avx2(const AomFlatBlockFinder *bloc
     }
     for (; i < n; ++i) block[i] -= plane[i];
 }
+
+/* One block per lane: the blocks are interleaved so each lane accumulates its
+ * sums in the same order as the C version. */
+void svt_aom_flat_block_finder_block_stats_avx2(const double *blocks, int32_t block_size, int32_t num_blocks,
+                                                double *stats) {
+    const int32_t n = block_size * block_size;
+    if (num_blocks != FLAT_BLOCK_STATS_BATCH || block_size > 32 || (n & 3)) {
+        svt_aom_flat_block_finder_block_stats_c(blocks, block_size, num_blocks, stats);
+        return;
+    }
+    DECLARE_ALIGNED(32, double, tb[32 * 32 * 4]);
+    const double *b0 = blocks, *b1 = blocks + n, *b2 = blocks + 2 * n, *b3 = blocks + 3 * n;
+    for (int32_t i = 0; i < n; i += 4) {
+        const __m256d a  = _mm256_loadu_pd(b0 + i);
+        const __m256d b  = _mm256_loadu_pd(b1 + i);
+        const __m256d c  = _mm256_loadu_pd(b2 + i);
+        const __m256d d  = _mm256_loadu_pd(b3 + i);
+        const __m256d t0 = _mm256_unpacklo_pd(a, b);
+        const __m256d t1 = _mm256_unpackhi_pd(a, b);
+        const __m256d t2 = _mm256_unpacklo_pd(c, d);
+        const __m256d t3 = _mm256_unpackhi_pd(c, d);
+        _mm256_store_pd(tb + 4 * i + 0, _mm256_permute2f128_pd(t0, t2, 0x20));
+        _mm256_store_pd(tb + 4 * i + 4, _mm256_permute2f128_pd(t1, t3, 0x20));
+        _mm256_store_pd(tb + 4 * i + 8, _mm256_permute2f128_pd(t0, t2, 0x31));
+        _mm256_store_pd(tb + 4 * i + 12, _mm256_permute2f128_pd(t1, t3, 0x31));
+    }
+
+    const __m256d half = _mm256_set1_pd(0.5);
+    __m256d       g_xx = _mm256_setzero_pd(), g_xy = _mm256_setzero_pd(), g_yy = _mm256_setzero_pd();
+    __m256d       mean = _mm256_setzero_pd(), var = _mm256_setzero_pd();
+    for (int32_t yi = 1; yi < block_size - 1; ++yi) {
+        for (int32_t xi = 1; xi < block_size - 1; ++xi) {
+            const double *p  = tb + 4 * (yi * block_size + xi);
+            const __m256d v  = _mm256_load_pd(p);
+            const __m256d gx = _mm256_mul_pd(_mm256_sub_pd(_mm256_load_pd(p + 4), _mm256_load_pd(p - 4)), half);
+            const __m256d gy = _mm256_mul_pd(
+                _mm256_sub_pd(_mm256_load_pd(p + 4 * block_size), _mm256_load_pd(p - 4 * block_size)), half);
+            g_xx = _mm256_add_pd(g_xx, _mm256_mul_pd(gx, gx));
+            g_xy = _mm256_add_pd(g_xy, _mm256_mul_pd(gx, gy));
+            g_yy = _mm256_add_pd(g_yy, _mm256_mul_pd(gy, gy));
+            mean = _mm256_add_pd(mean, v);
+            var  = _mm256_add_pd(var, _mm256_mul_pd(v, v));
+        }
+    }
+    _mm256_storeu_pd(stats + 0 * FLAT_BLOCK_STATS_BATCH, g_xx);
+    _mm256_storeu_pd(stats + 1 * FLAT_BLOCK_STATS_BATCH, g_xy);
+    _mm256_storeu_pd(stats + 2 * FLAT_BLOCK_STATS_BATCH, g_yy);
+    _mm256_storeu_pd(stats + 3 * FLAT_BLOCK_STATS_BATCH, mean);
+    _mm256_storeu_pd(stats + 4 * FLAT_BLOCK_STATS_BATCH, var);
+}
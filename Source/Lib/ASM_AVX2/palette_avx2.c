@@ -12,6 +12,7 @@
 #include <immintrin.h>
 #include "definitions.h"
 #include "common_dsp_rtcd.h"
+#include "aom_dsp_rtcd.h"
 #define DIVIDE_AND_ROUND(x, y) (((x) + ((y) >> 1)) / (y))
 
 static INLINE unsigned int lcg_rand16(unsigned int *state) {
@@ -391,3 +392,88 @@ void svt_av1_k_means_dim2_avx2(const int *data, int *centroids, uint8_t *indices
             break;
     }
 }
+
+/* Number of non-zero bins in the histogram, n is a multiple of 8. */
+static INLINE int count_non_zero_bins_avx2(const int *val_count, int n) {
+    __m256i acc = _mm256_setzero_si256();
+    for (int i = 0; i < n; i += 8) {
+        const __m256i v = _mm256_loadu_si256((const __m256i *)(val_count + i));
+        acc             = _mm256_sub_epi32(acc, _mm256_cmpgt_epi32(v, _mm256_setzero_si256()));
+    }
+    __m128i s = _mm_add_epi32(_mm256_castsi256_si128(acc), _mm256_extracti128_si256(acc, 1));
+    s         = _mm_add_epi32(s, _mm_srli_si128(s, 8));
+    s         = _mm_add_epi32(s, _mm_srli_si128(s, 4));
+    return _mm_cvtsi128_si32(s);
+}
+
+/* Runs of 16 (or 8) equal pixels, which make up most of screen content, are
+   added to their bin at once. Other pixels go through the scalar histogram. */
+int svt_av1_count_colors_avx2(const uint8_t *src, int stride, int rows, int cols, int *val_count) {
+    memset(val_count, 0, (1 << 8) * sizeof(val_count[0]));
+    for (int r = 0; r < rows; ++r) {
+        const uint8_t *row = src + r * stride;
+        int            c   = 0;
+        for (; c + 16 <= cols; c += 16) {
+            const __m128i v = _mm_loadu_si128((const __m128i *)(row + c));
+            if (_mm_movemask_epi8(_mm_cmpeq_epi8(v, _mm_set1_epi8((char)row[c]))) == 0xffff)
+                val_count[row[c]] += 16;
+            else
+                for (int i = 0; i < 16; ++i) ++val_count[row[c + i]];
+        }
+        if (c + 8 <= cols) {
+            const __m128i v = _mm_loadl_epi64((const __m128i *)(row + c));
+            if ((_mm_movemask_epi8(_mm_cmpeq_epi8(v, _mm_set1_epi8((char)row[c]))) & 0xff) == 0xff)
+                val_count[row[c]] += 8;
+            else
+                for (int i = 0; i < 8; ++i) ++val_count[row[c + i]];
+            c += 8;
+        }
+        for (; c < cols; ++c) ++val_count[row[c]];
+    }
+    return count_non_zero_bins_avx2(val_count, 1 << 8);
+}
+
+int svt_av1_count_colors_highbd_avx2(uint16_t *src, int stride, int rows, int cols, int bit_depth, int *val_count) {
+    assert(bit_depth <= 12);
+    const int max_pix_val = 1 << bit_depth;
+    memset(val_count, 0, max_pix_val * sizeof(val_count[0]));
+    for (int r = 0; r < rows; ++r) {
+        const uint16_t *row = src + r * stride;
+        int             c   = 0;
+        for (; c + 16 <= cols; c += 16) {
+            const __m256i v = _mm256_loadu_si256((const __m256i *)(row + c));
+            if (_mm256_movemask_epi8(_mm256_cmpeq_epi16(v, _mm256_set1_epi16((short)row[c]))) == -1) {
+                if (row[c] >= max_pix_val)
+                    return 0;
+                val_count[row[c]] += 16;
+                continue;
+            }
+            for (int i = 0; i < 16; ++i) {
+                if (row[c + i] >= max_pix_val)
+                    return 0;
+                ++val_count[row[c + i]];
+            }
+        }
+        if (c + 8 <= cols) {
+            const __m128i v = _mm_loadu_si128((const __m128i *)(row + c));
+            if (_mm_movemask_epi8(_mm_cmpeq_epi16(v, _mm_set1_epi16((short)row[c]))) == 0xffff) {
+                if (row[c] >= max_pix_val)
+                    return 0;
+                val_count[row[c]] += 8;
+            } else {
+                for (int i = 0; i < 8; ++i) {
+                    if (row[c + i] >= max_pix_val)
+                        return 0;
+                    ++val_count[row[c + i]];
+                }
+            }
+            c += 8;
+        }
+        for (; c < cols; ++c) {
+            if (row[c] >= max_pix_val)
+                return 0;
+            ++val_count[row[c]];
+        }
+    }
+    return count_non_zero_bins_avx2(val_count, max_pix_val);
+}
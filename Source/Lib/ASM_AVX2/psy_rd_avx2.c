@@ -0,0 +1,187 @@
+/*
+* Copyright (c) 2024, Alliance for Open Media. All rights reserved
+*
+* This source code is subject to the terms of the BSD 2 Clause License and
+* the Alliance for Open Media Patent License 1.0. If the BSD 2 Clause License
+* was not distributed with this source code in the LICENSE file, you can
+* obtain it at https://www.aomedia.org/license/software-license. If the Alliance for Open
+* Media Patent License 1.0 was not distributed with this source code in the
+* PATENTS file, you can obtain it at https://www.aomedia.org/license/patent-license.
+*/
+
+#include <immintrin.h>
+#include <stdlib.h>
+#include "common_dsp_rtcd.h"
+#include "transpose_sse2.h"
+
+/*
+ * The C reference packs two 16-bit partial sums into every 32-bit word and lets them wrap,
+ * so the kernels below keep the exact same 32-bit lane arithmetic to stay bit-exact.
+ */
+
+/* Equivalent of ashft(): absolute value of both 16-bit halves of each 32-bit lane */
+static INLINE __m256i psy_abs_packed_avx2(const __m256i a) {
+    const __m256i s = _mm256_and_si256(_mm256_srli_epi32(a, 15), _mm256_set1_epi32(0x10001));
+    const __m256i m = _mm256_sub_epi32(_mm256_slli_epi32(s, 16), s);
+    return _mm256_xor_si256(_mm256_add_epi32(a, m), m);
+}
+
+/* (a0 + a1) + ((a0 - a1) << 16) */
+static INLINE __m256i psy_pack_pair_avx2(const __m256i a0, const __m256i a1) {
+    return _mm256_add_epi32(_mm256_add_epi32(a0, a1), _mm256_slli_epi32(_mm256_sub_epi32(a0, a1), 16));
+}
+
+static INLINE void psy_hadamard4_avx2(const __m256i s0, const __m256i s1, const __m256i s2, const __m256i s3,
+                                      __m256i *d0, __m256i *d1, __m256i *d2, __m256i *d3) {
+    const __m256i t0 = _mm256_add_epi32(s0, s1);
+    const __m256i t1 = _mm256_sub_epi32(s0, s1);
+    const __m256i t2 = _mm256_add_epi32(s2, s3);
+    const __m256i t3 = _mm256_sub_epi32(s2, s3);
+    *d0              = _mm256_add_epi32(t0, t2);
+    *d2              = _mm256_sub_epi32(t0, t2);
+    *d1              = _mm256_add_epi32(t1, t3);
+    *d3              = _mm256_sub_epi32(t1, t3);
+}
+
+/* sa8d of 8 rows of 16-bit pixels against a zero reference, matches svt_sa8d_8x8() */
+static INLINE int psy_sa8d_8x8_avx2(const __m128i *const row) {
+    __m128i col[8];
+    __m256i a[8];
+    __m256i h0, h1, h2, h3, v0, v1, v2, v3;
+
+    transpose_16bit_8x8(row, col);
+    for (int i = 0; i < 8; i++) a[i] = _mm256_cvtepi16_epi32(col[i]);
+
+    // Horizontal pass, lane i holds tmp[i][]
+    psy_hadamard4_avx2(psy_pack_pair_avx2(a[0], a[1]),
+                       psy_pack_pair_avx2(a[2], a[3]),
+                       psy_pack_pair_avx2(a[4], a[5]),
+                       psy_pack_pair_avx2(a[6], a[7]),
+                       &h0,
+                       &h1,
+                       &h2,
+                       &h3);
+
+    // Transpose so that lane k of r[i] holds tmp[i][k] in the low half and tmp[i + 4][k] in the high half
+    const __m256i u0 = _mm256_unpacklo_epi32(h0, h1);
+    const __m256i u1 = _mm256_unpackhi_epi32(h0, h1);
+    const __m256i u2 = _mm256_unpacklo_epi32(h2, h3);
+    const __m256i u3 = _mm256_unpackhi_epi32(h2, h3);
+    psy_hadamard4_avx2(_mm256_unpacklo_epi64(u0, u2),
+                       _mm256_unpackhi_epi64(u0, u2),
+                       _mm256_unpacklo_epi64(u1, u3),
+                       _mm256_unpackhi_epi64(u1, u3),
+                       &v0,
+                       &v1,
+                       &v2,
+                       &v3);
+
+    // Vertical pass, combine a[m] (low half) with a[m + 4] (high half)
+    const __m256i mask_lo = _mm256_set1_epi32(0xffff);
+    const __m256i v[4]    = {v0, v1, v2, v3};
+    __m256i       sum_lo  = _mm256_setzero_si256();
+    __m256i       sum_hi  = _mm256_setzero_si256();
+    for (int m = 0; m < 4; m++) {
+        const __m128i lo = _mm256_castsi256_si128(v[m]);
+        const __m128i hi = _mm256_extracti128_si256(v[m], 1);
+        const __m256i w  = psy_abs_packed_avx2(
+            _mm256_insertf128_si256(_mm256_castsi128_si256(_mm_add_epi32(lo, hi)), _mm_sub_epi32(lo, hi), 1));
+        sum_lo = _mm256_add_epi32(sum_lo, _mm256_and_si256(w, mask_lo));
+        sum_hi = _mm256_add_epi32(sum_hi, _mm256_srli_epi32(w, 16));
+    }
+
+    // (uint16_t)b0 + (b0 >> 16) for each of the 4 columns, then sum the columns
+    const __m128i l = _mm_add_epi32(_mm256_castsi256_si128(sum_lo), _mm256_extracti128_si256(sum_lo, 1));
+    const __m128i h = _mm_add_epi32(_mm256_castsi256_si128(sum_hi), _mm256_extracti128_si256(sum_hi, 1));
+    __m128i       c = _mm_add_epi32(_mm_add_epi32(_mm_and_si128(l, _mm256_castsi256_si128(mask_lo)), _mm_srli_epi32(l, 16)),
+                              h);
+    c                  = _mm_add_epi32(c, _mm_srli_si128(c, 8));
+    c                  = _mm_add_epi32(c, _mm_srli_si128(c, 4));
+    const uint32_t sum = (uint32_t)_mm_cvtsi128_si32(c);
+
+    return ((int)sum + 2) >> 2;
+}
+
+/* Sum of 8 rows of 16-bit pixels, matches svt_psy_sad_nxn() against a zero reference */
+static INLINE int psy_sum_8x8_avx2(const __m128i *const row) {
+    __m128i acc = row[0];
+    for (int i = 1; i < 8; i++) acc = _mm_add_epi16(acc, row[i]);
+    acc = _mm_madd_epi16(acc, _mm_set1_epi16(1));
+    acc = _mm_add_epi32(acc, _mm_srli_si128(acc, 8));
+    acc = _mm_add_epi32(acc, _mm_srli_si128(acc, 4));
+    return _mm_cvtsi128_si32(acc);
+}
+
+static INLINE int psy_energy_8x8_avx2(const __m128i *const row) {
+    return (psy_sa8d_8x8_avx2(row) >> 8) - (psy_sum_8x8_avx2(row) >> 2);
+}
+
+static INLINE void psy_load_8x8(const uint8_t *src, uint32_t stride, __m128i *const row) {
+    for (int i = 0; i < 8; i++, src += stride) row[i] = _mm_cvtepu8_epi16(_mm_loadl_epi64((const __m128i *)src));
+}
+
+static INLINE void psy_load_8x8_hbd(const uint16_t *src, uint32_t stride, __m128i *const row) {
+    for (int i = 0; i < 8; i++, src += stride) row[i] = _mm_loadu_si128((const __m128i *)src);
+}
+
+uint64_t svt_psy_distortion_avx2(const uint8_t *input, uint32_t input_stride, const uint8_t *recon,
+                                 uint32_t recon_stride, uint32_t width, uint32_t height, const uint32_t count) {
+    if (count < 64) /* 4x4 only touches a single row, nothing to vectorize */
+        return svt_psy_distortion_c(input, input_stride, recon, recon_stride, width, height, count);
+
+    uint32_t total_nrg = 0;
+    __m128i  row[8];
+
+    for (uint64_t i = 0; i < height; i += 8) {
+        for (uint64_t j = 0; j < width; j += 8) {
+            psy_load_8x8(input + i * input_stride + j, input_stride, row);
+            const int input_nrg = psy_energy_8x8_avx2(row);
+            psy_load_8x8(recon + i * recon_stride + j, recon_stride, row);
+            const int recon_nrg = psy_energy_8x8_avx2(row);
+            total_nrg += (uint32_t)abs(input_nrg - recon_nrg);
+        }
+    }
+    return (total_nrg << 2);
+}
+
+uint64_t svt_psy_distor_hbd_avx2(const uint16_t *input, uint32_t input_stride, const uint16_t *recon,
+                                 uint32_t recon_stride, uint32_t width, uint32_t height, const uint32_t count) {
+    if (count < 64)
+        return svt_psy_distor_hbd_c(input, input_stride, recon, recon_stride, width, height, count);
+
+    uint32_t total_nrg = 0;
+    __m128i  row[8];
+
+    for (uint64_t i = 0; i < height; i += 8) {
+        for (uint64_t j = 0; j < width; j += 8) {
+            psy_load_8x8_hbd(input + i * input_stride + j, input_stride, row);
+            const int input_nrg = psy_energy_8x8_avx2(row);
+            psy_load_8x8_hbd(recon + i * recon_stride + j, recon_stride, row);
+            const int recon_nrg = psy_energy_8x8_avx2(row);
+            total_nrg += (uint32_t)abs(input_nrg - recon_nrg);
+        }
+    }
+    return (total_nrg << 2);
+}
+
+void svt_psy_ac_energy_avx2(const uint8_t *src, uint32_t stride, uint32_t width, uint32_t height, int32_t *nrg) {
+    __m128i row[8];
+
+    for (uint64_t i = 0; i < height; i += 8) {
+        for (uint64_t j = 0; j < width; j += 8) {
+            psy_load_8x8(src + i * stride + j, stride, row);
+            *nrg++ = psy_energy_8x8_avx2(row);
+        }
+    }
+}
+
+void svt_psy_ac_energy_hbd_avx2(const uint16_t *src, uint32_t stride, uint32_t width, uint32_t height, int32_t *nrg) {
+    __m128i row[8];
+
+    for (uint64_t i = 0; i < height; i += 8) {
+        for (uint64_t j = 0; j < width; j += 8) {
+            psy_load_8x8_hbd(src + i * stride + j, stride, row);
+            *nrg++ = psy_energy_8x8_avx2(row);
+        }
+    }
+}
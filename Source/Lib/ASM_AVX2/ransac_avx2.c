@@ -0,0 +1,119 @@
+/*
+ * Copyright (c) 2016, Alliance for Open Media. All rights reserved
+ *
+ * This source code is subject to the terms of the BSD 2 Clause License and
+ * the Alliance for Open Media Patent License 1.0. If the BSD 2 Clause License
+ * was not distributed with this source code in the LICENSE file, you can
+ * obtain it at https://www.aomedia.org/license/software-license. If the Alliance for Open
+ * Media Patent License 1.0 was not distributed with this source code in the
+ * PATENTS file, you can obtain it at https://www.aomedia.org/license/patent-license.
+ */
+
+#include <immintrin.h>
+#include <math.h>
+#include "aom_dsp_rtcd.h"
+#include "definitions.h"
+
+/* Separate multiplies and adds (no FMA) keep every entry bit-exact with the C
+ * version, which sums each entry over the rows in the same order. */
+void svt_av1_normal_equations_avx2(const double *A, int rows, int n, int stride, const double *b, double *at_a,
+                                   double *atb) {
+    if (n > 8) {
+        svt_av1_normal_equations_c(A, rows, n, stride, b, at_a, atb);
+        return;
+    }
+    const __m256i lane    = _mm256_setr_epi64x(0, 1, 2, 3);
+    const __m256i mask_lo = _mm256_cmpgt_epi64(_mm256_set1_epi64x(n), lane);
+    const __m256i mask_hi = _mm256_cmpgt_epi64(_mm256_set1_epi64x(n - 4), lane);
+    __m256d       acc_lo[8], acc_hi[8];
+    __m256d       atb_lo = _mm256_setzero_pd();
+    __m256d       atb_hi = _mm256_setzero_pd();
+    for (int i = 0; i < n; ++i) acc_lo[i] = acc_hi[i] = _mm256_setzero_pd();
+
+    if (n <= 4) {
+        for (int k = 0; k < rows; ++k) {
+            const double *a   = A + k * stride;
+            const __m256d row = _mm256_maskload_pd(a, mask_lo);
+            for (int i = 0; i < n; ++i)
+                acc_lo[i] = _mm256_add_pd(acc_lo[i], _mm256_mul_pd(_mm256_set1_pd(a[i]), row));
+            atb_lo = _mm256_add_pd(atb_lo, _mm256_mul_pd(row, _mm256_set1_pd(b[k])));
+        }
+    } else {
+        for (int k = 0; k < rows; ++k) {
+            const double *a      = A + k * stride;
+            const __m256d row_lo = _mm256_loadu_pd(a);
+            const __m256d row_hi = _mm256_maskload_pd(a + 4, mask_hi);
+            for (int i = 0; i < n; ++i) {
+                const __m256d aki = _mm256_set1_pd(a[i]);
+                acc_lo[i]         = _mm256_add_pd(acc_lo[i], _mm256_mul_pd(aki, row_lo));
+                acc_hi[i]         = _mm256_add_pd(acc_hi[i], _mm256_mul_pd(aki, row_hi));
+            }
+            const __m256d bk = _mm256_set1_pd(b[k]);
+            atb_lo           = _mm256_add_pd(atb_lo, _mm256_mul_pd(row_lo, bk));
+            atb_hi           = _mm256_add_pd(atb_hi, _mm256_mul_pd(row_hi, bk));
+        }
+    }
+
+    for (int i = 0; i < n; ++i) {
+        _mm256_maskstore_pd(at_a + i * n, mask_lo, acc_lo[i]);
+        if (n > 4)
+            _mm256_maskstore_pd(at_a + i * n + 4, mask_hi, acc_hi[i]);
+    }
+    _mm256_maskstore_pd(atb, mask_lo, atb_lo);
+    if (n > 4)
+        _mm256_maskstore_pd(atb + 4, mask_hi, atb_hi);
+}
+
+/* Projects and tests 4 correspondences per iteration. The inlier sums are
+ * still accumulated one point at a time in index order to match C exactly. */
+int svt_av1_ransac_find_inliers_avx2(const double *mat, const double *x1, const double *y1, const double *x2,
+                                     const double *y2, int npoints, double thresh_pow2, int *inlier_indices,
+                                     double *sum_distance, double *sum_distance_squared) {
+    const __m256d m0  = _mm256_set1_pd(mat[0]);
+    const __m256d m1  = _mm256_set1_pd(mat[1]);
+    const __m256d m2  = _mm256_set1_pd(mat[2]);
+    const __m256d m3  = _mm256_set1_pd(mat[3]);
+    const __m256d m4  = _mm256_set1_pd(mat[4]);
+    const __m256d m5  = _mm256_set1_pd(mat[5]);
+    const __m256d thr = _mm256_set1_pd(thresh_pow2);
+    DECLARE_ALIGNED(32, double, dist[4]);
+    DECLARE_ALIGNED(32, double, dist_pow2[4]);
+    int    num_inliers = 0;
+    double sum_d = 0.0, sum_d2 = 0.0;
+
+    int i = 0;
+    for (; i + 4 <= npoints; i += 4) {
+        const __m256d x  = _mm256_loadu_pd(x1 + i);
+        const __m256d y  = _mm256_loadu_pd(y1 + i);
+        const __m256d px = _mm256_add_pd(_mm256_add_pd(_mm256_mul_pd(m2, x), _mm256_mul_pd(m3, y)), m0);
+        const __m256d py = _mm256_add_pd(_mm256_add_pd(_mm256_mul_pd(m4, x), _mm256_mul_pd(m5, y)), m1);
+        const __m256d dx = _mm256_sub_pd(px, _mm256_loadu_pd(x2 + i));
+        const __m256d dy = _mm256_sub_pd(py, _mm256_loadu_pd(y2 + i));
+        const __m256d d2 = _mm256_add_pd(_mm256_mul_pd(dx, dx), _mm256_mul_pd(dy, dy));
+        int           mask = _mm256_movemask_pd(_mm256_cmp_pd(d2, thr, _CMP_LT_OQ));
+        if (!mask)
+            continue;
+        _mm256_store_pd(dist_pow2, d2);
+        _mm256_store_pd(dist, _mm256_sqrt_pd(d2));
+        for (int j = 0; j < 4; j++) {
+            if (mask & (1 << j)) {
+                inlier_indices[num_inliers++] = i + j;
+                sum_d += dist[j];
+                sum_d2 += dist_pow2[j];
+            }
+        }
+    }
+    for (; i < npoints; ++i) {
+        const double dx            = mat[2] * x1[i] + mat[3] * y1[i] + mat[0] - x2[i];
+        const double dy            = mat[4] * x1[i] + mat[5] * y1[i] + mat[1] - y2[i];
+        const double distance_pow2 = dx * dx + dy * dy;
+        if (distance_pow2 < thresh_pow2) {
+            inlier_indices[num_inliers++] = i;
+            sum_d += sqrt(distance_pow2);
+            sum_d2 += distance_pow2;
+        }
+    }
+    *sum_distance         = sum_d;
+    *sum_distance_squared = sum_d2;
+    return num_inliers;
+}
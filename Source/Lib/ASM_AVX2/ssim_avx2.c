@@ -11,6 +11,9 @@
 
 #include <immintrin.h>
 #include "definitions.h"
+#include "aom_dsp_rtcd.h"
+#include "synonyms_avx2.h"
+#include "quality_metrics.h"
 
 #ifndef _mm_loadu_si32
 #define _mm_loadu_si32(p) _mm_cvtsi32_si128(*(unsigned int const *)(p))
@@ -39,9 +42,8 @@ static INLINE uint32_t sum8(__m256i x) {
     const __m128i sum = _mm_add_epi32(lo, hi);
     return _mm_extract_epi32(sum, 0);
 }
-extern double similarity(uint32_t sum_s, uint32_t sum_r, uint32_t sum_sq_s, uint32_t sum_sq_r, uint32_t sum_sxr,
-                         int count, uint32_t bd);
-double        svt_ssim_8x8_avx2(const uint8_t *s, uint32_t sp, const uint8_t *r, uint32_t rp) {
+
+double svt_ssim_8x8_avx2(const uint8_t *s, uint32_t sp, const uint8_t *r, uint32_t rp) {
     __m256i vec_sum_s    = _mm256_setzero_si256();
     __m256i vec_sum_r    = _mm256_setzero_si256();
     __m256i vec_sum_sq_s = _mm256_setzero_si256();
@@ -72,7 +74,7 @@ double        svt_ssim_8x8_avx2(const uint8_t *s, uint32_t sp, const uint8_t *r,
     uint32_t sum_sq_s = sum8(vec_sum_sq_s);
     uint32_t sum_sq_r = sum8(vec_sum_sq_r);
     uint32_t sum_sxr  = sum8(vec_sum_sxr);
-    double   score    = similarity(sum_s, sum_r, sum_sq_s, sum_sq_r, sum_sxr, 64, 8);
+    double   score    = svt_aom_similarity(sum_s, sum_r, sum_sq_s, sum_sq_r, sum_sxr, 64, 8);
     return score;
 }
 double svt_ssim_4x4_avx2(const uint8_t *s, uint32_t sp, const uint8_t *r, uint32_t rp) {
@@ -106,74 +108,124 @@ double svt_ssim_4x4_avx2(const uint8_t *s, uint32_t sp, const uint8_t *r, uint32
     uint32_t sum_sq_s = sum8(vec_sum_sq_s);
     uint32_t sum_sq_r = sum8(vec_sum_sq_r);
     uint32_t sum_sxr  = sum8(vec_sum_sxr);
-    double   score    = similarity(sum_s, sum_r, sum_sq_s, sum_sq_r, sum_sxr, 16, 8);
+    double   score    = svt_aom_similarity(sum_s, sum_r, sum_sq_s, sum_sq_r, sum_sxr, 16, 8);
     return score;
 }
+/* Two rows per register. The samples are at most 12 bits, so the 16-bit sums of
+ * 4 rows and the pairwise products of madd stay in range. */
 double svt_ssim_8x8_hbd_avx2(const uint16_t *s, uint32_t sp, const uint16_t *r, uint32_t rp) {
-    __m256i vec_sum_s    = _mm256_setzero_si256();
-    __m256i vec_sum_r    = _mm256_setzero_si256();
-    __m256i vec_sum_sq_s = _mm256_setzero_si256();
-    __m256i vec_sum_sq_r = _mm256_setzero_si256();
-    __m256i vec_sum_sxr  = _mm256_setzero_si256();
-    for (int i = 0; i < 8; ++i) {
-        __m256i vec_src = _mm256_cvtepu16_epi32(_mm_loadu_si128((const __m128i *)s));
-        __m256i vec_rec = _mm256_cvtepu16_epi32(_mm_loadu_si128((const __m128i *)r));
-
-        vec_sum_s = _mm256_add_epi32(vec_sum_s, vec_src);
-        vec_sum_r = _mm256_add_epi32(vec_sum_r, vec_rec);
-
-        __m256i vec_sq = _mm256_mullo_epi32(vec_src, vec_src);
-        vec_sum_sq_s   = _mm256_add_epi32(vec_sum_sq_s, vec_sq);
-
-        vec_sq       = _mm256_mullo_epi32(vec_rec, vec_rec);
-        vec_sum_sq_r = _mm256_add_epi32(vec_sum_sq_r, vec_sq);
-
-        __m256i vec_sxr = _mm256_mullo_epi32(vec_src, vec_rec);
-        vec_sum_sxr     = _mm256_add_epi32(vec_sum_sxr, vec_sxr);
-
-        s += sp;
-        r += rp;
+    const __m256i one          = _mm256_set1_epi16(1);
+    __m256i       vec_sum_s    = _mm256_setzero_si256();
+    __m256i       vec_sum_r    = _mm256_setzero_si256();
+    __m256i       vec_sum_sq_s = _mm256_setzero_si256();
+    __m256i       vec_sum_sq_r = _mm256_setzero_si256();
+    __m256i       vec_sum_sxr  = _mm256_setzero_si256();
+    for (int i = 0; i < 8; i += 2) {
+        const __m256i vec_src = yy_loadu2_128(s + sp, s);
+        const __m256i vec_rec = yy_loadu2_128(r + rp, r);
+
+        vec_sum_s    = _mm256_add_epi16(vec_sum_s, vec_src);
+        vec_sum_r    = _mm256_add_epi16(vec_sum_r, vec_rec);
+        vec_sum_sq_s = _mm256_add_epi32(vec_sum_sq_s, _mm256_madd_epi16(vec_src, vec_src));
+        vec_sum_sq_r = _mm256_add_epi32(vec_sum_sq_r, _mm256_madd_epi16(vec_rec, vec_rec));
+        vec_sum_sxr  = _mm256_add_epi32(vec_sum_sxr, _mm256_madd_epi16(vec_src, vec_rec));
+
+        s += 2 * sp;
+        r += 2 * rp;
     }
 
-    uint32_t sum_s    = sum8(vec_sum_s);
-    uint32_t sum_r    = sum8(vec_sum_r);
+    uint32_t sum_s    = sum8(_mm256_madd_epi16(vec_sum_s, one));
+    uint32_t sum_r    = sum8(_mm256_madd_epi16(vec_sum_r, one));
     uint32_t sum_sq_s = sum8(vec_sum_sq_s);
     uint32_t sum_sq_r = sum8(vec_sum_sq_r);
     uint32_t sum_sxr  = sum8(vec_sum_sxr);
-    double   score    = similarity(sum_s, sum_r, sum_sq_s, sum_sq_r, sum_sxr, 64, 10);
+    double   score    = svt_aom_similarity(sum_s, sum_r, sum_sq_s, sum_sq_r, sum_sxr, 64, 10);
     return score;
 }
 double svt_ssim_4x4_hbd_avx2(const uint16_t *s, uint32_t sp, const uint16_t *r, uint32_t rp) {
-    __m256i vec_sum_s    = _mm256_setzero_si256();
-    __m256i vec_sum_r    = _mm256_setzero_si256();
-    __m256i vec_sum_sq_s = _mm256_setzero_si256();
-    __m256i vec_sum_sq_r = _mm256_setzero_si256();
-    __m256i vec_sum_sxr  = _mm256_setzero_si256();
-    for (int i = 0; i < 4; ++i) {
-        __m256i vec_src = _mm256_cvtepu16_epi32(_mm_loadu_si64(s));
-        __m256i vec_rec = _mm256_cvtepu16_epi32(_mm_loadu_si64(r));
-
-        vec_sum_s = _mm256_add_epi32(vec_sum_s, vec_src);
-        vec_sum_r = _mm256_add_epi32(vec_sum_r, vec_rec);
-
-        __m256i vec_sq = _mm256_mullo_epi32(vec_src, vec_src);
-        vec_sum_sq_s   = _mm256_add_epi32(vec_sum_sq_s, vec_sq);
-
-        vec_sq       = _mm256_mullo_epi32(vec_rec, vec_rec);
-        vec_sum_sq_r = _mm256_add_epi32(vec_sum_sq_r, vec_sq);
+    const __m256i one     = _mm256_set1_epi16(1);
+    const __m256i vec_src = yy_set_m128i(
+        _mm_unpacklo_epi64(_mm_loadu_si64(s + 2 * sp), _mm_loadu_si64(s + 3 * sp)),
+        _mm_unpacklo_epi64(_mm_loadu_si64(s), _mm_loadu_si64(s + sp)));
+    const __m256i vec_rec = yy_set_m128i(
+        _mm_unpacklo_epi64(_mm_loadu_si64(r + 2 * rp), _mm_loadu_si64(r + 3 * rp)),
+        _mm_unpacklo_epi64(_mm_loadu_si64(r), _mm_loadu_si64(r + rp)));
+
+    uint32_t sum_s    = sum8(_mm256_madd_epi16(vec_src, one));
+    uint32_t sum_r    = sum8(_mm256_madd_epi16(vec_rec, one));
+    uint32_t sum_sq_s = sum8(_mm256_madd_epi16(vec_src, vec_src));
+    uint32_t sum_sq_r = sum8(_mm256_madd_epi16(vec_rec, vec_rec));
+    uint32_t sum_sxr  = sum8(_mm256_madd_epi16(vec_src, vec_rec));
+    double   score    = svt_aom_similarity(sum_s, sum_r, sum_sq_s, sum_sq_r, sum_sxr, 16, 10);
+    return score;
+}
 
-        __m256i vec_sxr = _mm256_mullo_epi32(vec_src, vec_rec);
-        vec_sum_sxr     = _mm256_add_epi32(vec_sum_sxr, vec_sxr);
+/* Transposes the per-pair sums of 4 blocks (low lane: blocks 0-1, high lane: blocks 2-3) to
+ * {sum_s, sum_r, sum_sq, sum_sxr} per block */
+static INLINE void store_4x4_sums(__m256i sum_s, __m256i sum_r, __m256i sum_sq, __m256i sum_sxr, uint32_t *sums) {
+    const __m256i sr = _mm256_hadd_epi32(sum_s, sum_r); // s0 s1 r0 r1 | s2 s3 r2 r3
+    const __m256i qx = _mm256_hadd_epi32(sum_sq, sum_sxr); // q0 q1 x0 x1 | q2 q3 x2 x3
+    const __m256i t0 = _mm256_unpacklo_epi32(sr, qx); // s0 q0 s1 q1
+    const __m256i t1 = _mm256_unpackhi_epi32(sr, qx); // r0 x0 r1 x1
+    const __m256i b0 = _mm256_unpacklo_epi32(t0, t1); // s0 r0 q0 x0 | block 2
+    const __m256i b1 = _mm256_unpackhi_epi32(t0, t1); // s1 r1 q1 x1 | block 3
+    _mm256_storeu_si256((__m256i *)sums, _mm256_permute2x128_si256(b0, b1, 0x20));
+    _mm256_storeu_si256((__m256i *)(sums + 8), _mm256_permute2x128_si256(b0, b1, 0x31));
+}
 
-        s += sp;
-        r += rp;
+void svt_ssim_4x4_sums_avx2(const uint8_t *s, uint32_t sp, const uint8_t *r, uint32_t rp, uint32_t count,
+                            uint32_t *sums) {
+    const __m256i one = _mm256_set1_epi16(1);
+    uint32_t      i   = 0;
+    for (; i + 4 <= count; i += 4) {
+        __m256i vec_sum    = _mm256_setzero_si256();
+        __m256i vec_sum_r  = _mm256_setzero_si256();
+        __m256i vec_sum_sq = _mm256_setzero_si256();
+        __m256i vec_sxr    = _mm256_setzero_si256();
+        for (int y = 0; y < 4; ++y) {
+            const __m256i vec_src = _mm256_cvtepu8_epi16(_mm_loadu_si128((const __m128i *)(s + y * sp + 4 * i)));
+            const __m256i vec_rec = _mm256_cvtepu8_epi16(_mm_loadu_si128((const __m128i *)(r + y * rp + 4 * i)));
+            vec_sum               = _mm256_add_epi16(vec_sum, vec_src);
+            vec_sum_r             = _mm256_add_epi16(vec_sum_r, vec_rec);
+            vec_sum_sq            = _mm256_add_epi32(vec_sum_sq, _mm256_madd_epi16(vec_src, vec_src));
+            vec_sum_sq            = _mm256_add_epi32(vec_sum_sq, _mm256_madd_epi16(vec_rec, vec_rec));
+            vec_sxr               = _mm256_add_epi32(vec_sxr, _mm256_madd_epi16(vec_src, vec_rec));
+        }
+        store_4x4_sums(_mm256_madd_epi16(vec_sum, one),
+                       _mm256_madd_epi16(vec_sum_r, one),
+                       vec_sum_sq,
+                       vec_sxr,
+                       sums + 4 * i);
     }
+    if (i < count)
+        svt_ssim_4x4_sums_c(s + 4 * i, sp, r + 4 * i, rp, count - i, sums + 4 * i);
+}
 
-    uint32_t sum_s    = sum8(vec_sum_s);
-    uint32_t sum_r    = sum8(vec_sum_r);
-    uint32_t sum_sq_s = sum8(vec_sum_sq_s);
-    uint32_t sum_sq_r = sum8(vec_sum_sq_r);
-    uint32_t sum_sxr  = sum8(vec_sum_sxr);
-    double   score    = similarity(sum_s, sum_r, sum_sq_s, sum_sq_r, sum_sxr, 16, 10);
-    return score;
+void svt_ssim_4x4_sums_hbd_avx2(const uint16_t *s, uint32_t sp, const uint16_t *r, uint32_t rp, uint32_t count,
+                                uint32_t *sums) {
+    const __m256i one = _mm256_set1_epi16(1);
+    uint32_t      i   = 0;
+    for (; i + 4 <= count; i += 4) {
+        __m256i vec_sum    = _mm256_setzero_si256();
+        __m256i vec_sum_r  = _mm256_setzero_si256();
+        __m256i vec_sum_sq = _mm256_setzero_si256();
+        __m256i vec_sxr    = _mm256_setzero_si256();
+        for (int y = 0; y < 4; ++y) {
+            // up to 12-bit samples, 4 rows of them still fit the 16-bit lanes
+            const __m256i vec_src = _mm256_loadu_si256((const __m256i *)(s + y * sp + 4 * i));
+            const __m256i vec_rec = _mm256_loadu_si256((const __m256i *)(r + y * rp + 4 * i));
+            vec_sum               = _mm256_add_epi16(vec_sum, vec_src);
+            vec_sum_r             = _mm256_add_epi16(vec_sum_r, vec_rec);
+            vec_sum_sq            = _mm256_add_epi32(vec_sum_sq, _mm256_madd_epi16(vec_src, vec_src));
+            vec_sum_sq            = _mm256_add_epi32(vec_sum_sq, _mm256_madd_epi16(vec_rec, vec_rec));
+            vec_sxr               = _mm256_add_epi32(vec_sxr, _mm256_madd_epi16(vec_src, vec_rec));
+        }
+        store_4x4_sums(_mm256_madd_epi16(vec_sum, one),
+                       _mm256_madd_epi16(vec_sum_r, one),
+                       vec_sum_sq,
+                       vec_sxr,
+                       sums + 4 * i);
+    }
+    if (i < count)
+        svt_ssim_4x4_sums_hbd_c(s + 4 * i, sp, r + 4 * i, rp, count - i, sums + 4 * i);
 }
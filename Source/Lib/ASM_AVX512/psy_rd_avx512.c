@@ -0,0 +1,218 @@
+/*
+* Copyright (c) 2024, Alliance for Open Media. All rights reserved
+*
+* This source code is subject to the terms of the BSD 2 Clause License and
+* the Alliance for Open Media Patent License 1.0. If the BSD 2 Clause License
+* was not distributed with this source code in the LICENSE file, you can
+* obtain it at https://www.aomedia.org/license/software-license. If the Alliance for Open
+* Media Patent License 1.0 was not distributed with this source code in the
+* PATENTS file, you can obtain it at https://www.aomedia.org/license/patent-license.
+*/
+#include "definitions.h"
+
+#if EN_AVX512_SUPPORT
+
+#include <immintrin.h>
+#include <stdlib.h>
+#include "common_dsp_rtcd.h"
+#include "transpose_sse2.h"
+
+/*
+ * Same lane arithmetic as psy_rd_avx2.c, but the input block goes in the low 256 bits and
+ * the recon block in the high 256 bits so both energies come out of a single pass.
+ */
+
+static INLINE __m512i psy_abs_packed_avx512(const __m512i a) {
+    const __m512i s = _mm512_and_si512(_mm512_srli_epi32(a, 15), _mm512_set1_epi32(0x10001));
+    const __m512i m = _mm512_sub_epi32(_mm512_slli_epi32(s, 16), s);
+    return _mm512_xor_si512(_mm512_add_epi32(a, m), m);
+}
+
+static INLINE __m512i psy_pack_pair_avx512(const __m512i a0, const __m512i a1) {
+    return _mm512_add_epi32(_mm512_add_epi32(a0, a1), _mm512_slli_epi32(_mm512_sub_epi32(a0, a1), 16));
+}
+
+static INLINE void psy_hadamard4_avx512(const __m512i s0, const __m512i s1, const __m512i s2, const __m512i s3,
+                                        __m512i *d0, __m512i *d1, __m512i *d2, __m512i *d3) {
+    const __m512i t0 = _mm512_add_epi32(s0, s1);
+    const __m512i t1 = _mm512_sub_epi32(s0, s1);
+    const __m512i t2 = _mm512_add_epi32(s2, s3);
+    const __m512i t3 = _mm512_sub_epi32(s2, s3);
+    *d0              = _mm512_add_epi32(t0, t2);
+    *d2              = _mm512_sub_epi32(t0, t2);
+    *d1              = _mm512_add_epi32(t1, t3);
+    *d3              = _mm512_sub_epi32(t1, t3);
+}
+
+static INLINE int psy_sum_8x8_avx512(const __m128i *const row) {
+    __m128i acc = row[0];
+    for (int i = 1; i < 8; i++) acc = _mm_add_epi16(acc, row[i]);
+    acc = _mm_madd_epi16(acc, _mm_set1_epi16(1));
+    acc = _mm_add_epi32(acc, _mm_srli_si128(acc, 8));
+    acc = _mm_add_epi32(acc, _mm_srli_si128(acc, 4));
+    return _mm_cvtsi128_si32(acc);
+}
+
+/* (uint16_t)b0 + (b0 >> 16) summed over the 4 columns of one block, then rounded like svt_sa8d_8x8() */
+static INLINE int psy_sa8d_finish(const __m256i sum_lo, const __m256i sum_hi) {
+    const __m128i l = _mm_add_epi32(_mm256_castsi256_si128(sum_lo), _mm256_extracti128_si256(sum_lo, 1));
+    const __m128i h = _mm_add_epi32(_mm256_castsi256_si128(sum_hi), _mm256_extracti128_si256(sum_hi, 1));
+    __m128i c = _mm_add_epi32(_mm_add_epi32(_mm_and_si128(l, _mm_set1_epi32(0xffff)), _mm_srli_epi32(l, 16)), h);
+    c         = _mm_add_epi32(c, _mm_srli_si128(c, 8));
+    c         = _mm_add_epi32(c, _mm_srli_si128(c, 4));
+    const uint32_t sum = (uint32_t)_mm_cvtsi128_si32(c);
+
+    return ((int)sum + 2) >> 2;
+}
+
+/* Energies of two 8x8 blocks at once, the first in the low 256 bits and the second in the high 256 bits */
+static INLINE void psy_energy_pair_8x8_avx512(const __m128i *const in_row, const __m128i *const rec_row, int *in_nrg,
+                                              int *rec_nrg) {
+    __m128i in_col[8], rec_col[8];
+    __m512i a[8];
+    __m512i h0, h1, h2, h3, v0, v1, v2, v3;
+
+    transpose_16bit_8x8(in_row, in_col);
+    transpose_16bit_8x8(rec_row, rec_col);
+    for (int i = 0; i < 8; i++)
+        a[i] = _mm512_inserti64x4(
+            _mm512_castsi256_si512(_mm256_cvtepi16_epi32(in_col[i])), _mm256_cvtepi16_epi32(rec_col[i]), 1);
+
+    psy_hadamard4_avx512(psy_pack_pair_avx512(a[0], a[1]),
+                         psy_pack_pair_avx512(a[2], a[3]),
+                         psy_pack_pair_avx512(a[4], a[5]),
+                         psy_pack_pair_avx512(a[6], a[7]),
+                         &h0,
+                         &h1,
+                         &h2,
+                         &h3);
+
+    // 128-bit lanes of r[i]: input row i, input row i + 4, recon row i, recon row i + 4
+    const __m512i u0 = _mm512_unpacklo_epi32(h0, h1);
+    const __m512i u1 = _mm512_unpackhi_epi32(h0, h1);
+    const __m512i u2 = _mm512_unpacklo_epi32(h2, h3);
+    const __m512i u3 = _mm512_unpackhi_epi32(h2, h3);
+    psy_hadamard4_avx512(_mm512_unpacklo_epi64(u0, u2),
+                         _mm512_unpackhi_epi64(u0, u2),
+                         _mm512_unpacklo_epi64(u1, u3),
+                         _mm512_unpackhi_epi64(u1, u3),
+                         &v0,
+                         &v1,
+                         &v2,
+                         &v3);
+
+    const __m512i mask_lo = _mm512_set1_epi32(0xffff);
+    const __m512i v[4]    = {v0, v1, v2, v3};
+    __m512i       sum_lo  = _mm512_setzero_si512();
+    __m512i       sum_hi  = _mm512_setzero_si512();
+    for (int m = 0; m < 4; m++) {
+        // a[m] +/- a[m + 4] for both blocks: lanes become sum, difference, sum, difference
+        const __m512i x = _mm512_shuffle_i64x2(v[m], v[m], _MM_SHUFFLE(2, 2, 0, 0));
+        const __m512i y = _mm512_shuffle_i64x2(v[m], v[m], _MM_SHUFFLE(3, 3, 1, 1));
+        const __m512i w = psy_abs_packed_avx512(_mm512_mask_sub_epi32(_mm512_add_epi32(x, y), 0xF0F0, x, y));
+        sum_lo          = _mm512_add_epi32(sum_lo, _mm512_and_si512(w, mask_lo));
+        sum_hi          = _mm512_add_epi32(sum_hi, _mm512_srli_epi32(w, 16));
+    }
+
+    *in_nrg  = (psy_sa8d_finish(_mm512_castsi512_si256(sum_lo), _mm512_castsi512_si256(sum_hi)) >> 8) -
+        (psy_sum_8x8_avx512(in_row) >> 2);
+    *rec_nrg = (psy_sa8d_finish(_mm512_extracti64x4_epi64(sum_lo, 1), _mm512_extracti64x4_epi64(sum_hi, 1)) >> 8) -
+        (psy_sum_8x8_avx512(rec_row) >> 2);
+}
+
+/* Returns |input_nrg - recon_nrg| for one 8x8 block */
+static INLINE uint32_t psy_energy_diff_8x8_avx512(const __m128i *const in_row, const __m128i *const rec_row) {
+    int input_nrg, recon_nrg;
+    psy_energy_pair_8x8_avx512(in_row, rec_row, &input_nrg, &recon_nrg);
+    return (uint32_t)abs(input_nrg - recon_nrg);
+}
+
+static INLINE void psy_load_8x8(const uint8_t *src, uint32_t stride, __m128i *const row) {
+    for (int i = 0; i < 8; i++, src += stride) row[i] = _mm_cvtepu8_epi16(_mm_loadl_epi64((const __m128i *)src));
+}
+
+static INLINE void psy_load_8x8_hbd(const uint16_t *src, uint32_t stride, __m128i *const row) {
+    for (int i = 0; i < 8; i++, src += stride) row[i] = _mm_loadu_si128((const __m128i *)src);
+}
+
+uint64_t svt_psy_distortion_avx512(const uint8_t *input, uint32_t input_stride, const uint8_t *recon,
+                                   uint32_t recon_stride, uint32_t width, uint32_t height, const uint32_t count) {
+    if (count < 64)
+        return svt_psy_distortion_c(input, input_stride, recon, recon_stride, width, height, count);
+
+    uint32_t total_nrg = 0;
+    __m128i  in_row[8], rec_row[8];
+
+    for (uint64_t i = 0; i < height; i += 8) {
+        for (uint64_t j = 0; j < width; j += 8) {
+            psy_load_8x8(input + i * input_stride + j, input_stride, in_row);
+            psy_load_8x8(recon + i * recon_stride + j, recon_stride, rec_row);
+            total_nrg += psy_energy_diff_8x8_avx512(in_row, rec_row);
+        }
+    }
+    return (total_nrg << 2);
+}
+
+uint64_t svt_psy_distor_hbd_avx512(const uint16_t *input, uint32_t input_stride, const uint16_t *recon,
+                                   uint32_t recon_stride, uint32_t width, uint32_t height, const uint32_t count) {
+    if (count < 64)
+        return svt_psy_distor_hbd_c(input, input_stride, recon, recon_stride, width, height, count);
+
+    uint32_t total_nrg = 0;
+    __m128i  in_row[8], rec_row[8];
+
+    for (uint64_t i = 0; i < height; i += 8) {
+        for (uint64_t j = 0; j < width; j += 8) {
+            psy_load_8x8_hbd(input + i * input_stride + j, input_stride, in_row);
+            psy_load_8x8_hbd(recon + i * recon_stride + j, recon_stride, rec_row);
+            total_nrg += psy_energy_diff_8x8_avx512(in_row, rec_row);
+        }
+    }
+    return (total_nrg << 2);
+}
+
+/* Horizontally adjacent blocks are paired up, an odd block count leaves one for a pair with itself */
+void svt_psy_ac_energy_avx512(const uint8_t *src, uint32_t stride, uint32_t width, uint32_t height, int32_t *nrg) {
+    __m128i a_row[8], b_row[8];
+    int     a_nrg, b_nrg;
+
+    for (uint64_t i = 0; i < height; i += 8) {
+        uint64_t j = 0;
+        for (; j + 8 < width; j += 16) {
+            psy_load_8x8(src + i * stride + j, stride, a_row);
+            psy_load_8x8(src + i * stride + j + 8, stride, b_row);
+            psy_energy_pair_8x8_avx512(a_row, b_row, &a_nrg, &b_nrg);
+            *nrg++ = a_nrg;
+            *nrg++ = b_nrg;
+        }
+        if (j < width) {
+            psy_load_8x8(src + i * stride + j, stride, a_row);
+            psy_energy_pair_8x8_avx512(a_row, a_row, &a_nrg, &b_nrg);
+            *nrg++ = a_nrg;
+        }
+    }
+}
+
+void svt_psy_ac_energy_hbd_avx512(const uint16_t *src, uint32_t stride, uint32_t width, uint32_t height,
+                                  int32_t *nrg) {
+    __m128i a_row[8], b_row[8];
+    int     a_nrg, b_nrg;
+
+    for (uint64_t i = 0; i < height; i += 8) {
+        uint64_t j = 0;
+        for (; j + 8 < width; j += 16) {
+            psy_load_8x8_hbd(src + i * stride + j, stride, a_row);
+            psy_load_8x8_hbd(src + i * stride + j + 8, stride, b_row);
+            psy_energy_pair_8x8_avx512(a_row, b_row, &a_nrg, &b_nrg);
+            *nrg++ = a_nrg;
+            *nrg++ = b_nrg;
+        }
+        if (j < width) {
+            psy_load_8x8_hbd(src + i * stride + j, stride, a_row);
+            psy_energy_pair_8x8_avx512(a_row, a_row, &a_nrg, &b_nrg);
+            *nrg++ = a_nrg;
+        }
+    }
+}
+
+#endif // EN_AVX512_SUPPORT
@@ -10,10 +10,13 @@
 */
 
 #include <arm_neon.h>
+#include <string.h>
 
 #include "definitions.h"
 #include <math.h>
 
+#define TOTAL_STRENGTHS (CDEF_PRI_STRENGTHS * CDEF_SEC_STRENGTHS)
+
 static INLINE uint32_t sum32(const int32x4_t src) {
     int32x4_t dst;
 
@@ -470,3 +473,61 @@ uint64_t svt_aom_compute_cdef_dist_16bit_neon(const uint16_t *dst, int32_t dstri
 
     return sum >> 2 * coeff_shift;
 }
+
+void svt_search_one_dual_tot_mse_neon(int *lev0, int *lev1, int nb_strengths, uint64_t **mse[2], int sb_count,
+                                      int start_gi, int end_gi, uint64_t *tot_mse) {
+    for (int i = 0; i < sb_count; i++) {
+        uint64_t best_mse = (uint64_t)1 << 63;
+        /* Find best mse among already selected options. */
+        for (int gi = 0; gi < nb_strengths; gi++) {
+            uint64_t curr = mse[0][i][lev0[gi]] + mse[1][i][lev1[gi]];
+            if (curr < best_mse)
+                best_mse = curr;
+        }
+        const uint64x2_t best_mse_ = vdupq_n_u64(best_mse);
+        /* Find best mse when adding each possible new option. */
+        for (int j = start_gi; j < end_gi; ++j) {
+            const uint64x2_t luma = vdupq_n_u64(mse[0][i][j]);
+            uint64_t        *tot  = tot_mse + j * TOTAL_STRENGTHS;
+            int              k    = start_gi;
+            for (; k + 4 <= end_gi; k += 4) {
+                const uint64x2_t curr_lo = vaddq_u64(luma, vld1q_u64(&mse[1][i][k]));
+                const uint64x2_t curr_hi = vaddq_u64(luma, vld1q_u64(&mse[1][i][k + 2]));
+                const uint64x2_t best_lo = vbslq_u64(vcltq_u64(curr_lo, best_mse_), curr_lo, best_mse_);
+                const uint64x2_t best_hi = vbslq_u64(vcltq_u64(curr_hi, best_mse_), curr_hi, best_mse_);
+                vst1q_u64(&tot[k], vaddq_u64(vld1q_u64(&tot[k]), best_lo));
+                vst1q_u64(&tot[k + 2], vaddq_u64(vld1q_u64(&tot[k + 2]), best_hi));
+            }
+            for (; k < end_gi; k++) {
+                const uint64_t curr = mse[0][i][j] + mse[1][i][k];
+                tot[k] += curr < best_mse ? curr : best_mse;
+            }
+        }
+    }
+}
+
+/* Search for the best luma+chroma strength to add as an option, knowing we
+already selected nb_strengths options. */
+uint64_t svt_search_one_dual_neon(int *lev0, int *lev1, int nb_strengths, uint64_t **mse[2], int sb_count, int start_gi,
+                                  int end_gi) {
+    DECLARE_ALIGNED(16, uint64_t, tot_mse[TOTAL_STRENGTHS][TOTAL_STRENGTHS]);
+    uint64_t best_tot_mse = (uint64_t)1 << 63;
+    int      best_id0     = 0;
+    int      best_id1     = 0;
+
+    memset(tot_mse, 0, sizeof(tot_mse));
+    svt_search_one_dual_tot_mse_neon(lev0, lev1, nb_strengths, mse, sb_count, start_gi, end_gi, tot_mse[0]);
+    for (int j = start_gi; j < end_gi; j++) {
+        for (int k = start_gi; k < end_gi; k++) {
+            if (tot_mse[j][k] < best_tot_mse) {
+                best_tot_mse = tot_mse[j][k];
+                best_id0     = j;
+                best_id1     = k;
+            }
+        }
+    }
+    lev0[nb_strengths] = best_id0;
+    lev1[nb_strengths] = best_id1;
+
+    return best_tot_mse;
+}
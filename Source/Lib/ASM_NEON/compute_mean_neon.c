@@ -0,0 +1,49 @@
+/*
+* Copyright (c) 2024, Alliance for Open Media. All rights reserved
+*
+* This source code is subject to the terms of the BSD 2 Clause License and
+* the Alliance for Open Media Patent License 1.0. If the BSD 2 Clause License
+* was not distributed with this source code in the LICENSE file, you can
+* obtain it at www.aomedia.org/license/software. If the Alliance for Open
+* Media Patent License 1.0 was not distributed with this source code in the
+* PATENTS file, you can obtain it at www.aomedia.org/license/patent.
+*/
+
+#include <arm_neon.h>
+#include "aom_dsp_rtcd.h"
+#include "definitions.h"
+
+void svt_compute_mean_8x8_64x64_neon(uint8_t *input_samples, uint32_t input_stride, Bool subsample,
+                                     uint64_t *mean_of8x8_blocks, uint64_t *mean_of_squared8x8_blocks) {
+    const uint32_t step          = subsample ? 2 : 1;
+    const int      mean_shift    = subsample ? 3 : 2;
+    const int      squared_shift = subsample ? 11 : 10;
+
+    for (uint32_t blk_row = 0; blk_row < 8; blk_row++) {
+        uint16x8_t sum[4];
+        uint32x4_t squared[8];
+        for (int i = 0; i < 4; i++) sum[i] = vdupq_n_u16(0);
+        for (int i = 0; i < 8; i++) squared[i] = vdupq_n_u32(0);
+
+        for (uint32_t y = 0; y < 8; y += step) {
+            for (int i = 0; i < 4; i++) {
+                const uint8x16_t in = vld1q_u8(input_samples + 16 * i);
+                sum[i]              = vpadalq_u8(sum[i], in);
+                squared[2 * i]      = vpadalq_u16(squared[2 * i], vmull_u8(vget_low_u8(in), vget_low_u8(in)));
+                squared[2 * i + 1]  = vpadalq_u16(squared[2 * i + 1], vmull_u8(vget_high_u8(in), vget_high_u8(in)));
+            }
+            input_samples += step * input_stride;
+        }
+
+        for (int i = 0; i < 4; i++) {
+            // lane 0: left 8x8 block, lane 1: right 8x8 block
+            const uint64x2_t sum_64 = vpaddlq_u32(vpaddlq_u16(sum[i]));
+            mean_of8x8_blocks[2 * i]     = vgetq_lane_u64(sum_64, 0) << mean_shift;
+            mean_of8x8_blocks[2 * i + 1] = vgetq_lane_u64(sum_64, 1) << mean_shift;
+            mean_of_squared8x8_blocks[2 * i]     = (uint64_t)vaddvq_u32(squared[2 * i]) << squared_shift;
+            mean_of_squared8x8_blocks[2 * i + 1] = (uint64_t)vaddvq_u32(squared[2 * i + 1]) << squared_shift;
+        }
+        mean_of8x8_blocks += 8;
+        mean_of_squared8x8_blocks += 8;
+    }
+}
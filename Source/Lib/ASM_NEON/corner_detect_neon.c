@@ -0,0 +1,63 @@
+/*
+ * Copyright (c) 2016, Alliance for Open Media. All rights reserved
+ *
+ * This source code is subject to the terms of the BSD 2 Clause License and
+ * the Alliance for Open Media Patent License 1.0. If the BSD 2 Clause License
+ * was not distributed with this source code in the LICENSE file, you can
+ * obtain it at https://www.aomedia.org/license/software-license. If the Alliance for Open
+ * Media Patent License 1.0 was not distributed with this source code in the
+ * PATENTS file, you can obtain it at https://www.aomedia.org/license/patent-license.
+ */
+
+#include <arm_neon.h>
+#include "aom_dsp_rtcd.h"
+#include "corner_detect.h"
+
+/* Scores 8 corners at once, one corner per 16-bit lane, using the same window
+ * min/max reduction as the AVX2 version. */
+void svt_av1_fast9_score_neon(const uint8_t *im, int stride, const int *corners_xy, int num_corners, int b,
+                              int *scores) {
+    int offsets[16];
+    svt_av1_fast9_circle_offsets(offsets, stride);
+    const int16x8_t vb = vdupq_n_s16((int16_t)b);
+
+    int n = 0;
+    for (; n + 8 <= num_corners; n += 8) {
+        uint8_t pix[17][8];
+        for (int i = 0; i < 8; i++) {
+            const uint8_t *p = im + corners_xy[2 * (n + i) + 1] * stride + corners_xy[2 * (n + i)];
+            pix[16][i]       = p[0];
+            for (int k = 0; k < 16; k++) pix[k][i] = p[offsets[k]];
+        }
+        const int16x8_t c = vreinterpretq_s16_u16(vmovl_u8(vld1_u8(pix[16])));
+        int16x8_t       d[16], mn[16], mx[16];
+        for (int k = 0; k < 16; k++) d[k] = vsubq_s16(vreinterpretq_s16_u16(vmovl_u8(vld1_u8(pix[k]))), c);
+        for (int k = 0; k < 16; k++) {
+            mn[k] = vminq_s16(d[k], d[(k + 1) & 15]);
+            mx[k] = vmaxq_s16(d[k], d[(k + 1) & 15]);
+        }
+        for (int w = 2; w <= 4; w <<= 1) {
+            int16x8_t mn_w[16], mx_w[16];
+            for (int k = 0; k < 16; k++) {
+                mn_w[k] = vminq_s16(mn[k], mn[(k + w) & 15]);
+                mx_w[k] = vmaxq_s16(mx[k], mx[(k + w) & 15]);
+            }
+            for (int k = 0; k < 16; k++) {
+                mn[k] = mn_w[k];
+                mx[k] = mx_w[k];
+            }
+        }
+        int16x8_t bright = vdupq_n_s16(-255);
+        int16x8_t dark   = vdupq_n_s16(255);
+        for (int k = 0; k < 16; k++) {
+            bright = vmaxq_s16(bright, vminq_s16(mn[k], d[(k + 8) & 15]));
+            dark   = vminq_s16(dark, vmaxq_s16(mx[k], d[(k + 8) & 15]));
+        }
+        const int16x8_t s     = vmaxq_s16(bright, vnegq_s16(dark));
+        const int16x8_t score = vmaxq_s16(vb, vsubq_s16(s, vdupq_n_s16(1)));
+        vst1q_s32(scores + n, vmovl_s16(vget_low_s16(score)));
+        vst1q_s32(scores + n + 4, vmovl_s16(vget_high_s16(score)));
+    }
+    if (n < num_corners)
+        svt_av1_fast9_score_c(im, stride, corners_xy + 2 * n, num_corners - n, b, scores + n);
+}
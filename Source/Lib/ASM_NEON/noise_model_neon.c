@@ -0,0 +1,130 @@
+/*
+ * Copyright (c) 2016, Alliance for Open Media. All rights reserved
+ *
+ * This source code is subject to the terms of the BSD 2 Clause License and
+ * the Alliance for Open Media Patent License 1.0. If the BSD 2 Clause License
+ * was not distributed with this source code in the LICENSE file, you can
+ * obtain it at https://www.aomedia.org/license/software-license. If the Alliance for Open
+ * Media Patent License 1.0 was not distributed with this source code in the
+ * PATENTS file, you can obtain it at https://www.aomedia.org/license/patent-license.
+ */
+
+#include <arm_neon.h>
+#include "aom_dsp_rtcd.h"
+#include "definitions.h"
+#include "noise_model.h"
+
+void svt_av1_add_block_observations_internal_neon(uint32_t n, const double val, const double recp_sqr_norm,
+                                                  double *buffer, double *buffer_norm, double *b, double *A) {
+    const float64x2_t recp_sqr_norm_pd = vdupq_n_f64(recp_sqr_norm);
+    const float64x2_t val_pd           = vdupq_n_f64(val);
+    uint32_t          i;
+
+    for (i = 0; i + 4 <= n; i += 4) {
+        const float64x2_t norm0 = vmulq_f64(vld1q_f64(buffer + i), recp_sqr_norm_pd);
+        const float64x2_t norm1 = vmulq_f64(vld1q_f64(buffer + i + 2), recp_sqr_norm_pd);
+        vst1q_f64(buffer_norm + i, norm0);
+        vst1q_f64(buffer_norm + i + 2, norm1);
+        vst1q_f64(b + i, vaddq_f64(vld1q_f64(b + i), vmulq_f64(norm0, val_pd)));
+        vst1q_f64(b + i + 2, vaddq_f64(vld1q_f64(b + i + 2), vmulq_f64(norm1, val_pd)));
+    }
+    for (; i < n; ++i) {
+        buffer_norm[i] = buffer[i] * recp_sqr_norm;
+        b[i] += buffer_norm[i] * val;
+    }
+
+    for (i = 0; i < n; ++i) {
+        const double      buffer_norm_i  = buffer_norm[i];
+        const float64x2_t buffer_norm_pd = vdupq_n_f64(buffer_norm_i);
+        double           *a_row          = A + i * n;
+        uint32_t          j;
+        for (j = 0; j + 4 <= n; j += 4) {
+            vst1q_f64(a_row + j, vaddq_f64(vld1q_f64(a_row + j), vmulq_f64(vld1q_f64(buffer + j), buffer_norm_pd)));
+            vst1q_f64(a_row + j + 2,
+                      vaddq_f64(vld1q_f64(a_row + j + 2), vmulq_f64(vld1q_f64(buffer + j + 2), buffer_norm_pd)));
+        }
+        for (; j < n; ++j) a_row[j] += buffer_norm_i * buffer[j];
+    }
+}
+
+void svt_av1_pointwise_multiply_neon(const float *a, float *b, float *c, double *b_d, double *c_d, int32_t n) {
+    int32_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        const float32x4_t a_ps = vld1q_f32(a + i);
+        const float32x4_t b_ps = vcvt_high_f32_f64(vcvt_f32_f64(vld1q_f64(b_d + i)), vld1q_f64(b_d + i + 2));
+        const float32x4_t c_ps = vcvt_high_f32_f64(vcvt_f32_f64(vld1q_f64(c_d + i)), vld1q_f64(c_d + i + 2));
+        vst1q_f32(b + i, vmulq_f32(a_ps, b_ps));
+        vst1q_f32(c + i, vmulq_f32(a_ps, c_ps));
+    }
+    for (; i < n; i++) {
+        b[i] = a[i] * (float)b_d[i];
+        c[i] = a[i] * (float)c_d[i];
+    }
+}
+
+void svt_av1_apply_window_function_to_plane_neon(int32_t y_size, int32_t x_size, float *result_ptr,
+                                                 uint32_t result_stride, float *block, float *plane,
+                                                 const float *window_function) {
+    for (int32_t y = 0; y < y_size; ++y) {
+        float  *res = result_ptr + y * result_stride;
+        int32_t x   = 0;
+        for (; x + 4 <= x_size; x += 4) {
+            const float32x4_t sum = vaddq_f32(vld1q_f32(block + y * x_size + x), vld1q_f32(plane + y * x_size + x));
+            const float32x4_t wnd = vmulq_f32(sum, vld1q_f32(window_function + y * x_size + x));
+            vst1q_f32(res + x, vaddq_f32(wnd, vld1q_f32(res + x)));
+        }
+        for (; x < x_size; ++x)
+            res[x] += (block[y * x_size + x] + plane[y * x_size + x]) * window_function[y * x_size + x];
+    }
+}
+
+/* One block per lane as in the AVX2 version, the four blocks are spread over
+ * two vectors. */
+void svt_aom_flat_block_finder_block_stats_neon(const double *blocks, int32_t block_size, int32_t num_blocks,
+                                                double *stats) {
+    const int32_t n = block_size * block_size;
+    if (num_blocks != FLAT_BLOCK_STATS_BATCH || block_size > 32 || (n & 1)) {
+        svt_aom_flat_block_finder_block_stats_c(blocks, block_size, num_blocks, stats);
+        return;
+    }
+    DECLARE_ALIGNED(16, double, tb[32 * 32 * 4]);
+    const double *b0 = blocks, *b1 = blocks + n, *b2 = blocks + 2 * n, *b3 = blocks + 3 * n;
+    for (int32_t i = 0; i < n; i += 2) {
+        const float64x2_t a = vld1q_f64(b0 + i);
+        const float64x2_t b = vld1q_f64(b1 + i);
+        const float64x2_t c = vld1q_f64(b2 + i);
+        const float64x2_t d = vld1q_f64(b3 + i);
+        vst1q_f64(tb + 4 * i + 0, vzip1q_f64(a, b));
+        vst1q_f64(tb + 4 * i + 2, vzip1q_f64(c, d));
+        vst1q_f64(tb + 4 * i + 4, vzip2q_f64(a, b));
+        vst1q_f64(tb + 4 * i + 6, vzip2q_f64(c, d));
+    }
+
+    const float64x2_t half = vdupq_n_f64(0.5);
+    float64x2_t       g_xx[2], g_xy[2], g_yy[2], mean[2], var[2];
+    for (int32_t k = 0; k < 2; ++k) g_xx[k] = g_xy[k] = g_yy[k] = mean[k] = var[k] = vdupq_n_f64(0);
+    for (int32_t yi = 1; yi < block_size - 1; ++yi) {
+        for (int32_t xi = 1; xi < block_size - 1; ++xi) {
+            const double *p = tb + 4 * (yi * block_size + xi);
+            for (int32_t k = 0; k < 2; ++k) {
+                const double     *q  = p + 2 * k;
+                const float64x2_t v  = vld1q_f64(q);
+                const float64x2_t gx = vmulq_f64(vsubq_f64(vld1q_f64(q + 4), vld1q_f64(q - 4)), half);
+                const float64x2_t gy = vmulq_f64(
+                    vsubq_f64(vld1q_f64(q + 4 * block_size), vld1q_f64(q - 4 * block_size)), half);
+                g_xx[k] = vaddq_f64(g_xx[k], vmulq_f64(gx, gx));
+                g_xy[k] = vaddq_f64(g_xy[k], vmulq_f64(gx, gy));
+                g_yy[k] = vaddq_f64(g_yy[k], vmulq_f64(gy, gy));
+                mean[k] = vaddq_f64(mean[k], v);
+                var[k]  = vaddq_f64(var[k], vmulq_f64(v, v));
+            }
+        }
+    }
+    for (int32_t k = 0; k < 2; ++k) {
+        vst1q_f64(stats + 0 * FLAT_BLOCK_STATS_BATCH + 2 * k, g_xx[k]);
+        vst1q_f64(stats + 1 * FLAT_BLOCK_STATS_BATCH + 2 * k, g_xy[k]);
+        vst1q_f64(stats + 2 * FLAT_BLOCK_STATS_BATCH + 2 * k, g_yy[k]);
+        vst1q_f64(stats + 3 * FLAT_BLOCK_STATS_BATCH + 2 * k, mean[k]);
+        vst1q_f64(stats + 4 * FLAT_BLOCK_STATS_BATCH + 2 * k, var[k]);
+    }
+}
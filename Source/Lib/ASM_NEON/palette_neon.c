@@ -0,0 +1,261 @@
+/*
+ * Copyright (c) 2016, Alliance for Open Media. All rights reserved
+ *
+ * This source code is subject to the terms of the BSD 2 Clause License and
+ * the Alliance for Open Media Patent License 1.0. If the BSD 2 Clause License
+ * was not distributed with this source code in the LICENSE file, you can
+ * obtain it at https://www.aomedia.org/license/software-license. If the Alliance for Open
+ * Media Patent License 1.0 was not distributed with this source code in the
+ * PATENTS file, you can obtain it at https://www.aomedia.org/license/patent-license.
+ */
+
+#include <arm_neon.h>
+#include <string.h>
+#include "aom_dsp_rtcd.h"
+#include "definitions.h"
+#include "random.h"
+#include "utility.h"
+
+/* Nearest centroid of 8 points at once, the running minimum and its index are
+   kept in registers over all centroids. A strict less-than keeps the first
+   minimum as in C. Returns the sum of the distances to the chosen centroids. */
+static INLINE int64_t calc_indices_dist_dim1_neon(const int *data, const int *centroids, uint8_t *indices, int n,
+                                                  int k) {
+    int32x4_t cent[PALETTE_MAX_SIZE];
+    for (int j = 0; j < k; ++j) cent[j] = vdupq_n_s32(centroids[j]);
+    int64x2_t sum = vdupq_n_s64(0);
+    int       i   = 0;
+    for (; i + 8 <= n; i += 8) {
+        const int32x4_t d0    = vld1q_s32(data + i);
+        const int32x4_t d1    = vld1q_s32(data + i + 4);
+        int32x4_t       diff0 = vsubq_s32(d0, cent[0]);
+        int32x4_t       diff1 = vsubq_s32(d1, cent[0]);
+        int32x4_t       best0 = vmulq_s32(diff0, diff0);
+        int32x4_t       best1 = vmulq_s32(diff1, diff1);
+        uint32x4_t      idx0  = vdupq_n_u32(0);
+        uint32x4_t      idx1  = vdupq_n_u32(0);
+        for (int j = 1; j < k; ++j) {
+            const uint32x4_t jv    = vdupq_n_u32(j);
+            diff0                  = vsubq_s32(d0, cent[j]);
+            diff1                  = vsubq_s32(d1, cent[j]);
+            const int32x4_t  dist0 = vmulq_s32(diff0, diff0);
+            const int32x4_t  dist1 = vmulq_s32(diff1, diff1);
+            const uint32x4_t lt0   = vcltq_s32(dist0, best0);
+            const uint32x4_t lt1   = vcltq_s32(dist1, best1);
+            best0                  = vbslq_s32(lt0, dist0, best0);
+            best1                  = vbslq_s32(lt1, dist1, best1);
+            idx0                   = vbslq_u32(lt0, jv, idx0);
+            idx1                   = vbslq_u32(lt1, jv, idx1);
+        }
+        vst1_u8(indices + i, vmovn_u16(vcombine_u16(vmovn_u32(idx0), vmovn_u32(idx1))));
+        sum = vpadalq_s32(sum, best0);
+        sum = vpadalq_s32(sum, best1);
+    }
+    int64_t dist = vaddvq_s64(sum);
+    for (; i < n; ++i) {
+        int min_dist = (data[i] - centroids[0]) * (data[i] - centroids[0]);
+        indices[i]   = 0;
+        for (int j = 1; j < k; ++j) {
+            const int this_dist = (data[i] - centroids[j]) * (data[i] - centroids[j]);
+            if (this_dist < min_dist) {
+                min_dist   = this_dist;
+                indices[i] = j;
+            }
+        }
+        dist += min_dist;
+    }
+    return dist;
+}
+
+static INLINE int64_t calc_indices_dist_dim2_neon(const int *data, const int *centroids, uint8_t *indices, int n,
+                                                  int k) {
+    int32x4_t cent_x[PALETTE_MAX_SIZE], cent_y[PALETTE_MAX_SIZE];
+    for (int j = 0; j < k; ++j) {
+        cent_x[j] = vdupq_n_s32(centroids[2 * j]);
+        cent_y[j] = vdupq_n_s32(centroids[2 * j + 1]);
+    }
+    int64x2_t sum = vdupq_n_s64(0);
+    int       i   = 0;
+    for (; i + 8 <= n; i += 8) {
+        // deinterleave the (x, y) pairs of 2 x 4 points
+        const int32x4x2_t p0    = vld2q_s32(data + 2 * i);
+        const int32x4x2_t p1    = vld2q_s32(data + 2 * i + 8);
+        int32x4_t         dx0   = vsubq_s32(p0.val[0], cent_x[0]);
+        int32x4_t         dy0   = vsubq_s32(p0.val[1], cent_y[0]);
+        int32x4_t         dx1   = vsubq_s32(p1.val[0], cent_x[0]);
+        int32x4_t         dy1   = vsubq_s32(p1.val[1], cent_y[0]);
+        int32x4_t         best0 = vmlaq_s32(vmulq_s32(dx0, dx0), dy0, dy0);
+        int32x4_t         best1 = vmlaq_s32(vmulq_s32(dx1, dx1), dy1, dy1);
+        uint32x4_t        idx0  = vdupq_n_u32(0);
+        uint32x4_t        idx1  = vdupq_n_u32(0);
+        for (int j = 1; j < k; ++j) {
+            const uint32x4_t jv    = vdupq_n_u32(j);
+            dx0                    = vsubq_s32(p0.val[0], cent_x[j]);
+            dy0                    = vsubq_s32(p0.val[1], cent_y[j]);
+            dx1                    = vsubq_s32(p1.val[0], cent_x[j]);
+            dy1                    = vsubq_s32(p1.val[1], cent_y[j]);
+            const int32x4_t  dist0 = vmlaq_s32(vmulq_s32(dx0, dx0), dy0, dy0);
+            const int32x4_t  dist1 = vmlaq_s32(vmulq_s32(dx1, dx1), dy1, dy1);
+            const uint32x4_t lt0   = vcltq_s32(dist0, best0);
+            const uint32x4_t lt1   = vcltq_s32(dist1, best1);
+            best0                  = vbslq_s32(lt0, dist0, best0);
+            best1                  = vbslq_s32(lt1, dist1, best1);
+            idx0                   = vbslq_u32(lt0, jv, idx0);
+            idx1                   = vbslq_u32(lt1, jv, idx1);
+        }
+        vst1_u8(indices + i, vmovn_u16(vcombine_u16(vmovn_u32(idx0), vmovn_u32(idx1))));
+        sum = vpadalq_s32(sum, best0);
+        sum = vpadalq_s32(sum, best1);
+    }
+    int64_t dist = vaddvq_s64(sum);
+    for (; i < n; ++i) {
+        const int *p        = data + 2 * i;
+        int        min_dist = (p[0] - centroids[0]) * (p[0] - centroids[0]) +
+            (p[1] - centroids[1]) * (p[1] - centroids[1]);
+        indices[i] = 0;
+        for (int j = 1; j < k; ++j) {
+            const int this_dist = (p[0] - centroids[2 * j]) * (p[0] - centroids[2 * j]) +
+                (p[1] - centroids[2 * j + 1]) * (p[1] - centroids[2 * j + 1]);
+            if (this_dist < min_dist) {
+                min_dist   = this_dist;
+                indices[i] = j;
+            }
+        }
+        dist += min_dist;
+    }
+    return dist;
+}
+
+void svt_av1_calc_indices_dim1_neon(const int *data, const int *centroids, uint8_t *indices, int n, int k) {
+    calc_indices_dist_dim1_neon(data, centroids, indices, n, k);
+}
+
+void svt_av1_calc_indices_dim2_neon(const int *data, const int *centroids, uint8_t *indices, int n, int k) {
+    calc_indices_dist_dim2_neon(data, centroids, indices, n, k);
+}
+
+static INLINE void calc_centroids_neon(const int *data, int *centroids, const uint8_t *indices, int n, int k,
+                                       int dim) {
+    int          count[PALETTE_MAX_SIZE] = {0};
+    unsigned int rand_state              = (unsigned int)data[0];
+    assert(n <= 32768);
+    memset(centroids, 0, sizeof(centroids[0]) * k * dim);
+
+    for (int i = 0; i < n; ++i) {
+        const int index = indices[i];
+        assert(index < k);
+        ++count[index];
+        for (int j = 0; j < dim; ++j) centroids[index * dim + j] += data[i * dim + j];
+    }
+
+    for (int i = 0; i < k; ++i) {
+        if (count[i] == 0) {
+            memcpy(centroids + i * dim, data + (lcg_rand16(&rand_state) % n) * dim, sizeof(centroids[0]) * dim);
+        } else {
+            for (int j = 0; j < dim; ++j)
+                centroids[i * dim + j] = DIVIDE_AND_ROUND(centroids[i * dim + j], count[i]);
+        }
+    }
+}
+
+static INLINE void k_means_neon(const int *data, int *centroids, uint8_t *indices, int n, int k, int max_itr,
+                                int dim) {
+    int     pre_centroids[2 * PALETTE_MAX_SIZE];
+    uint8_t pre_indices[MAX_SB_SQUARE];
+
+    int64_t this_dist = dim == 1 ? calc_indices_dist_dim1_neon(data, centroids, indices, n, k)
+                                 : calc_indices_dist_dim2_neon(data, centroids, indices, n, k);
+
+    for (int i = 0; i < max_itr; ++i) {
+        const int64_t pre_dist = this_dist;
+        memcpy(pre_centroids, centroids, sizeof(pre_centroids[0]) * k * dim);
+        memcpy(pre_indices, indices, sizeof(pre_indices[0]) * n);
+
+        calc_centroids_neon(data, centroids, indices, n, k, dim);
+        this_dist = dim == 1 ? calc_indices_dist_dim1_neon(data, centroids, indices, n, k)
+                             : calc_indices_dist_dim2_neon(data, centroids, indices, n, k);
+
+        if (this_dist > pre_dist) {
+            memcpy(centroids, pre_centroids, sizeof(pre_centroids[0]) * k * dim);
+            memcpy(indices, pre_indices, sizeof(pre_indices[0]) * n);
+            break;
+        }
+        if (!memcmp(centroids, pre_centroids, sizeof(pre_centroids[0]) * k * dim))
+            break;
+    }
+}
+
+void svt_av1_k_means_dim1_neon(const int *data, int *centroids, uint8_t *indices, int n, int k, int max_itr) {
+    k_means_neon(data, centroids, indices, n, k, max_itr, 1);
+}
+
+void svt_av1_k_means_dim2_neon(const int *data, int *centroids, uint8_t *indices, int n, int k, int max_itr) {
+    k_means_neon(data, centroids, indices, n, k, max_itr, 2);
+}
+
+/* Number of non-zero bins in the histogram, n is a multiple of 4. */
+static INLINE int count_non_zero_bins_neon(const int *val_count, int n) {
+    uint32x4_t acc = vdupq_n_u32(0);
+    for (int i = 0; i < n; i += 4) {
+        const int32x4_t v = vld1q_s32(val_count + i);
+        acc               = vsubq_u32(acc, vtstq_s32(v, v));
+    }
+    return (int)vaddvq_u32(acc);
+}
+
+/* Runs of 16 (or 8) equal pixels are added to their bin at once, as in the
+   AVX2 version. */
+int svt_av1_count_colors_neon(const uint8_t *src, int stride, int rows, int cols, int *val_count) {
+    memset(val_count, 0, (1 << 8) * sizeof(val_count[0]));
+    for (int r = 0; r < rows; ++r) {
+        const uint8_t *row = src + r * stride;
+        int            c   = 0;
+        for (; c + 16 <= cols; c += 16) {
+            const uint8x16_t v = vld1q_u8(row + c);
+            if (vminvq_u8(vceqq_u8(v, vdupq_n_u8(row[c]))) == 0xff)
+                val_count[row[c]] += 16;
+            else
+                for (int i = 0; i < 16; ++i) ++val_count[row[c + i]];
+        }
+        if (c + 8 <= cols) {
+            const uint8x8_t v = vld1_u8(row + c);
+            if (vminv_u8(vceq_u8(v, vdup_n_u8(row[c]))) == 0xff)
+                val_count[row[c]] += 8;
+            else
+                for (int i = 0; i < 8; ++i) ++val_count[row[c + i]];
+            c += 8;
+        }
+        for (; c < cols; ++c) ++val_count[row[c]];
+    }
+    return count_non_zero_bins_neon(val_count, 1 << 8);
+}
+
+int svt_av1_count_colors_highbd_neon(uint16_t *src, int stride, int rows, int cols, int bit_depth, int *val_count) {
+    assert(bit_depth <= 12);
+    const int max_pix_val = 1 << bit_depth;
+    memset(val_count, 0, max_pix_val * sizeof(val_count[0]));
+    for (int r = 0; r < rows; ++r) {
+        const uint16_t *row = src + r * stride;
+        int             c   = 0;
+        for (; c + 8 <= cols; c += 8) {
+            const uint16x8_t v = vld1q_u16(row + c);
+            if (vminvq_u16(vceqq_u16(v, vdupq_n_u16(row[c]))) == 0xffff) {
+                if (row[c] >= max_pix_val)
+                    return 0;
+                val_count[row[c]] += 8;
+                continue;
+            }
+            for (int i = 0; i < 8; ++i) {
+                if (row[c + i] >= max_pix_val)
+                    return 0;
+                ++val_count[row[c + i]];
+            }
+        }
+        for (; c < cols; ++c) {
+            if (row[c] >= max_pix_val)
+                return 0;
+            ++val_count[row[c]];
+        }
+    }
+    return count_non_zero_bins_neon(val_count, max_pix_val);
+}
@@ -0,0 +1,188 @@
+/*
+* Copyright (c) 2024, Alliance for Open Media. All rights reserved
+*
+* This source code is subject to the terms of the BSD 2 Clause License and
+* the Alliance for Open Media Patent License 1.0. If the BSD 2 Clause License
+* was not distributed with this source code in the LICENSE file, you can
+* obtain it at https://www.aomedia.org/license/software-license. If the Alliance for Open
+* Media Patent License 1.0 was not distributed with this source code in the
+* PATENTS file, you can obtain it at https://www.aomedia.org/license/patent-license.
+*/
+
+#include <arm_neon.h>
+#include <stdlib.h>
+#include "common_dsp_rtcd.h"
+#include "definitions.h"
+#include "transpose_neon.h"
+
+/*
+ * The C reference packs two 16-bit partial sums into every 32-bit word and lets them wrap,
+ * so the kernels below keep the exact same 32-bit lane arithmetic to stay bit-exact.
+ */
+
+/* Equivalent of ashft(): absolute value of both 16-bit halves of each 32-bit lane */
+static INLINE uint32x4_t psy_abs_packed_neon(const uint32x4_t a) {
+    const uint32x4_t s = vandq_u32(vshrq_n_u32(a, 15), vdupq_n_u32(0x10001));
+    const uint32x4_t m = vsubq_u32(vshlq_n_u32(s, 16), s);
+    return veorq_u32(vaddq_u32(a, m), m);
+}
+
+/* (a0 + a1) + ((a0 - a1) << 16) */
+static INLINE uint32x4_t psy_pack_pair_neon(const uint32x4_t a0, const uint32x4_t a1) {
+    return vaddq_u32(vaddq_u32(a0, a1), vshlq_n_u32(vsubq_u32(a0, a1), 16));
+}
+
+static INLINE void psy_hadamard4_neon(const uint32x4_t s0, const uint32x4_t s1, const uint32x4_t s2,
+                                      const uint32x4_t s3, uint32x4_t *d0, uint32x4_t *d1, uint32x4_t *d2,
+                                      uint32x4_t *d3) {
+    const uint32x4_t t0 = vaddq_u32(s0, s1);
+    const uint32x4_t t1 = vsubq_u32(s0, s1);
+    const uint32x4_t t2 = vaddq_u32(s2, s3);
+    const uint32x4_t t3 = vsubq_u32(s2, s3);
+    *d0                 = vaddq_u32(t0, t2);
+    *d2                 = vsubq_u32(t0, t2);
+    *d1                 = vaddq_u32(t1, t3);
+    *d3                 = vsubq_u32(t1, t3);
+}
+
+/* Horizontal pass over 4 rows, then transpose so that lane k of r[i] holds tmp[i][k] */
+static INLINE void psy_sa8d_rows_neon(const uint32x4_t *const a, uint32x4_t *const r) {
+    uint32x4_t h0, h1, h2, h3;
+    int32x4_t  o0, o1, o2, o3;
+
+    psy_hadamard4_neon(psy_pack_pair_neon(a[0], a[1]),
+                       psy_pack_pair_neon(a[2], a[3]),
+                       psy_pack_pair_neon(a[4], a[5]),
+                       psy_pack_pair_neon(a[6], a[7]),
+                       &h0,
+                       &h1,
+                       &h2,
+                       &h3);
+    transpose_elems_s32_4x4(vreinterpretq_s32_u32(h0),
+                            vreinterpretq_s32_u32(h1),
+                            vreinterpretq_s32_u32(h2),
+                            vreinterpretq_s32_u32(h3),
+                            &o0,
+                            &o1,
+                            &o2,
+                            &o3);
+    psy_hadamard4_neon(vreinterpretq_u32_s32(o0),
+                       vreinterpretq_u32_s32(o1),
+                       vreinterpretq_u32_s32(o2),
+                       vreinterpretq_u32_s32(o3),
+                       &r[0],
+                       &r[1],
+                       &r[2],
+                       &r[3]);
+}
+
+/* sa8d of 8 rows of 16-bit pixels against a zero reference, matches svt_sa8d_8x8() */
+static INLINE int psy_sa8d_8x8_neon(const int16x8_t *const row) {
+    int16x8_t  col[8];
+    uint32x4_t a_lo[8], a_hi[8], v_lo[4], v_hi[4];
+
+    transpose_arrays_s16_8x8(row, col);
+    for (int i = 0; i < 8; i++) {
+        a_lo[i] = vreinterpretq_u32_s32(vmovl_s16(vget_low_s16(col[i])));
+        a_hi[i] = vreinterpretq_u32_s32(vmovl_s16(vget_high_s16(col[i])));
+    }
+    psy_sa8d_rows_neon(a_lo, v_lo); // a0..a3
+    psy_sa8d_rows_neon(a_hi, v_hi); // a4..a7
+
+    const uint32x4_t mask_lo = vdupq_n_u32(0xffff);
+    uint32x4_t       sum_lo  = vdupq_n_u32(0);
+    uint32x4_t       sum_hi  = vdupq_n_u32(0);
+    for (int m = 0; m < 4; m++) {
+        const uint32x4_t p = psy_abs_packed_neon(vaddq_u32(v_lo[m], v_hi[m]));
+        const uint32x4_t d = psy_abs_packed_neon(vsubq_u32(v_lo[m], v_hi[m]));
+        sum_lo             = vaddq_u32(sum_lo, vaddq_u32(vandq_u32(p, mask_lo), vandq_u32(d, mask_lo)));
+        sum_hi             = vaddq_u32(sum_hi, vaddq_u32(vshrq_n_u32(p, 16), vshrq_n_u32(d, 16)));
+    }
+
+    // (uint16_t)b0 + (b0 >> 16) for each of the 4 columns, then sum the columns
+    const uint32x4_t c   = vaddq_u32(vaddq_u32(vandq_u32(sum_lo, mask_lo), vshrq_n_u32(sum_lo, 16)), sum_hi);
+    const uint32_t   sum = vaddvq_u32(c);
+
+    return ((int)sum + 2) >> 2;
+}
+
+/* Sum of 8 rows of 16-bit pixels, matches svt_psy_sad_nxn() against a zero reference */
+static INLINE int psy_sum_8x8_neon(const int16x8_t *const row) {
+    uint16x8_t acc = vreinterpretq_u16_s16(row[0]);
+    for (int i = 1; i < 8; i++) acc = vaddq_u16(acc, vreinterpretq_u16_s16(row[i]));
+    return (int)vaddlvq_u16(acc);
+}
+
+static INLINE int psy_energy_8x8_neon(const int16x8_t *const row) {
+    return (psy_sa8d_8x8_neon(row) >> 8) - (psy_sum_8x8_neon(row) >> 2);
+}
+
+static INLINE void psy_load_8x8(const uint8_t *src, uint32_t stride, int16x8_t *const row) {
+    for (int i = 0; i < 8; i++, src += stride) row[i] = vreinterpretq_s16_u16(vmovl_u8(vld1_u8(src)));
+}
+
+static INLINE void psy_load_8x8_hbd(const uint16_t *src, uint32_t stride, int16x8_t *const row) {
+    for (int i = 0; i < 8; i++, src += stride) row[i] = vreinterpretq_s16_u16(vld1q_u16(src));
+}
+
+uint64_t svt_psy_distortion_neon(const uint8_t *input, uint32_t input_stride, const uint8_t *recon,
+                                 uint32_t recon_stride, uint32_t width, uint32_t height, const uint32_t count) {
+    if (count < 64) /* 4x4 only touches a single row, nothing to vectorize */
+        return svt_psy_distortion_c(input, input_stride, recon, recon_stride, width, height, count);
+
+    uint32_t  total_nrg = 0;
+    int16x8_t row[8];
+
+    for (uint64_t i = 0; i < height; i += 8) {
+        for (uint64_t j = 0; j < width; j += 8) {
+            psy_load_8x8(input + i * input_stride + j, input_stride, row);
+            const int input_nrg = psy_energy_8x8_neon(row);
+            psy_load_8x8(recon + i * recon_stride + j, recon_stride, row);
+            const int recon_nrg = psy_energy_8x8_neon(row);
+            total_nrg += (uint32_t)abs(input_nrg - recon_nrg);
+        }
+    }
+    return (total_nrg << 2);
+}
+
+uint64_t svt_psy_distor_hbd_neon(const uint16_t *input, uint32_t input_stride, const uint16_t *recon,
+                                 uint32_t recon_stride, uint32_t width, uint32_t height, const uint32_t count) {
+    if (count < 64)
+        return svt_psy_distor_hbd_c(input, input_stride, recon, recon_stride, width, height, count);
+
+    uint32_t  total_nrg = 0;
+    int16x8_t row[8];
+
+    for (uint64_t i = 0; i < height; i += 8) {
+        for (uint64_t j = 0; j < width; j += 8) {
+            psy_load_8x8_hbd(input + i * input_stride + j, input_stride, row);
+            const int input_nrg = psy_energy_8x8_neon(row);
+            psy_load_8x8_hbd(recon + i * recon_stride + j, recon_stride, row);
+            const int recon_nrg = psy_energy_8x8_neon(row);
+            total_nrg += (uint32_t)abs(input_nrg - recon_nrg);
+        }
+    }
+    return (total_nrg << 2);
+}
+
+void svt_psy_ac_energy_neon(const uint8_t *src, uint32_t stride, uint32_t width, uint32_t height, int32_t *nrg) {
+    int16x8_t row[8];
+
+    for (uint64_t i = 0; i < height; i += 8) {
+        for (uint64_t j = 0; j < width; j += 8) {
+            psy_load_8x8(src + i * stride + j, stride, row);
+            *nrg++ = psy_energy_8x8_neon(row);
+        }
+    }
+}
+
+void svt_psy_ac_energy_hbd_neon(const uint16_t *src, uint32_t stride, uint32_t width, uint32_t height, int32_t *nrg) {
+    int16x8_t row[8];
+
+    for (uint64_t i = 0; i < height; i += 8) {
+        for (uint64_t j = 0; j < width; j += 8) {
+            psy_load_8x8_hbd(src + i * stride + j, stride, row);
+            *nrg++ = psy_energy_8x8_neon(row);
+        }
+    }
+}
@@ -0,0 +1,179 @@
+/*
+* Copyright (c) 2024, Alliance for Open Media. All rights reserved
+*
+* This source code is subject to the terms of the BSD 2 Clause License and
+* the Alliance for Open Media Patent License 1.0. If the BSD 2 Clause License
+* was not distributed with this source code in the LICENSE file, you can
+* obtain it at https://www.aomedia.org/license/software-license. If the Alliance for Open
+* Media Patent License 1.0 was not distributed with this source code in the
+* PATENTS file, you can obtain it at https://www.aomedia.org/license/patent-license.
+*/
+
+#include <arm_neon.h>
+#include "aom_dsp_rtcd.h"
+#include "definitions.h"
+#include "mem_neon.h"
+#include "quality_metrics.h"
+
+double svt_ssim_8x8_neon(const uint8_t *s, uint32_t sp, const uint8_t *r, uint32_t rp) {
+    uint16x8_t sum_s    = vdupq_n_u16(0);
+    uint16x8_t sum_r    = vdupq_n_u16(0);
+    uint32x4_t sum_sq_s = vdupq_n_u32(0);
+    uint32x4_t sum_sq_r = vdupq_n_u32(0);
+    uint32x4_t sum_sxr  = vdupq_n_u32(0);
+    for (int i = 0; i < 8; ++i) {
+        const uint8x8_t vs = vld1_u8(s);
+        const uint8x8_t vr = vld1_u8(r);
+        sum_s              = vaddw_u8(sum_s, vs);
+        sum_r              = vaddw_u8(sum_r, vr);
+        sum_sq_s           = vpadalq_u16(sum_sq_s, vmull_u8(vs, vs));
+        sum_sq_r           = vpadalq_u16(sum_sq_r, vmull_u8(vr, vr));
+        sum_sxr            = vpadalq_u16(sum_sxr, vmull_u8(vs, vr));
+        s += sp;
+        r += rp;
+    }
+    return svt_aom_similarity(vaddlvq_u16(sum_s),
+                              vaddlvq_u16(sum_r),
+                              vaddvq_u32(sum_sq_s),
+                              vaddvq_u32(sum_sq_r),
+                              vaddvq_u32(sum_sxr),
+                              64,
+                              8);
+}
+
+double svt_ssim_4x4_neon(const uint8_t *s, uint32_t sp, const uint8_t *r, uint32_t rp) {
+    const uint8x16_t vs       = load_unaligned_u8q(s, sp);
+    const uint8x16_t vr       = load_unaligned_u8q(r, rp);
+    uint32x4_t       sum_sq_s = vpaddlq_u16(vmull_u8(vget_low_u8(vs), vget_low_u8(vs)));
+    uint32x4_t       sum_sq_r = vpaddlq_u16(vmull_u8(vget_low_u8(vr), vget_low_u8(vr)));
+    uint32x4_t       sum_sxr  = vpaddlq_u16(vmull_u8(vget_low_u8(vs), vget_low_u8(vr)));
+    sum_sq_s                  = vpadalq_u16(sum_sq_s, vmull_high_u8(vs, vs));
+    sum_sq_r                  = vpadalq_u16(sum_sq_r, vmull_high_u8(vr, vr));
+    sum_sxr                   = vpadalq_u16(sum_sxr, vmull_high_u8(vs, vr));
+    return svt_aom_similarity(
+        vaddlvq_u8(vs), vaddlvq_u8(vr), vaddvq_u32(sum_sq_s), vaddvq_u32(sum_sq_r), vaddvq_u32(sum_sxr), 16, 8);
+}
+
+double svt_ssim_8x8_hbd_neon(const uint16_t *s, uint32_t sp, const uint16_t *r, uint32_t rp) {
+    uint32x4_t sum_s    = vdupq_n_u32(0);
+    uint32x4_t sum_r    = vdupq_n_u32(0);
+    uint32x4_t sum_sq_s = vdupq_n_u32(0);
+    uint32x4_t sum_sq_r = vdupq_n_u32(0);
+    uint32x4_t sum_sxr  = vdupq_n_u32(0);
+    for (int i = 0; i < 8; ++i) {
+        const uint16x8_t vs = vld1q_u16(s);
+        const uint16x8_t vr = vld1q_u16(r);
+        sum_s               = vpadalq_u16(sum_s, vs);
+        sum_r               = vpadalq_u16(sum_r, vr);
+        sum_sq_s            = vmlal_u16(sum_sq_s, vget_low_u16(vs), vget_low_u16(vs));
+        sum_sq_s            = vmlal_high_u16(sum_sq_s, vs, vs);
+        sum_sq_r            = vmlal_u16(sum_sq_r, vget_low_u16(vr), vget_low_u16(vr));
+        sum_sq_r            = vmlal_high_u16(sum_sq_r, vr, vr);
+        sum_sxr             = vmlal_u16(sum_sxr, vget_low_u16(vs), vget_low_u16(vr));
+        sum_sxr             = vmlal_high_u16(sum_sxr, vs, vr);
+        s += sp;
+        r += rp;
+    }
+    return svt_aom_similarity(vaddvq_u32(sum_s),
+                              vaddvq_u32(sum_r),
+                              vaddvq_u32(sum_sq_s),
+                              vaddvq_u32(sum_sq_r),
+                              vaddvq_u32(sum_sxr),
+                              64,
+                              10);
+}
+
+double svt_ssim_4x4_hbd_neon(const uint16_t *s, uint32_t sp, const uint16_t *r, uint32_t rp) {
+    uint32x4_t sum_s    = vdupq_n_u32(0);
+    uint32x4_t sum_r    = vdupq_n_u32(0);
+    uint32x4_t sum_sq_s = vdupq_n_u32(0);
+    uint32x4_t sum_sq_r = vdupq_n_u32(0);
+    uint32x4_t sum_sxr  = vdupq_n_u32(0);
+    for (int i = 0; i < 4; i += 2) {
+        const uint16x8_t vs = load_unaligned_u16_4x2(s, sp);
+        const uint16x8_t vr = load_unaligned_u16_4x2(r, rp);
+        sum_s               = vpadalq_u16(sum_s, vs);
+        sum_r               = vpadalq_u16(sum_r, vr);
+        sum_sq_s            = vmlal_u16(sum_sq_s, vget_low_u16(vs), vget_low_u16(vs));
+        sum_sq_s            = vmlal_high_u16(sum_sq_s, vs, vs);
+        sum_sq_r            = vmlal_u16(sum_sq_r, vget_low_u16(vr), vget_low_u16(vr));
+        sum_sq_r            = vmlal_high_u16(sum_sq_r, vr, vr);
+        sum_sxr             = vmlal_u16(sum_sxr, vget_low_u16(vs), vget_low_u16(vr));
+        sum_sxr             = vmlal_high_u16(sum_sxr, vs, vr);
+        s += 2 * sp;
+        r += 2 * rp;
+    }
+    return svt_aom_similarity(vaddvq_u32(sum_s),
+                              vaddvq_u32(sum_r),
+                              vaddvq_u32(sum_sq_s),
+                              vaddvq_u32(sum_sq_r),
+                              vaddvq_u32(sum_sxr),
+                              16,
+                              10);
+}
+
+void svt_ssim_4x4_sums_neon(const uint8_t *s, uint32_t sp, const uint8_t *r, uint32_t rp, uint32_t count,
+                            uint32_t *sums) {
+    uint32_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        uint16x8_t sum_s  = vdupq_n_u16(0);
+        uint16x8_t sum_r  = vdupq_n_u16(0);
+        uint32x4_t sq_lo  = vdupq_n_u32(0);
+        uint32x4_t sq_hi  = vdupq_n_u32(0);
+        uint32x4_t sxr_lo = vdupq_n_u32(0);
+        uint32x4_t sxr_hi = vdupq_n_u32(0);
+        for (int y = 0; y < 4; ++y) {
+            const uint8x16_t vs = vld1q_u8(s + y * sp + 4 * i);
+            const uint8x16_t vr = vld1q_u8(r + y * rp + 4 * i);
+            sum_s               = vpadalq_u8(sum_s, vs);
+            sum_r               = vpadalq_u8(sum_r, vr);
+            sq_lo               = vpadalq_u16(sq_lo, vmull_u8(vget_low_u8(vs), vget_low_u8(vs)));
+            sq_lo               = vpadalq_u16(sq_lo, vmull_u8(vget_low_u8(vr), vget_low_u8(vr)));
+            sq_hi               = vpadalq_u16(sq_hi, vmull_high_u8(vs, vs));
+            sq_hi               = vpadalq_u16(sq_hi, vmull_high_u8(vr, vr));
+            sxr_lo              = vpadalq_u16(sxr_lo, vmull_u8(vget_low_u8(vs), vget_low_u8(vr)));
+            sxr_hi              = vpadalq_u16(sxr_hi, vmull_high_u8(vs, vr));
+        }
+        uint32x4x4_t out;
+        out.val[0] = vpaddlq_u16(sum_s);
+        out.val[1] = vpaddlq_u16(sum_r);
+        out.val[2] = vpaddq_u32(sq_lo, sq_hi);
+        out.val[3] = vpaddq_u32(sxr_lo, sxr_hi);
+        vst4q_u32(sums + 4 * i, out);
+    }
+    if (i < count)
+        svt_ssim_4x4_sums_c(s + 4 * i, sp, r + 4 * i, rp, count - i, sums + 4 * i);
+}
+
+void svt_ssim_4x4_sums_hbd_neon(const uint16_t *s, uint32_t sp, const uint16_t *r, uint32_t rp, uint32_t count,
+                                uint32_t *sums) {
+    uint32_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        uint32x4_t sum_s[2] = {vdupq_n_u32(0), vdupq_n_u32(0)};
+        uint32x4_t sum_r[2] = {vdupq_n_u32(0), vdupq_n_u32(0)};
+        uint32x4_t sq[4]    = {vdupq_n_u32(0), vdupq_n_u32(0), vdupq_n_u32(0), vdupq_n_u32(0)};
+        uint32x4_t sxr[4]   = {vdupq_n_u32(0), vdupq_n_u32(0), vdupq_n_u32(0), vdupq_n_u32(0)};
+        for (int y = 0; y < 4; ++y) {
+            for (int h = 0; h < 2; ++h) {
+                const uint16x8_t vs = vld1q_u16(s + y * sp + 4 * i + 8 * h);
+                const uint16x8_t vr = vld1q_u16(r + y * rp + 4 * i + 8 * h);
+                sum_s[h]            = vpadalq_u16(sum_s[h], vs);
+                sum_r[h]            = vpadalq_u16(sum_r[h], vr);
+                sq[2 * h]           = vmlal_u16(sq[2 * h], vget_low_u16(vs), vget_low_u16(vs));
+                sq[2 * h]           = vmlal_u16(sq[2 * h], vget_low_u16(vr), vget_low_u16(vr));
+                sq[2 * h + 1]       = vmlal_high_u16(sq[2 * h + 1], vs, vs);
+                sq[2 * h + 1]       = vmlal_high_u16(sq[2 * h + 1], vr, vr);
+                sxr[2 * h]          = vmlal_u16(sxr[2 * h], vget_low_u16(vs), vget_low_u16(vr));
+                sxr[2 * h + 1]      = vmlal_high_u16(sxr[2 * h + 1], vs, vr);
+            }
+        }
+        uint32x4x4_t out;
+        out.val[0] = vpaddq_u32(sum_s[0], sum_s[1]);
+        out.val[1] = vpaddq_u32(sum_r[0], sum_r[1]);
+        out.val[2] = vpaddq_u32(vpaddq_u32(sq[0], sq[1]), vpaddq_u32(sq[2], sq[3]));
+        out.val[3] = vpaddq_u32(vpaddq_u32(sxr[0], sxr[1]), vpaddq_u32(sxr[2], sxr[3]));
+        vst4q_u32(sums + 4 * i, out);
+    }
+    if (i < count)
+        svt_ssim_4x4_sums_hbd_c(s + 4 * i, sp, r + 4 * i, rp, count - i, sums + 4 * i);
+}
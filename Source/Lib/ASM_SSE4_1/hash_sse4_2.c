@@ -0,0 +1,36 @@
+/*
+ * Copyright (c) 2018, Alliance for Open Media. All rights reserved
+ *
+ * This source code is subject to the terms of the BSD 2 Clause License and
+ * the Alliance for Open Media Patent License 1.0. If the BSD 2 Clause License
+ * was not distributed with this source code in the LICENSE file, you can
+ * obtain it at https://www.aomedia.org/license/software-license. If the Alliance for Open
+ * Media Patent License 1.0 was not distributed with this source code in the
+ * PATENTS file, you can obtain it at https://www.aomedia.org/license/patent-license.
+ */
+
+#include <nmmintrin.h>
+#include <string.h>
+#include "aom_dsp_rtcd.h"
+#include "definitions.h"
+
+#define CALC_CRC(op, crc, type, buf, len) \
+    while ((len) >= sizeof(type)) {       \
+        type v;                           \
+        memcpy(&v, (buf), sizeof(v));     \
+        (crc) = op((crc), v);             \
+        (len) -= sizeof(type);            \
+        (buf) += sizeof(type);            \
+    }
+
+uint32_t svt_av1_get_crc32c_value_sse4_2(void *crc_calculator, uint8_t *p, size_t length) {
+    (void)crc_calculator;
+    const uint8_t *buf   = p;
+    uint64_t       crc64 = 0xFFFFFFFF;
+    CALC_CRC(_mm_crc32_u64, crc64, uint64_t, buf, length)
+    uint32_t crc = (uint32_t)crc64;
+    CALC_CRC(_mm_crc32_u32, crc, uint32_t, buf, length)
+    CALC_CRC(_mm_crc32_u16, crc, uint16_t, buf, length)
+    CALC_CRC(_mm_crc32_u8, crc, uint8_t, buf, length)
+    return crc ^ 0xFFFFFFFF;
+}
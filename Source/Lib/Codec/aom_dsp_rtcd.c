@@ -169,6 +169,7 @@
     #define SET_SSSE3(ptr, c, ssse3)                                SET_FUNCTIONS(ptr, c, 0, 0, 0, 0, ssse3, 0, 0, 0, 0, 0)
     #define SET_SSSE3_AVX2(ptr, c, ssse3, avx2)                     SET_FUNCTIONS(ptr, c, 0, 0, 0, 0, ssse3, 0, 0, 0, avx2, 0)
     #define SET_SSE41(ptr, c, sse4_1)                               SET_FUNCTIONS(ptr, c, 0, 0, 0, 0, 0, sse4_1, 0, 0, 0, 0)
+    #define SET_SSE42(ptr, c, sse4_2)                               SET_FUNCTIONS(ptr, c, 0, 0, 0, 0, 0, 0, sse4_2, 0, 0, 0)
     #define SET_SSE41_AVX2(ptr, c, sse4_1, avx2)                    SET_FUNCTIONS(ptr, c, 0, 0, 0, 0, 0, sse4_1, 0, 0, avx2, 0)
     #define SET_SSE41_AVX2_AVX512(ptr, c, sse4_1, avx2, avx512)     SET_FUNCTIONS(ptr, c, 0, 0, 0, 0, 0, sse4_1, 0, 0, avx2, avx512)
     #define SET_AVX2(ptr, c, avx2)                                  SET_FUNCTIONS(ptr, c, 0, 0, 0, 0, 0, 0, 0, 0, avx2, 0)
@@ -496,6 +497,7 @@ void svt_aom_setup_rtcd_internal(EbCpuFlags flags) {
     SET_AVX2(svt_av1_get_gradient_hist, svt_av1_get_gradient_hist_c, svt_av1_get_gradient_hist_avx2);
     SET_SSE2_AVX2(svt_av1_get_nz_map_contexts, svt_av1_get_nz_map_contexts_c, svt_av1_get_nz_map_contexts_sse2, svt_av1_get_nz_map_contexts_avx2);
     SET_AVX2_AVX512(svt_search_one_dual, svt_search_one_dual_c, svt_search_one_dual_avx2, svt_search_one_dual_avx512);
+    SET_AVX2(svt_search_one_dual_tot_mse, svt_search_one_dual_tot_mse_c, svt_search_one_dual_tot_mse_avx2);
     SET_SSE41_AVX2_AVX512(svt_sad_loop_kernel, svt_sad_loop_kernel_c, svt_sad_loop_kernel_sse4_1_intrin, svt_sad_loop_kernel_avx2_intrin, svt_sad_loop_kernel_avx512_intrin);
     SET_SSE41_AVX2(svt_av1_apply_zz_based_temporal_filter_planewise_medium, svt_av1_apply_zz_based_temporal_filter_planewise_medium_c, svt_av1_apply_zz_based_temporal_filter_planewise_medium_sse4_1, svt_av1_apply_zz_based_temporal_filter_planewise_medium_avx2);
     SET_SSE41_AVX2(svt_av1_apply_zz_based_temporal_filter_planewise_medium_hbd, svt_av1_apply_zz_based_temporal_filter_planewise_medium_hbd_c, svt_av1_apply_zz_based_temporal_filter_planewise_medium_hbd_sse4_1, svt_av1_apply_zz_based_temporal_filter_planewise_medium_hbd_avx2);
@@ -516,12 +518,15 @@ void svt_aom_setup_rtcd_internal(EbCpuFlags flags) {
     SET_SSE2(svt_compute_mean_square_values_8x8, svt_compute_mean_squared_values_c, svt_compute_mean_of_squared_values8x8_sse2_intrin);
     SET_SSE2(svt_compute_sub_mean_8x8, svt_compute_sub_mean_8x8_c, svt_compute_sub_mean8x8_sse2_intrin);
     SET_SSE2_AVX2(svt_compute_interm_var_four8x8, svt_compute_interm_var_four8x8_c, svt_compute_interm_var_four8x8_helper_sse2, svt_compute_interm_var_four8x8_avx2_intrin);
+    SET_AVX2(svt_compute_mean_8x8_64x64, svt_compute_mean_8x8_64x64_c, svt_compute_mean_8x8_64x64_avx2);
     SET_AVX2(sad_16b_kernel, svt_aom_sad_16b_kernel_c, svt_aom_sad_16bit_kernel_avx2);
     SET_SSE41_AVX2(svt_av1_compute_cross_correlation, svt_av1_compute_cross_correlation_c, svt_av1_compute_cross_correlation_sse4_1, svt_av1_compute_cross_correlation_avx2);
     SET_AVX2(svt_av1_k_means_dim1, svt_av1_k_means_dim1_c, svt_av1_k_means_dim1_avx2);
     SET_AVX2(svt_av1_k_means_dim2, svt_av1_k_means_dim2_c, svt_av1_k_means_dim2_avx2);
     SET_AVX2(svt_av1_calc_indices_dim1, svt_av1_calc_indices_dim1_c, svt_av1_calc_indices_dim1_avx2);
     SET_AVX2(svt_av1_calc_indices_dim2, svt_av1_calc_indices_dim2_c, svt_av1_calc_indices_dim2_avx2);
+    SET_AVX2(svt_av1_count_colors, svt_av1_count_colors_c, svt_av1_count_colors_avx2);
+    SET_AVX2(svt_av1_count_colors_highbd, svt_av1_count_colors_highbd_c, svt_av1_count_colors_highbd_avx2);
     SET_SSE41_AVX2(variance_highbd, svt_aom_variance_highbd_c, svt_aom_variance_highbd_sse4_1, svt_aom_variance_highbd_avx2);
     SET_AVX2(svt_av1_haar_ac_sad_8x8_uint8_input, svt_av1_haar_ac_sad_8x8_uint8_input_c, svt_av1_haar_ac_sad_8x8_uint8_input_avx2);
     SET_SSE41_AVX2(svt_pme_sad_loop_kernel, svt_pme_sad_loop_kernel_c, svt_pme_sad_loop_kernel_sse4_1, svt_pme_sad_loop_kernel_avx2);
@@ -534,6 +539,7 @@ void svt_aom_setup_rtcd_internal(EbCpuFlags flags) {
     SET_AVX2(svt_av1_apply_window_function_to_plane, svt_av1_apply_window_function_to_plane_c, svt_av1_apply_window_function_to_plane_avx2);
     SET_AVX2(svt_aom_noise_tx_filter, svt_aom_noise_tx_filter_c, svt_aom_noise_tx_filter_avx2);
     SET_AVX2(svt_aom_flat_block_finder_extract_block, svt_aom_flat_block_finder_extract_block_c, svt_aom_flat_block_finder_extract_block_avx2);
+    SET_AVX2(svt_aom_flat_block_finder_block_stats, svt_aom_flat_block_finder_block_stats_c, svt_aom_flat_block_finder_block_stats_avx2);
     SET_AVX2(svt_av1_calc_target_weighted_pred_above, svt_av1_calc_target_weighted_pred_above_c,svt_av1_calc_target_weighted_pred_above_avx2);
     SET_AVX2(svt_av1_calc_target_weighted_pred_left, svt_av1_calc_target_weighted_pred_left_c,svt_av1_calc_target_weighted_pred_left_avx2);
     SET_AVX2(svt_av1_interpolate_core, svt_av1_interpolate_core_c, svt_av1_interpolate_core_avx2);
@@ -547,6 +553,12 @@ void svt_aom_setup_rtcd_internal(EbCpuFlags flags) {
     SET_AVX2(svt_ssim_4x4, svt_ssim_4x4_c, svt_ssim_4x4_avx2);
     SET_AVX2(svt_ssim_8x8_hbd, svt_ssim_8x8_hbd_c, svt_ssim_8x8_hbd_avx2);
     SET_AVX2(svt_ssim_4x4_hbd, svt_ssim_4x4_hbd_c, svt_ssim_4x4_hbd_avx2);
+    SET_AVX2(svt_ssim_4x4_sums, svt_ssim_4x4_sums_c, svt_ssim_4x4_sums_avx2);
+    SET_AVX2(svt_ssim_4x4_sums_hbd, svt_ssim_4x4_sums_hbd_c, svt_ssim_4x4_sums_hbd_avx2);
+    SET_AVX2(svt_av1_fast9_score, svt_av1_fast9_score_c, svt_av1_fast9_score_avx2);
+    SET_AVX2(svt_av1_normal_equations, svt_av1_normal_equations_c, svt_av1_normal_equations_avx2);
+    SET_AVX2(svt_av1_ransac_find_inliers, svt_av1_ransac_find_inliers_c, svt_av1_ransac_find_inliers_avx2);
+    SET_SSE42(svt_av1_get_crc32c_value, svt_av1_get_crc32c_value_c, svt_av1_get_crc32c_value_sse4_2);
 #elif defined ARCH_AARCH64
     SET_NEON(hadamard_path, hadamard_path_c, hadamard_path_neon);
     SET_NEON(svt_aom_sse, svt_aom_sse_c, svt_aom_sse_neon);
@@ -846,7 +858,8 @@ void svt_aom_setup_rtcd_internal(EbCpuFlags flags) {
     SET_ONLY_C(svt_aom_ifft4x4_float, svt_aom_ifft4x4_float_c);
     SET_ONLY_C(svt_av1_get_gradient_hist, svt_av1_get_gradient_hist_c);
     SET_NEON(svt_av1_get_nz_map_contexts, svt_av1_get_nz_map_contexts_c, svt_av1_get_nz_map_contexts_neon);
-    SET_ONLY_C(svt_search_one_dual, svt_search_one_dual_c);
+    SET_NEON(svt_search_one_dual, svt_search_one_dual_c, svt_search_one_dual_neon);
+    SET_NEON(svt_search_one_dual_tot_mse, svt_search_one_dual_tot_mse_c, svt_search_one_dual_tot_mse_neon);
     SET_NEON(svt_sad_loop_kernel, svt_sad_loop_kernel_c, svt_sad_loop_kernel_neon);
     SET_NEON(svt_pme_sad_loop_kernel, svt_pme_sad_loop_kernel_c, svt_pme_sad_loop_kernel_neon);
     SET_ONLY_C(svt_av1_apply_zz_based_temporal_filter_planewise_medium, svt_av1_apply_zz_based_temporal_filter_planewise_medium_c);
@@ -868,23 +881,27 @@ void svt_aom_setup_rtcd_internal(EbCpuFlags flags) {
     SET_ONLY_C(svt_compute_mean_square_values_8x8, svt_compute_mean_squared_values_c);
     SET_ONLY_C(svt_compute_sub_mean_8x8, svt_compute_sub_mean_8x8_c);
     SET_ONLY_C(svt_compute_interm_var_four8x8, svt_compute_interm_var_four8x8_c);
+    SET_NEON(svt_compute_mean_8x8_64x64, svt_compute_mean_8x8_64x64_c, svt_compute_mean_8x8_64x64_neon);
     SET_ONLY_C(sad_16b_kernel, svt_aom_sad_16b_kernel_c);
     SET_ONLY_C(svt_av1_compute_cross_correlation, svt_av1_compute_cross_correlation_c);
-    SET_ONLY_C(svt_av1_k_means_dim1, svt_av1_k_means_dim1_c);
-    SET_ONLY_C(svt_av1_k_means_dim2, svt_av1_k_means_dim2_c);
-    SET_ONLY_C(svt_av1_calc_indices_dim1, svt_av1_calc_indices_dim1_c);
-    SET_ONLY_C(svt_av1_calc_indices_dim2, svt_av1_calc_indices_dim2_c);
+    SET_NEON(svt_av1_k_means_dim1, svt_av1_k_means_dim1_c, svt_av1_k_means_dim1_neon);
+    SET_NEON(svt_av1_k_means_dim2, svt_av1_k_means_dim2_c, svt_av1_k_means_dim2_neon);
+    SET_NEON(svt_av1_calc_indices_dim1, svt_av1_calc_indices_dim1_c, svt_av1_calc_indices_dim1_neon);
+    SET_NEON(svt_av1_calc_indices_dim2, svt_av1_calc_indices_dim2_c, svt_av1_calc_indices_dim2_neon);
+    SET_NEON(svt_av1_count_colors, svt_av1_count_colors_c, svt_av1_count_colors_neon);
+    SET_NEON(svt_av1_count_colors_highbd, svt_av1_count_colors_highbd_c, svt_av1_count_colors_highbd_neon);
     SET_ONLY_C(variance_highbd, svt_aom_variance_highbd_c);
     SET_ONLY_C(svt_av1_haar_ac_sad_8x8_uint8_input, svt_av1_haar_ac_sad_8x8_uint8_input_c);
     SET_NEON(svt_unpack_and_2bcompress, svt_unpack_and_2bcompress_c, svt_unpack_and_2bcompress_neon);
     SET_NEON(svt_estimate_noise_fp16, svt_estimate_noise_fp16_c, svt_estimate_noise_fp16_neon);
     SET_ONLY_C(svt_estimate_noise_highbd_fp16, svt_estimate_noise_highbd_fp16_c);
     SET_NEON(svt_copy_mi_map_grid, svt_copy_mi_map_grid_c, svt_copy_mi_map_grid_neon);
-    SET_ONLY_C(svt_av1_add_block_observations_internal, svt_av1_add_block_observations_internal_c);
-    SET_ONLY_C(svt_av1_pointwise_multiply, svt_av1_pointwise_multiply_c);
-    SET_ONLY_C(svt_av1_apply_window_function_to_plane, svt_av1_apply_window_function_to_plane_c);
+    SET_NEON(svt_av1_add_block_observations_internal, svt_av1_add_block_observations_internal_c, svt_av1_add_block_observations_internal_neon);
+    SET_NEON(svt_av1_pointwise_multiply, svt_av1_pointwise_multiply_c, svt_av1_pointwise_multiply_neon);
+    SET_NEON(svt_av1_apply_window_function_to_plane, svt_av1_apply_window_function_to_plane_c, svt_av1_apply_window_function_to_plane_neon);
     SET_ONLY_C(svt_aom_noise_tx_filter, svt_aom_noise_tx_filter_c);
     SET_ONLY_C(svt_aom_flat_block_finder_extract_block, svt_aom_flat_block_finder_extract_block_c);
+    SET_NEON(svt_aom_flat_block_finder_block_stats, svt_aom_flat_block_finder_block_stats_c, svt_aom_flat_block_finder_block_stats_neon);
     SET_ONLY_C(svt_av1_calc_target_weighted_pred_above, svt_av1_calc_target_weighted_pred_above_c);
     SET_ONLY_C(svt_av1_calc_target_weighted_pred_left, svt_av1_calc_target_weighted_pred_left_c);
     SET_ONLY_C(svt_av1_interpolate_core, svt_av1_interpolate_core_c);
@@ -894,10 +911,20 @@ void svt_aom_setup_rtcd_internal(EbCpuFlags flags) {
     SET_ONLY_C(svt_av1_highbd_resize_plane, svt_av1_highbd_resize_plane_c);
     SET_ONLY_C(svt_av1_resize_plane, svt_av1_resize_plane_c);
     SET_NEON(svt_av1_compute_cul_level, svt_av1_compute_cul_level_c, svt_av1_compute_cul_level_neon);
-    SET_ONLY_C(svt_ssim_8x8, svt_ssim_8x8_c);
-    SET_ONLY_C(svt_ssim_4x4, svt_ssim_4x4_c);
-    SET_ONLY_C(svt_ssim_8x8_hbd, svt_ssim_8x8_hbd_c);
-    SET_ONLY_C(svt_ssim_4x4_hbd, svt_ssim_4x4_hbd_c);
+    SET_NEON(svt_ssim_8x8, svt_ssim_8x8_c, svt_ssim_8x8_neon);
+    SET_NEON(svt_ssim_4x4, svt_ssim_4x4_c, svt_ssim_4x4_neon);
+    SET_NEON(svt_ssim_8x8_hbd, svt_ssim_8x8_hbd_c, svt_ssim_8x8_hbd_neon);
+    SET_NEON(svt_ssim_4x4_hbd, svt_ssim_4x4_hbd_c, svt_ssim_4x4_hbd_neon);
+    SET_NEON(svt_ssim_4x4_sums, svt_ssim_4x4_sums_c, svt_ssim_4x4_sums_neon);
+    SET_NEON(svt_ssim_4x4_sums_hbd, svt_ssim_4x4_sums_hbd_c, svt_ssim_4x4_sums_hbd_neon);
+    SET_NEON(svt_av1_fast9_score, svt_av1_fast9_score_c, svt_av1_fast9_score_neon);
+    SET_ONLY_C(svt_av1_normal_equations, svt_av1_normal_equations_c);
+    SET_ONLY_C(svt_av1_ransac_find_inliers, svt_av1_ransac_find_inliers_c);
+    SET_ONLY_C(svt_av1_get_crc32c_value, svt_av1_get_crc32c_value_c);
+#if HAVE_ARM_CRC32
+    if (flags & HAS_ARM_CRC32)
+        svt_av1_get_crc32c_value = svt_av1_get_crc32c_value_arm_crc32;
+#endif // HAVE_ARM_CRC32
 #else
     SET_ONLY_C(hadamard_path, hadamard_path_c);
     SET_ONLY_C(svt_aom_sse, svt_aom_sse_c);
@@ -1196,6 +1223,7 @@ void svt_aom_setup_rtcd_internal(EbCpuFlags flags) {
     SET_ONLY_C(svt_av1_get_gradient_hist, svt_av1_get_gradient_hist_c);
     SET_ONLY_C(svt_av1_get_nz_map_contexts, svt_av1_get_nz_map_contexts_c);
     SET_ONLY_C(svt_search_one_dual, svt_search_one_dual_c);
+    SET_ONLY_C(svt_search_one_dual_tot_mse, svt_search_one_dual_tot_mse_c);
     SET_ONLY_C(svt_sad_loop_kernel, svt_sad_loop_kernel_c);
     SET_ONLY_C(svt_av1_apply_zz_based_temporal_filter_planewise_medium, svt_av1_apply_zz_based_temporal_filter_planewise_medium_c);
     SET_ONLY_C(svt_av1_apply_zz_based_temporal_filter_planewise_medium_hbd, svt_av1_apply_zz_based_temporal_filter_planewise_medium_hbd_c);
@@ -1216,12 +1244,15 @@ void svt_aom_setup_rtcd_internal(EbCpuFlags flags) {
     SET_ONLY_C(svt_compute_mean_square_values_8x8, svt_compute_mean_squared_values_c);
     SET_ONLY_C(svt_compute_sub_mean_8x8, svt_compute_sub_mean_8x8_c);
     SET_ONLY_C(svt_compute_interm_var_four8x8, svt_compute_interm_var_four8x8_c);
+    SET_ONLY_C(svt_compute_mean_8x8_64x64, svt_compute_mean_8x8_64x64_c);
     SET_ONLY_C(sad_16b_kernel, svt_aom_sad_16b_kernel_c);
     SET_ONLY_C(svt_av1_compute_cross_correlation, svt_av1_compute_cross_correlation_c);
     SET_ONLY_C(svt_av1_k_means_dim1, svt_av1_k_means_dim1_c);
     SET_ONLY_C(svt_av1_k_means_dim2, svt_av1_k_means_dim2_c);
     SET_ONLY_C(svt_av1_calc_indices_dim1, svt_av1_calc_indices_dim1_c);
     SET_ONLY_C(svt_av1_calc_indices_dim2, svt_av1_calc_indices_dim2_c);
+    SET_ONLY_C(svt_av1_count_colors, svt_av1_count_colors_c);
+    SET_ONLY_C(svt_av1_count_colors_highbd, svt_av1_count_colors_highbd_c);
     SET_ONLY_C(variance_highbd, svt_aom_variance_highbd_c);
     SET_ONLY_C(svt_av1_haar_ac_sad_8x8_uint8_input, svt_av1_haar_ac_sad_8x8_uint8_input_c);
     SET_ONLY_C(svt_pme_sad_loop_kernel, svt_pme_sad_loop_kernel_c);
@@ -1234,6 +1265,7 @@ void svt_aom_setup_rtcd_internal(EbCpuFlags flags) {
     SET_ONLY_C(svt_av1_apply_window_function_to_plane, svt_av1_apply_window_function_to_plane_c);
     SET_ONLY_C(svt_aom_noise_tx_filter, svt_aom_noise_tx_filter_c);
     SET_ONLY_C(svt_aom_flat_block_finder_extract_block, svt_aom_flat_block_finder_extract_block_c);
+    SET_ONLY_C(svt_aom_flat_block_finder_block_stats, svt_aom_flat_block_finder_block_stats_c);
     SET_ONLY_C(svt_av1_calc_target_weighted_pred_above, svt_av1_calc_target_weighted_pred_above_c);
     SET_ONLY_C(svt_av1_calc_target_weighted_pred_left, svt_av1_calc_target_weighted_pred_left_c);
     SET_ONLY_C(svt_av1_interpolate_core, svt_av1_interpolate_core_c);
@@ -1247,6 +1279,12 @@ void svt_aom_setup_rtcd_internal(EbCpuFlags flags) {
     SET_ONLY_C(svt_ssim_4x4, svt_ssim_4x4_c);
     SET_ONLY_C(svt_ssim_8x8_hbd, svt_ssim_8x8_hbd_c);
     SET_ONLY_C(svt_ssim_4x4_hbd, svt_ssim_4x4_hbd_c);
+    SET_ONLY_C(svt_ssim_4x4_sums, svt_ssim_4x4_sums_c);
+    SET_ONLY_C(svt_ssim_4x4_sums_hbd, svt_ssim_4x4_sums_hbd_c);
+    SET_ONLY_C(svt_av1_fast9_score, svt_av1_fast9_score_c);
+    SET_ONLY_C(svt_av1_normal_equations, svt_av1_normal_equations_c);
+    SET_ONLY_C(svt_av1_ransac_find_inliers, svt_av1_ransac_find_inliers_c);
+    SET_ONLY_C(svt_av1_get_crc32c_value, svt_av1_get_crc32c_value_c);
 #endif
 
     if(0 == flags)
@@ -237,6 +237,8 @@ extern "C" {
     RTCD_EXTERN uint64_t(*svt_handle_transform64x64_N2_N4)(int32_t *output);
     uint64_t svt_search_one_dual_c(int *lev0, int *lev1, int nb_strengths, uint64_t** mse[2], int sb_count, int start_gi, int end_gi);
     RTCD_EXTERN uint64_t(*svt_search_one_dual)(int *lev0, int *lev1, int nb_strengths, uint64_t** mse[2], int sb_count, int start_gi, int end_gi);
+    void svt_search_one_dual_tot_mse_c(int *lev0, int *lev1, int nb_strengths, uint64_t** mse[2], int sb_count, int start_gi, int end_gi, uint64_t *tot_mse);
+    RTCD_EXTERN void(*svt_search_one_dual_tot_mse)(int *lev0, int *lev1, int nb_strengths, uint64_t** mse[2], int sb_count, int start_gi, int end_gi, uint64_t *tot_mse);
     uint32_t svt_aom_mse16x16_c(const uint8_t *src_ptr, int32_t  source_stride, const uint8_t *ref_ptr, int32_t  recon_stride, uint32_t *sse);
     RTCD_EXTERN uint32_t(*svt_aom_mse16x16)(const uint8_t *src_ptr, int32_t  source_stride, const uint8_t *ref_ptr, int32_t  recon_stride, uint32_t *sse);
     void svt_aom_quantize_b_c(const TranLow *coeff_ptr, int32_t stride,int32_t width, int32_t height, intptr_t n_coeffs, const int16_t *zbin_ptr, const int16_t *round_ptr,const int16_t *quant_ptr, const int16_t *quant_shift_ptr,TranLow *qcoeff_ptr, TranLow *dqcoeff_ptr, const int16_t *dequant_ptr,uint16_t *eob_ptr, const int16_t *scan, const int16_t *iscan,const QmVal *qm_ptr, const QmVal *iqm_ptr, const int32_t log_scale);
@@ -788,6 +790,10 @@ extern "C" {
     RTCD_EXTERN void(*svt_av1_calc_indices_dim1)(const int* data, const int* centroids, uint8_t* indices, int n, int k);
     void svt_av1_calc_indices_dim2_c(const int* data, const int* centroids, uint8_t* indices, int n, int k);
     RTCD_EXTERN void(*svt_av1_calc_indices_dim2)(const int* data, const int* centroids, uint8_t* indices, int n, int k);
+    int svt_av1_count_colors_c(const uint8_t *src, int stride, int rows, int cols, int *val_count);
+    RTCD_EXTERN int(*svt_av1_count_colors)(const uint8_t *src, int stride, int rows, int cols, int *val_count);
+    int svt_av1_count_colors_highbd_c(uint16_t *src, int stride, int rows, int cols, int bit_depth, int *val_count);
+    RTCD_EXTERN int(*svt_av1_count_colors_highbd)(uint16_t *src, int stride, int rows, int cols, int bit_depth, int *val_count);
     RTCD_EXTERN void(*svt_av1_apply_filtering)(const uint8_t *y_src, int y_src_stride, const uint8_t *y_pre, int y_pre_stride, const uint8_t *u_src, const uint8_t *v_src, int uv_src_stride, const uint8_t *u_pre, const uint8_t *v_pre, int uv_pre_stride, unsigned int block_width, unsigned int block_height, int ss_x, int ss_y, int strength, const int *blk_fw, int use_whole_blk, uint32_t *y_accum, uint16_t *y_count, uint32_t *u_accum, uint16_t *u_count, uint32_t *v_accum, uint16_t *v_count);
     RTCD_EXTERN void(*svt_av1_apply_filtering_highbd)(const uint16_t *y_src, int y_src_stride, const uint16_t *y_pre, int y_pre_stride, const uint16_t *u_src, const uint16_t *v_src, int uv_src_stride, const uint16_t *u_pre, const uint16_t *v_pre, int uv_pre_stride, unsigned int block_width, unsigned int block_height, int ss_x, int ss_y, int strength, const int *blk_fw, int use_whole_blk, uint32_t *y_accum, uint16_t *y_count, uint32_t *u_accum, uint16_t *u_count, uint32_t *v_accum, uint16_t *v_count);
 
@@ -858,6 +864,8 @@ extern "C" {
     RTCD_EXTERN uint64_t(*svt_compute_sub_mean_8x8)(uint8_t* input_samples, uint16_t input_stride);
     uint64_t svt_compute_sub_mean_8x8_c(uint8_t* input_samples, uint16_t input_stride);
     RTCD_EXTERN void(*svt_compute_interm_var_four8x8)(uint8_t *input_samples, uint16_t input_stride, uint64_t *mean_of8x8_blocks, uint64_t *mean_of_squared8x8_blocks);
+    RTCD_EXTERN void(*svt_compute_mean_8x8_64x64)(uint8_t *input_samples, uint32_t input_stride, Bool subsample, uint64_t *mean_of8x8_blocks, uint64_t *mean_of_squared8x8_blocks);
+    void svt_compute_mean_8x8_64x64_c(uint8_t *input_samples, uint32_t input_stride, Bool subsample, uint64_t *mean_of8x8_blocks, uint64_t *mean_of_squared8x8_blocks);
     RTCD_EXTERN uint32_t(*sad_16b_kernel)(uint16_t *src, uint32_t src_stride, uint16_t *ref, uint32_t ref_stride, uint32_t height, uint32_t width);
     struct svt_mv_cost_param;
     void svt_pme_sad_loop_kernel_c(const struct svt_mv_cost_param *mv_cost_params, uint8_t* src, uint32_t src_stride, uint8_t* ref, uint32_t ref_stride, uint32_t block_height, uint32_t block_width, uint32_t *best_cost, int16_t *best_mvx, int16_t *best_mvy, int16_t search_position_start_x, int16_t search_position_start_y, int16_t search_area_width, int16_t search_area_height, int16_t search_step, int16_t mvx, int16_t mvy);
@@ -887,6 +895,7 @@ extern "C" {
     void svt_aom_noise_tx_filter_c(int32_t block_size, float *block_ptr, const float psd);
     RTCD_EXTERN void (*svt_aom_flat_block_finder_extract_block)(const AomFlatBlockFinder *block_finder, const uint8_t *const data, int32_t w, int32_t h, int32_t stride, int32_t offsx, int32_t offsy, double *plane, double *block);
     void svt_aom_flat_block_finder_extract_block_c(const AomFlatBlockFinder *block_finder, const uint8_t *const data, int32_t w, int32_t h, int32_t stride, int32_t offsx, int32_t offsy, double *plane, double *block);
+    RTCD_EXTERN void (*svt_aom_flat_block_finder_block_stats)(const double *blocks, int32_t block_size, int32_t num_blocks, double *stats);
     RTCD_EXTERN void(*svt_av1_interpolate_core)(const uint8_t *const input, int in_length, uint8_t *output, int out_length, const int16_t *interp_filters);
     void svt_av1_interpolate_core_c(const uint8_t *const input, int in_length, uint8_t *output, int out_length, const int16_t *interp_filters);
     RTCD_EXTERN void(*svt_av1_down2_symeven)(const uint8_t *const input, int length, uint8_t *output);
@@ -909,6 +918,18 @@ extern "C" {
     double svt_ssim_8x8_hbd_c(const uint16_t* s, uint32_t sp, const uint16_t* r, uint32_t rp);
     RTCD_EXTERN double (*svt_ssim_4x4_hbd)(const uint16_t* s, uint32_t sp, const uint16_t* r, uint32_t rp);
     double svt_ssim_4x4_hbd_c(const uint16_t* s, uint32_t sp, const uint16_t* r, uint32_t rp);
+    RTCD_EXTERN void (*svt_ssim_4x4_sums)(const uint8_t* s, uint32_t sp, const uint8_t* r, uint32_t rp, uint32_t count, uint32_t* sums);
+    void svt_ssim_4x4_sums_c(const uint8_t* s, uint32_t sp, const uint8_t* r, uint32_t rp, uint32_t count, uint32_t* sums);
+    RTCD_EXTERN void (*svt_ssim_4x4_sums_hbd)(const uint16_t* s, uint32_t sp, const uint16_t* r, uint32_t rp, uint32_t count, uint32_t* sums);
+    void svt_ssim_4x4_sums_hbd_c(const uint16_t* s, uint32_t sp, const uint16_t* r, uint32_t rp, uint32_t count, uint32_t* sums);
+    RTCD_EXTERN void (*svt_av1_fast9_score)(const uint8_t *im, int stride, const int *corners_xy, int num_corners, int b, int *scores);
+    void svt_av1_fast9_score_c(const uint8_t *im, int stride, const int *corners_xy, int num_corners, int b, int *scores);
+    RTCD_EXTERN void (*svt_av1_normal_equations)(const double *A, int rows, int n, int stride, const double *b, double *at_a, double *atb);
+    void svt_av1_normal_equations_c(const double *A, int rows, int n, int stride, const double *b, double *at_a, double *atb);
+    RTCD_EXTERN int (*svt_av1_ransac_find_inliers)(const double *mat, const double *x1, const double *y1, const double *x2, const double *y2, int npoints, double thresh_pow2, int *inlier_indices, double *sum_distance, double *sum_distance_squared);
+    int svt_av1_ransac_find_inliers_c(const double *mat, const double *x1, const double *y1, const double *x2, const double *y2, int npoints, double thresh_pow2, int *inlier_indices, double *sum_distance, double *sum_distance_squared);
+    RTCD_EXTERN uint32_t (*svt_av1_get_crc32c_value)(void *crc_calculator, uint8_t *p, size_t length);
+    uint32_t svt_av1_get_crc32c_value_c(void *crc_calculator, uint8_t *p, size_t length);
 
 #ifdef ARCH_AARCH64
     void svt_av1_compute_stats_neon(int32_t wiener_win, const uint8_t *dgd8, const uint8_t *src8, int32_t h_start, int32_t h_end, int32_t v_start, int32_t v_end, int32_t dgd_stride, int32_t src_stride, int64_t *M, int64_t *H);
@@ -1221,6 +1242,8 @@ extern "C" {
     uint64_t svt_aom_compute_cdef_dist_8bit_neon(const uint8_t *dst8, int32_t dstride, const uint8_t *src8,
                                                  const CdefList *dlist, int32_t cdef_count, BlockSize bsize,
                                                  int32_t coeff_shift, int32_t pli, uint8_t subsampling_factor);
+    uint64_t svt_search_one_dual_neon(int *lev0, int *lev1, int nb_strengths, uint64_t** mse[2], int sb_count, int start_gi, int end_gi);
+    void svt_search_one_dual_tot_mse_neon(int *lev0, int *lev1, int nb_strengths, uint64_t** mse[2], int sb_count, int start_gi, int end_gi, uint64_t *tot_mse);
 
     void svt_av1_fwd_txfm2d_16x16_N4_neon(int16_t *input, int32_t *output, uint32_t input_stride, TxType transform_type, uint8_t  bit_depth);
     void svt_av1_fwd_txfm2d_32x32_N4_neon(int16_t *input, int32_t *output, uint32_t stride, TxType tx_type, uint8_t bd);
@@ -1267,6 +1290,25 @@ extern "C" {
         const uint16_t *u_pre, const uint16_t *v_pre, int uv_pre_stride, unsigned int block_width,
         unsigned int block_height, int ss_x, int ss_y, uint32_t *y_accum, uint16_t *y_count, uint32_t *u_accum,
         uint16_t *u_count, uint32_t *v_accum, uint16_t *v_count, uint32_t encoder_bit_depth);
+    double svt_ssim_8x8_neon(const uint8_t* s, uint32_t sp, const uint8_t* r, uint32_t rp);
+    double svt_ssim_4x4_neon(const uint8_t* s, uint32_t sp, const uint8_t* r, uint32_t rp);
+    double svt_ssim_8x8_hbd_neon(const uint16_t* s, uint32_t sp, const uint16_t* r, uint32_t rp);
+    double svt_ssim_4x4_hbd_neon(const uint16_t* s, uint32_t sp, const uint16_t* r, uint32_t rp);
+    void svt_ssim_4x4_sums_neon(const uint8_t* s, uint32_t sp, const uint8_t* r, uint32_t rp, uint32_t count, uint32_t* sums);
+    void svt_ssim_4x4_sums_hbd_neon(const uint16_t* s, uint32_t sp, const uint16_t* r, uint32_t rp, uint32_t count, uint32_t* sums);
+    void svt_av1_add_block_observations_internal_neon(uint32_t n, const double val, const double recp_sqr_norm, double *buffer, double *buffer_norm, double *b, double *A);
+    void svt_av1_pointwise_multiply_neon(const float *a, float *b, float *c, double *b_d, double *c_d, int32_t n);
+    void svt_av1_apply_window_function_to_plane_neon(int32_t y_size, int32_t x_size, float *result_ptr, uint32_t result_stride, float *block, float *plane, const float *window_function);
+    void svt_aom_flat_block_finder_block_stats_neon(const double *blocks, int32_t block_size, int32_t num_blocks, double *stats);
+    void svt_av1_fast9_score_neon(const uint8_t *im, int stride, const int *corners_xy, int num_corners, int b, int *scores);
+    void svt_av1_k_means_dim1_neon(const int* data, int* centroids, uint8_t* indices, int n, int k, int max_itr);
+    void svt_av1_k_means_dim2_neon(const int* data, int* centroids, uint8_t* indices, int n, int k, int max_itr);
+    void svt_av1_calc_indices_dim1_neon(const int* data, const int* centroids, uint8_t* indices, int n, int k);
+    void svt_av1_calc_indices_dim2_neon(const int* data, const int* centroids, uint8_t* indices, int n, int k);
+    int svt_av1_count_colors_neon(const uint8_t *src, int stride, int rows, int cols, int *val_count);
+    int svt_av1_count_colors_highbd_neon(uint16_t *src, int stride, int rows, int cols, int bit_depth, int *val_count);
+    uint32_t svt_av1_get_crc32c_value_arm_crc32(void *crc_calculator, uint8_t *p, size_t length);
+    void svt_compute_mean_8x8_64x64_neon(uint8_t *input_samples, uint32_t input_stride, Bool subsample, uint64_t *mean_of8x8_blocks, uint64_t *mean_of_squared8x8_blocks);
 
 #endif
 
@@ -1467,6 +1509,7 @@ extern "C" {
     uint64_t svt_handle_transform64x64_avx2(int32_t *output);
     uint64_t svt_search_one_dual_avx2(int *lev0, int *lev1, int nb_strengths, uint64_t** mse[2], int sb_count, int start_gi, int end_gi);
     uint64_t svt_search_one_dual_avx512(int *lev0, int *lev1, int nb_strengths, uint64_t** mse[2], int sb_count, int start_gi, int end_gi);
+    void svt_search_one_dual_tot_mse_avx2(int *lev0, int *lev1, int nb_strengths, uint64_t** mse[2], int sb_count, int start_gi, int end_gi, uint64_t *tot_mse);
     uint32_t svt_aom_mse16x16_sse2(const uint8_t *src_ptr, int32_t  source_stride, const uint8_t *ref_ptr, int32_t  recon_stride, uint32_t *sse);
     uint32_t svt_aom_mse16x16_avx2(const uint8_t *src_ptr, int32_t  source_stride, const uint8_t *ref_ptr, int32_t  recon_stride, uint32_t *sse);
 
@@ -1933,6 +1976,9 @@ extern "C" {
 
     void svt_av1_calc_indices_dim2_avx2(const int* data, const int* centroids, uint8_t* indices, int n, int k);
 
+    int svt_av1_count_colors_avx2(const uint8_t *src, int stride, int rows, int cols, int *val_count);
+    int svt_av1_count_colors_highbd_avx2(uint16_t *src, int stride, int rows, int cols, int bit_depth, int *val_count);
+
     void svt_ext_sad_calculation_8x8_16x16_avx2_intrin(uint8_t *src, uint32_t src_stride, uint8_t *ref,
         uint32_t ref_stride, uint32_t *p_best_sad_8x8,
         uint32_t *p_best_sad_16x16, uint32_t *p_best_mv8x8,
@@ -2022,6 +2068,8 @@ extern "C" {
     void svt_compute_interm_var_four8x8_avx2_intrin(uint8_t *input_samples, uint16_t input_stride,
         uint64_t *mean_of8x8_blocks, // mean of four  8x8
         uint64_t *mean_of_squared8x8_blocks);
+    void svt_compute_mean_8x8_64x64_avx2(uint8_t *input_samples, uint32_t input_stride, Bool subsample,
+        uint64_t *mean_of8x8_blocks, uint64_t *mean_of_squared8x8_blocks);
     uint32_t svt_aom_sad_16bit_kernel_avx2(uint16_t *src, uint32_t src_stride, uint16_t *ref,
         uint32_t ref_stride, uint32_t height, uint32_t width);
 
@@ -2091,6 +2139,7 @@ extern "C" {
     void svt_av1_apply_window_function_to_plane_avx2(int32_t y_size, int32_t x_size, float *result_ptr, uint32_t result_stride, float *block, float *plane, const float *window_function);
     void svt_aom_noise_tx_filter_avx2(int32_t block_size, float *block_ptr, const float psd);
     void svt_aom_flat_block_finder_extract_block_avx2(const AomFlatBlockFinder *block_finder, const uint8_t *const data, int32_t w, int32_t h, int32_t stride, int32_t offsx, int32_t offsy, double *plane, double *block);
+    void svt_aom_flat_block_finder_block_stats_avx2(const double *blocks, int32_t block_size, int32_t num_blocks, double *stats);
     void svt_av1_interpolate_core_avx2(const uint8_t *const input, int in_length, uint8_t *output, int out_length, const int16_t *interp_filters);
     void svt_av1_down2_symeven_avx2(const uint8_t *const input, int length, uint8_t *output);
     void svt_av1_highbd_interpolate_core_avx2(const uint16_t *const input, int in_length, uint16_t *output, int out_length, int bd, const int16_t *interp_filters);
@@ -2102,6 +2151,12 @@ extern "C" {
     double svt_ssim_4x4_avx2(const uint8_t* s, uint32_t sp, const uint8_t* r, uint32_t rp);
     double svt_ssim_8x8_hbd_avx2(const uint16_t* s, uint32_t sp, const uint16_t* r, uint32_t rp);
     double svt_ssim_4x4_hbd_avx2(const uint16_t* s, uint32_t sp, const uint16_t* r, uint32_t rp);
+    void svt_ssim_4x4_sums_avx2(const uint8_t* s, uint32_t sp, const uint8_t* r, uint32_t rp, uint32_t count, uint32_t* sums);
+    void svt_ssim_4x4_sums_hbd_avx2(const uint16_t* s, uint32_t sp, const uint16_t* r, uint32_t rp, uint32_t count, uint32_t* sums);
+    void svt_av1_fast9_score_avx2(const uint8_t *im, int stride, const int *corners_xy, int num_corners, int b, int *scores);
+    void svt_av1_normal_equations_avx2(const double *A, int rows, int n, int stride, const double *b, double *at_a, double *atb);
+    int svt_av1_ransac_find_inliers_avx2(const double *mat, const double *x1, const double *y1, const double *x2, const double *y2, int npoints, double thresh_pow2, int *inlier_indices, double *sum_distance, double *sum_distance_squared);
+    uint32_t svt_av1_get_crc32c_value_sse4_2(void *crc_calculator, uint8_t *p, size_t length);
 #endif
 
     /* Moved to aom_dsp_rtcd.c file:
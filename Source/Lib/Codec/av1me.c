@@ -1231,7 +1231,7 @@ int svt_av1_full_pixel_search(PictureControlSet *pcs, IntraBcContext *x, BlockSi
                 int       best_hash_cost = INT_MAX;
 
                 // for the hashMap
-                HashTable *ref_frame_hash = &pcs->hash_table;
+                const HashTable *ref_frame_hash = &pcs->hash_table;
 
                 svt_av1_get_block_hash_value(what, what_stride, block_width, &hash_value1, &hash_value2, 0, pcs, x);
 
@@ -1239,9 +1239,9 @@ int svt_av1_full_pixel_search(PictureControlSet *pcs, IntraBcContext *x, BlockSi
                 // for intra, at least one matching can be found, itself.
                 if (count <= (intra ? 1 : 0))
                     break;
-                Iterator iterator = svt_av1_hash_get_first_iterator(ref_frame_hash, hash_value1);
-                for (int i = 0; i < count; i++, svt_aom_iterator_increment(&iterator)) {
-                    BlockHash ref_block_hash = *(BlockHash *)(svt_aom_iterator_get(&iterator));
+                const BlockHash *ref_block_hashes = svt_av1_hash_get_first_block(ref_frame_hash, hash_value1);
+                for (int i = 0; i < count; i++) {
+                    BlockHash ref_block_hash = ref_block_hashes[i];
                     if (hash_value2 == ref_block_hash.hash_value2) {
                         // For intra, make sure the prediction is from valid area.
                         if (intra) {
@@ -12,6 +12,7 @@
 #include "cdef.h"
 #include "common_dsp_rtcd.h"
 #include "bitstream_unit.h"
+#include "svt_malloc.h"
 
 //-------memory stuff
 
@@ -58,6 +59,7 @@ void *svt_aom_memalign(size_t align, size_t size) {
     if (addr) {
         x = align_addr((uint8_t *)addr + ADDRESS_STORAGE_SIZE, align);
         set_actual_malloc_address(x, addr);
+        svt_memory_account_add_alloc(aligned_size);
     }
     return x;
 }
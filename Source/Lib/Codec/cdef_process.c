@@ -11,6 +11,7 @@
 */
 
 #include <stdlib.h>
+#include <string.h>
 #include "aom_dsp_rtcd.h"
 #include "definitions.h"
 #include "enc_handle.h"
@@ -25,6 +26,8 @@
 #include "utility.h"
 #include "pcs.h"
 #include "resize.h"
+#include "svt_trace.h"
+#include "segment_workers.h"
 
 void svt_aom_copy_sb8_16(uint16_t *dst, int32_t dstride, const uint8_t *src, int32_t src_voffset, int32_t src_hoffset,
                          int32_t sstride, int32_t vsize, int32_t hsize, Bool is_16bit);
@@ -35,7 +38,7 @@ void   *svt_aom_malloc(size_t size);
 int32_t svt_sb_all_skip(PictureControlSet *pcs, const Av1Common *const cm, int32_t mi_row, int32_t mi_col);
 int32_t svt_sb_compute_cdef_list(PictureControlSet *pcs, const Av1Common *const cm, int32_t mi_row, int32_t mi_col,
                                  CdefList *dlist, BlockSize bs);
-void    finish_cdef_search(PictureControlSet *pcs);
+void    finish_cdef_search(PictureControlSet *pcs, struct CdefSearchDispatch *dispatch);
 void    svt_av1_cdef_frame(SequenceControlSet *scs, PictureControlSet *pcs);
 void    svt_av1_loop_restoration_save_boundary_lines(const Yv12BufferConfig *frame, Av1Common *cm, int32_t after_cdef);
 void    svt_av1_superres_upscale_frame(struct Av1Common *cm, PictureControlSet *pcs, SequenceControlSet *scs);
@@ -43,17 +46,36 @@ void    set_unscaled_input_16bit(PictureControlSet *pcs);
 
 void svt_aom_get_recon_pic(PictureControlSet *pcs, EbPictureBufferDesc **recon_ptr, Bool is_highbd);
 
+// minimum number of (filter block, strength pair) updates given to one joint search segment
+#define CDEF_SEARCH_MIN_SEGMENT_WORK (1 << 17)
+
+/* Splits the filter blocks of one joint strength search step in bands searched by the CDEF search workers */
+typedef struct CdefSearchDispatch {
+    SegmentDispatch segments;
+    int            *lev0;
+    int            *lev1;
+    int             nb_strengths;
+    uint64_t      **mse[2];
+    int             sb_count;
+    int             start_gi;
+    int             end_gi;
+    uint64_t       *tot_mse; // one TOTAL_STRENGTHS x TOTAL_STRENGTHS partial sum per segment
+} CdefSearchDispatch;
+
 /**************************************
  * Cdef Context
  **************************************/
 typedef struct CdefContext {
-    EbFifo *cdef_input_fifo_ptr;
-    EbFifo *cdef_output_fifo_ptr;
+    EbFifo            *cdef_input_fifo_ptr;
+    EbFifo            *cdef_output_fifo_ptr;
+    CdefSearchDispatch search_dispatch;
 } CdefContext;
 
 static void cdef_context_dctor(EbPtr p) {
     EbThreadContext *thread_ctx = (EbThreadContext *)p;
     CdefContext     *obj        = (CdefContext *)thread_ctx->priv;
+    svt_aom_segment_dispatch_deinit(&obj->search_dispatch.segments);
+    EB_FREE_ARRAY(obj->search_dispatch.tot_mse);
     EB_FREE_ARRAY(obj);
 }
 
@@ -72,9 +94,70 @@ EbErrorType svt_aom_cdef_context_ctor(EbThreadContext *thread_ctx, const EbEncHa
     cdef_ctx->cdef_output_fifo_ptr = svt_system_resource_get_producer_fifo(enc_handle_ptr->cdef_results_resource_ptr,
                                                                            index);
 
+    // The CDEF thread runs the first band of each search step, the workers the others
+    CdefSearchDispatch *dispatch     = &cdef_ctx->search_dispatch;
+    EbErrorType         return_error = svt_aom_segment_dispatch_init(
+        &dispatch->segments, enc_handle_ptr->cdef_search_workers, index, CDEF_SEARCH_MAX_SEGMENTS);
+    if (return_error != EB_ErrorNone)
+        return return_error;
+    if (dispatch->segments.max_segment_count > 1)
+        EB_MALLOC_ARRAY(dispatch->tot_mse, dispatch->segments.max_segment_count * TOTAL_STRENGTHS * TOTAL_STRENGTHS);
+
     return EB_ErrorNone;
 }
 
+/* Accumulates the strength pair mse of the filter blocks of one band of the current step */
+static void cdef_search_segment(void *job, uint16_t segment_index, uint16_t segment_count) {
+    CdefSearchDispatch *dispatch = (CdefSearchDispatch *)job;
+    const int           sb_start = dispatch->sb_count * segment_index / segment_count;
+    const int           sb_end   = dispatch->sb_count * (segment_index + 1) / segment_count;
+    uint64_t           *tot_mse  = dispatch->tot_mse + segment_index * TOTAL_STRENGTHS * TOTAL_STRENGTHS;
+    uint64_t          **mse[2]   = {dispatch->mse[0] + sb_start, dispatch->mse[1] + sb_start};
+
+    memset(tot_mse, 0, sizeof(*tot_mse) * TOTAL_STRENGTHS * TOTAL_STRENGTHS);
+    svt_search_one_dual_tot_mse(dispatch->lev0,
+                                dispatch->lev1,
+                                dispatch->nb_strengths,
+                                mse,
+                                sb_end - sb_start,
+                                dispatch->start_gi,
+                                dispatch->end_gi,
+                                tot_mse);
+}
+
+/*
+ * Same as svt_search_one_dual(), with the filter blocks split in bands searched in
+ * parallel. The band sums are added in band order, and being integer the result is
+ * identical to the single threaded search.
+ */
+uint64_t svt_aom_cdef_search_one_dual_mt(CdefSearchDispatch *dispatch, int *lev0, int *lev1, int nb_strengths,
+                                         uint64_t **mse[2], int sb_count, int start_gi, int end_gi) {
+    const uint64_t work      = (uint64_t)sb_count * (end_gi - start_gi) * (end_gi - start_gi);
+    const uint16_t seg_count = (uint16_t)MAX(
+        1, MIN(dispatch->segments.max_segment_count, work / CDEF_SEARCH_MIN_SEGMENT_WORK));
+    if (seg_count == 1)
+        return svt_search_one_dual(lev0, lev1, nb_strengths, mse, sb_count, start_gi, end_gi);
+
+    dispatch->lev0         = lev0;
+    dispatch->lev1         = lev1;
+    dispatch->nb_strengths = nb_strengths;
+    dispatch->mse[0]       = mse[0];
+    dispatch->mse[1]       = mse[1];
+    dispatch->sb_count     = sb_count;
+    dispatch->start_gi     = start_gi;
+    dispatch->end_gi       = end_gi;
+    svt_aom_segment_dispatch_run(&dispatch->segments, seg_count, cdef_search_segment, dispatch);
+
+    uint64_t *tot_mse = dispatch->tot_mse;
+    for (uint16_t seg = 1; seg < seg_count; ++seg) {
+        const uint64_t *seg_mse = dispatch->tot_mse + seg * TOTAL_STRENGTHS * TOTAL_STRENGTHS;
+        for (int j = start_gi; j < end_gi; j++)
+            for (int k = start_gi; k < end_gi; k++)
+                tot_mse[j * TOTAL_STRENGTHS + k] += seg_mse[j * TOTAL_STRENGTHS + k];
+    }
+    return svt_cdef_select_one_dual(lev0, lev1, nb_strengths, tot_mse, start_gi, end_gi);
+}
+
 #define default_mse_uv 1040400
 static uint64_t compute_cdef_dist(const EbByte dst, int32_t doffset, int32_t dstride, const uint8_t *src,
                                   const CdefList *dlist, int32_t cdef_count, BlockSize bsize, int32_t coeff_shift,
@@ -378,6 +461,7 @@ void *svt_aom_cdef_kernel(void *input_ptr) {
         pcs                           = (PictureControlSet *)dlf_results->pcs_wrapper->object_ptr;
         PictureParentControlSet *ppcs = pcs->ppcs;
         scs                           = pcs->scs;
+        SVT_TRACE_BEGIN("cdef", pcs->picture_number, (int32_t)dlf_results->segment_index);
 
         Bool       is_16bit      = scs->is_16bit_pipeline;
         Av1Common *cm            = pcs->ppcs->av1_cm;
@@ -395,7 +479,8 @@ void *svt_aom_cdef_kernel(void *input_ptr) {
         if (pcs->tot_seg_searched_cdef == pcs->cdef_segments_total_count) {
             // SVT_LOG("    CDEF all seg here  %i\n", pcs->picture_number);
             if (scs->seq_header.cdef_level && pcs->ppcs->cdef_level) {
-                finish_cdef_search(pcs);
+                context_ptr->search_dispatch.segments.picture_number = pcs->picture_number;
+                finish_cdef_search(pcs, &context_ptr->search_dispatch);
                 if (ppcs->enable_restoration || pcs->ppcs->is_ref || scs->static_config.recon_enabled) {
                     // Do application iff there are non-zero filters
                     if (frm_hdr->cdef_params.cdef_y_strength[0] != 0 || frm_hdr->cdef_params.cdef_uv_strength[0] != 0 ||
@@ -470,6 +555,7 @@ void *svt_aom_cdef_kernel(void *input_ptr) {
                 cdef_results                = (struct CdefResults *)cdef_results_wrapper->object_ptr;
                 cdef_results->pcs_wrapper   = dlf_results->pcs_wrapper;
                 cdef_results->segment_index = segment_index;
+                cdef_results->input_type    = REST_INPUT_SEGMENT;
                 // Post Cdef Results
                 svt_post_full_object(cdef_results_wrapper);
             }
@@ -15,6 +15,9 @@
 #include "sys_resource_manager.h"
 #include "object.h"
 
+// most filter block bands one joint strength search step is split in
+#define CDEF_SEARCH_MAX_SEGMENTS 16
+
 /**************************************
  * Extern Function Declarations
  **************************************/
@@ -22,4 +25,8 @@ extern EbErrorType svt_aom_cdef_context_ctor(EbThreadContext *thread_ctx, const
 
 extern void *svt_aom_cdef_kernel(void *input_ptr);
 
+struct CdefSearchDispatch;
+uint64_t svt_aom_cdef_search_one_dual_mt(struct CdefSearchDispatch *dispatch, int *lev0, int *lev1, int nb_strengths,
+                                         uint64_t **mse[2], int sb_count, int start_gi, int end_gi);
+
 #endif
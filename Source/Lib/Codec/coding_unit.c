@@ -31,6 +31,35 @@ Tasks & Questions
     -Need a ReconPicture for each candidate.
     -I don't see a way around doing the copies in temp memory and then copying it in...
 */
+void svt_aom_get_sb_block_limits(EncMode enc_mode, bool *disallow_nsq, bool *disallow_4x4) {
+    *disallow_nsq = true;
+    for (uint8_t is_base = 0; is_base <= 1; is_base++) {
+        for (uint8_t is_islice = 0; is_islice <= 1; is_islice++) {
+            for (uint8_t coeff_lvl = 0; coeff_lvl <= HIGH_LVL + 1; coeff_lvl++) {
+                if (!*disallow_nsq)
+                    break;
+                *disallow_nsq = MIN(*disallow_nsq,
+                                    (svt_aom_get_nsq_geom_level(enc_mode, is_base, coeff_lvl) == 0 ? 1 : 0));
+            }
+        }
+    }
+
+    *disallow_4x4 = true;
+    for (uint8_t is_islice = 0; is_islice <= 1; is_islice++) {
+        for (uint8_t is_base = 0; is_base <= 1; is_base++) {
+            *disallow_4x4 = MIN(*disallow_4x4, svt_aom_get_disallow_4x4(enc_mode, is_base));
+        }
+    }
+}
+
+uint32_t svt_aom_get_final_blk_count(uint8_t sb_size, EncMode enc_mode) {
+    bool disallow_nsq, disallow_4x4;
+    svt_aom_get_sb_block_limits(enc_mode, &disallow_nsq, &disallow_4x4);
+    if (sb_size == 128)
+        return disallow_4x4 && disallow_nsq ? 260 : disallow_4x4 ? 512 : 1024;
+    return disallow_4x4 && disallow_nsq ? 65 : disallow_4x4 ? 128 : 256;
+}
+
 EbErrorType svt_aom_largest_coding_unit_ctor(SuperBlock *larget_coding_unit_ptr, uint8_t sb_size_pix,
                                              uint16_t sb_origin_x, uint16_t sb_origin_y, uint16_t sb_index,
                                              EncMode enc_mode, uint16_t max_block_cnt,
@@ -49,38 +78,7 @@ EbErrorType svt_aom_largest_coding_unit_ctor(SuperBlock *larget_coding_unit_ptr,
     larget_coding_unit_ptr->org_y = sb_origin_y;
 
     larget_coding_unit_ptr->index = sb_index;
-    bool disallow_nsq             = true;
-    for (uint8_t is_base = 0; is_base <= 1; is_base++) {
-        for (uint8_t is_islice = 0; is_islice <= 1; is_islice++) {
-            for (uint8_t coeff_lvl = 0; coeff_lvl <= HIGH_LVL + 1; coeff_lvl++) {
-                if (!disallow_nsq)
-                    break;
-                disallow_nsq = MIN(disallow_nsq,
-                                   (svt_aom_get_nsq_geom_level(enc_mode, is_base, coeff_lvl) == 0 ? 1 : 0));
-            }
-        }
-    }
-
-    bool disallow_4x4 = true;
-    for (uint8_t is_islice = 0; is_islice <= 1; is_islice++) {
-        for (uint8_t is_base = 0; is_base <= 1; is_base++) {
-            disallow_4x4 = MIN(disallow_4x4, svt_aom_get_disallow_4x4(enc_mode, is_base));
-        }
-    }
-    uint32_t tot_blk_num;
-    if (sb_size_pix == 128)
-        if (disallow_4x4 && disallow_nsq)
-            tot_blk_num = 260;
-        else if (disallow_4x4)
-            tot_blk_num = 512;
-        else
-            tot_blk_num = 1024;
-    else if (disallow_4x4 && disallow_nsq)
-        tot_blk_num = 65;
-    else if (disallow_4x4)
-        tot_blk_num = 128;
-    else
-        tot_blk_num = 256;
+    const uint32_t tot_blk_num = svt_aom_get_final_blk_count(sb_size_pix, enc_mode);
     EB_MALLOC_ARRAY(larget_coding_unit_ptr->final_blk_arr, tot_blk_num);
     EB_MALLOC_ARRAY(larget_coding_unit_ptr->av1xd, 1);
     // Do NOT initialize the final_blk_arr here
@@ -162,7 +162,7 @@ typedef struct IntraBcContext {
     // [two buffers used ping-pong]
     uint32_t      *hash_value_buffer[2][2];
     uint8_t        is_exhaustive_allowed;
-    CRC_CALCULATOR crc_calculator1;
+    CRC32C         crc32c;
     CRC_CALCULATOR crc_calculator2;
     // use approximate rate for inter cost (set at pic-level b/c some pic-level initializations will
     // be removed)
@@ -344,6 +344,10 @@ typedef struct SuperBlock {
     uint16_t       final_blk_cnt; // number of block(s) posted from EncDec to EC
 } SuperBlock;
 
+/* Whether no frame of enc_mode can use NSQ shapes or 4x4 blocks */
+void svt_aom_get_sb_block_limits(EncMode enc_mode, bool *disallow_nsq, bool *disallow_4x4);
+/* Size of the final_blk_arr of a superblock */
+uint32_t svt_aom_get_final_blk_count(uint8_t sb_size, EncMode enc_mode);
 extern EbErrorType svt_aom_largest_coding_unit_ctor(SuperBlock *larget_coding_unit_ptr, uint8_t sb_size,
                                                     uint16_t sb_origin_x, uint16_t sb_origin_y, uint16_t sb_index,
                                                     EncMode enc_mode, uint16_t max_block_cnt,
@@ -520,6 +520,10 @@ void svt_aom_setup_common_rtcd_internal(EbCpuFlags flags) {
     SET_SSE41_AVX2(svt_full_distortion_kernel32_bits, svt_full_distortion_kernel32_bits_c, svt_full_distortion_kernel32_bits_sse4_1, svt_full_distortion_kernel32_bits_avx2);
     SET_SSE41_AVX2_AVX512(svt_spatial_full_distortion_kernel, svt_spatial_full_distortion_kernel_c, svt_spatial_full_distortion_kernel_sse4_1, svt_spatial_full_distortion_kernel_avx2, svt_spatial_full_distortion_kernel_avx512);
     SET_SSE41_AVX2(svt_full_distortion_kernel16_bits, svt_full_distortion_kernel16_bits_c, svt_full_distortion_kernel16_bits_sse4_1, svt_full_distortion_kernel16_bits_avx2);
+    SET_AVX2_AVX512(svt_psy_distortion, svt_psy_distortion_c, svt_psy_distortion_avx2, svt_psy_distortion_avx512);
+    SET_AVX2_AVX512(svt_psy_distor_hbd, svt_psy_distor_hbd_c, svt_psy_distor_hbd_avx2, svt_psy_distor_hbd_avx512);
+    SET_AVX2_AVX512(svt_psy_ac_energy, svt_psy_ac_energy_c, svt_psy_ac_energy_avx2, svt_psy_ac_energy_avx512);
+    SET_AVX2_AVX512(svt_psy_ac_energy_hbd, svt_psy_ac_energy_hbd_c, svt_psy_ac_energy_hbd_avx2, svt_psy_ac_energy_hbd_avx512);
     SET_SSE41_AVX2_AVX512(svt_residual_kernel8bit, svt_residual_kernel8bit_c, svt_residual_kernel8bit_sse4_1, svt_residual_kernel8bit_avx2, svt_residual_kernel8bit_avx512);
     SET_SSE2_AVX2(svt_residual_kernel16bit, svt_residual_kernel16bit_c, svt_residual_kernel16bit_sse2_intrin, svt_residual_kernel16bit_avx2);
     SET_SSE2(svt_picture_average_kernel, svt_picture_average_kernel_c, svt_picture_average_kernel_sse2_intrin);
@@ -1051,6 +1055,10 @@ void svt_aom_setup_common_rtcd_internal(EbCpuFlags flags) {
     SET_NEON(svt_full_distortion_kernel32_bits, svt_full_distortion_kernel32_bits_c, svt_full_distortion_kernel32_bits_neon);
     SET_NEON(svt_spatial_full_distortion_kernel, svt_spatial_full_distortion_kernel_c, svt_spatial_full_distortion_kernel_neon);
     SET_NEON(svt_full_distortion_kernel16_bits, svt_full_distortion_kernel16_bits_c, svt_full_distortion_kernel16_bits_neon);
+    SET_NEON(svt_psy_distortion, svt_psy_distortion_c, svt_psy_distortion_neon);
+    SET_NEON(svt_psy_distor_hbd, svt_psy_distor_hbd_c, svt_psy_distor_hbd_neon);
+    SET_NEON(svt_psy_ac_energy, svt_psy_ac_energy_c, svt_psy_ac_energy_neon);
+    SET_NEON(svt_psy_ac_energy_hbd, svt_psy_ac_energy_hbd_c, svt_psy_ac_energy_hbd_neon);
     SET_NEON(svt_residual_kernel8bit, svt_residual_kernel8bit_c, svt_residual_kernel8bit_neon);
     SET_NEON(svt_residual_kernel16bit, svt_residual_kernel16bit_c, svt_residual_kernel16bit_neon);
     SET_ONLY_C(svt_picture_average_kernel, svt_picture_average_kernel_c);
@@ -1579,6 +1587,10 @@ void svt_aom_setup_common_rtcd_internal(EbCpuFlags flags) {
     SET_ONLY_C(svt_full_distortion_kernel32_bits, svt_full_distortion_kernel32_bits_c);
     SET_ONLY_C(svt_spatial_full_distortion_kernel, svt_spatial_full_distortion_kernel_c);
     SET_ONLY_C(svt_full_distortion_kernel16_bits, svt_full_distortion_kernel16_bits_c);
+    SET_ONLY_C(svt_psy_distortion, svt_psy_distortion_c);
+    SET_ONLY_C(svt_psy_distor_hbd, svt_psy_distor_hbd_c);
+    SET_ONLY_C(svt_psy_ac_energy, svt_psy_ac_energy_c);
+    SET_ONLY_C(svt_psy_ac_energy_hbd, svt_psy_ac_energy_hbd_c);
     SET_ONLY_C(svt_residual_kernel8bit, svt_residual_kernel8bit_c);
     SET_ONLY_C(svt_residual_kernel16bit, svt_residual_kernel16bit_c);
     SET_ONLY_C(svt_picture_average_kernel, svt_picture_average_kernel_c);
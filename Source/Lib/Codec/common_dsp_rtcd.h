@@ -38,6 +38,7 @@
 #define HAS_AVX512BW EB_CPU_FLAGS_AVX512BW
 #define HAS_AVX512VL EB_CPU_FLAGS_AVX512VL
 #define HAS_NEON EB_CPU_FLAGS_NEON
+#define HAS_ARM_CRC32 EB_CPU_FLAGS_ARM_CRC32
 #define HAS_NEON_DOTPROD EB_CPU_FLAGS_NEON_DOTPROD
 #define HAS_SVE EB_CPU_FLAGS_SVE
 
@@ -172,6 +173,14 @@ extern "C" {
     RTCD_EXTERN uint64_t(*svt_spatial_full_distortion_kernel)(uint8_t *input, uint32_t input_offset, uint32_t input_stride, uint8_t *recon, int32_t recon_offset, uint32_t recon_stride, uint32_t area_width, uint32_t area_height);
     uint64_t svt_full_distortion_kernel16_bits_c(uint8_t* input, uint32_t input_offset, uint32_t input_stride, uint8_t* recon, int32_t recon_offset, uint32_t recon_stride, uint32_t area_width, uint32_t area_height);
     RTCD_EXTERN uint64_t(*svt_full_distortion_kernel16_bits)(uint8_t* input, uint32_t input_offset, uint32_t input_stride, uint8_t* recon, int32_t recon_offset, uint32_t recon_stride, uint32_t area_width, uint32_t area_height);
+    uint64_t svt_psy_distortion_c(const uint8_t *input, uint32_t input_stride, const uint8_t *recon, uint32_t recon_stride, uint32_t width, uint32_t height, const uint32_t count);
+    RTCD_EXTERN uint64_t(*svt_psy_distortion)(const uint8_t *input, uint32_t input_stride, const uint8_t *recon, uint32_t recon_stride, uint32_t width, uint32_t height, const uint32_t count);
+    uint64_t svt_psy_distor_hbd_c(const uint16_t *input, uint32_t input_stride, const uint16_t *recon, uint32_t recon_stride, uint32_t width, uint32_t height, const uint32_t count);
+    RTCD_EXTERN uint64_t(*svt_psy_distor_hbd)(const uint16_t *input, uint32_t input_stride, const uint16_t *recon, uint32_t recon_stride, uint32_t width, uint32_t height, const uint32_t count);
+    void svt_psy_ac_energy_c(const uint8_t *src, uint32_t stride, uint32_t width, uint32_t height, int32_t *nrg);
+    RTCD_EXTERN void(*svt_psy_ac_energy)(const uint8_t *src, uint32_t stride, uint32_t width, uint32_t height, int32_t *nrg);
+    void svt_psy_ac_energy_hbd_c(const uint16_t *src, uint32_t stride, uint32_t width, uint32_t height, int32_t *nrg);
+    RTCD_EXTERN void(*svt_psy_ac_energy_hbd)(const uint16_t *src, uint32_t stride, uint32_t width, uint32_t height, int32_t *nrg);
     RTCD_EXTERN void(*svt_residual_kernel16bit)(uint16_t *input, uint32_t input_stride, uint16_t *pred, uint32_t pred_stride, int16_t *residual, uint32_t residual_stride, uint32_t area_width, uint32_t area_height);
     RTCD_EXTERN void(*avc_style_luma_interpolation_filter)(EbByte ref_pic, uint32_t src_stride, EbByte dst, uint32_t dst_stride, uint32_t pu_width, uint32_t pu_height, EbByte temp_buf, uint32_t frac_pos, uint8_t choice);
     void svt_av1_wiener_convolve_add_src_c(const uint8_t *const src, const ptrdiff_t src_stride, uint8_t *const dst, const ptrdiff_t dst_stride, const int16_t *const filter_x, const int16_t *const filter_y, const int32_t w, const int32_t h, const ConvolveParams *const conv_params);
@@ -1144,6 +1153,10 @@ extern "C" {
     void svt_av1_warp_affine_neon(const int32_t *mat, const uint8_t *ref, int width, int height, int stride, uint8_t *pred, int p_col, int p_row, int p_width, int p_height, int p_stride, int subsampling_x, int subsampling_y, ConvolveParams *conv_params, int16_t alpha, int16_t beta, int16_t gamma, int16_t delta);
 
     uint64_t svt_spatial_full_distortion_kernel_neon(uint8_t *input, uint32_t input_offset, uint32_t input_stride, uint8_t *recon, int32_t recon_offset, uint32_t recon_stride, uint32_t area_width, uint32_t area_height);
+    uint64_t svt_psy_distortion_neon(const uint8_t *input, uint32_t input_stride, const uint8_t *recon, uint32_t recon_stride, uint32_t width, uint32_t height, const uint32_t count);
+    uint64_t svt_psy_distor_hbd_neon(const uint16_t *input, uint32_t input_stride, const uint16_t *recon, uint32_t recon_stride, uint32_t width, uint32_t height, const uint32_t count);
+    void svt_psy_ac_energy_neon(const uint8_t *src, uint32_t stride, uint32_t width, uint32_t height, int32_t *nrg);
+    void svt_psy_ac_energy_hbd_neon(const uint16_t *src, uint32_t stride, uint32_t width, uint32_t height, int32_t *nrg);
 
     void svt_av1_wiener_convolve_add_src_neon(const uint8_t *const src, const ptrdiff_t src_stride, uint8_t *const dst, const ptrdiff_t dst_stride, const int16_t *const filter_x, const int16_t *const filter_y, const int32_t w, const int32_t h, const ConvolveParams *const conv_params);
 
@@ -1621,6 +1634,14 @@ extern "C" {
     uint64_t svt_spatial_full_distortion_kernel_sse4_1(uint8_t *input, uint32_t input_offset, uint32_t input_stride, uint8_t *recon, int32_t recon_offset, uint32_t recon_stride, uint32_t area_width, uint32_t area_height);
     uint64_t svt_spatial_full_distortion_kernel_avx2(uint8_t *input, uint32_t input_offset, uint32_t input_stride, uint8_t *recon, int32_t recon_offset, uint32_t recon_stride, uint32_t area_width, uint32_t area_height);
     uint64_t svt_spatial_full_distortion_kernel_avx512(uint8_t *input, uint32_t input_offset, uint32_t input_stride, uint8_t *recon, int32_t recon_offset, uint32_t recon_stride, uint32_t area_width, uint32_t area_height);
+    uint64_t svt_psy_distortion_avx2(const uint8_t *input, uint32_t input_stride, const uint8_t *recon, uint32_t recon_stride, uint32_t width, uint32_t height, const uint32_t count);
+    uint64_t svt_psy_distortion_avx512(const uint8_t *input, uint32_t input_stride, const uint8_t *recon, uint32_t recon_stride, uint32_t width, uint32_t height, const uint32_t count);
+    uint64_t svt_psy_distor_hbd_avx2(const uint16_t *input, uint32_t input_stride, const uint16_t *recon, uint32_t recon_stride, uint32_t width, uint32_t height, const uint32_t count);
+    uint64_t svt_psy_distor_hbd_avx512(const uint16_t *input, uint32_t input_stride, const uint16_t *recon, uint32_t recon_stride, uint32_t width, uint32_t height, const uint32_t count);
+    void svt_psy_ac_energy_avx2(const uint8_t *src, uint32_t stride, uint32_t width, uint32_t height, int32_t *nrg);
+    void svt_psy_ac_energy_avx512(const uint8_t *src, uint32_t stride, uint32_t width, uint32_t height, int32_t *nrg);
+    void svt_psy_ac_energy_hbd_avx2(const uint16_t *src, uint32_t stride, uint32_t width, uint32_t height, int32_t *nrg);
+    void svt_psy_ac_energy_hbd_avx512(const uint16_t *src, uint32_t stride, uint32_t width, uint32_t height, int32_t *nrg);
 
     uint64_t svt_full_distortion_kernel16_bits_sse4_1(uint8_t* input, uint32_t input_offset, uint32_t input_stride, uint8_t* recon, int32_t recon_offset, uint32_t recon_stride, uint32_t area_width, uint32_t area_height);
     uint64_t svt_full_distortion_kernel16_bits_avx2(uint8_t* input, uint32_t input_offset, uint32_t input_stride, uint8_t* recon, int32_t recon_offset, uint32_t recon_stride, uint32_t area_width, uint32_t area_height);
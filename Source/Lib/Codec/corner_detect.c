@@ -13,13 +13,48 @@
 #include "fast.h"
 
 #include "corner_detect.h"
+#include "aom_dsp_rtcd.h"
+
+/* FAST-9 score of each corner: the largest threshold at which 9 contiguous
+ * circle pixels are all brighter or all darker than the centre, never below b.
+ * This is the closed form of the binary search in svt_aom_fast9_score(). */
+void svt_av1_fast9_score_c(const uint8_t *im, int stride, const int *corners_xy, int num_corners, int b,
+                           int *scores) {
+    int offsets[16];
+    svt_av1_fast9_circle_offsets(offsets, stride);
+    for (int n = 0; n < num_corners; n++) {
+        const uint8_t *p = im + corners_xy[2 * n + 1] * stride + corners_xy[2 * n];
+        int            d[16];
+        for (int k = 0; k < 16; k++) d[k] = p[offsets[k]] - p[0];
+        int bright = -255, dark = -255;
+        for (int s = 0; s < 16; s++) {
+            int mn = 255, mx = -255;
+            for (int j = 0; j < 9; j++) {
+                const int v = d[(s + j) & 15];
+                mn          = AOMMIN(mn, v);
+                mx          = AOMMAX(mx, v);
+            }
+            bright = AOMMAX(bright, mn);
+            dark   = AOMMAX(dark, -mx);
+        }
+        scores[n] = AOMMAX(b, AOMMAX(bright, dark) - 1);
+    }
+}
 
 // Fast_9 wrapper
 #define FAST_BARRIER 18
 int svt_av1_fast_corner_detect(unsigned char *buf, int width, int height, int stride, int *points, int max_points) {
-    int       num_points;
-    xy *const frm_corners_xy = svt_aom_fast9_detect_nonmax(buf, width, height, stride, FAST_BARRIER, &num_points);
-    num_points               = (num_points <= max_points ? num_points : max_points);
+    int  num_corners    = 0, num_points = 0;
+    xy  *corners        = svt_aom_fast9_detect(buf, width, height, stride, FAST_BARRIER, &num_corners);
+    int *scores         = (int *)malloc(sizeof(*scores) * AOMMAX(num_corners, 1));
+    xy  *frm_corners_xy = NULL;
+    if (corners && scores) {
+        svt_av1_fast9_score(buf, stride, (const int *)corners, num_corners, FAST_BARRIER, scores);
+        frm_corners_xy = svt_aom_nonmax_suppression(corners, scores, num_corners, &num_points);
+    }
+    free(corners);
+    free(scores);
+    num_points = (num_points <= max_points ? num_points : max_points);
     if (num_points > 0 && frm_corners_xy) {
         svt_memcpy(points, frm_corners_xy, sizeof(*frm_corners_xy) * num_points);
         free(frm_corners_xy);
@@ -16,6 +16,28 @@
 #include <stdlib.h>
 #include <memory.h>
 #include "common_dsp_rtcd.h"
+
+/* Offsets of the 16 pixels on the radius-3 Bresenham circle used by FAST-9,
+ * in the same order as the fastfeat detector. */
+static INLINE void svt_av1_fast9_circle_offsets(int offsets[16], int stride) {
+    offsets[0]  = 0 + stride * 3;
+    offsets[1]  = 1 + stride * 3;
+    offsets[2]  = 2 + stride * 2;
+    offsets[3]  = 3 + stride * 1;
+    offsets[4]  = 3 + stride * 0;
+    offsets[5]  = 3 + stride * -1;
+    offsets[6]  = 2 + stride * -2;
+    offsets[7]  = 1 + stride * -3;
+    offsets[8]  = 0 + stride * -3;
+    offsets[9]  = -1 + stride * -3;
+    offsets[10] = -2 + stride * -2;
+    offsets[11] = -3 + stride * -1;
+    offsets[12] = -3 + stride * 0;
+    offsets[13] = -3 + stride * 1;
+    offsets[14] = -2 + stride * 2;
+    offsets[15] = -1 + stride * 3;
+}
+
 int svt_av1_fast_corner_detect(unsigned char *buf, int width, int height, int stride, int *points, int max_points);
 
 #endif // AOM_AV1_ENCODER_CORNER_DETECT_H_
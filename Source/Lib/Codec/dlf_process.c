@@ -20,6 +20,7 @@
 #include "sequence_control_set.h"
 #include "pcs.h"
 #include "aom_dsp_rtcd.h"
+#include "svt_trace.h"
 void svt_aom_get_recon_pic(PictureControlSet *pcs, EbPictureBufferDesc **recon_ptr, Bool is_highbd);
 void svt_av1_loop_restoration_save_boundary_lines(const Yv12BufferConfig *frame, Av1Common *cm, int32_t after_cdef);
 void svt_convert_pic_8bit_to_16bit(EbPictureBufferDesc *src_8bit, EbPictureBufferDesc *dst_16bit, uint16_t ss_x,
@@ -78,6 +79,7 @@ void *svt_aom_dlf_kernel(void *input_ptr) {
         scs                           = pcs->scs;
 
         Bool is_16bit = scs->is_16bit_pipeline;
+        SVT_TRACE_BEGIN("dlf", pcs->picture_number, -1);
         if (is_16bit && scs->static_config.encoder_bit_depth == EB_EIGHT_BIT) {
             svt_convert_pic_8bit_to_16bit(pcs->ppcs->enhanced_pic,
                                           pcs->input_frame16bit,
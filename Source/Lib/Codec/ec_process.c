@@ -20,6 +20,7 @@
 #include "cabac_context_model.h"
 #include "svt_log.h"
 #include "common_dsp_rtcd.h"
+#include "svt_trace.h"
 void svt_av1_reset_loop_restoration(PictureControlSet *piCSetPtr, uint16_t tile_idx);
 
 static void rest_context_dctor(EbPtr p) {
@@ -238,6 +239,8 @@ void *svt_aom_entropy_coding_kernel(void *input_ptr) {
         const uint16_t   tile_sb_start_x = cm->tiles_info.tile_col_start_mi[tile_col] >> scs->seq_header.sb_size_log2;
         const uint16_t   tile_sb_start_y = cm->tiles_info.tile_row_start_mi[tile_row] >> scs->seq_header.sb_size_log2;
 
+        SVT_TRACE_BEGIN("entropy_coding", pcs->picture_number, tile_idx);
+
         uint16_t tile_width_in_sb = (cm->tiles_info.tile_col_start_mi[tile_col + 1] -
                                      cm->tiles_info.tile_col_start_mi[tile_col]) >>
             scs->seq_header.sb_size_log2;
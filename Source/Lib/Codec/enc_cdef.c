@@ -18,6 +18,7 @@
 #include "aom_dsp_rtcd.h"
 #include "svt_log.h"
 #include "rd_cost.h"
+#include "cdef_process.h"
 
 void                   svt_aom_get_recon_pic(PictureControlSet *pcs, EbPictureBufferDesc **recon_ptr, Bool is_highbd);
 static INLINE uint64_t dist_8xn_16bit_c(const uint16_t *src, const uint16_t *dst, const int32_t dstride,
@@ -611,28 +612,15 @@ void svt_av1_cdef_frame(SequenceControlSet *scs, PictureControlSet *pcs) {
 
 ///-------search
 /*
- * Search for the best luma+chroma strength to add as an option, knowing we
- * already selected nb_strengths options
- *
- * Params:
- *
- * lev0 : Array of indices of selected luma strengths.
- * lev1 : Array of indices of selected chroma strengths.
- * nb_strengths : Number of selected (Luma_strength, Chroma_strength) pairs.
- * mse : Array of luma and chroma filtering mse values.
- * sb_count : Number of filter blocks in the frame.
- * start_gi : starting strength index for the search of the additional strengths.
- * end_gi : End index for the for the search of the additional strengths.
+ * Accumulate into tot_mse[j * TOTAL_STRENGTHS + k] the frame mse obtained when the
+ * (j, k) strength pair is added to the nb_strengths already selected pairs, for
+ * the sb_count filter blocks of mse. Only the entries with j and k in
+ * [start_gi, end_gi) are meaningful.
 */
-uint64_t svt_search_one_dual_c(int *lev0, int *lev1, int nb_strengths, uint64_t **mse[2], int sb_count, int start_gi,
-                               int end_gi) {
-    uint64_t      tot_mse[TOTAL_STRENGTHS][TOTAL_STRENGTHS];
+void svt_search_one_dual_tot_mse_c(int *lev0, int *lev1, int nb_strengths, uint64_t **mse[2], int sb_count,
+                                   int start_gi, int end_gi, uint64_t *tot_mse) {
     int32_t       i, j;
-    uint64_t      best_tot_mse    = (uint64_t)1 << 63;
-    int32_t       best_id0        = 0;
-    int32_t       best_id1        = 0;
     const int32_t total_strengths = end_gi;
-    memset(tot_mse, 0, sizeof(tot_mse));
     /* Loop over the filter blocks in the frame */
     for (i = 0; i < sb_count; i++) {
         int32_t  gi;
@@ -660,18 +648,50 @@ uint64_t svt_search_one_dual_c(int *lev0, int *lev1, int nb_strengths, uint64_t
                 curr += mse[1][i][k];
                 if (curr < best)
                     best = curr;
-                tot_mse[j][k] += best;
+                tot_mse[j * TOTAL_STRENGTHS + k] += best;
             }
         }
     }
+}
+
+/*
+ * Search for the best luma+chroma strength to add as an option, knowing we
+ * already selected nb_strengths options
+ *
+ * Params:
+ *
+ * lev0 : Array of indices of selected luma strengths.
+ * lev1 : Array of indices of selected chroma strengths.
+ * nb_strengths : Number of selected (Luma_strength, Chroma_strength) pairs.
+ * mse : Array of luma and chroma filtering mse values.
+ * sb_count : Number of filter blocks in the frame.
+ * start_gi : starting strength index for the search of the additional strengths.
+ * end_gi : End index for the for the search of the additional strengths.
+*/
+uint64_t svt_search_one_dual_c(int *lev0, int *lev1, int nb_strengths, uint64_t **mse[2], int sb_count, int start_gi,
+                               int end_gi) {
+    uint64_t tot_mse[TOTAL_STRENGTHS][TOTAL_STRENGTHS];
+    memset(tot_mse, 0, sizeof(tot_mse));
+    svt_search_one_dual_tot_mse_c(lev0, lev1, nb_strengths, mse, sb_count, start_gi, end_gi, tot_mse[0]);
+    return svt_cdef_select_one_dual(lev0, lev1, nb_strengths, tot_mse[0], start_gi, end_gi);
+}
+
+/*
+ * Add to the selected pairs the (j, k) strength pair with the smallest frame mse in
+ * tot_mse, and return that mse.
+*/
+uint64_t svt_cdef_select_one_dual(int *lev0, int *lev1, int nb_strengths, const uint64_t *tot_mse, int start_gi,
+                                  int end_gi) {
+    uint64_t best_tot_mse = (uint64_t)1 << 63;
+    int32_t  best_id0     = 0;
+    int32_t  best_id1     = 0;
     /* Loop over the additionally searched (Luma_strength, Chroma_strength) pairs
        from the step above, and identify any such pair that provided the best mse for
        the whole frame. The identified pair would be added to the set of already selected pairs. */
-    for (j = start_gi; j < total_strengths; j++) { // Loop over the additionally searched luma strengths
-        int32_t k;
-        for (k = start_gi; k < total_strengths; k++) { // Loop over the additionally searched chroma strengths
-            if (tot_mse[j][k] < best_tot_mse) {
-                best_tot_mse = tot_mse[j][k];
+    for (int32_t j = start_gi; j < end_gi; j++) { // Loop over the additionally searched luma strengths
+        for (int32_t k = start_gi; k < end_gi; k++) { // Loop over the additionally searched chroma strengths
+            if (tot_mse[j * TOTAL_STRENGTHS + k] < best_tot_mse) {
+                best_tot_mse = tot_mse[j * TOTAL_STRENGTHS + k];
                 best_id0     = j; // index for the best luma strength
                 best_id1     = k; // index for the best chroma strength
             }
@@ -694,8 +714,9 @@ uint64_t svt_search_one_dual_c(int *lev0, int *lev1, int nb_strengths, uint64_t
  * start_gi : starting strength index for the search of the additional strengths.
  * end_gi : End index for the for the search of the additional strengths.
 */
-static uint64_t joint_strength_search_dual(int32_t *best_lev0, int32_t *best_lev1, int32_t nb_strengths,
-                                           uint64_t **mse[2], int32_t sb_count, int32_t start_gi, int32_t end_gi) {
+static uint64_t joint_strength_search_dual(struct CdefSearchDispatch *dispatch, int32_t *best_lev0, int32_t *best_lev1,
+                                           int32_t nb_strengths, uint64_t **mse[2], int32_t sb_count, int32_t start_gi,
+                                           int32_t end_gi) {
     uint64_t best_tot_mse;
     int32_t  i;
     best_tot_mse = (uint64_t)1 << 63;
@@ -711,7 +732,8 @@ static uint64_t joint_strength_search_dual(int32_t *best_lev0, int32_t *best_lev
     selected list of best (Luma_strength, Chroma_strength) pairs.
     */
     for (i = 0; i < nb_strengths; i++)
-        best_tot_mse = svt_search_one_dual(best_lev0, best_lev1, i, mse, sb_count, start_gi, end_gi);
+        best_tot_mse = svt_aom_cdef_search_one_dual_mt(
+            dispatch, best_lev0, best_lev1, i, mse, sb_count, start_gi, end_gi);
     /* Performing further refinements on the search based on the results
     from the step above. Trying to refine the greedy search by reconsidering each
     already-selected option. */
@@ -721,11 +743,12 @@ static uint64_t joint_strength_search_dual(int32_t *best_lev0, int32_t *best_lev
             best_lev0[j] = best_lev0[j + 1];
             best_lev1[j] = best_lev1[j + 1];
         }
-        best_tot_mse = svt_search_one_dual(best_lev0, best_lev1, nb_strengths - 1, mse, sb_count, start_gi, end_gi);
+        best_tot_mse = svt_aom_cdef_search_one_dual_mt(
+            dispatch, best_lev0, best_lev1, nb_strengths - 1, mse, sb_count, start_gi, end_gi);
     }
     return best_tot_mse;
 }
-void finish_cdef_search(PictureControlSet *pcs) {
+void finish_cdef_search(PictureControlSet *pcs, struct CdefSearchDispatch *dispatch) {
     struct PictureParentControlSet *ppcs    = pcs->ppcs;
     FrameHeader                    *frm_hdr = &ppcs->frm_hdr;
     Av1Common                      *cm      = ppcs->av1_cm;
@@ -855,7 +878,7 @@ void finish_cdef_search(PictureControlSet *pcs) {
         int32_t best_lev1[CDEF_MAX_STRENGTHS] = {0};
         nb_strengths                          = 1 << i;
         uint64_t tot_mse                      = joint_strength_search_dual(
-            best_lev0, best_lev1, nb_strengths, mse, sb_count, start_gi, end_gi);
+            dispatch, best_lev0, best_lev1, nb_strengths, mse, sb_count, start_gi, end_gi);
         /* Count superblock signalling cost. */
         const int      total_bits = sb_count * i + nb_strengths * CDEF_STRENGTH_BITS * 2;
         const int      rate_cost  = av1_cost_literal(total_bits);
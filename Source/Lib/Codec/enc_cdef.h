@@ -22,6 +22,9 @@ typedef void (*CdefFilterBlockFunc)(uint8_t *dst8, uint16_t *dst16, int32_t dstr
                                     int32_t sec_damping, int32_t bsize, int32_t coeff_shift,
                                     uint8_t subsampling_factor);
 
+uint64_t svt_cdef_select_one_dual(int *lev0, int *lev1, int nb_strengths, const uint64_t *tot_mse, int start_gi,
+                                  int end_gi);
+
 void copy_cdef_16bit_to_16bit(uint16_t *dst, int32_t dstride, uint16_t *src, CdefList *dlist, int32_t cdef_count,
                               int32_t bsize);
 
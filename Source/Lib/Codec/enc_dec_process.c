@@ -26,6 +26,8 @@
 #include "pic_analysis_process.h"
 #include "resize.h"
 #include "enc_mode_config.h"
+#include "svt_trace.h"
+#include "svt_time.h"
 
 void svt_aom_get_recon_pic(PictureControlSet *pcs, EbPictureBufferDesc **recon_ptr, Bool is_highbd);
 void copy_mv_rate(PictureControlSet *pcs, MdRateEstimationContext *dst_rate);
@@ -263,8 +265,9 @@ static Bool assign_enc_dec_segments(EncDecSegments *segmentPtr, uint16_t *segmen
     uint32_t bottom_left_segment_index;
 
     int16_t feedback_row_index = -1;
-
-    uint32_t self_assigned = FALSE;
+    int16_t self_row_index     = -1;
+    Bool    right_ready        = FALSE;
+    Bool    bottom_left_ready  = FALSE;
 
     //static FILE *trace = 0;
     //
@@ -325,17 +328,7 @@ static Bool assign_enc_dec_segments(EncDecSegments *segmentPtr, uint16_t *segmen
             svt_block_on_mutex(segmentPtr->row_array[row_segment_index].assignment_mutex);
 
             --segmentPtr->dep_map.dependency_map[right_segment_index];
-
-            if (segmentPtr->dep_map.dependency_map[right_segment_index] == 0) {
-                *segmentInOutIndex = segmentPtr->row_array[row_segment_index].current_seg_index;
-                ++segmentPtr->row_array[row_segment_index].current_seg_index;
-                self_assigned            = TRUE;
-                continue_processing_flag = TRUE;
-
-                // fprintf(trace, "Start  Pic: %u Seg: %u\n",
-                //     (unsigned) ((PictureControlSet*)
-                //     taskPtr->pcs_wrapper->object_ptr)->picture_number, *segmentInOutIndex);
-            }
+            right_ready = segmentPtr->dep_map.dependency_map[right_segment_index] == 0;
 
             svt_release_mutex(segmentPtr->row_array[row_segment_index].assignment_mutex);
         }
@@ -346,24 +339,34 @@ static Bool assign_enc_dec_segments(EncDecSegments *segmentPtr, uint16_t *segmen
             svt_block_on_mutex(segmentPtr->row_array[row_segment_index + 1].assignment_mutex);
 
             --segmentPtr->dep_map.dependency_map[bottom_left_segment_index];
+            bottom_left_ready = segmentPtr->dep_map.dependency_map[bottom_left_segment_index] == 0;
 
-            if (segmentPtr->dep_map.dependency_map[bottom_left_segment_index] == 0) {
-                if (self_assigned == TRUE)
-                    feedback_row_index = (int16_t)row_segment_index + 1;
-                else {
-                    *segmentInOutIndex = segmentPtr->row_array[row_segment_index + 1].current_seg_index;
-                    ++segmentPtr->row_array[row_segment_index + 1].current_seg_index;
-                    continue_processing_flag = TRUE;
-
-                    // fprintf(trace, "Start  Pic: %u Seg: %u\n",
-                    //     (unsigned) ((PictureControlSet*)
-                    //     taskPtr->pcs_wrapper->object_ptr)->picture_number, *segmentInOutIndex);
-                }
-            }
             svt_release_mutex(segmentPtr->row_array[row_segment_index + 1].assignment_mutex);
         }
 
-        if (feedback_row_index > 0) {
+        // A ready segment is owned by the thread that cleared its last dependency, so it can be claimed
+        // outside of the row mutex. When both neighbours are ready, keep the one heading the most expensive
+        // dependency chain and hand the other row to the next available thread.
+        if (right_ready && bottom_left_ready) {
+            if (segmentPtr->path_cost[bottom_left_segment_index] > segmentPtr->path_cost[right_segment_index]) {
+                self_row_index     = (int16_t)row_segment_index + 1;
+                feedback_row_index = (int16_t)row_segment_index;
+            } else {
+                self_row_index     = (int16_t)row_segment_index;
+                feedback_row_index = (int16_t)row_segment_index + 1;
+            }
+        } else if (right_ready)
+            self_row_index = (int16_t)row_segment_index;
+        else if (bottom_left_ready)
+            self_row_index = (int16_t)row_segment_index + 1;
+
+        if (self_row_index >= 0) {
+            *segmentInOutIndex = segmentPtr->row_array[self_row_index].current_seg_index;
+            ++segmentPtr->row_array[self_row_index].current_seg_index;
+            continue_processing_flag = TRUE;
+        }
+
+        if (feedback_row_index >= 0) {
             EbObjectWrapper *wrapper_ptr;
             svt_get_empty_object(srmFifoPtr, &wrapper_ptr);
             EncDecTasks *feedback_task         = (EncDecTasks *)wrapper_ptr->object_ptr;
@@ -381,6 +384,31 @@ static Bool assign_enc_dec_segments(EncDecSegments *segmentPtr, uint16_t *segmen
 
     return continue_processing_flag;
 }
+#if DEBUG_ENCDEC_PARALLEL
+/* The average number of threads that coded the picture, against the highest parallelism the segment
+ * dependencies allow with the predicted costs. */
+static void print_enc_dec_parallel_stats(PictureControlSet *pcs) {
+    const uint16_t tg_count      = pcs->ppcs->tile_group_cols * pcs->ppcs->tile_group_rows;
+    uint64_t       total_cost    = 0;
+    uint64_t       critical_cost = 0;
+    for (uint16_t tile_group_idx = 0; tile_group_idx < tg_count; tile_group_idx++) {
+        EncDecSegments *segments_ptr = pcs->enc_dec_segment_ctrl[tile_group_idx];
+        total_cost += segments_ptr->total_cost;
+        critical_cost = MAX(critical_cost, segments_ptr->path_cost[segments_ptr->row_array[0].starting_seg_index]);
+    }
+    const double threads      = pcs->enc_dec_wall_time > 0 ? pcs->enc_dec_busy_time / pcs->enc_dec_wall_time : 1;
+    const double max_parallel = critical_cost ? (double)total_cost / critical_cost : 1;
+    const double max_threads  = MIN(max_parallel, (double)pcs->scs->enc_dec_process_init_count);
+    SVT_LOG("POC %llu EncDec busy %.2fms wall %.2fms threads %.2f max parallelism %.2f efficiency %.1f%%\n",
+            (unsigned long long)pcs->picture_number,
+            pcs->enc_dec_busy_time,
+            pcs->enc_dec_wall_time,
+            threads,
+            max_parallel,
+            100.0 * threads / MAX(max_threads, 1.0));
+}
+#endif
+
 static void svt_av1_add_film_grain(EbPictureBufferDesc *src, EbPictureBufferDesc *dst, AomFilmGrain *film_grain_ptr) {
     uint8_t *luma, *cb, *cr;
     int32_t  height, width, luma_stride, chroma_stride;
@@ -664,149 +692,6 @@ void svt_aom_recon_output(PictureControlSet *pcs, SequenceControlSet *scs) {
     svt_release_mutex(enc_ctx->total_number_of_recon_frame_mutex);
 }
 
-//************************************/
-// Calculate Frame SSIM
-/************************************/
-
-static void svt_aom_ssim_parms_8x8_c(const uint8_t *s, int sp, const uint8_t *r, int rp, uint32_t *sum_s,
-                                     uint32_t *sum_r, uint32_t *sum_sq_s, uint32_t *sum_sq_r, uint32_t *sum_sxr) {
-    int i, j;
-    for (i = 0; i < 8; i++, s += sp, r += rp) {
-        for (j = 0; j < 8; j++) {
-            *sum_s += s[j];
-            *sum_r += r[j];
-            *sum_sq_s += s[j] * s[j];
-            *sum_sq_r += r[j] * r[j];
-            *sum_sxr += s[j] * r[j];
-        }
-    }
-}
-
-static void svt_aom_highbd_ssim_parms_8x8_c(const uint8_t *s, int sp, const uint8_t *sinc, int spinc, const uint16_t *r,
-                                            int rp, uint32_t *sum_s, uint32_t *sum_r, uint32_t *sum_sq_s,
-                                            uint32_t *sum_sq_r, uint32_t *sum_sxr) {
-    int      i, j;
-    uint32_t ss;
-    for (i = 0; i < 8; i++, s += sp, sinc += spinc, r += rp) {
-        for (j = 0; j < 8; j++) {
-            ss = (int64_t)(s[j] << 2) + ((sinc[j] >> 6) & 0x3);
-            *sum_s += ss;
-            *sum_r += r[j];
-            *sum_sq_s += ss * ss;
-            *sum_sq_r += r[j] * r[j];
-            *sum_sxr += ss * r[j];
-        }
-    }
-}
-
-static const int64_t cc1    = 26634; // (64^2*(.01*255)^2
-static const int64_t cc2    = 239708; // (64^2*(.03*255)^2
-static const int64_t cc1_10 = 428658; // (64^2*(.01*1023)^2
-static const int64_t cc2_10 = 3857925; // (64^2*(.03*1023)^2
-static const int64_t cc1_12 = 6868593; // (64^2*(.01*4095)^2
-static const int64_t cc2_12 = 61817334; // (64^2*(.03*4095)^2
-
-double similarity(uint32_t sum_s, uint32_t sum_r, uint32_t sum_sq_s, uint32_t sum_sq_r, uint32_t sum_sxr, int count,
-                  uint32_t bd) {
-    double  ssim_n, ssim_d;
-    int64_t c1, c2;
-
-    if (bd == 8) {
-        // scale the constants by number of pixels
-        c1 = (cc1 * count * count) >> 12;
-        c2 = (cc2 * count * count) >> 12;
-    } else if (bd == 10) {
-        c1 = (cc1_10 * count * count) >> 12;
-        c2 = (cc2_10 * count * count) >> 12;
-    } else if (bd == 12) {
-        c1 = (cc1_12 * count * count) >> 12;
-        c2 = (cc2_12 * count * count) >> 12;
-    } else {
-        c1 = c2 = 0;
-        assert(0);
-    }
-
-    ssim_n = (2.0 * sum_s * sum_r + c1) * (2.0 * count * sum_sxr - 2.0 * sum_s * sum_r + c2);
-
-    ssim_d = ((double)sum_s * sum_s + (double)sum_r * sum_r + c1) *
-        ((double)count * sum_sq_s - (double)sum_s * sum_s + (double)count * sum_sq_r - (double)sum_r * sum_r + c2);
-
-    return ssim_n / ssim_d;
-}
-
-static double ssim_8x8(const uint8_t *s, int sp, const uint8_t *r, int rp) {
-    uint32_t sum_s = 0, sum_r = 0, sum_sq_s = 0, sum_sq_r = 0, sum_sxr = 0;
-    svt_aom_ssim_parms_8x8_c(s, sp, r, rp, &sum_s, &sum_r, &sum_sq_s, &sum_sq_r, &sum_sxr);
-    return similarity(sum_s, sum_r, sum_sq_s, sum_sq_r, sum_sxr, 64, 8);
-}
-
-static double highbd_ssim_8x8(const uint8_t *s, int sp, const uint8_t *sinc, int spinc, const uint16_t *r, int rp,
-                              uint32_t bd, uint32_t shift) {
-    uint32_t sum_s = 0, sum_r = 0, sum_sq_s = 0, sum_sq_r = 0, sum_sxr = 0;
-    svt_aom_highbd_ssim_parms_8x8_c(s, sp, sinc, spinc, r, rp, &sum_s, &sum_r, &sum_sq_s, &sum_sq_r, &sum_sxr);
-    return similarity(sum_s >> shift,
-                      sum_r >> shift,
-                      sum_sq_s >> (2 * shift),
-                      sum_sq_r >> (2 * shift),
-                      sum_sxr >> (2 * shift),
-                      64,
-                      bd);
-}
-
-// We are using a 8x8 moving window with starting location of each 8x8 window
-// on the 4x4 pixel grid. Such arrangement allows the windows to overlap
-// block boundaries to penalize blocking artifacts.
-static double aom_ssim2(const uint8_t *img1, int stride_img1, const uint8_t *img2, int stride_img2, int width,
-                        int height) {
-    int    i, j;
-    int    samples    = 0;
-    double ssim_total = 0;
-
-    if (width <= 8 || height <= 8) {
-        // Region is too small to compute a meaningful SSIM score, return early
-        return NAN;
-    }
-
-    // sample point start with each 4x4 location
-    for (i = 0; i <= height - 8; i += 4, img1 += stride_img1 * 4, img2 += stride_img2 * 4) {
-        for (j = 0; j <= width - 8; j += 4) {
-            double v = ssim_8x8(img1 + j, stride_img1, img2 + j, stride_img2);
-            ssim_total += v;
-            samples++;
-        }
-    }
-    assert(samples > 0);
-    ssim_total /= samples;
-    return ssim_total;
-}
-
-static double aom_highbd_ssim2(const uint8_t *img1, int stride_img1, const uint8_t *img1inc, int stride_img1inc,
-                               const uint16_t *img2, int stride_img2, int width, int height, uint32_t bd,
-                               uint32_t shift) {
-    int    i, j;
-    int    samples    = 0;
-    double ssim_total = 0;
-
-    if (width <= 8 || height <= 8) {
-        // Region is too small to compute a meaningful SSIM score, return early
-        return NAN;
-    }
-
-    // sample point start with each 4x4 location
-    for (i = 0; i <= height - 8;
-         i += 4, img1 += stride_img1 * 4, img1inc += stride_img1inc * 4, img2 += stride_img2 * 4) {
-        for (j = 0; j <= width - 8; j += 4) {
-            double v = highbd_ssim_8x8(
-                (img1 + j), stride_img1, (img1inc + j), stride_img1inc, (img2 + j), stride_img2, bd, shift);
-            ssim_total += v;
-            samples++;
-        }
-    }
-    assert(samples > 0);
-    ssim_total /= samples;
-    return ssim_total;
-}
-
 void free_temporal_filtering_buffer(PictureControlSet *pcs, SequenceControlSet *scs) {
     // save_source_picture_ptr will be allocated only if do_tf is true in svt_av1_init_temporal_filtering().
     if (!pcs->ppcs->do_tf) {
@@ -825,345 +710,6 @@ void free_temporal_filtering_buffer(PictureControlSet *pcs, SequenceControlSet *
     }
 }
 
-EbErrorType svt_aom_ssim_calculations(PictureControlSet *pcs, SequenceControlSet *scs, Bool free_memory) {
-    Bool is_16bit = (scs->static_config.encoder_bit_depth > EB_EIGHT_BIT);
-
-    const uint32_t ss_x = scs->subsampling_x;
-    const uint32_t ss_y = scs->subsampling_y;
-
-    EbPictureBufferDesc *recon_ptr;
-    EbPictureBufferDesc *input_pic = (EbPictureBufferDesc *)pcs->ppcs->enhanced_unscaled_pic;
-    svt_aom_get_recon_pic(pcs, &recon_ptr, is_16bit);
-    // upscale recon if resized
-    EbPictureBufferDesc *upscaled_recon = NULL;
-    Bool                 is_resized = recon_ptr->width != input_pic->width || recon_ptr->height != input_pic->height;
-    if (is_resized) {
-        superres_params_type spr_params = {input_pic->width, input_pic->height, 0};
-        svt_aom_downscaled_source_buffer_desc_ctor(&upscaled_recon, recon_ptr, spr_params);
-        svt_aom_resize_frame(recon_ptr,
-                             upscaled_recon,
-                             scs->static_config.encoder_bit_depth,
-                             av1_num_planes(&scs->seq_header.color_config),
-                             ss_x,
-                             ss_y,
-                             recon_ptr->packed_flag,
-                             PICTURE_BUFFER_DESC_FULL_MASK,
-                             0); // is_2bcompress
-        recon_ptr = upscaled_recon;
-    }
-
-    if (!is_16bit) {
-        EbByte input_buffer;
-        EbByte recon_coeff_buffer;
-
-        EbByte buffer_y;
-        EbByte buffer_cb;
-        EbByte buffer_cr;
-
-        double luma_ssim = 0.0;
-        double cb_ssim   = 0.0;
-        double cr_ssim   = 0.0;
-
-        // if current source picture was temporally filtered, use an alternative buffer which stores
-        // the original source picture
-        if (pcs->ppcs->do_tf == TRUE) {
-            assert(pcs->ppcs->save_source_picture_width == input_pic->width &&
-                   pcs->ppcs->save_source_picture_height == input_pic->height);
-            buffer_y  = pcs->ppcs->save_source_picture_ptr[0];
-            buffer_cb = pcs->ppcs->save_source_picture_ptr[1];
-            buffer_cr = pcs->ppcs->save_source_picture_ptr[2];
-        } else {
-            buffer_y  = input_pic->buffer_y;
-            buffer_cb = input_pic->buffer_cb;
-            buffer_cr = input_pic->buffer_cr;
-        }
-
-        recon_coeff_buffer = &((recon_ptr->buffer_y)[recon_ptr->org_x + recon_ptr->org_y * recon_ptr->stride_y]);
-        input_buffer       = &(buffer_y[input_pic->org_x + input_pic->org_y * input_pic->stride_y]);
-        luma_ssim          = aom_ssim2(input_buffer,
-                              input_pic->stride_y,
-                              recon_coeff_buffer,
-                              recon_ptr->stride_y,
-                              scs->max_input_luma_width,
-                              scs->max_input_luma_height);
-
-        recon_coeff_buffer = &(
-            (recon_ptr->buffer_cb)[recon_ptr->org_x / 2 + recon_ptr->org_y / 2 * recon_ptr->stride_cb]);
-        input_buffer = &(buffer_cb[input_pic->org_x / 2 + input_pic->org_y / 2 * input_pic->stride_cb]);
-        cb_ssim      = aom_ssim2(input_buffer,
-                            input_pic->stride_cb,
-                            recon_coeff_buffer,
-                            recon_ptr->stride_cb,
-                            scs->chroma_width,
-                            scs->chroma_height);
-
-        recon_coeff_buffer = &(
-            (recon_ptr->buffer_cr)[recon_ptr->org_x / 2 + recon_ptr->org_y / 2 * recon_ptr->stride_cr]);
-        input_buffer = &(buffer_cr[input_pic->org_x / 2 + input_pic->org_y / 2 * input_pic->stride_cr]);
-        cr_ssim      = aom_ssim2(input_buffer,
-                            input_pic->stride_cr,
-                            recon_coeff_buffer,
-                            recon_ptr->stride_cr,
-                            scs->chroma_width,
-                            scs->chroma_height);
-
-        pcs->ppcs->luma_ssim = luma_ssim;
-        pcs->ppcs->cb_ssim   = cb_ssim;
-        pcs->ppcs->cr_ssim   = cr_ssim;
-
-        if (free_memory && pcs->ppcs->do_tf == TRUE) {
-            EB_FREE_ARRAY(buffer_y);
-            EB_FREE_ARRAY(buffer_cb);
-            EB_FREE_ARRAY(buffer_cr);
-        }
-    } else {
-        EbByte    input_buffer;
-        uint16_t *recon_coeff_buffer;
-
-        double luma_ssim = 0.0;
-        double cb_ssim   = 0.0;
-        double cr_ssim   = 0.0;
-
-        if (scs->ten_bit_format == 1) {
-            /* SSIM calculation for compressed 10-bit format has not been verified and debugged,
-               since this format is not supported elsewhere in this version. See verify_settings(),
-               which exits with an error if compressed 10-bit format is enabled. To avoid
-               extra complexity of unpacking into a temporary buffer, or having to write
-               new core SSIM functions, we ignore the two least signifcant bits in this
-               case, and set these to zero. One test shows a difference in SSIM
-               of 0.00085 setting the two least significant bits to zero. */
-
-            const uint32_t luma_width       = input_pic->width - scs->max_input_pad_right;
-            const uint32_t luma_height      = input_pic->height - scs->max_input_pad_bottom;
-            const uint32_t chroma_width     = luma_width >> ss_x;
-            const uint32_t pic_width_in_sb  = (luma_width + 64 - 1) / 64;
-            const uint32_t pic_height_in_sb = (luma_height + 64 - 1) / 64;
-            const uint32_t chroma_height    = luma_height >> ss_y;
-            uint32_t       sb_num_in_height, sb_num_in_width, bd, shift;
-            uint8_t        zero_buffer[64 * 64];
-
-            bd    = 10;
-            shift = 0; // both input and output are 10 bit (bitdepth - input_bd)
-            memset(&zero_buffer[0], 0, sizeof(uint8_t) * 64 * 64);
-
-            EbByte input_buffer_org = &(
-                (input_pic->buffer_y)[input_pic->org_x + input_pic->org_y * input_pic->stride_y]);
-            uint16_t *recon_buffer_org = (uint16_t *)(&(
-                (recon_ptr->buffer_y)[(recon_ptr->org_x << is_16bit) +
-                                      (recon_ptr->org_y << is_16bit) * recon_ptr->stride_y]));
-            ;
-
-            EbByte input_buffer_org_u = &(
-                (input_pic->buffer_cb)[input_pic->org_x / 2 + input_pic->org_y / 2 * input_pic->stride_cb]);
-            ;
-            uint16_t *recon_buffer_org_u = recon_coeff_buffer = (uint16_t *)(&(
-                (recon_ptr->buffer_cb)[(recon_ptr->org_x << is_16bit) / 2 +
-                                       (recon_ptr->org_y << is_16bit) / 2 * recon_ptr->stride_cb]));
-            ;
-
-            EbByte input_buffer_org_v = &(
-                (input_pic->buffer_cr)[input_pic->org_x / 2 + input_pic->org_y / 2 * input_pic->stride_cr]);
-            ;
-            uint16_t *recon_buffer_org_v = recon_coeff_buffer = (uint16_t *)(&(
-                (recon_ptr->buffer_cr)[(recon_ptr->org_x << is_16bit) / 2 +
-                                       (recon_ptr->org_y << is_16bit) / 2 * recon_ptr->stride_cr]));
-            ;
-
-            for (sb_num_in_height = 0; sb_num_in_height < pic_height_in_sb; ++sb_num_in_height) {
-                for (sb_num_in_width = 0; sb_num_in_width < pic_width_in_sb; ++sb_num_in_width) {
-                    uint32_t tb_origin_x = sb_num_in_width * 64;
-                    uint32_t tb_origin_y = sb_num_in_height * 64;
-                    uint32_t sb_width    = MIN(luma_width - tb_origin_x, 64);
-                    uint32_t sb_height   = MIN(luma_height - tb_origin_y, 64);
-
-                    input_buffer       = input_buffer_org + tb_origin_y * input_pic->stride_y + tb_origin_x;
-                    recon_coeff_buffer = recon_buffer_org + tb_origin_y * recon_ptr->stride_y + tb_origin_x;
-
-                    luma_ssim += aom_highbd_ssim2(input_buffer,
-                                                  input_pic->stride_y,
-                                                  &zero_buffer[0],
-                                                  64,
-                                                  recon_coeff_buffer,
-                                                  recon_ptr->stride_y,
-                                                  sb_width,
-                                                  sb_height,
-                                                  bd,
-                                                  shift);
-
-                    //U+V
-                    tb_origin_x = sb_num_in_width * 32;
-                    tb_origin_y = sb_num_in_height * 32;
-                    sb_width    = (chroma_width - tb_origin_x) < 32 ? (chroma_width - tb_origin_x) : 32;
-                    sb_height   = (chroma_height - tb_origin_y) < 32 ? (chroma_height - tb_origin_y) : 32;
-
-                    input_buffer       = input_buffer_org_u + tb_origin_y * input_pic->stride_cb + tb_origin_x;
-                    recon_coeff_buffer = recon_buffer_org_u + tb_origin_y * recon_ptr->stride_cb + tb_origin_x;
-
-                    cb_ssim += aom_highbd_ssim2(input_buffer,
-                                                input_pic->stride_cb,
-                                                &zero_buffer[0],
-                                                64,
-                                                recon_coeff_buffer,
-                                                recon_ptr->stride_cb,
-                                                sb_width,
-                                                sb_height,
-                                                bd,
-                                                shift);
-
-                    input_buffer       = input_buffer_org_v + tb_origin_y * input_pic->stride_cr + tb_origin_x;
-                    recon_coeff_buffer = recon_buffer_org_v + tb_origin_y * recon_ptr->stride_cr + tb_origin_x;
-
-                    cr_ssim += aom_highbd_ssim2(input_buffer,
-                                                input_pic->stride_cr,
-                                                &zero_buffer[0],
-                                                64,
-                                                recon_coeff_buffer,
-                                                recon_ptr->stride_cr,
-                                                sb_width,
-                                                sb_height,
-                                                bd,
-                                                shift);
-                }
-            }
-
-            luma_ssim /= pic_height_in_sb * pic_width_in_sb;
-            cb_ssim /= pic_height_in_sb * pic_width_in_sb;
-            cr_ssim /= pic_height_in_sb * pic_width_in_sb;
-
-            pcs->ppcs->luma_ssim = luma_ssim;
-            pcs->ppcs->cb_ssim   = cb_ssim;
-            pcs->ppcs->cr_ssim   = cr_ssim;
-        } else {
-            recon_coeff_buffer = (uint16_t *)(&(
-                (recon_ptr->buffer_y)[(recon_ptr->org_x << is_16bit) +
-                                      (recon_ptr->org_y << is_16bit) * recon_ptr->stride_y]));
-
-            // if current source picture was temporally filtered, use an alternative buffer which stores
-            // the original source picture
-            EbByte buffer_y, buffer_bit_inc_y;
-            EbByte buffer_cb, buffer_bit_inc_cb;
-            EbByte buffer_cr, buffer_bit_inc_cr;
-            int    bd, shift;
-
-            if (pcs->ppcs->do_tf == TRUE) {
-                assert(pcs->ppcs->save_source_picture_width == input_pic->width &&
-                       pcs->ppcs->save_source_picture_height == input_pic->height);
-                buffer_y          = pcs->ppcs->save_source_picture_ptr[0];
-                buffer_bit_inc_y  = pcs->ppcs->save_source_picture_bit_inc_ptr[0];
-                buffer_cb         = pcs->ppcs->save_source_picture_ptr[1];
-                buffer_bit_inc_cb = pcs->ppcs->save_source_picture_bit_inc_ptr[1];
-                buffer_cr         = pcs->ppcs->save_source_picture_ptr[2];
-                buffer_bit_inc_cr = pcs->ppcs->save_source_picture_bit_inc_ptr[2];
-            } else {
-                uint32_t height_y  = (uint32_t)(input_pic->height + input_pic->org_y + input_pic->origin_bot_y);
-                uint32_t height_uv = (uint32_t)((input_pic->height + input_pic->org_y + input_pic->origin_bot_y) >>
-                                                ss_y);
-
-                uint8_t *uncompressed_pics[3];
-                EB_MALLOC_ARRAY(uncompressed_pics[0], pcs->ppcs->enhanced_unscaled_pic->luma_size);
-                EB_MALLOC_ARRAY(uncompressed_pics[1], pcs->ppcs->enhanced_unscaled_pic->chroma_size);
-                EB_MALLOC_ARRAY(uncompressed_pics[2], pcs->ppcs->enhanced_unscaled_pic->chroma_size);
-
-                svt_c_unpack_compressed_10bit(input_pic->buffer_bit_inc_y,
-                                              input_pic->stride_bit_inc_y / 4,
-                                              uncompressed_pics[0],
-                                              input_pic->stride_bit_inc_y,
-                                              height_y);
-                // U
-                svt_c_unpack_compressed_10bit(input_pic->buffer_bit_inc_cb,
-                                              input_pic->stride_bit_inc_cb / 4,
-                                              uncompressed_pics[1],
-                                              input_pic->stride_bit_inc_cb,
-                                              height_uv);
-                // V
-                svt_c_unpack_compressed_10bit(input_pic->buffer_bit_inc_cr,
-                                              input_pic->stride_bit_inc_cr / 4,
-                                              uncompressed_pics[2],
-                                              input_pic->stride_bit_inc_cr,
-                                              height_uv);
-
-                buffer_y          = input_pic->buffer_y;
-                buffer_bit_inc_y  = uncompressed_pics[0];
-                buffer_cb         = input_pic->buffer_cb;
-                buffer_bit_inc_cb = uncompressed_pics[1];
-                buffer_cr         = input_pic->buffer_cr;
-                buffer_bit_inc_cr = uncompressed_pics[2];
-            }
-
-            bd    = 10;
-            shift = 0; // both input and output are 10 bit (bitdepth - input_bd)
-
-            input_buffer                = &((buffer_y)[input_pic->org_x + input_pic->org_y * input_pic->stride_y]);
-            EbByte input_buffer_bit_inc = &(
-                (buffer_bit_inc_y)[input_pic->org_x + input_pic->org_y * input_pic->stride_bit_inc_y]);
-            luma_ssim = aom_highbd_ssim2(input_buffer,
-                                         input_pic->stride_y,
-                                         input_buffer_bit_inc,
-                                         input_pic->stride_bit_inc_y,
-                                         recon_coeff_buffer,
-                                         recon_ptr->stride_y,
-                                         scs->max_input_luma_width,
-                                         scs->max_input_luma_height,
-                                         bd,
-                                         shift);
-
-            recon_coeff_buffer   = (uint16_t *)(&(
-                (recon_ptr->buffer_cb)[(recon_ptr->org_x << is_16bit) / 2 +
-                                       (recon_ptr->org_y << is_16bit) / 2 * recon_ptr->stride_cb]));
-            input_buffer         = &((buffer_cb)[input_pic->org_x / 2 + input_pic->org_y / 2 * input_pic->stride_cb]);
-            input_buffer_bit_inc = &(
-                (buffer_bit_inc_cb)[input_pic->org_x / 2 + input_pic->org_y / 2 * input_pic->stride_bit_inc_cb]);
-            cb_ssim = aom_highbd_ssim2(input_buffer,
-                                       input_pic->stride_cb,
-                                       input_buffer_bit_inc,
-                                       input_pic->stride_bit_inc_cb,
-                                       recon_coeff_buffer,
-                                       recon_ptr->stride_cb,
-                                       scs->chroma_width,
-                                       scs->chroma_height,
-                                       bd,
-                                       shift);
-
-            recon_coeff_buffer   = (uint16_t *)(&(
-                (recon_ptr->buffer_cr)[(recon_ptr->org_x << is_16bit) / 2 +
-                                       (recon_ptr->org_y << is_16bit) / 2 * recon_ptr->stride_cr]));
-            input_buffer         = &((buffer_cr)[input_pic->org_x / 2 + input_pic->org_y / 2 * input_pic->stride_cr]);
-            input_buffer_bit_inc = &(
-                (buffer_bit_inc_cr)[input_pic->org_x / 2 + input_pic->org_y / 2 * input_pic->stride_bit_inc_cr]);
-            cr_ssim = aom_highbd_ssim2(input_buffer,
-                                       input_pic->stride_cr,
-                                       input_buffer_bit_inc,
-                                       input_pic->stride_bit_inc_cr,
-                                       recon_coeff_buffer,
-                                       recon_ptr->stride_cr,
-                                       scs->chroma_width,
-                                       scs->chroma_height,
-                                       bd,
-                                       shift);
-
-            pcs->ppcs->luma_ssim = luma_ssim;
-            pcs->ppcs->cb_ssim   = cb_ssim;
-            pcs->ppcs->cr_ssim   = cr_ssim;
-
-            if (free_memory && pcs->ppcs->do_tf == TRUE) {
-                EB_FREE_ARRAY(buffer_y);
-                EB_FREE_ARRAY(buffer_cb);
-                EB_FREE_ARRAY(buffer_cr);
-                EB_FREE_ARRAY(buffer_bit_inc_y);
-                EB_FREE_ARRAY(buffer_bit_inc_cb);
-                EB_FREE_ARRAY(buffer_bit_inc_cr);
-            }
-            if (pcs->ppcs->do_tf == FALSE) {
-                EB_FREE_ARRAY(buffer_bit_inc_y);
-                EB_FREE_ARRAY(buffer_bit_inc_cb);
-                EB_FREE_ARRAY(buffer_bit_inc_cr);
-            }
-        }
-    }
-    EB_DELETE(upscaled_recon);
-    return EB_ErrorNone;
-}
-
 EbErrorType psnr_calculations(PictureControlSet *pcs, SequenceControlSet *scs, Bool free_memory) {
     Bool is_16bit = (scs->static_config.encoder_bit_depth > EB_EIGHT_BIT);
 
@@ -3243,6 +2789,7 @@ void *svt_aom_mode_decision_kernel(void *input_ptr) {
         md_ctx->encoder_bit_depth                     = (uint8_t)scs->static_config.encoder_bit_depth;
         md_ctx->corrupted_mv_check                    = (pcs->ppcs->aligned_width >= (1 << (MV_IN_USE_BITS - 3))) ||
             (pcs->ppcs->aligned_height >= (1 << (MV_IN_USE_BITS - 3)));
+        SVT_TRACE_BEGIN("enc_dec", pcs->picture_number, -1);
         ed_ctx->tile_group_index = enc_dec_tasks->tile_group_index;
         ed_ctx->coded_sb_count   = 0;
         segments_ptr             = pcs->enc_dec_segment_ctrl[ed_ctx->tile_group_index];
@@ -3270,6 +2817,10 @@ void *svt_aom_mode_decision_kernel(void *input_ptr) {
             if (enc_dec_tasks->input_type == ENCDEC_TASKS_SUPERRES_INPUT) {
                 // do as dorecode do
                 pcs->enc_dec_coded_sb_count = 0;
+#if DEBUG_ENCDEC_PARALLEL
+                pcs->enc_dec_busy_time = 0;
+                svt_av1_get_time(&pcs->enc_dec_start_time_seconds, &pcs->enc_dec_start_time_u_seconds);
+#endif
                 // re-init mode decision configuration for qp update for re-encode frame
                 mode_decision_configuration_init_qp_update(pcs);
                 // init segment for re-encode frame
@@ -3295,24 +2846,24 @@ void *svt_aom_mode_decision_kernel(void *input_ptr) {
                 continue;
             }
 
+            // The groups that are not updated per SB are the ones of the picture table, which was built from the
+            // same md_frame_context, so copy them rather than converting the CDFs again on every thread
             if (pcs->cdf_ctrl.enabled) {
                 if (!pcs->cdf_ctrl.update_mv)
                     copy_mv_rate(pcs, ed_ctx->md_ctx->rate_est_table);
                 if (!pcs->cdf_ctrl.update_se)
-
-                    svt_aom_estimate_syntax_rate(ed_ctx->md_ctx->rate_est_table,
-                                                 pcs->slice_type == I_SLICE ? TRUE : FALSE,
-                                                 scs->seq_header.filter_intra_level,
-                                                 pcs->ppcs->frm_hdr.allow_screen_content_tools,
-                                                 pcs->ppcs->enable_restoration,
-                                                 pcs->ppcs->frm_hdr.allow_intrabc,
-                                                 &pcs->md_frame_context);
+                    svt_aom_copy_syntax_rate(ed_ctx->md_ctx->rate_est_table, pcs->md_rate_est_ctx);
                 if (!pcs->cdf_ctrl.update_coef)
-                    svt_aom_estimate_coefficients_rate(ed_ctx->md_ctx->rate_est_table, &pcs->md_frame_context);
+                    svt_aom_copy_coefficients_rate(ed_ctx->md_ctx->rate_est_table, pcs->md_rate_est_ctx);
             }
+#if DEBUG_ENCDEC_PARALLEL
+            uint64_t seg_start_seconds, seg_start_u_seconds, seg_finish_seconds, seg_finish_u_seconds;
+            svt_av1_get_time(&seg_start_seconds, &seg_start_u_seconds);
+#endif
             // Segment-loop
             while (assign_enc_dec_segments(
                        segments_ptr, &segment_index, enc_dec_tasks, ed_ctx->enc_dec_feedback_fifo_ptr) == TRUE) {
+                SVT_TRACE_BEGIN("enc_dec", pcs->picture_number, segment_index);
                 x_sb_start_index = segments_ptr->x_start_array[segment_index];
                 y_sb_start_index = segments_ptr->y_start_array[segment_index];
                 sb_start_index   = y_sb_start_index * tile_group_width_in_sb + x_sb_start_index;
@@ -3565,7 +3116,15 @@ void *svt_aom_mode_decision_kernel(void *input_ptr) {
                 }
             }
 
+#if DEBUG_ENCDEC_PARALLEL
+            svt_av1_get_time(&seg_finish_seconds, &seg_finish_u_seconds);
+#endif
+
             svt_block_on_mutex(pcs->intra_mutex);
+#if DEBUG_ENCDEC_PARALLEL
+            pcs->enc_dec_busy_time += svt_av1_compute_overall_elapsed_time_ms(
+                seg_start_seconds, seg_start_u_seconds, seg_finish_seconds, seg_finish_u_seconds);
+#endif
             pcs->intra_coded_area += (uint32_t)ed_ctx->tot_intra_coded_area;
             pcs->skip_coded_area += (uint32_t)ed_ctx->tot_skip_coded_area;
             pcs->hp_coded_area += (uint32_t)ed_ctx->tot_hp_coded_area;
@@ -3575,6 +3134,13 @@ void *svt_aom_mode_decision_kernel(void *input_ptr) {
             svt_release_mutex(pcs->intra_mutex);
 
             if (last_sb_flag) {
+#if DEBUG_ENCDEC_PARALLEL
+                pcs->enc_dec_wall_time = svt_av1_compute_overall_elapsed_time_ms(pcs->enc_dec_start_time_seconds,
+                                                                                 pcs->enc_dec_start_time_u_seconds,
+                                                                                 seg_finish_seconds,
+                                                                                 seg_finish_u_seconds);
+                print_enc_dec_parallel_stats(pcs);
+#endif
                 Bool do_recode = FALSE;
                 if ((scs->static_config.rate_control_mode == SVT_AV1_RC_MODE_VBR ||
                      scs->static_config.max_bit_rate != 0) &&
@@ -3597,6 +3163,10 @@ void *svt_aom_mode_decision_kernel(void *input_ptr) {
                         }
                     }
                     pcs->enc_dec_coded_sb_count = 0;
+#if DEBUG_ENCDEC_PARALLEL
+                    pcs->enc_dec_busy_time = 0;
+                    svt_av1_get_time(&pcs->enc_dec_start_time_seconds, &pcs->enc_dec_start_time_u_seconds);
+#endif
                     // re-init mode decision configuration for qp update for re-encode frame
                     mode_decision_configuration_init_qp_update(pcs);
                     // init segment for re-encode frame
@@ -32,10 +32,15 @@ typedef struct DlfResults {
     uint32_t         segment_index;
 } DlfResults;
 
+#define REST_INPUT_SEGMENT 0
+#define REST_INPUT_METRICS 1 // posted back by the restoration threads to score stat-report bands
+#define REST_INPUT_FINISH 2 // posted back by the restoration threads to finish one plane, segment_index is the plane
+
 typedef struct CdefResults {
     EbDctor          dctor;
     EbObjectWrapper *pcs_wrapper;
     uint32_t         segment_index;
+    uint32_t         input_type;
 } CdefResults;
 
 typedef struct RestResults {
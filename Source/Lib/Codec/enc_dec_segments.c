@@ -13,6 +13,7 @@
 #include <string.h>
 
 #include "enc_dec_segments.h"
+#include "utility.h"
 
 static void enc_dec_segments_dctor(EbPtr p) {
     EncDecSegments *obj = (EncDecSegments *)p;
@@ -24,6 +25,8 @@ static void enc_dec_segments_dctor(EbPtr p) {
     EB_FREE_ARRAY(obj->x_start_array);
     EB_FREE_ARRAY(obj->y_start_array);
     EB_FREE_ARRAY(obj->valid_sb_count_array);
+    EB_FREE_ARRAY(obj->segment_cost);
+    EB_FREE_ARRAY(obj->path_cost);
     EB_FREE_ARRAY(obj->dep_map.dependency_map);
     EB_FREE_ARRAY(obj->row_array);
 
@@ -50,6 +53,11 @@ EbErrorType svt_aom_enc_dec_segments_ctor(EncDecSegments *segments_ptr, uint32_t
 
     EB_MALLOC_ARRAY(segments_ptr->valid_sb_count_array, segments_ptr->segment_max_total_count);
 
+    // Cost Arrays
+    EB_MALLOC_ARRAY(segments_ptr->segment_cost, segments_ptr->segment_max_total_count);
+
+    EB_MALLOC_ARRAY(segments_ptr->path_cost, segments_ptr->segment_max_total_count);
+
     // Dependency map
     EB_MALLOC_ARRAY(segments_ptr->dep_map.dependency_map, segments_ptr->segment_max_total_count);
 
@@ -85,6 +93,9 @@ void svt_aom_enc_dec_segments_init(EncDecSegments *segments_ptr, uint32_t segCol
     EB_MEMSET(segments_ptr->valid_sb_count_array, 0, sizeof(uint16_t) * segments_ptr->segment_ttl_count);
     EB_MEMSET(segments_ptr->x_start_array, -1, sizeof(uint16_t) * segments_ptr->segment_ttl_count);
     EB_MEMSET(segments_ptr->y_start_array, -1, sizeof(uint16_t) * segments_ptr->segment_ttl_count);
+    EB_MEMSET(segments_ptr->segment_cost, 0, sizeof(uint64_t) * segments_ptr->segment_ttl_count);
+    EB_MEMSET(segments_ptr->path_cost, 0, sizeof(uint64_t) * segments_ptr->segment_ttl_count);
+    segments_ptr->total_cost = 0;
 
     // Initialize the per-SB input availability map & Start Arrays
     for (unsigned y = 0; y < pic_height_sb; ++y) {
@@ -144,3 +155,35 @@ void svt_aom_enc_dec_segments_init(EncDecSegments *segments_ptr, uint32_t segCol
 
     return;
 }
+
+void svt_aom_enc_dec_segments_add_sb_cost(EncDecSegments *segments_ptr, uint32_t x_sb_index, uint32_t y_sb_index,
+                                          uint64_t cost) {
+    unsigned band_index = BAND_INDEX(
+        x_sb_index, y_sb_index, segments_ptr->segment_band_count, segments_ptr->sb_band_count);
+    unsigned row_index = ROW_INDEX(y_sb_index, segments_ptr->segment_row_count, segments_ptr->sb_row_count);
+
+    segments_ptr->segment_cost[SEGMENT_INDEX(row_index, band_index, segments_ptr->segment_band_count)] += cost;
+    segments_ptr->total_cost += cost;
+}
+
+/* A segment gates its right and bottom-left neighbours, so its path cost is its own cost plus the
+ * larger path cost of the two. Segments are walked backwards so both neighbours are already known. */
+void svt_aom_enc_dec_segments_set_path_cost(EncDecSegments *segments_ptr) {
+    for (int row_index = (int)segments_ptr->segment_row_count - 1; row_index >= 0; --row_index) {
+        EncDecSegSegmentRow *row = &segments_ptr->row_array[row_index];
+        for (int segment_index = row->ending_seg_index; segment_index >= row->starting_seg_index; --segment_index) {
+            uint64_t next_cost = 0;
+            // Right Neighbor
+            if (segment_index < row->ending_seg_index)
+                next_cost = segments_ptr->path_cost[segment_index + 1];
+            // Bottom-left Neighbor
+            if (row_index < (int)segments_ptr->segment_row_count - 1) {
+                unsigned bottom_left_segment_index = segment_index + segments_ptr->segment_band_count;
+                if (bottom_left_segment_index >= row[1].starting_seg_index &&
+                    bottom_left_segment_index <= row[1].ending_seg_index)
+                    next_cost = MAX(next_cost, segments_ptr->path_cost[bottom_left_segment_index]);
+            }
+            segments_ptr->path_cost[segment_index] = segments_ptr->segment_cost[segment_index] + next_cost;
+        }
+    }
+}
@@ -64,6 +64,11 @@ typedef struct EncDecSegments {
     uint16_t *y_start_array;
     uint16_t *valid_sb_count_array;
 
+    // Predicted coding cost of each segment and of the longest dependency chain starting at it
+    uint64_t *segment_cost;
+    uint64_t *path_cost;
+    uint64_t  total_cost;
+
     uint32_t segment_band_count;
     uint32_t segment_row_count;
     uint32_t segment_ttl_count;
@@ -83,6 +88,11 @@ extern EbErrorType svt_aom_enc_dec_segments_ctor(EncDecSegments *segments_ptr, u
 
 extern void svt_aom_enc_dec_segments_init(EncDecSegments *segments_ptr, uint32_t col_count, uint32_t row_count,
                                           uint32_t pic_width_sb, uint32_t pic_height_sb);
+
+extern void svt_aom_enc_dec_segments_add_sb_cost(EncDecSegments *segments_ptr, uint32_t x_sb_index,
+                                                 uint32_t y_sb_index, uint64_t cost);
+
+extern void svt_aom_enc_dec_segments_set_path_cost(EncDecSegments *segments_ptr);
 #ifdef __cplusplus
 }
 #endif
@@ -59,6 +59,7 @@ static void encode_context_dctor(EbPtr p) {
 #endif
     EB_DESTROY_MUTEX(obj->sc_buffer_mutex);
     EB_DESTROY_MUTEX(obj->stat_file_mutex);
+    EB_DESTROY_MUTEX(obj->me_cache_mutex);
     EB_DESTROY_MUTEX(obj->frame_updated_mutex);
     EB_DELETE(obj->prediction_structure_group_ptr);
     EB_DELETE_PTR_ARRAY(obj->picture_decision_reorder_queue, PICTURE_DECISION_REORDER_QUEUE_MAX_DEPTH);
@@ -75,6 +76,7 @@ static void encode_context_dctor(EbPtr p) {
     EB_DELETE_PTR_ARRAY(obj->initial_rate_control_reorder_queue, INITIAL_RATE_CONTROL_REORDER_QUEUE_MAX_DEPTH);
     EB_DELETE_PTR_ARRAY(obj->packetization_reorder_queue, PACKETIZATION_REORDER_QUEUE_MAX_DEPTH);
     EB_FREE(obj->stats_out.stat);
+    EB_FREE(obj->stats_out.chunk);
     destroy_stats_buffer(&obj->stats_buf_context, obj->frame_stats_buffer);
     EB_DELETE_PTR_ARRAY(obj->rc.coded_frames_stat_queue, CODED_FRAMES_STAT_QUEUE_MAX_DEPTH);
 
@@ -146,6 +148,7 @@ EbErrorType svt_aom_encode_context_ctor(EncodeContext *enc_ctx, EbPtr object_ini
     enc_ctx->recode_tolerance = 25;
     enc_ctx->rc_cfg.min_cr    = 0;
     EB_CREATE_MUTEX(enc_ctx->stat_file_mutex);
+    EB_CREATE_MUTEX(enc_ctx->me_cache_mutex);
     enc_ctx->num_lap_buffers = 0; // lap not supported for now
     int *num_lap_buffers     = &enc_ctx->num_lap_buffers;
     create_stats_buffer(&enc_ctx->frame_stats_buffer, &enc_ctx->stats_buf_context, *num_lap_buffers);
@@ -50,6 +50,10 @@ typedef struct FirstPassStatsOut {
     FIRSTPASS_STATS *stat;
     size_t           size;
     size_t           capability;
+    uint64_t         base; // frame of stat[0], the ones before it were handed out as chunks
+    uint8_t         *chunk; // last SVT_AV1_STREAM_INFO_FIRST_PASS_STATS_CHUNK
+    size_t           chunk_capability;
+    Bool             header_out;
 } FirstPassStatsOut;
 
 typedef struct RateControlIntervalParamContext {
@@ -171,6 +175,11 @@ typedef struct EncodeContext {
 
     EbHandle stat_file_mutex;
 
+    // superres recode ME cache, shared by the rate control and packetization processes
+    SvtAv1MeCacheStats me_cache_stats;
+    uint64_t           me_cache_bytes; // bytes currently held by the picture caches
+    EbHandle           me_cache_mutex;
+
     Bool                 is_mini_gop_changed;
     uint64_t             poc_map_idx[MAX_TPL_LA_SW];
     EbPictureBufferDesc *mc_flow_rec_picture_buffer[MAX_TPL_LA_SW];
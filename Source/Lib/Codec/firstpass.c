@@ -53,9 +53,10 @@ static EbErrorType realloc_stats_out(SequenceControlSet *scs, FirstPassStatsOut
     if (frame_number < out->size)
         return EB_ErrorNone;
 
-    if ((int64_t)frame_number >= (int64_t)out->capability - 1) {
-        size_t capability = (int64_t)frame_number >= (int64_t)STATS_CAPABILITY_INIT - 1
-            ? STATS_CAPABILITY_GROW(frame_number)
+    const uint64_t index = frame_number - out->base;
+    if ((int64_t)index >= (int64_t)out->capability - 1) {
+        size_t capability = (int64_t)index >= (int64_t)STATS_CAPABILITY_INIT - 1
+            ? STATS_CAPABILITY_GROW(index)
             : STATS_CAPABILITY_INIT;
         if (scs->lap_rc) {
             //store the data points before re-allocation
@@ -76,12 +77,71 @@ static EbErrorType realloc_stats_out(SequenceControlSet *scs, FirstPassStatsOut
         } else {
             EB_REALLOC_ARRAY(out->stat, capability);
         }
+        // the records are written in decode order, a zero count marks one not written yet
+        memset(out->stat + out->capability, 0, (capability - out->capability) * sizeof(*out->stat));
         out->capability = capability;
     }
     out->size = frame_number + 1;
     return EB_ErrorNone;
 }
 
+EbErrorType svt_av1_first_pass_stats_chunk(SequenceControlSet *scs, SvtAv1FixedBuf *chunk) {
+    EncodeContext     *enc_ctx = scs->enc_ctx;
+    FirstPassStatsOut *out     = &enc_ctx->stats_out;
+    // the lookahead rate control keeps pointers into the records
+    if (scs->lap_rc)
+        return EB_ErrorBadParameter;
+    svt_block_on_mutex(enc_ctx->stat_file_mutex);
+    const size_t filled = (size_t)(out->size - out->base);
+    size_t       ready  = 0;
+    while (ready < filled && out->stat[ready].count != 0)
+        ready++;
+    const size_t header_sz = out->header_out ? 0 : sizeof(SvtAv1FirstPassStats);
+    const size_t chunk_sz  = header_sz + ready * sizeof(*out->stat);
+    EbErrorType  ret       = EB_ErrorNone;
+    if (chunk_sz > out->chunk_capability) {
+        EB_FREE(out->chunk);
+        EB_NO_THROW_MALLOC(out->chunk, chunk_sz);
+        out->chunk_capability = out->chunk ? chunk_sz : 0;
+        ret                   = out->chunk ? EB_ErrorNone : EB_ErrorInsufficientResources;
+    }
+    if (ret == EB_ErrorNone) {
+        if (header_sz) {
+            const SvtAv1FirstPassStats header = {SVT_AV1_FIRST_PASS_STATS_MAGIC,
+                                                 SVT_AV1_FIRST_PASS_STATS_VERSION,
+                                                 sizeof(SvtAv1FirstPassStats),
+                                                 sizeof(FIRSTPASS_STATS)};
+            memcpy(out->chunk, &header, sizeof(header));
+            out->header_out = TRUE;
+        }
+        if (ready) {
+            // drop the handed out records, the ones still in flight move to the front
+            memcpy(out->chunk + header_sz, out->stat, ready * sizeof(*out->stat));
+            memmove(out->stat, out->stat + ready, (filled - ready) * sizeof(*out->stat));
+            memset(out->stat + filled - ready, 0, ready * sizeof(*out->stat));
+            out->base += ready;
+        }
+        chunk->buf = out->chunk;
+        chunk->sz  = chunk_sz;
+    }
+    svt_release_mutex(enc_ctx->stat_file_mutex);
+    return ret;
+}
+
+FIRSTPASS_STATS *svt_av1_first_pass_stats_records(const SvtAv1FixedBuf *buf, uint64_t *count) {
+    const SvtAv1FirstPassStats *header = (const SvtAv1FirstPassStats *)buf->buf;
+    uint64_t                    offset = 0;
+    *count                             = 0;
+    if (buf->sz >= sizeof(*header) && header->magic == SVT_AV1_FIRST_PASS_STATS_MAGIC) {
+        if (header->version != SVT_AV1_FIRST_PASS_STATS_VERSION || header->record_size != sizeof(FIRSTPASS_STATS) ||
+            header->header_size < sizeof(*header) || header->header_size % 8 || header->header_size > buf->sz)
+            return NULL;
+        offset = header->header_size;
+    }
+    *count = (buf->sz - offset) / sizeof(FIRSTPASS_STATS);
+    return (FIRSTPASS_STATS *)((uint8_t *)buf->buf + offset);
+}
+
 static AOM_INLINE void output_stats(SequenceControlSet *scs, const FIRSTPASS_STATS *stats,
                                     uint64_t frame_number) {
     FirstPassStatsOut *stats_out = &scs->enc_ctx->stats_out;
@@ -89,7 +149,7 @@ static AOM_INLINE void output_stats(SequenceControlSet *scs, const FIRSTPASS_STA
     if (realloc_stats_out(scs, stats_out, frame_number) != EB_ErrorNone) {
         SVT_ERROR("realloc_stats_out request %d entries failed failed\n", frame_number);
     } else {
-        stats_out->stat[frame_number] = *stats;
+        stats_out->stat[frame_number - stats_out->base] = *stats;
     }
 
     // TEMP debug code
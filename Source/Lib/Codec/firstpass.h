@@ -100,9 +100,14 @@ typedef struct {
 /*!\cond */
 
 struct TileDataEnc;
+struct SequenceControlSet;
 
 void svt_av1_twopass_zero_stats(FIRSTPASS_STATS *section);
 void svt_av1_accumulate_stats(FIRSTPASS_STATS *section, const FIRSTPASS_STATS *frame);
+// Hands out the first pass records completed since the previous call, in the SvtAv1FirstPassStats format
+EbErrorType svt_av1_first_pass_stats_chunk(struct SequenceControlSet *scs, SvtAv1FixedBuf *chunk);
+// Records of a final pass rc_stats_buffer with or without SvtAv1FirstPassStats header, NULL if it is not supported
+FIRSTPASS_STATS *svt_av1_first_pass_stats_records(const SvtAv1FixedBuf *buf, uint64_t *count);
 /*!\endcond */
 
 #ifdef __cplusplus
@@ -2253,7 +2253,9 @@ void svt_aom_full_loop_uv(PictureControlSet *pcs, ModeDecisionContext *ctx, Mode
                     cand_bf->pred->stride_cb,
                     cropped_tx_width_uv,
                     cropped_tx_height_uv);
-                txb_full_distortion[DIST_SSD][1][DIST_CALC_PREDICTION] += get_svt_psy_full_dist(
+                txb_full_distortion[DIST_SSD][1][DIST_CALC_PREDICTION] += get_svt_psy_full_dist_cached(
+                    &ctx->psy_nrg_cache,
+                    AOM_PLANE_U,
                     input_pic->buffer_cb,
                     input_chroma_txb_origin_index,
                     input_pic->stride_cb,
@@ -2274,7 +2276,9 @@ void svt_aom_full_loop_uv(PictureControlSet *pcs, ModeDecisionContext *ctx, Mode
                     cand_bf->recon->stride_cb,
                     cropped_tx_width_uv,
                     cropped_tx_height_uv);
-                txb_full_distortion[DIST_SSD][1][DIST_CALC_RESIDUAL] += get_svt_psy_full_dist(
+                txb_full_distortion[DIST_SSD][1][DIST_CALC_RESIDUAL] += get_svt_psy_full_dist_cached(
+                    &ctx->psy_nrg_cache,
+                    AOM_PLANE_U,
                     input_pic->buffer_cb,
                     input_chroma_txb_origin_index,
                     input_pic->stride_cb,
@@ -2454,7 +2458,9 @@ void svt_aom_full_loop_uv(PictureControlSet *pcs, ModeDecisionContext *ctx, Mode
                     cand_bf->pred->stride_cr,
                     cropped_tx_width_uv,
                     cropped_tx_height_uv);
-                txb_full_distortion[DIST_SSD][2][DIST_CALC_PREDICTION] += get_svt_psy_full_dist(
+                txb_full_distortion[DIST_SSD][2][DIST_CALC_PREDICTION] += get_svt_psy_full_dist_cached(
+                    &ctx->psy_nrg_cache,
+                    AOM_PLANE_V,
                     input_pic->buffer_cr,
                     input_chroma_txb_origin_index,
                     input_pic->stride_cr,
@@ -2475,7 +2481,9 @@ void svt_aom_full_loop_uv(PictureControlSet *pcs, ModeDecisionContext *ctx, Mode
                     cand_bf->recon->stride_cr,
                     cropped_tx_width_uv,
                     cropped_tx_height_uv);
-                txb_full_distortion[DIST_SSD][2][DIST_CALC_RESIDUAL] += get_svt_psy_full_dist(
+                txb_full_distortion[DIST_SSD][2][DIST_CALC_RESIDUAL] += get_svt_psy_full_dist_cached(
+                    &ctx->psy_nrg_cache,
+                    AOM_PLANE_V,
                     input_pic->buffer_cr,
                     input_chroma_txb_origin_index,
                     input_pic->stride_cr,
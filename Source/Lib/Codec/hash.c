@@ -10,6 +10,7 @@
  */
 
 #include "hash.h"
+#include "aom_dsp_rtcd.h"
 static void crc_calculator_process_data(CRC_CALCULATOR *p_crc_calculator, uint8_t *pData, uint32_t dataLength) {
     for (uint32_t i = 0; i < dataLength; i++) {
         const uint8_t index = (uint8_t)((p_crc_calculator->remainder >> (p_crc_calculator->bits - 8)) ^ pData[i]);
@@ -56,3 +57,21 @@ uint32_t svt_av1_get_crc_value(void *crc_calculator, uint8_t *p, int length) {
     crc_calculator_process_data(p_crc_calculator, p, length);
     return crc_calculator_get_crc(p_crc_calculator);
 }
+
+/* CRC-32C (iSCSI) polynomial in reversed bit order. */
+#define CRC32C_POLY 0x82f63b78
+
+void svt_av1_crc32c_calculator_init(CRC32C *p_crc32c) {
+    for (uint32_t n = 0; n < 256; n++) {
+        uint32_t crc = n;
+        for (int k = 0; k < 8; k++) crc = (crc & 1) ? (crc >> 1) ^ CRC32C_POLY : crc >> 1;
+        p_crc32c->table[n] = crc;
+    }
+}
+
+uint32_t svt_av1_get_crc32c_value_c(void *crc_calculator, uint8_t *p, size_t length) {
+    const CRC32C *p_crc32c = (const CRC32C *)crc_calculator;
+    uint32_t      crc      = 0xFFFFFFFF;
+    for (size_t i = 0; i < length; i++) crc = p_crc32c->table[(crc ^ p[i]) & 0xff] ^ (crc >> 8);
+    return crc ^ 0xFFFFFFFF;
+}
@@ -9,26 +9,14 @@
  * PATENTS file, you can obtain it at https://www.aomedia.org/license/patent-license.
  */
 
+#include <string.h>
 #include "hash.h"
 #include "hash_motion.h"
 #include "pcs.h"
+#include "aom_dsp_rtcd.h"
+#include "svt_malloc.h"
 
-void             svt_aom_free(void *memblk);
-static const int crc_bits        = 16;
-static const int block_size_bits = 3;
-
-static void hash_table_clear_all(HashTable *p_hash_table) {
-    if (p_hash_table->p_lookup_table == NULL)
-        return;
-    int max_addr = 1 << (crc_bits + block_size_bits);
-    for (int i = 0; i < max_addr; i++) {
-        if (p_hash_table->p_lookup_table[i] != NULL) {
-            svt_aom_vector_destroy(p_hash_table->p_lookup_table[i]);
-            free(p_hash_table->p_lookup_table[i]);
-            p_hash_table->p_lookup_table[i] = NULL;
-        }
-    }
-}
+static const int crc_bits = 16;
 
 static void get_pixels_in_1d_char_array_by_block_2x2(uint8_t *y_src, int stride, uint8_t *p_pixels_in1D) {
     uint8_t *p_pel = y_src;
@@ -87,47 +75,51 @@ static int hash_block_size_to_index(int block_size) {
     }
 }
 
-void svt_av1_hash_table_destroy(HashTable *p_hash_table) {
-    hash_table_clear_all(p_hash_table);
-    EB_FREE_ARRAY(p_hash_table->p_lookup_table);
-    p_hash_table->p_lookup_table = NULL;
+void svt_av1_hash_table_release_entries(HashTable *p_hash_table) {
+    EB_FREE_ARRAY(p_hash_table->buckets);
+    EB_FREE_ARRAY(p_hash_table->entries);
+    p_hash_table->num_buckets = 0;
+    p_hash_table->max_buckets = 0;
+    p_hash_table->num_entries = 0;
+    p_hash_table->max_entries = 0;
+    p_hash_table->level_mask  = 0;
 }
 
-EbErrorType svt_aom_rtime_alloc_svt_av1_hash_table_create(HashTable *p_hash_table) {
-    EbErrorType err_code = EB_ErrorNone;
-    ;
+void svt_av1_hash_table_destroy(HashTable *p_hash_table) { svt_av1_hash_table_release_entries(p_hash_table); }
 
-    if (p_hash_table->p_lookup_table != NULL) {
-        hash_table_clear_all(p_hash_table);
-        return err_code;
-    }
-    const int max_addr = 1 << (crc_bits + block_size_bits);
-    //p_hash_table->p_lookup_table = (Vector **)malloc(sizeof(p_hash_table->p_lookup_table[0]) * max_addr);
-    EB_CALLOC_ARRAY(p_hash_table->p_lookup_table, max_addr);
-
-    return err_code;
+EbErrorType svt_aom_rtime_alloc_svt_av1_hash_table_create(HashTable *p_hash_table) {
+    // The arrays are allocated level by level as the table is filled.
+    p_hash_table->num_buckets = 0;
+    p_hash_table->num_entries = 0;
+    p_hash_table->level_mask  = 0;
+    return EB_ErrorNone;
 }
 
-static void hash_table_add_to_table(HashTable *p_hash_table, uint32_t hash_value, BlockHash *curr_block_hash) {
-    if (p_hash_table->p_lookup_table[hash_value] == NULL) {
-        p_hash_table->p_lookup_table[hash_value] = malloc(sizeof(p_hash_table->p_lookup_table[0][0]));
-        svt_aom_vector_setup(p_hash_table->p_lookup_table[hash_value], 10, sizeof(curr_block_hash[0]));
-        svt_aom_vector_push_back(p_hash_table->p_lookup_table[hash_value], curr_block_hash);
-    } else {
-        svt_aom_vector_push_back(p_hash_table->p_lookup_table[hash_value], curr_block_hash);
+static const HashBucket *hash_table_find(const HashTable *p_hash_table, uint32_t hash_value) {
+    if (!(p_hash_table->level_mask & (1 << (hash_value >> crc_bits))))
+        return NULL;
+    uint32_t lo = 0;
+    uint32_t hi = p_hash_table->num_buckets;
+    while (lo < hi) {
+        const uint32_t mid = (lo + hi) >> 1;
+        if (p_hash_table->buckets[mid].hash_value1 < hash_value)
+            lo = mid + 1;
+        else
+            hi = mid;
     }
+    if (lo == p_hash_table->num_buckets || p_hash_table->buckets[lo].hash_value1 != hash_value)
+        return NULL;
+    return &p_hash_table->buckets[lo];
 }
 
 int32_t svt_av1_hash_table_count(const HashTable *p_hash_table, uint32_t hash_value) {
-    if (p_hash_table->p_lookup_table[hash_value] == NULL) {
-        return 0;
-    } else
-        return (int32_t)(p_hash_table->p_lookup_table[hash_value]->size);
+    const HashBucket *bucket = hash_table_find(p_hash_table, hash_value);
+    return bucket ? (int32_t)(bucket[1].start - bucket[0].start) : 0;
 }
 
-Iterator svt_av1_hash_get_first_iterator(HashTable *p_hash_table, uint32_t hash_value) {
+const BlockHash *svt_av1_hash_get_first_block(const HashTable *p_hash_table, uint32_t hash_value) {
     assert(svt_av1_hash_table_count(p_hash_table, hash_value) > 0);
-    return svt_aom_vector_begin(p_hash_table->p_lookup_table[hash_value]);
+    return p_hash_table->entries + hash_table_find(p_hash_table, hash_value)->start;
 }
 
 void svt_av1_generate_block_2x2_hash_value(const Yv12BufferConfig *picture, uint32_t *pic_block_hash[2],
@@ -148,8 +140,8 @@ void svt_av1_generate_block_2x2_hash_value(const Yv12BufferConfig *picture, uint
                 pic_block_same_info[0][pos] = is_block16_2x2_row_same_value(p);
                 pic_block_same_info[1][pos] = is_block16_2x2_col_same_value(p);
 
-                pic_block_hash[0][pos] = svt_av1_get_crc_value(
-                    &pcs->crc_calculator1, (uint8_t *)p, length * sizeof(p[0]));
+                pic_block_hash[0][pos] = svt_av1_get_crc32c_value(
+                    &pcs->crc32c, (uint8_t *)p, length * sizeof(p[0]));
                 pic_block_hash[1][pos] = svt_av1_get_crc_value(
                     &pcs->crc_calculator2, (uint8_t *)p, length * sizeof(p[0]));
                 pos++;
@@ -166,7 +158,7 @@ void svt_av1_generate_block_2x2_hash_value(const Yv12BufferConfig *picture, uint
                 pic_block_same_info[0][pos] = is_block_2x2_row_same_value(p);
                 pic_block_same_info[1][pos] = is_block_2x2_col_same_value(p);
 
-                pic_block_hash[0][pos] = svt_av1_get_crc_value(&pcs->crc_calculator1, p, length * sizeof(p[0]));
+                pic_block_hash[0][pos] = svt_av1_get_crc32c_value(&pcs->crc32c, p, length * sizeof(p[0]));
                 pic_block_hash[1][pos] = svt_av1_get_crc_value(&pcs->crc_calculator2, p, length * sizeof(p[0]));
                 pos++;
             }
@@ -195,7 +187,7 @@ void svt_av1_generate_block_hash_value(const Yv12BufferConfig *picture, int bloc
             p[1]                       = src_pic_block_hash[0][pos + src_size];
             p[2]                       = src_pic_block_hash[0][pos + src_size * pic_width];
             p[3]                       = src_pic_block_hash[0][pos + src_size * pic_width + src_size];
-            dst_pic_block_hash[0][pos] = svt_av1_get_crc_value(&pcs->crc_calculator1, (uint8_t *)p, length);
+            dst_pic_block_hash[0][pos] = svt_av1_get_crc32c_value(&pcs->crc32c, (uint8_t *)p, length);
 
             p[0]                       = src_pic_block_hash[1][pos];
             p[1]                       = src_pic_block_hash[1][pos + src_size];
@@ -234,36 +226,89 @@ void svt_av1_generate_block_hash_value(const Yv12BufferConfig *picture, int bloc
     }
 }
 
-void svt_aom_rtime_alloc_svt_av1_add_to_hash_map_by_row_with_precal_data(HashTable *p_hash_table, uint32_t *pic_hash[2],
-                                                                         int8_t *pic_is_same, int pic_width,
-                                                                         int pic_height, int block_size) {
+// Grow the bucket index and the entry arena, keeping the levels already added.
+static EbErrorType hash_table_reserve(HashTable *p_hash_table, uint32_t num_buckets, uint32_t num_entries) {
+    if (num_buckets > p_hash_table->max_buckets) {
+        EB_REALLOC_ARRAY(p_hash_table->buckets, num_buckets);
+        p_hash_table->max_buckets = num_buckets;
+    }
+    if (num_entries > p_hash_table->max_entries) {
+        EB_REALLOC_ARRAY(p_hash_table->entries, num_entries);
+        p_hash_table->max_entries = num_entries;
+    }
+    return EB_ErrorNone;
+}
+
+EbErrorType svt_aom_rtime_alloc_svt_av1_add_to_hash_map_by_row_with_precal_data(HashTable *p_hash_table,
+                                                                                uint32_t  *pic_hash[2],
+                                                                                int8_t    *pic_is_same, int pic_width,
+                                                                                int pic_height, int block_size) {
     const int x_end = pic_width - block_size + 1;
     const int y_end = pic_height - block_size + 1;
 
     const int8_t   *src_is_added = pic_is_same;
     const uint32_t *src_hash[2]  = {pic_hash[0], pic_hash[1]};
 
-    int add_value = hash_block_size_to_index(block_size);
-    assert(add_value >= 0);
-    add_value <<= crc_bits;
-    const int crc_mask = (1 << crc_bits) - 1;
+    const int level = hash_block_size_to_index(block_size);
+    // levels are added from the smallest block size up, which keeps the buckets sorted
+    assert(level >= 0 && !(p_hash_table->level_mask >> level));
+    const int crc_count = 1 << crc_bits;
+    const int crc_mask  = crc_count - 1;
+    uint32_t *cursor;
+    EB_CALLOC_ARRAY(cursor, crc_count);
+
+    // Count the blocks of each bucket.
+    for (int y_pos = 0; y_pos < y_end; y_pos++) {
+        const int pos = y_pos * pic_width;
+        for (int x_pos = 0; x_pos < x_end; x_pos++)
+            if (src_is_added[pos + x_pos])
+                cursor[src_hash[0][pos + x_pos] & crc_mask]++;
+    }
+    uint32_t num_buckets = p_hash_table->num_buckets;
+    uint32_t num_entries = p_hash_table->num_entries;
+    for (int k = 0; k < crc_count; k++) {
+        num_buckets += cursor[k] != 0;
+        num_entries += cursor[k];
+    }
+    EbErrorType return_error = hash_table_reserve(p_hash_table, num_buckets + 1, num_entries);
+    if (return_error != EB_ErrorNone) {
+        EB_FREE_ARRAY(cursor);
+        return return_error;
+    }
+
+    // Index the non-empty buckets and turn the counts into scatter cursors.
+    HashBucket *bucket = p_hash_table->buckets + p_hash_table->num_buckets;
+    uint32_t    start  = p_hash_table->num_entries;
+    for (int k = 0; k < crc_count; k++) {
+        if (cursor[k]) {
+            bucket->hash_value1 = (level << crc_bits) | k;
+            bucket->start       = start;
+            bucket++;
+            start += cursor[k];
+            cursor[k] = start - cursor[k];
+        }
+    }
+    bucket->hash_value1 = UINT32_MAX;
+    bucket->start       = num_entries;
 
+    // Scatter column by column to keep the search order of each bucket.
     for (int x_pos = 0; x_pos < x_end; x_pos++) {
         for (int y_pos = 0; y_pos < y_end; y_pos++) {
             const int pos = y_pos * pic_width + x_pos;
             // valid data
             if (src_is_added[pos]) {
-                BlockHash curr_block_hash;
-                curr_block_hash.x = x_pos;
-                curr_block_hash.y = y_pos;
-
-                const uint32_t hash_value1  = (src_hash[0][pos] & crc_mask) + add_value;
-                curr_block_hash.hash_value2 = src_hash[1][pos];
-
-                hash_table_add_to_table(p_hash_table, hash_value1, &curr_block_hash);
+                BlockHash *curr_block_hash   = &p_hash_table->entries[cursor[src_hash[0][pos] & crc_mask]++];
+                curr_block_hash->x           = x_pos;
+                curr_block_hash->y           = y_pos;
+                curr_block_hash->hash_value2 = src_hash[1][pos];
             }
         }
     }
+    EB_FREE_ARRAY(cursor);
+    p_hash_table->num_buckets = num_buckets;
+    p_hash_table->num_entries = num_entries;
+    p_hash_table->level_mask |= 1 << level;
+    return EB_ErrorNone;
 }
 
 void svt_av1_get_block_hash_value(uint8_t *y_src, int stride, int block_size, uint32_t *hash_value1,
@@ -285,8 +330,8 @@ void svt_av1_get_block_hash_value(uint8_t *y_src, int stride, int block_size, ui
                 int pos = (y_pos >> 1) * sub_block_in_width + (x_pos >> 1);
                 get_pixels_in_1d_short_array_by_block_2x2(y16_src + y_pos * stride + x_pos, stride, pixel_to_hash);
                 assert(pos < AOM_BUFFER_SIZE_FOR_BLOCK_HASH);
-                x->hash_value_buffer[0][0][pos] = svt_av1_get_crc_value(
-                    &x->crc_calculator1, (uint8_t *)pixel_to_hash, sizeof(pixel_to_hash));
+                x->hash_value_buffer[0][0][pos] = svt_av1_get_crc32c_value(
+                    &x->crc32c, (uint8_t *)pixel_to_hash, sizeof(pixel_to_hash));
                 x->hash_value_buffer[1][0][pos] = svt_av1_get_crc_value(
                     &x->crc_calculator2, (uint8_t *)pixel_to_hash, sizeof(pixel_to_hash));
             }
@@ -298,8 +343,8 @@ void svt_av1_get_block_hash_value(uint8_t *y_src, int stride, int block_size, ui
                 int pos = (y_pos >> 1) * sub_block_in_width + (x_pos >> 1);
                 get_pixels_in_1d_char_array_by_block_2x2(y_src + y_pos * stride + x_pos, stride, pixel_to_hash);
                 assert(pos < AOM_BUFFER_SIZE_FOR_BLOCK_HASH);
-                x->hash_value_buffer[0][0][pos] = svt_av1_get_crc_value(
-                    &x->crc_calculator1, pixel_to_hash, sizeof(pixel_to_hash));
+                x->hash_value_buffer[0][0][pos] = svt_av1_get_crc32c_value(
+                    &x->crc32c, pixel_to_hash, sizeof(pixel_to_hash));
                 x->hash_value_buffer[1][0][pos] = svt_av1_get_crc_value(
                     &x->crc_calculator2, pixel_to_hash, sizeof(pixel_to_hash));
             }
@@ -329,8 +374,8 @@ void svt_av1_get_block_hash_value(uint8_t *y_src, int stride, int block_size, ui
                 to_hash[1] = x->hash_value_buffer[0][src_idx][src_pos + 1];
                 to_hash[2] = x->hash_value_buffer[0][src_idx][src_pos + src_sub_block_in_width];
                 to_hash[3] = x->hash_value_buffer[0][src_idx][src_pos + src_sub_block_in_width + 1];
-                x->hash_value_buffer[0][dst_idx][dst_pos] = svt_av1_get_crc_value(
-                    &x->crc_calculator1, (uint8_t *)to_hash, sizeof(to_hash));
+                x->hash_value_buffer[0][dst_idx][dst_pos] = svt_av1_get_crc32c_value(
+                    &x->crc32c, (uint8_t *)to_hash, sizeof(to_hash));
 
                 to_hash[0] = x->hash_value_buffer[1][src_idx][src_pos];
                 to_hash[1] = x->hash_value_buffer[1][src_idx][src_pos + 1];
@@ -14,7 +14,6 @@
 
 #include "definitions.h"
 #include "coding_unit.h"
-#include "vector.h"
 #include "pic_buffer_desc.h"
 
 #ifdef __cplusplus
@@ -30,22 +29,42 @@ typedef struct _block_hash {
     uint32_t hash_value2;
 } BlockHash;
 
+// one non-empty bucket: the entries with this hash_value1 start at start and
+// end where the next bucket starts
+typedef struct HashBucket {
+    uint32_t hash_value1;
+    uint32_t start;
+} HashBucket;
+
+// Flat hash table. hash_value1 is a 19-bit key (3 block size bits and 16 crc
+// bits). The entries of all levels share one arena, grouped by key, and only
+// the non-empty buckets are indexed, in increasing key order and followed by
+// an end sentinel. Both arrays are sized to the content of the picture and
+// released once it is packetized.
 typedef struct HashTable {
-    Vector **p_lookup_table;
+    HashBucket *buckets;
+    BlockHash  *entries;
+    uint32_t    num_buckets;
+    uint32_t    max_buckets;
+    uint32_t    num_entries;
+    uint32_t    max_entries;
+    uint8_t     level_mask; // block size levels added since the last reset
 } HashTable;
-void        svt_av1_hash_table_destroy(HashTable *p_hash_table);
-EbErrorType svt_aom_rtime_alloc_svt_av1_hash_table_create(HashTable *p_hash_table);
-int32_t     svt_av1_hash_table_count(const HashTable *p_hash_table, uint32_t hash_value);
-Iterator    svt_av1_hash_get_first_iterator(HashTable *p_hash_table, uint32_t hash_value);
-void        svt_av1_generate_block_2x2_hash_value(const Yv12BufferConfig *picture, uint32_t *pic_block_hash[2],
-                                                  int8_t *pic_block_same_info[3], struct PictureControlSet *pcs);
+void             svt_av1_hash_table_destroy(HashTable *p_hash_table);
+void             svt_av1_hash_table_release_entries(HashTable *p_hash_table);
+EbErrorType      svt_aom_rtime_alloc_svt_av1_hash_table_create(HashTable *p_hash_table);
+int32_t          svt_av1_hash_table_count(const HashTable *p_hash_table, uint32_t hash_value);
+const BlockHash *svt_av1_hash_get_first_block(const HashTable *p_hash_table, uint32_t hash_value);
+void             svt_av1_generate_block_2x2_hash_value(const Yv12BufferConfig *picture, uint32_t *pic_block_hash[2],
+                                                       int8_t *pic_block_same_info[3], struct PictureControlSet *pcs);
 
 void svt_av1_generate_block_hash_value(const Yv12BufferConfig *picture, int block_size, uint32_t *src_pic_block_hash[2],
                                        uint32_t *dst_pic_block_hash[2], int8_t *src_pic_block_same_info[3],
                                        int8_t *dst_pic_block_same_info[3], struct PictureControlSet *pcs);
-void svt_aom_rtime_alloc_svt_av1_add_to_hash_map_by_row_with_precal_data(HashTable *p_hash_table, uint32_t *pic_hash[2],
-                                                                         int8_t *pic_is_same, int pic_width,
-                                                                         int pic_height, int block_size);
+EbErrorType svt_aom_rtime_alloc_svt_av1_add_to_hash_map_by_row_with_precal_data(HashTable *p_hash_table,
+                                                                                uint32_t  *pic_hash[2],
+                                                                                int8_t    *pic_is_same, int pic_width,
+                                                                                int pic_height, int block_size);
 
 // check whether the block starts from (x_start, y_start) with the size of
 // BlockSize x BlockSize has the same color in all rows
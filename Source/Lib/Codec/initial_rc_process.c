@@ -23,6 +23,7 @@
 #include "svt_log.h"
 #include "pd_process.h"
 #include "firstpass.h"
+#include "svt_trace.h"
 /**************************************
  * Context
  **************************************/
@@ -88,6 +89,11 @@ EbErrorType svt_aom_initial_rate_control_context_ctor(EbThreadContext *thread_ct
     return EB_ErrorNone;
 }
 
+uint64_t svt_aom_initial_rate_control_context_size(void) {
+    return sizeof(InitialRateControlContext) + sizeof(LadQueue) +
+        REFERENCE_QUEUE_MAX_DEPTH * (sizeof(LadQueueEntry *) + sizeof(LadQueueEntry));
+}
+
 void svt_av1_build_quantizer(EbBitDepth bit_depth, int32_t y_dc_delta_q, int32_t u_dc_delta_q, int32_t u_ac_delta_q,
                              int32_t v_dc_delta_q, int32_t v_ac_delta_q, Quants *const quants, Dequants *const deq, PictureParentControlSet *pcs);
 
@@ -676,6 +682,7 @@ void *svt_aom_initial_rate_control_kernel(void *input_ptr) {
 
         MotionEstimationResults *in_results_ptr = (MotionEstimationResults *)in_results_wrapper_ptr->object_ptr;
         PictureParentControlSet *pcs            = (PictureParentControlSet *)in_results_ptr->pcs_wrapper->object_ptr;
+        SVT_TRACE_BEGIN("initial_rc", pcs->picture_number, (int32_t)in_results_ptr->segment_index);
 
         // Set the segment counter
         pcs->me_segments_completion_count++;
@@ -20,6 +20,8 @@
  * Extern Function Declaration
  ***************************************/
 EbErrorType svt_aom_initial_rate_control_context_ctor(EbThreadContext *thread_ctx, const EbEncHandle *enc_handle_ptr);
+/* Bytes svt_aom_initial_rate_control_context_ctor() allocates for the context */
+uint64_t svt_aom_initial_rate_control_context_size(void);
 
 extern void *svt_aom_initial_rate_control_kernel(void *input_ptr);
 #endif // EbInitialRateControl_h
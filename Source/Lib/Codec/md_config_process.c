@@ -30,6 +30,8 @@
 #include "enc_mode_config.h"
 #include "global_me.h"
 #include "aom_dsp_rtcd.h"
+#include "svt_trace.h"
+#include "svt_time.h"
 #define MAX_MESH_SPEED 5 // Max speed setting for mesh motion method
 static MeshPattern good_quality_mesh_patterns[MAX_MESH_SPEED + 1][MAX_MESH_STEP] = {
     {{64, 8}, {28, 4}, {15, 1}, {7, 1}},
@@ -679,6 +681,7 @@ void *svt_aom_mode_decision_configuration_kernel(void *input_ptr) {
         RateControlResults *rc_results = (RateControlResults *)rc_results_wrapper->object_ptr;
         PictureControlSet  *pcs        = (PictureControlSet *)rc_results->pcs_wrapper->object_ptr;
         SequenceControlSet *scs        = pcs->scs;
+        SVT_TRACE_BEGIN("md_config", pcs->picture_number, -1);
         pcs->min_me_clpx               = 0;
         pcs->max_me_clpx               = 0;
         pcs->avg_me_clpx               = 0;
@@ -819,17 +822,17 @@ void *svt_aom_mode_decision_configuration_kernel(void *input_ptr) {
                         is_block_same[k][j] = rtime_alloc_block_hash_block_is_same(sizeof(int8_t) * pic_width *
                                                                                    pic_height);
                 }
-                svt_aom_rtime_alloc_svt_av1_hash_table_create(&pcs->hash_table);
+                EbErrorType hash_error = svt_aom_rtime_alloc_svt_av1_hash_table_create(&pcs->hash_table);
                 Yv12BufferConfig cpi_source;
                 svt_aom_link_eb_to_aom_buffer_desc_8bit(pcs->ppcs->enhanced_pic, &cpi_source);
 
-                svt_av1_crc_calculator_init(&pcs->crc_calculator1, 24, 0x5D6DCB);
+                svt_av1_crc32c_calculator_init(&pcs->crc32c);
                 svt_av1_crc_calculator_init(&pcs->crc_calculator2, 24, 0x864CFB);
 
                 svt_av1_generate_block_2x2_hash_value(&cpi_source, block_hash_values[0], is_block_same[0], pcs);
                 uint8_t       src_idx     = 0;
                 const uint8_t max_sb_size = pcs->ppcs->intraBC_ctrls.max_block_size_hash;
-                for (int size = 4; size <= max_sb_size; size <<= 1, src_idx = !src_idx) {
+                for (int size = 4; size <= max_sb_size && hash_error == EB_ErrorNone; size <<= 1, src_idx = !src_idx) {
                     const uint8_t dst_idx = !src_idx;
                     svt_av1_generate_block_hash_value(&cpi_source,
                                                       size,
@@ -839,13 +842,19 @@ void *svt_aom_mode_decision_configuration_kernel(void *input_ptr) {
                                                       is_block_same[dst_idx],
                                                       pcs);
                     if (size != 4 || pcs->ppcs->intraBC_ctrls.hash_4x4_blocks)
-                        svt_aom_rtime_alloc_svt_av1_add_to_hash_map_by_row_with_precal_data(&pcs->hash_table,
-                                                                                            block_hash_values[dst_idx],
-                                                                                            is_block_same[dst_idx][2],
-                                                                                            pic_width,
-                                                                                            pic_height,
-                                                                                            size);
+                        hash_error = svt_aom_rtime_alloc_svt_av1_add_to_hash_map_by_row_with_precal_data(
+                            &pcs->hash_table,
+                            block_hash_values[dst_idx],
+                            is_block_same[dst_idx][2],
+                            pic_width,
+                            pic_height,
+                            size);
                 }
+                // The levels added before the failure stay searchable, the larger block sizes
+                // simply get no hash candidates.
+                if (hash_error != EB_ErrorNone)
+                    SVT_ERROR("Not enough memory for the IntraBC hash table of picture %d\n",
+                              (int)pcs->picture_number);
                 for (k = 0; k < 2; k++) {
                     for (j = 0; j < 2; j++) free(block_hash_values[k][j]);
                     for (j = 0; j < 3; j++) free(is_block_same[k][j]);
@@ -963,6 +972,10 @@ void *svt_aom_mode_decision_configuration_kernel(void *input_ptr) {
         }
 
         // Post the results to the MD processes
+#if DEBUG_ENCDEC_PARALLEL
+        pcs->enc_dec_busy_time = 0;
+        svt_av1_get_time(&pcs->enc_dec_start_time_seconds, &pcs->enc_dec_start_time_u_seconds);
+#endif
         uint16_t tg_count = pcs->ppcs->tile_group_cols * pcs->ppcs->tile_group_rows;
         for (uint16_t tile_group_idx = 0; tile_group_idx < tg_count; tile_group_idx++) {
             svt_get_empty_object(context_ptr->mode_decision_configuration_output_fifo_ptr, &enc_dec_tasks_wrapper);
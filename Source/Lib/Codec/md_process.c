@@ -116,6 +116,7 @@ static void mode_decision_context_dctor(EbPtr p) {
     EB_DELETE(obj->temp_residual);
     EB_DELETE(obj->temp_recon_ptr);
     EB_FREE_ARRAY(obj->full_cost_ssim_array);
+    EB_FREE_ARRAY(obj->psy_nrg_cache.nrg[0]);
 }
 
 void svt_aom_set_nics(NicScalingCtrls *scaling_ctrls, uint32_t mds1_count[CAND_CLASS_TOTAL],
@@ -477,6 +478,11 @@ EbErrorType svt_aom_mode_decision_context_ctor(ModeDecisionContext *ctx, EbColor
                &(ctx->full_cost_array[buffer_index]),
                &(ctx->full_cost_ssim_array[buffer_index]));
     }
+    // Source psy-rd energies, one entry per 4x4 position of the SB for each plane
+    const uint32_t psy_grid_size = (sb_size >> 2) * (sb_size >> 2);
+    EB_MALLOC_ARRAY(ctx->psy_nrg_cache.nrg[0], psy_grid_size * MAX_MB_PLANE);
+    ctx->psy_nrg_cache.nrg[1] = ctx->psy_nrg_cache.nrg[0] + psy_grid_size;
+    ctx->psy_nrg_cache.nrg[2] = ctx->psy_nrg_cache.nrg[1] + psy_grid_size;
 
     return EB_ErrorNone;
 }
@@ -21,6 +21,7 @@
 #include "neighbor_arrays.h"
 #include "object.h"
 #include "enc_inter_prediction.h"
+#include "psy_rd.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -908,6 +909,9 @@ typedef struct ModeDecisionContext {
     uint8_t                      *cost_avail;
     MdcSbData                     mdc_sb_array;
     bool                          copied_neigh_arrays;
+    // extent from the square origin of the area of the neighbour arrays modified since they were saved in [1]
+    uint8_t                       na_dirty_w;
+    uint8_t                       na_dirty_h;
     MvReferenceFrame              ref_frame_type_arr[MODE_CTX_REF_FRAMES];
     uint8_t                       tot_ref_frame_types;
 
@@ -1250,6 +1254,8 @@ typedef struct ModeDecisionContext {
     // SSIM_LVL_1: use ssim cost to find best candidate in product_full_mode_decision()
     // SSIM_LVL_2: addition to level 1, also use ssim cost to find best tx type in tx_type_search()
     SsimLevel tune_ssim_level;
+    // source-side psy-rd energies of the current SB, shared by all candidates
+    PsySrcEnergyCache psy_nrg_cache;
 } ModeDecisionContext;
 
 typedef void (*EbAv1LambdaAssignFunc)(PictureControlSet *pcs, uint32_t *fast_lambda, uint32_t *full_lambda,
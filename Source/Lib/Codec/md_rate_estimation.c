@@ -10,6 +10,7 @@
 * PATENTS file, you can obtain it at https://www.aomedia.org/license/patent-license.
 */
 
+#include <stddef.h>
 #include <stdlib.h>
 
 #include "md_rate_estimation.h"
@@ -417,6 +418,32 @@ void copy_mv_rate(PictureControlSet *pcs, MdRateEstimationContext *dst_rate) {
         memcpy(dst_rate->dv_joint_cost, pcs->md_rate_est_ctx->dv_joint_cost, MV_JOINTS * sizeof(int32_t));
     }
 }
+static void copy_rate_range(MdRateEstimationContext *dst, const MdRateEstimationContext *src, size_t start,
+                            size_t end) {
+    memcpy((uint8_t *)dst + start, (const uint8_t *)src + start, end - start);
+}
+// Everything written by svt_aom_estimate_syntax_rate(): the fields before the MV costs, those between the MV
+// and the coefficient costs, and those after the coefficient costs
+void svt_aom_copy_syntax_rate(MdRateEstimationContext *dst, const MdRateEstimationContext *src) {
+    copy_rate_range(dst,
+                    src,
+                    offsetof(MdRateEstimationContext, partition_fac_bits),
+                    offsetof(MdRateEstimationContext, nmv_vec_cost));
+    copy_rate_range(dst,
+                    src,
+                    offsetof(MdRateEstimationContext, inter_compound_mode_fac_bits),
+                    offsetof(MdRateEstimationContext, coeff_fac_bits));
+    copy_rate_range(dst,
+                    src,
+                    offsetof(MdRateEstimationContext, txfm_partition_fac_bits),
+                    sizeof(MdRateEstimationContext));
+}
+void svt_aom_copy_coefficients_rate(MdRateEstimationContext *dst, const MdRateEstimationContext *src) {
+    copy_rate_range(dst,
+                    src,
+                    offsetof(MdRateEstimationContext, coeff_fac_bits),
+                    offsetof(MdRateEstimationContext, txfm_partition_fac_bits));
+}
 /**************************************************************************
  * svt_aom_estimate_coefficients_rate()
  * Estimate the rate of the quantised coefficient
@@ -214,6 +214,17 @@ extern void svt_aom_estimate_mv_rate(
         struct PictureControlSet *pcs,
         MdRateEstimationContext  *md_rate_est_ctx,
         FRAME_CONTEXT            *fc);
+    /**************************************************************************
+    * Copy the syntax element and the coefficient rates of the picture table
+    * (built once per picture by mode decision configuration), for the groups
+    * that are not re-estimated per SB
+    ***************************************************************************/
+    extern void svt_aom_copy_syntax_rate(
+        MdRateEstimationContext       *dst,
+        const MdRateEstimationContext *src);
+    extern void svt_aom_copy_coefficients_rate(
+        MdRateEstimationContext       *dst,
+        const MdRateEstimationContext *src);
 #define AVG_CDF_WEIGHT_LEFT      3
 #define AVG_CDF_WEIGHT_TOP       1
 
@@ -34,6 +34,7 @@
 #include "firstpass.h"
 #include "initial_rc_process.h"
 #include "enc_mode_config.h"
+#include "svt_trace.h"
 
 /* --32x32-
 |00||01|
@@ -108,6 +109,9 @@ void *svt_aom_motion_estimation_kernel(void *input_ptr) {
         PictureParentControlSet *pcs = (PictureParentControlSet *)
                                                in_results_ptr->pcs_wrapper->object_ptr;
         SequenceControlSet *scs = pcs->scs;
+        SVT_TRACE_BEGIN(in_results_ptr->task_type == TASK_TFME ? "tf_me" : "motion_estimation",
+                        pcs->picture_number,
+                        (int32_t)in_results_ptr->segment_index);
         if (in_results_ptr->task_type == TASK_TFME)
             me_context_ptr->me_ctx->me_type = ME_MCTF;
         else if (in_results_ptr->task_type == TASK_PAME || in_results_ptr->task_type == TASK_SUPERRES_RE_ME)
@@ -161,7 +165,9 @@ void *svt_aom_motion_estimation_kernel(void *input_ptr) {
                 skip_me = TRUE;
             // skip me for the first pass. ME is already performed
             if (!skip_me) {
-                if (pcs->slice_type != I_SLICE) {
+                // a superres recode loop at an already searched scaling has its ME restored from the cache
+                if (pcs->slice_type != I_SLICE &&
+                    !(in_results_ptr->task_type == TASK_SUPERRES_RE_ME && pcs->me_cache_hit)) {
                     // Use scaled source references if resolution of the reference is different that of the input
                     svt_aom_use_scaled_source_refs_if_needed(pcs,
                                                      input_pic,
@@ -46,6 +46,9 @@ typedef struct MeSbResults {
     uint8_t     *total_me_candidate_index;
     MvCandidate *me_mv_array;
     MeCandidate *me_candidate_array;
+    uint8_t      pu_count; // allocated entries of total_me_candidate_index
+    uint8_t      mv_count; // allocated me_mv_array entries per PU
+    uint8_t      cand_count; // allocated me_candidate_array entries per PU
     // [PU][LAST, LAST2, LAST3, GOLD, BWD, ALT2, ALT] if MRP Mode 0,
     // [PU][LAST, LAST2, BWD, ALT2] if MRP Mode 1,
 } MeSbResults;
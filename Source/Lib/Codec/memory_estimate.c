@@ -0,0 +1,247 @@
+/*
+* Copyright (c) 2024, Alliance for Open Media. All rights reserved
+*
+* This source code is subject to the terms of the BSD 2 Clause License and
+* the Alliance for Open Media Patent License 1.0. If the BSD 2 Clause License
+* was not distributed with this source code in the LICENSE file, you can
+* obtain it at https://www.aomedia.org/license/software-license. If the Alliance for Open
+* Media Patent License 1.0 was not distributed with this source code in the
+* PATENTS file, you can obtain it at https://www.aomedia.org/license/patent-license.
+*/
+
+#include "memory_estimate.h"
+#include "enc_handle.h"
+#include "pcs.h"
+#include "md_process.h"
+#include "me_process.h"
+#include "pd_process.h"
+#include "initial_rc_process.h"
+#include "pic_manager_process.h"
+#include "cdef_process.h"
+#include "enc_mode_config.h"
+#include "reference_object.h"
+#include "encode_context.h"
+#include "restoration.h"
+#include "quality_metrics.h"
+#include "utility.h"
+
+// a stage thread also costs its EbThreadContext and its slots in the context and handle arrays
+#define THREAD_OVERHEAD (sizeof(EbThreadContext) + 2 * sizeof(EbPtr))
+
+static uint64_t picture_size(uint16_t width, uint16_t height, EbBitDepth bit_depth, EbColorFormat color_format,
+                             uint32_t mask, uint16_t padding, Bool split_mode, Bool noy8b) {
+    EbPictureBufferDescInitData init_data;
+    memset(&init_data, 0, sizeof(init_data));
+    init_data.max_width          = width;
+    init_data.max_height         = height;
+    init_data.bit_depth          = bit_depth;
+    init_data.color_format       = color_format;
+    init_data.buffer_enable_mask = mask;
+    init_data.left_padding       = padding;
+    init_data.right_padding      = padding;
+    init_data.top_padding        = padding;
+    init_data.bot_padding        = padding;
+    init_data.split_mode         = split_mode;
+    return svt_picture_buffer_desc_size(&init_data, noy8b);
+}
+
+/* Pool of count objects of object_size bytes, with one producer and no consumer like all the
+ * picture pools */
+static uint64_t pool_size(uint32_t count, uint64_t object_size) {
+    return svt_system_resource_size(count, 1, 0, FALSE) + count * object_size;
+}
+
+/* Mode decision and encode-decode context of an enc dec thread, see svt_aom_enc_dec_context_ctor().
+ * The mode decision context only depends on the preset and block geometry, so one is built and
+ * measured. Its per-block buffers are sized from the block geometry when the preset bypasses the
+ * encode pass, only then are the process wide geometry tables rebuilt, as svt_av1_enc_init() does */
+static EbErrorType enc_dec_thread_size(const SequenceControlSet *scs, uint64_t *size) {
+    const EbSvtAv1EncConfiguration *cfg = &scs->static_config;
+    EbMemoryAccount                 account;
+    memset(&account, 0, sizeof(account));
+    if (svt_aom_get_bypass_encdec(cfg->enc_mode, cfg->encoder_bit_depth))
+        svt_aom_build_blk_geom(scs->svt_aom_geom_idx);
+
+    ModeDecisionContext *md_ctx;
+    svt_memory_account_bind(&account, SVT_AV1_MEM_MODE_DECISION);
+    EB_NEW(md_ctx,
+           svt_aom_mode_decision_context_ctor,
+           cfg->encoder_color_format,
+           (uint8_t)scs->super_block_size,
+           cfg->enc_mode,
+           scs->max_block_cnt,
+           cfg->encoder_bit_depth,
+           NULL,
+           NULL,
+           scs->enable_hbd_mode_decision == DEFAULT ? 2 : scs->enable_hbd_mode_decision,
+           cfg->screen_content_mode,
+           scs->seq_qp_mod);
+    svt_memory_account_bind(NULL, SVT_AV1_MEM_OTHER);
+    EB_DELETE(md_ctx);
+
+    *size = THREAD_OVERHEAD + sizeof(EncDecContext) + account.allocated[SVT_AV1_MEM_MODE_DECISION] +
+        2 *
+            picture_size(SB_STRIDE_Y,
+                         SB_STRIDE_Y,
+                         EB_THIRTYTWO_BIT,
+                         cfg->encoder_color_format,
+                         PICTURE_BUFFER_DESC_FULL_MASK,
+                         0,
+                         FALSE,
+                         FALSE) +
+        (1 + !!scs->is_16bit_pipeline) *
+            picture_size(SB_STRIDE_Y,
+                         SB_STRIDE_Y,
+                         EB_SIXTEEN_BIT,
+                         cfg->encoder_color_format,
+                         PICTURE_BUFFER_DESC_FULL_MASK,
+                         0,
+                         FALSE,
+                         FALSE);
+    return EB_ErrorNone;
+}
+
+/* Motion estimation context of a motion estimation thread, see svt_aom_motion_estimation_context_ctor() */
+static EbErrorType me_thread_size(uint64_t *size) {
+    EbMemoryAccount account;
+    MeContext      *me_ctx;
+    memset(&account, 0, sizeof(account));
+    svt_memory_account_bind(&account, SVT_AV1_MEM_LOOKAHEAD);
+    EB_NEW(me_ctx, svt_aom_me_context_ctor);
+    svt_memory_account_bind(NULL, SVT_AV1_MEM_OTHER);
+    EB_DELETE(me_ctx);
+    *size = THREAD_OVERHEAD + sizeof(MotionEstimationContext_t) + account.allocated[SVT_AV1_MEM_LOOKAHEAD];
+    return EB_ErrorNone;
+}
+
+/* Picture decision context and its scene change histograms, see svt_aom_picture_decision_context_ctor() */
+static uint64_t pd_context_size(const SequenceControlSet *scs) {
+    uint64_t size = THREAD_OVERHEAD + sizeof(PictureDecisionContext);
+    if (scs->calc_hist)
+        size += MAX_NUMBER_OF_REGIONS_IN_WIDTH *
+                (sizeof(uint32_t **) +
+                 MAX_NUMBER_OF_REGIONS_IN_HEIGHT *
+                     (sizeof(uint32_t *) + HISTOGRAM_NUMBER_OF_BINS * sizeof(uint32_t) * sizeof(uint32_t))) +
+            MAX_NUMBER_OF_REGIONS_IN_WIDTH * sizeof(uint32_t) *
+                (sizeof(uint32_t *) + MAX_NUMBER_OF_REGIONS_IN_HEIGHT * sizeof(uint32_t) * sizeof(uint32_t));
+    return size;
+}
+
+/* Restoration search frames of a rest thread, see rest_context_ctor() */
+static uint64_t rest_thread_size(const SequenceControlSet *scs) {
+    const EbSvtAv1EncConfiguration *cfg  = &scs->static_config;
+    uint64_t                        size = 0;
+    if (cfg->stat_report)
+        size += sizeof(MetricsScratch) +
+            scs->max_input_luma_width *
+                ((cfg->encoder_bit_depth > EB_EIGHT_BIT ? (2 * METRICS_BAND_HEIGHT + 2) * sizeof(uint16_t) : 0) +
+                 2 * METRICS_BAND_HEIGHT * sizeof(uint16_t) + (METRICS_BAND_HEIGHT / 4 + 1) * sizeof(uint32_t));
+    if (svt_aom_get_enable_restoration(
+            cfg->enc_mode, cfg->enable_restoration_filtering, scs->input_resolution, cfg->fast_decode)) {
+        const uint64_t frame = picture_size((uint16_t)scs->max_input_luma_width,
+                                            (uint16_t)scs->max_input_luma_height,
+                                            scs->is_16bit_pipeline ? EB_SIXTEEN_BIT : EB_EIGHT_BIT,
+                                            cfg->encoder_color_format,
+                                            PICTURE_BUFFER_DESC_FULL_MASK,
+                                            AOM_RESTORATION_FRAME_BORDER,
+                                            FALSE,
+                                            FALSE);
+        size += frame * (1 + !!scs->use_boundaries_in_rest_search);
+        if (svt_aom_get_enable_sg(cfg->enc_mode, scs->input_resolution, cfg->fast_decode))
+            size += RESTORATION_TMPBUF_SIZE;
+    }
+    return size;
+}
+
+EbErrorType svt_aom_memory_model_init(const SequenceControlSet *scs, EbMemoryModel *model) {
+    const EbSvtAv1EncConfiguration *cfg    = &scs->static_config;
+    const uint32_t                  width  = scs->max_input_luma_width;
+    const uint32_t                  height = scs->max_input_luma_height;
+    // input pictures are allocated 8 aligned
+    const uint16_t in_width  = (uint16_t)(width + width % 8);
+    const uint16_t in_height = (uint16_t)(height + height % 8);
+    const Bool     split     = cfg->encoder_bit_depth > EB_EIGHT_BIT;
+    memset(model, 0, sizeof(*model));
+    model->input = sizeof(EbBufferHeaderType) +
+        picture_size(in_width,
+                     in_height,
+                     cfg->encoder_bit_depth,
+                     cfg->encoder_color_format,
+                     PICTURE_BUFFER_DESC_FULL_MASK,
+                     scs->left_padding,
+                     split,
+                     TRUE);
+    model->input_y8b = sizeof(EbBufferHeaderType) +
+        picture_size(in_width,
+                     in_height,
+                     EB_EIGHT_BIT,
+                     cfg->encoder_color_format,
+                     PICTURE_BUFFER_DESC_LUMA_MASK,
+                     scs->left_padding,
+                     FALSE,
+                     FALSE);
+    model->overlay = sizeof(EbBufferHeaderType) +
+        picture_size(in_width,
+                     in_height,
+                     cfg->encoder_bit_depth,
+                     cfg->encoder_color_format,
+                     PICTURE_BUFFER_DESC_FULL_MASK,
+                     scs->left_padding,
+                     split,
+                     FALSE);
+    model->recon_output = sizeof(EbBufferHeaderType) +
+        ((uint64_t)width * height * 3 / 2 << (cfg->encoder_bit_depth > EB_EIGHT_BIT));
+    model->rest_thread = THREAD_OVERHEAD + rest_thread_size(scs);
+    model->fixed[SVT_AV1_MEM_LOOKAHEAD] = pd_context_size(scs) + THREAD_OVERHEAD +
+        svt_aom_initial_rate_control_context_size();
+    model->fixed[SVT_AV1_MEM_OTHER] = THREAD_OVERHEAD + sizeof(PictureManagerContext);
+    EbErrorType return_error = me_thread_size(&model->me_thread);
+    if (return_error != EB_ErrorNone)
+        return return_error;
+    return enc_dec_thread_size(scs, &model->enc_dec_thread);
+}
+
+void svt_aom_memory_estimate(const SequenceControlSet *scs, const EbMemoryModel *model, SvtAv1MemoryUsage *usage) {
+    const EbSvtAv1EncConfiguration *cfg = &scs->static_config;
+    uint64_t                       *c   = usage->category;
+    memcpy(c, model->fixed, sizeof(model->fixed));
+
+    c[SVT_AV1_MEM_PICTURES] += pool_size(scs->picture_control_set_pool_init_count, model->ppcs);
+    c[SVT_AV1_MEM_PICTURES] += pool_size(scs->picture_control_set_pool_init_count_child, model->pcs);
+    c[SVT_AV1_MEM_PICTURES] += pool_size(scs->enc_dec_pool_init_count, model->enc_dec_set);
+    c[SVT_AV1_MEM_PICTURES] += pool_size(scs->input_buffer_fifo_init_count, model->input);
+    c[SVT_AV1_MEM_PICTURES] += pool_size(
+        MAX(scs->input_buffer_fifo_init_count, scs->pa_reference_picture_buffer_init_count), model->input_y8b);
+    if (cfg->enable_overlays)
+        c[SVT_AV1_MEM_PICTURES] += pool_size(scs->overlay_input_picture_buffer_init_count, model->overlay);
+    if (cfg->recon_enabled)
+        c[SVT_AV1_MEM_PICTURES] += svt_system_resource_size(
+                                       scs->output_recon_buffer_fifo_init_count,
+                                       scs->enc_dec_process_init_count,
+                                       1,
+                                       cfg->lock_free_queues) +
+            scs->output_recon_buffer_fifo_init_count * model->recon_output;
+
+    c[SVT_AV1_MEM_REFERENCES] += pool_size(scs->reference_picture_buffer_init_count, model->reference);
+    // reference list of the picture manager, see create_ref_buf_descs()
+    c[SVT_AV1_MEM_REFERENCES] += (scs->enable_dec_order ? scs->pa_reference_picture_buffer_init_count
+                                                        : scs->reference_picture_buffer_init_count) *
+        (sizeof(ReferenceQueueEntry *) + sizeof(ReferenceQueueEntry));
+
+    c[SVT_AV1_MEM_LOOKAHEAD] += pool_size(scs->me_pool_init_count, model->me);
+    c[SVT_AV1_MEM_LOOKAHEAD] += pool_size(scs->pa_reference_picture_buffer_init_count, model->pa_reference);
+    c[SVT_AV1_MEM_LOOKAHEAD] += pool_size(scs->tpl_reference_picture_buffer_init_count, model->tpl_reference);
+    c[SVT_AV1_MEM_LOOKAHEAD] += scs->motion_estimation_process_init_count * model->me_thread;
+
+    c[SVT_AV1_MEM_MODE_DECISION] += scs->enc_dec_process_init_count * model->enc_dec_thread;
+
+    c[SVT_AV1_MEM_OTHER] += scs->rest_process_init_count * model->rest_thread;
+    // partial sums of the CDEF strength search bands, see svt_aom_cdef_context_ctor()
+    const uint32_t cdef_segments = MIN(CDEF_SEARCH_MAX_SEGMENTS, scs->cdef_search_process_init_count + 1);
+    if (cdef_segments > 1)
+        c[SVT_AV1_MEM_OTHER] += (uint64_t)scs->cdef_process_init_count * cdef_segments * TOTAL_STRENGTHS *
+            TOTAL_STRENGTHS * sizeof(uint64_t);
+
+    usage->total = 0;
+    for (int i = 0; i < SVT_AV1_MEM_CATEGORIES; i++) usage->total += c[i];
+}
@@ -0,0 +1,61 @@
+/*
+* Copyright (c) 2024, Alliance for Open Media. All rights reserved
+*
+* This source code is subject to the terms of the BSD 2 Clause License and
+* the Alliance for Open Media Patent License 1.0. If the BSD 2 Clause License
+* was not distributed with this source code in the LICENSE file, you can
+* obtain it at https://www.aomedia.org/license/software-license. If the Alliance for Open
+* Media Patent License 1.0 was not distributed with this source code in the
+* PATENTS file, you can obtain it at https://www.aomedia.org/license/patent-license.
+*/
+
+#ifndef EbMemoryEstimate_h
+#define EbMemoryEstimate_h
+
+#include "sequence_control_set.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Model of the memory svt_av1_enc_init() allocates, split into the size of one object of each pool
+ * and of one context of each kind of stage thread, so the pool and thread counts derived in
+ * load_default_buffer_configuration_settings() can be priced without building the encoder.
+ *
+ * The pool objects whose init data is built by enc_handle.c (picture control sets, motion estimation
+ * and encode-decode sets, reference pictures, sequence control sets) are measured there by building
+ * one of each with the creator of their pool, and the task fifos are priced there too. The input
+ * buffers and the stage contexts are sized with the formulas of their ctors, the mode decision and
+ * motion estimation contexts are built and measured. The private contexts of the other stages, a few
+ * hundred bytes each, are not priced.
+ */
+typedef struct EbMemoryModel {
+    uint64_t input; // uv8b + 2 bit planes of an input picture
+    uint64_t input_y8b; // 8 bit luma of an input picture, shared with the PA reference
+    uint64_t overlay;
+    uint64_t ppcs; // measured by the caller
+    uint64_t me; // measured by the caller
+    uint64_t pcs; // measured by the caller
+    uint64_t enc_dec_set; // measured by the caller
+    uint64_t reference; // measured by the caller
+    uint64_t pa_reference; // measured by the caller
+    uint64_t tpl_reference; // measured by the caller
+    uint64_t recon_output;
+    uint64_t me_thread;
+    uint64_t enc_dec_thread;
+    uint64_t rest_thread;
+    uint64_t fixed[SVT_AV1_MEM_CATEGORIES]; // contexts of the single instance stages
+} EbMemoryModel;
+
+/* Fills the model of scs, after load_default_buffer_configuration_settings(), except the fields
+ * measured by the caller. Builds the block geometry tables like svt_av1_enc_init() when the mode
+ * decision context reads them */
+EbErrorType svt_aom_memory_model_init(const SequenceControlSet *scs, EbMemoryModel *model);
+/* Prices the pool and thread counts of scs with model */
+void svt_aom_memory_estimate(const SequenceControlSet *scs, const EbMemoryModel *model, SvtAv1MemoryUsage *usage);
+
+#ifdef __cplusplus
+}
+#endif
+#endif // EbMemoryEstimate_h
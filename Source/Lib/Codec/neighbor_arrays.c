@@ -34,9 +34,9 @@ EbErrorType svt_aom_neighbor_array_unit_ctor32(NeighborArrayUnit32 *na_unit_ptr,
     na_unit_ptr->dctor                     = neighbor_array_unit_dctor32;
     na_unit_ptr->unit_size                 = (uint8_t)(unit_size);
     na_unit_ptr->granularity_normal        = granularity_normal;
-    na_unit_ptr->granularity_normal_log2   = (uint8_t)(svt_log2f(na_unit_ptr->granularity_normal));
+    na_unit_ptr->granularity_normal_log2   = (uint8_t)(svt_aom_log2f_32(na_unit_ptr->granularity_normal));
     na_unit_ptr->granularity_top_left      = granularity_top_left;
-    na_unit_ptr->granularity_top_left_log2 = (uint8_t)(svt_log2f(na_unit_ptr->granularity_top_left));
+    na_unit_ptr->granularity_top_left_log2 = (uint8_t)(svt_aom_log2f_32(na_unit_ptr->granularity_top_left));
     na_unit_ptr->left_array_size           = (uint16_t)((type_mask & NEIGHBOR_ARRAY_UNIT_LEFT_MASK)
                                                             ? max_picture_height >> na_unit_ptr->granularity_normal_log2
                                                             : 0);
@@ -76,9 +76,9 @@ EbErrorType svt_aom_neighbor_array_unit_ctor(NeighborArrayUnit *na_unit_ptr, uin
     na_unit_ptr->dctor                     = neighbor_array_unit_dctor;
     na_unit_ptr->unit_size                 = (uint8_t)(unit_size);
     na_unit_ptr->granularity_normal        = granularity_normal;
-    na_unit_ptr->granularity_normal_log2   = (uint8_t)(svt_log2f(na_unit_ptr->granularity_normal));
+    na_unit_ptr->granularity_normal_log2   = (uint8_t)(svt_aom_log2f_32(na_unit_ptr->granularity_normal));
     na_unit_ptr->granularity_top_left      = granularity_top_left;
-    na_unit_ptr->granularity_top_left_log2 = (uint8_t)(svt_log2f(na_unit_ptr->granularity_top_left));
+    na_unit_ptr->granularity_top_left_log2 = (uint8_t)(svt_aom_log2f_32(na_unit_ptr->granularity_top_left));
 
     na_unit_ptr->max_pic_h = max_picture_height;
 
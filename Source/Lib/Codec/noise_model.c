@@ -17,6 +17,7 @@
 #include "mathutils.h"
 #include "svt_log.h"
 #include "aom_dsp_rtcd.h"
+#include "pic_analysis_process.h"
 
 static const int32_t k_max_lag = 4;
 
@@ -502,6 +503,36 @@ static int compare_scores(const void *a, const void *b) {
     return diff < 0 ? -1 : diff > 0;
 }
 
+void svt_aom_flat_block_finder_block_stats_c(const double *blocks, int32_t block_size, int32_t num_blocks,
+                                             double *stats) {
+    const int32_t n = block_size * block_size;
+    for (int32_t k = 0; k < num_blocks; ++k) {
+        const double *block = blocks + k * n;
+        double        g_xx = 0, g_xy = 0, g_yy = 0;
+        double        var  = 0;
+        double        mean = 0;
+        for (int32_t yi = 1; yi < block_size - 1; ++yi) {
+            for (int32_t xi = 1; xi < block_size - 1; ++xi) {
+                const double gx = (block[yi * block_size + xi + 1] - block[yi * block_size + xi - 1]) / 2;
+                const double gy = (block[yi * block_size + xi + block_size] -
+                                   block[yi * block_size + xi - block_size]) /
+                    2;
+                g_xx += gx * gx;
+                g_xy += gx * gy;
+                g_yy += gy * gy;
+
+                mean += block[yi * block_size + xi];
+                var += block[yi * block_size + xi] * block[yi * block_size + xi];
+            }
+        }
+        stats[0 * FLAT_BLOCK_STATS_BATCH + k] = g_xx;
+        stats[1 * FLAT_BLOCK_STATS_BATCH + k] = g_xy;
+        stats[2 * FLAT_BLOCK_STATS_BATCH + k] = g_yy;
+        stats[3 * FLAT_BLOCK_STATS_BATCH + k] = mean;
+        stats[4 * FLAT_BLOCK_STATS_BATCH + k] = var;
+    }
+}
+
 int32_t svt_aom_flat_block_finder_run(const AomFlatBlockFinder *block_finder, const uint8_t *const data, int32_t w,
                                       int32_t h, int32_t stride, uint8_t *flat_blocks) {
     // The gradient-based features used in this code are based on:
@@ -519,7 +550,7 @@ int32_t svt_aom_flat_block_finder_run(const AomFlatBlockFinder *block_finder, co
     const int32_t  num_blocks_h      = (h + block_size - 1) / block_size;
     int32_t        num_flat          = 0;
     double        *plane             = (double *)malloc(n * sizeof(*plane));
-    double        *block             = (double *)malloc(n * sizeof(*block));
+    double        *block             = (double *)malloc(FLAT_BLOCK_STATS_BATCH * n * sizeof(*block));
     IndexAndscore *scores            = (IndexAndscore *)malloc(num_blocks_w * num_blocks_h * sizeof(*scores));
     if (plane == NULL || block == NULL || scores == NULL) {
         SVT_ERROR("Failed to allocate memory for block of size %d\n", n);
@@ -532,29 +563,30 @@ int32_t svt_aom_flat_block_finder_run(const AomFlatBlockFinder *block_finder, co
 #ifdef NOISE_MODEL_LOG_SCORE
     SVT_ERROR("score = [");
 #endif
+    double stats[5 * FLAT_BLOCK_STATS_BATCH];
     for (int32_t by = 0; by < num_blocks_h; ++by) {
         for (int32_t bx = 0; bx < num_blocks_w; ++bx) {
-            // Compute gradient covariance matrix.
-            double g_xx = 0, g_xy = 0, g_yy = 0;
-            double var  = 0;
-            double mean = 0;
-            svt_aom_flat_block_finder_extract_block(
-                block_finder, data, w, h, stride, bx * block_size, by * block_size, plane, block);
-
-            for (int32_t yi = 1; yi < block_size - 1; ++yi) {
-                for (int32_t xi = 1; xi < block_size - 1; ++xi) {
-                    const double gx = (block[yi * block_size + xi + 1] - block[yi * block_size + xi - 1]) / 2;
-                    const double gy = (block[yi * block_size + xi + block_size] -
-                                       block[yi * block_size + xi - block_size]) /
-                        2;
-                    g_xx += gx * gx;
-                    g_xy += gx * gy;
-                    g_yy += gy * gy;
-
-                    mean += block[yi * block_size + xi];
-                    var += block[yi * block_size + xi] * block[yi * block_size + xi];
-                }
+            // Gradient covariance matrices are computed a batch of blocks at a time.
+            const int32_t k = bx % FLAT_BLOCK_STATS_BATCH;
+            if (!k) {
+                const int32_t num_batch = AOMMIN(FLAT_BLOCK_STATS_BATCH, num_blocks_w - bx);
+                for (int32_t i = 0; i < num_batch; ++i)
+                    svt_aom_flat_block_finder_extract_block(block_finder,
+                                                            data,
+                                                            w,
+                                                            h,
+                                                            stride,
+                                                            (bx + i) * block_size,
+                                                            by * block_size,
+                                                            plane,
+                                                            block + i * n);
+                svt_aom_flat_block_finder_block_stats(block, block_size, num_batch, stats);
             }
+            double g_xx = stats[0 * FLAT_BLOCK_STATS_BATCH + k];
+            double g_xy = stats[1 * FLAT_BLOCK_STATS_BATCH + k];
+            double g_yy = stats[2 * FLAT_BLOCK_STATS_BATCH + k];
+            double mean = stats[3 * FLAT_BLOCK_STATS_BATCH + k];
+            double var  = stats[4 * FLAT_BLOCK_STATS_BATCH + k];
             mean /= (block_size - 2) * (block_size - 2);
 
             // Normalize gradients by BlockSize.
@@ -1964,98 +1996,190 @@ void svt_av1_apply_window_function_to_plane_c(int32_t y_size, int32_t x_size, fl
     }
 }
 
+/* Buffers of one band of block rows of the Wiener denoiser */
+typedef struct DenoiseScratch {
+    float                 *plane;
+    float                 *block;
+    double                *block_d;
+    double                *plane_d;
+    struct aom_noise_tx_t *tx_full;
+    struct aom_noise_tx_t *tx_chroma;
+    int32_t                failed;
+} DenoiseScratch;
+
+/* One pass of the overlapped block processing: a plane and a vertical block offset */
+struct WienerDenoiseJob {
+    const uint8_t *const *data;
+    const int32_t        *stride;
+    const float          *noise_psd;
+    int32_t               w;
+    int32_t               h;
+    int32_t               block_size;
+    const int32_t        *chroma_sub;
+    int32_t               num_blocks_w;
+    int32_t               num_blocks_h;
+    AomFlatBlockFinder   *block_finder_full;
+    AomFlatBlockFinder   *block_finder_chroma;
+    const float          *window_full;
+    const float          *window_chroma;
+    float                *result;
+    int32_t               result_stride;
+    int32_t               c;
+    int32_t               offsy;
+    DenoiseScratch        scratch[DENOISE_MAX_SEGMENTS];
+};
+
+static void denoise_scratch_free(DenoiseScratch *scratch) {
+    free(scratch->plane);
+    svt_aom_free(scratch->block);
+    free(scratch->block_d);
+    free(scratch->plane_d);
+    if (scratch->tx_chroma != scratch->tx_full)
+        svt_aom_noise_tx_free(scratch->tx_chroma);
+    svt_aom_noise_tx_free(scratch->tx_full);
+    scratch->plane     = NULL;
+    scratch->block     = NULL;
+    scratch->block_d   = NULL;
+    scratch->plane_d   = NULL;
+    scratch->tx_full   = NULL;
+    scratch->tx_chroma = NULL;
+}
+
+static int32_t denoise_scratch_alloc(DenoiseScratch *scratch, int32_t block_size, int32_t chroma_sub) {
+    scratch->plane     = (float *)malloc(block_size * block_size * sizeof(*scratch->plane));
+    scratch->block     = (float *)svt_aom_memalign(32, 2 * block_size * block_size * sizeof(*scratch->block));
+    scratch->block_d   = (double *)malloc(block_size * block_size * sizeof(*scratch->block_d));
+    scratch->plane_d   = (double *)malloc(block_size * block_size * sizeof(*scratch->plane_d));
+    scratch->tx_full   = svt_aom_noise_tx_malloc(block_size);
+    scratch->tx_chroma = chroma_sub != 0 ? svt_aom_noise_tx_malloc(block_size >> chroma_sub) : scratch->tx_full;
+    if (scratch->plane && scratch->block && scratch->block_d && scratch->plane_d && scratch->tx_full &&
+        scratch->tx_chroma)
+        return 1;
+    denoise_scratch_free(scratch);
+    scratch->failed = 1;
+    return 0;
+}
+
+void svt_aom_wiener_denoise_segment(struct WienerDenoiseJob *job, uint16_t segment_index, uint16_t segment_count) {
+    DenoiseScratch *scratch = &job->scratch[segment_index];
+    if (scratch->failed || (!scratch->block && !denoise_scratch_alloc(scratch, job->block_size, job->chroma_sub[0])))
+        return;
+    const int32_t          c               = job->c;
+    const int32_t          block_size      = job->block_size;
+    const float           *window_function = c == 0 ? job->window_full : job->window_chroma;
+    AomFlatBlockFinder    *block_finder    = (c > 0 && job->chroma_sub[0] != 0) ? job->block_finder_chroma
+                                                                               : job->block_finder_full;
+    const int32_t          chroma_sub_h    = c > 0 ? job->chroma_sub[1] : 0;
+    const int32_t          chroma_sub_w    = c > 0 ? job->chroma_sub[0] : 0;
+    struct aom_noise_tx_t *tx = (c > 0 && job->chroma_sub[0] > 0) ? scratch->tx_chroma : scratch->tx_full;
+    const int32_t          y_size           = block_size >> chroma_sub_h;
+    const int32_t          x_size           = block_size >> chroma_sub_w;
+    const int32_t          pixels_per_block = x_size * y_size;
+    const int32_t          offsy            = job->offsy;
+    // Rows -1 .. num_blocks_h - 1 pad the boundary
+    const int32_t row_count = job->num_blocks_h + 1;
+    const int32_t by_start  = -1 + row_count * segment_index / segment_count;
+    const int32_t by_end    = -1 + row_count * (segment_index + 1) / segment_count;
+
+    // Block rows at one vertical offset do not overlap. Within a row the horizontal
+    // offsets are processed in order, so each output sample gets its terms in the
+    // same order as when the whole plane is processed one offset at a time.
+    for (int32_t by = by_start; by < by_end; ++by) {
+        for (int32_t offsx = 0; offsx < x_size; offsx += x_size / 2) {
+            for (int32_t bx = -1; bx < job->num_blocks_w; ++bx) {
+                svt_aom_flat_block_finder_extract_block(block_finder,
+                                                        job->data[c],
+                                                        job->w >> chroma_sub_w,
+                                                        job->h >> chroma_sub_h,
+                                                        job->stride[c],
+                                                        bx * x_size + offsx,
+                                                        by * y_size + offsy,
+                                                        scratch->plane_d,
+                                                        scratch->block_d);
+                svt_av1_pointwise_multiply(
+                    window_function, scratch->plane, scratch->block, scratch->plane_d, scratch->block_d, pixels_per_block);
+                svt_aom_noise_tx_forward(tx, scratch->block);
+                svt_aom_noise_tx_filter(tx->block_size, tx->tx_block, job->noise_psd[c]);
+                svt_aom_noise_tx_inverse(tx, scratch->block);
+
+                // Apply window function to the plane approximation (we will apply
+                // it to the sum of plane + block when composing the results).
+                float *result_ptr = job->result + ((by + 1) * y_size + offsy) * job->result_stride +
+                    (bx + 1) * x_size + offsx;
+                svt_av1_apply_window_function_to_plane(
+                    y_size, x_size, result_ptr, job->result_stride, scratch->block, scratch->plane, window_function);
+            }
+        }
+    }
+}
+
 int32_t svt_aom_wiener_denoise_2d(const uint8_t *const data[3], uint8_t *denoised[3], int32_t w, int32_t h,
                                   int32_t stride[3], int32_t chroma_sub[2], float noise_psd[3], int32_t block_size,
-                                  int32_t bit_depth, int32_t use_highbd) {
-    const float *window_full = NULL, *window_chroma = NULL;
-    float       *plane = NULL;
-    DECLARE_ALIGNED(32, float, *block);
-    block                          = NULL;
-    double                *block_d = NULL, *plane_d = NULL;
-    struct aom_noise_tx_t *tx_full       = NULL;
-    struct aom_noise_tx_t *tx_chroma     = NULL;
-    const int32_t          num_blocks_w  = (w + block_size - 1) / block_size;
-    const int32_t          num_blocks_h  = (h + block_size - 1) / block_size;
-    const int32_t          result_stride = (num_blocks_w + 2) * block_size;
-    const int32_t          result_height = (num_blocks_h + 2) * block_size;
-    float                 *result        = NULL;
-    int32_t                init_success  = 1;
-    AomFlatBlockFinder     block_finder_full;
-    AomFlatBlockFinder     block_finder_chroma;
-    const float            k_block_normalization = (float)((1 << bit_depth) - 1);
+                                  int32_t bit_depth, int32_t use_highbd, struct SegmentDispatch *dispatch) {
+    const float       *window_full = NULL, *window_chroma = NULL;
+    const int32_t      num_blocks_w  = (w + block_size - 1) / block_size;
+    const int32_t      num_blocks_h  = (h + block_size - 1) / block_size;
+    const int32_t      result_stride = (num_blocks_w + 2) * block_size;
+    const int32_t      result_height = (num_blocks_h + 2) * block_size;
+    float             *result        = NULL;
+    int32_t            init_success  = 1;
+    AomFlatBlockFinder block_finder_full;
+    AomFlatBlockFinder block_finder_chroma;
+    const float        k_block_normalization = (float)((1 << bit_depth) - 1);
     if (chroma_sub[0] != chroma_sub[1]) {
         SVT_ERROR(
             "svt_aom_wiener_denoise_2d doesn't handle different chroma "
             "subsampling");
         return 0;
     }
+    struct WienerDenoiseJob job;
+    memset(&job, 0, sizeof(job));
     init_success &= svt_aom_flat_block_finder_init(&block_finder_full, block_size, bit_depth, use_highbd);
     result      = (float *)malloc((num_blocks_h + 2) * block_size * result_stride * sizeof(*result));
-    plane       = (float *)malloc(block_size * block_size * sizeof(*plane));
-    block       = (float *)svt_aom_memalign(32, 2 * block_size * block_size * sizeof(*block));
-    block_d     = (double *)malloc(block_size * block_size * sizeof(*block_d));
-    plane_d     = (double *)malloc(block_size * block_size * sizeof(*plane_d));
     window_full = get_half_cos_window(block_size);
-    tx_full     = svt_aom_noise_tx_malloc(block_size);
 
     if (chroma_sub[0] != 0) {
         init_success &= svt_aom_flat_block_finder_init(
             &block_finder_chroma, block_size >> chroma_sub[0], bit_depth, use_highbd);
         window_chroma = get_half_cos_window(block_size >> chroma_sub[0]);
-        tx_chroma     = svt_aom_noise_tx_malloc(block_size >> chroma_sub[0]);
     } else {
         window_chroma = window_full;
-        tx_chroma     = tx_full;
     }
 
-    init_success &= (int32_t)((tx_full != NULL) && (tx_chroma != NULL) && (plane != NULL) && (plane_d != NULL) &&
-                              (block != NULL) && (block_d != NULL) && (window_full != NULL) &&
-                              (window_chroma != NULL) && (result != NULL));
+    // the first band's buffers, the others are allocated by the thread denoising them
+    init_success &= denoise_scratch_alloc(&job.scratch[0], block_size, chroma_sub[0]);
+    init_success &= (int32_t)((window_full != NULL) && (window_chroma != NULL) && (result != NULL));
+
+    job.data                = data;
+    job.stride              = stride;
+    job.noise_psd           = noise_psd;
+    job.w                   = w;
+    job.h                   = h;
+    job.block_size          = block_size;
+    job.chroma_sub          = chroma_sub;
+    job.num_blocks_w        = num_blocks_w;
+    job.num_blocks_h        = num_blocks_h;
+    job.block_finder_full   = &block_finder_full;
+    job.block_finder_chroma = &block_finder_chroma;
+    job.window_full         = window_full;
+    job.window_chroma       = window_chroma;
+    job.result              = result;
+    job.result_stride       = result_stride;
     for (int32_t c = init_success ? 0 : 3; c < 3; ++c) {
-        const float           *window_function = c == 0 ? window_full : window_chroma;
-        AomFlatBlockFinder    *block_finder    = &block_finder_full;
-        const int32_t          chroma_sub_h    = c > 0 ? chroma_sub[1] : 0;
-        const int32_t          chroma_sub_w    = c > 0 ? chroma_sub[0] : 0;
-        struct aom_noise_tx_t *tx              = (c > 0 && chroma_sub[0] > 0) ? tx_chroma : tx_full;
+        const int32_t chroma_sub_h = c > 0 ? chroma_sub[1] : 0;
+        const int32_t chroma_sub_w = c > 0 ? chroma_sub[0] : 0;
         if (!data[c] || !denoised[c])
             continue;
-        if (c > 0 && chroma_sub[0] != 0)
-            block_finder = &block_finder_chroma;
         memset(result, 0, sizeof(*result) * result_stride * result_height);
-        // Do overlapped block processing (half overlapped). The block rows can
-        // easily be done in parallel
+        // Do overlapped block processing (half overlapped). The block rows of
+        // each vertical offset are done in parallel.
+        job.c = c;
         for (int32_t offsy = 0; offsy < (block_size >> chroma_sub_h); offsy += (block_size >> chroma_sub_h) / 2) {
-            for (int32_t offsx = 0; offsx < (block_size >> chroma_sub_w); offsx += (block_size >> chroma_sub_w) / 2) {
-                // Pad the boundary when processing each block-set.
-                for (int32_t by = -1; by < num_blocks_h; ++by) {
-                    for (int32_t bx = -1; bx < num_blocks_w; ++bx) {
-                        const int32_t pixels_per_block = (block_size >> chroma_sub_w) * (block_size >> chroma_sub_h);
-                        svt_aom_flat_block_finder_extract_block(block_finder,
-                                                                data[c],
-                                                                w >> chroma_sub_w,
-                                                                h >> chroma_sub_h,
-                                                                stride[c],
-                                                                bx * (block_size >> chroma_sub_w) + offsx,
-                                                                by * (block_size >> chroma_sub_h) + offsy,
-                                                                plane_d,
-                                                                block_d);
-                        svt_av1_pointwise_multiply(window_function, plane, block, plane_d, block_d, pixels_per_block);
-                        svt_aom_noise_tx_forward(tx, block);
-                        svt_aom_noise_tx_filter(tx->block_size, tx->tx_block, noise_psd[c]);
-                        svt_aom_noise_tx_inverse(tx, block);
-
-                        // Apply window function to the plane approximation (we will apply
-                        // it to the sum of plane + block when composing the results).
-
-                        const int y_size  = (block_size >> chroma_sub_h);
-                        const int x_size  = (block_size >> chroma_sub_w);
-                        float *result_ptr = result + ((by + 1) * y_size + offsy) * result_stride + (bx + 1) * x_size +
-                            offsx;
-                        svt_av1_apply_window_function_to_plane(
-                            y_size, x_size, result_ptr, result_stride, block, plane, window_function);
-                    }
-                }
-            }
+            job.offsy = offsy;
+            if (dispatch)
+                svt_aom_wiener_denoise_rows_mt(dispatch, &job, num_blocks_h + 1);
+            else
+                svt_aom_wiener_denoise_segment(&job, 0, 1);
         }
         if (use_highbd) {
             dither_and_quantize_highbd(result,
@@ -2082,18 +2206,14 @@ int32_t svt_aom_wiener_denoise_2d(const uint8_t *const data[3], uint8_t *denoise
         }
     }
     free(result);
-    free(plane);
-    svt_aom_free(block);
-    free(plane_d);
-    free(block_d);
-
-    svt_aom_noise_tx_free(tx_full);
+    for (int32_t i = 0; i < DENOISE_MAX_SEGMENTS; ++i) {
+        init_success &= !job.scratch[i].failed;
+        denoise_scratch_free(&job.scratch[i]);
+    }
 
     svt_aom_flat_block_finder_free(&block_finder_full);
-    if (chroma_sub[0] != 0) {
+    if (chroma_sub[0] != 0)
         svt_aom_flat_block_finder_free(&block_finder_chroma);
-        svt_aom_noise_tx_free(tx_chroma);
-    }
     return init_success;
 }
 
@@ -2320,7 +2440,8 @@ int32_t svt_aom_denoise_and_model_run(struct AomDenoiseAndModel *ctx, EbPictureB
                                    ctx->noise_psd,
                                    block_size,
                                    ctx->bit_depth,
-                                   use_highbd)) {
+                                   use_highbd,
+                                   ctx->dispatch)) {
         SVT_ERROR("Unable to denoise image\n");
         return 0;
     }
@@ -134,6 +134,15 @@ void svt_aom_flat_block_finder_extract_block_c(const AomFlatBlockFinder *block_f
                                                int32_t w, int32_t h, int32_t stride, int32_t offsx, int32_t offsy,
                                                double *plane, double *block);
 
+/* Number of blocks handled by one svt_aom_flat_block_finder_block_stats call */
+#define FLAT_BLOCK_STATS_BATCH 4
+
+/*!\brief Sums the gradient products (g_xx, g_xy, g_yy), the values and the
+     * squared values over the interior of num_blocks consecutive blocks. Sum i
+     * of block k is written to stats[i * FLAT_BLOCK_STATS_BATCH + k]. */
+void svt_aom_flat_block_finder_block_stats_c(const double *blocks, int32_t block_size, int32_t num_blocks,
+                                             double *stats);
+
 /*!\brief Runs the flat block finder on the input data.
      *
      * Find flat blocks in the input image data. Returns a map of
@@ -237,6 +246,8 @@ typedef struct AomDenoiseAndModel {
     AomFlatBlockFinder flat_block_finder;
     AomNoiseModel      noise_model;
     uint8_t            denoise_apply;
+
+    struct SegmentDispatch *dispatch; // workers of the Wiener denoise, NULL when single threaded
 } AomDenoiseAndModel;
 
 /************************************
@@ -308,10 +319,17 @@ int32_t svt_aom_noise_model_get_grain_parameters(AomNoiseModel *const noise_mode
      * \param[in]     use_highbd      If true, uint8 pointers are interpreted as
      *                                uint16 and stride is measured in uint16.
      *                                This must be true when bit_depth >= 10.
+     * \param[in]     dispatch        Denoise workers the block rows are split
+     *                                across, NULL to denoise on this thread.
      */
 int32_t svt_aom_wiener_denoise_2d(const uint8_t *const data[3], uint8_t *denoised[3], int32_t w, int32_t h,
                                   int32_t stride[3], int32_t chroma_sub_log2[2], float noise_psd[3], int32_t block_size,
-                                  int32_t bit_depth, int32_t use_highbd);
+                                  int32_t bit_depth, int32_t use_highbd, struct SegmentDispatch *dispatch);
+
+/*!\brief Denoises band segment_index of segment_count bands of block rows of
+     * the current pass of svt_aom_wiener_denoise_2d(). */
+struct WienerDenoiseJob;
+void svt_aom_wiener_denoise_segment(struct WienerDenoiseJob *job, uint16_t segment_index, uint16_t segment_count);
 
 struct AomDenoiseAndModel;
 
@@ -26,6 +26,8 @@
 #include "restoration.h" // RDCOST_DBL
 #include "rc_process.h"
 #include "enc_mode_config.h"
+#include "svt_trace.h"
+#include "quality_metrics.h"
 
 #define RDCOST_DBL_WITH_NATIVE_BD_DIST(RM, R, D, BD) RDCOST_DBL((RM), (R), (double)((D) >> (2 * (BD - 8))))
 
@@ -58,7 +60,6 @@ void        svt_aom_recon_output(PictureControlSet *pcs, SequenceControlSet *scs
 void        svt_aom_init_resize_picture(SequenceControlSet *scs, PictureParentControlSet *pcs);
 void        pad_ref_and_set_flags(PictureControlSet *pcs, SequenceControlSet *scs);
 void        svt_aom_update_rc_counts(PictureParentControlSet *ppcs);
-EbErrorType svt_aom_ssim_calculations(PictureControlSet *pcs, SequenceControlSet *scs, Bool free_memory);
 
 // Extracts passthrough data from a linked list. The extracted data nodes are removed from the original linked list and
 // returned as a linked list. Does not gaurantee the original order of the nodes.
@@ -488,6 +489,7 @@ void *svt_aom_packetization_kernel(void *input_ptr) {
         EntropyCodingResults *entropy_coding_results_ptr = (EntropyCodingResults *)
                                                                entropy_coding_results_wrapper_ptr->object_ptr;
         PictureControlSet       *pcs      = (PictureControlSet *)entropy_coding_results_ptr->pcs_wrapper->object_ptr;
+        SVT_TRACE_BEGIN("packetization", pcs->picture_number, -1);
         SequenceControlSet      *scs      = pcs->scs;
         EncodeContext           *enc_ctx  = scs->enc_ctx;
         FrameHeader             *frm_hdr  = &pcs->ppcs->frm_hdr;
@@ -527,6 +529,15 @@ void *svt_aom_packetization_kernel(void *input_ptr) {
 
             assert(ppcs->superres_total_recode_loop <= SCALE_NUMERATOR + 1);
             ppcs->superres_rdcost[ppcs->superres_recode_loop] = rdcost;
+            if (ppcs->slice_type != I_SLICE && ppcs->superres_recode_loop < ppcs->superres_total_recode_loop - 1) {
+                // keep the ME of the best loop so far, the extra loop recodes at the best denom
+                int best_index = 0;
+                for (int i = 1; i < ppcs->superres_recode_loop; ++i)
+                    if (ppcs->superres_rdcost[i] < ppcs->superres_rdcost[best_index])
+                        best_index = i;
+                if (ppcs->superres_recode_loop == 0 || rdcost < ppcs->superres_rdcost[best_index])
+                    svt_aom_me_cache_store(ppcs, ME_CACHE_SLOT_BEST);
+            }
             ++ppcs->superres_recode_loop;
 
             if (ppcs->superres_recode_loop <= ppcs->superres_total_recode_loop) {
@@ -564,6 +575,8 @@ void *svt_aom_packetization_kernel(void *input_ptr) {
                     bool super_res_off = ppcs->frame_superres_enabled == FALSE &&
                         scs->static_config.resize_mode == RESIZE_NONE;
                     svt_aom_set_gm_controls(ppcs, svt_aom_derive_gm_level(ppcs, super_res_off));
+                    if (ppcs->slice_type != I_SLICE)
+                        ppcs->me_cache_hit = svt_aom_me_cache_restore(ppcs);
                     // Initialize Segments as picture decision process
                     ppcs->me_segments_completion_count = 0;
                     ppcs->me_processed_b64_count       = 0;
@@ -633,12 +646,13 @@ void *svt_aom_packetization_kernel(void *input_ptr) {
             svt_release_object(pcs->ppcs->me_data_wrapper);
             pcs->ppcs->me_data_wrapper = NULL;
             pcs->ppcs->pa_me_data      = NULL;
+            svt_aom_me_cache_release(ppcs);
 
             // Delayed call from Rest process
             {
                 if (scs->static_config.stat_report) {
-                    // memory is freed in the svt_aom_ssim_calculations call
-                    svt_aom_ssim_calculations(pcs, scs, TRUE);
+                    // memory is freed once the metrics are done
+                    svt_aom_metrics_calculations(pcs);
                 } else {
                     // free memory used by psnr_calculations
                     free_temporal_filtering_buffer(pcs, scs);
@@ -731,19 +745,21 @@ void *svt_aom_packetization_kernel(void *input_ptr) {
         output_stream_ptr->qp            = pcs->ppcs->picture_qp;
 
         if (scs->static_config.stat_report) {
-            output_stream_ptr->luma_sse  = pcs->ppcs->luma_sse;
-            output_stream_ptr->cr_sse    = pcs->ppcs->cr_sse;
-            output_stream_ptr->cb_sse    = pcs->ppcs->cb_sse;
-            output_stream_ptr->luma_ssim = pcs->ppcs->luma_ssim;
-            output_stream_ptr->cr_ssim   = pcs->ppcs->cr_ssim;
-            output_stream_ptr->cb_ssim   = pcs->ppcs->cb_ssim;
+            output_stream_ptr->luma_sse     = pcs->ppcs->luma_sse;
+            output_stream_ptr->cr_sse       = pcs->ppcs->cr_sse;
+            output_stream_ptr->cb_sse       = pcs->ppcs->cb_sse;
+            output_stream_ptr->luma_ssim    = pcs->ppcs->luma_ssim;
+            output_stream_ptr->cr_ssim      = pcs->ppcs->cr_ssim;
+            output_stream_ptr->cb_ssim      = pcs->ppcs->cb_ssim;
+            output_stream_ptr->luma_ms_ssim = pcs->ppcs->luma_ms_ssim;
         } else {
-            output_stream_ptr->luma_sse  = 0;
-            output_stream_ptr->cr_sse    = 0;
-            output_stream_ptr->cb_sse    = 0;
-            output_stream_ptr->luma_ssim = 0;
-            output_stream_ptr->cr_ssim   = 0;
-            output_stream_ptr->cb_ssim   = 0;
+            output_stream_ptr->luma_sse     = 0;
+            output_stream_ptr->cr_sse       = 0;
+            output_stream_ptr->cb_sse       = 0;
+            output_stream_ptr->luma_ssim    = 0;
+            output_stream_ptr->cr_ssim      = 0;
+            output_stream_ptr->cb_ssim      = 0;
+            output_stream_ptr->luma_ms_ssim = 0;
         }
 
         // Get Empty Rate Control Input Tasks
@@ -899,7 +915,7 @@ void *svt_aom_packetization_kernel(void *input_ptr) {
         // Post Rate Control Task. Be done after postig to PM as RC might release ppcs
         svt_post_full_object(rate_control_tasks_wrapper_ptr);
         if (pcs->ppcs->frm_hdr.allow_intrabc)
-            svt_av1_hash_table_destroy(&pcs->hash_table);
+            svt_av1_hash_table_release_entries(&pcs->hash_table);
         svt_release_object(pcs->ppcs->enc_dec_ptr->enc_dec_wrapper); // Child
         // Release the Parent PCS then the Child PCS
         assert(entropy_coding_results_ptr->pcs_wrapper->live_count == 1);
@@ -301,8 +301,6 @@ static void palette_rd_y(PaletteInfo *palette_info, uint8_t *palette_size_array,
     extend_palette_color_map(color_map, cols, rows, block_width, block_height);
 }
 
-int svt_av1_count_colors(const uint8_t *src, int stride, int rows, int cols, int *val_count);
-int svt_av1_count_colors_highbd(uint16_t *src, int stride, int rows, int cols, int bit_depth, int *val_count);
 /****************************************
    determine all palette luma candidates
  ****************************************/
@@ -111,6 +111,9 @@ EbErrorType svt_aom_me_sb_results_ctor(MeSbResults *obj_ptr, PictureControlSetIn
             : MAX_SB64_PU_COUNT_NO_8X8
         : MAX_SB64_PU_COUNT_WO_16X16;
 
+    obj_ptr->pu_count   = number_of_pus;
+    obj_ptr->mv_count   = max_ref_to_alloc;
+    obj_ptr->cand_count = max_cand_to_alloc;
     EB_MALLOC_ARRAY(obj_ptr->me_mv_array, number_of_pus * max_ref_to_alloc);
     EB_MALLOC_ARRAY(obj_ptr->me_candidate_array, number_of_pus * max_cand_to_alloc);
 
@@ -475,7 +478,10 @@ static EbErrorType picture_control_set_ctor(PictureControlSet *object_ptr, EbPtr
 
     object_ptr->dctor = picture_control_set_dctor;
 
-    object_ptr->hash_table.p_lookup_table = NULL;
+    object_ptr->hash_table.buckets     = NULL;
+    object_ptr->hash_table.entries     = NULL;
+    object_ptr->hash_table.max_buckets = 0;
+    object_ptr->hash_table.max_entries = 0;
 
     // Init Picture Init data
     uint16_t padding = init_data_ptr->sb_size + 32;
@@ -1048,24 +1054,9 @@ static EbErrorType picture_control_set_ctor(PictureControlSet *object_ptr, EbPtr
                     all_sb * (init_data_ptr->sb_size >> MI_SIZE_LOG2) * (init_data_ptr->sb_size >> MI_SIZE_LOG2));
 
     // If NSQ is allowed, then need a 4x4 MI grid because 8x8 NSQ shapes will require 4x4 granularity
-    bool disallow_4x4 = true;
-    for (uint8_t is_base = 0; is_base <= 1; is_base++) {
-        for (uint8_t is_islice = 0; is_islice <= 1; is_islice++) {
-            for (uint8_t coeff_lvl = 0; coeff_lvl <= HIGH_LVL + 1; coeff_lvl++) {
-                if (!disallow_4x4)
-                    break;
-                disallow_4x4 = MIN(
-                    disallow_4x4,
-                    (svt_aom_get_nsq_geom_level(init_data_ptr->enc_mode, is_base, coeff_lvl) == 0 ? 1 : 0));
-            }
-        }
-    }
-
-    for (uint8_t is_islice = 0; is_islice <= 1; is_islice++) {
-        for (uint8_t is_base = 0; is_base <= 1; is_base++) {
-            disallow_4x4 = MIN(disallow_4x4, svt_aom_get_disallow_4x4(init_data_ptr->enc_mode, is_base));
-        }
-    }
+    bool disallow_nsq, disallow_4x4;
+    svt_aom_get_sb_block_limits(init_data_ptr->enc_mode, &disallow_nsq, &disallow_4x4);
+    disallow_4x4 = disallow_4x4 && disallow_nsq;
 
     object_ptr->disallow_4x4_all_frames = disallow_4x4;
 
@@ -1153,6 +1144,7 @@ static void picture_parent_control_set_dctor(EbPtr ptr) {
     EB_FREE_ARRAY(obj->me_8x8_distortion);
 
     EB_FREE_ARRAY(obj->me_8x8_cost_variance);
+    for (int slot = 0; slot < ME_CACHE_SLOTS; slot++) EB_FREE_ARRAY(obj->me_cache[slot].data);
     if (obj->av1_cm) {
         EB_FREE_ARRAY(obj->av1_cm->frame_to_show);
         if (obj->av1_cm->rst_frame.buffer_alloc_sz) {
@@ -1698,3 +1690,112 @@ EbErrorType svt_aom_me_creator(EbPtr *object_dbl_ptr, EbPtr object_init_data_ptr
 
     return EB_ErrorNone;
 }
+
+static size_t me_cache_copy_field(uint8_t *data, size_t offset, void *field, size_t bytes, Bool to_cache) {
+    if (data) {
+        if (to_cache)
+            memcpy(data + offset, field, bytes);
+        else
+            memcpy(field, data + offset, bytes);
+    }
+    return offset + bytes;
+}
+/* Copies the ME output of the picture to or from the data of a cache entry. With
+ * no data only the size the entry needs is returned. */
+static size_t me_cache_copy(PictureParentControlSet *pcs, uint8_t *data, Bool to_cache) {
+    const uint16_t b64_cnt = pcs->b64_total_count;
+    size_t         offset  = 0;
+    for (uint16_t b64_idx = 0; b64_idx < b64_cnt; b64_idx++) {
+        MeSbResults *res = pcs->pa_me_data->me_results[b64_idx];
+        offset           = me_cache_copy_field(data, offset, res->total_me_candidate_index, res->pu_count, to_cache);
+        offset           = me_cache_copy_field(
+            data, offset, res->me_mv_array, sizeof(*res->me_mv_array) * res->pu_count * res->mv_count, to_cache);
+        offset = me_cache_copy_field(data,
+                                     offset,
+                                     res->me_candidate_array,
+                                     sizeof(*res->me_candidate_array) * res->pu_count * res->cand_count,
+                                     to_cache);
+    }
+    const size_t dist_bytes = sizeof(uint32_t) * b64_cnt;
+    offset                  = me_cache_copy_field(data, offset, pcs->rc_me_distortion, dist_bytes, to_cache);
+    offset                  = me_cache_copy_field(data, offset, pcs->me_8x8_cost_variance, dist_bytes, to_cache);
+    offset                  = me_cache_copy_field(data, offset, pcs->me_64x64_distortion, dist_bytes, to_cache);
+    offset                  = me_cache_copy_field(data, offset, pcs->me_32x32_distortion, dist_bytes, to_cache);
+    offset                  = me_cache_copy_field(data, offset, pcs->me_16x16_distortion, dist_bytes, to_cache);
+    offset                  = me_cache_copy_field(data, offset, pcs->me_8x8_distortion, dist_bytes, to_cache);
+    offset = me_cache_copy_field(data, offset, pcs->stationary_block_present_sb, b64_cnt, to_cache);
+    offset = me_cache_copy_field(data, offset, pcs->rc_me_allow_gm, b64_cnt, to_cache);
+    return offset;
+}
+/* Keeps the ME output of the picture at its current scaling in the given slot,
+ * replacing what the slot held. The cache is best effort: nothing is kept when
+ * the allocation fails. */
+void svt_aom_me_cache_store(PictureParentControlSet *pcs, int slot) {
+    EncodeContext *enc_ctx = pcs->scs->enc_ctx;
+    MeCacheEntry  *entry   = &pcs->me_cache[slot];
+    const size_t   size    = me_cache_copy(pcs, NULL, TRUE);
+    const size_t   prev    = entry->size;
+    if (entry->size != size) {
+        EB_FREE_ARRAY(entry->data);
+        entry->size = 0;
+        EB_NO_THROW_MALLOC(entry->data, size);
+        if (entry->data)
+            entry->size = size;
+    }
+    entry->valid = entry->data != NULL;
+    if (entry->valid) {
+        me_cache_copy(pcs, entry->data, TRUE);
+        entry->superres_denom  = pcs->superres_denom;
+        entry->resize_denom    = pcs->resize_denom;
+        entry->b64_total_count = pcs->b64_total_count;
+        memcpy(entry->is_global_motion, pcs->is_global_motion, sizeof(entry->is_global_motion));
+        memcpy(entry->global_motion, pcs->svt_aom_global_motion_estimation, sizeof(entry->global_motion));
+        entry->is_gm_on            = pcs->is_gm_on;
+        entry->gm_downsample_level = pcs->gm_downsample_level;
+    }
+    svt_block_on_mutex(enc_ctx->me_cache_mutex);
+    enc_ctx->me_cache_bytes += entry->size;
+    enc_ctx->me_cache_bytes -= prev;
+    enc_ctx->me_cache_stats.peak_bytes = MAX(enc_ctx->me_cache_stats.peak_bytes, enc_ctx->me_cache_bytes);
+    svt_release_mutex(enc_ctx->me_cache_mutex);
+}
+/* Restores the ME output searched at the current scaling of the picture, if a
+ * slot holds it, and counts the lookup as a hit or a miss. */
+Bool svt_aom_me_cache_restore(PictureParentControlSet *pcs) {
+    EncodeContext *enc_ctx = pcs->scs->enc_ctx;
+    Bool           hit     = FALSE;
+    for (int slot = 0; slot < ME_CACHE_SLOTS && !hit; slot++) {
+        MeCacheEntry *entry = &pcs->me_cache[slot];
+        if (!entry->valid || entry->superres_denom != pcs->superres_denom ||
+            entry->resize_denom != pcs->resize_denom || entry->b64_total_count != pcs->b64_total_count)
+            continue;
+        me_cache_copy(pcs, entry->data, FALSE);
+        memcpy(pcs->is_global_motion, entry->is_global_motion, sizeof(entry->is_global_motion));
+        memcpy(pcs->svt_aom_global_motion_estimation, entry->global_motion, sizeof(entry->global_motion));
+        pcs->is_gm_on            = entry->is_gm_on;
+        pcs->gm_downsample_level = entry->gm_downsample_level;
+        hit                      = TRUE;
+    }
+    svt_block_on_mutex(enc_ctx->me_cache_mutex);
+    if (hit)
+        enc_ctx->me_cache_stats.hits++;
+    else
+        enc_ctx->me_cache_stats.misses++;
+    svt_release_mutex(enc_ctx->me_cache_mutex);
+    return hit;
+}
+void svt_aom_me_cache_release(PictureParentControlSet *pcs) {
+    EncodeContext *enc_ctx = pcs->scs->enc_ctx;
+    size_t         size    = 0;
+    for (int slot = 0; slot < ME_CACHE_SLOTS; slot++) {
+        MeCacheEntry *entry = &pcs->me_cache[slot];
+        size += entry->size;
+        EB_FREE_ARRAY(entry->data);
+        entry->size  = 0;
+        entry->valid = 0;
+    }
+    pcs->me_cache_hit = FALSE;
+    svt_block_on_mutex(enc_ctx->me_cache_mutex);
+    enc_ctx->me_cache_bytes -= size;
+    svt_release_mutex(enc_ctx->me_cache_mutex);
+}
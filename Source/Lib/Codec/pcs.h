@@ -247,6 +247,13 @@ typedef struct PictureControlSet {
     EbColorFormat    color_format;
     EncDecSegments **enc_dec_segment_ctrl;
     uint16_t         enc_dec_coded_sb_count;
+#if DEBUG_ENCDEC_PARALLEL
+    // EncDec parallel efficiency statistics
+    uint64_t enc_dec_start_time_seconds;
+    uint64_t enc_dec_start_time_u_seconds;
+    double   enc_dec_busy_time; // time spent coding the segments, summed over the threads (ms)
+    double   enc_dec_wall_time; // time from the posting of the picture to its last SB (ms)
+#endif
 
     // Entropy Process Rows
     EntropyTileInfo **ec_info;
@@ -276,6 +283,13 @@ typedef struct PictureControlSet {
     uint8_t      rest_segments_row_count;
     // flag to indicate whether the frame is extended for restoration search
     Bool rest_extend_flag[3];
+    // planes whose filter decision and application are done, out of rest_plane_count
+    uint8_t rest_plane_count;
+    uint8_t rest_planes_finished;
+    // input task of the picture parked by a plane finisher for the thread that finishes the last plane
+    EbObjectWrapper *rest_finish_task;
+    // --enable-stat-report scoring of the final recon, shared by the restoration threads
+    struct PictureMetrics *metrics;
 
     // Slice Type
     SliceType slice_type;
@@ -396,7 +410,7 @@ typedef struct PictureControlSet {
     SpeedFeatures    sf;
     SearchSiteConfig ss_cfg; // CHKN this might be a seq based
     HashTable        hash_table;
-    CRC_CALCULATOR   crc_calculator1;
+    CRC32C           crc32c;
     CRC_CALCULATOR   crc_calculator2;
 
     FRAME_CONTEXT                  *ec_ctx_array;
@@ -711,6 +725,22 @@ typedef struct DGDetectorSeg {
     // ensures that only one dynamic gop detector segment is modifying the dg detector metrics at any time
     EbHandle metrics_mutex;
 } DGDetectorSeg;
+#define ME_CACHE_SLOT_UNSCALED 0 // first pass ME, searched before the superres denom was picked
+#define ME_CACHE_SLOT_BEST 1 // ME of the coding loop with the lowest rd cost so far
+#define ME_CACHE_SLOTS 2
+// Open loop ME output of a superres recode picture, keyed by the scaling it was searched at
+typedef struct MeCacheEntry {
+    uint8_t              valid;
+    uint8_t              superres_denom;
+    uint8_t              resize_denom;
+    uint16_t             b64_total_count;
+    uint8_t             *data; // me_results followed by the per b64 ME statistics
+    size_t               size;
+    Bool                 is_global_motion[MAX_NUM_OF_REF_PIC_LIST][REF_LIST_MAX_DEPTH];
+    EbWarpedMotionParams global_motion[MAX_NUM_OF_REF_PIC_LIST][REF_LIST_MAX_DEPTH];
+    int8_t               is_gm_on;
+    GM_LEVEL             gm_downsample_level;
+} MeCacheEntry;
 // CHKN
 //  Add the concept of PictureParentControlSet which is a subset of the old PictureControlSet.
 //  It actually holds only high level Picture based control data:(GOP management,when to start a
@@ -806,6 +836,7 @@ typedef struct PictureParentControlSet {
     double                                  luma_ssim;
     double                                  cr_ssim;
     double                                  cb_ssim;
+    double                                  luma_ms_ssim;
     EbPictureBufferDesc                    *quarter_src_pic;
     EbPictureBufferDesc                    *sixteenth_src_pic;
     // Pointer array for down scaled pictures
@@ -1045,6 +1076,9 @@ typedef struct PictureParentControlSet {
     int32_t superres_total_recode_loop; // how many loops to run, set to 2 in dual search mode
     uint8_t superres_denom_array[NUM_SR_SCALES + 1]; // denom candidate array used in auto supreres
     double  superres_rdcost[NUM_SR_SCALES + 1]; // 9 slots, for denom 8 ~ 16
+    // ME of the coding loops, reused when a later loop searches at the same scaling
+    MeCacheEntry me_cache[ME_CACHE_SLOTS];
+    Bool         me_cache_hit; // the pending re-ME task is served by me_cache
 
     EbObjectWrapper      *me_data_wrapper;
     MotionEstimationData *pa_me_data;
@@ -1255,6 +1289,9 @@ EbErrorType me_update_param(MotionEstimationData *me_data, struct SequenceContro
 EbErrorType recon_coef_update_param(EncDecSet *recon_coef, struct SequenceControlSet *scs);
 extern Bool svt_aom_is_pic_skipped(PictureParentControlSet *pcs);
 void svt_aom_get_gm_needed_resolutions(uint8_t ds_lvl, bool *gm_need_full, bool *gm_need_quart, bool *gm_need_sixteen);
+void svt_aom_me_cache_store(PictureParentControlSet *pcs, int slot);
+Bool svt_aom_me_cache_restore(PictureParentControlSet *pcs);
+void svt_aom_me_cache_release(PictureParentControlSet *pcs);
 #ifdef __cplusplus
 }
 #endif
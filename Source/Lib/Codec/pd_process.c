@@ -37,6 +37,7 @@
 #include "aom_dsp_rtcd.h"
 
 #include "pic_operators.h"
+#include "svt_trace.h"
 /************************************************
  * Defines
  ************************************************/
@@ -2698,7 +2699,8 @@ static void  av1_generate_rps_info(
         // Pre processing operations performed on the input picture
         svt_aom_picture_pre_processing_operations(
             pcs,
-            scs);
+            scs,
+            NULL);
 
         if (input_pic->color_format >= EB_YUV422) {
             // Jing: Do the conversion of 422/444=>420 here since it's multi-threaded kernel
@@ -3372,7 +3374,48 @@ static void low_delay_release_tf_pictures(
 }
 
 /*
-  Performs Motion Compensated Temporal Filtering in ME process
+  Returns TRUE if the widest TF window pcs could get overlaps the window of a picture that is still
+  being filtered. Windows are runs of consecutive pictures, so the check is done on picture numbers.
+*/
+static Bool tf_window_overlaps_pending(PictureParentControlSet *pcs, PictureDecisionContext *pd_ctx) {
+    const uint64_t lo = pcs->picture_number - MIN(pcs->picture_number, pcs->tf_ctrls.max_num_past_pics);
+    const uint64_t hi = pcs->picture_number + pcs->tf_ctrls.max_num_future_pics;
+    for (uint32_t pic_it = 0; pic_it < pd_ctx->tf_pending_cnt; pic_it++) {
+        PictureParentControlSet *pending = pd_ctx->tf_pending_array[pic_it];
+        for (int i = 0; i < pending->past_altref_nframes + pending->future_altref_nframes + 1; i++) {
+            PictureParentControlSet *pcs_itr = pending->temp_filt_pcs_list[i];
+            if (pcs_itr && pcs_itr->picture_number >= lo && pcs_itr->picture_number <= hi)
+                return TRUE;
+        }
+    }
+    return FALSE;
+}
+/*
+  Waits for the pending TF pictures in posting (display) order; every picture sent afterwards
+  inherits the motion direction of the last one.
+*/
+static void tf_wait_pending_pictures(PictureDecisionContext *pd_ctx) {
+    for (uint32_t pic_it = 0; pic_it < pd_ctx->tf_pending_cnt; pic_it++) {
+        PictureParentControlSet *pcs = pd_ctx->tf_pending_array[pic_it];
+        svt_block_on_semaphore(pcs->temp_filt_done_semaphore);
+
+        if (pcs->tf_tot_horz_blks > pcs->tf_tot_vert_blks * 6 / 4){
+            pd_ctx->tf_motion_direction = 0;
+        }
+        else  if (pcs->tf_tot_vert_blks > pcs->tf_tot_horz_blks * 6 / 4) {
+            pd_ctx->tf_motion_direction = 1;
+        }
+        else {
+            pd_ctx->tf_motion_direction = -1;
+        }
+        pd_ctx->tf_pending_array[pic_it] = NULL;
+    }
+    pd_ctx->tf_pending_cnt = 0;
+}
+/*
+  Performs Motion Compensated Temporal Filtering in ME process.
+  The segments are only posted: the filtering of pictures with disjoint windows (e.g. L1 and BASE of
+  the same mini-GOP) overlaps in the ME processes, and tf_wait_pending_pictures() collects them.
 */
 static void mctf_frame(
     SequenceControlSet      *scs,
@@ -3385,6 +3428,10 @@ static void mctf_frame(
             pcs,
             pd_ctx);
     if (pcs->tf_ctrls.enabled) {
+        // the window params read the pixels of the window, which must not be under filtering
+        if (tf_window_overlaps_pending(pcs, pd_ctx) ||
+            pd_ctx->tf_pending_cnt == (1 << MAX_TEMPORAL_LAYERS))
+            tf_wait_pending_pictures(pd_ctx);
         derive_tf_window_params(
             scs,
             scs->enc_ctx,
@@ -3416,19 +3463,13 @@ static void mctf_frame(
                 out_results->task_type = 1;
                 svt_post_full_object(out_results_wrapper);
             }
-
-            svt_block_on_semaphore(pcs->temp_filt_done_semaphore);
+            pd_ctx->tf_pending_array[pd_ctx->tf_pending_cnt++] = pcs;
         }
 
-        if (pcs->tf_tot_horz_blks > pcs->tf_tot_vert_blks * 6 / 4){
-            pd_ctx->tf_motion_direction = 0;
-        }
-        else  if (pcs->tf_tot_vert_blks > pcs->tf_tot_horz_blks * 6 / 4) {
-            pd_ctx->tf_motion_direction = 1;
-        }
-        else {
-            pd_ctx->tf_motion_direction = -1;
-        }
+        // I pictures provide filt_to_unfilt_diff to the next windows, and low delay releases the
+        // stored pictures right after filtering
+        if (pcs->slice_type == I_SLICE || scs->static_config.pred_structure != SVT_AV1_PRED_RANDOM_ACCESS)
+            tf_wait_pending_pictures(pd_ctx);
     }
     else
         pcs->do_tf = FALSE; // set temporal filtering flag OFF for current picture
@@ -4347,9 +4388,16 @@ static void process_pics(SequenceControlSet* scs, PictureDecisionContext* ctx) {
             pcs->filt_to_unfilt_diff = ctx->filt_to_unfilt_diff;
             mctf_frame(scs, pcs, ctx);
             ctx->filt_to_unfilt_diff = pcs->slice_type == I_SLICE ? pcs->filt_to_unfilt_diff : ctx->filt_to_unfilt_diff;
-            ctx->gm_pp_last_detected = pcs->gm_pp_enabled ? pcs->gm_pp_detected : ctx->gm_pp_last_detected;
         }
     }
+    tf_wait_pending_pictures(ctx);
+
+    // gm_pp_detected is set by the TF of the picture
+    for (uint32_t pic_i = 0; pic_i < mg_size; ++pic_i) {
+        pcs = ctx->mg_pictures_array_disp_order[pic_i];
+        if (svt_aom_is_delayed_intra(pcs) == FALSE)
+            ctx->gm_pp_last_detected = pcs->gm_pp_enabled ? pcs->gm_pp_detected : ctx->gm_pp_last_detected;
+    }
 
     if (ctx->prev_delayed_intra) {
         pcs = ctx->prev_delayed_intra;
@@ -4549,6 +4597,7 @@ void* svt_aom_picture_decision_kernel(void *input_ptr) {
         pcs = (PictureParentControlSet*)in_results_ptr->pcs_wrapper->object_ptr;
         scs = pcs->scs;
         enc_ctx = (EncodeContext*)scs->enc_ctx;
+        SVT_TRACE_BEGIN("picture_decision", pcs->picture_number, -1);
 
         // Input Picture Analysis Results into the Picture Decision Reordering Queue
         // Since the prior Picture Analysis processes stage is multithreaded, inputs to the Picture Decision Process
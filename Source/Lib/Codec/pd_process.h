@@ -28,7 +28,8 @@ void svt_aom_pad_picture_to_multiple_of_min_blk_size_dimensions(SequenceControlS
                                                                 EbPictureBufferDesc *input_pic);
 void svt_aom_pad_picture_to_multiple_of_min_blk_size_dimensions_16bit(SequenceControlSet  *scs,
                                                                       EbPictureBufferDesc *input_pic);
-void svt_aom_picture_pre_processing_operations(PictureParentControlSet *pcs, SequenceControlSet *scs);
+void svt_aom_picture_pre_processing_operations(PictureParentControlSet *pcs, SequenceControlSet *scs,
+                                               struct SegmentDispatch *dispatch);
 void svt_aom_pad_picture_to_multiple_of_sb_dimensions(EbPictureBufferDesc *input_padded_pic);
 void svt_aom_gathering_picture_statistics(SequenceControlSet *scs, PictureParentControlSet *pcs,
                                           EbPictureBufferDesc *input_padded_pic,
@@ -102,6 +103,8 @@ typedef struct PictureDecisionContext {
     uint8_t                  tf_level;
     uint32_t                 tf_pic_arr_cnt;
     PictureParentControlSet *tf_pic_array[1 << MAX_TEMPORAL_LAYERS];
+    uint32_t                 tf_pending_cnt;
+    PictureParentControlSet *tf_pending_array[1 << MAX_TEMPORAL_LAYERS]; // TF posted, not yet waited on
     PictureParentControlSet *mg_pictures_array[1 << MAX_TEMPORAL_LAYERS];
     PictureParentControlSet *prev_delayed_intra; //Key frame or I of LDP short MG
     uint32_t                 mg_size; //number of active pictures in above array
@@ -29,21 +29,28 @@
 #include "pic_operators.h"
 #include "resize.h"
 #include "av1me.h"
+#include "svt_trace.h"
+#include "segment_workers.h"
 
 #define VARIANCE_PRECISION 16
 
+// minimum number of block rows given to one denoise segment
+#define DENOISE_MIN_SEGMENT_ROWS 2
+
 /**************************************
  * Context
  **************************************/
 typedef struct PictureAnalysisContext {
     EB_ALIGN(64) uint8_t local_cache[64];
-    EbFifo *resource_coordination_results_input_fifo_ptr;
-    EbFifo *picture_analysis_results_output_fifo_ptr;
+    EbFifo         *resource_coordination_results_input_fifo_ptr;
+    EbFifo         *picture_analysis_results_output_fifo_ptr;
+    SegmentDispatch denoise_dispatch;
 } PictureAnalysisContext;
 
 static void picture_analysis_context_dctor(EbPtr p) {
     EbThreadContext        *thread_ctx = (EbThreadContext *)p;
     PictureAnalysisContext *obj        = (PictureAnalysisContext *)thread_ctx->priv;
+    svt_aom_segment_dispatch_deinit(&obj->denoise_dispatch);
     EB_FREE_ARRAY(obj);
 }
 /************************************************
@@ -60,8 +67,27 @@ EbErrorType svt_aom_picture_analysis_context_ctor(EbThreadContext *thread_ctx, c
         enc_handle_ptr->resource_coordination_results_resource_ptr, index);
     pa_ctx->picture_analysis_results_output_fifo_ptr = svt_system_resource_get_producer_fifo(
         enc_handle_ptr->picture_analysis_results_resource_ptr, index);
-    return EB_ErrorNone;
+
+    // The picture analysis thread denoises the first band of each pass, the workers the others
+    return svt_aom_segment_dispatch_init(
+        &pa_ctx->denoise_dispatch, enc_handle_ptr->denoise_workers, index, DENOISE_MAX_SEGMENTS);
+}
+
+static void wiener_denoise_segment(void *job, uint16_t segment_index, uint16_t segment_count) {
+    svt_aom_wiener_denoise_segment((struct WienerDenoiseJob *)job, segment_index, segment_count);
+}
+
+/*
+ * Runs one pass of the Wiener denoiser with the block rows split in bands
+ * denoised in parallel. Bands write disjoint rows of the result, so the output
+ * is identical to the single threaded pass.
+ */
+void svt_aom_wiener_denoise_rows_mt(SegmentDispatch *dispatch, struct WienerDenoiseJob *job, int32_t row_count) {
+    const uint16_t seg_count = (uint16_t)MAX(
+        1, MIN(dispatch->max_segment_count, row_count / DENOISE_MIN_SEGMENT_ROWS));
+    svt_aom_segment_dispatch_run(dispatch, seg_count, wiener_denoise_segment, job);
 }
+
 void svt_aom_down_sample_chroma(EbPictureBufferDesc *input_pic, EbPictureBufferDesc *outputPicturePtr) {
     uint32_t       input_color_format  = input_pic->color_format;
     const uint16_t input_subsampling_x = (input_color_format == EB_YUV444 ? 1 : 2) - 1;
@@ -300,6 +326,35 @@ void svt_compute_interm_var_four8x8_c(uint8_t *input_samples, uint16_t input_str
         input_samples + block_index, input_stride, 8, 8);
 }
 
+/*******************************************
+ * svt_compute_mean_8x8_64x64_c
+ *   computes the mean and the mean of squared values of the 64 8x8 blocks of a
+ *   64x64 block in raster order; when subsample is set only the even rows are used
+ *******************************************/
+void svt_compute_mean_8x8_64x64_c(uint8_t *input_samples, uint32_t input_stride, Bool subsample,
+                                  uint64_t *mean_of8x8_blocks, uint64_t *mean_of_squared8x8_blocks) {
+    const uint32_t step = subsample ? 2 : 1;
+    // Full: (sum << (VARIANCE_PRECISION >> 1)) / 64, subsampled: (sum << (VARIANCE_PRECISION >> 1)) / 32
+    const uint32_t mean_shift    = (VARIANCE_PRECISION >> 1) - 6 + (step - 1);
+    const uint32_t squared_shift = VARIANCE_PRECISION - 6 + (step - 1);
+
+    for (uint32_t blk_row = 0; blk_row < 8; blk_row++) {
+        uint32_t sum[8]         = {0};
+        uint32_t squared_sum[8] = {0};
+        for (uint32_t y = 0; y < 8; y += step) {
+            const uint8_t *src = input_samples + (blk_row * 8 + y) * input_stride;
+            for (uint32_t x = 0; x < 64; x++) {
+                sum[x >> 3] += src[x];
+                squared_sum[x >> 3] += src[x] * src[x];
+            }
+        }
+        for (uint32_t blk_col = 0; blk_col < 8; blk_col++) {
+            mean_of8x8_blocks[blk_row * 8 + blk_col]         = (uint64_t)sum[blk_col] << mean_shift;
+            mean_of_squared8x8_blocks[blk_row * 8 + blk_col] = (uint64_t)squared_sum[blk_col] << squared_shift;
+        }
+    }
+}
+
 /*******************************************
 * compute_block_mean_compute_variance
 *   computes the variance and the block mean of all CUs inside the tree block
@@ -313,8 +368,6 @@ static EbErrorType compute_block_mean_compute_variance(
 {
     EbErrorType return_error = EB_ErrorNone;
 
-    uint32_t block_index;
-
     uint64_t mean_of8x8_blocks[64];
     uint64_t mean_of_8x8_squared_values_blocks[64];
 
@@ -327,604 +380,12 @@ static EbErrorType compute_block_mean_compute_variance(
     uint64_t mean_of_64x64_blocks;
     uint64_t mean_of64x64_squared_values_blocks;
 
-    // (0,0)
-    block_index = input_luma_origin_index;
-    if (scs->block_mean_calc_prec == BLOCK_MEAN_PREC_FULL) {
-        mean_of8x8_blocks[0] = svt_compute_mean_8x8(
-            &(input_padded_pic->buffer_y[block_index]), input_padded_pic->stride_y, 8, 8);
-        mean_of_8x8_squared_values_blocks[0] = svt_compute_mean_square_values_8x8(
-            &(input_padded_pic->buffer_y[block_index]), input_padded_pic->stride_y, 8, 8);
-
-        // (0,1)
-        block_index          = block_index + 8;
-        mean_of8x8_blocks[1] = svt_compute_mean_8x8(
-            &(input_padded_pic->buffer_y[block_index]), input_padded_pic->stride_y, 8, 8);
-        mean_of_8x8_squared_values_blocks[1] = svt_compute_mean_square_values_8x8(
-            &(input_padded_pic->buffer_y[block_index]), input_padded_pic->stride_y, 8, 8);
-
-        // (0,2)
-        block_index          = block_index + 8;
-        mean_of8x8_blocks[2] = svt_compute_mean_8x8(
-            &(input_padded_pic->buffer_y[block_index]), input_padded_pic->stride_y, 8, 8);
-        mean_of_8x8_squared_values_blocks[2] = svt_compute_mean_square_values_8x8(
-            &(input_padded_pic->buffer_y[block_index]), input_padded_pic->stride_y, 8, 8);
-
-        // (0,3)
-        block_index          = block_index + 8;
-        mean_of8x8_blocks[3] = svt_compute_mean_8x8(
-            &(input_padded_pic->buffer_y[block_index]), input_padded_pic->stride_y, 8, 8);
-        mean_of_8x8_squared_values_blocks[3] = svt_compute_mean_square_values_8x8(
-            &(input_padded_pic->buffer_y[block_index]), input_padded_pic->stride_y, 8, 8);
-
-        // (0,4)
-        block_index          = block_index + 8;
-        mean_of8x8_blocks[4] = svt_compute_mean_8x8(
-            &(input_padded_pic->buffer_y[block_index]), input_padded_pic->stride_y, 8, 8);
-        mean_of_8x8_squared_values_blocks[4] = svt_compute_mean_square_values_8x8(
-            &(input_padded_pic->buffer_y[block_index]), input_padded_pic->stride_y, 8, 8);
-
-        // (0,5)
-        block_index          = block_index + 8;
-        mean_of8x8_blocks[5] = svt_compute_mean_8x8(
-            &(input_padded_pic->buffer_y[block_index]), input_padded_pic->stride_y, 8, 8);
-        mean_of_8x8_squared_values_blocks[5] = svt_compute_mean_square_values_8x8(
-            &(input_padded_pic->buffer_y[block_index]), input_padded_pic->stride_y, 8, 8);
-
-        // (0,6)
-        block_index          = block_index + 8;
-        mean_of8x8_blocks[6] = svt_compute_mean_8x8(
-            &(input_padded_pic->buffer_y[block_index]), input_padded_pic->stride_y, 8, 8);
-        mean_of_8x8_squared_values_blocks[6] = svt_compute_mean_square_values_8x8(
-            &(input_padded_pic->buffer_y[block_index]), input_padded_pic->stride_y, 8, 8);
-
-        // (0,7)
-        block_index          = block_index + 8;
-        mean_of8x8_blocks[7] = svt_compute_mean_8x8(
-            &(input_padded_pic->buffer_y[block_index]), input_padded_pic->stride_y, 8, 8);
-        mean_of_8x8_squared_values_blocks[7] = svt_compute_mean_square_values_8x8(
-            &(input_padded_pic->buffer_y[block_index]), input_padded_pic->stride_y, 8, 8);
-
-        // (1,0)
-        block_index          = input_luma_origin_index + (input_padded_pic->stride_y << 3);
-        mean_of8x8_blocks[8] = svt_compute_mean_8x8(
-            &(input_padded_pic->buffer_y[block_index]), input_padded_pic->stride_y, 8, 8);
-        mean_of_8x8_squared_values_blocks[8] = svt_compute_mean_square_values_8x8(
-            &(input_padded_pic->buffer_y[block_index]), input_padded_pic->stride_y, 8, 8);
-
-        // (1,1)
-        block_index          = block_index + 8;
-        mean_of8x8_blocks[9] = svt_compute_mean_8x8(
-            &(input_padded_pic->buffer_y[block_index]), input_padded_pic->stride_y, 8, 8);
-        mean_of_8x8_squared_values_blocks[9] = svt_compute_mean_square_values_8x8(
-            &(input_padded_pic->buffer_y[block_index]), input_padded_pic->stride_y, 8, 8);
-
-        // (1,2)
-        block_index           = block_index + 8;
-        mean_of8x8_blocks[10] = svt_compute_mean_8x8(
-            &(input_padded_pic->buffer_y[block_index]), input_padded_pic->stride_y, 8, 8);
-        mean_of_8x8_squared_values_blocks[10] = svt_compute_mean_square_values_8x8(
-            &(input_padded_pic->buffer_y[block_index]), input_padded_pic->stride_y, 8, 8);
-
-        // (1,3)
-        block_index           = block_index + 8;
-        mean_of8x8_blocks[11] = svt_compute_mean_8x8(
-            &(input_padded_pic->buffer_y[block_index]), input_padded_pic->stride_y, 8, 8);
-        mean_of_8x8_squared_values_blocks[11] = svt_compute_mean_square_values_8x8(
-            &(input_padded_pic->buffer_y[block_index]), input_padded_pic->stride_y, 8, 8);
-
-        // (1,4)
-        block_index           = block_index + 8;
-        mean_of8x8_blocks[12] = svt_compute_mean_8x8(
-            &(input_padded_pic->buffer_y[block_index]), input_padded_pic->stride_y, 8, 8);
-        mean_of_8x8_squared_values_blocks[12] = svt_compute_mean_square_values_8x8(
-            &(input_padded_pic->buffer_y[block_index]), input_padded_pic->stride_y, 8, 8);
-
-        // (1,5)
-        block_index           = block_index + 8;
-        mean_of8x8_blocks[13] = svt_compute_mean_8x8(
-            &(input_padded_pic->buffer_y[block_index]), input_padded_pic->stride_y, 8, 8);
-        mean_of_8x8_squared_values_blocks[13] = svt_compute_mean_square_values_8x8(
-            &(input_padded_pic->buffer_y[block_index]), input_padded_pic->stride_y, 8, 8);
-
-        // (1,6)
-        block_index           = block_index + 8;
-        mean_of8x8_blocks[14] = svt_compute_mean_8x8(
-            &(input_padded_pic->buffer_y[block_index]), input_padded_pic->stride_y, 8, 8);
-        mean_of_8x8_squared_values_blocks[14] = svt_compute_mean_square_values_8x8(
-            &(input_padded_pic->buffer_y[block_index]), input_padded_pic->stride_y, 8, 8);
-
-        // (1,7)
-        block_index           = block_index + 8;
-        mean_of8x8_blocks[15] = svt_compute_mean_8x8(
-            &(input_padded_pic->buffer_y[block_index]), input_padded_pic->stride_y, 8, 8);
-        mean_of_8x8_squared_values_blocks[15] = svt_compute_mean_square_values_8x8(
-            &(input_padded_pic->buffer_y[block_index]), input_padded_pic->stride_y, 8, 8);
-
-        // (2,0)
-        block_index           = input_luma_origin_index + (input_padded_pic->stride_y << 4);
-        mean_of8x8_blocks[16] = svt_compute_mean_8x8(
-            &(input_padded_pic->buffer_y[block_index]), input_padded_pic->stride_y, 8, 8);
-        mean_of_8x8_squared_values_blocks[16] = svt_compute_mean_square_values_8x8(
-            &(input_padded_pic->buffer_y[block_index]), input_padded_pic->stride_y, 8, 8);
-
-        // (2,1)
-        block_index           = block_index + 8;
-        mean_of8x8_blocks[17] = svt_compute_mean_8x8(
-            &(input_padded_pic->buffer_y[block_index]), input_padded_pic->stride_y, 8, 8);
-        mean_of_8x8_squared_values_blocks[17] = svt_compute_mean_square_values_8x8(
-            &(input_padded_pic->buffer_y[block_index]), input_padded_pic->stride_y, 8, 8);
-
-        // (2,2)
-        block_index           = block_index + 8;
-        mean_of8x8_blocks[18] = svt_compute_mean_8x8(
-            &(input_padded_pic->buffer_y[block_index]), input_padded_pic->stride_y, 8, 8);
-        mean_of_8x8_squared_values_blocks[18] = svt_compute_mean_square_values_8x8(
-            &(input_padded_pic->buffer_y[block_index]), input_padded_pic->stride_y, 8, 8);
-
-        // (2,3)
-        block_index           = block_index + 8;
-        mean_of8x8_blocks[19] = svt_compute_mean_8x8(
-            &(input_padded_pic->buffer_y[block_index]), input_padded_pic->stride_y, 8, 8);
-        mean_of_8x8_squared_values_blocks[19] = svt_compute_mean_square_values_8x8(
-            &(input_padded_pic->buffer_y[block_index]), input_padded_pic->stride_y, 8, 8);
-
-        /// (2,4)
-        block_index           = block_index + 8;
-        mean_of8x8_blocks[20] = svt_compute_mean_8x8(
-            &(input_padded_pic->buffer_y[block_index]), input_padded_pic->stride_y, 8, 8);
-        mean_of_8x8_squared_values_blocks[20] = svt_compute_mean_square_values_8x8(
-            &(input_padded_pic->buffer_y[block_index]), input_padded_pic->stride_y, 8, 8);
-
-        // (2,5)
-        block_index           = block_index + 8;
-        mean_of8x8_blocks[21] = svt_compute_mean_8x8(
-            &(input_padded_pic->buffer_y[block_index]), input_padded_pic->stride_y, 8, 8);
-        mean_of_8x8_squared_values_blocks[21] = svt_compute_mean_square_values_8x8(
-            &(input_padded_pic->buffer_y[block_index]), input_padded_pic->stride_y, 8, 8);
-
-        // (2,6)
-        block_index           = block_index + 8;
-        mean_of8x8_blocks[22] = svt_compute_mean_8x8(
-            &(input_padded_pic->buffer_y[block_index]), input_padded_pic->stride_y, 8, 8);
-        mean_of_8x8_squared_values_blocks[22] = svt_compute_mean_square_values_8x8(
-            &(input_padded_pic->buffer_y[block_index]), input_padded_pic->stride_y, 8, 8);
-
-        // (2,7)
-        block_index           = block_index + 8;
-        mean_of8x8_blocks[23] = svt_compute_mean_8x8(
-            &(input_padded_pic->buffer_y[block_index]), input_padded_pic->stride_y, 8, 8);
-        mean_of_8x8_squared_values_blocks[23] = svt_compute_mean_square_values_8x8(
-            &(input_padded_pic->buffer_y[block_index]), input_padded_pic->stride_y, 8, 8);
-
-        // (3,0)
-        block_index = input_luma_origin_index + (input_padded_pic->stride_y << 3) + (input_padded_pic->stride_y << 4);
-        mean_of8x8_blocks[24] = svt_compute_mean_8x8(
-            &(input_padded_pic->buffer_y[block_index]), input_padded_pic->stride_y, 8, 8);
-        mean_of_8x8_squared_values_blocks[24] = svt_compute_mean_square_values_8x8(
-            &(input_padded_pic->buffer_y[block_index]), input_padded_pic->stride_y, 8, 8);
-
-        // (3,1)
-        block_index           = block_index + 8;
-        mean_of8x8_blocks[25] = svt_compute_mean_8x8(
-            &(input_padded_pic->buffer_y[block_index]), input_padded_pic->stride_y, 8, 8);
-        mean_of_8x8_squared_values_blocks[25] = svt_compute_mean_square_values_8x8(
-            &(input_padded_pic->buffer_y[block_index]), input_padded_pic->stride_y, 8, 8);
-
-        // (3,2)
-        block_index           = block_index + 8;
-        mean_of8x8_blocks[26] = svt_compute_mean_8x8(
-            &(input_padded_pic->buffer_y[block_index]), input_padded_pic->stride_y, 8, 8);
-        mean_of_8x8_squared_values_blocks[26] = svt_compute_mean_square_values_8x8(
-            &(input_padded_pic->buffer_y[block_index]), input_padded_pic->stride_y, 8, 8);
-
-        // (3,3)
-        block_index           = block_index + 8;
-        mean_of8x8_blocks[27] = svt_compute_mean_8x8(
-            &(input_padded_pic->buffer_y[block_index]), input_padded_pic->stride_y, 8, 8);
-        mean_of_8x8_squared_values_blocks[27] = svt_compute_mean_square_values_8x8(
-            &(input_padded_pic->buffer_y[block_index]), input_padded_pic->stride_y, 8, 8);
-
-        // (3,4)
-        block_index           = block_index + 8;
-        mean_of8x8_blocks[28] = svt_compute_mean_8x8(
-            &(input_padded_pic->buffer_y[block_index]), input_padded_pic->stride_y, 8, 8);
-        mean_of_8x8_squared_values_blocks[28] = svt_compute_mean_square_values_8x8(
-            &(input_padded_pic->buffer_y[block_index]), input_padded_pic->stride_y, 8, 8);
-
-        // (3,5)
-        block_index           = block_index + 8;
-        mean_of8x8_blocks[29] = svt_compute_mean_8x8(
-            &(input_padded_pic->buffer_y[block_index]), input_padded_pic->stride_y, 8, 8);
-        mean_of_8x8_squared_values_blocks[29] = svt_compute_mean_square_values_8x8(
-            &(input_padded_pic->buffer_y[block_index]), input_padded_pic->stride_y, 8, 8);
-
-        // (3,6)
-        block_index           = block_index + 8;
-        mean_of8x8_blocks[30] = svt_compute_mean_8x8(
-            &(input_padded_pic->buffer_y[block_index]), input_padded_pic->stride_y, 8, 8);
-        mean_of_8x8_squared_values_blocks[30] = svt_compute_mean_square_values_8x8(
-            &(input_padded_pic->buffer_y[block_index]), input_padded_pic->stride_y, 8, 8);
-
-        // (3,7)
-        block_index           = block_index + 8;
-        mean_of8x8_blocks[31] = svt_compute_mean_8x8(
-            &(input_padded_pic->buffer_y[block_index]), input_padded_pic->stride_y, 8, 8);
-        mean_of_8x8_squared_values_blocks[31] = svt_compute_mean_square_values_8x8(
-            &(input_padded_pic->buffer_y[block_index]), input_padded_pic->stride_y, 8, 8);
-
-        // (4,0)
-        block_index           = input_luma_origin_index + (input_padded_pic->stride_y << 5);
-        mean_of8x8_blocks[32] = svt_compute_mean_8x8(
-            &(input_padded_pic->buffer_y[block_index]), input_padded_pic->stride_y, 8, 8);
-        mean_of_8x8_squared_values_blocks[32] = svt_compute_mean_square_values_8x8(
-            &(input_padded_pic->buffer_y[block_index]), input_padded_pic->stride_y, 8, 8);
-
-        // (4,1)
-        block_index           = block_index + 8;
-        mean_of8x8_blocks[33] = svt_compute_mean_8x8(
-            &(input_padded_pic->buffer_y[block_index]), input_padded_pic->stride_y, 8, 8);
-        mean_of_8x8_squared_values_blocks[33] = svt_compute_mean_square_values_8x8(
-            &(input_padded_pic->buffer_y[block_index]), input_padded_pic->stride_y, 8, 8);
-
-        // (4,2)
-        block_index           = block_index + 8;
-        mean_of8x8_blocks[34] = svt_compute_mean_8x8(
-            &(input_padded_pic->buffer_y[block_index]), input_padded_pic->stride_y, 8, 8);
-        mean_of_8x8_squared_values_blocks[34] = svt_compute_mean_square_values_8x8(
-            &(input_padded_pic->buffer_y[block_index]), input_padded_pic->stride_y, 8, 8);
-
-        // (4,3)
-        block_index           = block_index + 8;
-        mean_of8x8_blocks[35] = svt_compute_mean_8x8(
-            &(input_padded_pic->buffer_y[block_index]), input_padded_pic->stride_y, 8, 8);
-        mean_of_8x8_squared_values_blocks[35] = svt_compute_mean_square_values_8x8(
-            &(input_padded_pic->buffer_y[block_index]), input_padded_pic->stride_y, 8, 8);
-
-        // (4,4)
-        block_index           = block_index + 8;
-        mean_of8x8_blocks[36] = svt_compute_mean_8x8(
-            &(input_padded_pic->buffer_y[block_index]), input_padded_pic->stride_y, 8, 8);
-        mean_of_8x8_squared_values_blocks[36] = svt_compute_mean_square_values_8x8(
-            &(input_padded_pic->buffer_y[block_index]), input_padded_pic->stride_y, 8, 8);
-
-        // (4,5)
-        block_index           = block_index + 8;
-        mean_of8x8_blocks[37] = svt_compute_mean_8x8(
-            &(input_padded_pic->buffer_y[block_index]), input_padded_pic->stride_y, 8, 8);
-        mean_of_8x8_squared_values_blocks[37] = svt_compute_mean_square_values_8x8(
-            &(input_padded_pic->buffer_y[block_index]), input_padded_pic->stride_y, 8, 8);
-
-        // (4,6)
-        block_index           = block_index + 8;
-        mean_of8x8_blocks[38] = svt_compute_mean_8x8(
-            &(input_padded_pic->buffer_y[block_index]), input_padded_pic->stride_y, 8, 8);
-        mean_of_8x8_squared_values_blocks[38] = svt_compute_mean_square_values_8x8(
-            &(input_padded_pic->buffer_y[block_index]), input_padded_pic->stride_y, 8, 8);
-
-        // (4,7)
-        block_index           = block_index + 8;
-        mean_of8x8_blocks[39] = svt_compute_mean_8x8(
-            &(input_padded_pic->buffer_y[block_index]), input_padded_pic->stride_y, 8, 8);
-        mean_of_8x8_squared_values_blocks[39] = svt_compute_mean_square_values_8x8(
-            &(input_padded_pic->buffer_y[block_index]), input_padded_pic->stride_y, 8, 8);
-
-        // (5,0)
-        block_index = input_luma_origin_index + (input_padded_pic->stride_y << 3) + (input_padded_pic->stride_y << 5);
-        mean_of8x8_blocks[40] = svt_compute_mean_8x8(
-            &(input_padded_pic->buffer_y[block_index]), input_padded_pic->stride_y, 8, 8);
-        mean_of_8x8_squared_values_blocks[40] = svt_compute_mean_square_values_8x8(
-            &(input_padded_pic->buffer_y[block_index]), input_padded_pic->stride_y, 8, 8);
-
-        // (5,1)
-        block_index           = block_index + 8;
-        mean_of8x8_blocks[41] = svt_compute_mean_8x8(
-            &(input_padded_pic->buffer_y[block_index]), input_padded_pic->stride_y, 8, 8);
-        mean_of_8x8_squared_values_blocks[41] = svt_compute_mean_square_values_8x8(
-            &(input_padded_pic->buffer_y[block_index]), input_padded_pic->stride_y, 8, 8);
-
-        // (5,2)
-        block_index           = block_index + 8;
-        mean_of8x8_blocks[42] = svt_compute_mean_8x8(
-            &(input_padded_pic->buffer_y[block_index]), input_padded_pic->stride_y, 8, 8);
-        mean_of_8x8_squared_values_blocks[42] = svt_compute_mean_square_values_8x8(
-            &(input_padded_pic->buffer_y[block_index]), input_padded_pic->stride_y, 8, 8);
-
-        // (5,3)
-        block_index           = block_index + 8;
-        mean_of8x8_blocks[43] = svt_compute_mean_8x8(
-            &(input_padded_pic->buffer_y[block_index]), input_padded_pic->stride_y, 8, 8);
-        mean_of_8x8_squared_values_blocks[43] = svt_compute_mean_square_values_8x8(
-            &(input_padded_pic->buffer_y[block_index]), input_padded_pic->stride_y, 8, 8);
-
-        // (5,4)
-        block_index           = block_index + 8;
-        mean_of8x8_blocks[44] = svt_compute_mean_8x8(
-            &(input_padded_pic->buffer_y[block_index]), input_padded_pic->stride_y, 8, 8);
-        mean_of_8x8_squared_values_blocks[44] = svt_compute_mean_square_values_8x8(
-            &(input_padded_pic->buffer_y[block_index]), input_padded_pic->stride_y, 8, 8);
-
-        // (5,5)
-        block_index           = block_index + 8;
-        mean_of8x8_blocks[45] = svt_compute_mean_8x8(
-            &(input_padded_pic->buffer_y[block_index]), input_padded_pic->stride_y, 8, 8);
-        mean_of_8x8_squared_values_blocks[45] = svt_compute_mean_square_values_8x8(
-            &(input_padded_pic->buffer_y[block_index]), input_padded_pic->stride_y, 8, 8);
-
-        // (5,6)
-        block_index           = block_index + 8;
-        mean_of8x8_blocks[46] = svt_compute_mean_8x8(
-            &(input_padded_pic->buffer_y[block_index]), input_padded_pic->stride_y, 8, 8);
-        mean_of_8x8_squared_values_blocks[46] = svt_compute_mean_square_values_8x8(
-            &(input_padded_pic->buffer_y[block_index]), input_padded_pic->stride_y, 8, 8);
-
-        // (5,7)
-        block_index           = block_index + 8;
-        mean_of8x8_blocks[47] = svt_compute_mean_8x8(
-            &(input_padded_pic->buffer_y[block_index]), input_padded_pic->stride_y, 8, 8);
-        mean_of_8x8_squared_values_blocks[47] = svt_compute_mean_square_values_8x8(
-            &(input_padded_pic->buffer_y[block_index]), input_padded_pic->stride_y, 8, 8);
-
-        // (6,0)
-        block_index = input_luma_origin_index + (input_padded_pic->stride_y << 4) + (input_padded_pic->stride_y << 5);
-        mean_of8x8_blocks[48] = svt_compute_mean_8x8(
-            &(input_padded_pic->buffer_y[block_index]), input_padded_pic->stride_y, 8, 8);
-        mean_of_8x8_squared_values_blocks[48] = svt_compute_mean_square_values_8x8(
-            &(input_padded_pic->buffer_y[block_index]), input_padded_pic->stride_y, 8, 8);
-
-        // (6,1)
-        block_index           = block_index + 8;
-        mean_of8x8_blocks[49] = svt_compute_mean_8x8(
-            &(input_padded_pic->buffer_y[block_index]), input_padded_pic->stride_y, 8, 8);
-        mean_of_8x8_squared_values_blocks[49] = svt_compute_mean_square_values_8x8(
-            &(input_padded_pic->buffer_y[block_index]), input_padded_pic->stride_y, 8, 8);
-
-        // (6,2)
-        block_index           = block_index + 8;
-        mean_of8x8_blocks[50] = svt_compute_mean_8x8(
-            &(input_padded_pic->buffer_y[block_index]), input_padded_pic->stride_y, 8, 8);
-        mean_of_8x8_squared_values_blocks[50] = svt_compute_mean_square_values_8x8(
-            &(input_padded_pic->buffer_y[block_index]), input_padded_pic->stride_y, 8, 8);
-
-        // (6,3)
-        block_index           = block_index + 8;
-        mean_of8x8_blocks[51] = svt_compute_mean_8x8(
-            &(input_padded_pic->buffer_y[block_index]), input_padded_pic->stride_y, 8, 8);
-        mean_of_8x8_squared_values_blocks[51] = svt_compute_mean_square_values_8x8(
-            &(input_padded_pic->buffer_y[block_index]), input_padded_pic->stride_y, 8, 8);
-
-        // (6,4)
-        block_index           = block_index + 8;
-        mean_of8x8_blocks[52] = svt_compute_mean_8x8(
-            &(input_padded_pic->buffer_y[block_index]), input_padded_pic->stride_y, 8, 8);
-        mean_of_8x8_squared_values_blocks[52] = svt_compute_mean_square_values_8x8(
-            &(input_padded_pic->buffer_y[block_index]), input_padded_pic->stride_y, 8, 8);
-
-        // (6,5)
-        block_index           = block_index + 8;
-        mean_of8x8_blocks[53] = svt_compute_mean_8x8(
-            &(input_padded_pic->buffer_y[block_index]), input_padded_pic->stride_y, 8, 8);
-        mean_of_8x8_squared_values_blocks[53] = svt_compute_mean_square_values_8x8(
-            &(input_padded_pic->buffer_y[block_index]), input_padded_pic->stride_y, 8, 8);
-
-        // (6,6)
-        block_index           = block_index + 8;
-        mean_of8x8_blocks[54] = svt_compute_mean_8x8(
-            &(input_padded_pic->buffer_y[block_index]), input_padded_pic->stride_y, 8, 8);
-        mean_of_8x8_squared_values_blocks[54] = svt_compute_mean_square_values_8x8(
-            &(input_padded_pic->buffer_y[block_index]), input_padded_pic->stride_y, 8, 8);
-
-        // (6,7)
-        block_index           = block_index + 8;
-        mean_of8x8_blocks[55] = svt_compute_mean_8x8(
-            &(input_padded_pic->buffer_y[block_index]), input_padded_pic->stride_y, 8, 8);
-        mean_of_8x8_squared_values_blocks[55] = svt_compute_mean_square_values_8x8(
-            &(input_padded_pic->buffer_y[block_index]), input_padded_pic->stride_y, 8, 8);
-
-        // (7,0)
-        block_index = input_luma_origin_index + (input_padded_pic->stride_y << 3) + (input_padded_pic->stride_y << 4) +
-            (input_padded_pic->stride_y << 5);
-        mean_of8x8_blocks[56] = svt_compute_mean_8x8(
-            &(input_padded_pic->buffer_y[block_index]), input_padded_pic->stride_y, 8, 8);
-        mean_of_8x8_squared_values_blocks[56] = svt_compute_mean_square_values_8x8(
-            &(input_padded_pic->buffer_y[block_index]), input_padded_pic->stride_y, 8, 8);
-
-        // (7,1)
-        block_index           = block_index + 8;
-        mean_of8x8_blocks[57] = svt_compute_mean_8x8(
-            &(input_padded_pic->buffer_y[block_index]), input_padded_pic->stride_y, 8, 8);
-        mean_of_8x8_squared_values_blocks[57] = svt_compute_mean_square_values_8x8(
-            &(input_padded_pic->buffer_y[block_index]), input_padded_pic->stride_y, 8, 8);
-
-        // (7,2)
-        block_index           = block_index + 8;
-        mean_of8x8_blocks[58] = svt_compute_mean_8x8(
-            &(input_padded_pic->buffer_y[block_index]), input_padded_pic->stride_y, 8, 8);
-        mean_of_8x8_squared_values_blocks[58] = svt_compute_mean_square_values_8x8(
-            &(input_padded_pic->buffer_y[block_index]), input_padded_pic->stride_y, 8, 8);
-
-        // (7,3)
-        block_index           = block_index + 8;
-        mean_of8x8_blocks[59] = svt_compute_mean_8x8(
-            &(input_padded_pic->buffer_y[block_index]), input_padded_pic->stride_y, 8, 8);
-        mean_of_8x8_squared_values_blocks[59] = svt_compute_mean_square_values_8x8(
-            &(input_padded_pic->buffer_y[block_index]), input_padded_pic->stride_y, 8, 8);
-
-        // (7,4)
-        block_index           = block_index + 8;
-        mean_of8x8_blocks[60] = svt_compute_mean_8x8(
-            &(input_padded_pic->buffer_y[block_index]), input_padded_pic->stride_y, 8, 8);
-        mean_of_8x8_squared_values_blocks[60] = svt_compute_mean_square_values_8x8(
-            &(input_padded_pic->buffer_y[block_index]), input_padded_pic->stride_y, 8, 8);
-
-        // (7,5)
-        block_index           = block_index + 8;
-        mean_of8x8_blocks[61] = svt_compute_mean_8x8(
-            &(input_padded_pic->buffer_y[block_index]), input_padded_pic->stride_y, 8, 8);
-        mean_of_8x8_squared_values_blocks[61] = svt_compute_mean_square_values_8x8(
-            &(input_padded_pic->buffer_y[block_index]), input_padded_pic->stride_y, 8, 8);
-
-        // (7,6)
-        block_index           = block_index + 8;
-        mean_of8x8_blocks[62] = svt_compute_mean_8x8(
-            &(input_padded_pic->buffer_y[block_index]), input_padded_pic->stride_y, 8, 8);
-        mean_of_8x8_squared_values_blocks[62] = svt_compute_mean_square_values_8x8(
-            &(input_padded_pic->buffer_y[block_index]), input_padded_pic->stride_y, 8, 8);
-
-        // (7,7)
-        block_index           = block_index + 8;
-        mean_of8x8_blocks[63] = svt_compute_mean_8x8(
-            &(input_padded_pic->buffer_y[block_index]), input_padded_pic->stride_y, 8, 8);
-        mean_of_8x8_squared_values_blocks[63] = svt_compute_mean_square_values_8x8(
-            &(input_padded_pic->buffer_y[block_index]), input_padded_pic->stride_y, 8, 8);
-    } else {
-        const uint16_t stride_y = input_padded_pic->stride_y;
-
-        svt_compute_interm_var_four8x8(&(input_padded_pic->buffer_y[block_index]),
-                                       stride_y,
-                                       &mean_of8x8_blocks[0],
-                                       &mean_of_8x8_squared_values_blocks[0]);
-
-        // (0,1)
-        block_index = block_index + 32;
-
-        svt_compute_interm_var_four8x8(&(input_padded_pic->buffer_y[block_index]),
-                                       stride_y,
-                                       &mean_of8x8_blocks[4],
-                                       &mean_of_8x8_squared_values_blocks[4]);
-
-        // (0,5)
-        block_index = block_index + 24;
-
-        // (1,0)
-        block_index = input_luma_origin_index + (stride_y << 3);
-
-        svt_compute_interm_var_four8x8(&(input_padded_pic->buffer_y[block_index]),
-                                       stride_y,
-                                       &mean_of8x8_blocks[8],
-                                       &mean_of_8x8_squared_values_blocks[8]);
-
-        // (1,1)
-        block_index = block_index + 32;
-
-        svt_compute_interm_var_four8x8(&(input_padded_pic->buffer_y[block_index]),
-                                       stride_y,
-                                       &mean_of8x8_blocks[12],
-                                       &mean_of_8x8_squared_values_blocks[12]);
-
-        // (1,5)
-        block_index = block_index + 24;
-
-        // (2,0)
-        block_index = input_luma_origin_index + (stride_y << 4);
-
-        svt_compute_interm_var_four8x8(&(input_padded_pic->buffer_y[block_index]),
-                                       stride_y,
-                                       &mean_of8x8_blocks[16],
-                                       &mean_of_8x8_squared_values_blocks[16]);
-
-        // (2,1)
-        block_index = block_index + 32;
-
-        svt_compute_interm_var_four8x8(&(input_padded_pic->buffer_y[block_index]),
-                                       stride_y,
-                                       &mean_of8x8_blocks[20],
-                                       &mean_of_8x8_squared_values_blocks[20]);
-
-        // (2,5)
-        block_index = block_index + 24;
-
-        // (3,0)
-        block_index = input_luma_origin_index + (stride_y << 3) + (stride_y << 4);
-
-        svt_compute_interm_var_four8x8(&(input_padded_pic->buffer_y[block_index]),
-                                       stride_y,
-                                       &mean_of8x8_blocks[24],
-                                       &mean_of_8x8_squared_values_blocks[24]);
-
-        // (3,1)
-        block_index = block_index + 32;
-
-        svt_compute_interm_var_four8x8(&(input_padded_pic->buffer_y[block_index]),
-                                       stride_y,
-                                       &mean_of8x8_blocks[28],
-                                       &mean_of_8x8_squared_values_blocks[28]);
-
-        // (3,5)
-        block_index = block_index + 24;
-
-        // (4,0)
-        block_index = input_luma_origin_index + (stride_y << 5);
-
-        svt_compute_interm_var_four8x8(&(input_padded_pic->buffer_y[block_index]),
-                                       stride_y,
-                                       &mean_of8x8_blocks[32],
-                                       &mean_of_8x8_squared_values_blocks[32]);
-
-        // (4,1)
-        block_index = block_index + 32;
-
-        svt_compute_interm_var_four8x8(&(input_padded_pic->buffer_y[block_index]),
-                                       stride_y,
-                                       &mean_of8x8_blocks[36],
-                                       &mean_of_8x8_squared_values_blocks[36]);
-
-        // (4,5)
-        block_index = block_index + 24;
-
-        // (5,0)
-        block_index = input_luma_origin_index + (stride_y << 3) + (stride_y << 5);
-
-        svt_compute_interm_var_four8x8(&(input_padded_pic->buffer_y[block_index]),
-                                       stride_y,
-                                       &mean_of8x8_blocks[40],
-                                       &mean_of_8x8_squared_values_blocks[40]);
-
-        // (5,1)
-        block_index = block_index + 32;
-
-        svt_compute_interm_var_four8x8(&(input_padded_pic->buffer_y[block_index]),
-                                       stride_y,
-                                       &mean_of8x8_blocks[44],
-                                       &mean_of_8x8_squared_values_blocks[44]);
-
-        // (5,5)
-        block_index = block_index + 24;
-
-        // (6,0)
-        block_index = input_luma_origin_index + (stride_y << 4) + (stride_y << 5);
-
-        svt_compute_interm_var_four8x8(&(input_padded_pic->buffer_y[block_index]),
-                                       stride_y,
-                                       &mean_of8x8_blocks[48],
-                                       &mean_of_8x8_squared_values_blocks[48]);
-
-        // (6,1)
-        block_index = block_index + 32;
-
-        svt_compute_interm_var_four8x8(&(input_padded_pic->buffer_y[block_index]),
-                                       stride_y,
-                                       &mean_of8x8_blocks[52],
-                                       &mean_of_8x8_squared_values_blocks[52]);
-
-        // (6,5)
-        block_index = block_index + 24;
-
-        // (7,0)
-        block_index = input_luma_origin_index + (stride_y << 3) + (stride_y << 4) + (stride_y << 5);
-
-        svt_compute_interm_var_four8x8(&(input_padded_pic->buffer_y[block_index]),
-                                       stride_y,
-                                       &mean_of8x8_blocks[56],
-                                       &mean_of_8x8_squared_values_blocks[56]);
-
-        // (7,1)
-        block_index = block_index + 32;
-
-        svt_compute_interm_var_four8x8(&(input_padded_pic->buffer_y[block_index]),
-                                       stride_y,
-                                       &mean_of8x8_blocks[60],
-                                       &mean_of_8x8_squared_values_blocks[60]);
-    }
+    // 8x8 means and mean squared values of the whole SB in one pass
+    svt_compute_mean_8x8_64x64(&(input_padded_pic->buffer_y[input_luma_origin_index]),
+                               input_padded_pic->stride_y,
+                               scs->block_mean_calc_prec != BLOCK_MEAN_PREC_FULL,
+                               mean_of8x8_blocks,
+                               mean_of_8x8_squared_values_blocks);
 
     // 16x16
     mean_of_16x16_blocks[0] = (mean_of8x8_blocks[0] + mean_of8x8_blocks[1] + mean_of8x8_blocks[8] +
@@ -1381,7 +842,7 @@ static EbErrorType compute_block_mean_compute_variance(
 }
 
 static int32_t apply_denoise_2d(SequenceControlSet *scs, PictureParentControlSet *pcs,
-                                EbPictureBufferDesc *inputPicturePointer) {
+                                EbPictureBufferDesc *inputPicturePointer, SegmentDispatch *dispatch) {
     AomDenoiseAndModel     *denoise_and_model;
     DenoiseAndModelInitData fg_init_data;
     fg_init_data.encoder_bit_depth    = pcs->enhanced_pic->bit_depth;
@@ -1395,6 +856,7 @@ static int32_t apply_denoise_2d(SequenceControlSet *scs, PictureParentControlSet
     fg_init_data.denoise_apply        = scs->static_config.film_grain_denoise_apply;
     fg_init_data.adaptive_film_grain  = scs->static_config.adaptive_film_grain;
     EB_NEW(denoise_and_model, svt_aom_denoise_and_model_ctor, (EbPtr)&fg_init_data);
+    denoise_and_model->dispatch = dispatch;
 
     if (svt_aom_denoise_and_model_run(denoise_and_model,
                                       inputPicturePointer,
@@ -1406,7 +868,8 @@ static int32_t apply_denoise_2d(SequenceControlSet *scs, PictureParentControlSet
     return 0;
 }
 
-static EbErrorType denoise_estimate_film_grain(SequenceControlSet *scs, PictureParentControlSet *pcs) {
+static EbErrorType denoise_estimate_film_grain(SequenceControlSet *scs, PictureParentControlSet *pcs,
+                                               SegmentDispatch *dispatch) {
     EbErrorType return_error = EB_ErrorNone;
 
     FrameHeader *frm_hdr = &pcs->frm_hdr;
@@ -1415,7 +878,7 @@ static EbErrorType denoise_estimate_film_grain(SequenceControlSet *scs, PictureP
     frm_hdr->film_grain_params.apply_grain = 0;
 
     if (scs->static_config.film_grain_denoise_strength) {
-        if (apply_denoise_2d(scs, pcs, input_pic) < 0)
+        if (apply_denoise_2d(scs, pcs, input_pic, dispatch) < 0)
             return 1;
     }
 
@@ -1449,12 +912,15 @@ static EbErrorType apply_film_grain_table(SequenceControlSet *scs_ptr, PicturePa
  *** Operations included at this point:
  ***** Borders preprocessing
  ***** Denoising
+ *** dispatch spreads the denoising over the denoise
+ *** workers, NULL denoises on the calling thread
  ************************************************/
-void svt_aom_picture_pre_processing_operations(PictureParentControlSet *pcs, SequenceControlSet *scs) {
+void svt_aom_picture_pre_processing_operations(PictureParentControlSet *pcs, SequenceControlSet *scs,
+                                               struct SegmentDispatch *dispatch) {
     if (scs->static_config.fgs_table) {
         apply_film_grain_table(scs, pcs);
     } else if (scs->static_config.film_grain_denoise_strength) {
-        denoise_estimate_film_grain(scs, pcs);
+        denoise_estimate_film_grain(scs, pcs, dispatch);
     }
 
     return;
@@ -1807,7 +1273,7 @@ void svt_aom_pad_picture_to_multiple_of_sb_dimensions(EbPictureBufferDesc *input
     return;
 }
 
-int svt_av1_count_colors_highbd(uint16_t *src, int stride, int rows, int cols, int bit_depth, int *val_count) {
+int svt_av1_count_colors_highbd_c(uint16_t *src, int stride, int rows, int cols, int bit_depth, int *val_count) {
     assert(bit_depth <= 12);
     const int max_pix_val = 1 << bit_depth;
     // const uint16_t *src = CONVERT_TO_SHORTPTR(src8);
@@ -1829,7 +1295,7 @@ int svt_av1_count_colors_highbd(uint16_t *src, int stride, int rows, int cols, i
     return n;
 }
 
-int svt_av1_count_colors(const uint8_t *src, int stride, int rows, int cols, int *val_count) {
+int svt_av1_count_colors_c(const uint8_t *src, int stride, int rows, int cols, int *val_count) {
     const int max_pix_val = 1 << 8;
     memset(val_count, 0, max_pix_val * sizeof(val_count[0]));
     for (int r = 0; r < rows; ++r) {
@@ -2304,6 +1770,7 @@ void *svt_aom_picture_analysis_kernel(void *input_ptr) {
         in_results_ptr = (ResourceCoordinationResults *)in_results_wrapper_ptr->object_ptr;
         pcs            = (PictureParentControlSet *)in_results_ptr->pcs_wrapper->object_ptr;
         scs            = pcs->scs;
+        SVT_TRACE_BEGIN("picture_analysis", pcs->picture_number, -1);
 
         // Mariana : save enhanced picture ptr, move this from here
         pcs->enhanced_unscaled_pic                    = pcs->enhanced_pic;
@@ -2318,7 +1785,8 @@ void *svt_aom_picture_analysis_kernel(void *input_ptr) {
                 svt_aom_pad_input_pictures(scs, input_pic);
 
                 // Pre processing operations performed on the input picture
-                svt_aom_picture_pre_processing_operations(pcs, scs);
+                pa_ctx->denoise_dispatch.picture_number = pcs->picture_number;
+                svt_aom_picture_pre_processing_operations(pcs, scs, &pa_ctx->denoise_dispatch);
 
                 if (input_pic->color_format >= EB_YUV422) {
                     // Jing: Do the conversion of 422/444=>420 here since it's multi-threaded kernel
@@ -17,6 +17,9 @@
 #include "pcs.h"
 #include "sequence_control_set.h"
 
+// most block row bands one Wiener denoise pass is split in
+#define DENOISE_MAX_SEGMENTS 16
+
 /***************************************
  * Extern Function Declaration
  ***************************************/
@@ -25,6 +28,9 @@ EbErrorType svt_aom_picture_analysis_context_ctor(EbThreadContext *thread_ctx, c
 
 extern void *svt_aom_picture_analysis_kernel(void *input_ptr);
 
+struct WienerDenoiseJob;
+void svt_aom_wiener_denoise_rows_mt(struct SegmentDispatch *dispatch, struct WienerDenoiseJob *job, int32_t row_count);
+
 void svt_aom_downsample_filtering_input_picture(PictureParentControlSet *pcs, EbPictureBufferDesc *input_padded_pic,
                                                 EbPictureBufferDesc *quarter_picture_ptr,
                                                 EbPictureBufferDesc *sixteenth_picture_ptr);
@@ -646,3 +646,26 @@ int32_t svt_aom_realloc_frame_buffer(Yv12BufferConfig *ybf, int32_t width, int32
     }
     return -2;
 }
+
+uint64_t svt_picture_buffer_desc_size(const EbPictureBufferDescInitData *init_data, Bool noy8b) {
+    const uint16_t ss        = init_data->color_format == EB_YUV444 ? 0 : 1;
+    const uint64_t stride_y  = init_data->max_width + init_data->left_padding + init_data->right_padding;
+    const uint64_t luma_size = stride_y * (init_data->max_height + init_data->top_padding + init_data->bot_padding);
+    const uint64_t chroma_size = ((stride_y + ss) >> ss) *
+        ((init_data->max_height + ss + init_data->top_padding + init_data->bot_padding) >> ss);
+    const Bool     split     = init_data->split_mode == TRUE;
+    // the noy8b buffers are 8 bit, with their 2 bit planes packed 4 samples per byte
+    const uint64_t bytes = noy8b || (split && init_data->bit_depth <= EB_SIXTEEN_BIT) ? 1
+        : init_data->bit_depth == EB_EIGHT_BIT                                        ? 1
+        : init_data->bit_depth <= EB_SIXTEEN_BIT                                      ? 2
+                                                                                      : 4;
+    const uint64_t inc_div = noy8b ? 4 : 1;
+    uint64_t       size    = sizeof(EbPictureBufferDesc);
+    if (init_data->buffer_enable_mask & PICTURE_BUFFER_DESC_Y_FLAG)
+        size += (noy8b ? 0 : luma_size * bytes) + (split ? luma_size / inc_div : 0);
+    if (init_data->buffer_enable_mask & PICTURE_BUFFER_DESC_Cb_FLAG)
+        size += chroma_size * bytes + (split ? chroma_size / inc_div : 0);
+    if (init_data->buffer_enable_mask & PICTURE_BUFFER_DESC_Cr_FLAG)
+        size += chroma_size * bytes + (split ? chroma_size / inc_div : 0);
+    return size;
+}
@@ -232,6 +232,8 @@ extern EbErrorType svt_picture_buffer_desc_noy8b_update(EbPictureBufferDesc *obj
 extern EbErrorType svt_picture_buffer_desc_update(EbPictureBufferDesc *pictureBufferDescPtr,
                                                   const EbPtr          object_init_data_ptr);
 extern EbErrorType svt_recon_picture_buffer_desc_update(EbPictureBufferDesc *object_ptr, EbPtr object_init_data_ptr);
+/* Bytes the ctors above allocate for a descriptor, the descriptor included */
+extern uint64_t svt_picture_buffer_desc_size(const EbPictureBufferDescInitData *init_data, Bool noy8b);
 #ifdef __cplusplus
 }
 #endif
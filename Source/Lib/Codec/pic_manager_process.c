@@ -25,6 +25,7 @@
 #include "EbSvtAv1ErrorCodes.h"
 #include "entropy_coding.h"
 #include "svt_log.h"
+#include "svt_trace.h"
 
 // Token buffer is only used for palette tokens.
 static INLINE unsigned int get_token_alloc(int mb_rows, int mb_cols, int sb_size_log2, const int num_planes) {
@@ -125,6 +126,25 @@ ReferenceQueueEntry *search_ref_in_ref_queue(EncodeContext *enc_ctx, uint64_t re
     return NULL;
 }
 
+/* Predicted EncDec cost of a SB: the ME distortion of its 64x64 blocks, or their variance when the picture has
+ * no motion search. */
+static uint64_t get_sb_coding_metric(PictureParentControlSet *ppcs, Bool use_me_dist, uint32_t sb_x, uint32_t sb_y) {
+    SequenceControlSet *scs               = ppcs->scs;
+    const uint32_t      b64_per_sb        = scs->sb_size / scs->b64_size;
+    const uint32_t      pic_width_in_b64  = (ppcs->aligned_width + scs->b64_size - 1) / scs->b64_size;
+    const uint32_t      pic_height_in_b64 = (ppcs->aligned_height + scs->b64_size - 1) / scs->b64_size;
+    uint64_t            metric            = 0;
+
+    for (uint32_t y = sb_y * b64_per_sb; y < MIN((sb_y + 1) * b64_per_sb, pic_height_in_b64); y++) {
+        for (uint32_t x = sb_x * b64_per_sb; x < MIN((sb_x + 1) * b64_per_sb, pic_width_in_b64); x++) {
+            const uint32_t b64_index = y * pic_width_in_b64 + x;
+            metric += use_me_dist ? ppcs->rc_me_distortion[b64_index]
+                                  : ppcs->variance[b64_index][ME_TIER_ZERO_PU_64x64];
+        }
+    }
+    return metric;
+}
+
 void svt_aom_init_enc_dec_segement(PictureParentControlSet *ppcs) {
     SequenceControlSet *scs                  = ppcs->scs;
     uint8_t             pic_width_in_sb      = (uint8_t)((ppcs->aligned_width + scs->sb_size - 1) / scs->sb_size);
@@ -146,6 +166,17 @@ void svt_aom_init_enc_dec_segement(PictureParentControlSet *ppcs) {
     ppcs->tile_group_cols = tile_group_cols;
     ppcs->tile_group_rows = tile_group_rows;
 
+    // The picture average is added to every SB cost so that flat SBs are not predicted as free
+    const Bool use_me_dist = ppcs->slice_type != I_SLICE;
+    const Bool use_metric  = enc_dec_seg_col_cnt * enc_dec_seg_row_cnt > 1 &&
+        (use_me_dist || scs->calculate_variance);
+    uint64_t   avg_metric  = 0;
+    if (use_metric) {
+        for (uint32_t y = 0; y < picture_height_in_sb; y++)
+            for (uint32_t x = 0; x < pic_width_in_sb; x++) avg_metric += get_sb_coding_metric(ppcs, use_me_dist, x, y);
+        avg_metric /= pic_width_in_sb * picture_height_in_sb;
+    }
+
     uint8_t tile_group_col_start_tile_idx[1024];
     uint8_t tile_group_row_start_tile_idx[1024];
 
@@ -189,11 +220,28 @@ void svt_aom_init_enc_dec_segement(PictureParentControlSet *ppcs) {
             tg_info_ptr->tile_group_width_in_sb = tg_info_ptr->tile_group_sb_end_x - tg_info_ptr->tile_group_sb_start_x;
 
             // Init segments within the tile group
-            svt_aom_enc_dec_segments_init(ppcs->child_pcs->enc_dec_segment_ctrl[tile_group_idx],
+            EncDecSegments *segments_ptr = ppcs->child_pcs->enc_dec_segment_ctrl[tile_group_idx];
+            svt_aom_enc_dec_segments_init(segments_ptr,
                                           enc_dec_seg_col_cnt,
                                           enc_dec_seg_row_cnt,
                                           tg_info_ptr->tile_group_width_in_sb,
                                           tg_info_ptr->tile_group_height_in_sb);
+            // Weight the segments by their predicted cost so the threads follow the most expensive dependency
+            // chain first
+            if (segments_ptr->segment_ttl_count > 1) {
+                for (uint32_t y = 0; y < tg_info_ptr->tile_group_height_in_sb; y++) {
+                    for (uint32_t x = 0; x < tg_info_ptr->tile_group_width_in_sb; x++) {
+                        const uint64_t metric = use_metric
+                            ? get_sb_coding_metric(ppcs,
+                                                   use_me_dist,
+                                                   x + tg_info_ptr->tile_group_sb_start_x,
+                                                   y + tg_info_ptr->tile_group_sb_start_y)
+                            : 0;
+                        svt_aom_enc_dec_segments_add_sb_cost(segments_ptr, x, y, metric + avg_metric + 1);
+                    }
+                }
+                svt_aom_enc_dec_segments_set_path_cost(segments_ptr);
+            }
             // Enable tile parallelism in Entropy Coding stage
             for (uint16_t s = top_left_tile_row_idx; s < bottom_right_tile_row_idx; s++) {
                 for (uint16_t d = top_left_tile_col_idx; d < bottom_right_tile_col_idx; d++) {
@@ -369,6 +417,7 @@ void *svt_aom_picture_manager_kernel(void *input_ptr) {
             pcs     = (PictureParentControlSet *)input_pic_demux->pcs_wrapper->object_ptr;
             scs     = pcs->scs;
             enc_ctx = scs->enc_ctx;
+            SVT_TRACE_BEGIN("picture_manager", pcs->picture_number, -1);
 
             // SVT_LOG("\nPicture Manager Process @ %d \n ", pcs->picture_number);
             CHECK_REPORT_ERROR(
@@ -429,6 +478,7 @@ void *svt_aom_picture_manager_kernel(void *input_ptr) {
 
             scs     = input_pic_demux->scs;
             enc_ctx = scs->enc_ctx;
+            SVT_TRACE_BEGIN("picture_manager_reference", input_pic_demux->picture_number, -1);
             ((EbReferenceObject *)input_pic_demux->ref_pic_wrapper->object_ptr)->ds_pics.picture_number =
                 input_pic_demux->picture_number;
             // Find the Reference in the Reference List
@@ -458,6 +508,7 @@ void *svt_aom_picture_manager_kernel(void *input_ptr) {
         case EB_PIC_FEEDBACK:
             scs     = input_pic_demux->scs;
             enc_ctx = scs->enc_ctx;
+            SVT_TRACE_BEGIN("picture_manager_feedback", input_pic_demux->picture_number, -1);
 
             // Find the Reference in the Reference Queue
 #if OPT_LD_LATENCY2
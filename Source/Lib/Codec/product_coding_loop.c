@@ -406,8 +406,12 @@ static void mode_decision_update_neighbor_arrays(PictureControlSet *pcs, ModeDec
     }
     return;
 }
-void svt_aom_copy_neighbour_arrays(PictureControlSet *pcs, ModeDecisionContext *ctx, uint32_t src_idx, uint32_t dst_idx,
-                                   uint32_t blk_mds) {
+/*
+ * Copy the neighbour arrays over the footprint of the bwidth x bheight area at the origin of the given block.
+ * The chroma area is rounded up to whole 8x8 luma units, as chroma is written at 8x8 aligned origins.
+ */
+static void copy_neighbour_arrays_area(PictureControlSet *pcs, ModeDecisionContext *ctx, uint32_t src_idx,
+                                       uint32_t dst_idx, uint32_t blk_mds, uint32_t bwidth, uint32_t bheight) {
     uint16_t tile_idx = ctx->tile_index;
 
     const BlockGeom *blk_geom = get_blk_geom_mds(blk_mds);
@@ -416,15 +420,15 @@ void svt_aom_copy_neighbour_arrays(PictureControlSet *pcs, ModeDecisionContext *
     uint32_t blk_org_y    = ctx->sb_origin_y + blk_geom->org_y;
     uint32_t blk_org_x_uv = (blk_org_x >> 3 << 3) >> 1;
     uint32_t blk_org_y_uv = (blk_org_y >> 3 << 3) >> 1;
-    uint32_t bwidth_uv    = blk_geom->bwidth_uv;
-    uint32_t bheight_uv   = blk_geom->bheight_uv;
+    uint32_t bwidth_uv    = MIN(blk_geom->bwidth_uv, ((bwidth + 7) >> 3) << 2);
+    uint32_t bheight_uv   = MIN(blk_geom->bheight_uv, ((bheight + 7) >> 3) << 2);
     //svt_aom_neighbor_array_unit_reset(pcs->md_leaf_depth_neighbor_array[depth]);
     svt_aom_copy_neigh_arr(pcs->mdleaf_partition_na[src_idx][tile_idx],
                            pcs->mdleaf_partition_na[dst_idx][tile_idx],
                            blk_org_x,
                            blk_org_y,
-                           blk_geom->bwidth,
-                           blk_geom->bheight,
+                           bwidth,
+                           bheight,
                            NEIGHBOR_ARRAY_UNIT_TOP_AND_LEFT_ONLY_MASK);
 
     // if using 8bit MD and bypassing encdec, need to save 8bit and 10bit recon
@@ -434,23 +438,23 @@ void svt_aom_copy_neighbour_arrays(PictureControlSet *pcs, ModeDecisionContext *
                                pcs->md_luma_recon_na_16bit[dst_idx][tile_idx],
                                blk_org_x,
                                blk_org_y,
-                               blk_geom->bwidth,
-                               blk_geom->bheight,
+                               bwidth,
+                               bheight,
                                NEIGHBOR_ARRAY_UNIT_FULL_MASK);
         if (ctx->txs_ctrls.enabled) {
             svt_aom_copy_neigh_arr(pcs->md_tx_depth_1_luma_recon_na_16bit[src_idx][tile_idx],
                                    pcs->md_tx_depth_1_luma_recon_na_16bit[dst_idx][tile_idx],
                                    blk_org_x,
                                    blk_org_y,
-                                   blk_geom->bwidth,
-                                   blk_geom->bheight,
+                                   bwidth,
+                                   bheight,
                                    NEIGHBOR_ARRAY_UNIT_FULL_MASK);
             svt_aom_copy_neigh_arr(pcs->md_tx_depth_2_luma_recon_na_16bit[src_idx][tile_idx],
                                    pcs->md_tx_depth_2_luma_recon_na_16bit[dst_idx][tile_idx],
                                    blk_org_x,
                                    blk_org_y,
-                                   blk_geom->bwidth,
-                                   blk_geom->bheight,
+                                   bwidth,
+                                   bheight,
                                    NEIGHBOR_ARRAY_UNIT_FULL_MASK);
         }
         if (blk_geom->has_uv && ctx->uv_ctrls.uv_mode <= CHROMA_MODE_1) {
@@ -476,23 +480,23 @@ void svt_aom_copy_neighbour_arrays(PictureControlSet *pcs, ModeDecisionContext *
                                pcs->md_luma_recon_na[dst_idx][tile_idx],
                                blk_org_x,
                                blk_org_y,
-                               blk_geom->bwidth,
-                               blk_geom->bheight,
+                               bwidth,
+                               bheight,
                                NEIGHBOR_ARRAY_UNIT_FULL_MASK);
         if (ctx->txs_ctrls.enabled) {
             svt_aom_copy_neigh_arr(pcs->md_tx_depth_1_luma_recon_na[src_idx][tile_idx],
                                    pcs->md_tx_depth_1_luma_recon_na[dst_idx][tile_idx],
                                    blk_org_x,
                                    blk_org_y,
-                                   blk_geom->bwidth,
-                                   blk_geom->bheight,
+                                   bwidth,
+                                   bheight,
                                    NEIGHBOR_ARRAY_UNIT_FULL_MASK);
             svt_aom_copy_neigh_arr(pcs->md_tx_depth_2_luma_recon_na[src_idx][tile_idx],
                                    pcs->md_tx_depth_2_luma_recon_na[dst_idx][tile_idx],
                                    blk_org_x,
                                    blk_org_y,
-                                   blk_geom->bwidth,
-                                   blk_geom->bheight,
+                                   bwidth,
+                                   bheight,
                                    NEIGHBOR_ARRAY_UNIT_FULL_MASK);
         }
         if (blk_geom->has_uv && ctx->uv_ctrls.uv_mode <= CHROMA_MODE_1) {
@@ -517,23 +521,23 @@ void svt_aom_copy_neighbour_arrays(PictureControlSet *pcs, ModeDecisionContext *
                                pcs->md_luma_recon_na[dst_idx][tile_idx],
                                blk_org_x,
                                blk_org_y,
-                               blk_geom->bwidth,
-                               blk_geom->bheight,
+                               bwidth,
+                               bheight,
                                NEIGHBOR_ARRAY_UNIT_FULL_MASK);
         if (ctx->txs_ctrls.enabled) {
             svt_aom_copy_neigh_arr(pcs->md_tx_depth_1_luma_recon_na[src_idx][tile_idx],
                                    pcs->md_tx_depth_1_luma_recon_na[dst_idx][tile_idx],
                                    blk_org_x,
                                    blk_org_y,
-                                   blk_geom->bwidth,
-                                   blk_geom->bheight,
+                                   bwidth,
+                                   bheight,
                                    NEIGHBOR_ARRAY_UNIT_FULL_MASK);
             svt_aom_copy_neigh_arr(pcs->md_tx_depth_2_luma_recon_na[src_idx][tile_idx],
                                    pcs->md_tx_depth_2_luma_recon_na[dst_idx][tile_idx],
                                    blk_org_x,
                                    blk_org_y,
-                                   blk_geom->bwidth,
-                                   blk_geom->bheight,
+                                   bwidth,
+                                   bheight,
                                    NEIGHBOR_ARRAY_UNIT_FULL_MASK);
         }
         if (blk_geom->has_uv && ctx->uv_ctrls.uv_mode <= CHROMA_MODE_1) {
@@ -558,23 +562,23 @@ void svt_aom_copy_neighbour_arrays(PictureControlSet *pcs, ModeDecisionContext *
                                pcs->md_luma_recon_na_16bit[dst_idx][tile_idx],
                                blk_org_x,
                                blk_org_y,
-                               blk_geom->bwidth,
-                               blk_geom->bheight,
+                               bwidth,
+                               bheight,
                                NEIGHBOR_ARRAY_UNIT_FULL_MASK);
         if (ctx->txs_ctrls.enabled) {
             svt_aom_copy_neigh_arr(pcs->md_tx_depth_1_luma_recon_na_16bit[src_idx][tile_idx],
                                    pcs->md_tx_depth_1_luma_recon_na_16bit[dst_idx][tile_idx],
                                    blk_org_x,
                                    blk_org_y,
-                                   blk_geom->bwidth,
-                                   blk_geom->bheight,
+                                   bwidth,
+                                   bheight,
                                    NEIGHBOR_ARRAY_UNIT_FULL_MASK);
             svt_aom_copy_neigh_arr(pcs->md_tx_depth_2_luma_recon_na_16bit[src_idx][tile_idx],
                                    pcs->md_tx_depth_2_luma_recon_na_16bit[dst_idx][tile_idx],
                                    blk_org_x,
                                    blk_org_y,
-                                   blk_geom->bwidth,
-                                   blk_geom->bheight,
+                                   bwidth,
+                                   bheight,
                                    NEIGHBOR_ARRAY_UNIT_FULL_MASK);
         }
         if (blk_geom->has_uv && ctx->uv_ctrls.uv_mode <= CHROMA_MODE_1) {
@@ -601,16 +605,16 @@ void svt_aom_copy_neighbour_arrays(PictureControlSet *pcs, ModeDecisionContext *
                            pcs->md_y_dcs_na[dst_idx][tile_idx],
                            blk_org_x,
                            blk_org_y,
-                           blk_geom->bwidth,
-                           blk_geom->bheight,
+                           bwidth,
+                           bheight,
                            NEIGHBOR_ARRAY_UNIT_TOP_AND_LEFT_ONLY_MASK);
 
     svt_aom_copy_neigh_arr(pcs->md_tx_depth_1_luma_dc_sign_level_coeff_na[src_idx][tile_idx],
                            pcs->md_tx_depth_1_luma_dc_sign_level_coeff_na[dst_idx][tile_idx],
                            blk_org_x,
                            blk_org_y,
-                           blk_geom->bwidth,
-                           blk_geom->bheight,
+                           bwidth,
+                           bheight,
                            NEIGHBOR_ARRAY_UNIT_TOP_AND_LEFT_ONLY_MASK);
     if (blk_geom->has_uv && ctx->uv_ctrls.uv_mode <= CHROMA_MODE_1) {
         svt_aom_copy_neigh_arr(pcs->md_cb_dc_sign_level_coeff_na[src_idx][tile_idx],
@@ -636,10 +640,27 @@ void svt_aom_copy_neighbour_arrays(PictureControlSet *pcs, ModeDecisionContext *
                            pcs->md_txfm_context_array[dst_idx][tile_idx],
                            blk_org_x,
                            blk_org_y,
-                           blk_geom->bwidth,
-                           blk_geom->bheight,
+                           bwidth,
+                           bheight,
                            NEIGHBOR_ARRAY_UNIT_TOP_AND_LEFT_ONLY_MASK);
 }
+void svt_aom_copy_neighbour_arrays(PictureControlSet *pcs, ModeDecisionContext *ctx, uint32_t src_idx, uint32_t dst_idx,
+                                   uint32_t blk_mds) {
+    const BlockGeom *blk_geom = get_blk_geom_mds(blk_mds);
+    copy_neighbour_arrays_area(pcs, ctx, src_idx, dst_idx, blk_mds, blk_geom->bwidth, blk_geom->bheight);
+}
+/*
+ * Restore the neighbour arrays of the current square block from the copy saved in [1], only over the area that
+ * was modified since the save or the previous restore. The NSQ blocks whose neighbours are updated always start
+ * at the square origin, so that area is the extent of those blocks from the origin.
+ */
+static void restore_neighbour_arrays(PictureControlSet *pcs, ModeDecisionContext *ctx, uint32_t sq_mds) {
+    if (!ctx->na_dirty_w)
+        return;
+    copy_neighbour_arrays_area(pcs, ctx, 1, 0, sq_mds, ctx->na_dirty_w, ctx->na_dirty_h);
+    ctx->na_dirty_w = 0;
+    ctx->na_dirty_h = 0;
+}
 
 static void md_update_all_neighbour_arrays(PictureControlSet *pcs, ModeDecisionContext *ctx,
                                            uint32_t last_blk_index_mds) {
@@ -1163,16 +1184,18 @@ static void obmc_trans_face_off(ModeDecisionCandidateBuffer *cand_bf, PictureCon
                     pred->stride_y,
                     ctx->blk_geom->bwidth,
                     ctx->blk_geom->bheight));
-                luma_fast_dist += (uint32_t)(get_svt_psy_full_dist(input_pic->buffer_y,
-                                                                   input_origin_index,
-                                                                   input_pic->stride_y,
-                                                                   pred->buffer_y,
-                                                                   cu_origin_index,
-                                                                   pred->stride_y,
-                                                                   ctx->blk_geom->bwidth,
-                                                                   ctx->blk_geom->bheight,
-                                                                   ctx->hbd_md,
-                                                                   pcs->scs->static_config.psy_rd));
+                luma_fast_dist += (uint32_t)(get_svt_psy_full_dist_cached(&ctx->psy_nrg_cache,
+                                                                          AOM_PLANE_Y,
+                                                                          input_pic->buffer_y,
+                                                                          input_origin_index,
+                                                                          input_pic->stride_y,
+                                                                          pred->buffer_y,
+                                                                          cu_origin_index,
+                                                                          pred->stride_y,
+                                                                          ctx->blk_geom->bwidth,
+                                                                          ctx->blk_geom->bheight,
+                                                                          ctx->hbd_md,
+                                                                          pcs->scs->static_config.psy_rd));
                 cand_bf->luma_fast_dist = luma_fast_dist;
             } else if (ctx->mds0_ctrls.mds0_dist_type == VAR) {
                 if (!ctx->hbd_md) {
@@ -1227,16 +1250,18 @@ static void obmc_trans_face_off(ModeDecisionCandidateBuffer *cand_bf, PictureCon
                                                                                   pred->stride_cb,
                                                                                   ctx->blk_geom->bwidth_uv,
                                                                                   ctx->blk_geom->bheight_uv);
-                    chroma_fast_distortion += (uint32_t)get_svt_psy_full_dist(input_pic->buffer_cb,
-                                                                              input_cb_origin_in_index,
-                                                                              input_pic->stride_cb,
-                                                                              cand_bf->pred->buffer_cb,
-                                                                              cu_chroma_origin_index,
-                                                                              pred->stride_cb,
-                                                                              ctx->blk_geom->bwidth_uv,
-                                                                              ctx->blk_geom->bheight_uv,
-                                                                              ctx->hbd_md,
-                                                                              pcs->scs->static_config.psy_rd);
+                    chroma_fast_distortion += (uint32_t)get_svt_psy_full_dist_cached(&ctx->psy_nrg_cache,
+                                                                                     AOM_PLANE_U,
+                                                                                     input_pic->buffer_cb,
+                                                                                     input_cb_origin_in_index,
+                                                                                     input_pic->stride_cb,
+                                                                                     cand_bf->pred->buffer_cb,
+                                                                                     cu_chroma_origin_index,
+                                                                                     pred->stride_cb,
+                                                                                     ctx->blk_geom->bwidth_uv,
+                                                                                     ctx->blk_geom->bheight_uv,
+                                                                                     ctx->hbd_md,
+                                                                                     pcs->scs->static_config.psy_rd);
                     chroma_fast_distortion += (uint32_t)spatial_full_dist_type_fun(input_pic->buffer_cr,
                                                                                    input_cr_origin_in_index,
                                                                                    input_pic->stride_cb,
@@ -1245,16 +1270,18 @@ static void obmc_trans_face_off(ModeDecisionCandidateBuffer *cand_bf, PictureCon
                                                                                    pred->stride_cr,
                                                                                    ctx->blk_geom->bwidth_uv,
                                                                                    ctx->blk_geom->bheight_uv);
-                    chroma_fast_distortion += (uint32_t)get_svt_psy_full_dist(input_pic->buffer_cr,
-                                                                              input_cr_origin_in_index,
-                                                                              input_pic->stride_cr,
-                                                                              cand_bf->pred->buffer_cr,
-                                                                              cu_chroma_origin_index,
-                                                                              pred->stride_cr,
-                                                                              ctx->blk_geom->bwidth_uv,
-                                                                              ctx->blk_geom->bheight_uv,
-                                                                              ctx->hbd_md,
-                                                                              pcs->scs->static_config.psy_rd);
+                    chroma_fast_distortion += (uint32_t)get_svt_psy_full_dist_cached(&ctx->psy_nrg_cache,
+                                                                                     AOM_PLANE_V,
+                                                                                     input_pic->buffer_cr,
+                                                                                     input_cr_origin_in_index,
+                                                                                     input_pic->stride_cr,
+                                                                                     cand_bf->pred->buffer_cr,
+                                                                                     cu_chroma_origin_index,
+                                                                                     pred->stride_cr,
+                                                                                     ctx->blk_geom->bwidth_uv,
+                                                                                     ctx->blk_geom->bheight_uv,
+                                                                                     ctx->hbd_md,
+                                                                                     pcs->scs->static_config.psy_rd);
                 } else {
                     assert((ctx->blk_geom->bwidth_uv >> 3) < 17);
 
@@ -1350,16 +1377,18 @@ void fast_loop_core(ModeDecisionCandidateBuffer *cand_bf, PictureControlSet *pcs
                                                                pred->stride_y,
                                                                ctx->blk_geom->bwidth,
                                                                ctx->blk_geom->bheight));
-        luma_fast_dist += (uint32_t)(get_svt_psy_full_dist(input_pic->buffer_y,
-                                                           input_origin_index,
-                                                           input_pic->stride_y,
-                                                           pred->buffer_y,
-                                                           cu_origin_index,
-                                                           pred->stride_y,
-                                                           ctx->blk_geom->bwidth,
-                                                           ctx->blk_geom->bheight,
-                                                           ctx->hbd_md,
-                                                           pcs->scs->static_config.psy_rd));
+        luma_fast_dist += (uint32_t)(get_svt_psy_full_dist_cached(&ctx->psy_nrg_cache,
+                                                                  AOM_PLANE_Y,
+                                                                  input_pic->buffer_y,
+                                                                  input_origin_index,
+                                                                  input_pic->stride_y,
+                                                                  pred->buffer_y,
+                                                                  cu_origin_index,
+                                                                  pred->stride_y,
+                                                                  ctx->blk_geom->bwidth,
+                                                                  ctx->blk_geom->bheight,
+                                                                  ctx->hbd_md,
+                                                                  pcs->scs->static_config.psy_rd));
         cand_bf->luma_fast_dist = luma_fast_dist;
     } else if (ctx->mds0_ctrls.mds0_dist_type == VAR) {
         if (!ctx->hbd_md) {
@@ -1418,16 +1447,18 @@ void fast_loop_core(ModeDecisionCandidateBuffer *cand_bf, PictureControlSet *pcs
                                                                           pred->stride_cb,
                                                                           ctx->blk_geom->bwidth_uv,
                                                                           ctx->blk_geom->bheight_uv);
-            chroma_fast_distortion += (uint32_t)get_svt_psy_full_dist(input_pic->buffer_cb,
-                                                                      input_cb_origin_in_index,
-                                                                      input_pic->stride_cb,
-                                                                      cand_bf->pred->buffer_cb,
-                                                                      cu_chroma_origin_index,
-                                                                      pred->stride_cb,
-                                                                      ctx->blk_geom->bwidth_uv,
-                                                                      ctx->blk_geom->bheight_uv,
-                                                                      ctx->hbd_md,
-                                                                      pcs->scs->static_config.psy_rd);
+            chroma_fast_distortion += (uint32_t)get_svt_psy_full_dist_cached(&ctx->psy_nrg_cache,
+                                                                             AOM_PLANE_U,
+                                                                             input_pic->buffer_cb,
+                                                                             input_cb_origin_in_index,
+                                                                             input_pic->stride_cb,
+                                                                             cand_bf->pred->buffer_cb,
+                                                                             cu_chroma_origin_index,
+                                                                             pred->stride_cb,
+                                                                             ctx->blk_geom->bwidth_uv,
+                                                                             ctx->blk_geom->bheight_uv,
+                                                                             ctx->hbd_md,
+                                                                             pcs->scs->static_config.psy_rd);
             chroma_fast_distortion += (uint32_t)spatial_full_dist_type_fun(input_pic->buffer_cr,
                                                                            input_cr_origin_in_index,
                                                                            input_pic->stride_cb, // Was stride_cb ... may have been wrong?
@@ -1436,16 +1467,18 @@ void fast_loop_core(ModeDecisionCandidateBuffer *cand_bf, PictureControlSet *pcs
                                                                            pred->stride_cr,
                                                                            ctx->blk_geom->bwidth_uv,
                                                                            ctx->blk_geom->bheight_uv);
-            chroma_fast_distortion += (uint32_t)get_svt_psy_full_dist(input_pic->buffer_cr,
-                                                                      input_cr_origin_in_index,
-                                                                      input_pic->stride_cr,
-                                                                      cand_bf->pred->buffer_cr,
-                                                                      cu_chroma_origin_index,
-                                                                      pred->stride_cr,
-                                                                      ctx->blk_geom->bwidth_uv,
-                                                                      ctx->blk_geom->bheight_uv,
-                                                                      ctx->hbd_md,
-                                                                      pcs->scs->static_config.psy_rd);
+            chroma_fast_distortion += (uint32_t)get_svt_psy_full_dist_cached(&ctx->psy_nrg_cache,
+                                                                             AOM_PLANE_V,
+                                                                             input_pic->buffer_cr,
+                                                                             input_cr_origin_in_index,
+                                                                             input_pic->stride_cr,
+                                                                             cand_bf->pred->buffer_cr,
+                                                                             cu_chroma_origin_index,
+                                                                             pred->stride_cr,
+                                                                             ctx->blk_geom->bwidth_uv,
+                                                                             ctx->blk_geom->bheight_uv,
+                                                                             ctx->hbd_md,
+                                                                             pcs->scs->static_config.psy_rd);
         } else {
             assert((ctx->blk_geom->bwidth_uv >> 3) < 17);
 
@@ -2092,16 +2125,18 @@ static void md_full_pel_search(PictureControlSet *pcs, ModeDecisionContext *ctx,
                                                             ref_pic->stride_y,
                                                             ctx->blk_geom->bwidth,
                                                             ctx->blk_geom->bheight);
-                cost += (uint32_t)get_svt_psy_full_dist(input_pic->buffer_y,
-                                                         input_origin_index,
-                                                         input_pic->stride_y,
-                                                         ref_pic->buffer_y,
-                                                         ref_origin_index,
-                                                         ref_pic->stride_y,
-                                                         ctx->blk_geom->bwidth,
-                                                         ctx->blk_geom->bheight,
-                                                         ctx->hbd_md,
-                                                         pcs->scs->static_config.psy_rd);
+                cost += (uint32_t)get_svt_psy_full_dist_cached(&ctx->psy_nrg_cache,
+                                                                AOM_PLANE_Y,
+                                                                input_pic->buffer_y,
+                                                                input_origin_index,
+                                                                input_pic->stride_y,
+                                                                ref_pic->buffer_y,
+                                                                ref_origin_index,
+                                                                ref_pic->stride_y,
+                                                                ctx->blk_geom->bwidth,
+                                                                ctx->blk_geom->bheight,
+                                                                ctx->hbd_md,
+                                                                pcs->scs->static_config.psy_rd);
             } else {
                 assert((ctx->blk_geom->bwidth >> 3) < 17);
                 /* Might be able to add PSY distortion here too */
@@ -4794,7 +4829,9 @@ static void tx_type_search(PictureControlSet *pcs, ModeDecisionContext *ctx, Mod
                     cand_bf->pred->stride_y,
                     cropped_tx_width,
                     cropped_tx_height);
-                txb_full_distortion_txt[DIST_SSD][tx_type][DIST_CALC_PREDICTION] += get_svt_psy_full_dist(
+                txb_full_distortion_txt[DIST_SSD][tx_type][DIST_CALC_PREDICTION] += get_svt_psy_full_dist_cached(
+                    &ctx->psy_nrg_cache,
+                    AOM_PLANE_Y,
                     input_pic->buffer_y,
                     input_txb_origin_index,
                     input_pic->stride_y,
@@ -4814,7 +4851,9 @@ static void tx_type_search(PictureControlSet *pcs, ModeDecisionContext *ctx, Mod
                     cand_bf->recon->stride_y,
                     cropped_tx_width,
                     cropped_tx_height);
-                txb_full_distortion_txt[DIST_SSD][tx_type][DIST_CALC_RESIDUAL] += get_svt_psy_full_dist(
+                txb_full_distortion_txt[DIST_SSD][tx_type][DIST_CALC_RESIDUAL] += get_svt_psy_full_dist_cached(
+                    &ctx->psy_nrg_cache,
+                    AOM_PLANE_Y,
                     input_pic->buffer_y,
                     input_txb_origin_index,
                     input_pic->stride_y,
@@ -5718,16 +5757,18 @@ static void perform_dct_dct_tx(PictureControlSet *pcs, ModeDecisionContext *ctx,
                                                                                        cand_bf->pred->stride_y,
                                                                                        cropped_tx_width,
                                                                                        cropped_tx_height);
-        y_full_distortion[DIST_SSD][DIST_CALC_PREDICTION] += get_svt_psy_full_dist(input_pic->buffer_y,
-                                                                                   input_txb_origin_index,
-                                                                                   input_pic->stride_y,
-                                                                                   cand_bf->pred->buffer_y,
-                                                                                   (int32_t)txb_origin_index,
-                                                                                   cand_bf->pred->stride_y,
-                                                                                   cropped_tx_width,
-                                                                                   cropped_tx_height,
-                                                                                   ctx->hbd_md,
-                                                                                   pcs->scs->static_config.psy_rd);
+        y_full_distortion[DIST_SSD][DIST_CALC_PREDICTION] += get_svt_psy_full_dist_cached(&ctx->psy_nrg_cache,
+                                                                                          AOM_PLANE_Y,
+                                                                                          input_pic->buffer_y,
+                                                                                          input_txb_origin_index,
+                                                                                          input_pic->stride_y,
+                                                                                          cand_bf->pred->buffer_y,
+                                                                                          (int32_t)txb_origin_index,
+                                                                                          cand_bf->pred->stride_y,
+                                                                                          cropped_tx_width,
+                                                                                          cropped_tx_height,
+                                                                                          ctx->hbd_md,
+                                                                                          pcs->scs->static_config.psy_rd);
         y_full_distortion[DIST_SSD][DIST_CALC_RESIDUAL]   = spatial_full_dist_type_fun(input_pic->buffer_y,
                                                                                      input_txb_origin_index,
                                                                                      input_pic->stride_y,
@@ -5736,16 +5777,18 @@ static void perform_dct_dct_tx(PictureControlSet *pcs, ModeDecisionContext *ctx,
                                                                                      cand_bf->recon->stride_y,
                                                                                      cropped_tx_width,
                                                                                      cropped_tx_height);
-        y_full_distortion[DIST_SSD][DIST_CALC_RESIDUAL] += get_svt_psy_full_dist(input_pic->buffer_y,
-                                                                                 input_txb_origin_index,
-                                                                                 input_pic->stride_y,
-                                                                                 recon_ptr->buffer_y,
-                                                                                 (int32_t)txb_origin_index,
-                                                                                 cand_bf->recon->stride_y,
-                                                                                 cropped_tx_width,
-                                                                                 cropped_tx_height,
-                                                                                 ctx->hbd_md,
-                                                                                 pcs->scs->static_config.psy_rd);
+        y_full_distortion[DIST_SSD][DIST_CALC_RESIDUAL] += get_svt_psy_full_dist_cached(&ctx->psy_nrg_cache,
+                                                                                        AOM_PLANE_Y,
+                                                                                        input_pic->buffer_y,
+                                                                                        input_txb_origin_index,
+                                                                                        input_pic->stride_y,
+                                                                                        recon_ptr->buffer_y,
+                                                                                        (int32_t)txb_origin_index,
+                                                                                        cand_bf->recon->stride_y,
+                                                                                        cropped_tx_width,
+                                                                                        cropped_tx_height,
+                                                                                        ctx->hbd_md,
+                                                                                        pcs->scs->static_config.psy_rd);
         y_full_distortion[DIST_SSD][DIST_CALC_PREDICTION] <<= 4;
         y_full_distortion[DIST_SSD][DIST_CALC_RESIDUAL] <<= 4;
     } else {
@@ -7972,7 +8015,9 @@ static void calc_scr_to_recon_dist_per_quadrant(ModeDecisionContext *ctx, EbPict
                 recon_ptr->stride_y,
                 (uint32_t)quadrant_size,
                 (uint32_t)quadrant_size);
-            ctx->rec_dist_per_quadrant[c + (r << 1)] += get_svt_psy_full_dist(
+            ctx->rec_dist_per_quadrant[c + (r << 1)] += get_svt_psy_full_dist_cached(
+                &ctx->psy_nrg_cache,
+                AOM_PLANE_Y,
                 input_pic->buffer_y,
                 input_origin_index + c * quadrant_size + (r * quadrant_size) * input_pic->stride_y,
                 input_pic->stride_y,
@@ -7996,7 +8041,9 @@ static void calc_scr_to_recon_dist_per_quadrant(ModeDecisionContext *ctx, EbPict
                     recon_ptr->stride_cb,
                     (uint32_t)(quadrant_size >> 1),
                     (uint32_t)(quadrant_size >> 1));
-                ctx->rec_dist_per_quadrant[c + (r << 1)] += get_svt_psy_full_dist(
+                ctx->rec_dist_per_quadrant[c + (r << 1)] += get_svt_psy_full_dist_cached(
+                    &ctx->psy_nrg_cache,
+                    AOM_PLANE_U,
                     input_pic->buffer_cb,
                     input_cb_origin_in_index + c * (quadrant_size >> 1) +
                         (r * (quadrant_size >> 1)) * input_pic->stride_cb,
@@ -8021,7 +8068,9 @@ static void calc_scr_to_recon_dist_per_quadrant(ModeDecisionContext *ctx, EbPict
                     recon_ptr->stride_cr,
                     (uint32_t)(quadrant_size >> 1),
                     (uint32_t)(quadrant_size >> 1));
-                ctx->rec_dist_per_quadrant[c + (r << 1)] += get_svt_psy_full_dist(
+                ctx->rec_dist_per_quadrant[c + (r << 1)] += get_svt_psy_full_dist_cached(
+                    &ctx->psy_nrg_cache,
+                    AOM_PLANE_V,
                     input_pic->buffer_cr,
                     input_cb_origin_in_index + c * (quadrant_size >> 1) +
                         (r * (quadrant_size >> 1)) * input_pic->stride_cr,
@@ -10172,12 +10221,7 @@ static Bool update_redundant(PictureControlSet *pcs, ModeDecisionContext *ctx) {
 
     if (redundant_blk_avail && ctx->redundant_blk) {
         if (ctx->copied_neigh_arrays && ctx->blk_geom->nsi == 0)
-            svt_aom_copy_neighbour_arrays( //restore [1] in [0] after done last ns block
-                pcs,
-                ctx,
-                1,
-                0,
-                ctx->blk_geom->sqi_mds);
+            restore_neighbour_arrays(pcs, ctx, ctx->blk_geom->sqi_mds); //restore [1] in [0] after done last ns block
 
         // Copy results
         BlkStruct *redund_blk_ptr = &ctx->md_blk_arr_nsq[redundant_blk_mds];
@@ -10369,14 +10413,8 @@ static void process_block(PictureControlSet *pcs, ModeDecisionContext *ctx, cons
 
     // encode the current block only if it's not redundant
     if (!skip_processing_block && (!ctx->redundant_blk || !update_redundant(pcs, ctx))) {
-        if (ctx->copied_neigh_arrays && blk_geom->nsi == 0) {
-            svt_aom_copy_neighbour_arrays( //restore [1] in [0] after done last ns block
-                pcs,
-                ctx,
-                1,
-                0,
-                blk_geom->sqi_mds);
-        }
+        if (ctx->copied_neigh_arrays && blk_geom->nsi == 0)
+            restore_neighbour_arrays(pcs, ctx, blk_geom->sqi_mds); //restore [1] in [0] after done last ns block
 
         // Encode the block
         md_encode_block(pcs, ctx, ctx->sb_index, in_pic);
@@ -10439,8 +10477,15 @@ static void update_d1_data(PictureControlSet *pcs, ModeDecisionContext *ctx, uin
                         1,
                         ctx->blk_geom->sqi_mds);
                     ctx->copied_neigh_arrays = 1;
+                    ctx->na_dirty_w          = 0;
+                    ctx->na_dirty_h          = 0;
                 }
                 md_update_all_neighbour_arrays(pcs, ctx, blk_idx_mds);
+                if (ctx->copied_neigh_arrays) {
+                    const BlockGeom *sq_geom = get_blk_geom_mds(blk_geom->sqi_mds);
+                    ctx->na_dirty_w = MAX(ctx->na_dirty_w, blk_geom->org_x + blk_geom->bwidth - sq_geom->org_x);
+                    ctx->na_dirty_h = MAX(ctx->na_dirty_h, blk_geom->org_y + blk_geom->bheight - sq_geom->org_y);
+                }
             }
         }
     }
@@ -10508,6 +10553,43 @@ static const uint8_t num_ns_per_shape[PART_S] = {1, 2, 2, 4, 4, 3, 3, 3, 3};
 static const uint32_t ns_blk_offset_md[PART_S]     = {0, 1, 3, 5, 9, 13, 16, 19, 22};
 static const uint32_t ns_blk_offset_128_md[PART_S] = {
     0, 1, 3, 0 /*H4 not allowed*/, 0 /*V4 not allowed*/, 5, 8, 11, 14};
+/*
+ * Point the psy-rd source energy cache at the current SB of input_pic. Must be called for every SB,
+ * the input buffers are recycled across pictures so stale entries could otherwise match.
+ */
+static void reset_psy_nrg_cache(SequenceControlSet *scs, ModeDecisionContext *ctx, EbPictureBufferDesc *input_pic) {
+    if (scs->static_config.psy_rd == 0.0)
+        return;
+    const uint32_t org_x = ctx->sb_origin_x + input_pic->org_x;
+    const uint32_t org_y = ctx->sb_origin_y + input_pic->org_y;
+    svt_psy_src_nrg_cache_reset(&ctx->psy_nrg_cache,
+                                AOM_PLANE_Y,
+                                input_pic->buffer_y,
+                                input_pic->stride_y,
+                                org_x,
+                                org_y,
+                                ctx->sb_size,
+                                ctx->sb_size,
+                                ctx->hbd_md);
+    svt_psy_src_nrg_cache_reset(&ctx->psy_nrg_cache,
+                                AOM_PLANE_U,
+                                input_pic->buffer_cb,
+                                input_pic->stride_cb,
+                                org_x >> 1,
+                                org_y >> 1,
+                                ctx->sb_size >> 1,
+                                ctx->sb_size >> 1,
+                                ctx->hbd_md);
+    svt_psy_src_nrg_cache_reset(&ctx->psy_nrg_cache,
+                                AOM_PLANE_V,
+                                input_pic->buffer_cr,
+                                input_pic->stride_cr,
+                                org_x >> 1,
+                                org_y >> 1,
+                                ctx->sb_size >> 1,
+                                ctx->sb_size >> 1,
+                                ctx->hbd_md);
+}
 /*
  * Loop over all passed blocks in an SB and perform mode decision for each block,
  * then output the optimal mode distribution/partitioning for the given SB.
@@ -10535,6 +10617,7 @@ void svt_aom_mode_decision_sb_light_pd0(SequenceControlSet *scs, PictureControlS
 
     // get the input picture; if high bit-depth, pad the input pic
     EbPictureBufferDesc *input_pic = pcs->ppcs->enhanced_pic;
+    reset_psy_nrg_cache(scs, ctx, input_pic);
 
     // Initialize variables used to track blocks
     uint32_t                   leaf_count      = mdc_sb_data->leaf_count;
@@ -10598,6 +10681,7 @@ void svt_aom_mode_decision_sb_light_pd1(SequenceControlSet *scs, PictureControlS
         // input_pic
         pad_hbd_pictures(scs, pcs, ctx, input_pic);
     }
+    reset_psy_nrg_cache(scs, ctx, input_pic);
 
     // Initialize variables used to track blocks
     uint32_t                   leaf_count      = mdc_sb_data->leaf_count;
@@ -10728,6 +10812,7 @@ void svt_aom_mode_decision_sb(SequenceControlSet *scs, PictureControlSet *pcs, M
         // If using 8bit MD but bypassing EncDec, will need th 16bit pic later, but don't change input_pic
         pad_hbd_pictures(scs, pcs, ctx, input_pic);
     }
+    reset_psy_nrg_cache(scs, ctx, input_pic);
     // Initialize variables used to track blocks
     uint32_t                   leaf_count      = mdc_sb_data->leaf_count;
     const EbMdcLeafData *const leaf_data_array = mdc_sb_data->leaf_data_array;
@@ -10738,6 +10823,8 @@ void svt_aom_mode_decision_sb(SequenceControlSet *scs, PictureControlSet *pcs, M
     ctx->coded_area_sb_uv              = 0;
     ctx->params_status                 = 0;
     ctx->copied_neigh_arrays           = 0;
+    ctx->na_dirty_w                    = 0;
+    ctx->na_dirty_h                    = 0;
 
     // Iterate over all blocks which are flagged to be considered
     for (uint32_t blk_idx = 0; blk_idx < leaf_count; blk_idx++) {
@@ -10805,12 +10892,7 @@ void svt_aom_mode_decision_sb(SequenceControlSet *scs, PictureControlSet *pcs, M
 
         // Now have checked all d1 blocks, so update d2 info
         if (ctx->copied_neigh_arrays && ctx->md_blk_arr_nsq[ctx->blk_geom->sqi_mds].split_flag)
-            svt_aom_copy_neighbour_arrays( //restore [1] in [0] after done last ns block
-                pcs,
-                ctx,
-                1,
-                0,
-                ctx->blk_geom->sqi_mds);
+            restore_neighbour_arrays(pcs, ctx, ctx->blk_geom->sqi_mds); //restore [1] in [0] after done last ns block
 
         // Perform d2 inter-depth decision after final d1 block
         update_d2_decision(pcs, ctx);
@@ -12,6 +12,8 @@
 #include <stdint.h>
 #include <stdlib.h>
 #include <stdbool.h>
+#include "common_dsp_rtcd.h"
+#include "psy_rd.h"
 #define BITS_PER_SUM 8 * sizeof(uint16_t)
 
 #define HADAMARD4(d0, d1, d2, d3, s0, s1, s2, s3) { \
@@ -120,7 +122,7 @@ static int svt_psy_sad_nxn(const uint8_t bw, const uint8_t bh, const uint8_t* s,
 
     return sum;
 }
-uint64_t svt_psy_distortion(const uint8_t* input, uint32_t input_stride,
+uint64_t svt_psy_distortion_c(const uint8_t* input, uint32_t input_stride,
                             const uint8_t* recon, uint32_t recon_stride,
                             uint32_t width, uint32_t height,
                             const uint32_t count) {
@@ -149,6 +151,18 @@ uint64_t svt_psy_distortion(const uint8_t* input, uint32_t input_stride,
     return (total_nrg << 2);
 }
 
+/* AC energy of every 8x8 block of the area, in the same order svt_psy_distortion() visits them */
+void svt_psy_ac_energy_c(const uint8_t* src, uint32_t stride, uint32_t width, uint32_t height, int32_t* nrg) {
+    static uint8_t zero_buffer[8] = { 0 };
+
+    for (uint64_t i = 0; i < height; i += 8) {
+        for (uint64_t j = 0; j < width; j += 8) {
+            *nrg++ = (svt_sa8d_8x8(src + i * stride + j, stride, zero_buffer, 0) >> 8) -
+                (svt_psy_sad_nxn(8, 8, src + i * stride + j, stride, zero_buffer, 0) >> 2);
+        }
+    }
+}
+
 /*
  * 10-bit functions
  */
@@ -224,7 +238,7 @@ static int svt_psy_sad_nxn_hbd(const uint8_t bw, const uint8_t bh, const uint16_
 
     return sum;
 }
-uint64_t svt_psy_distor_hbd(const uint16_t* input, uint32_t input_stride,
+uint64_t svt_psy_distor_hbd_c(const uint16_t* input, uint32_t input_stride,
                             const uint16_t* recon, uint32_t recon_stride,
                             uint32_t width, uint32_t height,
                             const uint32_t count) {
@@ -253,6 +267,17 @@ uint64_t svt_psy_distor_hbd(const uint16_t* input, uint32_t input_stride,
     return (total_nrg << 2);
 }
 
+void svt_psy_ac_energy_hbd_c(const uint16_t* src, uint32_t stride, uint32_t width, uint32_t height, int32_t* nrg) {
+    static uint16_t zero_buffer[8] = { 0 };
+
+    for (uint64_t i = 0; i < height; i += 8) {
+        for (uint64_t j = 0; j < width; j += 8) {
+            *nrg++ = (svt_sa8d_8x8_hbd(src + i * stride + j, stride, zero_buffer, 0) >> 8) -
+                (svt_psy_sad_nxn_hbd(8, 8, src + i * stride + j, stride, zero_buffer, 0) >> 2);
+        }
+    }
+}
+
 /*
  * Public function that mirrors the arguments of `spatial_full_dist_type_fun()`
  */
@@ -264,6 +289,9 @@ uint64_t get_svt_psy_full_dist(const void* s, uint32_t so, uint32_t sp,
     uint32_t count = w * h;
     uint64_t dist;
 
+    if (psy_rd == 0.0)
+        return 0;
+
     switch (is_hbd) {
     case 1: // 10-bit
         dist = svt_psy_distor_hbd((const uint16_t*)s + so, sp, (const uint16_t*)r + ro, rp, w, h, count);
@@ -275,3 +303,85 @@ uint64_t get_svt_psy_full_dist(const void* s, uint32_t so, uint32_t sp,
 
     return (uint64_t)(dist * psy_rd);
 }
+
+/*
+ * Source-side energy cache
+ */
+
+#define PSY_NRG_INVALID INT32_MIN
+#define PSY_MAX_NRG_BLOCKS ((128 >> 3) * (128 >> 3))
+
+void svt_psy_src_nrg_cache_reset(PsySrcEnergyCache* cache, uint8_t plane, const void* src, uint32_t stride,
+                                 uint32_t org_x, uint32_t org_y, uint32_t width, uint32_t height, uint8_t is_hbd) {
+    cache->src[plane]    = src;
+    cache->stride[plane] = stride;
+    cache->org_x[plane]  = org_x;
+    cache->org_y[plane]  = org_y;
+    cache->grid_w[plane] = width >> 2;
+    cache->grid_h[plane] = height >> 2;
+    cache->hbd           = is_hbd;
+    for (uint32_t i = 0; i < cache->grid_w[plane] * cache->grid_h[plane]; i++)
+        cache->nrg[plane][i] = PSY_NRG_INVALID;
+}
+
+/*
+ * Same result as get_svt_psy_full_dist(), but the energy of the source 8x8 blocks is taken from
+ * (and added to) the cache, so only the recon side is transformed for every new candidate.
+ * Falls back to the uncached path when the source does not match the cached superblock.
+ */
+uint64_t get_svt_psy_full_dist_cached(PsySrcEnergyCache* cache, uint8_t plane,
+                                      const void* s, uint32_t so, uint32_t sp,
+                                      const void* r, uint32_t ro, uint32_t rp,
+                                      uint32_t w, uint32_t h, uint8_t is_hbd,
+                                      double psy_rd) {
+    if (psy_rd == 0.0)
+        return 0;
+    if (w * h < 64 || s != cache->src[plane] || sp != cache->stride[plane] || is_hbd != cache->hbd)
+        return get_svt_psy_full_dist(s, so, sp, r, ro, rp, w, h, is_hbd, psy_rd);
+
+    const uint32_t x      = so % sp;
+    const uint32_t y      = so / sp;
+    const uint32_t bw     = (w + 7) >> 3;
+    const uint32_t bh     = (h + 7) >> 3;
+    const uint32_t grid_w = cache->grid_w[plane];
+    if (x < cache->org_x[plane] || y < cache->org_y[plane] ||
+        ((x - cache->org_x[plane]) | (y - cache->org_y[plane])) & 3 ||
+        ((x - cache->org_x[plane]) >> 2) + ((bw - 1) << 1) >= grid_w ||
+        ((y - cache->org_y[plane]) >> 2) + ((bh - 1) << 1) >= cache->grid_h[plane])
+        return get_svt_psy_full_dist(s, so, sp, r, ro, rp, w, h, is_hbd, psy_rd);
+
+    // 8x8 windows are 2 grid entries apart
+    int32_t* src_nrg = cache->nrg[plane] + ((y - cache->org_y[plane]) >> 2) * grid_w +
+        ((x - cache->org_x[plane]) >> 2);
+    int32_t nrg[PSY_MAX_NRG_BLOCKS];
+    bool    complete = true;
+
+    for (uint32_t i = 0; i < bh && complete; i++)
+        for (uint32_t j = 0; j < bw; j++)
+            if (src_nrg[(i * grid_w + j) << 1] == PSY_NRG_INVALID) {
+                complete = false;
+                break;
+            }
+    if (!complete) {
+        if (is_hbd == 1)
+            svt_psy_ac_energy_hbd((const uint16_t*)s + so, sp, w, h, nrg);
+        else
+            svt_psy_ac_energy((const uint8_t*)s + so, sp, w, h, nrg);
+        for (uint32_t i = 0; i < bh; i++)
+            for (uint32_t j = 0; j < bw; j++)
+                src_nrg[(i * grid_w + j) << 1] = nrg[i * bw + j];
+    }
+
+    if (is_hbd == 1)
+        svt_psy_ac_energy_hbd((const uint16_t*)r + ro, rp, w, h, nrg);
+    else
+        svt_psy_ac_energy((const uint8_t*)r + ro, rp, w, h, nrg);
+
+    uint32_t total_nrg = 0;
+    for (uint32_t i = 0; i < bh; i++)
+        for (uint32_t j = 0; j < bw; j++)
+            total_nrg += (uint32_t)abs(src_nrg[(i * grid_w + j) << 1] - nrg[i * bw + j]);
+
+    const uint64_t dist = (uint32_t)(total_nrg << 2);
+    return (uint64_t)(dist * psy_rd);
+}
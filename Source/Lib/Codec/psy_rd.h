@@ -9,16 +9,36 @@
 * PATENTS file, you can obtain it at https://www.aomedia.org/license/patent-license.
 */
 
+#ifndef EbPsyRd_h
+#define EbPsyRd_h
+
 #include <stdint.h>
 
 #ifdef __cplusplus
 extern "C" {
 #endif
 
-uint64_t svt_psy_distortion(const uint8_t* input, uint32_t input_stride, const uint8_t* recon, uint32_t recon_stride, uint32_t width, uint32_t height, const uint32_t count);
-uint64_t svt_psy_distor_hbd(const uint16_t* input, uint32_t input_stride, const uint16_t* recon, uint32_t recon_stride, uint32_t width, uint32_t height, const uint32_t count);
+/*
+ * AC energy of the source 8x8 windows of one superblock, per plane. Entries are kept on a
+ * 4-pixel grid relative to (org_x, org_y) so that every block position MD can test maps to one.
+ */
+typedef struct PsySrcEnergyCache {
+    const void* src[3];
+    uint32_t    stride[3];
+    uint32_t    org_x[3];
+    uint32_t    org_y[3];
+    uint32_t    grid_w[3];
+    uint32_t    grid_h[3];
+    int32_t*    nrg[3];
+    uint8_t     hbd;
+} PsySrcEnergyCache;
+
 uint64_t get_svt_psy_full_dist(const void* s, uint32_t so, uint32_t sp, const void* r, uint32_t ro, uint32_t rp, uint32_t w, uint32_t h, uint8_t is_hbd, double psy_rd);
+void     svt_psy_src_nrg_cache_reset(PsySrcEnergyCache* cache, uint8_t plane, const void* src, uint32_t stride,
+                                     uint32_t org_x, uint32_t org_y, uint32_t width, uint32_t height, uint8_t is_hbd);
+uint64_t get_svt_psy_full_dist_cached(PsySrcEnergyCache* cache, uint8_t plane, const void* s, uint32_t so, uint32_t sp, const void* r, uint32_t ro, uint32_t rp, uint32_t w, uint32_t h, uint8_t is_hbd, double psy_rd);
 
 #ifdef __cplusplus
 }
 #endif
+#endif // EbPsyRd_h
@@ -0,0 +1,528 @@
+/*
+* Copyright (c) 2024, Alliance for Open Media. All rights reserved
+*
+* This source code is subject to the terms of the BSD 2 Clause License and
+* the Alliance for Open Media Patent License 1.0. If the BSD 2 Clause License
+* was not distributed with this source code in the LICENSE file, you can
+* obtain it at https://www.aomedia.org/license/software-license. If the Alliance for Open
+* Media Patent License 1.0 was not distributed with this source code in the
+* PATENTS file, you can obtain it at https://www.aomedia.org/license/patent-license.
+*/
+
+#include <math.h>
+#include <string.h>
+
+#include "quality_metrics.h"
+#include "pcs.h"
+#include "sequence_control_set.h"
+#include "aom_dsp_rtcd.h"
+#include "common_dsp_rtcd.h"
+#include "pic_operators.h"
+#include "resize.h"
+#include "svt_threads.h"
+#include "svt_malloc.h"
+
+void svt_aom_get_recon_pic(PictureControlSet *pcs, EbPictureBufferDesc **recon_ptr, Bool is_highbd);
+void free_temporal_filtering_buffer(PictureControlSet *pcs, SequenceControlSet *scs);
+
+typedef struct MetricsPlane {
+    uint8_t *src; // 8 msb of high bit depth sources
+    uint8_t *inc; // 2 lsb of high bit depth sources
+    uint8_t *rec; // uint16_t samples for high bit depth
+    uint32_t src_stride;
+    uint32_t inc_stride;
+    uint32_t rec_stride;
+    uint32_t width;
+    uint32_t height;
+} MetricsPlane;
+
+typedef struct MetricsBandStats {
+    uint64_t sse[3];
+    double   ssim[3];
+    uint32_t ssim_windows[3];
+    // luma contrast-structure per scale, SSIM for the coarsest one
+    double   ms[MS_SSIM_SCALES];
+    uint32_t ms_windows[MS_SSIM_SCALES];
+} MetricsBandStats;
+
+typedef struct PictureMetrics {
+    MetricsPlane         plane[3];
+    EbPictureBufferDesc *upscaled_recon;
+    Bool                 hbd;
+    // 2 lsb packed 4 pixels per byte in the input picture, else one per byte (temporal filtering copy)
+    Bool              inc_compressed;
+    uint32_t          bd;
+    uint32_t          ss_y;
+    uint32_t          height;
+    uint32_t          ms_scales;
+    uint32_t          band_count;
+    volatile int32_t  next_band;
+    volatile int32_t  users;
+    MetricsBandStats *bands;
+} PictureMetrics;
+
+/* Rows of the source and recon of one scale, starting at row top; uint16_t samples when hbd */
+typedef struct MetricsView {
+    const uint8_t *src;
+    const uint8_t *rec;
+    uint32_t       src_stride;
+    uint32_t       rec_stride;
+    uint32_t       top;
+    Bool           hbd;
+} MetricsView;
+
+static const double ms_ssim_weights[MS_SSIM_SCALES] = {0.0448, 0.2856, 0.3001, 0.2363, 0.1333};
+
+void svt_ssim_4x4_sums_c(const uint8_t *s, uint32_t sp, const uint8_t *r, uint32_t rp, uint32_t count,
+                         uint32_t *sums) {
+    for (uint32_t i = 0; i < count; i++, s += 4, r += 4, sums += 4) {
+        uint32_t sum_s = 0, sum_r = 0, sum_sq = 0, sum_sxr = 0;
+        for (int y = 0; y < 4; y++) {
+            for (int x = 0; x < 4; x++) {
+                const uint32_t a = s[y * sp + x];
+                const uint32_t b = r[y * rp + x];
+                sum_s += a;
+                sum_r += b;
+                sum_sq += a * a + b * b;
+                sum_sxr += a * b;
+            }
+        }
+        sums[0] = sum_s;
+        sums[1] = sum_r;
+        sums[2] = sum_sq;
+        sums[3] = sum_sxr;
+    }
+}
+
+void svt_ssim_4x4_sums_hbd_c(const uint16_t *s, uint32_t sp, const uint16_t *r, uint32_t rp, uint32_t count,
+                             uint32_t *sums) {
+    for (uint32_t i = 0; i < count; i++, s += 4, r += 4, sums += 4) {
+        uint32_t sum_s = 0, sum_r = 0, sum_sq = 0, sum_sxr = 0;
+        for (int y = 0; y < 4; y++) {
+            for (int x = 0; x < 4; x++) {
+                const uint32_t a = s[y * sp + x];
+                const uint32_t b = r[y * rp + x];
+                sum_s += a;
+                sum_r += b;
+                sum_sq += a * a + b * b;
+                sum_sxr += a * b;
+            }
+        }
+        sums[0] = sum_s;
+        sums[1] = sum_r;
+        sums[2] = sum_sq;
+        sums[3] = sum_sxr;
+    }
+}
+
+static const int64_t cc1    = 26634; // (64^2*(.01*255)^2
+static const int64_t cc2    = 239708; // (64^2*(.03*255)^2
+static const int64_t cc1_10 = 428658; // (64^2*(.01*1023)^2
+static const int64_t cc2_10 = 3857925; // (64^2*(.03*1023)^2
+static const int64_t cc1_12 = 6868593; // (64^2*(.01*4095)^2
+static const int64_t cc2_12 = 61817334; // (64^2*(.03*4095)^2
+
+static void ssim_constants(int count, uint32_t bd, int64_t *c1, int64_t *c2) {
+    // scale the constants by number of pixels
+    if (bd == 8) {
+        *c1 = (cc1 * count * count) >> 12;
+        *c2 = (cc2 * count * count) >> 12;
+    } else if (bd == 10) {
+        *c1 = (cc1_10 * count * count) >> 12;
+        *c2 = (cc2_10 * count * count) >> 12;
+    } else if (bd == 12) {
+        *c1 = (cc1_12 * count * count) >> 12;
+        *c2 = (cc2_12 * count * count) >> 12;
+    } else {
+        *c1 = *c2 = 0;
+        assert(0);
+    }
+}
+
+double svt_aom_similarity(uint32_t sum_s, uint32_t sum_r, uint32_t sum_sq_s, uint32_t sum_sq_r, uint32_t sum_sxr,
+                          int count, uint32_t bd) {
+    double  ssim_n, ssim_d;
+    int64_t c1, c2;
+
+    ssim_constants(count, bd, &c1, &c2);
+
+    ssim_n = (2.0 * sum_s * sum_r + c1) * (2.0 * count * sum_sxr - 2.0 * sum_s * sum_r + c2);
+
+    ssim_d = ((double)sum_s * sum_s + (double)sum_r * sum_r + c1) *
+        ((double)count * sum_sq_s - (double)sum_s * sum_s + (double)count * sum_sq_r - (double)sum_r * sum_r + c2);
+
+    return ssim_n / ssim_d;
+}
+
+// contrast-structure term of SSIM, sum_sq holding the squares of both the source and the recon
+static double contrast_structure(uint32_t sum_s, uint32_t sum_r, uint32_t sum_sq, uint32_t sum_sxr, int count,
+                                 uint32_t bd) {
+    int64_t c1, c2;
+    ssim_constants(count, bd, &c1, &c2);
+    return (2.0 * count * sum_sxr - 2.0 * sum_s * sum_r + c2) /
+        ((double)count * sum_sq - (double)sum_s * sum_s - (double)sum_r * sum_r + c2);
+}
+
+static void metrics_scratch_dctor(EbPtr p) {
+    MetricsScratch *obj = (MetricsScratch *)p;
+    EB_FREE_ARRAY(obj->src16);
+    EB_FREE_ARRAY(obj->pyramid[0][0]);
+    EB_FREE_ARRAY(obj->pyramid[0][1]);
+    EB_FREE_ARRAY(obj->pyramid[1][0]);
+    EB_FREE_ARRAY(obj->pyramid[1][1]);
+    EB_FREE_ARRAY(obj->blocks);
+}
+
+EbErrorType svt_aom_metrics_scratch_ctor(MetricsScratch *scratch, const SequenceControlSet *scs) {
+    const uint32_t max_w = scs->max_input_luma_width;
+    scratch->dctor       = metrics_scratch_dctor;
+    scratch->max_width   = max_w;
+    // a band reads up to twice its height of full resolution rows to build the coarser scales
+    if (scs->static_config.encoder_bit_depth > EB_EIGHT_BIT)
+        EB_MALLOC_ARRAY(scratch->src16, (2 * METRICS_BAND_HEIGHT + 2) * max_w);
+    EB_MALLOC_ARRAY(scratch->pyramid[0][0], METRICS_BAND_HEIGHT * (max_w / 2));
+    EB_MALLOC_ARRAY(scratch->pyramid[0][1], METRICS_BAND_HEIGHT * (max_w / 2));
+    EB_MALLOC_ARRAY(scratch->pyramid[1][0], METRICS_BAND_HEIGHT * (max_w / 2));
+    EB_MALLOC_ARRAY(scratch->pyramid[1][1], METRICS_BAND_HEIGHT * (max_w / 2));
+    EB_MALLOC_ARRAY(scratch->blocks, (METRICS_BAND_HEIGHT / 4 + 1) * (max_w / 4) * 4);
+    return EB_ErrorNone;
+}
+
+static INLINE uint32_t view_px(const uint8_t *buf, uint32_t stride, Bool hbd, uint32_t y, uint32_t x) {
+    return hbd ? ((const uint16_t *)buf)[y * stride + x] : buf[y * stride + x];
+}
+
+static void block_row_sums(const MetricsView *v, uint32_t by, uint32_t wb, uint32_t *sums) {
+    const uint32_t y = 4 * by - v->top;
+    if (v->hbd)
+        svt_ssim_4x4_sums_hbd((const uint16_t *)v->src + y * v->src_stride,
+                              v->src_stride,
+                              (const uint16_t *)v->rec + y * v->rec_stride,
+                              v->rec_stride,
+                              wb,
+                              sums);
+    else
+        svt_ssim_4x4_sums(v->src + y * v->src_stride, v->src_stride, v->rec + y * v->rec_stride, v->rec_stride, wb, sums);
+}
+
+// SSE of rows [y0, y1): the full 4x4 blocks come from their sums (s^2 + r^2 - 2sr), the right and
+// bottom remainders are summed per pixel
+static uint64_t band_sse(const MetricsView *v, const uint32_t *blocks, uint32_t blk_top, uint32_t w, uint32_t y0,
+                         uint32_t y1) {
+    const uint32_t wb     = w / 4;
+    const uint32_t by_end = y1 / 4;
+    uint64_t       sse    = 0;
+    for (uint32_t by = blk_top; by < by_end; by++) {
+        const uint32_t *b = blocks + (by - blk_top) * wb * 4;
+        for (uint32_t bx = 0; bx < wb; bx++, b += 4) sse += (int64_t)b[2] - 2 * (int64_t)b[3];
+    }
+    for (uint32_t y = y0; y < y1; y++) {
+        const uint32_t x0 = y < 4 * by_end ? 4 * wb : 0;
+        for (uint32_t x = x0; x < w; x++) {
+            const int32_t d = (int32_t)view_px(v->src, v->src_stride, v->hbd, y - v->top, x) -
+                (int32_t)view_px(v->rec, v->rec_stride, v->hbd, y - v->top, x);
+            sse += d * d;
+        }
+    }
+    return sse;
+}
+
+// Scores the 8x8 windows whose top left 4x4 blocks are in the first rows of blocks
+static void score_windows(const uint32_t *blocks, uint32_t wb, uint32_t rows, uint32_t bd, double *ssim,
+                          double *cs) {
+    double sum_ssim = 0, sum_cs = 0;
+    for (uint32_t by = 0; by < rows; by++) {
+        const uint32_t *b0 = blocks + by * wb * 4;
+        const uint32_t *b1 = b0 + wb * 4;
+        for (uint32_t bx = 0; bx + 1 < wb; bx++, b0 += 4, b1 += 4) {
+            const uint32_t sum_s   = b0[0] + b0[4] + b1[0] + b1[4];
+            const uint32_t sum_r   = b0[1] + b0[5] + b1[1] + b1[5];
+            const uint32_t sum_sq  = b0[2] + b0[6] + b1[2] + b1[6];
+            const uint32_t sum_sxr = b0[3] + b0[7] + b1[3] + b1[7];
+            sum_ssim += svt_aom_similarity(sum_s, sum_r, sum_sq, 0, sum_sxr, 64, bd);
+            if (cs)
+                sum_cs += contrast_structure(sum_s, sum_r, sum_sq, sum_sxr, 64, bd);
+        }
+    }
+    *ssim = sum_ssim;
+    if (cs)
+        *cs = sum_cs;
+}
+
+// 2x2 averages of the rows [2 * j0, 2 * j1) of v
+static void downsample(const MetricsView *v, uint32_t j0, uint32_t j1, uint32_t w, uint16_t *dst_s, uint16_t *dst_r,
+                       uint32_t dst_stride) {
+    for (uint32_t j = j0; j < j1; j++) {
+        const uint32_t y  = 2 * j - v->top;
+        uint16_t      *ds = dst_s + (j - j0) * dst_stride;
+        uint16_t      *dr = dst_r + (j - j0) * dst_stride;
+        for (uint32_t x = 0; x < w; x++) {
+            ds[x] = (uint16_t)((view_px(v->src, v->src_stride, v->hbd, y, 2 * x) +
+                                view_px(v->src, v->src_stride, v->hbd, y, 2 * x + 1) +
+                                view_px(v->src, v->src_stride, v->hbd, y + 1, 2 * x) +
+                                view_px(v->src, v->src_stride, v->hbd, y + 1, 2 * x + 1) + 2) >>
+                               2);
+            dr[x] = (uint16_t)((view_px(v->rec, v->rec_stride, v->hbd, y, 2 * x) +
+                                view_px(v->rec, v->rec_stride, v->hbd, y, 2 * x + 1) +
+                                view_px(v->rec, v->rec_stride, v->hbd, y + 1, 2 * x) +
+                                view_px(v->rec, v->rec_stride, v->hbd, y + 1, 2 * x + 1) + 2) >>
+                               2);
+        }
+    }
+}
+
+/* A band owns the SSE of its rows and the windows whose top left corner is in them, at every scale.
+ * The windows at the bottom read 4 rows of the next band, and the coarser scales are built from the
+ * rows of the band and below, so a band never depends on the work of another */
+static void score_plane_band(PictureMetrics *m, MetricsScratch *scratch, uint32_t plane, uint32_t band,
+                             MetricsBandStats *st) {
+    const MetricsPlane *p      = &m->plane[plane];
+    const uint32_t      ss_y   = plane ? m->ss_y : 0;
+    const uint32_t      w      = p->width;
+    const uint32_t      h      = p->height;
+    const uint32_t      y0     = (band * METRICS_BAND_HEIGHT) >> ss_y;
+    const uint32_t      y1     = AOMMIN((band + 1) * METRICS_BAND_HEIGHT, m->height) >> ss_y;
+    const uint32_t      scales = plane ? 1 : m->ms_scales;
+    uint32_t            blk_top[MS_SSIM_SCALES], blk_end[MS_SSIM_SCALES], need[MS_SSIM_SCALES + 1];
+
+    // rows each scale has to provide, for its own windows and for the next scale
+    need[scales] = 0;
+    for (int32_t k = scales - 1; k >= 0; k--) {
+        const uint32_t hb = (h >> k) / 4;
+        blk_top[k]        = (y0 >> k) / 4;
+        blk_end[k]        = AOMMIN((y1 >> k) / 4 + 1, hb);
+        need[k]           = AOMMAX(AOMMAX(4 * blk_end[k], 2 * need[k + 1]), y0 >> k);
+    }
+    need[0] = AOMMAX(need[0], y1);
+
+    MetricsView v;
+    v.hbd        = m->hbd;
+    v.top        = y0;
+    v.rec_stride = p->rec_stride;
+    v.rec        = p->rec + ((size_t)y0 * p->rec_stride << m->hbd);
+    if (m->hbd) {
+        // the packing kernels work on 4 pixel wide and 2 row high units, the padding covers the excess
+        const uint32_t rows = (need[0] - y0 + 1) & ~1;
+        if (m->inc_compressed)
+            svt_compressed_packmsb(p->src + y0 * p->src_stride,
+                                   p->src_stride,
+                                   p->inc + y0 * p->inc_stride,
+                                   p->inc_stride,
+                                   scratch->src16,
+                                   scratch->max_width,
+                                   (w + 3) & ~3,
+                                   rows);
+        else
+            svt_aom_pack2d_src(p->src + y0 * p->src_stride,
+                               p->src_stride,
+                               p->inc + y0 * p->inc_stride,
+                               p->inc_stride,
+                               scratch->src16,
+                               scratch->max_width,
+                               (w + 3) & ~3,
+                               rows);
+        v.src        = (const uint8_t *)scratch->src16;
+        v.src_stride = scratch->max_width;
+    } else {
+        v.src        = p->src + y0 * p->src_stride;
+        v.src_stride = p->src_stride;
+    }
+
+    for (uint32_t k = 0; k < scales; k++) {
+        const uint32_t wk = w >> k;
+        const uint32_t hk = h >> k;
+        const uint32_t wb = wk / 4;
+        const uint32_t hb = hk / 4;
+        for (uint32_t by = blk_top[k]; by < blk_end[k]; by++)
+            block_row_sums(&v, by, wb, scratch->blocks + (by - blk_top[k]) * wb * 4);
+        if (k == 0)
+            st->sse[plane] += band_sse(&v, scratch->blocks, blk_top[0], w, y0, y1);
+
+        const uint32_t top_end = AOMMIN(((y1 >> k) + 3) / 4, hb - 1);
+        if (wk > 8 && hk > 8 && top_end > blk_top[k]) {
+            const uint32_t rows    = top_end - blk_top[k];
+            const uint32_t windows = rows * (wb - 1);
+            const Bool     last    = k == scales - 1;
+            double         ssim, cs = 0;
+            score_windows(scratch->blocks, wb, rows, m->bd, &ssim, last ? NULL : &cs);
+            if (k == 0) {
+                st->ssim[plane] += ssim;
+                st->ssim_windows[plane] += windows;
+            }
+            if (plane == 0) {
+                st->ms[k] += last ? ssim : cs;
+                st->ms_windows[k] += windows;
+            }
+        }
+        if (k + 1 < scales) {
+            const uint32_t stride = scratch->max_width / 2;
+            uint16_t      *dst_s  = scratch->pyramid[k & 1][0];
+            uint16_t      *dst_r  = scratch->pyramid[k & 1][1];
+            downsample(&v, y0 >> (k + 1), need[k + 1], w >> (k + 1), dst_s, dst_r, stride);
+            v.src        = (const uint8_t *)dst_s;
+            v.rec        = (const uint8_t *)dst_r;
+            v.src_stride = v.rec_stride = stride;
+            v.top                       = y0 >> (k + 1);
+            v.hbd                       = TRUE;
+        }
+    }
+}
+
+static double ms_ssim(const MetricsBandStats *total, uint32_t scales) {
+    if (!total->ms_windows[0])
+        return NAN;
+    double weight_sum = 0, score = 1;
+    for (uint32_t k = 0; k < scales; k++) weight_sum += ms_ssim_weights[k];
+    for (uint32_t k = 0; k < scales; k++) {
+        const double mean = total->ms_windows[k] ? total->ms[k] / total->ms_windows[k] : 0;
+        score *= pow(AOMMAX(mean, 0), ms_ssim_weights[k] / weight_sum);
+    }
+    return score;
+}
+
+// Reduces the bands in order and releases the picture state
+static void metrics_finish(PictureControlSet *pcs) {
+    PictureMetrics          *m     = pcs->metrics;
+    PictureParentControlSet *ppcs  = pcs->ppcs;
+    MetricsBandStats         total;
+    memset(&total, 0, sizeof(total));
+    for (uint32_t b = 0; b < m->band_count; b++) {
+        const MetricsBandStats *st = &m->bands[b];
+        for (int p = 0; p < 3; p++) {
+            total.sse[p] += st->sse[p];
+            total.ssim[p] += st->ssim[p];
+            total.ssim_windows[p] += st->ssim_windows[p];
+        }
+        for (uint32_t k = 0; k < m->ms_scales; k++) {
+            total.ms[k] += st->ms[k];
+            total.ms_windows[k] += st->ms_windows[k];
+        }
+    }
+    ppcs->luma_sse     = total.sse[0];
+    ppcs->cb_sse       = total.sse[1];
+    ppcs->cr_sse       = total.sse[2];
+    ppcs->luma_ssim    = total.ssim_windows[0] ? total.ssim[0] / total.ssim_windows[0] : NAN;
+    ppcs->cb_ssim      = total.ssim_windows[1] ? total.ssim[1] / total.ssim_windows[1] : NAN;
+    ppcs->cr_ssim      = total.ssim_windows[2] ? total.ssim[2] / total.ssim_windows[2] : NAN;
+    ppcs->luma_ms_ssim = ms_ssim(&total, m->ms_scales);
+
+    EB_DELETE(m->upscaled_recon);
+    free_temporal_filtering_buffer(pcs, pcs->scs);
+    EB_FREE_ARRAY(m->bands);
+    EB_FREE_ARRAY(m);
+    pcs->metrics = NULL;
+}
+
+EbErrorType svt_aom_metrics_start(PictureControlSet *pcs, uint32_t max_threads, uint32_t *helpers) {
+    SequenceControlSet      *scs       = pcs->scs;
+    PictureParentControlSet *ppcs      = pcs->ppcs;
+    const Bool               hbd       = scs->static_config.encoder_bit_depth > EB_EIGHT_BIT;
+    EbPictureBufferDesc     *input_pic = ppcs->enhanced_unscaled_pic;
+    EbPictureBufferDesc     *recon;
+    PictureMetrics          *m;
+
+    EB_CALLOC_ARRAY(m, 1);
+    svt_aom_get_recon_pic(pcs, &recon, hbd);
+    // upscale recon if resized
+    if (recon->width != input_pic->width || recon->height != input_pic->height) {
+        superres_params_type spr_params = {input_pic->width, input_pic->height, 0};
+        svt_aom_downscaled_source_buffer_desc_ctor(&m->upscaled_recon, recon, spr_params);
+        svt_aom_resize_frame(recon,
+                             m->upscaled_recon,
+                             scs->static_config.encoder_bit_depth,
+                             av1_num_planes(&scs->seq_header.color_config),
+                             scs->subsampling_x,
+                             scs->subsampling_y,
+                             recon->packed_flag,
+                             PICTURE_BUFFER_DESC_FULL_MASK,
+                             0); // is_2bcompress
+        recon = m->upscaled_recon;
+    }
+
+    m->hbd            = hbd;
+    m->bd             = scs->static_config.encoder_bit_depth;
+    m->ss_y           = scs->subsampling_y;
+    m->height         = input_pic->height - scs->max_input_pad_bottom;
+    m->inc_compressed = !ppcs->do_tf;
+
+    // if the source picture was temporally filtered, use the copy of the original source
+    uint8_t *src_buf[3] = {input_pic->buffer_y, input_pic->buffer_cb, input_pic->buffer_cr};
+    uint8_t *inc_buf[3] = {input_pic->buffer_bit_inc_y, input_pic->buffer_bit_inc_cb, input_pic->buffer_bit_inc_cr};
+    if (ppcs->do_tf) {
+        assert(ppcs->save_source_picture_width == input_pic->width &&
+               ppcs->save_source_picture_height == input_pic->height);
+        for (int p = 0; p < 3; p++) {
+            src_buf[p] = ppcs->save_source_picture_ptr[p];
+            inc_buf[p] = ppcs->save_source_picture_bit_inc_ptr[p];
+        }
+    }
+    const uint32_t src_stride[3] = {input_pic->stride_y, input_pic->stride_cb, input_pic->stride_cr};
+    const uint32_t inc_stride[3] = {
+        input_pic->stride_bit_inc_y, input_pic->stride_bit_inc_cb, input_pic->stride_bit_inc_cr};
+    uint8_t *const rec_buf[3]    = {recon->buffer_y, recon->buffer_cb, recon->buffer_cr};
+    const uint32_t rec_stride[3] = {recon->stride_y, recon->stride_cb, recon->stride_cr};
+    for (int p = 0; p < 3; p++) {
+        MetricsPlane  *plane = &m->plane[p];
+        const uint32_t ss_x  = p ? scs->subsampling_x : 0;
+        const uint32_t ss_y  = p ? scs->subsampling_y : 0;
+        const uint32_t org_x = input_pic->org_x >> ss_x;
+        const uint32_t org_y = input_pic->org_y >> ss_y;
+        plane->width         = (input_pic->width - scs->max_input_pad_right) >> ss_x;
+        plane->height        = m->height >> ss_y;
+        plane->src_stride    = src_stride[p];
+        plane->src           = src_buf[p] + org_y * src_stride[p] + org_x;
+        plane->rec_stride    = rec_stride[p];
+        plane->rec = rec_buf[p] + (((recon->org_y >> ss_y) * rec_stride[p] + (recon->org_x >> ss_x)) << hbd);
+        if (!hbd)
+            continue;
+        if (m->inc_compressed) {
+            assert(!(org_x & 3));
+            plane->inc_stride = inc_stride[p] / 4;
+            plane->inc        = inc_buf[p] + org_y * plane->inc_stride + org_x / 4;
+        } else {
+            plane->inc_stride = inc_stride[p];
+            plane->inc        = inc_buf[p] + org_y * inc_stride[p] + org_x;
+        }
+    }
+
+    const uint32_t w = m->plane[0].width;
+    m->ms_scales     = 1;
+    while (m->ms_scales < MS_SSIM_SCALES && (w >> m->ms_scales) > 8 && (m->height >> m->ms_scales) > 8)
+        m->ms_scales++;
+    m->band_count = (m->height + METRICS_BAND_HEIGHT - 1) / METRICS_BAND_HEIGHT;
+    EB_CALLOC_ARRAY(m->bands, m->band_count);
+
+    const uint32_t participants = AOMMAX(AOMMIN(m->band_count, max_threads), 1);
+    *helpers                    = participants - 1;
+    m->users                    = (int32_t)participants;
+    m->next_band                = 0;
+    pcs->metrics                = m;
+    return EB_ErrorNone;
+}
+
+Bool svt_aom_metrics_process(PictureControlSet *pcs, MetricsScratch *scratch) {
+    PictureMetrics *m = pcs->metrics;
+    for (;;) {
+        const int32_t band = svt_atomic_fetch_add_i32(&m->next_band, 1);
+        if (band >= (int32_t)m->band_count)
+            break;
+        for (uint32_t plane = 0; plane < 3; plane++)
+            score_plane_band(m, scratch, plane, (uint32_t)band, &m->bands[band]);
+    }
+    // the last one out has seen the writes of all the others
+    if (svt_atomic_fetch_add_i32(&m->users, -1) != 1)
+        return FALSE;
+    metrics_finish(pcs);
+    return TRUE;
+}
+
+EbErrorType svt_aom_metrics_calculations(PictureControlSet *pcs) {
+    MetricsScratch *scratch;
+    uint32_t        helpers;
+    EB_NEW(scratch, svt_aom_metrics_scratch_ctor, pcs->scs);
+    EbErrorType return_error = svt_aom_metrics_start(pcs, 1, &helpers);
+    if (return_error == EB_ErrorNone)
+        svt_aom_metrics_process(pcs, scratch);
+    EB_DELETE(scratch);
+    return return_error;
+}
@@ -0,0 +1,64 @@
+/*
+* Copyright (c) 2024, Alliance for Open Media. All rights reserved
+*
+* This source code is subject to the terms of the BSD 2 Clause License and
+* the Alliance for Open Media Patent License 1.0. If the BSD 2 Clause License
+* was not distributed with this source code in the LICENSE file, you can
+* obtain it at https://www.aomedia.org/license/software-license. If the Alliance for Open
+* Media Patent License 1.0 was not distributed with this source code in the
+* PATENTS file, you can obtain it at https://www.aomedia.org/license/patent-license.
+*/
+
+#ifndef EbQualityMetrics_h
+#define EbQualityMetrics_h
+
+#include "definitions.h"
+#include "object.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Per-frame PSNR (SSE), SSIM and luma MS-SSIM of the source against the final recon, computed for
+ * --enable-stat-report. The frame is split into bands of METRICS_BAND_HEIGHT luma rows that are
+ * scored independently (the restoration threads pick them up once the recon is final) and reduced
+ * in band order, so the results do not depend on the thread count.
+ *
+ * SSIM uses 8x8 windows on a 4x4 grid; the window statistics are built from the 4x4 block sums of
+ * svt_ssim_4x4_sums(), which also give the SSE. MS-SSIM repeats this on up to MS_SSIM_SCALES 2x2
+ * averaged scales.
+ */
+#define METRICS_BAND_HEIGHT 64
+#define MS_SSIM_SCALES 5
+
+struct PictureControlSet;
+struct SequenceControlSet;
+
+/* Per-thread working buffers, sized for the largest band of the sequence */
+typedef struct MetricsScratch {
+    EbDctor   dctor;
+    uint32_t  max_width;
+    uint16_t *src16; // packed high bit depth source rows of a band
+    uint16_t *pyramid[2][2]; // [ping-pong][src, recon] downscaled rows
+    uint32_t *blocks; // 4x4 block sums, 4 per block
+} MetricsScratch;
+
+EbErrorType svt_aom_metrics_scratch_ctor(MetricsScratch *scratch, const struct SequenceControlSet *scs);
+
+double svt_aom_similarity(uint32_t sum_s, uint32_t sum_r, uint32_t sum_sq_s, uint32_t sum_sq_r, uint32_t sum_sxr,
+                          int count, uint32_t bd);
+
+/* Prepares pcs->metrics for up to max_threads participants and returns in *helpers how many threads
+ * besides the caller should join through svt_aom_metrics_process() */
+EbErrorType svt_aom_metrics_start(struct PictureControlSet *pcs, uint32_t max_threads, uint32_t *helpers);
+/* Scores bands until none is left. Returns TRUE for the last participant to leave, once the results
+ * are in the parent pcs and pcs->metrics has been released */
+Bool svt_aom_metrics_process(struct PictureControlSet *pcs, MetricsScratch *scratch);
+/* Scores the whole picture on the calling thread */
+EbErrorType svt_aom_metrics_calculations(struct PictureControlSet *pcs);
+
+#ifdef __cplusplus
+}
+#endif
+#endif // EbQualityMetrics_h
@@ -17,6 +17,7 @@
 #include "mathutils.h"
 #include "random.h"
 #include "common_dsp_rtcd.h"
+#include "aom_dsp_rtcd.h"
 #include "utility.h"
 
 #define MAX_MINPTS 4
@@ -30,43 +31,51 @@
 // ransac
 typedef int (*IsDegenerateFunc)(double *p);
 typedef int (*FindTransformationFunc)(int points, double *points1, double *points2, double *params);
-typedef void (*ProjectPointsDoubleFunc)(double *mat, double *points, double *proj, int n, int stride_points,
-                                        int stride_proj);
-
-static void project_points_double_translation(double *mat, double *points, double *proj, int n, int stride_points,
-                                              int stride_proj) {
-    int i;
-    for (i = 0; i < n; ++i) {
-        const double x = *(points++), y = *(points++);
-        *(proj++) = x + mat[0];
-        *(proj++) = y + mat[1];
-        points += stride_points - 2;
-        proj += stride_proj - 2;
+
+/* Accumulate the normal equations A^T A and A^T b of an n column system. Each
+ * entry is summed over the rows in order, so SIMD versions match bit-exactly. */
+void svt_av1_normal_equations_c(const double *A, int rows, int n, int stride, const double *b, double *at_a,
+                                double *atb) {
+    for (int i = 0; i < n; ++i) {
+        for (int j = i; j < n; ++j) {
+            at_a[i * n + j] = 0.0;
+            for (int k = 0; k < rows; ++k) at_a[i * n + j] += A[k * stride + i] * A[k * stride + j];
+            at_a[j * n + i] = at_a[i * n + j];
+        }
+        atb[i] = 0;
+        for (int k = 0; k < rows; ++k) atb[i] += A[k * stride + i] * b[k];
     }
 }
 
-static void project_points_double_rotzoom(double *mat, double *points, double *proj, int n, int stride_points,
-                                          int stride_proj) {
-    int i;
-    for (i = 0; i < n; ++i) {
-        const double x = *(points++), y = *(points++);
-        *(proj++) = mat[2] * x + mat[3] * y + mat[0];
-        *(proj++) = -mat[3] * x + mat[2] * y + mat[1];
-        points += stride_points - 2;
-        proj += stride_proj - 2;
+/* Project the structure-of-arrays points (x1, y1) with the affine model mat
+ * (translation and rotzoom models are stored in the same layout) and collect
+ * the points landing closer than sqrt(thresh_pow2) to (x2, y2), in index order,
+ * along with the sum of their distances and squared distances. */
+int svt_av1_ransac_find_inliers_c(const double *mat, const double *x1, const double *y1, const double *x2,
+                                  const double *y2, int npoints, double thresh_pow2, int *inlier_indices,
+                                  double *sum_distance, double *sum_distance_squared) {
+    int    num_inliers = 0;
+    double sum_d = 0.0, sum_d2 = 0.0;
+    for (int i = 0; i < npoints; ++i) {
+        const double dx            = mat[2] * x1[i] + mat[3] * y1[i] + mat[0] - x2[i];
+        const double dy            = mat[4] * x1[i] + mat[5] * y1[i] + mat[1] - y2[i];
+        const double distance_pow2 = dx * dx + dy * dy;
+        if (distance_pow2 < thresh_pow2) {
+            inlier_indices[num_inliers++] = i;
+            sum_d += sqrt(distance_pow2);
+            sum_d2 += distance_pow2;
+        }
     }
+    *sum_distance         = sum_d;
+    *sum_distance_squared = sum_d2;
+    return num_inliers;
 }
 
-static void project_points_double_affine(double *mat, double *points, double *proj, int n, int stride_points,
-                                         int stride_proj) {
-    int i;
-    for (i = 0; i < n; ++i) {
-        const double x = *(points++), y = *(points++);
-        *(proj++) = mat[2] * x + mat[3] * y + mat[0];
-        *(proj++) = mat[4] * x + mat[5] * y + mat[1];
-        points += stride_points - 2;
-        proj += stride_proj - 2;
-    }
+static int least_squares_fit(int n, double *A, int rows, double *b, double *scratch, double *x) {
+    double *at_a = scratch;
+    double *atb  = scratch + n * n;
+    svt_av1_normal_equations(A, rows, n, n, b, at_a, atb);
+    return linsolve(n, at_a, n, atb, x);
 }
 
 static void normalize_homography(double *pts, int n, double *T) {
@@ -238,7 +247,7 @@ static int find_rotzoom(int np, double *pts1, double *pts2, double *mat) {
         b[2 * i]     = dx;
         b[2 * i + 1] = dy;
     }
-    if (!least_squares(4, a, np2, 4, b, temp, mat)) {
+    if (!least_squares_fit(4, a, np2, b, temp, mat)) {
         free(a);
         return 1;
     }
@@ -282,7 +291,7 @@ static int find_affine(int np, double *pts1, double *pts2, double *mat) {
         b[2 * i]     = dx;
         b[2 * i + 1] = dy;
     }
-    if (!least_squares(6, a, np2, 6, b, temp, mat)) {
+    if (!least_squares_fit(6, a, np2, b, temp, mat)) {
         free(a);
         return 1;
     }
@@ -359,7 +368,7 @@ static void clear_motion(RANSAC_MOTION *motion, int num_points) {
 
 static int ransac(const int *matched_points, int npoints, int *num_inliers_by_motion, MotionModel *params_by_motion,
                   int num_desired_motions, int minpts, IsDegenerateFunc is_degenerate,
-                  FindTransformationFunc find_transformation, ProjectPointsDoubleFunc projectpoints) {
+                  FindTransformationFunc find_transformation) {
     int trial_count = 0;
     int ret_val     = 0;
 
@@ -369,7 +378,8 @@ static int ransac(const int *matched_points, int npoints, int *num_inliers_by_mo
 
     double *points1, *points2;
     double *corners1, *corners2;
-    double *image1_coord;
+    // Structure-of-arrays copy of the correspondences for inlier evaluation.
+    double *soa_points, *x1, *y1, *x2, *y2;
 
     // Store information for the num_desired_motions best transformations found
     // and the worst motion among them, as well as the motion currently under
@@ -392,7 +402,7 @@ static int ransac(const int *matched_points, int npoints, int *num_inliers_by_mo
     points2      = (double *)malloc(sizeof(*points2) * npoints * 2);
     corners1     = (double *)malloc(sizeof(*corners1) * npoints * 2);
     corners2     = (double *)malloc(sizeof(*corners2) * npoints * 2);
-    image1_coord = (double *)malloc(sizeof(*image1_coord) * npoints * 2);
+    soa_points   = (double *)malloc(sizeof(*soa_points) * npoints * 4);
 
     motions = (RANSAC_MOTION *)malloc(sizeof(RANSAC_MOTION) * num_desired_motions);
     assert(motions != NULL);
@@ -405,18 +415,22 @@ static int ransac(const int *matched_points, int npoints, int *num_inliers_by_mo
 
     worst_kept_motion = motions;
 
-    if (!(points1 && points2 && corners1 && corners2 && image1_coord && motions && current_motion.inlier_indices)) {
+    if (!(points1 && points2 && corners1 && corners2 && soa_points && motions && current_motion.inlier_indices)) {
         ret_val = 1;
         goto finish_ransac;
     }
 
     cnp1 = corners1;
     cnp2 = corners2;
+    x1   = soa_points;
+    y1   = x1 + npoints;
+    x2   = y1 + npoints;
+    y2   = x2 + npoints;
     for (int i = 0; i < npoints; ++i) {
-        *(cnp1++) = *(matched_points++);
-        *(cnp1++) = *(matched_points++);
-        *(cnp2++) = *(matched_points++);
-        *(cnp2++) = *(matched_points++);
+        *(cnp1++) = x1[i] = *(matched_points++);
+        *(cnp1++) = y1[i] = *(matched_points++);
+        *(cnp2++) = x2[i] = *(matched_points++);
+        *(cnp2++) = y2[i] = *(matched_points++);
     }
 
     while (MIN_TRIALS > trial_count) {
@@ -450,19 +464,16 @@ static int ransac(const int *matched_points, int npoints, int *num_inliers_by_mo
             continue;
         }
 
-        projectpoints(params_this_motion, corners1, image1_coord, npoints, 2, 2);
-
-        for (int i = 0; i < npoints; ++i) {
-            double dx            = image1_coord[i * 2] - corners2[i * 2];
-            double dy            = image1_coord[i * 2 + 1] - corners2[i * 2 + 1];
-            double distance_pow2 = dx * dx + dy * dy;
-
-            if (distance_pow2 < INLIER_THRESHOLD_POW2) {
-                current_motion.inlier_indices[current_motion.num_inliers++] = i;
-                sum_distance += sqrt(distance_pow2);
-                sum_distance_squared += distance_pow2;
-            }
-        }
+        current_motion.num_inliers = svt_av1_ransac_find_inliers(params_this_motion,
+                                                                 x1,
+                                                                 y1,
+                                                                 x2,
+                                                                 y2,
+                                                                 npoints,
+                                                                 INLIER_THRESHOLD_POW2,
+                                                                 current_motion.inlier_indices,
+                                                                 &sum_distance,
+                                                                 &sum_distance_squared);
 
         if (current_motion.num_inliers >= worst_kept_motion->num_inliers && current_motion.num_inliers > 1) {
             double mean_distance;
@@ -525,7 +536,7 @@ finish_ransac:
     free(points2);
     free(corners1);
     free(corners2);
-    free(image1_coord);
+    free(soa_points);
     free(current_motion.inlier_indices);
     if (motions) {
         for (int i = 0; i < num_desired_motions; ++i) free(motions[i].inlier_indices);
@@ -556,8 +567,7 @@ static int ransac_translation(int *matched_points, int npoints, int *num_inliers
                   num_desired_motions,
                   3,
                   is_degenerate_translation,
-                  find_translation,
-                  project_points_double_translation);
+                  find_translation);
 }
 
 static int ransac_rotzoom(int *matched_points, int npoints, int *num_inliers_by_motion, MotionModel *params_by_motion,
@@ -569,8 +579,7 @@ static int ransac_rotzoom(int *matched_points, int npoints, int *num_inliers_by_
                   num_desired_motions,
                   3,
                   is_degenerate_affine,
-                  find_rotzoom,
-                  project_points_double_rotzoom);
+                  find_rotzoom);
 }
 
 static int ransac_affine(int *matched_points, int npoints, int *num_inliers_by_motion, MotionModel *params_by_motion,
@@ -582,8 +591,7 @@ static int ransac_affine(int *matched_points, int npoints, int *num_inliers_by_m
                   num_desired_motions,
                   3,
                   is_degenerate_affine,
-                  find_affine,
-                  project_points_double_affine);
+                  find_affine);
 }
 
 RansacFunc svt_av1_get_ransac_type(TransformationType type) {
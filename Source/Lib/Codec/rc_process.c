@@ -39,6 +39,8 @@
 #include "resize.h"
 #include "src_ops_process.h"
 #include "enc_mode_config.h"
+#include "svt_trace.h"
+#include "segment_workers.h"
 
 // Specifies the weights of the ref frame in calculating qindex of non base layer frames
 static const int non_base_qindex_weight_ref[EB_MAX_TEMPORAL_LAYERS] = {100, 100, 100, 100, 100, 100};
@@ -136,11 +138,53 @@ static void free_private_data_list(EbBufferHeaderType *p) {
     p->p_app_private = NULL;
 }
 
+/* Frame-level reductions gathered by one SB QP derivation segment */
+typedef struct RcSbStats {
+    uint8_t  min_qindex;
+    uint8_t  max_qindex;
+    uint64_t cyclic_me_dist;
+    uint64_t me_cost_var_sum;
+    uint64_t me_cost_var_min;
+    uint64_t me_cost_var_max;
+} RcSbStats;
+
+/* Frame-level decisions applied by every SB QP derivation segment */
+typedef struct RcSbPlan {
+    Bool     variance_boost;
+    Bool     tpl;
+    Bool     cyclic;
+    Bool     normalize_delta_q;
+    Bool     me_qindex_map;
+    int      normalized_base_q_idx;
+    uint8_t  sb_delta_q_res; // delta q res the TPL and cyclic offsets are clamped with
+    Bool     cyclic_delta_q_present;
+    int      cyclic_delta;
+    uint64_t cyclic_avg_me_dist;
+    uint8_t  delta_q_res;
+    uint8_t  delta_q_mask;
+    uint8_t  delta_q_remainder;
+    uint64_t me_avg_dist;
+    uint64_t me_min_dist;
+    uint64_t me_max_dist;
+} RcSbPlan;
+
+/* Splits the SB QP derivation passes of one picture in bands of SB rows run by the rate control SB workers */
+typedef struct RcSbDispatch {
+    SegmentDispatch    segments;
+    uint16_t           segment_count;
+    PictureControlSet *pcs;
+    RateControlSbPass  pass;
+    RcSbPlan           plan;
+    RcSbStats          stats[RC_SB_MAX_SEGMENTS];
+} RcSbDispatch;
+
 typedef struct RateControlContext {
-    EbFifo *rate_control_input_tasks_fifo_ptr;
-    EbFifo *rate_control_output_results_fifo_ptr;
-    EbFifo *picture_decision_results_output_fifo_ptr;
+    EbFifo      *rate_control_input_tasks_fifo_ptr;
+    EbFifo      *rate_control_output_results_fifo_ptr;
+    EbFifo      *picture_decision_results_output_fifo_ptr;
+    RcSbDispatch sb_dispatch;
 } RateControlContext;
+
 EbErrorType svt_aom_rate_control_coded_frames_stats_context_ctor(coded_frames_stats_entry *entry_ptr,
                                                                  uint64_t                  picture_number) {
     entry_ptr->picture_number         = picture_number;
@@ -151,6 +195,7 @@ EbErrorType svt_aom_rate_control_coded_frames_stats_context_ctor(coded_frames_st
 static void rate_control_context_dctor(EbPtr p) {
     EbThreadContext    *thread_ctx = (EbThreadContext *)p;
     RateControlContext *obj        = (RateControlContext *)thread_ctx->priv;
+    svt_aom_segment_dispatch_deinit(&obj->sb_dispatch.segments);
     EB_FREE_ARRAY(obj);
 }
 
@@ -168,7 +213,15 @@ EbErrorType svt_aom_rate_control_context_ctor(EbThreadContext *thread_ctx, const
     context_ptr->picture_decision_results_output_fifo_ptr = svt_system_resource_get_producer_fifo(
         enc_handle_ptr->picture_decision_results_resource_ptr, me_port_index);
 
-    return EB_ErrorNone;
+    // The rate control thread runs the first band of each pass, the SB workers the others
+#if DEBUG_VAR_BOOST_STATS
+    // the per SB debug dumps are printed in raster order
+    const uint16_t max_sb_segments = 1;
+#else
+    const uint16_t max_sb_segments = RC_SB_MAX_SEGMENTS;
+#endif
+    return svt_aom_segment_dispatch_init(
+        &context_ptr->sb_dispatch.segments, enc_handle_ptr->rate_control_sb_workers, 0, max_sb_segments);
 }
 
 #define MAX_Q_INDEX 255
@@ -1201,7 +1254,6 @@ static void sb_setup_lambda(PictureControlSet *pcs, SuperBlock *sb_ptr) {
                 ppcs_ptr->pa_me_data->tpl_rdmult_scaling_factors[index];
         }
     }
-    ppcs_ptr->blk_lambda_tuning = TRUE;
 }
 /******************************************************************************
 * compute_deltaq
@@ -1255,53 +1307,37 @@ int svt_av1_cyclic_refresh_rc_bits_per_mb(PictureParentControlSet *ppcs, double
     return bits_per_mb;
 }
 /******************************************************
- * cyclic_sb_qp_derivation
+ * cyclic_sb_qp_range
  * Calculates the QP per SB based on the ME statistics
- * used in one pass encoding
+ * used in one pass encoding, for the b64s in [b64_start, b64_end)
  * only works for sb size  = 64
  ******************************************************/
-static void cyclic_sb_qp_derivation(PictureControlSet *pcs) {
+static void cyclic_sb_qp_range(PictureControlSet *pcs, const RcSbPlan *plan, uint32_t b64_start, uint32_t b64_end) {
     PictureParentControlSet *ppcs = pcs->ppcs;
-    SequenceControlSet      *scs  = pcs->ppcs->scs;
     CyclicRefresh           *cr   = &ppcs->cyclic_refresh;
-    SuperBlock              *sb;
     uint32_t                 b64_idx;
 
-    if (cr->apply_cyclic_refresh)
-        ppcs->frm_hdr.delta_q_params.delta_q_present = 1;
-    else
-        ppcs->frm_hdr.delta_q_params.delta_q_present = 0;
-
     // This function assume sb size = 64 and sb total count is equal to b64 total count
-    assert(scs->sb_total_count == ppcs->b64_total_count);
+    assert(ppcs->scs->sb_total_count == ppcs->b64_total_count);
 
-    if (ppcs->frm_hdr.delta_q_params.delta_q_present) {
-        uint64_t avg_me_dist = 0;
-        for (b64_idx = 0; b64_idx < ppcs->b64_total_count; ++b64_idx) {
-            avg_me_dist += ppcs->me_8x8_distortion[b64_idx];
-        }
-        avg_me_dist /= ppcs->b64_total_count;
-
-        RATE_CONTROL *rc        = &scs->enc_ctx->rc;
-        const int     bit_depth = scs->static_config.encoder_bit_depth;
-        int           delta     = compute_deltaq(ppcs, rc, ppcs->frm_hdr.quantization_params.base_q_idx, bit_depth);
-        for (b64_idx = 0; b64_idx < ppcs->b64_total_count; ++b64_idx) {
-            int diff_dist = (int)(ppcs->me_8x8_distortion[b64_idx] - avg_me_dist);
-            sb            = pcs->sb_ptr_array[b64_idx];
-            int offset    = 0;
+    if (plan->cyclic_delta_q_present) {
+        for (b64_idx = b64_start; b64_idx < b64_end; ++b64_idx) {
+            int         diff_dist = (int)(ppcs->me_8x8_distortion[b64_idx] - plan->cyclic_avg_me_dist);
+            SuperBlock *sb        = pcs->sb_ptr_array[b64_idx];
+            int         offset    = 0;
             if (b64_idx >= cr->sb_start && b64_idx < cr->sb_end && diff_dist <= 0) {
-                offset = delta;
+                offset = plan->cyclic_delta;
             } else if (b64_idx >= cr->sb_start && b64_idx < cr->sb_end) {
-                offset = delta / 2;
+                offset = plan->cyclic_delta / 2;
             }
-            sb->qindex = CLIP3(ppcs->frm_hdr.delta_q_params.delta_q_res,
-                               255 - ppcs->frm_hdr.delta_q_params.delta_q_res,
+            sb->qindex = CLIP3(plan->sb_delta_q_res,
+                               255 - plan->sb_delta_q_res,
                                ((int16_t)ppcs->frm_hdr.quantization_params.base_q_idx + (int16_t)offset));
         }
     } else {
-        for (b64_idx = 0; b64_idx < ppcs->b64_total_count; ++b64_idx) {
-            sb         = pcs->sb_ptr_array[b64_idx];
-            sb->qindex = quantizer_to_qindex[pcs->picture_qp];
+        for (b64_idx = b64_start; b64_idx < b64_end; ++b64_idx) {
+            SuperBlock *sb = pcs->sb_ptr_array[b64_idx];
+            sb->qindex     = quantizer_to_qindex[pcs->picture_qp];
         }
     }
 }
@@ -1344,56 +1380,80 @@ void svt_aom_cyclic_refresh_init(PictureParentControlSet *ppcs) {
     if (ppcs->sc_class1)
         cr->rate_ratio_qdelta += 0.5;
 }
+static const int me_qindex_min_offset[MAX_TEMPORAL_LAYERS] = {0, -8, -8, -8, -8, -8};
+static const int me_qindex_max_offset[MAX_TEMPORAL_LAYERS] = {0, 8, 8, 8, 8, 8};
+
 /*
-* Derives a qindex per 64x64 using ME distortions (to be used for lambda modulation only; not at Q/Q-1)
+* Derives a qindex per 64x64 using ME distortions (to be used for lambda modulation only; not at Q/Q-1),
+* for the b64s in [b64_start, b64_end); the frame distortion statistics come from the plan
 */
-static void generate_b64_me_qindex_map(PictureControlSet *pcs) {
+static void me_qindex_map_range(PictureControlSet *pcs, const RcSbPlan *plan, uint32_t b64_start, uint32_t b64_end) {
     PictureParentControlSet *ppcs = pcs->ppcs;
+    const uint8_t            tl   = ppcs->temporal_layer_index;
     uint32_t                 b64_idx;
 
-    int min_offset[MAX_TEMPORAL_LAYERS] = {0, -8, -8, -8, -8, -8};
-    int max_offset[MAX_TEMPORAL_LAYERS] = {0, 8, 8, 8, 8, 8};
-
-    if (min_offset[pcs->ppcs->temporal_layer_index] != 0 || max_offset[pcs->ppcs->temporal_layer_index] != 0) {
-        uint64_t avg_me_dist = 0;
-        uint64_t min_dist    = (uint64_t)~0;
-        uint64_t max_dist    = 0;
+    if (me_qindex_min_offset[tl] != 0 || me_qindex_max_offset[tl] != 0) {
+        const uint64_t avg_me_dist = plan->me_avg_dist;
+        const uint64_t min_dist    = plan->me_min_dist;
+        const uint64_t max_dist    = plan->me_max_dist;
 
-        for (b64_idx = 0; b64_idx < ppcs->b64_total_count; ++b64_idx) {
-            avg_me_dist += ppcs->me_8x8_cost_variance[b64_idx];
-            min_dist = MIN(ppcs->me_8x8_cost_variance[b64_idx], min_dist);
-            max_dist = MAX(ppcs->me_8x8_cost_variance[b64_idx], max_dist);
-        }
-        avg_me_dist /= ppcs->b64_total_count;
-
-        for (b64_idx = 0; b64_idx < ppcs->b64_total_count; ++b64_idx) {
+        for (b64_idx = b64_start; b64_idx < b64_end; ++b64_idx) {
             int diff_dist = (int)(ppcs->me_8x8_cost_variance[b64_idx] - avg_me_dist);
             int offset    = 0;
             if (diff_dist <= 0) {
                 offset = (min_dist != avg_me_dist)
-                    ? (int)((min_offset[pcs->ppcs->temporal_layer_index] * diff_dist) / (int)(min_dist - avg_me_dist))
+                    ? (int)((me_qindex_min_offset[tl] * diff_dist) / (int)(min_dist - avg_me_dist))
                     : 0;
             } else {
                 offset = (max_dist != avg_me_dist)
-                    ? (int)((max_offset[pcs->ppcs->temporal_layer_index] * diff_dist) / (int)(max_dist - avg_me_dist))
+                    ? (int)((me_qindex_max_offset[tl] * diff_dist) / (int)(max_dist - avg_me_dist))
                     : 0;
             }
 
-            offset                      = AOMMIN(offset, pcs->ppcs->frm_hdr.delta_q_params.delta_q_res * 9 * (pcs->ppcs->scs->static_config.tune == 3 ? 8 : 4) - 1);
-            offset                      = AOMMAX(offset, -pcs->ppcs->frm_hdr.delta_q_params.delta_q_res * 9 * (pcs->ppcs->scs->static_config.tune == 3 ? 8 : 4) + 1);
+            offset                      = AOMMIN(offset, ppcs->frm_hdr.delta_q_params.delta_q_res * 9 * (ppcs->scs->static_config.tune == 3 ? 8 : 4) - 1);
+            offset                      = AOMMAX(offset, -ppcs->frm_hdr.delta_q_params.delta_q_res * 9 * (ppcs->scs->static_config.tune == 3 ? 8 : 4) + 1);
             pcs->b64_me_qindex[b64_idx] = CLIP3(
-                pcs->ppcs->frm_hdr.delta_q_params.delta_q_res,
-                255 - pcs->ppcs->frm_hdr.delta_q_params.delta_q_res,
+                ppcs->frm_hdr.delta_q_params.delta_q_res,
+                255 - ppcs->frm_hdr.delta_q_params.delta_q_res,
                 ((int16_t)ppcs->frm_hdr.quantization_params.base_q_idx + (int16_t)offset));
         }
     } else {
-        for (b64_idx = 0; b64_idx < ppcs->b64_total_count; ++b64_idx) {
+        for (b64_idx = b64_start; b64_idx < b64_end; ++b64_idx) {
             pcs->b64_me_qindex[b64_idx] = ppcs->frm_hdr.quantization_params.base_q_idx;
         }
     }
 }
 
+#if DEBUG_VAR_BOOST
 int variance_comp_int(const void *a, const void *b) { return (int)*(uint16_t *)a - *(uint16_t *)b; }
+#endif
+
+/*
+ * Partially orders v[lo..hi] so that v[k] holds the value it would have if the range were
+ * sorted, with no larger value before it and no smaller value after it (nth element selection).
+ */
+static void variance_select(uint16_t *v, int lo, int hi, const int k) {
+    while (lo < hi) {
+        const uint16_t pivot = v[(lo + hi) >> 1];
+        int            i     = lo;
+        int            j     = hi;
+        while (i <= j) {
+            while (v[i] < pivot) i++;
+            while (v[j] > pivot) j--;
+            if (i <= j) {
+                const uint16_t tmp = v[i];
+                v[i++]             = v[j];
+                v[j--]             = tmp;
+            }
+        }
+        if (k <= j)
+            hi = j;
+        else if (k >= i)
+            lo = i;
+        else
+            return;
+    }
+}
 
 #define VAR_BOOST_MAX_DELTAQ_RANGE 80
 #define VAR_BOOST_MAX_QSTEP_RATIO_BOOST 8
@@ -1417,7 +1477,6 @@ static int av1_get_deltaq_sb_variance_boost(uint8_t base_q_idx, uint16_t *varian
     // copy sb 8x8 variance values to an array for ordering
     uint16_t ordered_variances[64];
     memcpy(&ordered_variances, variances + ME_TIER_ZERO_PU_8x8_0, sizeof(uint16_t) * 64);
-    qsort(&ordered_variances, 64, sizeof(uint16_t), variance_comp_int);
 
     assert(octile >= 1 && octile <= 8);
 
@@ -1431,12 +1490,21 @@ static int av1_get_deltaq_sb_variance_boost(uint8_t base_q_idx, uint16_t *varian
     const int low_idx = AOMMAX(SUBBLOCKS_IN_OCTILE - 1, mid_idx - SUBBLOCKS_IN_OCTILE);
     const int upp_idx = AOMMIN(SUBBLOCKS_IN_SB - 1, mid_idx + SUBBLOCKS_IN_OCTILE);
 
+    // Only the three sampled ranks are needed, so select them instead of sorting:
+    // once the mid rank is in place, the other two are selected on either side of it
+    variance_select(ordered_variances, 0, SUBBLOCKS_IN_SB - 1, mid_idx);
+    if (low_idx < mid_idx)
+        variance_select(ordered_variances, 0, mid_idx - 1, low_idx);
+    if (upp_idx > mid_idx)
+        variance_select(ordered_variances, mid_idx + 1, SUBBLOCKS_IN_SB - 1, upp_idx);
+
     // Weigh the three variances in a 1:2:1 ratio, with rounding (the +2 term).
     // This allows for smoother delta-q transitions among superblocks with
     // mixed-variance features.
     uint16_t variance = (ordered_variances[low_idx] + (ordered_variances[mid_idx] << 1) + ordered_variances[upp_idx] + 2) >> 2;
 
 #if DEBUG_VAR_BOOST
+    qsort(&ordered_variances, 64, sizeof(uint16_t), variance_comp_int);
     SVT_INFO("64x64 variance: %d\n", variances[ME_TIER_ZERO_PU_64x64]);
     SVT_INFO("8x8 min %d, 1st oct %d, median %d, max %d\n",
              ordered_variances[0],
@@ -1513,27 +1581,45 @@ static int av1_get_deltaq_sb_variance_boost(uint8_t base_q_idx, uint16_t *varian
     return boost;
 }
 
-void svt_variance_adjust_qp(PictureControlSet *pcs, bool readjust_base_q_idx) {
+// super res pictures scaled with different sb count, should use sb_total_count for each picture
+static uint16_t rc_sb_count(PictureControlSet *pcs) {
     PictureParentControlSet *ppcs_ptr = pcs->ppcs;
-    SequenceControlSet      *scs      = pcs->ppcs->scs;
-    SuperBlock              *sb_ptr;
-    uint32_t                 sb_addr;
+    if (ppcs_ptr->frame_superres_enabled || ppcs_ptr->frame_resize_enabled)
+        return ppcs_ptr->b64_total_count;
+    return ppcs_ptr->scs->sb_total_count;
+}
 
-    pcs->ppcs->frm_hdr.delta_q_params.delta_q_present = 1;
+static void rc_sb_stats_init(RcSbStats *stats) {
+    stats->min_qindex      = MAX_Q_INDEX;
+    stats->max_qindex      = MIN_Q_INDEX;
+    stats->cyclic_me_dist  = 0;
+    stats->me_cost_var_sum = 0;
+    stats->me_cost_var_min = (uint64_t)~0;
+    stats->me_cost_var_max = 0;
+}
 
-    // super res pictures scaled with different sb count, should use sb_total_count for each picture
-    uint16_t sb_cnt = scs->sb_total_count;
-    if (ppcs_ptr->frame_superres_enabled || ppcs_ptr->frame_resize_enabled) {
-        sb_cnt = ppcs_ptr->b64_total_count;
-    }
+static void rc_sb_stats_merge(RcSbStats *dst, const RcSbStats *src) {
+    dst->min_qindex = AOMMIN(dst->min_qindex, src->min_qindex);
+    dst->max_qindex = AOMMAX(dst->max_qindex, src->max_qindex);
+    dst->cyclic_me_dist += src->cyclic_me_dist;
+    dst->me_cost_var_sum += src->me_cost_var_sum;
+    dst->me_cost_var_min = MIN(dst->me_cost_var_min, src->me_cost_var_min);
+    dst->me_cost_var_max = MAX(dst->me_cost_var_max, src->me_cost_var_max);
+}
 
-    uint8_t min_qindex = MAX_Q_INDEX;
-    uint8_t max_qindex = MIN_Q_INDEX;
+/*
+ * Applies the variance boost to the SBs in [sb_start, sb_end) and records their qindex range
+ */
+static void variance_boost_sb_range(PictureControlSet *pcs, uint32_t sb_start, uint32_t sb_end, RcSbStats *stats) {
+    PictureParentControlSet *ppcs_ptr = pcs->ppcs;
+    SequenceControlSet      *scs      = pcs->ppcs->scs;
+    SuperBlock              *sb_ptr;
+    uint32_t                 sb_addr;
 
 #if DEBUG_VAR_BOOST_STATS
     printf("TPL/CQP SB qindex, frame %llu, temp. level %i\n", pcs->picture_number, pcs->temporal_layer_index);
 
-    for (sb_addr = 0; sb_addr < sb_cnt; ++sb_addr) {
+    for (sb_addr = sb_start; sb_addr < sb_end; ++sb_addr) {
         sb_ptr = pcs->sb_ptr_array[sb_addr];
 
         printf("%4d ", sb_ptr->qindex);
@@ -1544,7 +1630,7 @@ void svt_variance_adjust_qp(PictureControlSet *pcs, bool readjust_base_q_idx) {
     }
     printf("VAQ qindex boost, frame %llu, temp. level %i\n", pcs->picture_number, pcs->temporal_layer_index);
 #endif
-    for (sb_addr = 0; sb_addr < sb_cnt; ++sb_addr) {
+    for (sb_addr = sb_start; sb_addr < sb_end; ++sb_addr) {
         sb_ptr = pcs->sb_ptr_array[sb_addr];
         int boost;
 
@@ -1570,20 +1656,28 @@ void svt_variance_adjust_qp(PictureControlSet *pcs, bool readjust_base_q_idx) {
                                sb_ptr->qindex - boost);
 
         // record last seen min and max qindexes for frame qp readjusting
-        min_qindex = AOMMIN(min_qindex, sb_ptr->qindex);
-        max_qindex = AOMMAX(max_qindex, sb_ptr->qindex);
+        stats->min_qindex = AOMMIN(stats->min_qindex, sb_ptr->qindex);
+        stats->max_qindex = AOMMAX(stats->max_qindex, sb_ptr->qindex);
     }
+}
+
+/*
+ * Derives the normalized frame qindex from the boosted SB qindex range, optionally making it the frame qindex
+ */
+static int variance_boost_frame_q(PictureControlSet *pcs, const RcSbStats *stats, bool readjust_base_q_idx) {
+    PictureParentControlSet *ppcs_ptr = pcs->ppcs;
+    SequenceControlSet      *scs      = pcs->ppcs->scs;
 
     // normalize and clamp frame qindex value to maximize deltaq range
-    int range                 = max_qindex - min_qindex;
+    int range                 = stats->max_qindex - stats->min_qindex;
     range                     = AOMMIN(range, VAR_BOOST_MAX_DELTAQ_RANGE);
-    int normalized_base_q_idx = (int)min_qindex + (range >> 1);
+    int normalized_base_q_idx = (int)stats->min_qindex + (range >> 1);
 
 #if DEBUG_VAR_BOOST_QP
     SVT_INFO("previous qidx %d, min_qidx %d, max_qidx %d, delta_q_res %d, normalized qidx %d, range %d\n",
              ppcs_ptr->frm_hdr.quantization_params.base_q_idx,
-             min_qindex,
-             max_qindex,
+             stats->min_qindex,
+             stats->max_qindex,
              pcs->ppcs->frm_hdr.delta_q_params.delta_q_res,
              normalized_base_q_idx,
              range);
@@ -1595,12 +1689,23 @@ void svt_variance_adjust_qp(PictureControlSet *pcs, bool readjust_base_q_idx) {
                                         (int32_t)scs->static_config.max_qp_allowed,
                                         (ppcs_ptr->frm_hdr.quantization_params.base_q_idx + 2) >> 2);
     }
+    return normalized_base_q_idx;
+}
+
+/*
+ * Clamps the boosted qindex of the SBs in [sb_start, sb_end) around the normalized frame qindex
+ */
+static void variance_normalize_sb_range(PictureControlSet *pcs, int normalized_base_q_idx, uint32_t sb_start,
+                                        uint32_t sb_end) {
+    SuperBlock *sb_ptr;
+    uint32_t    sb_addr;
+
 #if DEBUG_VAR_BOOST_STATS
     printf("Total CQP/CRF + VAQ qindex, frame %llu, temp. level %i\n", pcs->picture_number, pcs->temporal_layer_index);
 #endif
 
     // normalize sb qindex values
-    for (sb_addr = 0; sb_addr < sb_cnt; ++sb_addr) {
+    for (sb_addr = sb_start; sb_addr < sb_end; ++sb_addr) {
         sb_ptr = pcs->sb_ptr_array[sb_addr];
 
         int offset = (int)sb_ptr->qindex - normalized_base_q_idx;
@@ -1625,6 +1730,51 @@ void svt_variance_adjust_qp(PictureControlSet *pcs, bool readjust_base_q_idx) {
     }
 }
 
+void svt_variance_adjust_qp(PictureControlSet *pcs, bool readjust_base_q_idx) {
+    const uint16_t sb_cnt = rc_sb_count(pcs);
+    RcSbStats      stats;
+
+    pcs->ppcs->frm_hdr.delta_q_params.delta_q_present = 1;
+
+    rc_sb_stats_init(&stats);
+    variance_boost_sb_range(pcs, 0, sb_cnt, &stats);
+    const int normalized_base_q_idx = variance_boost_frame_q(pcs, &stats, readjust_base_q_idx);
+    variance_normalize_sb_range(pcs, normalized_base_q_idx, 0, sb_cnt);
+}
+
+/*
+ * Adds the TPL based qindex offset to the SBs in [sb_start, sb_end) and sets up their lambda scaling;
+ * delta_q_res is the one in effect before any delta q res normalization of the frame
+ */
+static void tpl_sb_qp_range(PictureControlSet *pcs, uint8_t delta_q_res, uint32_t sb_start, uint32_t sb_end) {
+    PictureParentControlSet *ppcs_ptr = pcs->ppcs;
+    SequenceControlSet      *scs      = pcs->ppcs->scs;
+#if DEBUG_VAR_BOOST_STATS
+    printf("TPL qindex boost, frame %llu, temp. level %i\n", pcs->picture_number, pcs->temporal_layer_index);
+#endif
+    for (uint32_t sb_addr = sb_start; sb_addr < sb_end; ++sb_addr) {
+        SuperBlock *sb_ptr = pcs->sb_ptr_array[sb_addr];
+        double      beta   = ppcs_ptr->pa_me_data->tpl_beta[sb_addr];
+        int         offset = svt_av1_get_deltaq_offset(
+            scs->static_config.encoder_bit_depth, sb_ptr->qindex, beta, pcs->ppcs->slice_type == I_SLICE);
+        offset         = AOMMIN(offset, delta_q_res * 9 * (scs->static_config.tune == 3 ? 8 : 4) - 1);
+        offset         = AOMMAX(offset, -delta_q_res * 9 * (scs->static_config.tune == 3 ? 8 : 4) + 1);
+
+#if DEBUG_VAR_BOOST_STATS
+        printf("%4d ", -offset);
+        if (pcs->frame_width <= (sb_ptr->org_x + 64)) {
+            printf("\n");
+        }
+#endif
+        // read back SB qindex value, and add TPL boost on top
+        sb_ptr->qindex = CLIP3(1, // q_index 0 is lossless, and is currently not supported in SVT-AV1
+                               MAXQ,
+                               (int16_t)sb_ptr->qindex + (int16_t)offset);
+
+        sb_setup_lambda(pcs, sb_ptr);
+    }
+}
+
 /******************************************************
  * svt_aom_sb_qp_derivation_tpl_la
  * Calculates the QP per SB based on the tpl statistics
@@ -1632,47 +1782,20 @@ void svt_variance_adjust_qp(PictureControlSet *pcs, bool readjust_base_q_idx) {
  ******************************************************/
 void svt_aom_sb_qp_derivation_tpl_la(PictureControlSet *pcs) {
     PictureParentControlSet *ppcs_ptr = pcs->ppcs;
-    SequenceControlSet      *scs      = pcs->ppcs->scs;
     if (ppcs_ptr->r0_based_qps_qpm)
         pcs->ppcs->frm_hdr.delta_q_params.delta_q_present = 1;
 
-    // super res pictures scaled with different sb count, should use sb_total_count for each picture
-    uint16_t sb_cnt = scs->sb_total_count;
-    if (ppcs_ptr->frame_superres_enabled || ppcs_ptr->frame_resize_enabled)
-        sb_cnt = ppcs_ptr->b64_total_count;
     if ((ppcs_ptr->r0_based_qps_qpm) && (pcs->ppcs->tpl_is_valid == 1)) {
-#if DEBUG_VAR_BOOST_STATS
-        printf("TPL qindex boost, frame %llu, temp. level %i\n", pcs->picture_number, pcs->temporal_layer_index);
-#endif
-        for (uint32_t sb_addr = 0; sb_addr < sb_cnt; ++sb_addr) {
-            SuperBlock *sb_ptr = pcs->sb_ptr_array[sb_addr];
-            double      beta   = ppcs_ptr->pa_me_data->tpl_beta[sb_addr];
-            int         offset = svt_av1_get_deltaq_offset(
-                scs->static_config.encoder_bit_depth, sb_ptr->qindex, beta, pcs->ppcs->slice_type == I_SLICE);
-            offset         = AOMMIN(offset, pcs->ppcs->frm_hdr.delta_q_params.delta_q_res * 9 * (pcs->ppcs->scs->static_config.tune == 3 ? 8 : 4) - 1);
-            offset         = AOMMAX(offset, -pcs->ppcs->frm_hdr.delta_q_params.delta_q_res * 9 * (pcs->ppcs->scs->static_config.tune == 3 ? 8 : 4) + 1);
-
-#if DEBUG_VAR_BOOST_STATS
-            printf("%4d ", -offset);
-            if (pcs->frame_width <= (sb_ptr->org_x + 64)) {
-                printf("\n");
-            }
-#endif
-            // read back SB qindex value, and add TPL boost on top
-            sb_ptr->qindex = CLIP3(1, // q_index 0 is lossless, and is currently not supported in SVT-AV1
-                                   MAXQ,
-                                   (int16_t)sb_ptr->qindex + (int16_t)offset);
-
-            sb_setup_lambda(pcs, sb_ptr);
-        }
+        ppcs_ptr->blk_lambda_tuning = TRUE;
+        tpl_sb_qp_range(pcs, ppcs_ptr->frm_hdr.delta_q_params.delta_q_res, 0, rc_sb_count(pcs));
     }
 }
 
-/******************************************************
- * normalize_sb_delta_q
- * Adjusts superblock delta q to the most optimal res
- ******************************************************/
-void normalize_sb_delta_q(PictureControlSet *pcs) {
+/*
+ * Picks the delta q res from the (encode-wide) qp setting and the mask/remainder the SB qindexes are aligned with;
+ * returns FALSE when the delta q res stays 1 and there is nothing to normalize
+ */
+static Bool normalize_sb_delta_q_plan(PictureControlSet *pcs, RcSbPlan *plan) {
     PictureParentControlSet *ppcs_ptr = pcs->ppcs;
     SequenceControlSet      *scs      = pcs->ppcs->scs;
 
@@ -1695,30 +1818,34 @@ void normalize_sb_delta_q(PictureControlSet *pcs) {
 #if DEBUG_VAR_BOOST_STATS
         printf("Frame %llu, temp. level %i, keep delta_q_res = 1\n", pcs->picture_number, pcs->temporal_layer_index);
 #endif
-        return;
+        return FALSE;
     }
 
     assert(delta_q_res == 2 || delta_q_res == 4 || delta_q_res == 8);
 
     pcs->ppcs->frm_hdr.delta_q_params.delta_q_res = delta_q_res;
 
-    uint8_t mask = ~(delta_q_res - 1);
-    uint8_t delta_q_remainder = ppcs_ptr->frm_hdr.quantization_params.base_q_idx & ~mask;
+    plan->delta_q_res       = delta_q_res;
+    plan->delta_q_mask      = ~(delta_q_res - 1);
+    plan->delta_q_remainder = ppcs_ptr->frm_hdr.quantization_params.base_q_idx & ~plan->delta_q_mask;
+    return TRUE;
+}
 
-    // super res pictures scaled with different sb count, should use sb_total_count for each picture
-    uint16_t sb_cnt = scs->sb_total_count;
-    if (ppcs_ptr->frame_superres_enabled || ppcs_ptr->frame_resize_enabled)
-        sb_cnt = ppcs_ptr->b64_total_count;
+/*
+ * Aligns the qindex of the SBs in [sb_start, sb_end) on the delta q res picked by normalize_sb_delta_q_plan()
+ */
+static void normalize_sb_delta_q_range(PictureControlSet *pcs, const RcSbPlan *plan, uint32_t sb_start,
+                                       uint32_t sb_end) {
 #if DEBUG_VAR_BOOST_STATS
-        printf("Normalized delta q boost, frame %llu, temp. level %i, new delta_q_res %i\n", pcs->picture_number, pcs->temporal_layer_index, delta_q_res);
+        printf("Normalized delta q boost, frame %llu, temp. level %i, new delta_q_res %i\n", pcs->picture_number, pcs->temporal_layer_index, plan->delta_q_res);
 #endif
-    for (uint32_t sb_addr = 0; sb_addr < sb_cnt; ++sb_addr) {
+    for (uint32_t sb_addr = sb_start; sb_addr < sb_end; ++sb_addr) {
         SuperBlock *sb_ptr = pcs->sb_ptr_array[sb_addr];
 
-        uint8_t normalized_q_index = (sb_ptr->qindex & mask) + delta_q_remainder;
+        uint8_t normalized_q_index = (sb_ptr->qindex & plan->delta_q_mask) + plan->delta_q_remainder;
 
         // q_index 0 is lossless, and is currently not supported in SVT-AV1
-        sb_ptr->qindex = normalized_q_index == 0 ? delta_q_res : normalized_q_index;
+        sb_ptr->qindex = normalized_q_index == 0 ? plan->delta_q_res : normalized_q_index;
 #if DEBUG_VAR_BOOST_STATS
         printf("%4d ", sb_ptr->qindex);
         if (pcs->frame_width <= (sb_ptr->org_x + 64)) {
@@ -1728,6 +1855,182 @@ void normalize_sb_delta_q(PictureControlSet *pcs) {
     }
 }
 
+/******************************************************
+ * normalize_sb_delta_q
+ * Adjusts superblock delta q to the most optimal res
+ ******************************************************/
+void normalize_sb_delta_q(PictureControlSet *pcs) {
+    RcSbPlan plan;
+    if (normalize_sb_delta_q_plan(pcs, &plan))
+        normalize_sb_delta_q_range(pcs, &plan, 0, rc_sb_count(pcs));
+}
+
+/*
+ * Splits count units laid out in rows of width units into seg_count bands of whole rows,
+ * and returns the [start, end) unit range of band seg
+ */
+static void rc_sb_segment_range(uint32_t count, uint32_t width, uint16_t seg, uint16_t seg_count, uint32_t *start,
+                                uint32_t *end) {
+    const uint32_t rows = (count + width - 1) / width;
+    *start              = MIN(count, rows * seg / seg_count * width);
+    *end                = MIN(count, rows * (seg + 1) / seg_count * width);
+}
+
+/*
+ * Runs one band of SB rows of an SB QP derivation pass; bands are whole SB rows so that the TPL lambda
+ * setup of neighbouring SBs (which may share scaling factors under super-res) keeps its raster order
+ */
+static void rc_sb_process_segment(void *job, uint16_t seg, uint16_t seg_count) {
+    RcSbDispatch            *dispatch  = (RcSbDispatch *)job;
+    PictureControlSet       *pcs       = dispatch->pcs;
+    PictureParentControlSet *ppcs      = pcs->ppcs;
+    SequenceControlSet      *scs       = ppcs->scs;
+    const RcSbPlan          *plan      = &dispatch->plan;
+    const uint32_t           sb_width  = (ppcs->aligned_width + scs->sb_size - 1) / scs->sb_size;
+    const uint32_t           b64_width = (ppcs->aligned_width + 64 - 1) / 64;
+    uint32_t                 start, end;
+
+    switch (dispatch->pass) {
+    case RC_SB_PASS_STATS: {
+        RcSbStats *stats = &dispatch->stats[seg];
+        rc_sb_stats_init(stats);
+
+        // set initial SB base_q_idx values
+        rc_sb_segment_range(pcs->sb_total_count, sb_width, seg, seg_count, &start, &end);
+        for (uint32_t sb_addr = start; sb_addr < end; ++sb_addr)
+            pcs->sb_ptr_array[sb_addr]->qindex = ppcs->frm_hdr.quantization_params.base_q_idx;
+
+        if (plan->variance_boost) {
+            rc_sb_segment_range(rc_sb_count(pcs), sb_width, seg, seg_count, &start, &end);
+            variance_boost_sb_range(pcs, start, end, stats);
+        }
+
+        rc_sb_segment_range(ppcs->b64_total_count, b64_width, seg, seg_count, &start, &end);
+        if (plan->cyclic && ppcs->cyclic_refresh.apply_cyclic_refresh) {
+            for (uint32_t b64_idx = start; b64_idx < end; ++b64_idx)
+                stats->cyclic_me_dist += ppcs->me_8x8_distortion[b64_idx];
+        }
+        if (plan->me_qindex_map) {
+            for (uint32_t b64_idx = start; b64_idx < end; ++b64_idx) {
+                stats->me_cost_var_sum += ppcs->me_8x8_cost_variance[b64_idx];
+                stats->me_cost_var_min = MIN(ppcs->me_8x8_cost_variance[b64_idx], stats->me_cost_var_min);
+                stats->me_cost_var_max = MAX(ppcs->me_8x8_cost_variance[b64_idx], stats->me_cost_var_max);
+            }
+        }
+        break;
+    }
+    case RC_SB_PASS_QP:
+        rc_sb_segment_range(rc_sb_count(pcs), sb_width, seg, seg_count, &start, &end);
+        if (plan->variance_boost)
+            variance_normalize_sb_range(pcs, plan->normalized_base_q_idx, start, end);
+        if (plan->tpl)
+            tpl_sb_qp_range(pcs, plan->sb_delta_q_res, start, end);
+        if (plan->normalize_delta_q)
+            normalize_sb_delta_q_range(pcs, plan, start, end);
+        if (plan->cyclic) {
+            rc_sb_segment_range(ppcs->b64_total_count, b64_width, seg, seg_count, &start, &end);
+            cyclic_sb_qp_range(pcs, plan, start, end);
+        }
+        break;
+    case RC_SB_PASS_ME_QINDEX:
+        rc_sb_segment_range(ppcs->b64_total_count, b64_width, seg, seg_count, &start, &end);
+        me_qindex_map_range(pcs, plan, start, end);
+        break;
+    default: assert(0); break;
+    }
+}
+
+/*
+ * Runs an SB QP derivation pass over all the segments of the picture and waits for it to complete;
+ * the rate control thread runs the first band itself
+ */
+static void rc_sb_run_pass(RcSbDispatch *dispatch, PictureControlSet *pcs, RateControlSbPass pass) {
+    dispatch->pcs                     = pcs;
+    dispatch->pass                    = pass;
+    dispatch->segments.picture_number = pcs->picture_number;
+    svt_aom_segment_dispatch_run(&dispatch->segments, dispatch->segment_count, rc_sb_process_segment, dispatch);
+}
+
+/******************************************************
+ * rc_sb_qp_derivation
+ * Derives the SB qindex values of the picture (variance boost, TPL / cyclic refresh QPM and delta q res
+ * normalization). The per SB work runs in bands of SB rows, the first one on this thread and the others
+ * on the rate control SB workers; only the frame-level decisions in between the passes are taken here.
+ ******************************************************/
+static void rc_sb_qp_derivation(RcSbDispatch *dispatch, PictureControlSet *pcs) {
+    PictureParentControlSet *ppcs    = pcs->ppcs;
+    SequenceControlSet      *scs     = ppcs->scs;
+    FrameHeader             *frm_hdr = &ppcs->frm_hdr;
+    RcSbPlan                *plan    = &dispatch->plan;
+    RcSbStats                stats;
+
+    const uint32_t sb_rows  = (ppcs->aligned_height + scs->sb_size - 1) / scs->sb_size;
+    dispatch->segment_count = (uint16_t)MAX(1, MIN(dispatch->segments.max_segment_count, sb_rows));
+
+    memset(plan, 0, sizeof(*plan));
+    // note: do not enable variance boost for CBR rate control mode
+    plan->variance_boost = scs->static_config.enable_variance_boost &&
+        scs->static_config.rate_control_mode != SVT_AV1_RC_MODE_CBR;
+    // QPM with tpl_la, otherwise cyclic refresh QPM for CBR
+    const Bool tpl_qpm = scs->static_config.enable_adaptive_quantization == 2 && ppcs->tpl_ctrls.enable &&
+        ppcs->r0 != 0;
+    plan->cyclic = !tpl_qpm && scs->static_config.enable_adaptive_quantization &&
+        scs->static_config.rate_control_mode == SVT_AV1_RC_MODE_CBR;
+    plan->me_qindex_map = scs->stats_based_sb_lambda_modulation;
+
+    // set initial SB base_q_idx values, boost them based on variance, and gather the frame statistics
+    frm_hdr->delta_q_params.delta_q_present = 0;
+    rc_sb_run_pass(dispatch, pcs, RC_SB_PASS_STATS);
+    rc_sb_stats_init(&stats);
+    for (uint16_t seg = 0; seg < dispatch->segment_count; ++seg) rc_sb_stats_merge(&stats, &dispatch->stats[seg]);
+
+    plan->sb_delta_q_res = frm_hdr->delta_q_params.delta_q_res;
+    if (plan->variance_boost) {
+        frm_hdr->delta_q_params.delta_q_present = 1;
+        plan->normalized_base_q_idx             = variance_boost_frame_q(pcs, &stats, true);
+    }
+    if (tpl_qpm) {
+        if (ppcs->r0_based_qps_qpm) {
+            frm_hdr->delta_q_params.delta_q_present = 1;
+            if (ppcs->tpl_is_valid == 1) {
+                plan->tpl               = TRUE;
+                ppcs->blk_lambda_tuning = TRUE;
+            }
+        }
+    } else if (plan->cyclic) {
+        CyclicRefresh *cr                       = &ppcs->cyclic_refresh;
+        plan->cyclic_delta_q_present            = cr->apply_cyclic_refresh ? TRUE : FALSE;
+        frm_hdr->delta_q_params.delta_q_present = plan->cyclic_delta_q_present;
+        if (plan->cyclic_delta_q_present) {
+            plan->cyclic_avg_me_dist = stats.cyclic_me_dist / ppcs->b64_total_count;
+            plan->cyclic_delta       = compute_deltaq(ppcs,
+                                                &scs->enc_ctx->rc,
+                                                frm_hdr->quantization_params.base_q_idx,
+                                                scs->static_config.encoder_bit_depth);
+        }
+    }
+
+    if ((scs->static_config.tune == 2 || scs->static_config.tune == 3 || scs->static_config.tune == 4) &&
+        !frm_hdr->delta_q_params.delta_q_present) {
+        // enable sb level qindex when tune 2
+        frm_hdr->delta_q_params.delta_q_present = 1;
+    }
+
+    if (scs->static_config.enable_variance_boost && frm_hdr->delta_q_params.delta_q_present) {
+        // adjust delta q res and normalize superblock delta q values to reduce signaling overhead
+        plan->normalize_delta_q = normalize_sb_delta_q_plan(pcs, plan);
+    }
+
+    if (plan->me_qindex_map) {
+        plan->me_avg_dist = stats.me_cost_var_sum / ppcs->b64_total_count;
+        plan->me_min_dist = stats.me_cost_var_min;
+        plan->me_max_dist = stats.me_cost_var_max;
+    }
+
+    if (plan->variance_boost || plan->tpl || plan->cyclic || plan->normalize_delta_q)
+        rc_sb_run_pass(dispatch, pcs, RC_SB_PASS_QP);
+}
+
 static int av1_find_qindex(double desired_q, aom_bit_depth_t bit_depth, int best_qindex, int worst_qindex) {
     assert(best_qindex <= worst_qindex);
     int low  = best_qindex;
@@ -3303,6 +3606,7 @@ void *svt_aom_rate_control_kernel(void *input_ptr) {
         case RC_INPUT:
             pcs = (PictureControlSet *)rc_tasks->pcs_wrapper->object_ptr;
             scs = pcs->scs;
+            SVT_TRACE_BEGIN("rate_control", pcs->picture_number, -1);
             // Get r0
             if (pcs->ppcs->r0_based_qps_qpm) {
                 svt_aom_generate_r0beta(pcs->ppcs);
@@ -3580,13 +3884,23 @@ void *svt_aom_rate_control_kernel(void *input_ptr) {
                 // SUPERRES_FIXED and SUPERRES_RANDOM modes are handled in picture decision process.
                 if (scs->static_config.pass == ENC_SINGLE_PASS) {
                     if (scs->static_config.superres_mode > SUPERRES_RANDOM) {
+                        // keep the full resolution ME for the unscaled loop of the auto superres search
+                        const Bool me_cache = scs->static_config.superres_mode == SUPERRES_AUTO &&
+                            scs->static_config.superres_auto_search_type != SUPERRES_AUTO_SOLO &&
+                            pcs->slice_type != I_SLICE;
+                        if (me_cache)
+                            svt_aom_me_cache_store(pcs->ppcs, ME_CACHE_SLOT_UNSCALED);
                         // determine denom and scale down picture by selected denom
                         svt_aom_init_resize_picture(scs, pcs->ppcs);
+                        if (me_cache && pcs->ppcs->superres_total_recode_loop == 0)
+                            svt_aom_me_cache_release(pcs->ppcs);
                         if (pcs->ppcs->frame_superres_enabled || pcs->ppcs->frame_resize_enabled) {
                             // reset gm based on super-res on/off
                             bool super_res_off = pcs->ppcs->frame_superres_enabled == FALSE &&
                                 scs->static_config.resize_mode == RESIZE_NONE;
                             svt_aom_set_gm_controls(pcs->ppcs, svt_aom_derive_gm_level(pcs->ppcs, super_res_off));
+                            if (me_cache && pcs->ppcs->superres_total_recode_loop > 0)
+                                pcs->ppcs->me_cache_hit = svt_aom_me_cache_restore(pcs->ppcs);
                             // Initialize Segments as picture decision process
                             pcs->ppcs->me_segments_completion_count = 0;
                             pcs->ppcs->me_processed_b64_count       = 0;
@@ -3635,47 +3949,17 @@ void *svt_aom_rate_control_kernel(void *input_ptr) {
                 }
             }
 
-            // set initial SB base_q_idx values
-            pcs->ppcs->frm_hdr.delta_q_params.delta_q_present = 0;
-            for (int sb_addr = 0; sb_addr < pcs->sb_total_count; ++sb_addr) {
-                SuperBlock *sb_ptr = pcs->sb_ptr_array[sb_addr];
-                sb_ptr->qindex     = frm_hdr->quantization_params.base_q_idx;
-            }
-
-            // adjust SB qindex based on variance
-            // note: do not enable variance boost for CBR rate control mode
-            if (scs->static_config.enable_variance_boost &&
-                scs->static_config.rate_control_mode != SVT_AV1_RC_MODE_CBR) {
-                svt_variance_adjust_qp(pcs, true);
-            }
-
-            // QPM with tpl_la
-            if (scs->static_config.enable_adaptive_quantization == 2 && pcs->ppcs->tpl_ctrls.enable &&
-                pcs->ppcs->r0 != 0) {
-                svt_aom_sb_qp_derivation_tpl_la(pcs);
-            } else if (scs->static_config.enable_adaptive_quantization &&
-                       scs->static_config.rate_control_mode == SVT_AV1_RC_MODE_CBR) {
-                cyclic_sb_qp_derivation(pcs);
-            }
-
-            if ((pcs->scs->static_config.tune == 2 || pcs->scs->static_config.tune == 3 || pcs->ppcs->scs->static_config.tune == 4) && !pcs->ppcs->frm_hdr.delta_q_params.delta_q_present) {
-                // enable sb level qindex when tune 2
-                pcs->ppcs->frm_hdr.delta_q_params.delta_q_present = 1;
-            }
-
-            if (scs->static_config.enable_variance_boost && pcs->ppcs->frm_hdr.delta_q_params.delta_q_present)
-            {
-                // adjust delta q res and normalize superblock delta q values to reduce signaling overhead
-                normalize_sb_delta_q(pcs);
-            }
+            // SB qindex derivation, segmented over the rate control SB workers
+            rc_sb_qp_derivation(&context_ptr->sb_dispatch, pcs);
 
             if (scs->static_config.rate_control_mode && !is_superres_recode_task) {
                 svt_aom_update_rc_counts(pcs->ppcs);
             }
 
             // Derive a QP per 64x64 using ME distortions (to be used for lambda modulation only; not at Q/Q-1)
+            // kept after the SB QP pass, whose TPL lambda setup reads the map as it was before this update
             if (scs->stats_based_sb_lambda_modulation)
-                generate_b64_me_qindex_map(pcs);
+                rc_sb_run_pass(&context_ptr->sb_dispatch, pcs, RC_SB_PASS_ME_QINDEX);
             // Get Empty Rate Control Results Buffer
             svt_get_empty_object(context_ptr->rate_control_output_results_fifo_ptr, &rc_results_wrapper);
             rc_results                  = (RateControlResults *)rc_results_wrapper->object_ptr;
@@ -3694,6 +3978,7 @@ void *svt_aom_rate_control_kernel(void *input_ptr) {
 
             ppcs = (PictureParentControlSet *)rc_tasks->pcs_wrapper->object_ptr;
             scs  = ppcs->scs;
+            SVT_TRACE_BEGIN("rc_feedback", ppcs->picture_number, -1);
             // Prevent double counting fames with overlay to so we don't
             // increase processed_frame_number twice per frame
             if (!ppcs->is_overlay) {
@@ -39,6 +39,17 @@ typedef struct RateControlTasksInitData {
     int32_t junk;
 } RateControlTasksInitData;
 
+/**************************************
+ * SB QP derivation segments
+ **************************************/
+#define RC_SB_MAX_SEGMENTS 16
+
+typedef enum RateControlSbPass {
+    RC_SB_PASS_STATS, // seed SB qindex values and gather the frame-level reductions
+    RC_SB_PASS_QP, // apply the per SB qindex adjustments (variance boost, TPL, cyclic, delta q res)
+    RC_SB_PASS_ME_QINDEX // derive the per 64x64 ME qindex map
+} RateControlSbPass;
+
 /**************************************
  * Extern Function Declarations
  **************************************/
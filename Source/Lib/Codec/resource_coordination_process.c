@@ -29,6 +29,7 @@
 #include "resize.h"
 #include "metadata_handle.h"
 #include "enc_mode_config.h"
+#include "svt_trace.h"
 
 typedef struct ResourceCoordinationContext {
     EbFifo                        *input_cmd_fifo_ptr;
@@ -316,6 +317,7 @@ static EbErrorType reset_pcs_av1(PictureParentControlSet *pcs) {
     pcs->gm_pp_detected      = false;
     pcs->gm_pp_enabled       = false;
     pcs->is_gm_on            = -1;
+    pcs->me_cache_hit        = FALSE;
     pcs->gf_interval         = 0;
 
     pcs->reference_released                     = 0;
@@ -547,13 +549,13 @@ void svt_aom_setup_two_pass(SequenceControlSet *scs) {
     scs->twopass.stats_buf_ctx = &enc_ctx->stats_buf_context;
     scs->twopass.stats_in      = scs->twopass.stats_buf_ctx->stats_in_start;
     if (scs->static_config.pass == ENC_SECOND_PASS) {
-        const size_t packet_sz = sizeof(FIRSTPASS_STATS);
-        const int    packets   = (int)(enc_ctx->rc_stats_buffer.sz / packet_sz);
+        uint64_t         packets;
+        FIRSTPASS_STATS *records = svt_av1_first_pass_stats_records(&enc_ctx->rc_stats_buffer, &packets);
 
         if (!scs->lap_rc) {
             /*Re-initialize to stats buffer, populated by application in the case of
              * two pass*/
-            scs->twopass.stats_buf_ctx->stats_in_start     = enc_ctx->rc_stats_buffer.buf;
+            scs->twopass.stats_buf_ctx->stats_in_start     = records;
             scs->twopass.stats_in                          = scs->twopass.stats_buf_ctx->stats_in_start;
             scs->twopass.stats_buf_ctx->stats_in_end_write = &scs->twopass.stats_buf_ctx->stats_in_start[packets - 1];
             scs->twopass.stats_buf_ctx->stats_in_end       = &scs->twopass.stats_buf_ctx->stats_in_start[packets - 1];
@@ -857,6 +859,8 @@ void *svt_aom_resource_coordination_kernel(void *input_ptr) {
         uint8_t            *buff_y8b    = ((EbPictureBufferDesc *)y8b_header->p_buffer)->buffer_y;
         eb_input_wrapper_ptr            = input_cmd_obj->eb_input_wrapper_ptr;
         eb_input_ptr                    = (EbBufferHeaderType *)eb_input_wrapper_ptr->object_ptr;
+        // the picture number this input is about to get
+        SVT_TRACE_BEGIN("resource_coordination", context_ptr->picture_number_array[instance_index], -1);
 
         // Set the SequenceControlSet
         scs = context_ptr->scs_instance_array[instance_index]->scs;
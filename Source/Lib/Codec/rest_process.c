@@ -22,6 +22,8 @@
 #include "resource_coordination_process.h"
 #include "resize.h"
 #include "enc_mode_config.h"
+#include "svt_trace.h"
+#include "quality_metrics.h"
 
 /**************************************
  * Rest Context
@@ -31,6 +33,7 @@ typedef struct RestContext {
     EbFifo *rest_input_fifo_ptr;
     EbFifo *rest_output_fifo_ptr;
     EbFifo *picture_demux_fifo_ptr;
+    MetricsScratch *metrics_scratch;
 
     EbPictureBufferDesc *trial_frame_rst;
 
@@ -46,14 +49,16 @@ void        svt_aom_pack_highbd_pic(const EbPictureBufferDesc *pic_ptr, uint16_t
                                     uint32_t ss_y, Bool include_padding);
 void        svt_aom_copy_buffer_info(EbPictureBufferDesc *src_ptr, EbPictureBufferDesc *dst_ptr);
 void        svt_aom_recon_output(PictureControlSet *pcs, SequenceControlSet *scs);
-void        svt_av1_loop_restoration_filter_frame(int32_t *rst_tmpbuf, Yv12BufferConfig *frame, Av1Common *cm,
-                                                  int32_t optimized_lr);
+void        svt_av1_loop_restoration_filter_plane(int32_t *rst_tmpbuf, Yv12BufferConfig *frame, Yv12BufferConfig *dst,
+                                                  Av1Common *cm, int32_t optimized_lr, int32_t plane);
+void        svt_av1_loop_restoration_alloc_dst(const Yv12BufferConfig *frame, Av1Common *cm);
+void        svt_av1_loop_restoration_free_dst(Av1Common *cm);
 EbErrorType psnr_calculations(PictureControlSet *pcs, SequenceControlSet *scs, Bool free_memory);
-EbErrorType svt_aom_ssim_calculations(PictureControlSet *pcs, SequenceControlSet *scs, Bool free_memory);
 void        pad_ref_and_set_flags(PictureControlSet *pcs, SequenceControlSet *scs);
 void        restoration_seg_search(int32_t *rst_tmpbuf, Yv12BufferConfig *org_fts, const Yv12BufferConfig *src,
                                    Yv12BufferConfig *trial_frame_rst, PictureControlSet *pcs, uint32_t segment_index);
-void        rest_finish_search(PictureControlSet *pcs);
+int32_t     rest_finish_search_init(PictureControlSet *pcs);
+void        rest_finish_search_plane(PictureControlSet *pcs, int32_t plane);
 void        svt_av1_upscale_normative_rows(const Av1Common *cm, const uint8_t *src, int src_stride, uint8_t *dst,
                                            int dst_stride, int rows, int sub_x, int bd, Bool is_16bit_pipeline);
 #if DEBUG_UPSCALING
@@ -71,6 +76,7 @@ static void rest_context_dctor(EbPtr p) {
     if (obj->org_rec_frame)
         EB_DELETE(obj->org_rec_frame);
     EB_FREE_ALIGNED(obj->rst_tmpbuf);
+    EB_DELETE(obj->metrics_scratch);
     EB_FREE_ARRAY(obj);
 }
 
@@ -95,6 +101,8 @@ EbErrorType svt_aom_rest_context_ctor(EbThreadContext *thread_ctx, const EbEncHa
                                                                               index);
     context_ptr->picture_demux_fifo_ptr = svt_system_resource_get_producer_fifo(
         enc_handle_ptr->picture_demux_results_resource_ptr, demux_index);
+    if (config->stat_report)
+        EB_NEW(context_ptr->metrics_scratch, svt_aom_metrics_scratch_ctor, scs);
 
     Bool is_16bit = scs->is_16bit_pipeline;
     if (svt_aom_get_enable_restoration(init_data_ptr->enc_mode,
@@ -514,6 +522,234 @@ static void copy_statistics_to_ref_obj_ect(PictureControlSet *pcs, SequenceContr
     }
 }
 
+// Hands the finished picture over: the reference to the picture manager (unless packetization does it
+// after a superres recode), then one task per tile to entropy coding
+static void post_rest_results(RestContext *context_ptr, EbObjectWrapper *pcs_wrapper, Bool post_reference) {
+    PictureControlSet *pcs = (PictureControlSet *)pcs_wrapper->object_ptr;
+    if (post_reference && pcs->ppcs->is_ref) {
+        EbObjectWrapper *picture_demux_results_wrapper_ptr;
+        // Get Empty PicMgr Results
+        svt_get_empty_object(context_ptr->picture_demux_fifo_ptr, &picture_demux_results_wrapper_ptr);
+
+        PictureDemuxResults *picture_demux_results_rtr = (PictureDemuxResults *)
+                                                             picture_demux_results_wrapper_ptr->object_ptr;
+        picture_demux_results_rtr->ref_pic_wrapper = pcs->ppcs->ref_pic_wrapper;
+        picture_demux_results_rtr->scs             = pcs->scs;
+        picture_demux_results_rtr->picture_number  = pcs->picture_number;
+        picture_demux_results_rtr->picture_type    = EB_PIC_REFERENCE;
+
+        // Post Reference Picture
+        svt_post_full_object(picture_demux_results_wrapper_ptr);
+    }
+
+    const uint8_t tile_cols = pcs->ppcs->av1_cm->tiles_info.tile_cols;
+    const uint8_t tile_rows = pcs->ppcs->av1_cm->tiles_info.tile_rows;
+    for (int tile_row_idx = 0; tile_row_idx < tile_rows; tile_row_idx++) {
+        for (int tile_col_idx = 0; tile_col_idx < tile_cols; tile_col_idx++) {
+            EbObjectWrapper *rest_results_wrapper;
+            svt_get_empty_object(context_ptr->rest_output_fifo_ptr, &rest_results_wrapper);
+            RestResults *rest_results = (struct RestResults *)rest_results_wrapper->object_ptr;
+            rest_results->pcs_wrapper = pcs_wrapper;
+            rest_results->tile_index  = tile_row_idx * tile_cols + tile_col_idx;
+            // Post Rest Results
+            svt_post_full_object(rest_results_wrapper);
+        }
+    }
+}
+
+/* Wraps up the picture once the restoration filters of all planes are decided and applied: pads and
+   outputs the recon, then hands the picture over. Called under rest_search_mutex, returns TRUE when the
+   caller should score the stat-report metrics with *helpers other restoration threads, see
+   rest_run_metrics(). */
+static Bool rest_finish_picture(RestContext *context_ptr, EbObjectWrapper *pcs_wrapper, uint32_t *helpers) {
+    PictureControlSet  *pcs         = (PictureControlSet *)pcs_wrapper->object_ptr;
+    SequenceControlSet *scs         = pcs->scs;
+    Av1Common          *cm          = pcs->ppcs->av1_cm;
+    const Bool          is_16bit    = scs->is_16bit_pipeline;
+    Bool                run_metrics = FALSE;
+
+    if (pcs->ppcs->enable_restoration && pcs->ppcs->frm_hdr.allow_intrabc == 0) {
+        svt_av1_loop_restoration_free_dst(cm);
+        if (cm->sg_filter_ctrls.enabled) {
+            uint8_t best_ep_cnt = 0;
+            uint8_t best_ep     = 0;
+            for (uint8_t i = 0; i < SGRPROJ_PARAMS; i++) {
+                if (cm->sg_frame_ep_cnt[i] > best_ep_cnt) {
+                    best_ep     = i;
+                    best_ep_cnt = cm->sg_frame_ep_cnt[i];
+                }
+            }
+            cm->sg_frame_ep = best_ep;
+        }
+    }
+
+    // delete scaled_input_pic after lr finished
+    EB_DELETE(pcs->scaled_input_pic);
+    if (pcs->ppcs->ref_pic_wrapper != NULL) {
+        // copy stat to ref object (intra_coded_area, Luminance, Scene change detection
+        // flags)
+        copy_statistics_to_ref_obj_ect(pcs, scs);
+    }
+
+    const Bool superres_recode = pcs->ppcs->superres_total_recode_loop > 0 ? TRUE : FALSE;
+
+    // Pad the reference picture and set ref POC
+    {
+        if (pcs->ppcs->is_ref == TRUE)
+            pad_ref_and_set_flags(pcs, scs);
+        else {
+            // convert non-reference frame buffer from 16-bit to 8-bit, to export recon and
+            // psnr/ssim calculation
+            if (is_16bit && scs->static_config.encoder_bit_depth == EB_EIGHT_BIT) {
+                EbPictureBufferDesc *ref_pic_ptr       = pcs->ppcs->enc_dec_ptr->recon_pic;
+                EbPictureBufferDesc *ref_pic_16bit_ptr = pcs->ppcs->enc_dec_ptr->recon_pic_16bit;
+                // Y
+                uint16_t *buf_16bit = (uint16_t *)(ref_pic_16bit_ptr->buffer_y);
+                uint8_t  *buf_8bit  = ref_pic_ptr->buffer_y;
+                svt_convert_16bit_to_8bit(buf_16bit,
+                                          ref_pic_16bit_ptr->stride_y,
+                                          buf_8bit,
+                                          ref_pic_ptr->stride_y,
+                                          ref_pic_16bit_ptr->width + (ref_pic_ptr->org_x << 1),
+                                          ref_pic_16bit_ptr->height + (ref_pic_ptr->org_y << 1));
+
+                //CB
+                buf_16bit = (uint16_t *)(ref_pic_16bit_ptr->buffer_cb);
+                buf_8bit  = ref_pic_ptr->buffer_cb;
+                svt_convert_16bit_to_8bit(
+                    buf_16bit,
+                    ref_pic_16bit_ptr->stride_cb,
+                    buf_8bit,
+                    ref_pic_ptr->stride_cb,
+                    (ref_pic_16bit_ptr->width + (ref_pic_ptr->org_x << 1)) >> scs->subsampling_x,
+                    (ref_pic_16bit_ptr->height + (ref_pic_ptr->org_y << 1)) >> scs->subsampling_y);
+
+                //CR
+                buf_16bit = (uint16_t *)(ref_pic_16bit_ptr->buffer_cr);
+                buf_8bit  = ref_pic_ptr->buffer_cr;
+                svt_convert_16bit_to_8bit(
+                    buf_16bit,
+                    ref_pic_16bit_ptr->stride_cr,
+                    buf_8bit,
+                    ref_pic_ptr->stride_cr,
+                    (ref_pic_16bit_ptr->width + (ref_pic_ptr->org_x << 1)) >> scs->subsampling_x,
+                    (ref_pic_16bit_ptr->height + (ref_pic_ptr->org_y << 1)) >> scs->subsampling_y);
+            }
+        }
+    }
+
+    // superres needs psnr to compute rdcost, the final metrics are computed in packetization
+    if (superres_recode) {
+        EbErrorType return_error = psnr_calculations(pcs, scs, FALSE);
+        if (return_error != EB_ErrorNone) {
+            svt_aom_assert_err(0,
+                               "Couldn't allocate memory for uncompressed 10bit buffers for PSNR "
+                               "calculations");
+        }
+    } else if (scs->static_config.recon_enabled) {
+        svt_aom_recon_output(pcs, scs);
+    }
+
+    // PSNR and SSIM are scored in bands by this thread and the idle restoration threads, the
+    // last one to finish hands the picture over
+    *helpers = 0;
+    if (!superres_recode && scs->static_config.stat_report) {
+        if (svt_aom_metrics_start(pcs, scs->rest_process_init_count, helpers) == EB_ErrorNone)
+            run_metrics = TRUE;
+        else {
+            svt_aom_assert_err(0, "Couldn't allocate memory for PSNR/SSIM calculations");
+            post_rest_results(context_ptr, pcs_wrapper, TRUE);
+        }
+    } else
+        post_rest_results(context_ptr, pcs_wrapper, !superres_recode);
+
+    return run_metrics;
+}
+
+/* Scores the stat-report metrics of a picture along with `helpers` other restoration threads. The
+   helpers are reached by reposting task_wrapper, the input task the caller already holds, as a metrics
+   task that each helper passes on before scoring. No task object has to be taken from the pool, which
+   the CDEF threads fill. Takes ownership of task_wrapper. */
+static void rest_run_metrics(RestContext *context_ptr, EbObjectWrapper *task_wrapper, EbObjectWrapper *pcs_wrapper,
+                             uint32_t helpers) {
+    PictureControlSet *pcs = (PictureControlSet *)pcs_wrapper->object_ptr;
+    if (helpers) {
+        CdefResults *metrics_task   = (CdefResults *)task_wrapper->object_ptr;
+        metrics_task->pcs_wrapper   = pcs_wrapper;
+        metrics_task->segment_index = helpers;
+        metrics_task->input_type    = REST_INPUT_METRICS;
+        svt_post_full_object_front(task_wrapper);
+    } else
+        svt_release_object(task_wrapper);
+
+    SVT_TRACE_BEGIN("metrics", pcs->picture_number, -1);
+    if (svt_aom_metrics_process(pcs, context_ptr->metrics_scratch))
+        post_rest_results(context_ptr, pcs_wrapper, TRUE);
+}
+
+/* Decides and applies the restoration filter of one plane. The planes of a picture are finished by any
+   of the restoration threads, the last one wraps up the picture. The input task of the picture travels
+   with the planes, see rest_post_finish_task(): the thread holding it in *task_wrapper parks it in the
+   PCS unless it finishes last, and the last one takes it back, so it always returns holding the task
+   when the picture is done. */
+static Bool rest_finish_plane(RestContext *context_ptr, EbObjectWrapper *pcs_wrapper, int32_t plane,
+                              EbObjectWrapper **task_wrapper, uint32_t *helpers) {
+    PictureControlSet  *pcs = (PictureControlSet *)pcs_wrapper->object_ptr;
+    SequenceControlSet *scs = pcs->scs;
+    Av1Common          *cm  = pcs->ppcs->av1_cm;
+
+    rest_finish_search_plane(pcs, plane);
+
+    // Only need recon if REF pic or recon is output
+    if ((pcs->ppcs->is_ref || scs->static_config.recon_enabled) &&
+        pcs->rst_info[plane].frame_restoration_type != RESTORE_NONE) {
+        svt_block_on_mutex(pcs->rest_search_mutex);
+        if (!cm->rst_frame.buffer_alloc_sz)
+            svt_av1_loop_restoration_alloc_dst(cm->frame_to_show, cm);
+        svt_release_mutex(pcs->rest_search_mutex);
+        svt_av1_loop_restoration_filter_plane(context_ptr->rst_tmpbuf, cm->frame_to_show, &cm->rst_frame, cm, 0, plane);
+    }
+
+    Bool run_metrics = FALSE;
+    svt_block_on_mutex(pcs->rest_search_mutex);
+    if (++pcs->rest_planes_finished == pcs->rest_plane_count) {
+        if (!*task_wrapper) {
+            *task_wrapper         = pcs->rest_finish_task;
+            pcs->rest_finish_task = NULL;
+        }
+        run_metrics = rest_finish_picture(context_ptr, pcs_wrapper, helpers);
+    } else if (*task_wrapper) {
+        pcs->rest_finish_task = *task_wrapper;
+        *task_wrapper         = NULL;
+    }
+    svt_release_mutex(pcs->rest_search_mutex);
+    return run_metrics;
+}
+
+/* Hands plane `plane` of the picture to an idle restoration thread by reposting task_wrapper, the input
+   task the caller holds, ahead of the queued segments. The receiver reposts it for the next plane, the
+   thread given the last plane keeps it. No task object is taken from the pool, which the CDEF threads
+   fill. */
+static void rest_post_finish_task(EbObjectWrapper *task_wrapper, EbObjectWrapper *pcs_wrapper, uint32_t plane) {
+    CdefResults *finish_task   = (CdefResults *)task_wrapper->object_ptr;
+    finish_task->pcs_wrapper   = pcs_wrapper;
+    finish_task->segment_index = plane;
+    finish_task->input_type    = REST_INPUT_FINISH;
+    svt_post_full_object_front(task_wrapper);
+}
+
+/* Releases the input task, or reposts it to score the metrics, once the caller is done with the
+   picture. task_wrapper may be NULL when another thread carries the task. */
+static void rest_task_done(RestContext *context_ptr, EbObjectWrapper *task_wrapper, EbObjectWrapper *pcs_wrapper,
+                           Bool run_metrics, uint32_t helpers) {
+    if (run_metrics)
+        rest_run_metrics(context_ptr, task_wrapper, pcs_wrapper, helpers);
+    else if (task_wrapper) {
+        // Release input Results
+        svt_release_object(task_wrapper);
+    }
+}
+
 /******************************************************
  * Rest Kernel
  ******************************************************/
@@ -528,25 +764,34 @@ void *svt_aom_rest_kernel(void *input_ptr) {
     EbObjectWrapper *cdef_results_wrapper;
     CdefResults     *cdef_results;
 
-    //// Output
-    EbObjectWrapper     *rest_results_wrapper;
-    RestResults         *rest_results;
-    EbObjectWrapper     *picture_demux_results_wrapper_ptr;
-    PictureDemuxResults *picture_demux_results_rtr;
-    // SB Loop variables
-    uint8_t tile_cols;
-    uint8_t tile_rows;
-
-    Bool superres_recode = FALSE;
-
     for (;;) {
         // Get Cdef Results
         EB_GET_FULL_OBJECT(context_ptr->rest_input_fifo_ptr, &cdef_results_wrapper);
 
         cdef_results                  = (CdefResults *)cdef_results_wrapper->object_ptr;
         pcs                           = (PictureControlSet *)cdef_results->pcs_wrapper->object_ptr;
+        if (cdef_results->input_type == REST_INPUT_METRICS) {
+            // segment_index counts this helper and the ones it still has to wake
+            rest_run_metrics(
+                context_ptr, cdef_results_wrapper, cdef_results->pcs_wrapper, cdef_results->segment_index - 1);
+            continue;
+        }
+        if (cdef_results->input_type == REST_INPUT_FINISH) {
+            EbObjectWrapper *pcs_wrapper = cdef_results->pcs_wrapper;
+            const uint32_t   plane       = cdef_results->segment_index;
+            EbObjectWrapper *task        = cdef_results_wrapper;
+            uint32_t         helpers;
+            if (plane + 1 < pcs->rest_plane_count) {
+                rest_post_finish_task(task, pcs_wrapper, plane + 1);
+                task = NULL;
+            }
+            Bool run_metrics = rest_finish_plane(context_ptr, pcs_wrapper, (int32_t)plane, &task, &helpers);
+            rest_task_done(context_ptr, task, pcs_wrapper, run_metrics, helpers);
+            continue;
+        }
         PictureParentControlSet *ppcs = pcs->ppcs;
         scs                           = pcs->scs;
+        SVT_TRACE_BEGIN("restoration", pcs->picture_number, (int32_t)cdef_results->segment_index);
         FrameHeader *frm_hdr          = &pcs->ppcs->frm_hdr;
         Bool         is_16bit         = scs->is_16bit_pipeline;
         Av1Common   *cm               = pcs->ppcs->av1_cm;
@@ -611,158 +856,38 @@ void *svt_aom_rest_kernel(void *input_ptr) {
         }
 
         //all seg based search is done. update total processed segments. if all done, finish the search and perfrom application.
+        EbObjectWrapper *pcs_wrapper   = cdef_results->pcs_wrapper;
+        EbObjectWrapper *task          = cdef_results_wrapper;
+        Bool             run_metrics   = FALSE;
+        Bool             finish_planes = FALSE;
+        uint32_t         helpers       = 0;
         svt_block_on_mutex(pcs->rest_search_mutex);
 
         pcs->tot_seg_searched_rest++;
         if (pcs->tot_seg_searched_rest == pcs->rest_segments_total_count) {
             if (ppcs->enable_restoration && frm_hdr->allow_intrabc == 0) {
-                rest_finish_search(pcs);
-
-                // Only need recon if REF pic or recon is output
-                if (pcs->ppcs->is_ref || scs->static_config.recon_enabled) {
-                    if (pcs->rst_info[0].frame_restoration_type != RESTORE_NONE ||
-                        pcs->rst_info[1].frame_restoration_type != RESTORE_NONE ||
-                        pcs->rst_info[2].frame_restoration_type != RESTORE_NONE) {
-                        svt_av1_loop_restoration_filter_frame(context_ptr->rst_tmpbuf, cm->frame_to_show, cm, 0);
-                    }
-                }
-
-                if (cm->sg_filter_ctrls.enabled) {
-                    uint8_t best_ep_cnt = 0;
-                    uint8_t best_ep     = 0;
-                    for (uint8_t i = 0; i < SGRPROJ_PARAMS; i++) {
-                        if (cm->sg_frame_ep_cnt[i] > best_ep_cnt) {
-                            best_ep     = i;
-                            best_ep_cnt = cm->sg_frame_ep_cnt[i];
-                        }
-                    }
-                    cm->sg_frame_ep = best_ep;
-                }
+                pcs->rest_plane_count     = (uint8_t)rest_finish_search_init(pcs);
+                pcs->rest_planes_finished = 0;
+                pcs->rest_finish_task     = NULL;
+                finish_planes             = TRUE;
             } else {
                 pcs->rst_info[0].frame_restoration_type = RESTORE_NONE;
                 pcs->rst_info[1].frame_restoration_type = RESTORE_NONE;
                 pcs->rst_info[2].frame_restoration_type = RESTORE_NONE;
-            }
-
-            // delete scaled_input_pic after lr finished
-            EB_DELETE(pcs->scaled_input_pic);
-            if (pcs->ppcs->ref_pic_wrapper != NULL) {
-                // copy stat to ref object (intra_coded_area, Luminance, Scene change detection
-                // flags)
-                copy_statistics_to_ref_obj_ect(pcs, scs);
-            }
-
-            superres_recode = pcs->ppcs->superres_total_recode_loop > 0 ? TRUE : FALSE;
-
-            // Pad the reference picture and set ref POC
-            {
-                if (pcs->ppcs->is_ref == TRUE)
-                    pad_ref_and_set_flags(pcs, scs);
-                else {
-                    // convert non-reference frame buffer from 16-bit to 8-bit, to export recon and
-                    // psnr/ssim calculation
-                    if (is_16bit && scs->static_config.encoder_bit_depth == EB_EIGHT_BIT) {
-                        EbPictureBufferDesc *ref_pic_ptr       = pcs->ppcs->enc_dec_ptr->recon_pic;
-                        EbPictureBufferDesc *ref_pic_16bit_ptr = pcs->ppcs->enc_dec_ptr->recon_pic_16bit;
-                        // Y
-                        uint16_t *buf_16bit = (uint16_t *)(ref_pic_16bit_ptr->buffer_y);
-                        uint8_t  *buf_8bit  = ref_pic_ptr->buffer_y;
-                        svt_convert_16bit_to_8bit(buf_16bit,
-                                                  ref_pic_16bit_ptr->stride_y,
-                                                  buf_8bit,
-                                                  ref_pic_ptr->stride_y,
-                                                  ref_pic_16bit_ptr->width + (ref_pic_ptr->org_x << 1),
-                                                  ref_pic_16bit_ptr->height + (ref_pic_ptr->org_y << 1));
-
-                        //CB
-                        buf_16bit = (uint16_t *)(ref_pic_16bit_ptr->buffer_cb);
-                        buf_8bit  = ref_pic_ptr->buffer_cb;
-                        svt_convert_16bit_to_8bit(
-                            buf_16bit,
-                            ref_pic_16bit_ptr->stride_cb,
-                            buf_8bit,
-                            ref_pic_ptr->stride_cb,
-                            (ref_pic_16bit_ptr->width + (ref_pic_ptr->org_x << 1)) >> scs->subsampling_x,
-                            (ref_pic_16bit_ptr->height + (ref_pic_ptr->org_y << 1)) >> scs->subsampling_y);
-
-                        //CR
-                        buf_16bit = (uint16_t *)(ref_pic_16bit_ptr->buffer_cr);
-                        buf_8bit  = ref_pic_ptr->buffer_cr;
-                        svt_convert_16bit_to_8bit(
-                            buf_16bit,
-                            ref_pic_16bit_ptr->stride_cr,
-                            buf_8bit,
-                            ref_pic_ptr->stride_cr,
-                            (ref_pic_16bit_ptr->width + (ref_pic_ptr->org_x << 1)) >> scs->subsampling_x,
-                            (ref_pic_16bit_ptr->height + (ref_pic_ptr->org_y << 1)) >> scs->subsampling_y);
-                    }
-                }
-            }
-
-            // PSNR and SSIM Calculation.
-            if (superres_recode) { // superres needs psnr to compute rdcost
-                // Note: if superres recode is actived, memory needs to be freed in packetization process by calling free_temporal_filtering_buffer()
-                EbErrorType return_error = psnr_calculations(pcs, scs, FALSE);
-                if (return_error != EB_ErrorNone) {
-                    svt_aom_assert_err(0,
-                                       "Couldn't allocate memory for uncompressed 10bit buffers for PSNR "
-                                       "calculations");
-                }
-            } else if (scs->static_config.stat_report) {
-                // Note: if temporal_filtering is used, memory needs to be freed in the last of these calls
-                EbErrorType return_error = psnr_calculations(pcs, scs, FALSE);
-                if (return_error != EB_ErrorNone) {
-                    svt_aom_assert_err(0,
-                                       "Couldn't allocate memory for uncompressed 10bit buffers for PSNR "
-                                       "calculations");
-                }
-                return_error = svt_aom_ssim_calculations(pcs, scs, TRUE /* free memory here */);
-                if (return_error != EB_ErrorNone) {
-                    svt_aom_assert_err(0,
-                                       "Couldn't allocate memory for uncompressed 10bit buffers for SSIM "
-                                       "calculations");
-                }
-            }
-
-            if (!superres_recode) {
-                if (scs->static_config.recon_enabled) {
-                    svt_aom_recon_output(pcs, scs);
-                }
-                // post reference picture task in packetization process if it's superres_recode
-                if (pcs->ppcs->is_ref) {
-                    // Get Empty PicMgr Results
-                    svt_get_empty_object(context_ptr->picture_demux_fifo_ptr, &picture_demux_results_wrapper_ptr);
-
-                    picture_demux_results_rtr = (PictureDemuxResults *)picture_demux_results_wrapper_ptr->object_ptr;
-                    picture_demux_results_rtr->ref_pic_wrapper = pcs->ppcs->ref_pic_wrapper;
-                    picture_demux_results_rtr->scs             = pcs->scs;
-                    picture_demux_results_rtr->picture_number  = pcs->picture_number;
-                    picture_demux_results_rtr->picture_type    = EB_PIC_REFERENCE;
-
-                    // Post Reference Picture
-                    svt_post_full_object(picture_demux_results_wrapper_ptr);
-                }
-            }
-
-            tile_cols = pcs->ppcs->av1_cm->tiles_info.tile_cols;
-            tile_rows = pcs->ppcs->av1_cm->tiles_info.tile_rows;
-
-            for (int tile_row_idx = 0; tile_row_idx < tile_rows; tile_row_idx++) {
-                for (int tile_col_idx = 0; tile_col_idx < tile_cols; tile_col_idx++) {
-                    const int tile_idx = tile_row_idx * tile_cols + tile_col_idx;
-                    svt_get_empty_object(context_ptr->rest_output_fifo_ptr, &rest_results_wrapper);
-                    rest_results              = (struct RestResults *)rest_results_wrapper->object_ptr;
-                    rest_results->pcs_wrapper = cdef_results->pcs_wrapper;
-                    rest_results->tile_index  = tile_idx;
-                    // Post Rest Results
-                    svt_post_full_object(rest_results_wrapper);
-                }
+                run_metrics = rest_finish_picture(context_ptr, pcs_wrapper, &helpers);
             }
         }
         svt_release_mutex(pcs->rest_search_mutex);
 
-        // Release input Results
-        svt_release_object(cdef_results_wrapper);
+        if (finish_planes) {
+            // the chroma planes are finished by the idle restoration threads
+            if (pcs->rest_plane_count > 1) {
+                rest_post_finish_task(task, pcs_wrapper, AOM_PLANE_U);
+                task = NULL;
+            }
+            run_metrics = rest_finish_plane(context_ptr, pcs_wrapper, AOM_PLANE_Y, &task, &helpers);
+        }
+        rest_task_done(context_ptr, task, pcs_wrapper, run_metrics, helpers);
     }
 
     return NULL;
@@ -1176,19 +1176,59 @@ static void filter_frame_on_unit(const RestorationTileLimits *limits, const Av1P
                                          rsi->optimized_lr);
 }
 
-void svt_av1_loop_restoration_filter_frame(int32_t *rst_tmpbuf, Yv12BufferConfig *frame, Av1Common *cm,
-                                           int32_t optimized_lr) {
-    // assert(!cm->all_lossless);
-    const int32_t num_planes = 3; // av1_num_planes(cm);
+/* Filters one plane of frame into the same plane of dst, then copies it back. Each plane only
+   touches its own buffers, so different threads may filter the planes of a frame at once. */
+void svt_av1_loop_restoration_filter_plane(int32_t *rst_tmpbuf, Yv12BufferConfig *frame, Yv12BufferConfig *dst,
+                                           Av1Common *cm, int32_t optimized_lr, int32_t plane) {
     typedef void (*CopyFun)(const Yv12BufferConfig *src, Yv12BufferConfig *dst);
     static const CopyFun copy_funs[3] = {
         svt_aom_yv12_copy_y_c, svt_aom_yv12_copy_u_c, svt_aom_yv12_copy_v_c}; //CHKN SSE
 
-    Yv12BufferConfig *dst = &cm->rst_frame;
+    RestorationLineBuffers rlbs;
+    const int32_t          bit_depth = cm->bit_depth;
+    const int32_t          highbd    = cm->use_highbitdepth;
+
+    RestorationInfo *rsi   = &cm->child_pcs->rst_info[plane];
+    RestorationType  rtype = rsi->frame_restoration_type;
+    rsi->optimized_lr      = optimized_lr;
 
+    if (rtype == RESTORE_NONE)
+        return;
+    const int32_t is_uv        = plane > 0;
+    const int32_t plane_width  = frame->crop_widths[is_uv];
+    const int32_t plane_height = frame->crop_heights[is_uv];
+
+    svt_extend_frame(frame->buffers[plane],
+                     plane_width,
+                     plane_height,
+                     frame->strides[is_uv],
+                     RESTORATION_BORDER,
+                     RESTORATION_BORDER,
+                     highbd);
+
+    FilterFrameCtxt ctxt;
+    ctxt.rsi         = rsi;
+    ctxt.rlbs        = &rlbs;
+    ctxt.cm          = cm;
+    ctxt.ss_x        = is_uv && cm->subsampling_x;
+    ctxt.ss_y        = is_uv && cm->subsampling_y;
+    ctxt.highbd      = highbd;
+    ctxt.bit_depth   = bit_depth;
+    ctxt.data8       = frame->buffers[plane];
+    ctxt.dst8        = dst->buffers[plane];
+    ctxt.data_stride = frame->strides[is_uv];
+    ctxt.dst_stride  = dst->strides[is_uv];
+    ctxt.tmpbuf      = rst_tmpbuf;
+    svt_aom_foreach_rest_unit_in_frame(cm, plane, filter_frame_on_tile, filter_frame_on_unit, &ctxt);
+
+    copy_funs[plane](dst, frame);
+}
+
+/* Allocates cm->rst_frame, the destination of the filtered planes, for frame. */
+void svt_av1_loop_restoration_alloc_dst(const Yv12BufferConfig *frame, Av1Common *cm) {
     const int32_t frame_width  = frame->crop_widths[0];
     const int32_t frame_height = frame->crop_heights[0];
-    if (svt_aom_realloc_frame_buffer(dst,
+    if (svt_aom_realloc_frame_buffer(&cm->rst_frame,
                                      frame_width,
                                      frame_height,
                                      cm->subsampling_x,
@@ -1200,47 +1240,10 @@ void svt_av1_loop_restoration_filter_frame(int32_t *rst_tmpbuf, Yv12BufferConfig
                                      NULL,
                                      NULL) < 0)
         SVT_LOG("Failed to allocate restoration dst buffer\n");
+}
 
-    RestorationLineBuffers rlbs;
-    const int32_t          bit_depth = cm->bit_depth;
-    const int32_t          highbd    = cm->use_highbitdepth;
-
-    for (int32_t plane = 0; plane < num_planes; ++plane) {
-        RestorationInfo *rsi   = &cm->child_pcs->rst_info[plane];
-        RestorationType  rtype = rsi->frame_restoration_type;
-        rsi->optimized_lr      = optimized_lr;
-
-        if (rtype == RESTORE_NONE)
-            continue;
-        const int32_t is_uv        = plane > 0;
-        const int32_t plane_width  = frame->crop_widths[is_uv];
-        const int32_t plane_height = frame->crop_heights[is_uv];
-
-        svt_extend_frame(frame->buffers[plane],
-                         plane_width,
-                         plane_height,
-                         frame->strides[is_uv],
-                         RESTORATION_BORDER,
-                         RESTORATION_BORDER,
-                         highbd);
-
-        FilterFrameCtxt ctxt;
-        ctxt.rsi         = rsi;
-        ctxt.rlbs        = &rlbs;
-        ctxt.cm          = cm;
-        ctxt.ss_x        = is_uv && cm->subsampling_x;
-        ctxt.ss_y        = is_uv && cm->subsampling_y;
-        ctxt.highbd      = highbd;
-        ctxt.bit_depth   = bit_depth;
-        ctxt.data8       = frame->buffers[plane];
-        ctxt.dst8        = dst->buffers[plane];
-        ctxt.data_stride = frame->strides[is_uv];
-        ctxt.dst_stride  = dst->strides[is_uv];
-        ctxt.tmpbuf      = rst_tmpbuf;
-        svt_aom_foreach_rest_unit_in_frame(cm, plane, filter_frame_on_tile, filter_frame_on_unit, &ctxt);
-
-        copy_funs[plane](dst, frame);
-    }
+void svt_av1_loop_restoration_free_dst(Av1Common *cm) {
+    Yv12BufferConfig *dst = &cm->rst_frame;
     if (dst->buffer_alloc_sz) {
         dst->buffer_alloc_sz = 0;
         EB_FREE_ARRAY(dst->buffer_alloc);
@@ -1549,85 +1549,84 @@ void restoration_seg_search(int32_t *rst_tmpbuf, Yv12BufferConfig *org_fts, cons
                                                    segment_index);
     }
 }
+/* Returns the number of planes searched for the picture, and disables the chroma
+   restoration when only luma was searched. */
+int32_t rest_finish_search_init(PictureControlSet *pcs) {
+    Av1Common *const cm        = pcs->ppcs->av1_cm;
+    const int32_t    plane_end = ((cm->wn_filter_ctrls.enabled && cm->wn_filter_ctrls.use_chroma) ||
+                               (cm->sg_filter_ctrls.enabled && cm->sg_filter_ctrls.use_chroma))
+           ? AOM_PLANE_V
+           : AOM_PLANE_Y;
+
+    // if restoration performed for luma only, set chroma to RESTORE_NONE
+    if (plane_end == AOM_PLANE_Y) {
+        pcs->rst_info[1].frame_restoration_type = RESTORE_NONE;
+        pcs->rst_info[2].frame_restoration_type = RESTORE_NONE;
+    }
+    return plane_end + 1;
+}
 /* Given the best parameters for each type of filter and their associated SSEs,
-   decide which filter should be used for each filter block.
+   decide which filter should be used for each filter block of the plane.
+   The planes are independent, and may be finished by different threads.
 */
-void rest_finish_search(PictureControlSet *pcs) {
+void rest_finish_search_plane(PictureControlSet *pcs, int32_t plane) {
     Macroblock              *x                    = pcs->ppcs->av1x;
     Av1Common *const         cm                   = pcs->ppcs->av1_cm;
     PictureParentControlSet *p_pcs_ptr            = pcs->ppcs;
     RestorationType          force_restore_type_d = (cm->wn_filter_ctrls.enabled)
                  ? ((cm->sg_filter_ctrls.enabled) ? RESTORE_TYPES : RESTORE_WIENER)
                  : ((cm->sg_filter_ctrls.enabled) ? RESTORE_SGRPROJ : RESTORE_NONE);
-    int32_t                  ntiles[2];
-    for (int32_t is_uv = 0; is_uv < 2; ++is_uv) ntiles[is_uv] = rest_tiles_in_plane(cm, is_uv);
-
-    assert(ntiles[1] <= ntiles[0]);
-    RestUnitSearchInfo *rusi = (RestUnitSearchInfo *)svt_aom_memalign(16, sizeof(*rusi) * ntiles[0]);
+    const int32_t            plane_ntiles         = rest_tiles_in_plane(cm, plane);
+    RestUnitSearchInfo *rusi = (RestUnitSearchInfo *)svt_aom_memalign(16, sizeof(*rusi) * plane_ntiles);
 
     // If the restoration unit dimensions are not multiples of
     // rsi->restoration_unit_size then some elements of the rusi array may be
     // left uninitialised when we reach copy_unit_info(...). This is not a
     // problem, as these elements are ignored later, but in order to quiet
     // Valgrind's warnings we initialise the array below.
-    memset(rusi, 0, sizeof(*rusi) * ntiles[0]);
+    memset(rusi, 0, sizeof(*rusi) * plane_ntiles);
 
+    //init rsc context for this plane
     RestSearchCtxt rsc;
-    const int32_t  plane_start = AOM_PLANE_Y;
-    const int32_t  plane_end   = ((cm->wn_filter_ctrls.enabled && cm->wn_filter_ctrls.use_chroma) ||
-                               (cm->sg_filter_ctrls.enabled && cm->sg_filter_ctrls.use_chroma))
-           ? AOM_PLANE_V
-           : AOM_PLANE_Y;
+    rsc.cm       = cm;
+    rsc.x        = x;
+    rsc.plane    = plane;
+    rsc.rusi     = rusi;
+    rsc.pic_num  = (uint32_t)p_pcs_ptr->picture_number;
+    rsc.rusi_pic = pcs->rusi_picture[plane];
 
-    for (int32_t plane = plane_start; plane <= plane_end; ++plane) {
-        //init rsc context for this plane
-        rsc.cm       = cm;
-        rsc.x        = x;
-        rsc.plane    = plane;
-        rsc.rusi     = rusi;
-        rsc.pic_num  = (uint32_t)p_pcs_ptr->picture_number;
-        rsc.rusi_pic = pcs->rusi_picture[plane];
+    const RestorationType num_rtypes = (plane_ntiles > 1) ? RESTORE_TYPES : RESTORE_SWITCHABLE_TYPES;
 
-        const int32_t         plane_ntiles = ntiles[plane > 0];
-        const RestorationType num_rtypes   = (plane_ntiles > 1) ? RESTORE_TYPES : RESTORE_SWITCHABLE_TYPES;
+    double          best_cost  = 0;
+    RestorationType best_rtype = RESTORE_NONE;
 
-        double          best_cost  = 0;
-        RestorationType best_rtype = RESTORE_NONE;
+    for (int32_t rest_type = 0; rest_type < num_rtypes; ++rest_type) {
+        RestorationType r = (RestorationType)rest_type;
 
-        for (int32_t rest_type = 0; rest_type < num_rtypes; ++rest_type) {
-            RestorationType r = (RestorationType)rest_type;
+        if ((force_restore_type_d != RESTORE_TYPES) && (r != RESTORE_NONE) && (r != force_restore_type_d))
+            continue;
 
-            if ((force_restore_type_d != RESTORE_TYPES) && (r != RESTORE_NONE) && (r != force_restore_type_d))
+        if (plane) {
+            // if current filter was not tested for chroma plane, do not check the cost
+            if ((r == RESTORE_WIENER && !cm->wn_filter_ctrls.use_chroma) ||
+                (r == RESTORE_SGRPROJ && !cm->sg_filter_ctrls.use_chroma))
                 continue;
-
-            if (plane) {
-                // if current filter was not tested for chroma plane, do not check the cost
-                if ((r == RESTORE_WIENER && !cm->wn_filter_ctrls.use_chroma) ||
-                    (r == RESTORE_SGRPROJ && !cm->sg_filter_ctrls.use_chroma))
-                    continue;
-            }
-
-            double cost = search_rest_type_finish(&rsc, r);
-
-            if (r == 0 || cost < best_cost) {
-                best_cost  = cost;
-                best_rtype = r;
-            }
         }
-        cm->child_pcs->rst_info[plane].frame_restoration_type = best_rtype;
-        if (force_restore_type_d != RESTORE_TYPES)
-            assert(best_rtype == force_restore_type_d || best_rtype == RESTORE_NONE);
 
-        if (best_rtype != RESTORE_NONE) {
-            for (int32_t u = 0; u < plane_ntiles; ++u)
-                copy_unit_info(best_rtype, &rusi[u], &cm->child_pcs->rst_info[plane].unit_info[u]);
+        double cost = search_rest_type_finish(&rsc, r);
+
+        if (r == 0 || cost < best_cost) {
+            best_cost  = cost;
+            best_rtype = r;
         }
     }
+    cm->child_pcs->rst_info[plane].frame_restoration_type = best_rtype;
+    if (force_restore_type_d != RESTORE_TYPES)
+        assert(best_rtype == force_restore_type_d || best_rtype == RESTORE_NONE);
 
-    // if restoration performed for luma only, set chroma to RESTORE_NONE
-    if (plane_end == AOM_PLANE_Y) {
-        pcs->rst_info[1].frame_restoration_type = RESTORE_NONE;
-        pcs->rst_info[2].frame_restoration_type = RESTORE_NONE;
+    if (best_rtype != RESTORE_NONE) {
+        for (int32_t u = 0; u < plane_ntiles; ++u)
+            copy_unit_info(best_rtype, &rusi[u], &cm->child_pcs->rst_info[plane].unit_info[u]);
     }
 
     svt_aom_free(rusi);
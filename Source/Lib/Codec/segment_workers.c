@@ -0,0 +1,148 @@
+/*
+* Copyright (c) 2024, Alliance for Open Media. All rights reserved
+*
+* This source code is subject to the terms of the BSD 2 Clause License and
+* the Alliance for Open Media Patent License 1.0. If the BSD 2 Clause License
+* was not distributed with this source code in the LICENSE file, you can
+* obtain it at https://www.aomedia.org/license/software-license. If the Alliance for Open
+* Media Patent License 1.0 was not distributed with this source code in the
+* PATENTS file, you can obtain it at https://www.aomedia.org/license/patent-license.
+*/
+
+#include "segment_workers.h"
+#include "svt_threads.h"
+#include "svt_trace.h"
+#include "utility.h"
+
+static EbErrorType segment_task_creator(EbPtr *object_dbl_ptr, EbPtr object_init_data_ptr) {
+    SegmentTask *task;
+    (void)object_init_data_ptr;
+
+    *object_dbl_ptr = NULL;
+    EB_CALLOC_ARRAY(task, 1);
+    *object_dbl_ptr = task;
+
+    return EB_ErrorNone;
+}
+
+static void segment_workers_dctor(EbPtr p) {
+    SegmentWorkers *obj = (SegmentWorkers *)p;
+    svt_aom_segment_workers_stop(obj);
+    EB_DELETE(obj->tasks_resource_ptr);
+    EB_FREE_ARRAY(obj->tasks_fifo_ptr_array);
+}
+
+EbErrorType svt_aom_segment_workers_ctor(SegmentWorkers *workers, const char *name, uint32_t worker_count,
+                                         uint32_t dispatcher_count, Bool lock_free) {
+    workers->dctor        = segment_workers_dctor;
+    workers->name         = name;
+    workers->worker_count = worker_count;
+
+    EB_NEW(workers->tasks_resource_ptr,
+           svt_system_resource_ctor,
+           worker_count * dispatcher_count,
+           dispatcher_count,
+           worker_count,
+           segment_task_creator,
+           NULL,
+           NULL,
+           lock_free);
+    EB_MALLOC_ARRAY(workers->tasks_fifo_ptr_array, worker_count);
+    for (uint32_t i = 0; i < worker_count; i++)
+        workers->tasks_fifo_ptr_array[i] = svt_system_resource_get_consumer_fifo(workers->tasks_resource_ptr, i);
+
+    return EB_ErrorNone;
+}
+
+uint64_t svt_aom_segment_workers_size(uint32_t worker_count, uint32_t dispatcher_count, Bool lock_free) {
+    if (!worker_count)
+        return 0;
+    const uint32_t task_count = worker_count * dispatcher_count;
+    return sizeof(SegmentWorkers) + svt_system_resource_size(task_count, dispatcher_count, worker_count, lock_free) +
+        (uint64_t)task_count * sizeof(SegmentTask) + (uint64_t)worker_count * sizeof(EbFifo *);
+}
+
+/* Counts a band run by a worker and wakes the dispatcher after the last one */
+static void segment_done(SegmentDispatch *dispatch) {
+    svt_block_on_mutex(dispatch->mutex);
+    const Bool last_segment = ++dispatch->segments_done == dispatch->segment_count - 1;
+    svt_release_mutex(dispatch->mutex);
+    if (last_segment)
+        svt_post_semaphore(dispatch->done_semaphore);
+}
+
+/******************************************************
+ * Segment Worker Kernel
+ * Runs the bands posted by the dispatching stage threads, all but the first band of each job
+ ******************************************************/
+void *svt_aom_segment_worker_kernel(void *input_ptr) {
+    EbFifo          *tasks_fifo_ptr = (EbFifo *)input_ptr;
+    EbObjectWrapper *task_wrapper;
+
+    for (;;) {
+        // Get Segment Task
+        EB_GET_FULL_OBJECT(tasks_fifo_ptr, &task_wrapper);
+
+        SegmentTask     *task     = (SegmentTask *)task_wrapper->object_ptr;
+        SegmentDispatch *dispatch = task->dispatch;
+        SVT_TRACE_BEGIN(dispatch->name, dispatch->picture_number, task->segment_index);
+
+        dispatch->func(dispatch->job, task->segment_index, dispatch->segment_count);
+        segment_done(dispatch);
+
+        svt_release_object(task_wrapper);
+    }
+    return NULL;
+}
+
+void svt_aom_segment_workers_stop(SegmentWorkers *workers) {
+    if (workers)
+        EB_DESTROY_THREAD_ARRAY(workers->thread_handle_array, workers->worker_count);
+}
+
+void svt_aom_segment_workers_shutdown(const SegmentWorkers *workers) {
+    if (workers)
+        svt_shutdown_process(workers->tasks_resource_ptr);
+}
+
+EbErrorType svt_aom_segment_dispatch_init(SegmentDispatch *dispatch, const SegmentWorkers *workers,
+                                          uint32_t dispatcher_index, uint16_t max_segment_count) {
+    dispatch->max_segment_count = 1;
+    if (!workers)
+        return EB_ErrorNone;
+    dispatch->name              = workers->name;
+    dispatch->max_segment_count = (uint16_t)MAX(1, MIN(max_segment_count, workers->worker_count + 1));
+    dispatch->tasks_fifo_ptr    = svt_system_resource_get_producer_fifo(workers->tasks_resource_ptr, dispatcher_index);
+    EB_CREATE_SEMAPHORE(dispatch->done_semaphore, 0, 1);
+    EB_CREATE_MUTEX(dispatch->mutex);
+
+    return EB_ErrorNone;
+}
+
+void svt_aom_segment_dispatch_deinit(SegmentDispatch *dispatch) {
+    EB_DESTROY_SEMAPHORE(dispatch->done_semaphore);
+    EB_DESTROY_MUTEX(dispatch->mutex);
+}
+
+void svt_aom_segment_dispatch_run(SegmentDispatch *dispatch, uint16_t segment_count, SegmentJobFunc func, void *job) {
+    assert(segment_count >= 1 && segment_count <= dispatch->max_segment_count);
+    if (segment_count == 1) {
+        func(job, 0, 1);
+        return;
+    }
+
+    dispatch->segment_count = segment_count;
+    dispatch->segments_done = 0;
+    dispatch->func          = func;
+    dispatch->job           = job;
+    for (uint16_t seg = 1; seg < segment_count; ++seg) {
+        EbObjectWrapper *task_wrapper;
+        svt_get_empty_object(dispatch->tasks_fifo_ptr, &task_wrapper);
+        SegmentTask *task   = (SegmentTask *)task_wrapper->object_ptr;
+        task->dispatch      = dispatch;
+        task->segment_index = seg;
+        svt_post_full_object(task_wrapper);
+    }
+    func(job, 0, segment_count);
+    svt_block_on_semaphore(dispatch->done_semaphore);
+}
@@ -0,0 +1,91 @@
+/*
+* Copyright (c) 2024, Alliance for Open Media. All rights reserved
+*
+* This source code is subject to the terms of the BSD 2 Clause License and
+* the Alliance for Open Media Patent License 1.0. If the BSD 2 Clause License
+* was not distributed with this source code in the LICENSE file, you can
+* obtain it at https://www.aomedia.org/license/software-license. If the Alliance for Open
+* Media Patent License 1.0 was not distributed with this source code in the
+* PATENTS file, you can obtain it at https://www.aomedia.org/license/patent-license.
+*/
+
+#ifndef EbSegmentWorkers_h
+#define EbSegmentWorkers_h
+
+#include "definitions.h"
+#include "sys_resource_manager.h"
+#include "object.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Runs band segment_index of segment_count bands of job */
+typedef void (*SegmentJobFunc)(void *job, uint16_t segment_index, uint16_t segment_count);
+
+/*
+ * Worker threads a stage splits its work over. The dispatching stage thread runs the first band of each
+ * job itself and posts the others, so a stage that can use N bands owns N - 1 workers.
+ */
+typedef struct SegmentWorkers {
+    EbDctor           dctor;
+    const char       *name; // trace stage of the bands run by the workers
+    EbSystemResource *tasks_resource_ptr;
+    EbFifo          **tasks_fifo_ptr_array; // one per worker, handed to its thread
+    EbHandle         *thread_handle_array;
+    uint32_t          worker_count;
+} SegmentWorkers;
+
+/* Splits the jobs of one stage thread over the workers of its stage */
+typedef struct SegmentDispatch {
+    EbFifo        *tasks_fifo_ptr; // NULL without workers, the jobs then run on the calling thread
+    EbHandle       done_semaphore;
+    EbHandle       mutex;
+    uint16_t       max_segment_count;
+    uint16_t       segment_count;
+    uint16_t       segments_done;
+    const char    *name;
+    uint64_t       picture_number; // traced with the bands, set by the stage
+    SegmentJobFunc func;
+    void          *job;
+} SegmentDispatch;
+
+typedef struct SegmentTask {
+    EbDctor          dctor;
+    SegmentDispatch *dispatch;
+    uint16_t         segment_index;
+} SegmentTask;
+
+/*
+ * Creates worker_count workers serving dispatcher_count stage threads; enough tasks are made for every
+ * dispatcher to post a job at once
+ */
+EbErrorType svt_aom_segment_workers_ctor(SegmentWorkers *workers, const char *name, uint32_t worker_count,
+                                         uint32_t dispatcher_count, Bool lock_free);
+/* Bytes svt_aom_segment_workers_ctor() allocates, 0 without workers */
+uint64_t svt_aom_segment_workers_size(uint32_t worker_count, uint32_t dispatcher_count, Bool lock_free);
+
+/* Thread of worker i, started on tasks_fifo_ptr_array[i] */
+extern void *svt_aom_segment_worker_kernel(void *input_ptr);
+/* Both accept NULL workers */
+void svt_aom_segment_workers_stop(SegmentWorkers *workers);
+void svt_aom_segment_workers_shutdown(const SegmentWorkers *workers);
+
+/*
+ * Binds the dispatch of stage thread dispatcher_index to workers, at most max_segment_count bands per job.
+ * Without workers every job runs as a single band on the calling thread.
+ */
+EbErrorType svt_aom_segment_dispatch_init(SegmentDispatch *dispatch, const SegmentWorkers *workers,
+                                          uint32_t dispatcher_index, uint16_t max_segment_count);
+void        svt_aom_segment_dispatch_deinit(SegmentDispatch *dispatch);
+
+/*
+ * Runs job in segment_count bands and returns when all of them are done; the calling thread runs the first
+ * band. segment_count must not exceed the max_segment_count of the dispatch.
+ */
+void svt_aom_segment_dispatch_run(SegmentDispatch *dispatch, uint16_t segment_count, SegmentJobFunc func, void *job);
+
+#ifdef __cplusplus
+}
+#endif
+#endif // EbSegmentWorkers_h
@@ -180,6 +180,8 @@ typedef struct SequenceControlSet {
 #else
     unsigned int core_count;
 #endif
+    // cores shared by the pipeline threads in core_pool mode
+    uint32_t core_pool_size;
 
     /*!< Picture, reference, recon and input output buffer count */
     uint32_t picture_control_set_pool_init_count;
@@ -226,6 +228,10 @@ typedef struct SequenceControlSet {
     uint32_t     cdef_process_init_count;
     uint32_t     rest_process_init_count;
     uint32_t     tpl_disp_process_init_count;
+    /*!< Segment workers of the stages splitting their work in bands, 0 when single threaded */
+    uint32_t     rate_control_sb_process_init_count;
+    uint32_t     cdef_search_process_init_count;
+    uint32_t     denoise_process_init_count;
     uint32_t     total_process_init_count;
     int32_t      lap_rc;
     TWO_PASS     twopass;
@@ -34,6 +34,7 @@
 #include "av1me.h"
 #include "enc_inter_prediction.h"
 #include "resize.h"
+#include "svt_trace.h"
 /**************************************
  * Context
  **************************************/
@@ -1973,6 +1974,7 @@ void *svt_aom_tpl_disp_kernel(void *input_ptr) {
         in_results_ptr = (TplDispResults *)in_results_wrapper_ptr->object_ptr;
 
         PictureParentControlSet *pcs = in_results_ptr->pcs;
+        SVT_TRACE_BEGIN("tpl_dispenser", pcs->picture_number, in_results_ptr->enc_dec_segment_row);
 
         SequenceControlSet *scs = (SequenceControlSet *)pcs->scs;
 
@@ -2302,6 +2304,7 @@ void *svt_aom_source_based_operations_kernel(void *input_ptr) {
         InitialRateControlResults *in_results_ptr = (InitialRateControlResults *)in_results_wrapper_ptr->object_ptr;
         PictureParentControlSet   *pcs            = (PictureParentControlSet *)in_results_ptr->pcs_wrapper->object_ptr;
         SequenceControlSet        *scs            = pcs->scs;
+        SVT_TRACE_BEGIN("source_based_operations", pcs->picture_number, -1);
         if (in_results_ptr->superres_recode) {
             sbo_send_picture_out(context_ptr, pcs, TRUE);
 
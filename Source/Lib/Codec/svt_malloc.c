@@ -20,6 +20,29 @@ void svt_print_alloc_fail_impl(const char* file, int line) {
     SVT_FATAL("allocate memory failed, at %s:%d\n", file, line);
 }
 
+static SVT_THREAD_LOCAL EbMemoryAccount* tls_account;
+static SVT_THREAD_LOCAL uint32_t         tls_category;
+
+void svt_memory_account_bind(EbMemoryAccount* account, SvtAv1MemoryCategory category) {
+    tls_account  = account;
+    tls_category = category;
+}
+
+void svt_memory_account_category(SvtAv1MemoryCategory category) { tls_category = category; }
+
+void svt_memory_account_add_alloc(size_t size) {
+    if (tls_account)
+        tls_account->allocated[tls_category] += size;
+}
+
+void svt_memory_account_usage(const EbMemoryAccount* account, SvtAv1MemoryUsage* usage) {
+    usage->total = 0;
+    for (int i = 0; i < SVT_AV1_MEM_CATEGORIES; i++) {
+        usage->category[i] = account->allocated[i];
+        usage->total += account->allocated[i];
+    }
+}
+
 #ifdef DEBUG_MEMORY_USAGE
 
 static EbHandle g_malloc_mutex;
@@ -27,6 +27,20 @@
 #endif
 void svt_print_alloc_fail_impl(const char* file, int line);
 
+/* Always-on accounting of the encoder memory: while an account is bound to the calling
+ * thread, the allocation macros add the requested sizes to its current category. Frees are
+ * not subtracted, so an account holds the cumulative allocations made while it was bound,
+ * temporaries included. */
+typedef struct EbMemoryAccount {
+    uint64_t allocated[SVT_AV1_MEM_CATEGORIES];
+} EbMemoryAccount;
+
+/* Binds account (NULL unbinds) to the calling thread, starting with category */
+void svt_memory_account_bind(EbMemoryAccount* account, SvtAv1MemoryCategory category);
+void svt_memory_account_category(SvtAv1MemoryCategory category);
+void svt_memory_account_add_alloc(size_t size);
+void svt_memory_account_usage(const EbMemoryAccount* account, SvtAv1MemoryUsage* usage);
+
 #ifdef DEBUG_MEMORY_USAGE
 void svt_print_memory_usage(void);
 void svt_increase_component_count(void);
@@ -66,8 +80,11 @@ void svt_remove_mem_entry(void* ptr, EbPtrType type);
     do {                                              \
         if (!p)                                       \
             svt_print_alloc_fail(__FILE__, __LINE__); \
-        else                                          \
+        else {                                        \
             EB_ADD_MEM_ENTRY(p, type, size);          \
+            if ((type) < EB_MUTEX)                    \
+                svt_memory_account_add_alloc(size);   \
+        }                                             \
     } while (0)
 
 #define EB_CHECK_MEM(p)                           \
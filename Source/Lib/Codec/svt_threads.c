@@ -42,12 +42,20 @@
 #include <errno.h>
 #include <fcntl.h>
 #include <pthread.h>
+#include <sched.h>
 #include <semaphore.h>
 #include <unistd.h>
 #endif // _WIN32
 #ifdef __APPLE__
 #include <dispatch/dispatch.h>
 #endif
+
+// core pool the calling thread belongs to, NULL outside of core_pool mode
+static SVT_THREAD_LOCAL SvtCorePool *tls_core_pool;
+// core pool joined by the threads the calling thread creates
+static SVT_THREAD_LOCAL SvtCorePool *tls_spawn_pool;
+
+static EbErrorType wait_semaphore(EbHandle semaphore_handle);
 #if PRINTF_TIME
 #include <time.h>
 #ifdef _WIN32
@@ -114,12 +122,43 @@ end:
 }
 #endif
 
+typedef struct CorePoolThread {
+    void *(*thread_function)(void *);
+    void        *thread_context;
+    SvtCorePool *pool;
+} CorePoolThread;
+
+/* Runs a pool member thread, which holds a core whenever it is not blocked */
+static void *core_pool_thread(void *arg) {
+    CorePoolThread thread = *(CorePoolThread *)arg;
+    free(arg);
+
+    tls_core_pool = thread.pool;
+    wait_semaphore(thread.pool->cores);
+    void *ret = thread.thread_function(thread.thread_context);
+    svt_post_semaphore(thread.pool->cores);
+    return ret;
+}
+
 /****************************************
  * svt_create_thread
  ****************************************/
 EbHandle svt_create_thread(void *thread_function(void *), void *thread_context) {
     EbHandle thread_handle = NULL;
 
+    if (tls_spawn_pool) {
+        CorePoolThread *thread = (CorePoolThread *)malloc(sizeof(*thread));
+        if (thread == NULL) {
+            SVT_ERROR("Failed to allocate thread handle\n");
+            return NULL;
+        }
+        thread->thread_function = thread_function;
+        thread->thread_context  = thread_context;
+        thread->pool            = tls_spawn_pool;
+        thread_function         = core_pool_thread;
+        thread_context          = thread;
+    }
+
 #ifdef _WIN32
 
     thread_handle = (EbHandle)CreateThread(
@@ -129,6 +168,8 @@ EbHandle svt_create_thread(void *thread_function(void *), void *thread_context)
         thread_context, // context to be tied to the new thread
         0, // thread active when created
         NULL); // new thread ID
+    if (thread_handle == NULL && tls_spawn_pool)
+        free(thread_context);
 
 #else
     if (pthread_once(&checked_once, check_set_prio)) {
@@ -167,6 +208,8 @@ EbHandle svt_create_thread(void *thread_function(void *), void *thread_context)
         SVT_ERROR("Failed to create thread: %s\n", strerror(ret));
         free(th);
         pthread_attr_destroy(&attr);
+        if (tls_spawn_pool)
+            free(thread_context);
         return NULL;
     }
 
@@ -242,6 +285,14 @@ EbErrorType svt_destroy_thread(EbHandle thread_handle) {
     return error_return;
 }
 
+void svt_yield_thread(void) {
+#ifdef _WIN32
+    SwitchToThread();
+#else
+    sched_yield();
+#endif
+}
+
 /***************************************
  * svt_create_semaphore
  ***************************************/
@@ -291,10 +342,35 @@ EbErrorType svt_post_semaphore(EbHandle semaphore_handle) {
     return return_error;
 }
 
+/* Takes the semaphore only if that does not block */
+static bool try_semaphore(EbHandle semaphore_handle) {
+#ifdef _WIN32
+    return WaitForSingleObject((HANDLE)semaphore_handle, 0) == WAIT_OBJECT_0;
+#elif defined(__APPLE__)
+    return dispatch_semaphore_wait((dispatch_semaphore_t)semaphore_handle, DISPATCH_TIME_NOW) == 0;
+#else
+    return sem_trywait((sem_t *)semaphore_handle) == 0;
+#endif
+}
+
 /***************************************
  * svt_block_on_semaphore
  ***************************************/
 EbErrorType svt_block_on_semaphore(EbHandle semaphore_handle) {
+    SvtCorePool *pool = tls_core_pool;
+    if (pool == NULL)
+        return wait_semaphore(semaphore_handle);
+    if (try_semaphore(semaphore_handle))
+        return EB_ErrorNone;
+
+    // give the core to another thread while blocked
+    svt_post_semaphore(pool->cores);
+    const EbErrorType return_error = wait_semaphore(semaphore_handle);
+    wait_semaphore(pool->cores);
+    return return_error;
+}
+
+static EbErrorType wait_semaphore(EbHandle semaphore_handle) {
     EbErrorType return_error;
 
 #ifdef _WIN32
@@ -374,15 +450,38 @@ EbErrorType svt_release_mutex(EbHandle mutex_handle) {
  * svt_block_on_mutex
  ***************************************/
 EbErrorType svt_block_on_mutex(EbHandle mutex_handle) {
-    EbErrorType return_error;
-
+    SvtCorePool *pool = tls_core_pool;
+    if (pool) {
+        // Never wait for a core while holding the mutex: without a core, only wait for the
+        // mutex to become free, then take a core back and retry
+        for (;;) {
 #ifdef _WIN32
-    return_error = WaitForSingleObject((HANDLE)mutex_handle, INFINITE) ? EB_ErrorMutexUnresponsive : EB_ErrorNone;
+            if (WaitForSingleObject((HANDLE)mutex_handle, 0) == WAIT_OBJECT_0)
 #else
-    return_error = pthread_mutex_lock((pthread_mutex_t *)mutex_handle) ? EB_ErrorMutexUnresponsive : EB_ErrorNone;
+            if (pthread_mutex_trylock((pthread_mutex_t *)mutex_handle) == 0)
+#endif
+                return EB_ErrorNone;
+            // the owner may itself be waiting for a core
+            svt_post_semaphore(pool->cores);
+#ifdef _WIN32
+            const Bool locked = WaitForSingleObject((HANDLE)mutex_handle, INFINITE) == WAIT_OBJECT_0;
+            if (locked)
+                ReleaseMutex((HANDLE)mutex_handle);
+#else
+            const Bool locked = pthread_mutex_lock((pthread_mutex_t *)mutex_handle) == 0;
+            if (locked)
+                pthread_mutex_unlock((pthread_mutex_t *)mutex_handle);
+#endif
+            wait_semaphore(pool->cores);
+            if (!locked)
+                return EB_ErrorMutexUnresponsive;
+        }
+    }
+#ifdef _WIN32
+    return WaitForSingleObject((HANDLE)mutex_handle, INFINITE) ? EB_ErrorMutexUnresponsive : EB_ErrorNone;
+#else
+    return pthread_mutex_lock((pthread_mutex_t *)mutex_handle) ? EB_ErrorMutexUnresponsive : EB_ErrorNone;
 #endif
-
-    return return_error;
 }
 
 /***************************************
@@ -457,18 +556,58 @@ EbErrorType svt_set_cond_var(CondVar *cond_var, int32_t newval) {
 */
 
 EbErrorType svt_wait_cond_var(CondVar *cond_var, int32_t input) {
-    EbErrorType return_error;
+    EbErrorType  return_error;
+    SvtCorePool *pool      = tls_core_pool;
+    bool         gave_core = false;
 
 #ifdef _WIN32
 
     EnterCriticalSection(&cond_var->cs);
+    if (pool && cond_var->val == input) {
+        svt_post_semaphore(pool->cores);
+        gave_core = true;
+    }
     while (cond_var->val == input) SleepConditionVariableCS(&cond_var->cv, &cond_var->cs, INFINITE);
     LeaveCriticalSection(&cond_var->cs);
     return_error = EB_ErrorNone;
 #else
     return_error = pthread_mutex_lock(&cond_var->m_mutex);
+    if (pool && cond_var->val == input) {
+        svt_post_semaphore(pool->cores);
+        gave_core = true;
+    }
     while (cond_var->val == input) return_error = pthread_cond_wait(&cond_var->m_cond, &cond_var->m_mutex);
     return_error = pthread_mutex_unlock(&cond_var->m_mutex);
 #endif
+    if (gave_core)
+        wait_semaphore(pool->cores);
     return return_error;
 }
+
+/*
+    core pool
+*/
+SvtCorePool *svt_core_pool_create(uint32_t core_count) {
+    SvtCorePool *pool = (SvtCorePool *)malloc(sizeof(*pool));
+    if (pool == NULL)
+        return NULL;
+    pool->cores = svt_create_semaphore(core_count, core_count);
+    if (pool->cores == NULL) {
+        free(pool);
+        return NULL;
+    }
+    return pool;
+}
+
+void svt_core_pool_destroy(SvtCorePool *pool) {
+    if (pool == NULL)
+        return;
+    if (tls_spawn_pool == pool)
+        tls_spawn_pool = NULL;
+    svt_destroy_semaphore(pool->cores);
+    free(pool);
+}
+
+void svt_core_pool_attach_new_threads(SvtCorePool *pool) { tls_spawn_pool = pool; }
+
+Bool svt_core_pool_member(void) { return tls_core_pool != NULL; }
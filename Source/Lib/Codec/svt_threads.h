@@ -18,6 +18,12 @@
 #include <windows.h>
 #endif
 
+#ifdef _MSC_VER
+#define SVT_THREAD_LOCAL __declspec(thread)
+#else
+#define SVT_THREAD_LOCAL __thread
+#endif
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -36,6 +42,9 @@ extern EbErrorType svt_stop_thread(EbHandle thread_handle);
 
 extern EbErrorType svt_destroy_thread(EbHandle thread_handle);
 
+/* Lets another ready thread run on this core */
+extern void svt_yield_thread(void);
+
 /**************************************
      * Semaphores
      **************************************/
@@ -138,6 +147,60 @@ EbErrorType svt_set_cond_var(CondVar *cond_var, int32_t newval);
 EbErrorType svt_wait_cond_var(CondVar *cond_var, int32_t input);
 EbErrorType svt_create_cond_var(CondVar *cond_var);
 
+/*
+ Core pool
+
+ Cores shared by all the pipeline threads of an encoder (core_pool mode). A member thread
+ only runs while it holds one of the cores and hands it back whenever it has to block on a
+ semaphore, mutex or condition variable, so the cores go to whichever stages have work.
+*/
+typedef struct SvtCorePool {
+    EbHandle cores; // counting semaphore, one count per free core
+} SvtCorePool;
+
+SvtCorePool *svt_core_pool_create(uint32_t core_count);
+void         svt_core_pool_destroy(SvtCorePool *pool);
+/* Threads created by the calling thread join pool until this is called again with NULL */
+void svt_core_pool_attach_new_threads(SvtCorePool *pool);
+/* TRUE when the calling thread runs on the cores of a pool */
+Bool svt_core_pool_member(void);
+
+/*
+ Atomics
+
+ Sequentially consistent on MSVC, acquire loads, release stores and seq_cst read-modify-write
+ elsewhere. Only used where a lock would be the bottleneck.
+*/
+#ifdef _MSC_VER
+static INLINE int32_t svt_atomic_load_i32(volatile int32_t *p) { return InterlockedOr((volatile LONG *)p, 0); }
+static INLINE void    svt_atomic_store_i32(volatile int32_t *p, int32_t v) { InterlockedExchange((volatile LONG *)p, v); }
+static INLINE int32_t svt_atomic_fetch_add_i32(volatile int32_t *p, int32_t v) {
+    return InterlockedExchangeAdd((volatile LONG *)p, v);
+}
+static INLINE Bool svt_atomic_cas_i32(volatile int32_t *p, int32_t expected, int32_t desired) {
+    return InterlockedCompareExchange((volatile LONG *)p, desired, expected) == expected;
+}
+#define svt_cpu_pause() YieldProcessor()
+#else
+static INLINE int32_t svt_atomic_load_i32(volatile int32_t *p) { return __atomic_load_n(p, __ATOMIC_ACQUIRE); }
+static INLINE void svt_atomic_store_i32(volatile int32_t *p, int32_t v) { __atomic_store_n(p, v, __ATOMIC_RELEASE); }
+static INLINE int32_t svt_atomic_fetch_add_i32(volatile int32_t *p, int32_t v) {
+    return __atomic_fetch_add(p, v, __ATOMIC_SEQ_CST);
+}
+static INLINE Bool svt_atomic_cas_i32(volatile int32_t *p, int32_t expected, int32_t desired) {
+    return __atomic_compare_exchange_n(p, &expected, desired, 0, __ATOMIC_SEQ_CST, __ATOMIC_RELAXED);
+}
+#if defined(__i386__) || defined(__x86_64__)
+#define svt_cpu_pause() __builtin_ia32_pause()
+#elif defined(__aarch64__) || defined(__arm__)
+#define svt_cpu_pause() __asm__ __volatile__("yield")
+#else
+#define svt_cpu_pause() \
+    do {                \
+    } while (0)
+#endif
+#endif
+
 #ifdef __cplusplus
 }
 #endif
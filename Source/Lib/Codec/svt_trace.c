@@ -0,0 +1,300 @@
+/*
+* Copyright (c) 2024, Alliance for Open Media. All rights reserved
+*
+* This source code is subject to the terms of the BSD 2 Clause License and
+* the Alliance for Open Media Patent License 1.0. If the BSD 2 Clause License
+* was not distributed with this source code in the LICENSE file, you can
+* obtain it at https://www.aomedia.org/license/software-license. If the Alliance for Open
+* Media Patent License 1.0 was not distributed with this source code in the
+* PATENTS file, you can obtain it at https://www.aomedia.org/license/patent-license.
+*/
+//for getenv and fopen on windows
+#if defined(_WIN32) && !defined(_CRT_SECURE_NO_WARNINGS)
+#define _CRT_SECURE_NO_WARNINGS
+#endif
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <pthread.h>
+#endif
+
+#include "svt_trace.h"
+#include "svt_threads.h"
+#include "svt_time.h"
+#include "svt_log.h"
+
+#define TRACE_CHUNK_EVENTS 4096
+
+typedef struct TraceEvent {
+    const char *stage;
+    uint64_t    picture_number;
+    int32_t     segment;
+    // input object timestamps, 0 when the span did not start right after a dequeue
+    uint64_t wait_start;
+    uint64_t dequeue;
+    uint64_t post;
+    uint64_t start;
+    uint64_t end;
+} TraceEvent;
+
+typedef struct TraceChunk {
+    struct TraceChunk *next;
+    uint32_t           count;
+    TraceEvent         events[TRACE_CHUNK_EVENTS];
+} TraceChunk;
+
+typedef struct TraceThread {
+    struct TraceThread *next;
+    uint32_t            tid;
+    TraceChunk         *first;
+    TraceChunk         *last;
+    Bool                open;
+    TraceEvent          span;
+    // last dequeue, taken by the next span
+    uint64_t wait_start;
+    uint64_t dequeue;
+    uint64_t post;
+} TraceThread;
+
+Bool svt_trace_enabled;
+
+static char        *trace_path;
+// encoder handles using the trace, guarded by trace_users_mutex
+static uint32_t     trace_users;
+static EbHandle     trace_users_mutex;
+static EbHandle     trace_mutex;
+static TraceThread *trace_threads;
+static uint32_t     trace_thread_count;
+static uint64_t     trace_origin;
+// bumped on every enable, so threads that outlive a trace (the application thread) register again
+static uint32_t trace_generation;
+
+static SVT_THREAD_LOCAL TraceThread *tls_trace;
+static SVT_THREAD_LOCAL uint32_t     tls_trace_generation;
+
+uint64_t svt_trace_now(void) {
+    uint64_t s, us;
+    svt_av1_get_time(&s, &us);
+    return s * 1000000 + us;
+}
+
+static TraceThread *trace_thread(void) {
+    if (tls_trace && tls_trace_generation == trace_generation)
+        return tls_trace;
+    TraceThread *t = (TraceThread *)calloc(1, sizeof(*t));
+    if (t == NULL)
+        return NULL;
+    svt_block_on_mutex(trace_mutex);
+    t->tid        = ++trace_thread_count;
+    t->next       = trace_threads;
+    trace_threads = t;
+    svt_release_mutex(trace_mutex);
+    tls_trace            = t;
+    tls_trace_generation = trace_generation;
+    return t;
+}
+
+static void trace_end_span(TraceThread *t, uint64_t now) {
+    if (!t->open)
+        return;
+    t->open       = FALSE;
+    TraceChunk *c = t->last;
+    if (c == NULL || c->count == TRACE_CHUNK_EVENTS) {
+        c = (TraceChunk *)malloc(sizeof(*c));
+        if (c == NULL)
+            return;
+        c->next  = NULL;
+        c->count = 0;
+        if (t->last)
+            t->last->next = c;
+        else
+            t->first = c;
+        t->last = c;
+    }
+    t->span.end           = now;
+    c->events[c->count++] = t->span;
+}
+
+void svt_trace_wait(void) {
+    TraceThread *t = trace_thread();
+    if (t == NULL)
+        return;
+    const uint64_t now = svt_trace_now();
+    trace_end_span(t, now);
+    t->wait_start = now;
+}
+
+void svt_trace_dequeue(uint64_t post_time) {
+    TraceThread *t = trace_thread();
+    if (t == NULL)
+        return;
+    t->dequeue = svt_trace_now();
+    t->post    = post_time;
+}
+
+void svt_trace_begin(const char *stage, uint64_t picture_number, int32_t segment) {
+    TraceThread *t = trace_thread();
+    if (t == NULL)
+        return;
+    const uint64_t now = svt_trace_now();
+    trace_end_span(t, now);
+    t->span.stage          = stage;
+    t->span.picture_number = picture_number;
+    t->span.segment        = segment;
+    t->span.wait_start     = t->wait_start;
+    t->span.dequeue        = t->dequeue;
+    t->span.post           = t->post;
+    t->span.start          = now;
+    t->open                = TRUE;
+    t->wait_start = t->dequeue = t->post = 0;
+}
+
+static unsigned long long trace_ts(uint64_t t) {
+    return (unsigned long long)(t > trace_origin ? t - trace_origin : 0);
+}
+
+static void trace_write_event(FILE *f, uint32_t tid, const TraceEvent *e) {
+    if (e->wait_start && e->dequeue > e->wait_start)
+        fprintf(f,
+                ",\n{\"ph\":\"X\",\"pid\":1,\"tid\":%u,\"cat\":\"idle\",\"name\":\"wait\",\"ts\":%llu,\"dur\":%llu}",
+                tid,
+                trace_ts(e->wait_start),
+                (unsigned long long)(e->dequeue - e->wait_start));
+    fprintf(f,
+            ",\n{\"ph\":\"X\",\"pid\":1,\"tid\":%u,\"cat\":\"stage\",\"name\":\"%s\",\"ts\":%llu,\"dur\":%llu,"
+            "\"args\":{\"picture\":%llu",
+            tid,
+            e->stage,
+            trace_ts(e->start),
+            (unsigned long long)(e->end - e->start),
+            (unsigned long long)e->picture_number);
+    if (e->segment >= 0)
+        fprintf(f, ",\"segment\":%d", e->segment);
+    if (e->dequeue && e->post)
+        fprintf(f,
+                ",\"enqueue\":%llu,\"dequeue\":%llu,\"queued_us\":%llu",
+                trace_ts(e->post),
+                trace_ts(e->dequeue),
+                (unsigned long long)(e->dequeue > e->post ? e->dequeue - e->post : 0));
+    fprintf(f, "}}");
+}
+
+static void trace_write(void) {
+    FILE *f = fopen(trace_path, "w");
+    if (f == NULL) {
+        SVT_ERROR("Failed to open trace file %s\n", trace_path);
+        return;
+    }
+    fprintf(f, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n");
+    fprintf(f, "{\"ph\":\"M\",\"pid\":1,\"name\":\"process_name\",\"args\":{\"name\":\"SvtAv1Enc\"}}");
+    for (const TraceThread *t = trace_threads; t; t = t->next) {
+        if (t->first == NULL)
+            continue;
+        fprintf(f,
+                ",\n{\"ph\":\"M\",\"pid\":1,\"tid\":%u,\"name\":\"thread_name\",\"args\":{\"name\":\"%s %u\"}}",
+                t->tid,
+                t->first->events[0].stage,
+                t->tid);
+        for (const TraceChunk *c = t->first; c; c = c->next)
+            for (uint32_t i = 0; i < c->count; i++) trace_write_event(f, t->tid, &c->events[i]);
+    }
+    fprintf(f, "\n]}\n");
+    fclose(f);
+    SVT_INFO("Pipeline trace written to %s\n", trace_path);
+}
+
+static void trace_users_mutex_cleanup(void) { svt_destroy_mutex(trace_users_mutex); }
+static void create_trace_users_mutex(void) {
+    trace_users_mutex = svt_create_mutex();
+    atexit(trace_users_mutex_cleanup);
+}
+
+#ifdef _WIN32
+static INIT_ONCE trace_users_once = INIT_ONCE_STATIC_INIT;
+
+static BOOL CALLBACK create_trace_users_mutex_wrapper(PINIT_ONCE InitOnce, PVOID Parameter, PVOID *lpContext) {
+    (void)InitOnce;
+    (void)Parameter;
+    (void)lpContext;
+    create_trace_users_mutex();
+    return TRUE;
+}
+
+static EbHandle get_trace_users_mutex(void) {
+    InitOnceExecuteOnce(&trace_users_once, create_trace_users_mutex_wrapper, NULL, NULL);
+    return trace_users_mutex;
+}
+#else
+static pthread_once_t trace_users_once = PTHREAD_ONCE_INIT;
+
+static EbHandle get_trace_users_mutex(void) {
+    pthread_once(&trace_users_once, create_trace_users_mutex);
+    return trace_users_mutex;
+}
+#endif
+
+// Called with trace_users_mutex held by the first user
+static void trace_start(void) {
+    const char *file = getenv("SVT_TRACE_FILE");
+    if (file == NULL || *file == '\0')
+        return;
+    const size_t len = strlen(file) + 1;
+    trace_path       = (char *)malloc(len);
+    trace_mutex      = svt_create_mutex();
+    if (trace_path == NULL || trace_mutex == NULL) {
+        free(trace_path);
+        trace_path = NULL;
+        if (trace_mutex)
+            svt_destroy_mutex(trace_mutex);
+        trace_mutex = NULL;
+        return;
+    }
+    memcpy(trace_path, file, len);
+    trace_origin = svt_trace_now();
+    trace_generation++;
+    svt_trace_enabled = TRUE;
+}
+
+// Called with trace_users_mutex held by the last user, once all its pipeline threads are gone
+static void trace_stop(void) {
+    svt_trace_enabled = FALSE;
+    trace_write();
+    while (trace_threads) {
+        TraceThread *t = trace_threads;
+        trace_threads  = t->next;
+        while (t->first) {
+            TraceChunk *c = t->first;
+            t->first      = c->next;
+            free(c);
+        }
+        free(t);
+    }
+    trace_thread_count = 0;
+    svt_destroy_mutex(trace_mutex);
+    trace_mutex = NULL;
+    free(trace_path);
+    trace_path = NULL;
+}
+
+void svt_trace_init(void) {
+    EbHandle mutex = get_trace_users_mutex();
+    if (mutex == NULL)
+        return;
+    svt_block_on_mutex(mutex);
+    if (!trace_users++)
+        trace_start();
+    svt_release_mutex(mutex);
+}
+
+void svt_trace_deinit(void) {
+    EbHandle mutex = get_trace_users_mutex();
+    if (mutex == NULL)
+        return;
+    svt_block_on_mutex(mutex);
+    if (trace_users && !--trace_users && svt_trace_enabled)
+        trace_stop();
+    svt_release_mutex(mutex);
+}
@@ -0,0 +1,51 @@
+/*
+* Copyright (c) 2024, Alliance for Open Media. All rights reserved
+*
+* This source code is subject to the terms of the BSD 2 Clause License and
+* the Alliance for Open Media Patent License 1.0. If the BSD 2 Clause License
+* was not distributed with this source code in the LICENSE file, you can
+* obtain it at https://www.aomedia.org/license/software-license. If the Alliance for Open
+* Media Patent License 1.0 was not distributed with this source code in the
+* PATENTS file, you can obtain it at https://www.aomedia.org/license/patent-license.
+*/
+
+#ifndef EbTrace_h
+#define EbTrace_h
+
+#include <stdint.h>
+#include "definitions.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Pipeline tracer, enabled by setting SVT_TRACE_FILE to the output path. Every stage kernel marks
+ * the picture (and segment) it works on with SVT_TRACE_BEGIN, the span ends when the thread goes
+ * back to its input fifo. For each span the trace also keeps when its input object was posted and
+ * when it was dequeued, plus how long the thread was blocked waiting for it. The events are kept in
+ * per-thread buffers and written as Chrome trace JSON (chrome://tracing, ui.perfetto.dev) when the
+ * last encoder handle is released. When disabled the cost is one load and branch per call site.
+ */
+extern Bool svt_trace_enabled;
+
+void svt_trace_init(void);
+void svt_trace_deinit(void);
+
+uint64_t svt_trace_now(void);
+/* Called by svt_get_full_object() before blocking and after dequeuing an object posted at post_time */
+void svt_trace_wait(void);
+void svt_trace_dequeue(uint64_t post_time);
+/* Starts a span of the calling thread, ending the previous one; segment is -1 for whole pictures */
+void svt_trace_begin(const char *stage, uint64_t picture_number, int32_t segment);
+
+#define SVT_TRACE_BEGIN(stage, picture_number, segment)                  \
+    do {                                                                 \
+        if (svt_trace_enabled)                                           \
+            svt_trace_begin(stage, (uint64_t)(picture_number), segment); \
+    } while (0)
+
+#ifdef __cplusplus
+}
+#endif
+#endif // EbTrace_h
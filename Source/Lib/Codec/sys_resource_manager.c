@@ -15,6 +15,7 @@
 #include "sys_resource_manager.h"
 #include "definitions.h"
 #include "svt_threads.h"
+#include "svt_trace.h"
 #if SRM_REPORT
 #include "svt_log.h"
 #endif
@@ -84,9 +85,134 @@ static EbErrorType svt_fifo_pop_front(EbFifo *fifoPtr, EbObjectWrapper **wrapper
     return return_error;
 }
 
+/**************************************
+ * Lock-free queue
+ **************************************/
+#define LOCK_FREE_SPIN_MIN 16
+#define LOCK_FREE_SPIN_MAX 256
+
+static void svt_lock_free_queue_dctor(EbPtr p) {
+    EbLockFreeQueue *obj = (EbLockFreeQueue *)p;
+    EB_DESTROY_SEMAPHORE(obj->park_semaphore);
+    EB_FREE(obj->cells);
+}
+
+static EbErrorType svt_lock_free_queue_ctor(EbLockFreeQueue *queue_ptr, uint32_t object_total_count) {
+    uint32_t size = 1;
+    while (size < object_total_count) size <<= 1;
+
+    queue_ptr->dctor = svt_lock_free_queue_dctor;
+    queue_ptr->mask  = size - 1;
+    queue_ptr->spin  = LOCK_FREE_SPIN_MIN;
+    EB_MALLOC(queue_ptr->cells, size * sizeof(*queue_ptr->cells));
+    for (uint32_t i = 0; i < size; i++) {
+        queue_ptr->cells[i].seq         = (int32_t)i;
+        queue_ptr->cells[i].wrapper_ptr = NULL;
+    }
+    // parked threads are woken one post each, the count never gets near the maximum
+    EB_CREATE_SEMAPHORE(queue_ptr->park_semaphore, 0, INT32_MAX);
+
+    return EB_ErrorNone;
+}
+
+static INLINE int32_t lock_free_pos_add(int32_t pos, uint32_t n) { return (int32_t)((uint32_t)pos + n); }
+
+static void svt_lock_free_queue_push(EbLockFreeQueue *queue_ptr, EbObjectWrapper *wrapper_ptr) {
+    EbRingCell *cell;
+    int32_t     pos = svt_atomic_load_i32(&queue_ptr->enqueue_pos);
+
+    for (;;) {
+        cell              = &queue_ptr->cells[(uint32_t)pos & queue_ptr->mask];
+        const int32_t dif = (int32_t)((uint32_t)svt_atomic_load_i32(&cell->seq) - (uint32_t)pos);
+        if (dif == 0 && svt_atomic_cas_i32(&queue_ptr->enqueue_pos, pos, lock_free_pos_add(pos, 1)))
+            break;
+        // dif < 0 would mean a full ring, which cannot hold since it fits every object
+        pos = svt_atomic_load_i32(&queue_ptr->enqueue_pos);
+    }
+    cell->wrapper_ptr = wrapper_ptr;
+    svt_atomic_store_i32(&cell->seq, lock_free_pos_add(pos, 1));
+
+    // Publish the object, waking a parked consumer if there is one
+    if (svt_atomic_fetch_add_i32(&queue_ptr->avail_count, 1) < 0)
+        svt_post_semaphore(queue_ptr->park_semaphore);
+}
+
+/* Takes the next object, the caller must have claimed one from avail_count */
+static EbObjectWrapper *svt_lock_free_queue_pop(EbLockFreeQueue *queue_ptr) {
+    int32_t  pos   = svt_atomic_load_i32(&queue_ptr->dequeue_pos);
+    uint32_t spins = 0;
+
+    for (;;) {
+        EbRingCell   *cell = &queue_ptr->cells[(uint32_t)pos & queue_ptr->mask];
+        const int32_t dif  = (int32_t)((uint32_t)svt_atomic_load_i32(&cell->seq) - (uint32_t)lock_free_pos_add(pos, 1));
+        if (dif == 0) {
+            if (svt_atomic_cas_i32(&queue_ptr->dequeue_pos, pos, lock_free_pos_add(pos, 1))) {
+                EbObjectWrapper *wrapper_ptr = cell->wrapper_ptr;
+                svt_atomic_store_i32(&cell->seq, lock_free_pos_add(pos, queue_ptr->mask + 1));
+                return wrapper_ptr;
+            }
+        } else if (dif < 0) {
+            // a push reserved this cell but has not written it yet
+            if (++spins & 1023)
+                svt_cpu_pause();
+            else
+                svt_yield_thread();
+        }
+        pos = svt_atomic_load_i32(&queue_ptr->dequeue_pos);
+    }
+}
+
+/*
+ * Claims one published object. Polls for up to `spin` iterations before parking: the spin grows
+ * when objects tend to arrive late in the window and shrinks every time the consumer has to park.
+ * Threads of a core pool park right away, spinning would keep a core other threads wait for.
+ * Returns FALSE when the queue is shutting down.
+ */
+static Bool svt_lock_free_queue_wait(EbLockFreeQueue *queue_ptr) {
+    const int32_t spin = svt_core_pool_member() ? 0 : svt_atomic_load_i32(&queue_ptr->spin);
+
+    for (int32_t i = 0; i < spin; i++) {
+        const int32_t avail = svt_atomic_load_i32(&queue_ptr->avail_count);
+        if (avail > 0 && svt_atomic_cas_i32(&queue_ptr->avail_count, avail, avail - 1)) {
+            if (i > spin / 2)
+                svt_atomic_store_i32(&queue_ptr->spin, AOMMIN(2 * spin, LOCK_FREE_SPIN_MAX));
+            return !svt_atomic_load_i32(&queue_ptr->quit_signal);
+        }
+        svt_cpu_pause();
+    }
+    if (svt_atomic_fetch_add_i32(&queue_ptr->avail_count, -1) <= 0) {
+        if (spin)
+            svt_atomic_store_i32(&queue_ptr->spin, AOMMAX(spin - spin / 4, LOCK_FREE_SPIN_MIN));
+        svt_block_on_semaphore(queue_ptr->park_semaphore);
+    }
+    return !svt_atomic_load_i32(&queue_ptr->quit_signal);
+}
+
+static Bool svt_lock_free_queue_try_claim(EbLockFreeQueue *queue_ptr) {
+    int32_t avail = svt_atomic_load_i32(&queue_ptr->avail_count);
+    while (avail > 0) {
+        if (svt_atomic_cas_i32(&queue_ptr->avail_count, avail, avail - 1))
+            return TRUE;
+        avail = svt_atomic_load_i32(&queue_ptr->avail_count);
+    }
+    return FALSE;
+}
+
+/* Wakes one consumer with the quit signal set */
+static void svt_lock_free_queue_shutdown(EbLockFreeQueue *queue_ptr) {
+    svt_atomic_store_i32(&queue_ptr->quit_signal, 1);
+    if (svt_atomic_fetch_add_i32(&queue_ptr->avail_count, 1) < 0)
+        svt_post_semaphore(queue_ptr->park_semaphore);
+}
+
 static EbErrorType svt_fifo_shutdown(EbFifo *fifo_ptr) {
     EbErrorType return_error = EB_ErrorNone;
 
+    if (fifo_ptr->queue_ptr->lock_free_queue) {
+        svt_lock_free_queue_shutdown(fifo_ptr->queue_ptr->lock_free_queue);
+        return return_error;
+    }
+
     // Acquire lockout Mutex
     svt_block_on_mutex(fifo_ptr->lockout_mutex);
     fifo_ptr->quit_signal = TRUE;
@@ -188,6 +314,7 @@ void svt_muxing_queue_dctor(EbPtr p) {
     EB_DELETE_PTR_ARRAY(obj->process_fifo_ptr_array, obj->process_total_count);
     EB_DELETE(obj->object_queue);
     EB_DELETE(obj->process_queue);
+    EB_DELETE(obj->lock_free_queue);
     EB_DESTROY_MUTEX(obj->lockout_mutex);
 }
 
@@ -195,7 +322,7 @@ void svt_muxing_queue_dctor(EbPtr p) {
  * svt_muxing_queue_ctor
  **************************************/
 static EbErrorType svt_muxing_queue_ctor(EbMuxingQueue *queue_ptr, uint32_t object_total_count,
-                                         uint32_t process_total_count) {
+                                         uint32_t process_total_count, Bool lock_free) {
     uint32_t    process_index;
     EbErrorType return_error = EB_ErrorNone;
 
@@ -209,6 +336,8 @@ static EbErrorType svt_muxing_queue_ctor(EbMuxingQueue *queue_ptr, uint32_t obje
     EB_NEW(queue_ptr->object_queue, svt_circular_buffer_ctor, object_total_count);
     // Construct Process Circular Buffer
     EB_NEW(queue_ptr->process_queue, svt_circular_buffer_ctor, queue_ptr->process_total_count);
+    if (lock_free)
+        EB_NEW(queue_ptr->lock_free_queue, svt_lock_free_queue_ctor, object_total_count);
     // Construct the Process Fifos
     EB_ALLOC_PTR_ARRAY(queue_ptr->process_fifo_ptr_array, queue_ptr->process_total_count);
 
@@ -434,10 +563,17 @@ static void svt_system_resource_dctor(EbPtr p) {
  *     object_ctor is called.
  *   object_destroyer
  *     object destroyer, will call dctor if this is null
+ *
+ *   lock_free_queues
+ *     hand the full objects to the consumers through a lock-free ring
+ *     instead of the mutex protected muxing queue. Empty objects always
+ *     go through the muxing queue, which reuses the most recently
+ *     released object first.
  *********************************************************************/
 EbErrorType svt_system_resource_ctor(EbSystemResource *resource_ptr, uint32_t object_total_count,
                                      uint32_t producer_process_total_count, uint32_t consumer_process_total_count,
-                                     EbCreator object_creator, EbPtr object_init_data_ptr, EbDctor object_destroyer) {
+                                     EbCreator object_creator, EbPtr object_init_data_ptr, EbDctor object_destroyer,
+                                     Bool lock_free_queues) {
     uint32_t    wrapper_index;
     EbErrorType return_error = EB_ErrorNone;
     resource_ptr->dctor      = svt_system_resource_dctor;
@@ -465,7 +601,8 @@ EbErrorType svt_system_resource_ctor(EbSystemResource *resource_ptr, uint32_t ob
     EB_NEW(resource_ptr->empty_queue,
            svt_muxing_queue_ctor,
            resource_ptr->object_total_count,
-           producer_process_total_count);
+           producer_process_total_count,
+           FALSE);
     // Fill the Empty Fifo with every ObjectWrapper
     for (wrapper_index = 0; wrapper_index < resource_ptr->object_total_count; ++wrapper_index) {
         svt_muxing_queue_object_push_back(resource_ptr->empty_queue, resource_ptr->wrapper_ptr_pool[wrapper_index]);
@@ -480,7 +617,8 @@ EbErrorType svt_system_resource_ctor(EbSystemResource *resource_ptr, uint32_t ob
         EB_NEW(resource_ptr->full_queue,
                svt_muxing_queue_ctor,
                resource_ptr->object_total_count,
-               consumer_process_total_count);
+               consumer_process_total_count,
+               lock_free_queues);
     } else {
         resource_ptr->full_queue = (EbMuxingQueue *)NULL;
     }
@@ -488,6 +626,28 @@ EbErrorType svt_system_resource_ctor(EbSystemResource *resource_ptr, uint32_t ob
     return return_error;
 }
 
+static uint64_t muxing_queue_size(uint32_t object_total_count, uint32_t process_total_count, Bool lock_free) {
+    uint64_t size = sizeof(EbMuxingQueue) + 2 * sizeof(EbCircularBuffer) +
+        (uint64_t)(object_total_count + process_total_count) * sizeof(EbPtr) +
+        (uint64_t)process_total_count * (sizeof(EbFifo *) + sizeof(EbFifo));
+    if (lock_free) {
+        uint64_t cells = 1;
+        while (cells < object_total_count) cells <<= 1;
+        size += sizeof(EbLockFreeQueue) + cells * sizeof(EbRingCell);
+    }
+    return size;
+}
+
+uint64_t svt_system_resource_size(uint32_t object_total_count, uint32_t producer_process_total_count,
+                                  uint32_t consumer_process_total_count, Bool lock_free_queues) {
+    uint64_t size = sizeof(EbSystemResource) +
+        (uint64_t)object_total_count * (sizeof(EbObjectWrapper *) + sizeof(EbObjectWrapper)) +
+        muxing_queue_size(object_total_count, producer_process_total_count, FALSE);
+    if (consumer_process_total_count)
+        size += muxing_queue_size(object_total_count, consumer_process_total_count, lock_free_queues);
+    return size;
+}
+
 EbFifo *svt_system_resource_get_producer_fifo(const EbSystemResource *resource_ptr, uint32_t index) {
     return svt_muxing_queue_get_fifo(resource_ptr->empty_queue, index);
 }
@@ -543,6 +703,14 @@ static EbErrorType svt_release_process(EbFifo *process_fifo_ptr) {
 EbErrorType svt_post_full_object(EbObjectWrapper *object_ptr) {
     EbErrorType return_error = EB_ErrorNone;
 
+    if (svt_trace_enabled)
+        object_ptr->trace_post_time = svt_trace_now();
+
+    if (object_ptr->system_resource_ptr->full_queue->lock_free_queue) {
+        svt_lock_free_queue_push(object_ptr->system_resource_ptr->full_queue->lock_free_queue, object_ptr);
+        return return_error;
+    }
+
     svt_block_on_mutex(object_ptr->system_resource_ptr->full_queue->lockout_mutex);
 
     svt_muxing_queue_object_push_back(object_ptr->system_resource_ptr->full_queue, object_ptr);
@@ -552,6 +720,32 @@ EbErrorType svt_post_full_object(EbObjectWrapper *object_ptr) {
     return return_error;
 }
 
+/*********************************************************************
+ * svt_post_full_object_front
+ *   Queues a full EbObjectWrapper ahead of the full objects already
+ *   waiting, for follow-up work of a task that is in progress. A
+ *   lock-free full queue is FIFO only, the object is posted at its
+ *   back.
+ *
+ *   object_ptr
+ *      pointer to EbObjectWrapper to be posted.
+ *********************************************************************/
+EbErrorType svt_post_full_object_front(EbObjectWrapper *object_ptr) {
+    if (object_ptr->system_resource_ptr->full_queue->lock_free_queue)
+        return svt_post_full_object(object_ptr);
+
+    if (svt_trace_enabled)
+        object_ptr->trace_post_time = svt_trace_now();
+
+    svt_block_on_mutex(object_ptr->system_resource_ptr->full_queue->lockout_mutex);
+
+    svt_muxing_queue_object_push_front(object_ptr->system_resource_ptr->full_queue, object_ptr);
+
+    svt_release_mutex(object_ptr->system_resource_ptr->full_queue->lockout_mutex);
+
+    return EB_ErrorNone;
+}
+
 /*********************************************************************
  * EbSystemResourceReleaseObject
  *   Queues an empty EbObjectWrapper to the SystemResource. This
@@ -562,8 +756,18 @@ EbErrorType svt_post_full_object(EbObjectWrapper *object_ptr) {
  *   object_ptr
  *      pointer to EbObjectWrapper to be released.
  *********************************************************************/
+/* Takes the pending release callback of an object going back to its empty queue */
+static INLINE void take_release_cb(EbObjectWrapper *object_ptr, void (**release_cb)(void *), void **release_ctx) {
+    *release_cb             = object_ptr->release_cb;
+    *release_ctx            = object_ptr->release_ctx;
+    object_ptr->release_cb  = NULL;
+    object_ptr->release_ctx = NULL;
+}
+
 EbErrorType svt_release_object(EbObjectWrapper *object_ptr) {
     EbErrorType return_error = EB_ErrorNone;
+    void (*release_cb)(void *) = NULL;
+    void *release_ctx          = NULL;
 
     svt_block_on_mutex(object_ptr->system_resource_ptr->empty_queue->lockout_mutex);
 
@@ -576,6 +780,7 @@ EbErrorType svt_release_object(EbObjectWrapper *object_ptr) {
     if ((object_ptr->release_enable == TRUE) && (object_ptr->live_count == 0)) {
         // Set live_count to EB_ObjectWrapperReleasedValue
         object_ptr->live_count = EB_ObjectWrapperReleasedValue;
+        take_release_cb(object_ptr, &release_cb, &release_ctx);
 
         svt_muxing_queue_object_push_front(object_ptr->system_resource_ptr->empty_queue, object_ptr);
 #if SRM_REPORT
@@ -591,11 +796,16 @@ EbErrorType svt_release_object(EbObjectWrapper *object_ptr) {
 
     svt_release_mutex(object_ptr->system_resource_ptr->empty_queue->lockout_mutex);
 
+    if (release_cb)
+        release_cb(release_ctx);
+
     return return_error;
 }
 
 EbErrorType svt_release_dual_object(EbObjectWrapper *object_ptr, EbObjectWrapper *sec_object_ptr) {
     EbErrorType return_error = EB_ErrorNone;
+    void (*release_cb)(void *) = NULL;
+    void *release_ctx          = NULL;
 
     svt_block_on_mutex(object_ptr->system_resource_ptr->empty_queue->lockout_mutex);
 
@@ -608,6 +818,7 @@ EbErrorType svt_release_dual_object(EbObjectWrapper *object_ptr, EbObjectWrapper
 
         // Set live_count to EB_ObjectWrapperReleasedValue
         object_ptr->live_count = EB_ObjectWrapperReleasedValue;
+        take_release_cb(object_ptr, &release_cb, &release_ctx);
 
         svt_muxing_queue_object_push_front(object_ptr->system_resource_ptr->empty_queue, object_ptr);
 
@@ -626,6 +837,9 @@ EbErrorType svt_release_dual_object(EbObjectWrapper *object_ptr, EbObjectWrapper
 
     svt_release_mutex(object_ptr->system_resource_ptr->empty_queue->lockout_mutex);
 
+    if (release_cb)
+        release_cb(release_ctx);
+
     return return_error;
 }
 #if SRM_REPORT
@@ -716,24 +930,41 @@ EbErrorType svt_get_empty_object(EbFifo *empty_fifo_ptr, EbObjectWrapper **wrapp
 EbErrorType svt_get_full_object(EbFifo *full_fifo_ptr, EbObjectWrapper **wrapper_dbl_ptr) {
     EbErrorType return_error = EB_ErrorNone;
 
-    // Queue the Fifo requesting the full fifo
-    svt_release_process(full_fifo_ptr);
+    // the previous span of a traced kernel ends here
+    if (svt_trace_enabled)
+        svt_trace_wait();
+
+    EbLockFreeQueue *lock_free_queue = full_fifo_ptr->queue_ptr->lock_free_queue;
+    if (lock_free_queue) {
+        if (svt_lock_free_queue_wait(lock_free_queue)) {
+            *wrapper_dbl_ptr = svt_lock_free_queue_pop(lock_free_queue);
+        } else {
+            *wrapper_dbl_ptr = NULL;
+            return_error     = EB_NoErrorFifoShutdown;
+        }
+    } else {
+        // Queue the Fifo requesting the full fifo
+        svt_release_process(full_fifo_ptr);
 
-    // Block on the counting Semaphore until an empty buffer is available
-    svt_block_on_semaphore(full_fifo_ptr->counting_semaphore);
+        // Block on the counting Semaphore until an empty buffer is available
+        svt_block_on_semaphore(full_fifo_ptr->counting_semaphore);
 
-    // Acquire lockout Mutex
-    svt_block_on_mutex(full_fifo_ptr->lockout_mutex);
+        // Acquire lockout Mutex
+        svt_block_on_mutex(full_fifo_ptr->lockout_mutex);
 
-    if (!full_fifo_ptr->quit_signal) {
-        svt_fifo_pop_front(full_fifo_ptr, wrapper_dbl_ptr);
-    } else {
-        *wrapper_dbl_ptr = NULL;
-        return_error     = EB_NoErrorFifoShutdown;
+        if (!full_fifo_ptr->quit_signal) {
+            svt_fifo_pop_front(full_fifo_ptr, wrapper_dbl_ptr);
+        } else {
+            *wrapper_dbl_ptr = NULL;
+            return_error     = EB_NoErrorFifoShutdown;
+        }
+
+        // Release Mutex
+        svt_release_mutex(full_fifo_ptr->lockout_mutex);
     }
 
-    // Release Mutex
-    svt_release_mutex(full_fifo_ptr->lockout_mutex);
+    if (svt_trace_enabled && *wrapper_dbl_ptr)
+        svt_trace_dequeue((*wrapper_dbl_ptr)->trace_post_time);
 
     return return_error;
 }
@@ -752,6 +983,16 @@ static Bool svt_fifo_peak_front(EbFifo *fifoPtr) {
 EbErrorType svt_get_full_object_non_blocking(EbFifo *full_fifo_ptr, EbObjectWrapper **wrapper_dbl_ptr) {
     EbErrorType return_error = EB_ErrorNone;
     Bool        fifo_empty;
+
+    EbLockFreeQueue *lock_free_queue = full_fifo_ptr->queue_ptr->lock_free_queue;
+    if (lock_free_queue) {
+        if (!svt_atomic_load_i32(&lock_free_queue->quit_signal) && svt_lock_free_queue_try_claim(lock_free_queue))
+            *wrapper_dbl_ptr = svt_lock_free_queue_pop(lock_free_queue);
+        else
+            *wrapper_dbl_ptr = (EbObjectWrapper *)NULL;
+        return return_error;
+    }
+
     // Queue the Fifo requesting the full fifo
     svt_release_process(full_fifo_ptr);
 
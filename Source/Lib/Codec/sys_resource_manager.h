@@ -52,6 +52,15 @@ typedef struct EbObjectWrapper {
     // next_ptr - a pointer to a different EbObjectWrapper.  Used
     //   only in the implemenation of a single-linked Fifo.
     struct EbObjectWrapper *next_ptr;
+
+    // release_cb - optional, called once (outside of the SystemResource
+    //   lock) when the object goes back to its empty queue, then cleared.
+    void (*release_cb)(void *release_ctx);
+    void *release_ctx;
+
+    // trace_post_time - when the object was last posted to its full
+    //   queue, only set while the pipeline trace is enabled.
+    uint64_t trace_post_time;
 #if SRM_REPORT
     uint64_t pic_number;
 #endif
@@ -102,6 +111,39 @@ typedef struct EbCircularBuffer {
     uint32_t current_count;
 } EbCircularBuffer;
 
+/*********************************************************************
+     * LockFreeQueue
+     *   Bounded multi-producer multi-consumer ring of EbObjectWrapper
+     *   pointers (D. Vyukov's algorithm), sized to hold every object of
+     *   the SystemResource so a push never finds it full. Consumers
+     *   poll avail_count for an adaptive number of iterations and only
+     *   park on park_semaphore when no object shows up in that time.
+     *********************************************************************/
+#define EB_CACHE_LINE_SIZE 64
+typedef struct EbRingCell {
+    int32_t          seq;
+    EbObjectWrapper *wrapper_ptr;
+} EbRingCell;
+
+typedef struct EbLockFreeQueue {
+    EbDctor     dctor;
+    EbRingCell *cells;
+    uint32_t    mask;
+    EbHandle    park_semaphore;
+    // spin - polling iterations before a consumer parks, adapted at run time
+    int32_t spin;
+    int32_t quit_signal;
+    // the positions and the count are written by different threads, keep them on separate lines
+    uint8_t pad0[EB_CACHE_LINE_SIZE];
+    int32_t enqueue_pos;
+    uint8_t pad1[EB_CACHE_LINE_SIZE];
+    int32_t dequeue_pos;
+    uint8_t pad2[EB_CACHE_LINE_SIZE];
+    // avail_count - published objects not yet claimed, minus the parked consumers
+    int32_t avail_count;
+    uint8_t pad3[EB_CACHE_LINE_SIZE];
+} EbLockFreeQueue;
+
 /*********************************************************************
      * MuxingQueue
      *********************************************************************/
@@ -112,6 +154,8 @@ typedef struct EbMuxingQueue {
     EbCircularBuffer *process_queue;
     uint32_t          process_total_count;
     EbFifo          **process_fifo_ptr_array;
+    // lock_free_queue - replaces the buffers above when set, full queues only
+    EbLockFreeQueue *lock_free_queue;
 #if SRM_REPORT
     uint32_t curr_count; //run time fullness
     uint8_t  log; //if set monitor out the queue size
@@ -216,11 +260,24 @@ extern EbErrorType svt_object_inc_live_count(EbObjectWrapper *wrapper_ptr, uint3
      *     pointer to data block to be used during the construction of
      *     the object. object_init_data_ptr is passed to object_ctor when
      *     object_ctor is called.
+     *
+     *   lock_free_queues
+     *     pass the full objects through a lock-free ring with
+     *     spin-then-park waits instead of the muxing queue
      *********************************************************************/
 extern EbErrorType svt_system_resource_ctor(EbSystemResource *resource_ptr, uint32_t object_total_count,
                                             uint32_t producer_process_total_count,
                                             uint32_t consumer_process_total_count, EbCreator object_ctor,
-                                            EbPtr object_init_data_ptr, EbDctor object_destroyer);
+                                            EbPtr object_init_data_ptr, EbDctor object_destroyer,
+                                            Bool lock_free_queues);
+
+/*********************************************************************
+     * svt_system_resource_size
+     *   Bytes svt_system_resource_ctor() allocates for the resource itself,
+     *   its wrappers and its queues, without the managed objects.
+     */
+extern uint64_t svt_system_resource_size(uint32_t object_total_count, uint32_t producer_process_total_count,
+                                         uint32_t consumer_process_total_count, Bool lock_free_queues);
 
 /*********************************************************************
      * svt_system_resource_get_producer_fifo
@@ -285,6 +342,18 @@ EbErrorType dump_srm_content(EbSystemResource *resource_ptr, uint8_t log);
      *********************************************************************/
 extern EbErrorType svt_post_full_object(EbObjectWrapper *object_ptr);
 
+/*********************************************************************
+     * svt_post_full_object_front
+     *   Queues a full EbObjectWrapper ahead of the full objects already
+     *   waiting, for follow-up work of a task that is in progress. A
+     *   lock-free full queue is FIFO only, the object is posted at its
+     *   back.
+     *
+     *   object_ptr
+     *      pointer to EbObjectWrapper to be posted.
+     *********************************************************************/
+extern EbErrorType svt_post_full_object_front(EbObjectWrapper *object_ptr);
+
 /*********************************************************************
      * EbSystemResourceGetFullObject
      *   Dequeues an full EbObjectWrapper from the SystemResource. This
@@ -448,8 +448,8 @@ static void md_scan_all_blks(uint32_t* idx_mds, uint32_t sq_size, uint32_t x, ui
             svt_aom_blk_geom_mds[*idx_mds].bwidth  = quartsize * ns_quarter_size_mult[part_it_idx][0][nsq_it];
             svt_aom_blk_geom_mds[*idx_mds].bheight = quartsize * ns_quarter_size_mult[part_it_idx][1][nsq_it];
             svt_aom_blk_geom_mds[*idx_mds].bsize =
-                hvsize_to_bsize[svt_log2f(svt_aom_blk_geom_mds[*idx_mds].bwidth) - 2]
-                               [svt_log2f(svt_aom_blk_geom_mds[*idx_mds].bheight) - 2];
+                hvsize_to_bsize[svt_aom_log2f_32(svt_aom_blk_geom_mds[*idx_mds].bwidth) - 2]
+                               [svt_aom_log2f_32(svt_aom_blk_geom_mds[*idx_mds].bheight) - 2];
             svt_aom_blk_geom_mds[*idx_mds].bwidth_uv  = MAX(4, svt_aom_blk_geom_mds[*idx_mds].bwidth >> 1);
             svt_aom_blk_geom_mds[*idx_mds].bheight_uv = MAX(4, svt_aom_blk_geom_mds[*idx_mds].bheight >> 1);
             svt_aom_blk_geom_mds[*idx_mds].has_uv     = 1;
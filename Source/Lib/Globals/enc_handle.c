@@ -64,6 +64,8 @@
 #include <immintrin.h>
 #endif
 #include "svt_log.h"
+#include "svt_trace.h"
+#include "memory_estimate.h"
 
 #ifdef _WIN32
 #include <windows.h>
@@ -731,8 +733,22 @@ void set_segments_numbers(SequenceControlSet    *scs) {
     scs->tf_segment_row_count = me_seg_h;
 }
 #endif
+// most bands a stage splitting its work in segments runs at once outside of the core pool
+#define SEGMENT_THREADS_MAX 8
+/* Segment workers of a stage using at most max_segment_count bands, the stage thread runs one of them */
+static uint32_t segment_worker_count(uint32_t segment_threads, uint32_t max_segment_count) {
+    return MIN(segment_threads, MAX(max_segment_count, 1)) - 1;
+}
+/* Raises a stage thread count to the core count, within what the stage can use, returns the added threads */
+static uint32_t core_pool_widen(uint32_t *process_count, uint32_t core_count, uint32_t max_process_count) {
+    const uint32_t widened = MAX(*process_count, MIN(core_count, max_process_count));
+    const uint32_t added = widened - *process_count;
+    *process_count = widened;
+    return added;
+}
 static EbErrorType load_default_buffer_configuration_settings(
-    SequenceControlSet       *scs) {
+    SequenceControlSet       *scs,
+    Bool                      verbose) {
     EbErrorType           return_error = EB_ErrorNone;
 #if CLN_LP_LVLS
     uint32_t core_count = get_num_processors();
@@ -742,7 +758,7 @@ static EbErrorType load_default_buffer_configuration_settings(
 #endif
     uint32_t me_seg_h, me_seg_w;
 #if defined(_WIN32) || defined(__linux__)
-    if (scs->static_config.target_socket != -1)
+    if (scs->static_config.target_socket != -1 && num_groups)
         core_count /= num_groups;
 #endif
 #if CLN_LP_LVLS
@@ -1035,16 +1051,22 @@ static EbErrorType load_default_buffer_configuration_settings(
     //#====================== Processes number ======================
     scs->total_process_init_count                    = 0;
 
-    uint32_t max_pa_proc, max_me_proc, max_tpl_proc, max_mdc_proc, max_md_proc, max_ec_proc, max_dlf_proc, max_cdef_proc, max_rest_proc;
+    uint32_t max_pa_proc, max_me_proc, max_tpl_proc, max_rc_sb_proc, max_mdc_proc, max_md_proc, max_ec_proc, max_dlf_proc, max_cdef_proc, max_cdef_search_proc, max_denoise_proc, max_rest_proc;
 
     max_pa_proc = max_input;
     max_me_proc = max_me * me_seg_w * me_seg_h;
     max_tpl_proc = get_max_wavefronts(scs->max_input_luma_width, scs->max_input_luma_height, 64);
+    max_rc_sb_proc = MIN(RC_SB_MAX_SEGMENTS, (scs->max_input_luma_height + scs->super_block_size - 1) / scs->super_block_size);
     max_mdc_proc = scs->picture_control_set_pool_init_count_child;
     max_md_proc = scs->picture_control_set_pool_init_count_child * get_max_wavefronts(scs->max_input_luma_width, scs->max_input_luma_height, scs->super_block_size);
     max_ec_proc = scs->picture_control_set_pool_init_count_child;
     max_dlf_proc = scs->picture_control_set_pool_init_count_child;
     max_cdef_proc = scs->picture_control_set_pool_init_count_child * scs->cdef_segment_column_count * scs->cdef_segment_row_count;
+    max_cdef_search_proc = MIN(CDEF_SEARCH_MAX_SEGMENTS, (scs->max_input_luma_height + 63) / 64);
+    // the denoise workers only serve the film grain estimation
+    max_denoise_proc = scs->static_config.film_grain_denoise_strength && !scs->static_config.fgs_table
+        ? MIN(DENOISE_MAX_SEGMENTS, (scs->max_input_luma_height + 63) / 64)
+        : 1;
     max_rest_proc = scs->picture_control_set_pool_init_count_child * scs->rest_segment_column_count * scs->rest_segment_row_count;
 
 #if CLN_LP_LVLS
@@ -1177,10 +1199,39 @@ static EbErrorType load_default_buffer_configuration_settings(
     }
 #endif
 
+    if (scs->static_config.core_pool) {
+        // the pool bounds the running threads, let every parallel stage use all the cores
+        scs->core_pool_size = core_count;
+        scs->total_process_init_count += core_pool_widen(&scs->picture_analysis_process_init_count, core_count, max_pa_proc);
+        scs->total_process_init_count += core_pool_widen(&scs->motion_estimation_process_init_count, core_count, max_me_proc);
+        scs->total_process_init_count += core_pool_widen(&scs->tpl_disp_process_init_count, core_count, max_tpl_proc);
+        scs->total_process_init_count += core_pool_widen(&scs->mode_decision_configuration_process_init_count, core_count, max_mdc_proc);
+        scs->total_process_init_count += core_pool_widen(&scs->enc_dec_process_init_count, core_count, max_md_proc);
+        scs->total_process_init_count += core_pool_widen(&scs->entropy_coding_process_init_count, core_count, max_ec_proc);
+        scs->total_process_init_count += core_pool_widen(&scs->dlf_process_init_count, core_count, max_dlf_proc);
+        scs->total_process_init_count += core_pool_widen(&scs->cdef_process_init_count, core_count, max_cdef_proc);
+        scs->total_process_init_count += core_pool_widen(&scs->rest_process_init_count, core_count, max_rest_proc);
+    }
+
+    // The stages splitting their work in bands run the first band on their own thread and the others on
+    // segment workers, so a stage that cannot use a second band gets none
+#if CLN_LP_LVLS
+    const uint32_t segment_threads = lp <= PARALLEL_LEVEL_1 ? 1
+        : scs->static_config.core_pool                      ? core_count
+                                                            : MIN(core_count, SEGMENT_THREADS_MAX);
+#else
+    const uint32_t segment_threads = scs->static_config.core_pool ? core_count : MIN(core_count, SEGMENT_THREADS_MAX);
+#endif
+    scs->total_process_init_count += (scs->rate_control_sb_process_init_count = segment_worker_count(segment_threads, max_rc_sb_proc));
+    scs->total_process_init_count += (scs->cdef_search_process_init_count = segment_worker_count(segment_threads, max_cdef_search_proc));
+    scs->total_process_init_count += (scs->denoise_process_init_count = segment_worker_count(segment_threads, max_denoise_proc));
+
     scs->total_process_init_count += 6; // single processes count
 #if CLN_LP_LVLS
-    if (scs->static_config.pass == 0 || scs->static_config.pass == 2) {
+    if (verbose && (scs->static_config.pass == 0 || scs->static_config.pass == 2)) {
         SVT_INFO("Level of Parallelism: %u\n", lp);
+        if (scs->static_config.core_pool)
+            SVT_INFO("Shared core pool: %u cores\n", scs->core_pool_size);
 #else
     if (scs->static_config.pass == 0 || scs->static_config.pass == 3) {
         SVT_INFO("Number of logical cores available: %u\n", core_count);
@@ -1203,6 +1254,481 @@ static EbErrorType load_default_buffer_configuration_settings(
 #endif
     }
     return return_error;
+}
+/* Init data of the parent picture control sets and of their motion estimation results */
+static void ppcs_init_data(SequenceControlSet *scs, PictureControlSetInitData *input_data) {
+    memset(input_data, 0, sizeof(*input_data));
+    // The segment Width & Height Arrays are in units of SBs, not samples
+    input_data->picture_width = scs->max_input_luma_width;
+    input_data->picture_height = scs->max_input_luma_height;
+    input_data->left_padding = scs->left_padding;
+    input_data->right_padding = scs->right_padding;
+    input_data->top_padding = scs->top_padding;
+    input_data->bot_padding = scs->bot_padding;
+    input_data->color_format = scs->static_config.encoder_color_format;
+    input_data->b64_size = scs->b64_size;
+    input_data->ten_bit_format = scs->ten_bit_format;
+    input_data->enc_mode = scs->static_config.enc_mode;
+    input_data->speed_control = (uint8_t)scs->speed_control_flag;
+    input_data->hbd_md = scs->enable_hbd_mode_decision;
+    input_data->bit_depth = scs->static_config.encoder_bit_depth;
+    input_data->log2_tile_rows = scs->static_config.tile_rows;
+    input_data->log2_tile_cols = scs->static_config.tile_columns;
+    input_data->log2_sb_size = (scs->super_block_size == 128) ? 5 : 4;
+    input_data->is_16bit_pipeline = scs->is_16bit_pipeline;
+    input_data->non_m8_pad_w = scs->max_input_pad_right;
+    input_data->non_m8_pad_h = scs->max_input_pad_bottom;
+    input_data->enable_tpl_la = scs->tpl;
+    input_data->in_loop_ois = scs->in_loop_ois;
+    input_data->enc_dec_segment_col = (uint16_t)scs->tpl_segment_col_count_array;
+    input_data->enc_dec_segment_row = (uint16_t)scs->tpl_segment_row_count_array;
+    input_data->final_pass_preset = scs->final_pass_preset;
+    input_data->rate_control_mode = scs->static_config.rate_control_mode;
+    const MrpCtrls* mrp_ctrl = &(scs->mrp_ctrls);
+    input_data->ref_count_used_list0 =
+        MAX(mrp_ctrl->sc_base_ref_list0_count,
+            MAX(mrp_ctrl->base_ref_list0_count,
+                MAX(mrp_ctrl->sc_non_base_ref_list0_count, mrp_ctrl->non_base_ref_list0_count)));
+
+    input_data->ref_count_used_list1 =
+        MAX(mrp_ctrl->sc_base_ref_list1_count,
+            MAX(mrp_ctrl->base_ref_list1_count,
+                MAX(mrp_ctrl->sc_non_base_ref_list1_count, mrp_ctrl->non_base_ref_list1_count)));
+    input_data->tpl_synth_size = svt_aom_set_tpl_group(NULL,
+        svt_aom_get_tpl_group_level(
+            1,
+            scs->static_config.enc_mode,
+            scs->static_config.rate_control_mode),
+        input_data->picture_width, input_data->picture_height);
+    input_data->enable_adaptive_quantization = scs->static_config.enable_adaptive_quantization;
+    input_data->calculate_variance = scs->calculate_variance;
+    input_data->calc_hist = scs->calc_hist =
+        scs->static_config.scene_change_detection ||
+        scs->vq_ctrls.sharpness_ctrls.scene_transition ||
+        scs->tf_params_per_type[0].enabled ||
+        scs->tf_params_per_type[1].enabled ||
+        scs->tf_params_per_type[2].enabled;
+    input_data->tpl_lad_mg = scs->tpl_lad_mg;
+    input_data->input_resolution = scs->input_resolution;
+    input_data->is_scale = scs->static_config.superres_mode > SUPERRES_NONE ||
+                          scs->static_config.resize_mode > RESIZE_NONE;
+    input_data->rtc_tune = (scs->static_config.pred_structure == SVT_AV1_PRED_LOW_DELAY_B) ? true : false;
+    input_data->enable_variance_boost = scs->static_config.enable_variance_boost;
+    input_data->variance_boost_strength = scs->static_config.variance_boost_strength;
+    input_data->variance_octile = scs->static_config.variance_octile;
+    input_data->sharpness = scs->static_config.sharpness;
+    input_data->qp_scale_compress_strength = scs->static_config.qp_scale_compress_strength;
+    input_data->frame_luma_bias = scs->static_config.frame_luma_bias;
+    input_data->max_32_tx_size = scs->static_config.max_32_tx_size;
+    input_data->adaptive_film_grain = scs->static_config.adaptive_film_grain;
+    input_data->tf_strength = scs->static_config.tf_strength;
+    input_data->kf_tf_strength = scs->static_config.kf_tf_strength;
+    input_data->noise_norm_strength = scs->static_config.noise_norm_strength;
+    input_data->psy_rd = scs->static_config.psy_rd;
+    input_data->static_config = scs->static_config;
+}
+
+/* Init data of the child picture control sets, which share the tiles of parent_pcs */
+static void pcs_init_data(const SequenceControlSet *scs, const PictureParentControlSet *parent_pcs,
+                          PictureControlSetInitData *input_data) {
+    unsigned i;
+
+    memset(input_data, 0, sizeof(*input_data));
+    // The segment Width & Height Arrays are in units of SBs, not samples
+    input_data->enc_dec_segment_col = 0;
+    input_data->enc_dec_segment_row = 0;
+    for (i = 0; i <= scs->static_config.hierarchical_levels; ++i) {
+        input_data->enc_dec_segment_col = scs->enc_dec_segment_col_count_array[i] > input_data->enc_dec_segment_col ?
+            (uint16_t)scs->enc_dec_segment_col_count_array[i] :
+            input_data->enc_dec_segment_col;
+        input_data->enc_dec_segment_row = scs->enc_dec_segment_row_count_array[i] > input_data->enc_dec_segment_row ?
+            (uint16_t)scs->enc_dec_segment_row_count_array[i] :
+            input_data->enc_dec_segment_row;
+    }
+
+    input_data->init_max_block_cnt = scs->max_block_cnt;
+    input_data->picture_width = scs->max_input_luma_width;
+    input_data->picture_height = scs->max_input_luma_height;
+    input_data->left_padding = scs->left_padding;
+    input_data->right_padding = scs->right_padding;
+    input_data->top_padding = scs->top_padding;
+    input_data->bot_padding = scs->bot_padding;
+    input_data->bit_depth = scs->encoder_bit_depth;
+    input_data->color_format = scs->static_config.encoder_color_format;
+    input_data->b64_size = scs->b64_size;
+    input_data->sb_size = scs->super_block_size;
+    input_data->hbd_md = scs->enable_hbd_mode_decision;
+    input_data->cdf_mode = scs->cdf_mode;
+    input_data->mfmv = scs->mfmv_enabled;
+    input_data->cfg_palette = scs->static_config.screen_content_mode;
+    //Jing: Get tile info from parent_pcs
+    input_data->tile_row_count = parent_pcs->av1_cm->tiles_info.tile_rows;
+    input_data->tile_column_count = parent_pcs->av1_cm->tiles_info.tile_cols;
+    input_data->is_16bit_pipeline = scs->is_16bit_pipeline;
+    input_data->av1_cm = parent_pcs->av1_cm;
+    input_data->enc_mode = scs->static_config.enc_mode;
+    input_data->static_config = scs->static_config;
+
+    input_data->input_resolution = scs->input_resolution;
+    input_data->is_scale = scs->static_config.superres_mode > SUPERRES_NONE ||
+                          scs->static_config.resize_mode > RESIZE_NONE;
+}
+
+/* Init data of the PA reference pictures */
+static void pa_ref_init_data(const SequenceControlSet *scs, EbPaReferenceObjectDescInitData *init_data) {
+    EbPictureBufferDescInitData ref_pic_buf_desc_init_data;
+    EbPictureBufferDescInitData quart_pic_buf_desc_init_data;
+    EbPictureBufferDescInitData sixteenth_pic_buf_desc_init_data;
+    memset(&ref_pic_buf_desc_init_data, 0, sizeof(ref_pic_buf_desc_init_data));
+    memset(&quart_pic_buf_desc_init_data, 0, sizeof(quart_pic_buf_desc_init_data));
+    memset(&sixteenth_pic_buf_desc_init_data, 0, sizeof(sixteenth_pic_buf_desc_init_data));
+    // PA Reference Picture Buffers
+    // Currently, only Luma samples are needed in the PA
+    ref_pic_buf_desc_init_data.max_width = scs->max_input_luma_width;
+    ref_pic_buf_desc_init_data.max_height = scs->max_input_luma_height;
+    ref_pic_buf_desc_init_data.bit_depth = EB_EIGHT_BIT;
+    ref_pic_buf_desc_init_data.color_format = EB_YUV420; //use 420 for picture analysis
+    //No full-resolution pixel data is allocated for PA REF,
+    // it points directly to the Luma input samples of the app data
+    ref_pic_buf_desc_init_data.buffer_enable_mask = 0;
+
+
+    ref_pic_buf_desc_init_data.left_padding = scs->left_padding;
+    ref_pic_buf_desc_init_data.right_padding = scs->right_padding;
+    ref_pic_buf_desc_init_data.top_padding = scs->top_padding;
+    ref_pic_buf_desc_init_data.bot_padding = scs->bot_padding;
+    ref_pic_buf_desc_init_data.split_mode = FALSE;
+    ref_pic_buf_desc_init_data.rest_units_per_tile = scs->rest_units_per_tile;
+    ref_pic_buf_desc_init_data.mfmv                = 0;
+    ref_pic_buf_desc_init_data.is_16bit_pipeline   = FALSE;
+    ref_pic_buf_desc_init_data.enc_mode            = scs->static_config.enc_mode;
+    ref_pic_buf_desc_init_data.sb_total_count      = scs->sb_total_count;
+
+    quart_pic_buf_desc_init_data.max_width = scs->max_input_luma_width >> 1;
+    quart_pic_buf_desc_init_data.max_height = scs->max_input_luma_height >> 1;
+    quart_pic_buf_desc_init_data.bit_depth = EB_EIGHT_BIT;
+    quart_pic_buf_desc_init_data.color_format = EB_YUV420;
+    quart_pic_buf_desc_init_data.buffer_enable_mask = PICTURE_BUFFER_DESC_LUMA_MASK;
+    quart_pic_buf_desc_init_data.left_padding = scs->b64_size >> 1;
+    quart_pic_buf_desc_init_data.right_padding = scs->b64_size >> 1;
+    quart_pic_buf_desc_init_data.top_padding = scs->b64_size >> 1;
+    quart_pic_buf_desc_init_data.bot_padding = scs->b64_size >> 1;
+    quart_pic_buf_desc_init_data.split_mode = FALSE;
+    quart_pic_buf_desc_init_data.rest_units_per_tile = scs->rest_units_per_tile;
+    quart_pic_buf_desc_init_data.mfmv                = 0;
+    quart_pic_buf_desc_init_data.is_16bit_pipeline   = FALSE;
+    quart_pic_buf_desc_init_data.enc_mode            = scs->static_config.enc_mode;
+    quart_pic_buf_desc_init_data.sb_total_count      = scs->sb_total_count;
+
+    sixteenth_pic_buf_desc_init_data.max_width = scs->max_input_luma_width >> 2;
+    sixteenth_pic_buf_desc_init_data.max_height = scs->max_input_luma_height >> 2;
+    sixteenth_pic_buf_desc_init_data.bit_depth = EB_EIGHT_BIT;
+    sixteenth_pic_buf_desc_init_data.color_format = EB_YUV420;
+    sixteenth_pic_buf_desc_init_data.buffer_enable_mask = PICTURE_BUFFER_DESC_LUMA_MASK;
+    sixteenth_pic_buf_desc_init_data.left_padding = scs->b64_size >> 2;
+    sixteenth_pic_buf_desc_init_data.right_padding = scs->b64_size >> 2;
+    sixteenth_pic_buf_desc_init_data.top_padding = scs->b64_size >> 2;
+    sixteenth_pic_buf_desc_init_data.bot_padding = scs->b64_size >> 2;
+    sixteenth_pic_buf_desc_init_data.split_mode = FALSE;
+    sixteenth_pic_buf_desc_init_data.rest_units_per_tile = scs->rest_units_per_tile;
+    sixteenth_pic_buf_desc_init_data.mfmv                = 0;
+    sixteenth_pic_buf_desc_init_data.is_16bit_pipeline   = FALSE;
+    sixteenth_pic_buf_desc_init_data.enc_mode            = scs->static_config.enc_mode;
+    sixteenth_pic_buf_desc_init_data.sb_total_count      = scs->sb_total_count;
+
+    init_data->reference_picture_desc_init_data = ref_pic_buf_desc_init_data;
+    init_data->quarter_picture_desc_init_data = quart_pic_buf_desc_init_data;
+    init_data->sixteenth_picture_desc_init_data = sixteenth_pic_buf_desc_init_data;
+}
+
+/* Init data of the TPL reference pictures */
+static void tpl_ref_init_data(const SequenceControlSet *scs, EbTplReferenceObjectDescInitData *init_data) {
+    EbPictureBufferDescInitData ref_pic_buf_desc_init_data;
+    memset(&ref_pic_buf_desc_init_data, 0, sizeof(ref_pic_buf_desc_init_data));
+    // PA Reference Picture Buffers
+    // Currently, only Luma samples are needed in the PA
+    ref_pic_buf_desc_init_data.max_width = scs->max_input_luma_width;
+    ref_pic_buf_desc_init_data.max_height = scs->max_input_luma_height;
+    ref_pic_buf_desc_init_data.bit_depth = EB_EIGHT_BIT;
+    ref_pic_buf_desc_init_data.color_format = EB_YUV420; //use 420 for picture analysis
+
+    // Allocate one ref pic to be used in TPL
+    ref_pic_buf_desc_init_data.buffer_enable_mask = PICTURE_BUFFER_DESC_Y_FLAG;
+
+    ref_pic_buf_desc_init_data.left_padding = TPL_PADX;// scs->left_padding;
+    ref_pic_buf_desc_init_data.right_padding = TPL_PADX;// scs->right_padding;
+    ref_pic_buf_desc_init_data.top_padding = TPL_PADY;// scs->top_padding;
+    ref_pic_buf_desc_init_data.bot_padding = TPL_PADY;// scs->bot_padding;
+    ref_pic_buf_desc_init_data.split_mode = FALSE;
+    ref_pic_buf_desc_init_data.mfmv = 0;
+    ref_pic_buf_desc_init_data.is_16bit_pipeline = FALSE;
+    ref_pic_buf_desc_init_data.enc_mode = scs->static_config.enc_mode;
+
+    ref_pic_buf_desc_init_data.rest_units_per_tile = 0;// rest not needed in tpl scs->rest_units_per_tile;
+    ref_pic_buf_desc_init_data.sb_total_count = scs->sb_total_count;
+
+    init_data->reference_picture_desc_init_data = ref_pic_buf_desc_init_data;
+}
+
+/* Init data of the reference pictures, after scs->rest_units_per_tile and scs->b64_total_count are
+ * set from a child picture control set */
+static void ref_init_data(SequenceControlSet *scs, EbReferenceObjectDescInitData *init_data) {
+    EbPictureBufferDescInitData ref_pic_buf_desc_init_data;
+    memset(&ref_pic_buf_desc_init_data, 0, sizeof(ref_pic_buf_desc_init_data));
+    Bool is_16bit = (Bool)(scs->static_config.encoder_bit_depth > EB_EIGHT_BIT);
+    // Initialize the various Picture types
+    ref_pic_buf_desc_init_data.max_width = scs->max_input_luma_width;
+    ref_pic_buf_desc_init_data.max_height = scs->max_input_luma_height;
+    ref_pic_buf_desc_init_data.bit_depth = scs->encoder_bit_depth;
+    ref_pic_buf_desc_init_data.color_format = scs->static_config.encoder_color_format;
+    ref_pic_buf_desc_init_data.buffer_enable_mask = PICTURE_BUFFER_DESC_FULL_MASK;
+    ref_pic_buf_desc_init_data.rest_units_per_tile = scs->rest_units_per_tile;
+    ref_pic_buf_desc_init_data.sb_total_count = scs->b64_total_count;
+    uint16_t padding = scs->super_block_size + 32;
+    if (scs->static_config.superres_mode > SUPERRES_NONE ||
+        scs->static_config.resize_mode > RESIZE_NONE) {
+        padding += scs->super_block_size;
+    }
+
+    ref_pic_buf_desc_init_data.left_padding = padding;
+    ref_pic_buf_desc_init_data.right_padding = padding;
+    ref_pic_buf_desc_init_data.top_padding = padding;
+    ref_pic_buf_desc_init_data.bot_padding = padding;
+    ref_pic_buf_desc_init_data.mfmv = scs->mfmv_enabled;
+    ref_pic_buf_desc_init_data.is_16bit_pipeline = scs->is_16bit_pipeline;
+    // Hsan: split_mode is set @ eb_reference_object_ctor() as both unpacked reference and packed reference are needed for a 10BIT input; unpacked reference @ MD, and packed reference @ EP
+
+    ref_pic_buf_desc_init_data.split_mode = FALSE;
+    ref_pic_buf_desc_init_data.enc_mode = scs->static_config.enc_mode;
+    if (is_16bit)
+        ref_pic_buf_desc_init_data.bit_depth = EB_TEN_BIT;
+
+    init_data->reference_picture_desc_init_data = ref_pic_buf_desc_init_data;
+    init_data->hbd_md =
+        scs->enable_hbd_mode_decision;
+    init_data->static_config = &scs->static_config;
+}
+
+/*
+ * Fills model for scs. The pool objects whose init data is built here are measured by building one
+ * of each with the creator of their pool, under the category svt_av1_enc_init() accounts it to, and
+ * so is the prediction structure group.
+ */
+static EbErrorType memory_model_init(SequenceControlSet *scs, EbMemoryModel *model) {
+    PictureControlSetInitData input_data;
+    PictureParentControlSet  *ppcs = NULL;
+    MotionEstimationData     *me = NULL;
+    PictureControlSet        *pcs = NULL;
+    EncDecSet                *enc_dec_set = NULL;
+    EbReferenceObject        *reference = NULL;
+    EbTplReferenceObject     *tpl_reference = NULL;
+    EbPaReferenceObject      *pa_reference = NULL;
+    SequenceControlSet       *pool_scs = NULL;
+    PredictionStructureGroup *prediction_structure_group = NULL;
+    EbMemoryAccount           account;
+    // sets scs->calc_hist, which sizes the picture decision context
+    ppcs_init_data(scs, &input_data);
+    EbErrorType return_error = svt_aom_memory_model_init(scs, model);
+    if (return_error != EB_ErrorNone)
+        return return_error;
+
+    memset(&account, 0, sizeof(account));
+    svt_memory_account_bind(&account, SVT_AV1_MEM_PICTURES);
+    return_error = svt_aom_picture_parent_control_set_creator((EbPtr *)&ppcs, &input_data);
+    model->ppcs = account.allocated[SVT_AV1_MEM_PICTURES];
+    if (return_error == EB_ErrorNone) {
+        svt_memory_account_category(SVT_AV1_MEM_LOOKAHEAD);
+        return_error = svt_aom_me_creator((EbPtr *)&me, &input_data);
+        model->me = account.allocated[SVT_AV1_MEM_LOOKAHEAD];
+    }
+    if (return_error == EB_ErrorNone) {
+        pcs_init_data(scs, ppcs, &input_data);
+        svt_memory_account_category(SVT_AV1_MEM_PICTURES);
+        return_error = svt_aom_picture_control_set_creator((EbPtr *)&pcs, &input_data);
+        model->pcs = account.allocated[SVT_AV1_MEM_PICTURES] - model->ppcs;
+    }
+    if (return_error == EB_ErrorNone) {
+        return_error = svt_aom_recon_coef_creator((EbPtr *)&enc_dec_set, &input_data);
+        model->enc_dec_set = account.allocated[SVT_AV1_MEM_PICTURES] - model->ppcs - model->pcs;
+    }
+    if (return_error == EB_ErrorNone) {
+        EbReferenceObjectDescInitData ref_data;
+        scs->rest_units_per_tile = pcs->rst_info[0 /*Y-plane*/].units_per_tile;
+        scs->b64_total_count     = pcs->b64_total_count;
+        ref_init_data(scs, &ref_data);
+        svt_memory_account_category(SVT_AV1_MEM_REFERENCES);
+        return_error     = svt_reference_object_creator((EbPtr *)&reference, &ref_data);
+        model->reference = account.allocated[SVT_AV1_MEM_REFERENCES];
+    }
+    if (return_error == EB_ErrorNone) {
+        EbTplReferenceObjectDescInitData tpl_ref_data;
+        tpl_ref_init_data(scs, &tpl_ref_data);
+        svt_memory_account_category(SVT_AV1_MEM_LOOKAHEAD);
+        return_error         = svt_tpl_reference_object_creator((EbPtr *)&tpl_reference, &tpl_ref_data);
+        model->tpl_reference = account.allocated[SVT_AV1_MEM_LOOKAHEAD] - model->me;
+    }
+    if (return_error == EB_ErrorNone) {
+        EbPaReferenceObjectDescInitData pa_ref_data;
+        pa_ref_init_data(scs, &pa_ref_data);
+        return_error        = svt_pa_reference_object_creator((EbPtr *)&pa_reference, &pa_ref_data);
+        model->pa_reference = account.allocated[SVT_AV1_MEM_LOOKAHEAD] - model->me - model->tpl_reference;
+    }
+    if (return_error == EB_ErrorNone) {
+        svt_memory_account_category(SVT_AV1_MEM_OTHER);
+        return_error = svt_aom_scs_set_creator((EbPtr *)&pool_scs, NULL);
+        model->fixed[SVT_AV1_MEM_OTHER] += EB_SequenceControlSetPoolInitCount * account.allocated[SVT_AV1_MEM_OTHER] +
+            svt_system_resource_size(EB_SequenceControlSetPoolInitCount, 1, 0, scs->static_config.lock_free_queues);
+    }
+    if (return_error == EB_ErrorNone) {
+        // built by svt_av1_enc_set_parameter()
+        const uint64_t scs_pool = account.allocated[SVT_AV1_MEM_OTHER];
+        EB_NO_THROW_NEW(prediction_structure_group, svt_aom_prediction_structure_group_ctor);
+        if (!prediction_structure_group)
+            return_error = EB_ErrorInsufficientResources;
+        model->fixed[SVT_AV1_MEM_OTHER] += account.allocated[SVT_AV1_MEM_OTHER] - scs_pool;
+    }
+    svt_memory_account_bind(NULL, SVT_AV1_MEM_OTHER);
+    EB_DELETE(prediction_structure_group);
+    EB_DELETE(pool_scs);
+    EB_DELETE(pa_reference);
+    EB_DELETE(tpl_reference);
+    EB_DELETE(reference);
+    EB_DELETE(enc_dec_set);
+    EB_DELETE(pcs);
+    EB_DELETE(me);
+    EB_DELETE(ppcs);
+    return return_error;
+}
+
+/* Bytes of the task fifos svt_av1_enc_init() creates between the stages, all accounted to OTHER */
+static uint64_t task_resources_size(const SequenceControlSet *scs) {
+    const struct {
+        uint32_t count;
+        uint32_t producers;
+        uint32_t consumers;
+        size_t   object_size;
+    } fifos[] = {
+        {scs->resource_coordination_fifo_init_count, EB_ResourceCoordinationProcessInitCount,
+         scs->picture_analysis_process_init_count, sizeof(ResourceCoordinationResults)},
+        {scs->picture_analysis_fifo_init_count, scs->picture_analysis_process_init_count,
+         EB_PictureDecisionProcessInitCount, sizeof(PictureAnalysisResults)},
+        {scs->picture_decision_fifo_init_count, EB_PictureDecisionProcessInitCount + 2,
+         scs->motion_estimation_process_init_count, sizeof(PictureDecisionResults)},
+        {scs->motion_estimation_fifo_init_count, scs->motion_estimation_process_init_count,
+         EB_InitialRateControlProcessInitCount, sizeof(MotionEstimationResults)},
+        {scs->initial_rate_control_fifo_init_count, EB_InitialRateControlProcessInitCount,
+         scs->source_based_operations_process_init_count, sizeof(InitialRateControlResults)},
+        {scs->picture_demux_fifo_init_count,
+         scs->source_based_operations_process_init_count + EB_PacketizationProcessInitCount +
+             scs->rest_process_init_count,
+         EB_PictureManagerProcessInitCount, sizeof(PictureDemuxResults)},
+        {scs->tpl_disp_fifo_init_count,
+         scs->source_based_operations_process_init_count + scs->tpl_disp_process_init_count,
+         scs->tpl_disp_process_init_count, sizeof(TplDispResults)},
+        {scs->rate_control_tasks_fifo_init_count,
+         EB_PictureManagerProcessInitCount + EB_PacketizationProcessInitCount +
+             scs->entropy_coding_process_init_count,
+         EB_RateControlProcessInitCount, sizeof(RateControlTasks)},
+        {scs->rate_control_fifo_init_count, EB_RateControlProcessInitCount,
+         scs->mode_decision_configuration_process_init_count, sizeof(RateControlResults)},
+        {scs->mode_decision_configuration_fifo_init_count,
+         scs->mode_decision_configuration_process_init_count + scs->enc_dec_process_init_count,
+         scs->enc_dec_process_init_count, sizeof(EncDecTasks)},
+        {scs->enc_dec_fifo_init_count, scs->enc_dec_process_init_count, scs->dlf_process_init_count,
+         sizeof(EncDecResults)},
+        {scs->dlf_fifo_init_count, scs->dlf_process_init_count, scs->cdef_process_init_count, sizeof(DlfResults)},
+        {scs->cdef_fifo_init_count, scs->cdef_process_init_count, scs->rest_process_init_count, sizeof(CdefResults)},
+        {scs->rest_fifo_init_count, scs->rest_process_init_count, scs->entropy_coding_process_init_count,
+         sizeof(RestResults)},
+        {scs->entropy_coding_fifo_init_count, scs->entropy_coding_process_init_count,
+         EB_PacketizationProcessInitCount, sizeof(EntropyCodingResults)},
+        {scs->output_stream_buffer_fifo_init_count, scs->total_process_init_count, 1, sizeof(EbBufferHeaderType)},
+    };
+    const Bool lock_free = scs->static_config.lock_free_queues;
+    uint64_t   total     = 0;
+    for (uint32_t i = 0; i < sizeof(fifos) / sizeof(fifos[0]); i++)
+        total += svt_system_resource_size(fifos[i].count, fifos[i].producers, fifos[i].consumers, lock_free) +
+            (uint64_t)fifos[i].count * fifos[i].object_size;
+    total += svt_aom_segment_workers_size(scs->rate_control_sb_process_init_count, EB_RateControlProcessInitCount,
+                                          lock_free);
+    total += svt_aom_segment_workers_size(scs->cdef_search_process_init_count, scs->cdef_process_init_count, lock_free);
+    total += svt_aom_segment_workers_size(scs->denoise_process_init_count, scs->picture_analysis_process_init_count,
+                                          lock_free);
+    return total;
+}
+
+/* Prices scs with model, adding the fifos svt_aom_memory_estimate() leaves to this file */
+static void memory_estimate(const SequenceControlSet *scs, const EbMemoryModel *model, SvtAv1MemoryUsage *usage) {
+    svt_aom_memory_estimate(scs, model, usage);
+    const uint64_t input_cmd = svt_system_resource_size(scs->resource_coordination_fifo_init_count,
+                                                        1,
+                                                        EB_ResourceCoordinationProcessInitCount,
+                                                        scs->static_config.lock_free_queues) +
+        (uint64_t)scs->resource_coordination_fifo_init_count * sizeof(InputCommand);
+    const uint64_t tasks = task_resources_size(scs);
+    usage->category[SVT_AV1_MEM_PICTURES] += input_cmd;
+    usage->category[SVT_AV1_MEM_OTHER] += tasks;
+    usage->total += input_cmd + tasks;
+}
+
+static void set_param_based_on_input(SequenceControlSet *scs);
+/*
+ * Shrinks the configuration of scs until model prices it within max_memory_mb. requested is the
+ * configuration set_param_based_on_input() derived scs from; each step lowers one of its knobs and
+ * derives scs again, so every setting that follows from the level of parallelism or the lookahead
+ * stays consistent. The level of parallelism goes first as it only costs speed, then the lookahead
+ * mini-gops beyond the TPL ones, then the TPL lookahead. When the smallest configuration is still
+ * over budget it is kept with a warning rather than failing the init.
+ */
+static EbErrorType fit_memory_budget(SequenceControlSet *scs, const EbSvtAv1EncConfiguration *requested,
+                                     EbMemoryModel *model, Bool verbose) {
+    const uint64_t           budget    = (uint64_t)requested->max_memory_mb << 20;
+    const uint32_t           mg_size   = 1 << scs->static_config.hierarchical_levels;
+    const uint32_t           eos_delay = 1;
+    EbSvtAv1EncConfiguration fitted    = *requested;
+    SvtAv1MemoryUsage        usage;
+    EbErrorType              return_error = EB_ErrorNone;
+    memory_estimate(scs, model, &usage);
+    const uint64_t initial = usage.total;
+    while (usage.total > budget) {
+        if (fitted.core_pool)
+            fitted.core_pool = 0;
+#if CLN_LP_LVLS
+        else if (scs->lp > PARALLEL_LEVEL_1)
+            fitted.level_of_parallelism = scs->lp - 1;
+#else
+        else if (scs->core_count > SINGLE_CORE_COUNT)
+            fitted.logical_processors = scs->core_count / 2;
+#endif
+        // the lookahead update_look_ahead() rounds to one mini-gop less
+        else if (scs->lad_mg > scs->tpl_lad_mg)
+            fitted.look_ahead_distance = (1 + mg_size) * scs->lad_mg + scs->scd_delay + eos_delay;
+        // below one mini-gop TPL only uses the current one
+        else if (scs->tpl_lad_mg)
+            fitted.look_ahead_distance = mg_size - 1;
+        else {
+            if (verbose)
+                SVT_WARN("max-memory-mb %u is below the smallest configuration, %.1f MB\n",
+                    requested->max_memory_mb, usage.total / (double)(1 << 20));
+            break;
+        }
+        scs->static_config = fitted;
+        set_param_based_on_input(scs);
+        return_error = load_default_buffer_configuration_settings(scs, FALSE);
+        if (return_error == EB_ErrorNone)
+            return_error = memory_model_init(scs, model);
+        if (return_error != EB_ErrorNone)
+            return return_error;
+        memory_estimate(scs, model, &usage);
+    }
+    if (verbose) {
+        if (usage.total < initial)
+            SVT_INFO("max-memory-mb %u: estimated memory lowered from %.1f MB to %.1f MB, lookahead mini-gops %u\n",
+                requested->max_memory_mb, initial / (double)(1 << 20), usage.total / (double)(1 << 20),
+                scs->lad_mg);
+        return_error = load_default_buffer_configuration_settings(scs, TRUE);
+    }
+    return return_error;
 }
  // Rate Control
 static RateControlPorts rate_control_ports[] = {
@@ -1332,6 +1858,7 @@ static void svt_enc_handle_stop_threads(EbEncHandle *enc_handle_ptr)
     // Resource Coordination
     EB_DESTROY_THREAD(enc_handle_ptr->resource_coordination_thread_handle);
     EB_DESTROY_THREAD_ARRAY(enc_handle_ptr->picture_analysis_thread_handle_array,control_set_ptr->picture_analysis_process_init_count);
+    svt_aom_segment_workers_stop(enc_handle_ptr->denoise_workers);
 
     // Picture Decision
     EB_DESTROY_THREAD(enc_handle_ptr->picture_decision_thread_handle);
@@ -1354,6 +1881,9 @@ static void svt_enc_handle_stop_threads(EbEncHandle *enc_handle_ptr)
     // Rate Control
     EB_DESTROY_THREAD(enc_handle_ptr->rate_control_thread_handle);
 
+    // Rate Control SB QP derivation
+    svt_aom_segment_workers_stop(enc_handle_ptr->rate_control_sb_workers);
+
     // Mode Decision Configuration Process
     EB_DESTROY_THREAD_ARRAY(enc_handle_ptr->mode_decision_configuration_thread_handle_array, control_set_ptr->mode_decision_configuration_process_init_count);
 
@@ -1366,6 +1896,9 @@ static void svt_enc_handle_stop_threads(EbEncHandle *enc_handle_ptr)
     // Cdef Process
     EB_DESTROY_THREAD_ARRAY(enc_handle_ptr->cdef_thread_handle_array, control_set_ptr->cdef_process_init_count);
 
+    // Cdef strength search workers
+    svt_aom_segment_workers_stop(enc_handle_ptr->cdef_search_workers);
+
     // Rest Process
     EB_DESTROY_THREAD_ARRAY(enc_handle_ptr->rest_thread_handle_array, control_set_ptr->rest_process_init_count);
 
@@ -1417,11 +1950,14 @@ static void svt_enc_handle_dctor(EbPtr p)
     EB_DELETE(enc_handle_ptr->picture_demux_results_resource_ptr);
     EB_DELETE(enc_handle_ptr->tpl_disp_res_srm);
     EB_DELETE(enc_handle_ptr->rate_control_tasks_resource_ptr);
+    EB_DELETE(enc_handle_ptr->rate_control_sb_workers);
     EB_DELETE(enc_handle_ptr->rate_control_results_resource_ptr);
     EB_DELETE(enc_handle_ptr->enc_dec_tasks_resource_ptr);
     EB_DELETE(enc_handle_ptr->enc_dec_results_resource_ptr);
     EB_DELETE(enc_handle_ptr->dlf_results_resource_ptr);
     EB_DELETE(enc_handle_ptr->cdef_results_resource_ptr);
+    EB_DELETE(enc_handle_ptr->cdef_search_workers);
+    EB_DELETE(enc_handle_ptr->denoise_workers);
     EB_DELETE(enc_handle_ptr->rest_results_resource_ptr);
     EB_DELETE(enc_handle_ptr->entropy_coding_results_resource_ptr);
 
@@ -1443,7 +1979,8 @@ static void svt_enc_handle_dctor(EbPtr p)
     EB_DELETE(enc_handle_ptr->rate_control_context_ptr);
     EB_DELETE(enc_handle_ptr->packetization_context_ptr);
     EB_DELETE_PTR_ARRAY(enc_handle_ptr->reference_picture_pool_ptr_array, enc_handle_ptr->encode_instance_total_count);
-
+    EB_DESTROY_MUTEX(enc_handle_ptr->zero_copy_mutex);
+    svt_core_pool_destroy(enc_handle_ptr->core_pool);
 }
 
 /**********************************
@@ -1475,6 +2012,7 @@ static EbErrorType svt_enc_handle_ctor(
     enc_handle_ptr->eos_sent = false;
     enc_handle_ptr->frame_received = false;
     enc_handle_ptr->is_prev_valid = true;
+    EB_CREATE_MUTEX(enc_handle_ptr->zero_copy_mutex);
     return EB_ErrorNone;
 }
 
@@ -1625,70 +2163,16 @@ static EbErrorType rest_results_creator(
     return EB_ErrorNone;
 }
 
+/* Queue kind of the SystemResources of this encoder, see svt_system_resource_ctor */
+static INLINE Bool use_lock_free_queues(const EbEncHandle *enc_handle_ptr) {
+    return enc_handle_ptr->scs_instance_array[0]->scs->static_config.lock_free_queues;
+}
+
 static int create_pa_ref_buf_descs(EbEncHandle *enc_handle_ptr, uint32_t instance_index)
 {
         SequenceControlSet* scs = enc_handle_ptr->scs_instance_array[instance_index]->scs;
         EbPaReferenceObjectDescInitData   eb_pa_ref_obj_ect_desc_init_data_structure;
-        EbPictureBufferDescInitData       ref_pic_buf_desc_init_data;
-        EbPictureBufferDescInitData       quart_pic_buf_desc_init_data;
-        EbPictureBufferDescInitData       sixteenth_pic_buf_desc_init_data;
-        // PA Reference Picture Buffers
-        // Currently, only Luma samples are needed in the PA
-        ref_pic_buf_desc_init_data.max_width = scs->max_input_luma_width;
-        ref_pic_buf_desc_init_data.max_height = scs->max_input_luma_height;
-        ref_pic_buf_desc_init_data.bit_depth = EB_EIGHT_BIT;
-        ref_pic_buf_desc_init_data.color_format = EB_YUV420; //use 420 for picture analysis
-        //No full-resolution pixel data is allocated for PA REF,
-        // it points directly to the Luma input samples of the app data
-        ref_pic_buf_desc_init_data.buffer_enable_mask = 0;
-
-
-        ref_pic_buf_desc_init_data.left_padding = scs->left_padding;
-        ref_pic_buf_desc_init_data.right_padding = scs->right_padding;
-        ref_pic_buf_desc_init_data.top_padding = scs->top_padding;
-        ref_pic_buf_desc_init_data.bot_padding = scs->bot_padding;
-        ref_pic_buf_desc_init_data.split_mode = FALSE;
-        ref_pic_buf_desc_init_data.rest_units_per_tile = scs->rest_units_per_tile;
-        ref_pic_buf_desc_init_data.mfmv                = 0;
-        ref_pic_buf_desc_init_data.is_16bit_pipeline   = FALSE;
-        ref_pic_buf_desc_init_data.enc_mode            = scs->static_config.enc_mode;
-        ref_pic_buf_desc_init_data.sb_total_count      = scs->sb_total_count;
-
-        quart_pic_buf_desc_init_data.max_width = scs->max_input_luma_width >> 1;
-        quart_pic_buf_desc_init_data.max_height = scs->max_input_luma_height >> 1;
-        quart_pic_buf_desc_init_data.bit_depth = EB_EIGHT_BIT;
-        quart_pic_buf_desc_init_data.color_format = EB_YUV420;
-        quart_pic_buf_desc_init_data.buffer_enable_mask = PICTURE_BUFFER_DESC_LUMA_MASK;
-        quart_pic_buf_desc_init_data.left_padding = scs->b64_size >> 1;
-        quart_pic_buf_desc_init_data.right_padding = scs->b64_size >> 1;
-        quart_pic_buf_desc_init_data.top_padding = scs->b64_size >> 1;
-        quart_pic_buf_desc_init_data.bot_padding = scs->b64_size >> 1;
-        quart_pic_buf_desc_init_data.split_mode = FALSE;
-        quart_pic_buf_desc_init_data.rest_units_per_tile = scs->rest_units_per_tile;
-        quart_pic_buf_desc_init_data.mfmv                = 0;
-        quart_pic_buf_desc_init_data.is_16bit_pipeline   = FALSE;
-        quart_pic_buf_desc_init_data.enc_mode            = scs->static_config.enc_mode;
-        quart_pic_buf_desc_init_data.sb_total_count      = scs->sb_total_count;
-
-        sixteenth_pic_buf_desc_init_data.max_width = scs->max_input_luma_width >> 2;
-        sixteenth_pic_buf_desc_init_data.max_height = scs->max_input_luma_height >> 2;
-        sixteenth_pic_buf_desc_init_data.bit_depth = EB_EIGHT_BIT;
-        sixteenth_pic_buf_desc_init_data.color_format = EB_YUV420;
-        sixteenth_pic_buf_desc_init_data.buffer_enable_mask = PICTURE_BUFFER_DESC_LUMA_MASK;
-        sixteenth_pic_buf_desc_init_data.left_padding = scs->b64_size >> 2;
-        sixteenth_pic_buf_desc_init_data.right_padding = scs->b64_size >> 2;
-        sixteenth_pic_buf_desc_init_data.top_padding = scs->b64_size >> 2;
-        sixteenth_pic_buf_desc_init_data.bot_padding = scs->b64_size >> 2;
-        sixteenth_pic_buf_desc_init_data.split_mode = FALSE;
-        sixteenth_pic_buf_desc_init_data.rest_units_per_tile = scs->rest_units_per_tile;
-        sixteenth_pic_buf_desc_init_data.mfmv                = 0;
-        sixteenth_pic_buf_desc_init_data.is_16bit_pipeline   = FALSE;
-        sixteenth_pic_buf_desc_init_data.enc_mode            = scs->static_config.enc_mode;
-        sixteenth_pic_buf_desc_init_data.sb_total_count      = scs->sb_total_count;
-
-        eb_pa_ref_obj_ect_desc_init_data_structure.reference_picture_desc_init_data = ref_pic_buf_desc_init_data;
-        eb_pa_ref_obj_ect_desc_init_data_structure.quarter_picture_desc_init_data = quart_pic_buf_desc_init_data;
-        eb_pa_ref_obj_ect_desc_init_data_structure.sixteenth_picture_desc_init_data = sixteenth_pic_buf_desc_init_data;
+        pa_ref_init_data(scs, &eb_pa_ref_obj_ect_desc_init_data_structure);
         // Reference Picture Buffers
         EB_NEW(enc_handle_ptr->pa_reference_picture_pool_ptr_array[instance_index],
             svt_system_resource_ctor,
@@ -1697,7 +2181,8 @@ static int create_pa_ref_buf_descs(EbEncHandle *enc_handle_ptr, uint32_t instanc
             0,
             svt_pa_reference_object_creator,
             &(eb_pa_ref_obj_ect_desc_init_data_structure),
-            NULL);
+            NULL,
+            use_lock_free_queues(enc_handle_ptr));
         // Set the SequenceControlSet Picture Pool Fifo Ptrs
         enc_handle_ptr->scs_instance_array[instance_index]->enc_ctx->pa_reference_picture_pool_fifo_ptr =
             svt_system_resource_get_producer_fifo(enc_handle_ptr->pa_reference_picture_pool_ptr_array[instance_index], 0);
@@ -1711,30 +2196,7 @@ static int create_tpl_ref_buf_descs(EbEncHandle *enc_handle_ptr, uint32_t instan
 {
     SequenceControlSet* scs = enc_handle_ptr->scs_instance_array[instance_index]->scs;
     EbTplReferenceObjectDescInitData   eb_tpl_ref_obj_ect_desc_init_data_structure;
-    EbPictureBufferDescInitData       ref_pic_buf_desc_init_data;
-    // PA Reference Picture Buffers
-    // Currently, only Luma samples are needed in the PA
-    ref_pic_buf_desc_init_data.max_width = scs->max_input_luma_width;
-    ref_pic_buf_desc_init_data.max_height = scs->max_input_luma_height;
-    ref_pic_buf_desc_init_data.bit_depth = EB_EIGHT_BIT;
-    ref_pic_buf_desc_init_data.color_format = EB_YUV420; //use 420 for picture analysis
-
-    // Allocate one ref pic to be used in TPL
-    ref_pic_buf_desc_init_data.buffer_enable_mask = PICTURE_BUFFER_DESC_Y_FLAG;
-
-    ref_pic_buf_desc_init_data.left_padding = TPL_PADX;// scs->left_padding;
-    ref_pic_buf_desc_init_data.right_padding = TPL_PADX;// scs->right_padding;
-    ref_pic_buf_desc_init_data.top_padding = TPL_PADY;// scs->top_padding;
-    ref_pic_buf_desc_init_data.bot_padding = TPL_PADY;// scs->bot_padding;
-    ref_pic_buf_desc_init_data.split_mode = FALSE;
-    ref_pic_buf_desc_init_data.mfmv = 0;
-    ref_pic_buf_desc_init_data.is_16bit_pipeline = FALSE;
-    ref_pic_buf_desc_init_data.enc_mode = scs->static_config.enc_mode;
-
-    ref_pic_buf_desc_init_data.rest_units_per_tile = 0;// rest not needed in tpl scs->rest_units_per_tile;
-    ref_pic_buf_desc_init_data.sb_total_count = scs->sb_total_count;
-
-    eb_tpl_ref_obj_ect_desc_init_data_structure.reference_picture_desc_init_data = ref_pic_buf_desc_init_data;
+    tpl_ref_init_data(scs, &eb_tpl_ref_obj_ect_desc_init_data_structure);
     // Reference Picture Buffers
     EB_NEW(enc_handle_ptr->tpl_reference_picture_pool_ptr_array[instance_index],
         svt_system_resource_ctor,
@@ -1743,7 +2205,8 @@ static int create_tpl_ref_buf_descs(EbEncHandle *enc_handle_ptr, uint32_t instan
         0,
         svt_tpl_reference_object_creator,
         &(eb_tpl_ref_obj_ect_desc_init_data_structure),
-        NULL);
+        NULL,
+        use_lock_free_queues(enc_handle_ptr));
     // Set the SequenceControlSet Picture Pool Fifo Ptrs
     enc_handle_ptr->scs_instance_array[instance_index]->enc_ctx->tpl_reference_picture_pool_fifo_ptr =
         svt_system_resource_get_producer_fifo(enc_handle_ptr->tpl_reference_picture_pool_ptr_array[instance_index], 0);
@@ -1755,40 +2218,8 @@ static int create_tpl_ref_buf_descs(EbEncHandle *enc_handle_ptr, uint32_t instan
 static int create_ref_buf_descs(EbEncHandle *enc_handle_ptr, uint32_t instance_index)
 {
     EbReferenceObjectDescInitData     eb_ref_obj_ect_desc_init_data_structure;
-    EbPictureBufferDescInitData       ref_pic_buf_desc_init_data;
     SequenceControlSet* scs = enc_handle_ptr->scs_instance_array[instance_index]->scs;
-    Bool is_16bit = (Bool)(scs->static_config.encoder_bit_depth > EB_EIGHT_BIT);
-    // Initialize the various Picture types
-    ref_pic_buf_desc_init_data.max_width = scs->max_input_luma_width;
-    ref_pic_buf_desc_init_data.max_height = scs->max_input_luma_height;
-    ref_pic_buf_desc_init_data.bit_depth = scs->encoder_bit_depth;
-    ref_pic_buf_desc_init_data.color_format = scs->static_config.encoder_color_format;
-    ref_pic_buf_desc_init_data.buffer_enable_mask = PICTURE_BUFFER_DESC_FULL_MASK;
-    ref_pic_buf_desc_init_data.rest_units_per_tile = scs->rest_units_per_tile;
-    ref_pic_buf_desc_init_data.sb_total_count = scs->b64_total_count;
-    uint16_t padding = scs->super_block_size + 32;
-    if (scs->static_config.superres_mode > SUPERRES_NONE ||
-        scs->static_config.resize_mode > RESIZE_NONE) {
-        padding += scs->super_block_size;
-    }
-
-    ref_pic_buf_desc_init_data.left_padding = padding;
-    ref_pic_buf_desc_init_data.right_padding = padding;
-    ref_pic_buf_desc_init_data.top_padding = padding;
-    ref_pic_buf_desc_init_data.bot_padding = padding;
-    ref_pic_buf_desc_init_data.mfmv = scs->mfmv_enabled;
-    ref_pic_buf_desc_init_data.is_16bit_pipeline = scs->is_16bit_pipeline;
-    // Hsan: split_mode is set @ eb_reference_object_ctor() as both unpacked reference and packed reference are needed for a 10BIT input; unpacked reference @ MD, and packed reference @ EP
-
-    ref_pic_buf_desc_init_data.split_mode = FALSE;
-    ref_pic_buf_desc_init_data.enc_mode = scs->static_config.enc_mode;
-    if (is_16bit)
-        ref_pic_buf_desc_init_data.bit_depth = EB_TEN_BIT;
-
-    eb_ref_obj_ect_desc_init_data_structure.reference_picture_desc_init_data = ref_pic_buf_desc_init_data;
-    eb_ref_obj_ect_desc_init_data_structure.hbd_md =
-        scs->enable_hbd_mode_decision;
-    eb_ref_obj_ect_desc_init_data_structure.static_config = &scs->static_config;
+    ref_init_data(scs, &eb_ref_obj_ect_desc_init_data_structure);
     // Reference Picture Buffers
     EB_NEW(
             enc_handle_ptr->reference_picture_pool_ptr_array[instance_index],
@@ -1798,7 +2229,8 @@ static int create_ref_buf_descs(EbEncHandle *enc_handle_ptr, uint32_t instance_i
             0,
             svt_reference_object_creator,
             &(eb_ref_obj_ect_desc_init_data_structure),
-            NULL);
+            NULL,
+            use_lock_free_queues(enc_handle_ptr));
 
     // Create reference list for Picture Manager
     // When decode-order is not enforced at pic mgr, each reference picture must have an allocated reference buffer (for at least one mini-gop) so the
@@ -1826,16 +2258,122 @@ static int create_ref_buf_descs(EbEncHandle *enc_handle_ptr, uint32_t instance_i
     return 0;
 }
 
+static void print_memory_usage(const EbMemoryAccount *account) {
+    SvtAv1MemoryUsage usage;
+    svt_memory_account_usage(account, &usage);
+    const double mb = 1.0 / (1 << 20);
+    SVT_INFO("Encoder memory: %.1f MB (pictures %.1f, references %.1f, lookahead %.1f, mode decision %.1f, other %.1f)\n",
+             usage.total * mb,
+             usage.category[SVT_AV1_MEM_PICTURES] * mb,
+             usage.category[SVT_AV1_MEM_REFERENCES] * mb,
+             usage.category[SVT_AV1_MEM_LOOKAHEAD] * mb,
+             usage.category[SVT_AV1_MEM_MODE_DECISION] * mb,
+             usage.category[SVT_AV1_MEM_OTHER] * mb);
+}
+
 void init_fn_ptr(void);
 void svt_av1_init_wedge_masks(void);
 /**********************************
 * Initialize Encoder Library
 **********************************/
-EB_API EbErrorType svt_av1_enc_init(EbComponentType *svt_enc_component)
+/* Starts the threads of the segment workers of a stage, if it has any */
+static EbErrorType start_segment_workers(SegmentWorkers *workers) {
+    if (workers)
+        EB_CREATE_THREAD_ARRAY(workers->thread_handle_array, workers->worker_count,
+            svt_aom_segment_worker_kernel,
+            workers->tasks_fifo_ptr_array);
+    return EB_ErrorNone;
+}
+/*
+ Create the pipeline threads. Returns early on the first failure, which enc_init handles
+ after detaching the calling thread from the core pool.
+*/
+static EbErrorType create_pipeline_threads(EbEncHandle *enc_handle_ptr) {
+    SequenceControlSet *control_set_ptr = enc_handle_ptr->scs_instance_array[0]->scs;
+    EbErrorType         return_error;
+    // Resource Coordination
+    EB_CREATE_THREAD(enc_handle_ptr->resource_coordination_thread_handle, svt_aom_resource_coordination_kernel, enc_handle_ptr->resource_coordination_context_ptr);
+    EB_CREATE_THREAD_ARRAY(enc_handle_ptr->picture_analysis_thread_handle_array,control_set_ptr->picture_analysis_process_init_count,
+        svt_aom_picture_analysis_kernel,
+        enc_handle_ptr->picture_analysis_context_ptr_array);
+
+    // Film grain denoise workers
+    return_error = start_segment_workers(enc_handle_ptr->denoise_workers);
+    if (return_error != EB_ErrorNone)
+        return return_error;
+
+    // Picture Decision
+    EB_CREATE_THREAD(enc_handle_ptr->picture_decision_thread_handle, svt_aom_picture_decision_kernel, enc_handle_ptr->picture_decision_context_ptr);
+
+    // Motion Estimation
+    EB_CREATE_THREAD_ARRAY(enc_handle_ptr->motion_estimation_thread_handle_array, control_set_ptr->motion_estimation_process_init_count,
+        svt_aom_motion_estimation_kernel,
+        enc_handle_ptr->motion_estimation_context_ptr_array);
+
+        // Initial Rate Control
+        EB_CREATE_THREAD(enc_handle_ptr->initial_rate_control_thread_handle, svt_aom_initial_rate_control_kernel, enc_handle_ptr->initial_rate_control_context_ptr);
+
+        // Source Based Oprations
+        EB_CREATE_THREAD_ARRAY(enc_handle_ptr->source_based_operations_thread_handle_array, control_set_ptr->source_based_operations_process_init_count,
+            svt_aom_source_based_operations_kernel,
+            enc_handle_ptr->source_based_operations_context_ptr_array);
+
+        // TPL dispenser
+        EB_CREATE_THREAD_ARRAY(enc_handle_ptr->tpl_disp_thread_handle_array, control_set_ptr->tpl_disp_process_init_count,
+            svt_aom_tpl_disp_kernel,//TODOOMK
+            enc_handle_ptr->tpl_disp_context_ptr_array);
+        // Picture Manager
+        EB_CREATE_THREAD(enc_handle_ptr->picture_manager_thread_handle, svt_aom_picture_manager_kernel, enc_handle_ptr->picture_manager_context_ptr);
+        // Rate Control
+        EB_CREATE_THREAD(enc_handle_ptr->rate_control_thread_handle, svt_aom_rate_control_kernel, enc_handle_ptr->rate_control_context_ptr);
+        // Rate Control SB QP derivation workers
+        return_error = start_segment_workers(enc_handle_ptr->rate_control_sb_workers);
+        if (return_error != EB_ErrorNone)
+            return return_error;
+
+        // Mode Decision Configuration Process
+        EB_CREATE_THREAD_ARRAY(enc_handle_ptr->mode_decision_configuration_thread_handle_array, control_set_ptr->mode_decision_configuration_process_init_count,
+            svt_aom_mode_decision_configuration_kernel,
+            enc_handle_ptr->mode_decision_configuration_context_ptr_array);
+
+
+        // EncDec Process
+        EB_CREATE_THREAD_ARRAY(enc_handle_ptr->enc_dec_thread_handle_array, control_set_ptr->enc_dec_process_init_count,
+            svt_aom_mode_decision_kernel,
+            enc_handle_ptr->enc_dec_context_ptr_array);
+
+        // Dlf Process
+        EB_CREATE_THREAD_ARRAY(enc_handle_ptr->dlf_thread_handle_array, control_set_ptr->dlf_process_init_count,
+            svt_aom_dlf_kernel,
+            enc_handle_ptr->dlf_context_ptr_array);
+
+        // Cdef Process
+        EB_CREATE_THREAD_ARRAY(enc_handle_ptr->cdef_thread_handle_array, control_set_ptr->cdef_process_init_count,
+            svt_aom_cdef_kernel,
+            enc_handle_ptr->cdef_context_ptr_array);
+
+        // Cdef strength search workers
+        return_error = start_segment_workers(enc_handle_ptr->cdef_search_workers);
+        if (return_error != EB_ErrorNone)
+            return return_error;
+
+        // Rest Process
+        EB_CREATE_THREAD_ARRAY(enc_handle_ptr->rest_thread_handle_array, control_set_ptr->rest_process_init_count,
+            svt_aom_rest_kernel,
+            enc_handle_ptr->rest_context_ptr_array);
+
+        // Entropy Coding Process
+        EB_CREATE_THREAD_ARRAY(enc_handle_ptr->entropy_coding_thread_handle_array, control_set_ptr->entropy_coding_process_init_count,
+            svt_aom_entropy_coding_kernel,
+            enc_handle_ptr->entropy_coding_context_ptr_array);
+
+    // Packetization
+    EB_CREATE_THREAD(enc_handle_ptr->packetization_thread_handle, svt_aom_packetization_kernel, enc_handle_ptr->packetization_context_ptr);
+    return EB_ErrorNone;
+}
+
+static EbErrorType enc_init(EbEncHandle *enc_handle_ptr)
 {
-    if(svt_enc_component == NULL)
-        return EB_ErrorBadParameter;
-    EbEncHandle *enc_handle_ptr = (EbEncHandle*)svt_enc_component->p_component_private;
     EbErrorType return_error = EB_ErrorNone;
     uint32_t instance_index;
     uint32_t process_index;
@@ -1873,7 +2411,8 @@ EB_API EbErrorType svt_av1_enc_init(EbComponentType *svt_enc_component)
             0,
             svt_aom_scs_set_creator,
             NULL,
-            NULL);
+            NULL,
+            use_lock_free_queues(enc_handle_ptr));
     }
     /************************************
     * Picture Control Set: Parent
@@ -1881,77 +2420,10 @@ EB_API EbErrorType svt_av1_enc_init(EbComponentType *svt_enc_component)
     EB_ALLOC_PTR_ARRAY(enc_handle_ptr->picture_parent_control_set_pool_ptr_array, enc_handle_ptr->encode_instance_total_count);
     EB_ALLOC_PTR_ARRAY(enc_handle_ptr->me_pool_ptr_array, enc_handle_ptr->encode_instance_total_count);
     for (instance_index = 0; instance_index < enc_handle_ptr->encode_instance_total_count; ++instance_index) {
-        // The segment Width & Height Arrays are in units of SBs, not samples
         PictureControlSetInitData input_data;
+        ppcs_init_data(enc_handle_ptr->scs_instance_array[instance_index]->scs, &input_data);
 
-        input_data.picture_width = enc_handle_ptr->scs_instance_array[instance_index]->scs->max_input_luma_width;
-        input_data.picture_height = enc_handle_ptr->scs_instance_array[instance_index]->scs->max_input_luma_height;
-        input_data.left_padding = enc_handle_ptr->scs_instance_array[instance_index]->scs->left_padding;
-        input_data.right_padding = enc_handle_ptr->scs_instance_array[instance_index]->scs->right_padding;
-        input_data.top_padding = enc_handle_ptr->scs_instance_array[instance_index]->scs->top_padding;
-        input_data.bot_padding = enc_handle_ptr->scs_instance_array[instance_index]->scs->bot_padding;
-        input_data.color_format = color_format;
-        input_data.b64_size = enc_handle_ptr->scs_instance_array[instance_index]->scs->b64_size;
-        input_data.ten_bit_format = enc_handle_ptr->scs_instance_array[instance_index]->scs->ten_bit_format;
-        input_data.enc_mode = enc_handle_ptr->scs_instance_array[instance_index]->scs->static_config.enc_mode;
-        input_data.speed_control = (uint8_t)enc_handle_ptr->scs_instance_array[instance_index]->scs->speed_control_flag;
-        input_data.hbd_md = enc_handle_ptr->scs_instance_array[instance_index]->scs->enable_hbd_mode_decision;
-        input_data.bit_depth = enc_handle_ptr->scs_instance_array[instance_index]->scs->static_config.encoder_bit_depth;
-        input_data.log2_tile_rows = enc_handle_ptr->scs_instance_array[instance_index]->scs->static_config.tile_rows;
-        input_data.log2_tile_cols = enc_handle_ptr->scs_instance_array[instance_index]->scs->static_config.tile_columns;
-        input_data.log2_sb_size = (enc_handle_ptr->scs_instance_array[instance_index]->scs->super_block_size == 128) ? 5 : 4;
-        input_data.is_16bit_pipeline = enc_handle_ptr->scs_instance_array[instance_index]->scs->is_16bit_pipeline;
-        input_data.non_m8_pad_w = enc_handle_ptr->scs_instance_array[instance_index]->scs->max_input_pad_right;
-        input_data.non_m8_pad_h = enc_handle_ptr->scs_instance_array[instance_index]->scs->max_input_pad_bottom;
-        input_data.enable_tpl_la = enc_handle_ptr->scs_instance_array[instance_index]->scs->tpl;
-        input_data.in_loop_ois = enc_handle_ptr->scs_instance_array[instance_index]->scs->in_loop_ois;
-        input_data.enc_dec_segment_col = (uint16_t)enc_handle_ptr->scs_instance_array[instance_index]->scs->tpl_segment_col_count_array;
-        input_data.enc_dec_segment_row = (uint16_t)enc_handle_ptr->scs_instance_array[instance_index]->scs->tpl_segment_row_count_array;
-        input_data.final_pass_preset = enc_handle_ptr->scs_instance_array[instance_index]->scs->final_pass_preset;
-        input_data.rate_control_mode = enc_handle_ptr->scs_instance_array[instance_index]->scs->static_config.rate_control_mode;
-        MrpCtrls* mrp_ctrl = &(enc_handle_ptr->scs_instance_array[0]->scs->mrp_ctrls);
-        input_data.ref_count_used_list0 =
-            MAX(mrp_ctrl->sc_base_ref_list0_count,
-                MAX(mrp_ctrl->base_ref_list0_count,
-                    MAX(mrp_ctrl->sc_non_base_ref_list0_count, mrp_ctrl->non_base_ref_list0_count)));
-
-        input_data.ref_count_used_list1 =
-            MAX(mrp_ctrl->sc_base_ref_list1_count,
-                MAX(mrp_ctrl->base_ref_list1_count,
-                    MAX(mrp_ctrl->sc_non_base_ref_list1_count, mrp_ctrl->non_base_ref_list1_count)));
-        input_data.tpl_synth_size = svt_aom_set_tpl_group(NULL,
-            svt_aom_get_tpl_group_level(
-                1,
-                enc_handle_ptr->scs_instance_array[instance_index]->scs->static_config.enc_mode,
-                enc_handle_ptr->scs_instance_array[instance_index]->scs->static_config.rate_control_mode),
-            input_data.picture_width, input_data.picture_height);
-        input_data.enable_adaptive_quantization = enc_handle_ptr->scs_instance_array[instance_index]->scs->static_config.enable_adaptive_quantization;
-        input_data.calculate_variance = enc_handle_ptr->scs_instance_array[instance_index]->scs->calculate_variance;
-        input_data.calc_hist = enc_handle_ptr->scs_instance_array[instance_index]->scs->calc_hist =
-            enc_handle_ptr->scs_instance_array[instance_index]->scs->static_config.scene_change_detection ||
-            enc_handle_ptr->scs_instance_array[instance_index]->scs->vq_ctrls.sharpness_ctrls.scene_transition ||
-            enc_handle_ptr->scs_instance_array[instance_index]->scs->tf_params_per_type[0].enabled ||
-            enc_handle_ptr->scs_instance_array[instance_index]->scs->tf_params_per_type[1].enabled ||
-            enc_handle_ptr->scs_instance_array[instance_index]->scs->tf_params_per_type[2].enabled;
-        input_data.tpl_lad_mg = enc_handle_ptr->scs_instance_array[instance_index]->scs->tpl_lad_mg;
-        input_data.input_resolution = enc_handle_ptr->scs_instance_array[instance_index]->scs->input_resolution;
-        input_data.is_scale = enc_handle_ptr->scs_instance_array[instance_index]->scs->static_config.superres_mode > SUPERRES_NONE ||
-                              enc_handle_ptr->scs_instance_array[instance_index]->scs->static_config.resize_mode > RESIZE_NONE;
-        input_data.rtc_tune = (enc_handle_ptr->scs_instance_array[instance_index]->scs->static_config.pred_structure == SVT_AV1_PRED_LOW_DELAY_B) ? true : false;
-        input_data.enable_variance_boost = enc_handle_ptr->scs_instance_array[instance_index]->scs->static_config.enable_variance_boost;
-        input_data.variance_boost_strength = enc_handle_ptr->scs_instance_array[instance_index]->scs->static_config.variance_boost_strength;
-        input_data.variance_octile = enc_handle_ptr->scs_instance_array[instance_index]->scs->static_config.variance_octile;
-        input_data.sharpness = enc_handle_ptr->scs_instance_array[instance_index]->scs->static_config.sharpness;
-        input_data.qp_scale_compress_strength = enc_handle_ptr->scs_instance_array[instance_index]->scs->static_config.qp_scale_compress_strength;
-        input_data.frame_luma_bias = enc_handle_ptr->scs_instance_array[instance_index]->scs->static_config.frame_luma_bias;
-        input_data.max_32_tx_size = enc_handle_ptr->scs_instance_array[instance_index]->scs->static_config.max_32_tx_size;
-        input_data.adaptive_film_grain = enc_handle_ptr->scs_instance_array[instance_index]->scs->static_config.adaptive_film_grain;
-        input_data.tf_strength = enc_handle_ptr->scs_instance_array[instance_index]->scs->static_config.tf_strength;
-        input_data.kf_tf_strength = enc_handle_ptr->scs_instance_array[instance_index]->scs->static_config.kf_tf_strength;
-        input_data.noise_norm_strength = enc_handle_ptr->scs_instance_array[instance_index]->scs->static_config.noise_norm_strength;
-        input_data.psy_rd = enc_handle_ptr->scs_instance_array[instance_index]->scs->static_config.psy_rd;
-        input_data.static_config = enc_handle_ptr->scs_instance_array[instance_index]->scs->static_config;
-
+        svt_memory_account_category(SVT_AV1_MEM_PICTURES);
         EB_NEW(
             enc_handle_ptr->picture_parent_control_set_pool_ptr_array[instance_index],
             svt_system_resource_ctor,
@@ -1960,10 +2432,12 @@ EB_API EbErrorType svt_av1_enc_init(EbComponentType *svt_enc_component)
             0,
             svt_aom_picture_parent_control_set_creator,
             &input_data,
-            NULL);
+            NULL,
+            use_lock_free_queues(enc_handle_ptr));
 #if SRM_REPORT
         enc_handle_ptr->picture_parent_control_set_pool_ptr_array[0]->empty_queue->log = 0;
 #endif
+        svt_memory_account_category(SVT_AV1_MEM_LOOKAHEAD);
         EB_NEW(
             enc_handle_ptr->me_pool_ptr_array[instance_index],
             svt_system_resource_ctor,
@@ -1972,7 +2446,8 @@ EB_API EbErrorType svt_av1_enc_init(EbComponentType *svt_enc_component)
             0,
             svt_aom_me_creator,
             &input_data,
-            NULL);
+            NULL,
+            use_lock_free_queues(enc_handle_ptr));
 #if SRM_REPORT
         enc_handle_ptr->me_pool_ptr_array[instance_index]->empty_queue->log = 0;
         dump_srm_content(enc_handle_ptr->me_pool_ptr_array[instance_index], FALSE);
@@ -1981,6 +2456,7 @@ EB_API EbErrorType svt_av1_enc_init(EbComponentType *svt_enc_component)
 
 
 
+        svt_memory_account_category(SVT_AV1_MEM_PICTURES);
         EB_ALLOC_PTR_ARRAY(enc_handle_ptr->enc_dec_pool_ptr_array, enc_handle_ptr->encode_instance_total_count);
 
         for (instance_index = 0; instance_index < enc_handle_ptr->encode_instance_total_count; ++instance_index) {
@@ -2032,7 +2508,8 @@ EB_API EbErrorType svt_av1_enc_init(EbComponentType *svt_enc_component)
                 0,
                 svt_aom_recon_coef_creator,
                 &input_data,
-                NULL);
+                NULL,
+                use_lock_free_queues(enc_handle_ptr));
         }
 
 
@@ -2044,48 +2521,10 @@ EB_API EbErrorType svt_av1_enc_init(EbComponentType *svt_enc_component)
         EB_ALLOC_PTR_ARRAY(enc_handle_ptr->picture_control_set_pool_ptr_array, enc_handle_ptr->encode_instance_total_count);
 
         for (instance_index = 0; instance_index < enc_handle_ptr->encode_instance_total_count; ++instance_index) {
-            // The segment Width & Height Arrays are in units of SBs, not samples
             PictureControlSetInitData input_data;
-            unsigned i;
-
-            input_data.enc_dec_segment_col = 0;
-            input_data.enc_dec_segment_row = 0;
-            for (i = 0; i <= enc_handle_ptr->scs_instance_array[instance_index]->scs->static_config.hierarchical_levels; ++i) {
-                input_data.enc_dec_segment_col = enc_handle_ptr->scs_instance_array[instance_index]->scs->enc_dec_segment_col_count_array[i] > input_data.enc_dec_segment_col ?
-                    (uint16_t)enc_handle_ptr->scs_instance_array[instance_index]->scs->enc_dec_segment_col_count_array[i] :
-                    input_data.enc_dec_segment_col;
-                input_data.enc_dec_segment_row = enc_handle_ptr->scs_instance_array[instance_index]->scs->enc_dec_segment_row_count_array[i] > input_data.enc_dec_segment_row ?
-                    (uint16_t)enc_handle_ptr->scs_instance_array[instance_index]->scs->enc_dec_segment_row_count_array[i] :
-                    input_data.enc_dec_segment_row;
-            }
-
-            input_data.init_max_block_cnt = enc_handle_ptr->scs_instance_array[instance_index]->scs->max_block_cnt;
-            input_data.picture_width = enc_handle_ptr->scs_instance_array[instance_index]->scs->max_input_luma_width;
-            input_data.picture_height = enc_handle_ptr->scs_instance_array[instance_index]->scs->max_input_luma_height;
-            input_data.left_padding = enc_handle_ptr->scs_instance_array[instance_index]->scs->left_padding;
-            input_data.right_padding = enc_handle_ptr->scs_instance_array[instance_index]->scs->right_padding;
-            input_data.top_padding = enc_handle_ptr->scs_instance_array[instance_index]->scs->top_padding;
-            input_data.bot_padding = enc_handle_ptr->scs_instance_array[instance_index]->scs->bot_padding;
-            input_data.bit_depth = enc_handle_ptr->scs_instance_array[instance_index]->scs->encoder_bit_depth;
-            input_data.color_format = color_format;
-            input_data.b64_size = enc_handle_ptr->scs_instance_array[instance_index]->scs->b64_size;
-            input_data.sb_size = enc_handle_ptr->scs_instance_array[instance_index]->scs->super_block_size;
-            input_data.hbd_md = enc_handle_ptr->scs_instance_array[instance_index]->scs->enable_hbd_mode_decision;
-            input_data.cdf_mode = enc_handle_ptr->scs_instance_array[instance_index]->scs->cdf_mode;
-            input_data.mfmv = enc_handle_ptr->scs_instance_array[instance_index]->scs->mfmv_enabled;
-            input_data.cfg_palette = enc_handle_ptr->scs_instance_array[0]->scs->static_config.screen_content_mode;
-            //Jing: Get tile info from parent_pcs
-            PictureParentControlSet *parent_pcs = (PictureParentControlSet *)enc_handle_ptr->picture_parent_control_set_pool_ptr_array[instance_index]->wrapper_ptr_pool[0]->object_ptr;
-            input_data.tile_row_count = parent_pcs->av1_cm->tiles_info.tile_rows;
-            input_data.tile_column_count = parent_pcs->av1_cm->tiles_info.tile_cols;
-            input_data.is_16bit_pipeline = enc_handle_ptr->scs_instance_array[instance_index]->scs->is_16bit_pipeline;
-            input_data.av1_cm = parent_pcs->av1_cm;
-            input_data.enc_mode = enc_handle_ptr->scs_instance_array[instance_index]->scs->static_config.enc_mode;
-            input_data.static_config = enc_handle_ptr->scs_instance_array[instance_index]->scs->static_config;
-
-            input_data.input_resolution = enc_handle_ptr->scs_instance_array[instance_index]->scs->input_resolution;
-            input_data.is_scale = enc_handle_ptr->scs_instance_array[instance_index]->scs->static_config.superres_mode > SUPERRES_NONE ||
-                                  enc_handle_ptr->scs_instance_array[instance_index]->scs->static_config.resize_mode > RESIZE_NONE;
+            pcs_init_data(enc_handle_ptr->scs_instance_array[instance_index]->scs,
+                (PictureParentControlSet *)enc_handle_ptr->picture_parent_control_set_pool_ptr_array[instance_index]->wrapper_ptr_pool[0]->object_ptr,
+                &input_data);
 
             EB_NEW(
                 enc_handle_ptr->picture_control_set_pool_ptr_array[instance_index],
@@ -2095,7 +2534,8 @@ EB_API EbErrorType svt_av1_enc_init(EbComponentType *svt_enc_component)
                 0,
                 svt_aom_picture_control_set_creator,
                 &input_data,
-                NULL);
+                NULL,
+                use_lock_free_queues(enc_handle_ptr));
         }
 
     /************************************
@@ -2129,11 +2569,14 @@ EB_API EbErrorType svt_av1_enc_init(EbComponentType *svt_enc_component)
         PictureControlSet *pcs = (PictureControlSet *)enc_handle_ptr->picture_control_set_pool_ptr_array[instance_index]->wrapper_ptr_pool[0]->object_ptr;
         enc_handle_ptr->scs_instance_array[instance_index]->scs->rest_units_per_tile = pcs->rst_info[0/*Y-plane*/].units_per_tile;
         enc_handle_ptr->scs_instance_array[instance_index]->scs->b64_total_count = pcs->b64_total_count;
+        svt_memory_account_category(SVT_AV1_MEM_REFERENCES);
         create_ref_buf_descs(enc_handle_ptr, instance_index);
 
+        svt_memory_account_category(SVT_AV1_MEM_LOOKAHEAD);
         create_tpl_ref_buf_descs(enc_handle_ptr, instance_index);
         create_pa_ref_buf_descs(enc_handle_ptr, instance_index);
 
+        svt_memory_account_category(SVT_AV1_MEM_PICTURES);
         if (enc_handle_ptr->scs_instance_array[0]->scs->static_config.enable_overlays) {
             // Overlay Input Picture Buffers
             EB_NEW(
@@ -2144,7 +2587,8 @@ EB_API EbErrorType svt_av1_enc_init(EbComponentType *svt_enc_component)
                 0,
                 svt_overlay_buffer_header_creator,
                 enc_handle_ptr->scs_instance_array[instance_index]->scs,
-                svt_input_buffer_header_destroyer);
+                svt_input_buffer_header_destroyer,
+                use_lock_free_queues(enc_handle_ptr));
             // Set the SequenceControlSet Overlay input Picture Pool Fifo Ptrs
             enc_handle_ptr->scs_instance_array[instance_index]->enc_ctx->overlay_input_picture_pool_fifo_ptr = svt_system_resource_get_producer_fifo(enc_handle_ptr->overlay_input_picture_pool_ptr_array[instance_index], 0);
         }
@@ -2163,7 +2607,8 @@ EB_API EbErrorType svt_av1_enc_init(EbComponentType *svt_enc_component)
         EB_ResourceCoordinationProcessInitCount,
         svt_input_cmd_creator,
         enc_handle_ptr->scs_instance_array[0]->scs,
-        NULL);
+        NULL,
+        use_lock_free_queues(enc_handle_ptr));
     enc_handle_ptr->input_cmd_producer_fifo_ptr = svt_system_resource_get_producer_fifo(enc_handle_ptr->input_cmd_resource_ptr, 0);
 
     //Picture Buffer SRM to hold (uv8b + yuv2b)
@@ -2175,7 +2620,8 @@ EB_API EbErrorType svt_av1_enc_init(EbComponentType *svt_enc_component)
         0, //1/2 SRM; no consumer FIFO
         svt_input_buffer_header_creator,
         enc_handle_ptr->scs_instance_array[0]->scs,
-        svt_input_buffer_header_destroyer);
+        svt_input_buffer_header_destroyer,
+        use_lock_free_queues(enc_handle_ptr));
     enc_handle_ptr->input_buffer_producer_fifo_ptr = svt_system_resource_get_producer_fifo(enc_handle_ptr->input_buffer_resource_ptr, 0);
 
     //Picture Buffer SRM to hold y8b to be shared by Pcs->enhanced and Pa_ref
@@ -2187,13 +2633,15 @@ EB_API EbErrorType svt_av1_enc_init(EbComponentType *svt_enc_component)
         0, //1/2 SRM; no consumer FIFO
         svt_input_y8b_creator,
         enc_handle_ptr->scs_instance_array[0]->scs,
-        svt_input_y8b_destroyer);
+        svt_input_y8b_destroyer,
+        use_lock_free_queues(enc_handle_ptr));
 
 #if SRM_REPORT
     enc_handle_ptr->input_y8b_buffer_resource_ptr->empty_queue->log = 1;
 #endif
     enc_handle_ptr->input_y8b_buffer_producer_fifo_ptr = svt_system_resource_get_producer_fifo(enc_handle_ptr->input_y8b_buffer_resource_ptr, 0);
 
+    svt_memory_account_category(SVT_AV1_MEM_OTHER);
     // EbBufferHeaderType Output Stream
     EB_ALLOC_PTR_ARRAY(enc_handle_ptr->output_stream_buffer_resource_ptr_array, enc_handle_ptr->encode_instance_total_count);
 
@@ -2206,10 +2654,12 @@ EB_API EbErrorType svt_av1_enc_init(EbComponentType *svt_enc_component)
             1,
             svt_output_buffer_header_creator,
             &enc_handle_ptr->scs_instance_array[0]->scs->static_config,
-            svt_output_buffer_header_destroyer);
+            svt_output_buffer_header_destroyer,
+            use_lock_free_queues(enc_handle_ptr));
     }
     enc_handle_ptr->output_stream_buffer_consumer_fifo_ptr = svt_system_resource_get_consumer_fifo(enc_handle_ptr->output_stream_buffer_resource_ptr_array[0], 0);
     if (enc_handle_ptr->scs_instance_array[0]->scs->static_config.recon_enabled) {
+        svt_memory_account_category(SVT_AV1_MEM_PICTURES);
         // EbBufferHeaderType Output Recon
         EB_ALLOC_PTR_ARRAY(enc_handle_ptr->output_recon_buffer_resource_ptr_array, enc_handle_ptr->encode_instance_total_count);
 
@@ -2222,11 +2672,13 @@ EB_API EbErrorType svt_av1_enc_init(EbComponentType *svt_enc_component)
                 1,
                 svt_output_recon_buffer_header_creator,
                 enc_handle_ptr->scs_instance_array[0]->scs,
-                svt_output_recon_buffer_header_destroyer);
+                svt_output_recon_buffer_header_destroyer,
+                use_lock_free_queues(enc_handle_ptr));
         }
         enc_handle_ptr->output_recon_buffer_consumer_fifo_ptr = svt_system_resource_get_consumer_fifo(enc_handle_ptr->output_recon_buffer_resource_ptr_array[0], 0);
     }
 
+    svt_memory_account_category(SVT_AV1_MEM_OTHER);
     // Resource Coordination Results
     {
         ResourceCoordinationResultInitData resource_coordination_result_init_data;
@@ -2239,7 +2691,8 @@ EB_API EbErrorType svt_av1_enc_init(EbComponentType *svt_enc_component)
             enc_handle_ptr->scs_instance_array[0]->scs->picture_analysis_process_init_count,
             svt_aom_resource_coordination_result_creator,
             &resource_coordination_result_init_data,
-            NULL);
+            NULL,
+            use_lock_free_queues(enc_handle_ptr));
     }
 
     // Picture Analysis Results
@@ -2254,7 +2707,8 @@ EB_API EbErrorType svt_av1_enc_init(EbComponentType *svt_enc_component)
             EB_PictureDecisionProcessInitCount,
             svt_aom_picture_analysis_result_creator,
             &picture_analysis_result_init_data,
-            NULL);
+            NULL,
+            use_lock_free_queues(enc_handle_ptr));
     }
 
     // Picture Decision Results
@@ -2269,7 +2723,8 @@ EB_API EbErrorType svt_av1_enc_init(EbComponentType *svt_enc_component)
             enc_handle_ptr->scs_instance_array[0]->scs->motion_estimation_process_init_count,
             svt_aom_picture_decision_result_creator,
             &picture_decision_result_init_data,
-            NULL);
+            NULL,
+            use_lock_free_queues(enc_handle_ptr));
     }
 
     // Motion Estimation Results
@@ -2284,7 +2739,8 @@ EB_API EbErrorType svt_av1_enc_init(EbComponentType *svt_enc_component)
             EB_InitialRateControlProcessInitCount,
             svt_aom_motion_estimation_results_creator,
             &motion_estimation_result_init_data,
-            NULL);
+            NULL,
+            use_lock_free_queues(enc_handle_ptr));
     }
 
 
@@ -2300,7 +2756,8 @@ EB_API EbErrorType svt_av1_enc_init(EbComponentType *svt_enc_component)
             enc_handle_ptr->scs_instance_array[0]->scs->source_based_operations_process_init_count,
             svt_aom_initial_rate_control_results_creator,
             &initial_rate_control_result_init_data,
-            NULL);
+            NULL,
+            use_lock_free_queues(enc_handle_ptr));
     }
 
     // Picture Demux Results
@@ -2314,7 +2771,8 @@ EB_API EbErrorType svt_av1_enc_init(EbComponentType *svt_enc_component)
             EB_PictureManagerProcessInitCount,
             svt_aom_picture_results_creator,
             &picture_result_init_data,
-            NULL);
+            NULL,
+            use_lock_free_queues(enc_handle_ptr));
 
     }
 
@@ -2330,7 +2788,8 @@ EB_API EbErrorType svt_av1_enc_init(EbComponentType *svt_enc_component)
             enc_handle_ptr->scs_instance_array[0]->scs->tpl_disp_process_init_count,
             tpl_disp_results_creator,
             &tpl_disp_result_init_data,
-            NULL);
+            NULL,
+            use_lock_free_queues(enc_handle_ptr));
     }
 
     // Rate Control Tasks
@@ -2345,9 +2804,20 @@ EB_API EbErrorType svt_av1_enc_init(EbComponentType *svt_enc_component)
             EB_RateControlProcessInitCount,
             svt_aom_rate_control_tasks_creator,
             &rate_control_tasks_init_data,
-            NULL);
+            NULL,
+            use_lock_free_queues(enc_handle_ptr));
     }
 
+    // Rate Control SB QP derivation workers
+    if (enc_handle_ptr->scs_instance_array[0]->scs->rate_control_sb_process_init_count)
+        EB_NEW(
+            enc_handle_ptr->rate_control_sb_workers,
+            svt_aom_segment_workers_ctor,
+            "rate_control_sb",
+            enc_handle_ptr->scs_instance_array[0]->scs->rate_control_sb_process_init_count,
+            EB_RateControlProcessInitCount,
+            use_lock_free_queues(enc_handle_ptr));
+
     // Rate Control Results
     {
         RateControlResultsInitData rate_control_result_init_data;
@@ -2360,7 +2830,8 @@ EB_API EbErrorType svt_av1_enc_init(EbComponentType *svt_enc_component)
             enc_handle_ptr->scs_instance_array[0]->scs->mode_decision_configuration_process_init_count,
             svt_aom_rate_control_results_creator,
             &rate_control_result_init_data,
-            NULL);
+            NULL,
+            use_lock_free_queues(enc_handle_ptr));
     }
     // EncDec Tasks
     {
@@ -2383,7 +2854,8 @@ EB_API EbErrorType svt_av1_enc_init(EbComponentType *svt_enc_component)
             enc_handle_ptr->scs_instance_array[0]->scs->enc_dec_process_init_count,
             svt_aom_enc_dec_tasks_creator,
             &mode_decision_result_init_data,
-            NULL);
+            NULL,
+            use_lock_free_queues(enc_handle_ptr));
     }
 
     // EncDec Results
@@ -2398,7 +2870,8 @@ EB_API EbErrorType svt_av1_enc_init(EbComponentType *svt_enc_component)
             enc_handle_ptr->scs_instance_array[0]->scs->dlf_process_init_count,
             svt_aom_enc_dec_results_creator,
             &enc_dec_result_init_data,
-            NULL);
+            NULL,
+            use_lock_free_queues(enc_handle_ptr));
     }
 
     //DLF results
@@ -2413,7 +2886,8 @@ EB_API EbErrorType svt_av1_enc_init(EbComponentType *svt_enc_component)
             enc_handle_ptr->scs_instance_array[0]->scs->cdef_process_init_count,
             dlf_results_creator,
             &delf_result_init_data,
-            NULL);
+            NULL,
+            use_lock_free_queues(enc_handle_ptr));
     }
     //CDEF results
     {
@@ -2427,8 +2901,27 @@ EB_API EbErrorType svt_av1_enc_init(EbComponentType *svt_enc_component)
             enc_handle_ptr->scs_instance_array[0]->scs->rest_process_init_count,
             cdef_results_creator,
             &cdef_result_init_data,
-            NULL);
+            NULL,
+            use_lock_free_queues(enc_handle_ptr));
     }
+    //CDEF strength search workers
+    if (enc_handle_ptr->scs_instance_array[0]->scs->cdef_search_process_init_count)
+        EB_NEW(
+            enc_handle_ptr->cdef_search_workers,
+            svt_aom_segment_workers_ctor,
+            "cdef_search",
+            enc_handle_ptr->scs_instance_array[0]->scs->cdef_search_process_init_count,
+            enc_handle_ptr->scs_instance_array[0]->scs->cdef_process_init_count,
+            use_lock_free_queues(enc_handle_ptr));
+    //Film grain denoise workers
+    if (enc_handle_ptr->scs_instance_array[0]->scs->denoise_process_init_count)
+        EB_NEW(
+            enc_handle_ptr->denoise_workers,
+            svt_aom_segment_workers_ctor,
+            "denoise",
+            enc_handle_ptr->scs_instance_array[0]->scs->denoise_process_init_count,
+            enc_handle_ptr->scs_instance_array[0]->scs->picture_analysis_process_init_count,
+            use_lock_free_queues(enc_handle_ptr));
     //REST results
     {
         EntropyCodingResultsInitData rest_result_init_data;
@@ -2441,7 +2934,8 @@ EB_API EbErrorType svt_av1_enc_init(EbComponentType *svt_enc_component)
             enc_handle_ptr->scs_instance_array[0]->scs->entropy_coding_process_init_count,
             rest_results_creator,
             &rest_result_init_data,
-            NULL);
+            NULL,
+            use_lock_free_queues(enc_handle_ptr));
     }
 
     // Entropy Coding Results
@@ -2456,7 +2950,8 @@ EB_API EbErrorType svt_av1_enc_init(EbComponentType *svt_enc_component)
             EB_PacketizationProcessInitCount,
             svt_aom_entropy_coding_results_creator,
             &entropy_coding_results_init_data,
-            NULL);
+            NULL,
+            use_lock_free_queues(enc_handle_ptr));
     }
 
 
@@ -2482,6 +2977,7 @@ EB_API EbErrorType svt_av1_enc_init(EbComponentType *svt_enc_component)
         svt_aom_resource_coordination_context_ctor,
         enc_handle_ptr);
 
+    svt_memory_account_category(SVT_AV1_MEM_LOOKAHEAD);
     // Picture Analysis Context
     EB_ALLOC_PTR_ARRAY(enc_handle_ptr->picture_analysis_context_ptr_array, enc_handle_ptr->scs_instance_array[0]->scs->picture_analysis_process_init_count);
 
@@ -2546,6 +3042,7 @@ EB_API EbErrorType svt_av1_enc_init(EbComponentType *svt_enc_component)
                 tpl_port_lookup(TPL_INPUT_PORT_TPL, process_index)
             );
         }
+        svt_memory_account_category(SVT_AV1_MEM_OTHER);
         // Picture Manager Context
         EB_NEW(
             enc_handle_ptr->picture_manager_context_ptr,
@@ -2559,6 +3056,7 @@ EB_API EbErrorType svt_av1_enc_init(EbComponentType *svt_enc_component)
             enc_handle_ptr,
             EB_PictureDecisionProcessInitCount);  // me_port_index
 
+        svt_memory_account_category(SVT_AV1_MEM_MODE_DECISION);
         // Mode Decision Configuration Contexts
         {
             // Mode Decision Configuration Contexts
@@ -2584,6 +3082,7 @@ EB_API EbErrorType svt_av1_enc_init(EbComponentType *svt_enc_component)
                 enc_dec_port_lookup(ENCDEC_INPUT_PORT_ENCDEC, process_index));
         }
 
+        svt_memory_account_category(SVT_AV1_MEM_OTHER);
         // Dlf Contexts
         EB_ALLOC_PTR_ARRAY(enc_handle_ptr->dlf_context_ptr_array, enc_handle_ptr->scs_instance_array[0]->scs->dlf_process_init_count);
 
@@ -2653,76 +3152,38 @@ EB_API EbErrorType svt_av1_enc_init(EbComponentType *svt_enc_component)
 
     control_set_ptr = enc_handle_ptr->scs_instance_array[0]->scs;
 
-    // Resource Coordination
-    EB_CREATE_THREAD(enc_handle_ptr->resource_coordination_thread_handle, svt_aom_resource_coordination_kernel, enc_handle_ptr->resource_coordination_context_ptr);
-    EB_CREATE_THREAD_ARRAY(enc_handle_ptr->picture_analysis_thread_handle_array,control_set_ptr->picture_analysis_process_init_count,
-        svt_aom_picture_analysis_kernel,
-        enc_handle_ptr->picture_analysis_context_ptr_array);
-
-    // Picture Decision
-    EB_CREATE_THREAD(enc_handle_ptr->picture_decision_thread_handle, svt_aom_picture_decision_kernel, enc_handle_ptr->picture_decision_context_ptr);
-
-    // Motion Estimation
-    EB_CREATE_THREAD_ARRAY(enc_handle_ptr->motion_estimation_thread_handle_array, control_set_ptr->motion_estimation_process_init_count,
-        svt_aom_motion_estimation_kernel,
-        enc_handle_ptr->motion_estimation_context_ptr_array);
-
-        // Initial Rate Control
-        EB_CREATE_THREAD(enc_handle_ptr->initial_rate_control_thread_handle, svt_aom_initial_rate_control_kernel, enc_handle_ptr->initial_rate_control_context_ptr);
-
-        // Source Based Oprations
-        EB_CREATE_THREAD_ARRAY(enc_handle_ptr->source_based_operations_thread_handle_array, control_set_ptr->source_based_operations_process_init_count,
-            svt_aom_source_based_operations_kernel,
-            enc_handle_ptr->source_based_operations_context_ptr_array);
-
-        // TPL dispenser
-        EB_CREATE_THREAD_ARRAY(enc_handle_ptr->tpl_disp_thread_handle_array, control_set_ptr->tpl_disp_process_init_count,
-            svt_aom_tpl_disp_kernel,//TODOOMK
-            enc_handle_ptr->tpl_disp_context_ptr_array);
-        // Picture Manager
-        EB_CREATE_THREAD(enc_handle_ptr->picture_manager_thread_handle, svt_aom_picture_manager_kernel, enc_handle_ptr->picture_manager_context_ptr);
-        // Rate Control
-        EB_CREATE_THREAD(enc_handle_ptr->rate_control_thread_handle, svt_aom_rate_control_kernel, enc_handle_ptr->rate_control_context_ptr);
-
-        // Mode Decision Configuration Process
-        EB_CREATE_THREAD_ARRAY(enc_handle_ptr->mode_decision_configuration_thread_handle_array, control_set_ptr->mode_decision_configuration_process_init_count,
-            svt_aom_mode_decision_configuration_kernel,
-            enc_handle_ptr->mode_decision_configuration_context_ptr_array);
-
-
-        // EncDec Process
-        EB_CREATE_THREAD_ARRAY(enc_handle_ptr->enc_dec_thread_handle_array, control_set_ptr->enc_dec_process_init_count,
-            svt_aom_mode_decision_kernel,
-            enc_handle_ptr->enc_dec_context_ptr_array);
-
-        // Dlf Process
-        EB_CREATE_THREAD_ARRAY(enc_handle_ptr->dlf_thread_handle_array, control_set_ptr->dlf_process_init_count,
-            svt_aom_dlf_kernel,
-            enc_handle_ptr->dlf_context_ptr_array);
-
-        // Cdef Process
-        EB_CREATE_THREAD_ARRAY(enc_handle_ptr->cdef_thread_handle_array, control_set_ptr->cdef_process_init_count,
-            svt_aom_cdef_kernel,
-            enc_handle_ptr->cdef_context_ptr_array);
-
-        // Rest Process
-        EB_CREATE_THREAD_ARRAY(enc_handle_ptr->rest_thread_handle_array, control_set_ptr->rest_process_init_count,
-            svt_aom_rest_kernel,
-            enc_handle_ptr->rest_context_ptr_array);
-
-        // Entropy Coding Process
-        EB_CREATE_THREAD_ARRAY(enc_handle_ptr->entropy_coding_thread_handle_array, control_set_ptr->entropy_coding_process_init_count,
-            svt_aom_entropy_coding_kernel,
-            enc_handle_ptr->entropy_coding_context_ptr_array);
+    // All the pipeline threads created below share the cores of the pool
+    if (config_ptr->core_pool) {
+        enc_handle_ptr->core_pool = svt_core_pool_create(control_set_ptr->core_pool_size);
+        if (enc_handle_ptr->core_pool == NULL)
+            return EB_ErrorInsufficientResources;
+        svt_core_pool_attach_new_threads(enc_handle_ptr->core_pool);
+    }
 
-    // Packetization
-    EB_CREATE_THREAD(enc_handle_ptr->packetization_thread_handle, svt_aom_packetization_kernel, enc_handle_ptr->packetization_context_ptr);
+    return_error = create_pipeline_threads(enc_handle_ptr);
+    // Detach before checking so a failed init does not leave the calling thread attached
+    svt_core_pool_attach_new_threads(NULL);
+    if (return_error != EB_ErrorNone)
+        return return_error;
 
     svt_print_memory_usage();
+    print_memory_usage(&enc_handle_ptr->memory_account);
 
     return return_error;
 }
 
+EB_API EbErrorType svt_av1_enc_init(EbComponentType *svt_enc_component)
+{
+    if(svt_enc_component == NULL)
+        return EB_ErrorBadParameter;
+    EbEncHandle *enc_handle_ptr = (EbEncHandle*)svt_enc_component->p_component_private;
+    // everything allocated on this thread until the pipeline is up is accounted to the encoder
+    svt_memory_account_bind(&enc_handle_ptr->memory_account, SVT_AV1_MEM_OTHER);
+    EbErrorType return_error = enc_init(enc_handle_ptr);
+    svt_memory_account_bind(NULL, SVT_AV1_MEM_OTHER);
+    return return_error;
+}
+
 static EbErrorType enc_drain_queue(EbComponentType *svt_enc_component) {
     bool eos = false;
     do {
@@ -2745,6 +3206,8 @@ static EbErrorType enc_drain_queue(EbComponentType *svt_enc_component) {
 /**********************************
 * DeInitialize Encoder Library
 **********************************/
+static void release_borrowed_inputs(EbEncHandle *enc_handle_ptr);
+
 EB_API EbErrorType svt_av1_enc_deinit(EbComponentType *svt_enc_component) {
     if (!svt_enc_component || !svt_enc_component->p_component_private)
         return EB_ErrorBadParameter;
@@ -2760,10 +3223,18 @@ EB_API EbErrorType svt_av1_enc_deinit(EbComponentType *svt_enc_component) {
         EbErrorType return_error = enc_drain_queue(svt_enc_component);
         if (return_error != EB_ErrorNone)
             return return_error;
+
+        const SvtAv1MeCacheStats *me_cache = &handle->scs_instance_array[0]->enc_ctx->me_cache_stats;
+        if (me_cache->hits + me_cache->misses)
+            SVT_INFO("superres ME cache: %llu hits, %llu misses, %llu KB peak\n",
+                     (unsigned long long)me_cache->hits,
+                     (unsigned long long)me_cache->misses,
+                     (unsigned long long)(me_cache->peak_bytes >> 10));
     }
     #ifdef MINIMAL_BUILD
     svt_aom_free(svt_aom_blk_geom_mds);
     #endif
+    release_borrowed_inputs(handle);
     svt_shutdown_process(handle->input_buffer_resource_ptr);
     svt_shutdown_process(handle->input_cmd_resource_ptr);
     svt_shutdown_process(handle->resource_coordination_results_resource_ptr);
@@ -2774,12 +3245,15 @@ EB_API EbErrorType svt_av1_enc_deinit(EbComponentType *svt_enc_component) {
     svt_shutdown_process(handle->picture_demux_results_resource_ptr);
     svt_shutdown_process(handle->tpl_disp_res_srm);
     svt_shutdown_process(handle->rate_control_tasks_resource_ptr);
+    svt_aom_segment_workers_shutdown(handle->rate_control_sb_workers);
     svt_shutdown_process(handle->rate_control_results_resource_ptr);
     svt_shutdown_process(handle->enc_dec_tasks_resource_ptr);
     svt_shutdown_process(handle->enc_dec_results_resource_ptr);
     svt_shutdown_process(handle->entropy_coding_results_resource_ptr);
     svt_shutdown_process(handle->dlf_results_resource_ptr);
     svt_shutdown_process(handle->cdef_results_resource_ptr);
+    svt_aom_segment_workers_shutdown(handle->cdef_search_workers);
+    svt_aom_segment_workers_shutdown(handle->denoise_workers);
     svt_shutdown_process(handle->rest_results_resource_ptr);
 
     return EB_ErrorNone;
@@ -2826,6 +3300,7 @@ EB_API EbErrorType svt_av1_enc_init_handle(
         return return_error;
     }
     svt_increase_component_count();
+    svt_trace_init();
     return return_error;
 }
 
@@ -2860,6 +3335,7 @@ EB_API EbErrorType svt_av1_enc_deinit_handle(
         EB_FREE(lp_group);
 #endif
         svt_decrease_component_count();
+        svt_trace_deinit();
         return return_error;
     }
     return EB_ErrorInvalidComponent;
@@ -5038,6 +5514,10 @@ static void copy_api_from_app(
     // Psy rd
     scs->static_config.psy_rd = config_struct->psy_rd;
 
+    // Shared core pool
+    scs->static_config.core_pool = config_struct->core_pool;
+    scs->static_config.max_memory_mb = config_struct->max_memory_mb;
+
     // Override settings for Still Picture tune
     if (scs->static_config.tune == 4) {
         SVT_WARN("Tune 4: Still Picture is experimental, expect frequent changes that may modify present behavior.\n");
@@ -5084,17 +5564,26 @@ EB_API EbErrorType svt_av1_enc_set_parameter(
     if (return_error == EB_ErrorBadParameter)
         return EB_ErrorBadParameter;
 
+    const EbSvtAv1EncConfiguration requested = enc_handle->scs_instance_array[instance_index]->scs->static_config;
     set_param_based_on_input(
         enc_handle->scs_instance_array[instance_index]->scs);
     // Initialize the Prediction Structure Group
+    svt_memory_account_bind(&enc_handle->memory_account, SVT_AV1_MEM_OTHER);
     EB_NO_THROW_NEW(
         enc_handle->scs_instance_array[instance_index]->enc_ctx->prediction_structure_group_ptr,
         svt_aom_prediction_structure_group_ctor);
+    svt_memory_account_bind(NULL, SVT_AV1_MEM_OTHER);
     if (!enc_handle->scs_instance_array[instance_index]->enc_ctx->prediction_structure_group_ptr) {
         return EB_ErrorInsufficientResources;
     }
-    return_error = load_default_buffer_configuration_settings(
-        enc_handle->scs_instance_array[instance_index]->scs);
+    SequenceControlSet *scs = enc_handle->scs_instance_array[instance_index]->scs;
+    return_error = load_default_buffer_configuration_settings(scs, !scs->static_config.max_memory_mb);
+    if (return_error == EB_ErrorNone && scs->static_config.max_memory_mb) {
+        EbMemoryModel model;
+        return_error = memory_model_init(scs, &model);
+        if (return_error == EB_ErrorNone)
+            return_error = fit_memory_budget(scs, &requested, &model, TRUE);
+    }
 
     svt_av1_print_lib_params(
         enc_handle->scs_instance_array[instance_index]->scs);
@@ -5107,6 +5596,38 @@ EB_API EbErrorType svt_av1_enc_set_parameter(
 
     return return_error;
 }
+/**********************************
+* Estimate Memory
+**********************************/
+EB_API EbErrorType svt_av1_enc_estimate_memory(
+    const EbSvtAv1EncConfiguration *config_struct,
+    SvtAv1MemoryUsage              *usage)
+{
+    if (!config_struct || !usage)
+        return EB_ErrorBadParameter;
+    memset(usage, 0, sizeof(*usage));
+    // copy_api_from_app() adjusts the configuration it reads
+    EbSvtAv1EncConfiguration      config = *config_struct;
+    EbSequenceControlSetInstance *instance;
+    EB_NEW(instance, svt_sequence_control_set_instance_ctor);
+    SequenceControlSet *scs = instance->scs;
+    copy_api_from_app(scs, &config);
+    EbErrorType return_error = svt_av1_verify_settings(scs);
+    const EbSvtAv1EncConfiguration requested = scs->static_config;
+    if (return_error == EB_ErrorNone) {
+        set_param_based_on_input(scs);
+        return_error = load_default_buffer_configuration_settings(scs, FALSE);
+    }
+    EbMemoryModel model;
+    if (return_error == EB_ErrorNone)
+        return_error = memory_model_init(scs, &model);
+    if (return_error == EB_ErrorNone && scs->static_config.max_memory_mb)
+        return_error = fit_memory_budget(scs, &requested, &model, FALSE);
+    if (return_error == EB_ErrorNone)
+        memory_estimate(scs, &model, usage);
+    EB_DELETE(instance);
+    return return_error;
+}
 EB_API EbErrorType svt_av1_enc_stream_header(
     EbComponentType           *svt_enc_component,
     EbBufferHeaderType        **output_stream_ptr)
@@ -5410,6 +5931,9 @@ static EbErrorType copy_frame_buffer(
 
         uint8_t *src = input_ptr->luma;
         uint8_t *dst = y8b_input_picture_ptr->buffer_y + luma_buffer_offset;
+        // zero-copy input: the planes already are the library buffers
+        if (src == dst)
+            return return_error;
         for (unsigned i = 0; i < luma_height; i++) {
             svt_memcpy(dst, src, luma_width);
             src += source_luma_stride;
@@ -5845,6 +6369,145 @@ static EbErrorType validate_on_the_fly_settings(EbBufferHeaderType *input_ptr, S
 /**********************************
 * Empty This Buffer
 **********************************/
+/* Input picture borrowed through svt_av1_enc_get_input_buffer(), hdr has to stay the first member */
+typedef struct EbZeroCopyInput {
+    EbBufferHeaderType   hdr;
+    EbSvtIOFormat        io;
+    EbObjectWrapper     *y8b_wrapper;
+    EbObjectWrapper     *input_wrapper;
+    EbEncHandle         *enc_handle;
+    EbReleaseFrameBuffer release_cb;
+    void                *release_private;
+    uint32_t             frame_size;
+    uint32_t             pending; // wrappers not yet back in their pool
+    struct EbZeroCopyInput *next; // next borrowed picture not sent yet
+} EbZeroCopyInput;
+
+/* Called once for each of the two wrappers, the caller is notified when both went back to their pool */
+static void zero_copy_input_release(void *ctx) {
+    EbZeroCopyInput *zc = (EbZeroCopyInput *)ctx;
+
+    svt_block_on_mutex(zc->enc_handle->zero_copy_mutex);
+    const bool done = --zc->pending == 0;
+    svt_release_mutex(zc->enc_handle->zero_copy_mutex);
+    if (!done)
+        return;
+    if (zc->release_cb) {
+        EbExtFrameBuf frame_buf = {zc->io.luma, zc->frame_size, zc->release_private};
+        zc->release_cb(&frame_buf, zc->release_private);
+    }
+    EB_FREE(zc);
+}
+
+/**********************************
+* Zero-copy input
+**********************************/
+EB_API EbErrorType svt_av1_enc_set_input_release_cb(
+    EbComponentType      *svt_enc_component,
+    EbReleaseFrameBuffer  release_cb,
+    void                 *private_data)
+{
+    if (svt_enc_component == NULL || svt_enc_component->p_component_private == NULL)
+        return EB_ErrorBadParameter;
+    EbEncHandle *enc_handle_ptr = (EbEncHandle*)svt_enc_component->p_component_private;
+    enc_handle_ptr->input_release_cb = release_cb;
+    enc_handle_ptr->input_release_private = private_data;
+    return EB_ErrorNone;
+}
+
+EB_API EbErrorType svt_av1_enc_get_input_buffer(
+    EbComponentType      *svt_enc_component,
+    EbBufferHeaderType  **p_buffer)
+{
+    if (svt_enc_component == NULL || p_buffer == NULL)
+        return EB_ErrorBadParameter;
+    EbEncHandle              *enc_handle_ptr = (EbEncHandle*)svt_enc_component->p_component_private;
+    SequenceControlSet       *scs = enc_handle_ptr->scs_instance_array[0]->scs;
+    EbSvtAv1EncConfiguration *config = &scs->static_config;
+
+    *p_buffer = NULL;
+    if (config->encoder_bit_depth > EB_EIGHT_BIT || scs->first_pass_ctrls.ds) {
+        SVT_ERROR("Zero-copy input is only supported for 8-bit input outside of the first pass\n");
+        return EB_ErrorBadParameter;
+    }
+    EbZeroCopyInput *zc;
+    EB_CALLOC(zc, 1, sizeof(*zc));
+
+    // same pool buffers as svt_av1_enc_send_picture(), held until the end of the encode
+    svt_get_empty_object(enc_handle_ptr->input_y8b_buffer_producer_fifo_ptr, &zc->y8b_wrapper);
+    if (buffer_update_needed((EbBufferHeaderType*)zc->y8b_wrapper->object_ptr, scs))
+        svt_input_y8b_update((EbBufferHeaderType*)zc->y8b_wrapper->object_ptr, scs);
+    svt_object_inc_live_count(zc->y8b_wrapper, 1);
+    svt_get_empty_object(enc_handle_ptr->input_buffer_producer_fifo_ptr, &zc->input_wrapper);
+    if (buffer_update_needed((EbBufferHeaderType*)zc->input_wrapper->object_ptr, scs))
+        svt_input_buffer_header_update((EbBufferHeaderType*)zc->input_wrapper->object_ptr, scs, TRUE);
+    svt_object_inc_live_count(zc->input_wrapper, 1);
+
+    // planes at the same place copy_frame_buffer() would write them
+    EbPictureBufferDesc *y8b_pic = (EbPictureBufferDesc*)((EbBufferHeaderType*)zc->y8b_wrapper->object_ptr)->p_buffer;
+    EbPictureBufferDesc *input_pic = (EbPictureBufferDesc*)((EbBufferHeaderType*)zc->input_wrapper->object_ptr)->p_buffer;
+    const uint8_t subsampling_x = (config->encoder_color_format == EB_YUV444 ? 1 : 2) - 1;
+    const uint8_t subsampling_y = ((config->encoder_color_format == EB_YUV444 || config->encoder_color_format == EB_YUV422) ? 1 : 2) - 1;
+    const uint32_t luma_width = input_pic->width - scs->max_input_pad_right;
+    const uint32_t luma_height = input_pic->height - scs->max_input_pad_bottom;
+    const uint32_t chroma_width = (luma_width + subsampling_x) >> subsampling_x;
+    const uint32_t chroma_height = (luma_height + subsampling_y) >> subsampling_y;
+
+    zc->io.luma = y8b_pic->buffer_y + input_pic->stride_y * scs->top_padding + scs->left_padding;
+    zc->io.cb = input_pic->buffer_cb + input_pic->stride_cb * (scs->top_padding >> 1) + (scs->left_padding >> 1);
+    zc->io.cr = input_pic->buffer_cr + input_pic->stride_cr * (scs->top_padding >> 1) + (scs->left_padding >> 1);
+    zc->io.y_stride = input_pic->stride_y;
+    zc->io.cb_stride = input_pic->stride_cb;
+    zc->io.cr_stride = input_pic->stride_cr;
+    zc->io.width = luma_width;
+    zc->io.height = luma_height;
+    zc->io.color_fmt = (EbColorFormat)config->encoder_color_format;
+    zc->io.bit_depth = EB_EIGHT_BIT;
+    zc->frame_size = luma_width * luma_height + 2 * chroma_width * chroma_height;
+    zc->enc_handle = enc_handle_ptr;
+
+    zc->hdr.size = sizeof(EbBufferHeaderType);
+    zc->hdr.p_buffer = (uint8_t*)&zc->io;
+    zc->hdr.n_alloc_len = zc->frame_size;
+    zc->hdr.n_filled_len = zc->frame_size;
+    zc->hdr.pic_type = EB_AV1_INVALID_PICTURE;
+
+    svt_block_on_mutex(enc_handle_ptr->zero_copy_mutex);
+    zc->next = enc_handle_ptr->borrowed_inputs;
+    enc_handle_ptr->borrowed_inputs = zc;
+    svt_release_mutex(enc_handle_ptr->zero_copy_mutex);
+    *p_buffer = &zc->hdr;
+    return EB_ErrorNone;
+}
+
+/* Removes hdr from the borrowed pictures, returns NULL if it was not borrowed through
+ * svt_av1_enc_get_input_buffer() */
+static EbZeroCopyInput *take_borrowed_input(EbEncHandle *enc_handle_ptr, EbBufferHeaderType *hdr) {
+    EbZeroCopyInput *zc = NULL;
+    svt_block_on_mutex(enc_handle_ptr->zero_copy_mutex);
+    for (EbZeroCopyInput **it = &enc_handle_ptr->borrowed_inputs; *it; it = &(*it)->next) {
+        if (&(*it)->hdr == hdr) {
+            zc = *it;
+            *it = zc->next;
+            zc->next = NULL;
+            break;
+        }
+    }
+    svt_release_mutex(enc_handle_ptr->zero_copy_mutex);
+    return zc;
+}
+
+/* Gives the buffers of the pictures borrowed but never sent back to their pools */
+static void release_borrowed_inputs(EbEncHandle *enc_handle_ptr) {
+    while (enc_handle_ptr->borrowed_inputs) {
+        EbZeroCopyInput *zc = enc_handle_ptr->borrowed_inputs;
+        enc_handle_ptr->borrowed_inputs = zc->next;
+        svt_release_object(zc->y8b_wrapper);
+        svt_release_object(zc->input_wrapper);
+        EB_FREE(zc);
+    }
+}
+
 EB_API EbErrorType svt_av1_enc_send_picture(
     EbComponentType      *svt_enc_component,
     EbBufferHeaderType   *p_buffer)
@@ -5864,34 +6527,51 @@ EB_API EbErrorType svt_av1_enc_send_picture(
         SVT_ERROR("Invalid API input buffer size detected. Please ignore the output stream\n");
     }
 
-    // Get new Luma-8b buffer & a new (Chroma-8b + Luma-Chroma-2bit) buffers; Lib will release once done.
     EbObjectWrapper  *y8b_wrapper;
-    svt_get_empty_object(
-        enc_handle_ptr->input_y8b_buffer_producer_fifo_ptr,
-        &y8b_wrapper);
-    // Update the input picture definitions: resolution of the sequence
-    if(validate_on_the_fly_settings(p_buffer, enc_handle_ptr->scs_instance_array[0]->scs, enc_handle_ptr->scs_instance_array[0]->config_mutex)){
-        return_val = EB_ErrorBadParameter;
-        enc_handle_ptr->eos_received = 1;
+    // A borrowed picture already holds its buffers (see svt_av1_enc_get_input_buffer())
+    EbZeroCopyInput *zc = p_buffer ? take_borrowed_input(enc_handle_ptr, p_buffer) : NULL;
+    if (zc) {
+        if (validate_on_the_fly_settings(p_buffer, enc_handle_ptr->scs_instance_array[0]->scs, enc_handle_ptr->scs_instance_array[0]->config_mutex) ||
+            buffer_update_needed((EbBufferHeaderType*)zc->input_wrapper->object_ptr, enc_handle_ptr->scs_instance_array[0]->scs)) {
+            SVT_ERROR("Resolution change on the fly is not supported with zero-copy input\n");
+            return_val = EB_ErrorBadParameter;
+            enc_handle_ptr->eos_received = 1;
+        }
+        y8b_wrapper = zc->y8b_wrapper;
+        eb_wrapper_ptr = zc->input_wrapper;
+        zc->release_cb = enc_handle_ptr->input_release_cb;
+        zc->release_private = enc_handle_ptr->input_release_private;
+        zc->pending = 2;
+        y8b_wrapper->release_cb = eb_wrapper_ptr->release_cb = zero_copy_input_release;
+        y8b_wrapper->release_ctx = eb_wrapper_ptr->release_ctx = zc;
     }
-    // if resolution has changed, and the y8b_wrapper settings do not match scs settings, update y8b_wrapper settings
-    if (buffer_update_needed((EbBufferHeaderType*)y8b_wrapper->object_ptr, enc_handle_ptr->scs_instance_array[0]->scs))
-        svt_input_y8b_update((EbBufferHeaderType*)y8b_wrapper->object_ptr, enc_handle_ptr->scs_instance_array[0]->scs);
-    //set live count to 1 to be decremented at the end of the encode in RC
-    svt_object_inc_live_count(y8b_wrapper, 1);
-
-   // svt_object_inc_live_count(y8b_wrapper, 1);
-
-    svt_get_empty_object(
-        enc_handle_ptr->input_buffer_producer_fifo_ptr,
-        &eb_wrapper_ptr);
-    // if resolution has changed, and the input_buffer settings do not match scs settings, update input_buffer settings
-    if (buffer_update_needed((EbBufferHeaderType*)eb_wrapper_ptr->object_ptr, enc_handle_ptr->scs_instance_array[0]->scs))
-        svt_input_buffer_header_update((EbBufferHeaderType*)eb_wrapper_ptr->object_ptr, enc_handle_ptr->scs_instance_array[0]->scs, TRUE);
+    else {
+        // Get new Luma-8b buffer & a new (Chroma-8b + Luma-Chroma-2bit) buffers; Lib will release once done.
+        svt_get_empty_object(
+            enc_handle_ptr->input_y8b_buffer_producer_fifo_ptr,
+            &y8b_wrapper);
+        // Update the input picture definitions: resolution of the sequence
+        if(validate_on_the_fly_settings(p_buffer, enc_handle_ptr->scs_instance_array[0]->scs, enc_handle_ptr->scs_instance_array[0]->config_mutex)){
+            return_val = EB_ErrorBadParameter;
+            enc_handle_ptr->eos_received = 1;
+        }
+        // if resolution has changed, and the y8b_wrapper settings do not match scs settings, update y8b_wrapper settings
+        if (buffer_update_needed((EbBufferHeaderType*)y8b_wrapper->object_ptr, enc_handle_ptr->scs_instance_array[0]->scs))
+            svt_input_y8b_update((EbBufferHeaderType*)y8b_wrapper->object_ptr, enc_handle_ptr->scs_instance_array[0]->scs);
+        //set live count to 1 to be decremented at the end of the encode in RC
+        svt_object_inc_live_count(y8b_wrapper, 1);
+
+        svt_get_empty_object(
+            enc_handle_ptr->input_buffer_producer_fifo_ptr,
+            &eb_wrapper_ptr);
+        // if resolution has changed, and the input_buffer settings do not match scs settings, update input_buffer settings
+        if (buffer_update_needed((EbBufferHeaderType*)eb_wrapper_ptr->object_ptr, enc_handle_ptr->scs_instance_array[0]->scs))
+            svt_input_buffer_header_update((EbBufferHeaderType*)eb_wrapper_ptr->object_ptr, enc_handle_ptr->scs_instance_array[0]->scs, TRUE);
 
-     //set live count to 1 to be decremented at the end of the encode in RC, and released
-     //this would also allow low delay TF to retain pictures
-     svt_object_inc_live_count(eb_wrapper_ptr, 1);
+        //set live count to 1 to be decremented at the end of the encode in RC, and released
+        //this would also allow low delay TF to retain pictures
+        svt_object_inc_live_count(eb_wrapper_ptr, 1);
+    }
 
     if (p_buffer != NULL) {
         enc_handle_ptr->eos_received += p_buffer->flags & EB_BUFFERFLAG_EOS;
@@ -6461,10 +7141,26 @@ EB_API EbErrorType svt_av1_enc_get_stream_info(EbComponentType *    svt_enc_comp
     if (stream_info_id == SVT_AV1_STREAM_INFO_FIRST_PASS_STATS_OUT) {
         EncodeContext*      context = enc_handle->scs_instance_array[0]->enc_ctx;
         SvtAv1FixedBuf*     first_pass_stats = (SvtAv1FixedBuf*)info;
+        // the records handed out as chunks are gone
+        if (context->stats_out.header_out)
+            return EB_ErrorBadParameter;
         first_pass_stats->buf = context->stats_out.stat;
         first_pass_stats->sz = context->stats_out.size * sizeof(FIRSTPASS_STATS);
         return EB_ErrorNone;
     }
+    if (stream_info_id == SVT_AV1_STREAM_INFO_FIRST_PASS_STATS_CHUNK)
+        return svt_av1_first_pass_stats_chunk(enc_handle->scs_instance_array[0]->scs, (SvtAv1FixedBuf*)info);
+    if (stream_info_id == SVT_AV1_STREAM_INFO_MEMORY_USAGE) {
+        svt_memory_account_usage(&enc_handle->memory_account, (SvtAv1MemoryUsage*)info);
+        return EB_ErrorNone;
+    }
+    if (stream_info_id == SVT_AV1_STREAM_INFO_ME_CACHE_STATS) {
+        EncodeContext *context = enc_handle->scs_instance_array[0]->enc_ctx;
+        svt_block_on_mutex(context->me_cache_mutex);
+        *(SvtAv1MeCacheStats*)info = context->me_cache_stats;
+        svt_release_mutex(context->me_cache_mutex);
+        return EB_ErrorNone;
+    }
     return EB_ErrorBadParameter;
 }
 // clang-format on
@@ -17,7 +17,10 @@
 #include "pic_buffer_desc.h"
 #include "sys_resource_manager.h"
 #include "sequence_control_set.h"
+#include "svt_threads.h"
 #include "object.h"
+#include "svt_malloc.h"
+#include "segment_workers.h"
 
 struct _EbThreadContext {
     EbDctor dctor;
@@ -117,6 +120,11 @@ struct _EbEncHandle {
     EbSystemResource  *cdef_results_resource_ptr;
     EbSystemResource  *rest_results_resource_ptr;
 
+    // Segment workers of the stages splitting their work in bands, NULL when the stage runs single threaded
+    SegmentWorkers *rate_control_sb_workers;
+    SegmentWorkers *cdef_search_workers;
+    SegmentWorkers *denoise_workers;
+
     // Callbacks
     EbCallback **app_callback_ptr_array;
 
@@ -130,6 +138,16 @@ struct _EbEncHandle {
     bool eos_sent; // used to signal we sent the EOS to the app
     bool frame_received; // used to signal we received any frame from the app
     bool is_prev_valid; // whether the previous input is valid or not
+
+    // Zero-copy input, see svt_av1_enc_get_input_buffer()
+    EbReleaseFrameBuffer input_release_cb;
+    void                *input_release_private;
+    EbHandle             zero_copy_mutex; // protects EbZeroCopyInput::pending and borrowed_inputs
+    struct EbZeroCopyInput *borrowed_inputs; // borrowed pictures not sent yet
+
+    SvtCorePool *core_pool; // cores shared by the pipeline threads, NULL unless core_pool is set
+
+    EbMemoryAccount memory_account; // allocations made while setting up the encoder
 };
 void set_segments_numbers(SequenceControlSet *scs);
 #endif // EbEncHandle_h
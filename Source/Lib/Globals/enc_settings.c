@@ -282,6 +282,12 @@ EbErrorType svt_av1_verify_settings(SequenceControlSet *scs) {
         SVT_ERROR("Instance %u: Only rate control mode 0~2 are supported for 2-pass \n", channel_number + 1);
         return_error = EB_ErrorBadParameter;
     }
+    uint64_t stats_records;
+    if (config->pass == ENC_SECOND_PASS &&
+        (!svt_av1_first_pass_stats_records(&config->rc_stats_buffer, &stats_records) || !stats_records)) {
+        SVT_ERROR("Instance %u: The first pass stats are empty or of an unsupported version\n", channel_number + 1);
+        return_error = EB_ErrorBadParameter;
+    }
     if (config->profile > 2) {
         SVT_ERROR("Instance %u: The maximum allowed profile value is 2 \n", channel_number + 1);
         return_error = EB_ErrorBadParameter;
@@ -939,6 +945,16 @@ EbErrorType svt_av1_verify_settings(SequenceControlSet *scs) {
         return_error = EB_ErrorBadParameter;
     }
 
+    if (config->core_pool > 1) {
+        SVT_ERROR("Instance %u: core-pool must be 0 or 1\n", channel_number + 1);
+        return_error = EB_ErrorBadParameter;
+    }
+
+    if (config->lock_free_queues > 1) {
+        SVT_ERROR("Instance %u: lock-free-queues must be 0 or 1\n", channel_number + 1);
+        return_error = EB_ErrorBadParameter;
+    }
+
     return return_error;
 }
 
@@ -1107,6 +1123,9 @@ EbErrorType svt_av1_set_default_params(EbSvtAv1EncConfiguration *config_ptr) {
     config_ptr->tf_strength                       = 1;
     config_ptr->kf_tf_strength                    = 1;
     config_ptr->noise_norm_strength               = 0;
+    config_ptr->core_pool                         = 0;
+    config_ptr->lock_free_queues                  = 0;
+    config_ptr->max_memory_mb                     = 0;
     return return_error;
 }
 
@@ -2126,6 +2145,7 @@ EB_API EbErrorType svt_av1_enc_parse_parameter(EbSvtAv1EncConfiguration *config_
         {"input-depth", &config_struct->encoder_bit_depth},
         {"forced-max-frame-width", &config_struct->forced_max_frame_width},
         {"forced-max-frame-height", &config_struct->forced_max_frame_height},
+        {"max-memory-mb", &config_struct->max_memory_mb},
     };
     const size_t uint_opts_size = sizeof(uint_opts) / sizeof(uint_opts[0]);
 
@@ -2170,6 +2190,8 @@ EB_API EbErrorType svt_av1_enc_parse_parameter(EbSvtAv1EncConfiguration *config_
         {"noise-norm-strength", &config_struct->noise_norm_strength},
         {"fast-decode", &config_struct->fast_decode},
         {"enable-tf", &config_struct->enable_tf},
+        {"core-pool", &config_struct->core_pool},
+        {"lock-free-queues", &config_struct->lock_free_queues},
     };
     const size_t uint8_opts_size = sizeof(uint8_opts) / sizeof(uint8_opts[0]);
 
@@ -20,6 +20,7 @@
  * * svt_aom_compute_cdef_dist_16bit
  * * svt_aom_copy_rect8_8bit_to_16bit
  * * svt_search_one_dual
+ * * svt_search_one_dual_tot_mse
  *
  * @author Cidana-Wenyao
  *
@@ -1165,3 +1166,127 @@ INSTANTIATE_TEST_SUITE_P(AVX512, CDEFSearchOneDualTest,
 #endif
 
 #endif  // ARCH_X86_64
+
+#ifdef ARCH_AARCH64
+INSTANTIATE_TEST_SUITE_P(NEON, CDEFSearchOneDualTest,
+                         ::testing::Values(svt_search_one_dual_neon));
+#endif  // ARCH_AARCH64
+
+/**
+ * @brief Unit test for svt_search_one_dual_tot_mse
+ *
+ * The threaded joint strength search accumulates bands of filter blocks
+ * separately and adds the band sums. Check every band against the C version,
+ * and that the sum of the bands selects the same strengths as the full search.
+ */
+using SearchOneDualTotMseFunc = void (*)(int *lev0, int *lev1, int nb_strengths,
+                                         uint64_t **mse[2], int sb_count,
+                                         int start_gi, int end_gi,
+                                         uint64_t *tot_mse);
+
+class CDEFSearchOneDualTotMseTest
+    : public ::testing::TestWithParam<SearchOneDualTotMseFunc> {
+  public:
+    CDEFSearchOneDualTotMseTest() : test_func_(GetParam()), sb_count_(100) {
+    }
+
+    void SetUp() override {
+        for (int i = 0; i < 2; i++) {
+            mse_[i] = new uint64_t *[sb_count_];
+            for (int n = 0; n < sb_count_; n++)
+                mse_[i][n] = new uint64_t[TOTAL_STRENGTHS];
+        }
+    }
+
+    void TearDown() override {
+        for (int i = 0; i < 2; i++) {
+            for (int n = 0; n < sb_count_; n++)
+                delete[] mse_[i][n];
+            delete[] mse_[i];
+        }
+    }
+
+    void RunTest() {
+        const int seg_count = 7;
+        int lev0_ref[CDEF_MAX_STRENGTHS], lev1_ref[CDEF_MAX_STRENGTHS];
+        int lev0_tst[CDEF_MAX_STRENGTHS], lev1_tst[CDEF_MAX_STRENGTHS];
+        uint64_t sum[TOTAL_STRENGTHS * TOTAL_STRENGTHS];
+        uint64_t ref[TOTAL_STRENGTHS * TOTAL_STRENGTHS];
+        uint64_t tst[TOTAL_STRENGTHS * TOTAL_STRENGTHS];
+        SVTRandom rnd(10, false);
+
+        for (int i = 0; i < 2; ++i)
+            for (int n = 0; n < sb_count_; ++n)
+                for (int j = 0; j < TOTAL_STRENGTHS; ++j)
+                    mse_[i][n][j] = rnd.random();
+        memset(lev0_ref, 0, sizeof(lev0_ref));
+        memset(lev1_ref, 0, sizeof(lev1_ref));
+
+        for (int nb = 0; nb < 4; ++nb) {
+            // the strengths already chosen are also the candidates of the steps
+            const int start_gi = nb ? TOTAL_STRENGTHS / 2 : 0;
+            const int end_gi = TOTAL_STRENGTHS;
+            memcpy(lev0_tst, lev0_ref, sizeof(lev0_ref));
+            memcpy(lev1_tst, lev1_ref, sizeof(lev1_ref));
+            memset(sum, 0, sizeof(sum));
+            for (int seg = 0; seg < seg_count; ++seg) {
+                const int sb_start = sb_count_ * seg / seg_count;
+                const int sb_end = sb_count_ * (seg + 1) / seg_count;
+                uint64_t **mse[2] = {mse_[0] + sb_start, mse_[1] + sb_start};
+                memset(ref, 0, sizeof(ref));
+                memset(tst, 0, sizeof(tst));
+                svt_search_one_dual_tot_mse_c(lev0_ref,
+                                              lev1_ref,
+                                              nb,
+                                              mse,
+                                              sb_end - sb_start,
+                                              start_gi,
+                                              end_gi,
+                                              ref);
+                test_func_(lev0_tst,
+                           lev1_tst,
+                           nb,
+                           mse,
+                           sb_end - sb_start,
+                           start_gi,
+                           end_gi,
+                           tst);
+                for (int j = start_gi; j < end_gi; ++j)
+                    for (int k = start_gi; k < end_gi; ++k) {
+                        const int idx = j * TOTAL_STRENGTHS + k;
+                        ASSERT_EQ(ref[idx], tst[idx])
+                            << "nb_strengths " << nb << " band " << seg
+                            << " pos " << j << "x" << k;
+                        sum[idx] += tst[idx];
+                    }
+            }
+            const uint64_t best_ref = svt_search_one_dual_c(
+                lev0_ref, lev1_ref, nb, mse_, sb_count_, start_gi, end_gi);
+            const uint64_t best_tst = svt_cdef_select_one_dual(
+                lev0_tst, lev1_tst, nb, sum, start_gi, end_gi);
+            ASSERT_EQ(best_ref, best_tst) << "nb_strengths " << nb;
+            ASSERT_EQ(lev0_ref[nb], lev0_tst[nb]) << "nb_strengths " << nb;
+            ASSERT_EQ(lev1_ref[nb], lev1_tst[nb]) << "nb_strengths " << nb;
+        }
+    }
+
+  private:
+    SearchOneDualTotMseFunc test_func_;
+    int sb_count_;
+    uint64_t **mse_[2];
+};
+GTEST_ALLOW_UNINSTANTIATED_PARAMETERIZED_TEST(CDEFSearchOneDualTotMseTest);
+
+TEST_P(CDEFSearchOneDualTotMseTest, test_match) {
+    RunTest();
+}
+
+#ifdef ARCH_X86_64
+INSTANTIATE_TEST_SUITE_P(AVX2, CDEFSearchOneDualTotMseTest,
+                         ::testing::Values(svt_search_one_dual_tot_mse_avx2));
+#endif  // ARCH_X86_64
+
+#ifdef ARCH_AARCH64
+INSTANTIATE_TEST_SUITE_P(NEON, CDEFSearchOneDualTotMseTest,
+                         ::testing::Values(svt_search_one_dual_tot_mse_neon));
+#endif  // ARCH_AARCH64
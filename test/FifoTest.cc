@@ -0,0 +1,221 @@
+/*
+ * Copyright (c) 2024, Alliance for Open Media. All rights reserved
+ *
+ * This source code is subject to the terms of the BSD 2 Clause License and
+ * the Alliance for Open Media Patent License 1.0. If the BSD 2 Clause License
+ * was not distributed with this source code in the LICENSE file, you can
+ * obtain it at https://www.aomedia.org/license/software-license. If the
+ * Alliance for Open Media Patent License 1.0 was not distributed with this
+ * source code in the PATENTS file, you can obtain it at
+ * https://www.aomedia.org/license/patent-license.
+ */
+#include <stdlib.h>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "sys_resource_manager.h"
+#include "svt_time.h"
+
+namespace {
+
+static EbErrorType payload_creator(EbPtr *object_dbl_ptr, EbPtr) {
+    *object_dbl_ptr = calloc(1, sizeof(uint64_t));
+    return *object_dbl_ptr ? EB_ErrorNone : EB_ErrorInsufficientResources;
+}
+
+static void payload_destroyer(EbPtr p) {
+    free(p);
+}
+
+class FifoTest : public ::testing::TestWithParam<bool> {
+  protected:
+    void TearDown() override {
+        for (EbSystemResource *resource : resources_) {
+            resource->dctor(resource);
+            free(resource);
+        }
+    }
+
+    EbSystemResource *create_resource(uint32_t object_count,
+                                      uint32_t producers, uint32_t consumers) {
+        EbSystemResource *resource =
+            (EbSystemResource *)calloc(1, sizeof(EbSystemResource));
+        EXPECT_NE(resource, nullptr);
+        EXPECT_EQ(svt_system_resource_ctor(resource,
+                                           object_count,
+                                           producers,
+                                           consumers,
+                                           payload_creator,
+                                           nullptr,
+                                           payload_destroyer,
+                                           GetParam()),
+                  EB_ErrorNone);
+        resources_.push_back(resource);
+        return resource;
+    }
+
+    std::vector<EbSystemResource *> resources_;
+};
+
+// Every posted object reaches exactly one consumer with several producers and
+// consumers contending on a small pool
+TEST_P(FifoTest, MultiProducerMultiConsumer) {
+    const uint32_t kProducers = 3;
+    const uint32_t kConsumers = 4;
+    const uint64_t kPerProducer = 20000;
+    EbSystemResource *resource = create_resource(6, kProducers, kConsumers);
+
+    std::atomic<uint64_t> received(0);
+    std::atomic<uint64_t> sum(0);
+    std::vector<std::thread> threads;
+    for (uint32_t c = 0; c < kConsumers; c++) {
+        threads.emplace_back([&, c]() {
+            EbFifo *fifo = svt_system_resource_get_consumer_fifo(resource, c);
+            for (;;) {
+                EbObjectWrapper *wrapper;
+                if (svt_get_full_object(fifo, &wrapper) ==
+                    EB_NoErrorFifoShutdown)
+                    break;
+                sum += *(uint64_t *)wrapper->object_ptr;
+                received++;
+                svt_release_object(wrapper);
+            }
+        });
+    }
+    for (uint32_t p = 0; p < kProducers; p++) {
+        threads.emplace_back([&, p]() {
+            EbFifo *fifo = svt_system_resource_get_producer_fifo(resource, p);
+            for (uint64_t i = 0; i < kPerProducer; i++) {
+                EbObjectWrapper *wrapper;
+                svt_get_empty_object(fifo, &wrapper);
+                *(uint64_t *)wrapper->object_ptr = p * kPerProducer + i + 1;
+                svt_post_full_object(wrapper);
+            }
+        });
+    }
+
+    const uint64_t total = kProducers * kPerProducer;
+    while (received.load() < total) std::this_thread::yield();
+    svt_shutdown_process(resource);
+    for (std::thread &t : threads) t.join();
+
+    EXPECT_EQ(received.load(), total);
+    EXPECT_EQ(sum.load(), total * (total + 1) / 2);
+}
+
+// Objects handed back by a consumer with a live count above one only return
+// to the empty queue on the last release
+TEST_P(FifoTest, LiveCount) {
+    EbSystemResource *resource = create_resource(1, 1, 1);
+    EbFifo *producer = svt_system_resource_get_producer_fifo(resource, 0);
+    EbFifo *consumer = svt_system_resource_get_consumer_fifo(resource, 0);
+    EbObjectWrapper *wrapper;
+    EbObjectWrapper *out;
+
+    svt_get_empty_object(producer, &wrapper);
+    svt_object_inc_live_count(wrapper, 2);
+    svt_post_full_object(wrapper);
+    svt_get_full_object_non_blocking(consumer, &out);
+    ASSERT_EQ(out, wrapper);
+    svt_get_full_object_non_blocking(consumer, &out);
+    EXPECT_EQ(out, nullptr);
+
+    svt_release_object(wrapper);
+    EXPECT_EQ(wrapper->live_count, 1u);
+    svt_release_object(wrapper);
+    EXPECT_EQ(wrapper->live_count, EB_ObjectWrapperReleasedValue);
+    svt_get_empty_object(producer, &out);
+    EXPECT_EQ(out, wrapper);
+    svt_release_object(out);
+}
+
+// The most recently released object is handed out first, so its buffers are
+// still in cache
+TEST_P(FifoTest, EmptyObjectsReusedLifo) {
+    EbSystemResource *resource = create_resource(3, 1, 1);
+    EbFifo *producer = svt_system_resource_get_producer_fifo(resource, 0);
+    EbObjectWrapper *first;
+    EbObjectWrapper *second;
+    EbObjectWrapper *out;
+
+    svt_get_empty_object(producer, &first);
+    svt_get_empty_object(producer, &second);
+    svt_release_object(first);
+    svt_release_object(second);
+    svt_get_empty_object(producer, &out);
+    EXPECT_EQ(out, second);
+    svt_get_empty_object(producer, &out);
+    EXPECT_EQ(out, first);
+}
+
+// An object posted to the front is consumed before the ones already queued,
+// except on a lock-free full queue, which is FIFO only
+TEST_P(FifoTest, FullObjectPostedFront) {
+    EbSystemResource *resource = create_resource(3, 1, 1);
+    EbFifo *producer = svt_system_resource_get_producer_fifo(resource, 0);
+    EbFifo *consumer = svt_system_resource_get_consumer_fifo(resource, 0);
+    EbObjectWrapper *queued;
+    EbObjectWrapper *urgent;
+    EbObjectWrapper *out;
+
+    svt_get_empty_object(producer, &queued);
+    svt_get_empty_object(producer, &urgent);
+    svt_post_full_object(queued);
+    svt_post_full_object_front(urgent);
+    svt_get_full_object(consumer, &out);
+    EXPECT_EQ(out, GetParam() ? queued : urgent);
+    svt_release_object(out);
+    svt_get_full_object(consumer, &out);
+    EXPECT_EQ(out, GetParam() ? urgent : queued);
+    svt_release_object(out);
+}
+
+// Round trip latency of one object bounced between two threads, the pattern
+// of a kernel waiting on its input fifo
+TEST_P(FifoTest, DISABLED_Speed) {
+    const uint32_t kRoundTrips = 200000;
+    EbSystemResource *ping = create_resource(1, 1, 1);
+    EbSystemResource *pong = create_resource(1, 1, 1);
+
+    std::thread echo([&]() {
+        EbFifo *in = svt_system_resource_get_consumer_fifo(ping, 0);
+        EbFifo *out = svt_system_resource_get_producer_fifo(pong, 0);
+        for (uint32_t i = 0; i < kRoundTrips; i++) {
+            EbObjectWrapper *wrapper;
+            EbObjectWrapper *reply;
+            svt_get_full_object(in, &wrapper);
+            svt_release_object(wrapper);
+            svt_get_empty_object(out, &reply);
+            svt_post_full_object(reply);
+        }
+    });
+
+    EbFifo *out = svt_system_resource_get_producer_fifo(ping, 0);
+    EbFifo *in = svt_system_resource_get_consumer_fifo(pong, 0);
+    uint64_t start_s, start_us, end_s, end_us;
+    svt_av1_get_time(&start_s, &start_us);
+    for (uint32_t i = 0; i < kRoundTrips; i++) {
+        EbObjectWrapper *wrapper;
+        svt_get_empty_object(out, &wrapper);
+        svt_post_full_object(wrapper);
+        svt_get_full_object(in, &wrapper);
+        svt_release_object(wrapper);
+    }
+    svt_av1_get_time(&end_s, &end_us);
+    echo.join();
+
+    const double time_ms = svt_av1_compute_overall_elapsed_time_ms(
+        start_s, start_us, end_s, end_us);
+    printf("%s: %u round trips in %.1f ms, %.3f us per handoff\n",
+           GetParam() ? "lock-free" : "mutex",
+           kRoundTrips,
+           time_ms,
+           time_ms * 1000.0 / (2.0 * kRoundTrips));
+}
+
+INSTANTIATE_TEST_SUITE_P(SystemResource, FifoTest,
+                         ::testing::Values(false, true));
+
+}  // namespace
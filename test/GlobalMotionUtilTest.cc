@@ -20,6 +20,8 @@
  * - ransac_affine_double_prec
  * - ransac_rotzoom_double_prec
  * - ransac_translation_double_prec
+ * - svt_av1_normal_equations
+ * - svt_av1_ransac_find_inliers
  *
  * @author Cidana-Edmond
  *
@@ -29,11 +31,13 @@
 #include "gtest/gtest.h"
 #include "definitions.h"
 #include "utility.h"
+#include "aom_dsp_rtcd.h"
 extern "C" {
 #include "ransac.h"
 }
 #include "random.h"
 #include "util.h"
+#include "unit_test_utility.h"
 
 using std::tuple;
 using std::vector;
@@ -352,4 +356,248 @@ TEST_P(RansacIntTest, CheckOutput) {
 INSTANTIATE_TEST_SUITE_P(GlobalMotion, RansacIntTest,
                          ::testing::ValuesIn(transform_table));
 
+typedef void (*NormalEquationsFunc)(const double *A, int rows, int n,
+                                    int stride, const double *b, double *at_a,
+                                    double *atb);
+
+/**
+ * @brief Unit test for svt_av1_normal_equations, the A^T A and A^T b
+ * accumulation of the rotzoom (n = 4) and affine (n = 6) least-squares fits.
+ *
+ * Test strategy:
+ * Build systems with the sparsity pattern used by ransac.c from random
+ * normalized points, for the minimal 3-point fit and for refits over many
+ * inliers, and compare the SIMD output with the C output.
+ *
+ * Expected result:
+ * Both outputs are bit-exact.
+ */
+class NormalEquationsTest
+    : public ::testing::TestWithParam<NormalEquationsFunc> {
+  protected:
+    NormalEquationsTest() : rnd_(-2.0f, 2.0f) {
+    }
+
+    void prepare_system(int n, int np, double *a, double *b) {
+        for (int i = 0; i < np; ++i) {
+            const double sx = rnd_.random_float();
+            const double sy = rnd_.random_float();
+            double *r0 = a + 2 * i * n;
+            double *r1 = r0 + n;
+            if (n == 4) {
+                const double row0[4] = {sx, sy, 1, 0};
+                const double row1[4] = {sy, -sx, 0, 1};
+                memcpy(r0, row0, sizeof(row0));
+                memcpy(r1, row1, sizeof(row1));
+            } else {
+                const double row0[6] = {sx, sy, 0, 0, 1, 0};
+                const double row1[6] = {0, 0, sx, sy, 0, 1};
+                memcpy(r0, row0, sizeof(row0));
+                memcpy(r1, row1, sizeof(row1));
+            }
+            b[2 * i] = rnd_.random_float();
+            b[2 * i + 1] = rnd_.random_float();
+        }
+    }
+
+    void run_test(int run_times) {
+        NormalEquationsFunc test_func = GetParam();
+        const int np_list[] = {3, 16, 500, MAX_CORNERS};
+        vector<double> a(2 * MAX_CORNERS * 6), b(2 * MAX_CORNERS);
+        double at_a_ref[36], atb_ref[6], at_a_tst[36], atb_tst[6];
+        for (int n = 4; n <= 6; n += 2) {
+            for (const int np : np_list) {
+                const int rows = 2 * np;
+                prepare_system(n, np, a.data(), b.data());
+                svt_av1_normal_equations_c(
+                    a.data(), rows, n, n, b.data(), at_a_ref, atb_ref);
+                test_func(a.data(), rows, n, n, b.data(), at_a_tst, atb_tst);
+                for (int i = 0; i < n * n; ++i)
+                    ASSERT_EQ(at_a_ref[i], at_a_tst[i])
+                        << "n " << n << " points " << np << " entry " << i;
+                for (int i = 0; i < n; ++i)
+                    ASSERT_EQ(atb_ref[i], atb_tst[i])
+                        << "n " << n << " points " << np << " entry " << i;
+
+                if (run_times <= 1)
+                    continue;
+                uint64_t start_s, start_us, middle_s, middle_us, end_s, end_us;
+                svt_av1_get_time(&start_s, &start_us);
+                for (int r = 0; r < run_times; ++r)
+                    svt_av1_normal_equations_c(
+                        a.data(), rows, n, n, b.data(), at_a_ref, atb_ref);
+                svt_av1_get_time(&middle_s, &middle_us);
+                for (int r = 0; r < run_times; ++r)
+                    test_func(
+                        a.data(), rows, n, n, b.data(), at_a_tst, atb_tst);
+                svt_av1_get_time(&end_s, &end_us);
+                const double time_c = svt_av1_compute_overall_elapsed_time_ms(
+                    start_s, start_us, middle_s, middle_us);
+                const double time_o = svt_av1_compute_overall_elapsed_time_ms(
+                    middle_s, middle_us, end_s, end_us);
+                printf("n %d points %4d: C %6.2f ms, SIMD %6.2f ms (%5.2fx)\n",
+                       n,
+                       np,
+                       time_c,
+                       time_o,
+                       time_c / time_o);
+            }
+        }
+    }
+
+    SVTRandom rnd_;
+};
+
+GTEST_ALLOW_UNINSTANTIATED_PARAMETERIZED_TEST(NormalEquationsTest);
+
+TEST_P(NormalEquationsTest, CheckOutput) {
+    run_test(1);
+}
+
+TEST_P(NormalEquationsTest, DISABLED_Speed) {
+    run_test(10000);
+}
+
+typedef int (*RansacFindInliersFunc)(const double *mat, const double *x1,
+                                     const double *y1, const double *x2,
+                                     const double *y2, int npoints,
+                                     double thresh_pow2, int *inlier_indices,
+                                     double *sum_distance,
+                                     double *sum_distance_squared);
+
+/**
+ * @brief Unit test for svt_av1_ransac_find_inliers, the per-hypothesis
+ * projection and inlier test of ransac().
+ *
+ * Test strategy:
+ * Project random integer points with a random near-identity affine model and
+ * perturb the targets so that about half of the points fall inside the 1.25
+ * pixel threshold, then compare the SIMD output with the C output.
+ *
+ * Expected result:
+ * Inlier count, inlier indices and both distance sums are bit-exact.
+ */
+class RansacFindInliersTest
+    : public ::testing::TestWithParam<RansacFindInliersFunc> {
+  protected:
+    RansacFindInliersTest() : rnd_(0, CoordinateMax), noise_(-2.0f, 2.0f) {
+    }
+
+    void prepare_points(int npoints, double *mat, double *x1, double *y1,
+                        double *x2, double *y2) {
+        mat[0] = noise_.random_float() * 8;
+        mat[1] = noise_.random_float() * 8;
+        mat[2] = 1.0 + noise_.random_float() / 64;
+        mat[3] = noise_.random_float() / 64;
+        mat[4] = noise_.random_float() / 64;
+        mat[5] = 1.0 + noise_.random_float() / 64;
+        for (int i = 0; i < npoints; ++i) {
+            x1[i] = rnd_.random() & 4095;
+            y1[i] = rnd_.random() & 4095;
+            x2[i] = round(mat[2] * x1[i] + mat[3] * y1[i] + mat[0] +
+                          noise_.random_float());
+            y2[i] = round(mat[4] * x1[i] + mat[5] * y1[i] + mat[1] +
+                          noise_.random_float());
+        }
+    }
+
+    void run_test(int run_times) {
+        RansacFindInliersFunc test_func = GetParam();
+        const double thresh_pow2 = 1.5625;
+        vector<double> pts(4 * MAX_CORNERS);
+        vector<int> idx_ref(MAX_CORNERS), idx_tst(MAX_CORNERS);
+        const int np_list[] = {15, 17, 101, 1000, MAX_CORNERS};
+        for (const int np : np_list) {
+            double mat[6];
+            double *x1 = pts.data(), *y1 = x1 + np, *x2 = y1 + np,
+                   *y2 = x2 + np;
+            prepare_points(np, mat, x1, y1, x2, y2);
+            double sum_ref = 0, sum2_ref = 0, sum_tst = 0, sum2_tst = 0;
+            const int n_ref = svt_av1_ransac_find_inliers_c(mat,
+                                                            x1,
+                                                            y1,
+                                                            x2,
+                                                            y2,
+                                                            np,
+                                                            thresh_pow2,
+                                                            idx_ref.data(),
+                                                            &sum_ref,
+                                                            &sum2_ref);
+            const int n_tst = test_func(mat,
+                                        x1,
+                                        y1,
+                                        x2,
+                                        y2,
+                                        np,
+                                        thresh_pow2,
+                                        idx_tst.data(),
+                                        &sum_tst,
+                                        &sum2_tst);
+            ASSERT_EQ(n_ref, n_tst) << "points " << np;
+            for (int i = 0; i < n_ref; ++i)
+                ASSERT_EQ(idx_ref[i], idx_tst[i]) << "points " << np;
+            ASSERT_EQ(sum_ref, sum_tst) << "points " << np;
+            ASSERT_EQ(sum2_ref, sum2_tst) << "points " << np;
+
+            if (run_times <= 1)
+                continue;
+            uint64_t start_s, start_us, middle_s, middle_us, end_s, end_us;
+            svt_av1_get_time(&start_s, &start_us);
+            for (int r = 0; r < run_times; ++r)
+                svt_av1_ransac_find_inliers_c(mat,
+                                              x1,
+                                              y1,
+                                              x2,
+                                              y2,
+                                              np,
+                                              thresh_pow2,
+                                              idx_ref.data(),
+                                              &sum_ref,
+                                              &sum2_ref);
+            svt_av1_get_time(&middle_s, &middle_us);
+            for (int r = 0; r < run_times; ++r)
+                test_func(mat,
+                          x1,
+                          y1,
+                          x2,
+                          y2,
+                          np,
+                          thresh_pow2,
+                          idx_tst.data(),
+                          &sum_tst,
+                          &sum2_tst);
+            svt_av1_get_time(&end_s, &end_us);
+            const double time_c = svt_av1_compute_overall_elapsed_time_ms(
+                start_s, start_us, middle_s, middle_us);
+            const double time_o = svt_av1_compute_overall_elapsed_time_ms(
+                middle_s, middle_us, end_s, end_us);
+            printf("points %4d: C %6.2f ms, SIMD %6.2f ms (%5.2fx)\n",
+                   np,
+                   time_c,
+                   time_o,
+                   time_c / time_o);
+        }
+    }
+
+    SVTRandom rnd_;
+    SVTRandom noise_;
+};
+
+GTEST_ALLOW_UNINSTANTIATED_PARAMETERIZED_TEST(RansacFindInliersTest);
+
+TEST_P(RansacFindInliersTest, CheckOutput) {
+    run_test(1);
+}
+
+TEST_P(RansacFindInliersTest, DISABLED_Speed) {
+    run_test(1000);
+}
+
+#ifdef ARCH_X86_64
+INSTANTIATE_TEST_SUITE_P(AVX2, NormalEquationsTest,
+                         ::testing::Values(svt_av1_normal_equations_avx2));
+INSTANTIATE_TEST_SUITE_P(AVX2, RansacFindInliersTest,
+                         ::testing::Values(svt_av1_ransac_find_inliers_avx2));
+#endif  // ARCH_X86_64
+
 }  // namespace
@@ -0,0 +1,186 @@
+/*
+ * Copyright(c) 2024 Alliance for Open Media
+ *
+ * This source code is subject to the terms of the BSD 2 Clause License and
+ * the Alliance for Open Media Patent License 1.0. If the BSD 2 Clause License
+ * was not distributed with this source code in the LICENSE file, you can
+ * obtain it at https://www.aomedia.org/license/software-license. If the
+ * Alliance for Open Media Patent License 1.0 was not distributed with this
+ * source code in the PATENTS file, you can obtain it at
+ * https://www.aomedia.org/license/patent-license.
+ */
+
+/******************************************************************************
+ * @file HashTest.cc
+ *
+ * @brief Unit test of the block hashing used by IntraBC:
+ * - svt_av1_get_crc32c_value
+ * - flat hash table bucket count and order
+ *
+ ******************************************************************************/
+
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "aom_dsp_rtcd.h"
+#include "hash.h"
+#include "hash_motion.h"
+#include "svt_time.h"
+#include "random.h"
+#include "util.h"
+
+namespace {
+using svt_av1_test_tool::SVTRandom;
+
+typedef uint32_t (*Crc32cFunc)(void *crc_calculator, uint8_t *p,
+                               size_t length);
+
+class Crc32cTest : public ::testing::TestWithParam<Crc32cFunc> {
+  public:
+    Crc32cTest() : rnd_(0, 255), func_(GetParam()) {
+        svt_av1_crc32c_calculator_init(&crc32c_);
+    }
+
+  protected:
+    void RunCheckOutput(int run_times) {
+        const size_t max_len = 512;
+        uint8_t buf[max_len + 8];
+        for (size_t i = 0; i < sizeof(buf); i++) buf[i] = rnd_.random();
+
+        for (size_t len = 0; len <= max_len; len++) {
+            // unaligned start to exercise the tails of every load width
+            uint8_t *p = buf + (len & 7);
+            const uint32_t ref = svt_av1_get_crc32c_value_c(&crc32c_, p, len);
+            const uint32_t tst = func_(&crc32c_, p, len);
+            ASSERT_EQ(ref, tst) << "length " << len;
+        }
+
+        if (run_times > 1) {
+            const size_t lens[] = {4, 8, 16, 64};
+            for (size_t l = 0; l < 4; l++) {
+                double time_c, time_o;
+                uint64_t start_time_seconds, start_time_useconds;
+                uint64_t middle_time_seconds, middle_time_useconds;
+                uint64_t finish_time_seconds, finish_time_useconds;
+                uint32_t sum_c = 0, sum_o = 0;
+
+                svt_av1_get_time(&start_time_seconds, &start_time_useconds);
+                for (int i = 0; i < run_times; i++)
+                    sum_c += svt_av1_get_crc32c_value_c(
+                        &crc32c_, buf + (i & 7), lens[l]);
+                svt_av1_get_time(&middle_time_seconds, &middle_time_useconds);
+                for (int i = 0; i < run_times; i++)
+                    sum_o += func_(&crc32c_, buf + (i & 7), lens[l]);
+                svt_av1_get_time(&finish_time_seconds, &finish_time_useconds);
+                ASSERT_EQ(sum_c, sum_o);
+
+                time_c = svt_av1_compute_overall_elapsed_time_ms(
+                    start_time_seconds,
+                    start_time_useconds,
+                    middle_time_seconds,
+                    middle_time_useconds);
+                time_o = svt_av1_compute_overall_elapsed_time_ms(
+                    middle_time_seconds,
+                    middle_time_useconds,
+                    finish_time_seconds,
+                    finish_time_useconds);
+                printf("crc32c length %3d: c %5.2fms, opt %5.2fms (x%4.2f)\n",
+                       (int)lens[l],
+                       time_c,
+                       time_o,
+                       time_c / time_o);
+            }
+        }
+    }
+
+    SVTRandom rnd_;
+    Crc32cFunc func_;
+    CRC32C crc32c_;
+};
+GTEST_ALLOW_UNINSTANTIATED_PARAMETERIZED_TEST(Crc32cTest);
+
+TEST_P(Crc32cTest, CheckOutput) {
+    RunCheckOutput(1);
+}
+
+TEST_P(Crc32cTest, DISABLED_Speed) {
+    RunCheckOutput(10000000);
+}
+
+#ifdef ARCH_X86_64
+INSTANTIATE_TEST_SUITE_P(SSE4_2, Crc32cTest,
+                         ::testing::Values(svt_av1_get_crc32c_value_sse4_2));
+#endif  // ARCH_X86_64
+
+#if defined(ARCH_AARCH64) && HAVE_ARM_CRC32
+INSTANTIATE_TEST_SUITE_P(ARM_CRC32, Crc32cTest,
+                         ::testing::Values(svt_av1_get_crc32c_value_arm_crc32));
+#endif  // ARCH_AARCH64 && HAVE_ARM_CRC32
+
+TEST(Crc32cTest, KnownAnswer) {
+    CRC32C crc32c;
+    svt_av1_crc32c_calculator_init(&crc32c);
+    uint8_t msg[] = {'1', '2', '3', '4', '5', '6', '7', '8', '9'};
+    ASSERT_EQ(0xE3069283u,
+              svt_av1_get_crc32c_value_c(&crc32c, msg, sizeof(msg)));
+}
+
+// Every bucket of the flat table must hold exactly the blocks of that hash,
+// in the column major order of the picture scan.
+TEST(HashTableTest, BucketCountAndOrder) {
+    const int w = 64, h = 48, block_size = 8;
+    SVTRandom rnd(0, 15);
+    uint32_t *hash[2];
+    hash[0] = new uint32_t[w * h];
+    hash[1] = new uint32_t[w * h];
+    int8_t *is_added = new int8_t[w * h];
+    for (int i = 0; i < w * h; i++) {
+        // few distinct values so buckets get many entries
+        hash[0][i] = (rnd.random() << 16) | rnd.random();
+        hash[1][i] = i;
+        is_added[i] = rnd.random() & 1;
+    }
+
+    HashTable table;
+    memset(&table, 0, sizeof(table));
+    for (int frame = 0; frame < 2; frame++) {
+        ASSERT_EQ(svt_aom_rtime_alloc_svt_av1_hash_table_create(&table),
+                  EB_ErrorNone);
+        ASSERT_EQ(svt_aom_rtime_alloc_svt_av1_add_to_hash_map_by_row_with_precal_data(
+                      &table, hash, is_added, w, h, 4),
+                  EB_ErrorNone);
+        ASSERT_EQ(svt_aom_rtime_alloc_svt_av1_add_to_hash_map_by_row_with_precal_data(
+                      &table, hash, is_added, w, h, block_size),
+                  EB_ErrorNone);
+        // 16x16 blocks were not added
+        ASSERT_EQ(svt_av1_hash_table_count(&table, (2 << 16) | 1), 0);
+
+        for (uint32_t crc = 0; crc < 16; crc++) {
+            const uint32_t hash_value1 = (1 << 16) | crc;
+            std::vector<int> expected;
+            for (int x = 0; x <= w - block_size; x++)
+                for (int y = 0; y <= h - block_size; y++)
+                    if (is_added[y * w + x] && (hash[0][y * w + x] & 0xffff) == crc)
+                        expected.push_back(y * w + x);
+            const int count = svt_av1_hash_table_count(&table, hash_value1);
+            ASSERT_EQ(count, (int)expected.size());
+            if (!count)
+                continue;
+            const BlockHash *blocks =
+                svt_av1_hash_get_first_block(&table, hash_value1);
+            for (int i = 0; i < count; i++) {
+                ASSERT_EQ(blocks[i].x, expected[i] % w);
+                ASSERT_EQ(blocks[i].y, expected[i] / w);
+                ASSERT_EQ(blocks[i].hash_value2, (uint32_t)expected[i]);
+            }
+        }
+        svt_av1_hash_table_release_entries(&table);
+    }
+    svt_av1_hash_table_destroy(&table);
+
+    delete[] hash[0];
+    delete[] hash[1];
+    delete[] is_added;
+}
+
+}  // namespace
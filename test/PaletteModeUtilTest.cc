@@ -18,6 +18,7 @@
  * - svt_av1_count_colors_highbd
  * - av1_k_means_dim1
  * - av1_k_means_dim2
+ * - SIMD versions of the above against C
  *
  * @author Cidana-Edmond
  *
@@ -39,12 +40,6 @@ using svt_av1_test_tool::SVTRandom;
 
 namespace {
 
-extern "C" int svt_av1_count_colors(const uint8_t *src, int stride, int rows,
-                                    int cols, int *val_count);
-extern "C" int svt_av1_count_colors_highbd(uint16_t *src, int stride, int rows,
-                                           int cols, int bit_depth,
-                                           int *val_count);
-
 /**
  * @brief Unit test for counting colors:
  * - svt_av1_count_colors
@@ -125,7 +120,7 @@ class ColorCountLbdTest : public ColorCountTest<uint8_t> {
         const int max_colors = (1 << bd_);
         memset(val_count_, 0, max_colors * sizeof(int));
         unsigned int colors =
-            (unsigned int)svt_av1_count_colors(input_, 64, 64, 64, val_count_);
+            (unsigned int)svt_av1_count_colors_c(input_, 64, 64, 64, val_count_);
         return colors;
     }
 };
@@ -139,7 +134,7 @@ class ColorCountHbdTest : public ColorCountTest<uint16_t> {
     unsigned int count_color() override {
         const int max_colors = (1 << bd_);
         memset(val_count_, 0, max_colors * sizeof(int));
-        unsigned int colors = (unsigned int)svt_av1_count_colors_highbd(
+        unsigned int colors = (unsigned int)svt_av1_count_colors_highbd_c(
             input_, 64, 64, 64, bd_, val_count_);
         return colors;
     }
@@ -160,6 +155,113 @@ TEST_F(ColorCountHbdTest, MatchTest12Bit) {
     run_test(1000);
 }
 
+typedef int (*CountColorsFunc)(const uint8_t *src, int stride, int rows,
+                               int cols, int *val_count);
+typedef int (*CountColorsHbdFunc)(uint16_t *src, int stride, int rows,
+                                  int cols, int bit_depth, int *val_count);
+typedef std::tuple<CountColorsFunc, CountColorsHbdFunc> CountColorsFuncs;
+
+/**
+ * @brief Unit test for the SIMD color counting against C, on random blocks
+ * and on blocks made of runs of a few colors as in screen content. Both the
+ * number of colors and the histogram must match.
+ */
+class ColorCountSimdTest : public ::testing::TestWithParam<CountColorsFuncs> {
+  protected:
+    ColorCountSimdTest()
+        : rnd_(0, 65535),
+          func_(std::get<0>(GetParam())),
+          func_hbd_(std::get<1>(GetParam())) {
+    }
+
+    // fill the block with either random samples or runs of random length
+    // taken from a palette of 4 colors
+    template <typename Sample>
+    void prepare_data(Sample *src, int stride, int rows, int cols, int bd,
+                      bool runs) {
+        const int mask = (1 << bd) - 1;
+        int palette[4];
+        for (int i = 0; i < 4; i++)
+            palette[i] = rnd_.random() & mask;
+        for (int r = 0; r < rows; r++) {
+            int c = 0;
+            while (c < cols) {
+                const int len = runs ? 1 + (rnd_.random() & 31) : 1;
+                const int val =
+                    runs ? palette[rnd_.random() & 3] : rnd_.random() & mask;
+                for (int i = 0; i < len && c < cols; i++, c++)
+                    src[r * stride + c] = (Sample)val;
+            }
+        }
+    }
+
+    void run_test() {
+        const int stride = 80;
+        uint8_t src[64 * 80];
+        uint16_t src16[64 * 80];
+        int count_ref[1 << 12], count_tst[1 << 12];
+        const int sizes[] = {4, 8, 12, 16, 24, 32, 40, 64};
+        for (int bd = 8; bd <= 12; bd += 2) {
+            for (int runs = 0; runs < 2; runs++) {
+                for (int h = 0; h < 8; h++) {
+                    for (int w = 0; w < 8; w++) {
+                        const int rows = sizes[h], cols = sizes[w];
+                        const int bins = 1 << bd;
+                        if (bd == 8) {
+                            prepare_data(src, stride, rows, cols, bd, runs);
+                            const int ref = svt_av1_count_colors_c(
+                                src, stride, rows, cols, count_ref);
+                            const int tst =
+                                func_(src, stride, rows, cols, count_tst);
+                            ASSERT_EQ(ref, tst)
+                                << rows << "x" << cols << " runs " << runs;
+                            ASSERT_EQ(0,
+                                      memcmp(count_ref,
+                                             count_tst,
+                                             bins * sizeof(count_ref[0])));
+                        }
+                        prepare_data(src16, stride, rows, cols, bd, runs);
+                        const int ref = svt_av1_count_colors_highbd_c(
+                            src16, stride, rows, cols, bd, count_ref);
+                        const int tst = func_hbd_(
+                            src16, stride, rows, cols, bd, count_tst);
+                        ASSERT_EQ(ref, tst) << rows << "x" << cols << " bd "
+                                            << bd << " runs " << runs;
+                        ASSERT_EQ(
+                            0,
+                            memcmp(
+                                count_ref, count_tst, bins * sizeof(count_ref[0])));
+                    }
+                }
+            }
+        }
+    }
+
+    SVTRandom rnd_;
+    CountColorsFunc func_;
+    CountColorsHbdFunc func_hbd_;
+};
+GTEST_ALLOW_UNINSTANTIATED_PARAMETERIZED_TEST(ColorCountSimdTest);
+
+TEST_P(ColorCountSimdTest, MatchTest) {
+    for (int i = 0; i < 20; i++)
+        run_test();
+}
+
+#ifdef ARCH_X86_64
+INSTANTIATE_TEST_SUITE_P(
+    AVX2, ColorCountSimdTest,
+    ::testing::Values(CountColorsFuncs(svt_av1_count_colors_avx2,
+                                       svt_av1_count_colors_highbd_avx2)));
+#endif  // ARCH_X86_64
+
+#ifdef ARCH_AARCH64
+INSTANTIATE_TEST_SUITE_P(
+    NEON, ColorCountSimdTest,
+    ::testing::Values(CountColorsFuncs(svt_av1_count_colors_neon,
+                                       svt_av1_count_colors_highbd_neon)));
+#endif  // ARCH_AARCH64
+
 extern "C" void svt_av1_k_means_dim1_c(const int *data, int *centroids,
                                        uint8_t *indices, int n, int k,
                                        int max_itr);
@@ -209,7 +311,7 @@ class KMeansTest : public ::testing::TestWithParam<int> {
             data_[i] = tmp[i] = palette[rnd_.random() % max_colors];
         delete[] palette;
         int val_count[MAX_PALETTE_SQUARE] = {0};
-        return svt_av1_count_colors(tmp, 64, 64, 64, val_count);
+        return svt_av1_count_colors_c(tmp, 64, 64, 64, val_count);
     }
 
     void run_test(size_t times) {
@@ -347,6 +449,14 @@ static void svt_av1_calc_indices_dim1_c_wrap(const int *data, int *centroids,
     svt_av1_calc_indices_dim1_c(data, centroids, indices, n, k);
 }
 
+static void svt_av1_calc_indices_dim2_c_wrap(const int *data, int *centroids,
+                                             uint8_t *indices, int n, int k,
+                                             int max_itr) {
+    (void)max_itr;
+    svt_av1_calc_indices_dim2_c(data, centroids, indices, n, k);
+}
+
+#ifdef ARCH_X86_64
 static void svt_av1_calc_indices_dim1_avx2_wrap(const int *data, int *centroids,
                                                 uint8_t *indices, int n, int k,
                                                 int max_itr) {
@@ -354,28 +464,49 @@ static void svt_av1_calc_indices_dim1_avx2_wrap(const int *data, int *centroids,
     svt_av1_calc_indices_dim1_avx2(data, centroids, indices, n, k);
 }
 
-static void svt_av1_calc_indices_dim2_c_wrap(const int *data, int *centroids,
-                                             uint8_t *indices, int n, int k,
-                                             int max_itr) {
+static void svt_av1_calc_indices_dim2_avx2_wrap(const int *data, int *centroids,
+                                                uint8_t *indices, int n, int k,
+                                                int max_itr) {
     (void)max_itr;
-    svt_av1_calc_indices_dim2_c(data, centroids, indices, n, k);
+    svt_av1_calc_indices_dim2_avx2(data, centroids, indices, n, k);
 }
+#endif  // ARCH_X86_64
 
-static void svt_av1_calc_indices_dim2_avx2_wrap(const int *data, int *centroids,
+#ifdef ARCH_AARCH64
+static void svt_av1_calc_indices_dim1_neon_wrap(const int *data, int *centroids,
                                                 uint8_t *indices, int n, int k,
                                                 int max_itr) {
     (void)max_itr;
-    svt_av1_calc_indices_dim2_avx2(data, centroids, indices, n, k);
+    svt_av1_calc_indices_dim1_neon(data, centroids, indices, n, k);
+}
+
+static void svt_av1_calc_indices_dim2_neon_wrap(const int *data, int *centroids,
+                                                uint8_t *indices, int n, int k,
+                                                int max_itr) {
+    (void)max_itr;
+    svt_av1_calc_indices_dim2_neon(data, centroids, indices, n, k);
 }
+#endif  // ARCH_AARCH64
 
 typedef std::tuple<av1_k_means_func, av1_k_means_func> FuncPair;
 FuncPair TEST_FUNC_PAIRS[] = {
+#ifdef ARCH_X86_64
     FuncPair(svt_av1_calc_indices_dim1_c_wrap,
              svt_av1_calc_indices_dim1_avx2_wrap),
     FuncPair(svt_av1_k_means_dim1_c, svt_av1_k_means_dim1_avx2),
     FuncPair(svt_av1_calc_indices_dim2_c_wrap,
              svt_av1_calc_indices_dim2_avx2_wrap),
-    FuncPair(svt_av1_k_means_dim2_c, svt_av1_k_means_dim2_avx2)};
+    FuncPair(svt_av1_k_means_dim2_c, svt_av1_k_means_dim2_avx2),
+#endif  // ARCH_X86_64
+#ifdef ARCH_AARCH64
+    FuncPair(svt_av1_calc_indices_dim1_c_wrap,
+             svt_av1_calc_indices_dim1_neon_wrap),
+    FuncPair(svt_av1_k_means_dim1_c, svt_av1_k_means_dim1_neon),
+    FuncPair(svt_av1_calc_indices_dim2_c_wrap,
+             svt_av1_calc_indices_dim2_neon_wrap),
+    FuncPair(svt_av1_k_means_dim2_c, svt_av1_k_means_dim2_neon),
+#endif  // ARCH_AARCH64
+};
 
 typedef std::tuple<TestPattern, BlockSize, FuncPair> Av1KMeansDimParam;
 
@@ -0,0 +1,371 @@
+/*
+ * Copyright (c) 2024, Alliance for Open Media. All rights reserved
+ *
+ * This source code is subject to the terms of the BSD 2 Clause License and
+ * the Alliance for Open Media Patent License 1.0. If the BSD 2 Clause License
+ * was not distributed with this source code in the LICENSE file, you can
+ * obtain it at https://www.aomedia.org/license/software-license. If the
+ * Alliance for Open Media Patent License 1.0 was not distributed with this
+ * source code in the PATENTS file, you can obtain it at
+ * https://www.aomedia.org/license/patent-license.
+ */
+#include <stdlib.h>
+
+#include "gtest/gtest.h"
+#include "common_dsp_rtcd.h"
+#include "definitions.h"
+#include "random.h"
+#include "svt_time.h"
+#include "util.h"
+#include "utility.h"
+
+using std::make_tuple;
+using svt_av1_test_tool::SVTRandom;
+
+namespace {
+
+using PsyDistFunc = uint64_t (*)(const uint8_t *input, uint32_t input_stride,
+                                 const uint8_t *recon, uint32_t recon_stride,
+                                 uint32_t width, uint32_t height,
+                                 const uint32_t count);
+using PsyDistHbdFunc = uint64_t (*)(const uint16_t *input,
+                                    uint32_t input_stride,
+                                    const uint16_t *recon,
+                                    uint32_t recon_stride, uint32_t width,
+                                    uint32_t height, const uint32_t count);
+using PsyEnergyFunc = void (*)(const uint8_t *src, uint32_t stride,
+                               uint32_t width, uint32_t height, int32_t *nrg);
+using PsyEnergyHbdFunc = void (*)(const uint16_t *src, uint32_t stride,
+                                  uint32_t width, uint32_t height,
+                                  int32_t *nrg);
+
+// All the block sizes get_svt_psy_full_dist() is called with
+static const BlockSize kPsyBlockSizes[] = {
+    BLOCK_4X4,   BLOCK_4X8,   BLOCK_8X4,   BLOCK_8X8,   BLOCK_8X16,
+    BLOCK_16X8,  BLOCK_16X16, BLOCK_16X32, BLOCK_32X16, BLOCK_32X32,
+    BLOCK_32X64, BLOCK_64X32, BLOCK_64X64, BLOCK_4X16,  BLOCK_16X4,
+    BLOCK_8X32,  BLOCK_32X8,  BLOCK_16X64, BLOCK_64X16};
+
+static const uint32_t kStride = 160;
+
+template <typename Pixel, typename Func>
+class PsyDistortionTestBase
+    : public ::testing::TestWithParam<std::tuple<BlockSize, Func>> {
+  protected:
+    PsyDistortionTestBase() {
+        bsize_ = std::get<0>(this->GetParam());
+        func_test_ = std::get<1>(this->GetParam());
+        width_ = block_size_wide[bsize_];
+        height_ = block_size_high[bsize_];
+    }
+
+    void SetUp() override {
+        input_ = reinterpret_cast<Pixel *>(
+            svt_aom_memalign(32, sizeof(Pixel) * kStride * kStride));
+        recon_ = reinterpret_cast<Pixel *>(
+            svt_aom_memalign(32, sizeof(Pixel) * kStride * kStride));
+        ASSERT_NE(input_, nullptr);
+        ASSERT_NE(recon_, nullptr);
+    }
+
+    void TearDown() override {
+        svt_aom_free(input_);
+        svt_aom_free(recon_);
+    }
+
+    void FillRandom(const int max_val) {
+        SVTRandom rnd(0, max_val);
+        for (uint32_t i = 0; i < kStride * kStride; ++i) {
+            input_[i] = static_cast<Pixel>(rnd.random());
+            recon_[i] = static_cast<Pixel>(rnd.random());
+        }
+    }
+
+    // Small differences around a flat value, the typical MD case
+    void FillNoisy(const int max_val) {
+        SVTRandom rnd(-4, 4);
+        const int mid = (max_val + 1) >> 1;
+        for (uint32_t i = 0; i < kStride * kStride; ++i) {
+            input_[i] = static_cast<Pixel>(mid + rnd.random());
+            recon_[i] = static_cast<Pixel>(mid + rnd.random());
+        }
+    }
+
+    // Saturated checkerboards overflow the packed 16-bit sums of the C code
+    void FillExtreme(const int max_val) {
+        SVTRandom rnd(0, 1);
+        for (uint32_t i = 0; i < kStride * kStride; ++i) {
+            input_[i] = static_cast<Pixel>(rnd.random() ? max_val : 0);
+            recon_[i] = static_cast<Pixel>(((i + i / kStride) & 1) ? max_val
+                                                                   : 0);
+        }
+    }
+
+    void RunComparison(Func func_ref) {
+        for (uint32_t offset = 0; offset < 8; offset += 3) {
+            const uint64_t dist_ref = func_ref(input_ + offset,
+                                               kStride,
+                                               recon_ + 2 * offset,
+                                               kStride - 1,
+                                               width_,
+                                               height_,
+                                               width_ * height_);
+            const uint64_t dist_test = func_test_(input_ + offset,
+                                                  kStride,
+                                                  recon_ + 2 * offset,
+                                                  kStride - 1,
+                                                  width_,
+                                                  height_,
+                                                  width_ * height_);
+            ASSERT_EQ(dist_ref, dist_test)
+                << "block " << width_ << "x" << height_ << " offset "
+                << offset;
+        }
+    }
+
+    void RunSpeedTest(Func func_ref) {
+        double time_c, time_o;
+        uint64_t start_time_seconds, start_time_useconds;
+        uint64_t finish_time_seconds, finish_time_useconds;
+        const int num_iter = 1000000 / (width_ * height_) + 1000;
+        uint64_t dist_ref = 0, dist_test = 0;
+
+        svt_av1_get_time(&start_time_seconds, &start_time_useconds);
+        for (int i = 0; i < num_iter; i++)
+            dist_ref += func_ref(input_,
+                                 kStride,
+                                 recon_,
+                                 kStride,
+                                 width_,
+                                 height_,
+                                 width_ * height_);
+        svt_av1_get_time(&finish_time_seconds, &finish_time_useconds);
+        time_c = svt_av1_compute_overall_elapsed_time_ms(start_time_seconds,
+                                                         start_time_useconds,
+                                                         finish_time_seconds,
+                                                         finish_time_useconds);
+
+        svt_av1_get_time(&start_time_seconds, &start_time_useconds);
+        for (int i = 0; i < num_iter; i++)
+            dist_test += func_test_(input_,
+                                    kStride,
+                                    recon_,
+                                    kStride,
+                                    width_,
+                                    height_,
+                                    width_ * height_);
+        svt_av1_get_time(&finish_time_seconds, &finish_time_useconds);
+        time_o = svt_av1_compute_overall_elapsed_time_ms(start_time_seconds,
+                                                         start_time_useconds,
+                                                         finish_time_seconds,
+                                                         finish_time_useconds);
+
+        printf("%ux%u c_time = %f \t o_time = %f \t Gain = %4.2f \n",
+               width_,
+               height_,
+               time_c,
+               time_o,
+               (static_cast<float>(time_c) / static_cast<float>(time_o)));
+
+        EXPECT_EQ(dist_ref, dist_test) << "Output mismatch \n";
+    }
+
+    BlockSize bsize_;
+    uint32_t width_;
+    uint32_t height_;
+    Pixel *input_;
+    Pixel *recon_;
+    Func func_test_;
+};
+
+class PsyDistortionTest
+    : public PsyDistortionTestBase<uint8_t, PsyDistFunc> {};
+
+TEST_P(PsyDistortionTest, MatchRandom) {
+    for (int i = 0; i < 10; i++) {
+        FillRandom(255);
+        RunComparison(svt_psy_distortion_c);
+    }
+}
+
+TEST_P(PsyDistortionTest, MatchNoisy) {
+    for (int i = 0; i < 10; i++) {
+        FillNoisy(255);
+        RunComparison(svt_psy_distortion_c);
+    }
+}
+
+TEST_P(PsyDistortionTest, MatchExtreme) {
+    for (int i = 0; i < 10; i++) {
+        FillExtreme(255);
+        RunComparison(svt_psy_distortion_c);
+    }
+}
+
+TEST_P(PsyDistortionTest, DISABLED_Speed) {
+    FillRandom(255);
+    RunSpeedTest(svt_psy_distortion_c);
+}
+GTEST_ALLOW_UNINSTANTIATED_PARAMETERIZED_TEST(PsyDistortionTest);
+
+class PsyDistortionHbdTest
+    : public PsyDistortionTestBase<uint16_t, PsyDistHbdFunc> {};
+
+TEST_P(PsyDistortionHbdTest, MatchRandom) {
+    for (int i = 0; i < 10; i++) {
+        FillRandom(1023);
+        RunComparison(svt_psy_distor_hbd_c);
+    }
+}
+
+TEST_P(PsyDistortionHbdTest, MatchNoisy) {
+    for (int i = 0; i < 10; i++) {
+        FillNoisy(1023);
+        RunComparison(svt_psy_distor_hbd_c);
+    }
+}
+
+TEST_P(PsyDistortionHbdTest, MatchExtreme) {
+    for (int i = 0; i < 10; i++) {
+        FillExtreme(1023);
+        RunComparison(svt_psy_distor_hbd_c);
+    }
+}
+
+TEST_P(PsyDistortionHbdTest, DISABLED_Speed) {
+    FillRandom(1023);
+    RunSpeedTest(svt_psy_distor_hbd_c);
+}
+GTEST_ALLOW_UNINSTANTIATED_PARAMETERIZED_TEST(PsyDistortionHbdTest);
+
+// Per 8x8 source energies used by the MD psy-rd cache
+template <typename Pixel, typename Func>
+class PsyEnergyTestBase : public PsyDistortionTestBase<Pixel, Func> {
+  protected:
+    void RunEnergyComparison(Func func_ref) {
+        // up to 16x16 8x8 windows for a 128x128 area
+        int32_t nrg_ref[256], nrg_test[256];
+        const uint32_t num = ((this->width_ + 7) >> 3) *
+                             ((this->height_ + 7) >> 3);
+        if (this->width_ * this->height_ < 64)
+            return;
+        for (uint32_t offset = 0; offset < 8; offset += 3) {
+            func_ref(this->input_ + offset,
+                     kStride,
+                     this->width_,
+                     this->height_,
+                     nrg_ref);
+            this->func_test_(this->input_ + offset,
+                             kStride,
+                             this->width_,
+                             this->height_,
+                             nrg_test);
+            for (uint32_t i = 0; i < num; i++)
+                ASSERT_EQ(nrg_ref[i], nrg_test[i])
+                    << "block " << this->width_ << "x" << this->height_
+                    << " window " << i << " offset " << offset;
+        }
+    }
+};
+
+class PsyEnergyTest : public PsyEnergyTestBase<uint8_t, PsyEnergyFunc> {};
+
+TEST_P(PsyEnergyTest, MatchRandom) {
+    for (int i = 0; i < 10; i++) {
+        FillRandom(255);
+        RunEnergyComparison(svt_psy_ac_energy_c);
+    }
+}
+
+TEST_P(PsyEnergyTest, MatchExtreme) {
+    for (int i = 0; i < 10; i++) {
+        FillExtreme(255);
+        RunEnergyComparison(svt_psy_ac_energy_c);
+    }
+}
+GTEST_ALLOW_UNINSTANTIATED_PARAMETERIZED_TEST(PsyEnergyTest);
+
+class PsyEnergyHbdTest
+    : public PsyEnergyTestBase<uint16_t, PsyEnergyHbdFunc> {};
+
+TEST_P(PsyEnergyHbdTest, MatchRandom) {
+    for (int i = 0; i < 10; i++) {
+        FillRandom(1023);
+        RunEnergyComparison(svt_psy_ac_energy_hbd_c);
+    }
+}
+
+TEST_P(PsyEnergyHbdTest, MatchExtreme) {
+    for (int i = 0; i < 10; i++) {
+        FillExtreme(1023);
+        RunEnergyComparison(svt_psy_ac_energy_hbd_c);
+    }
+}
+GTEST_ALLOW_UNINSTANTIATED_PARAMETERIZED_TEST(PsyEnergyHbdTest);
+
+#if ARCH_X86_64
+INSTANTIATE_TEST_SUITE_P(
+    AVX2, PsyDistortionTest,
+    ::testing::Combine(::testing::ValuesIn(kPsyBlockSizes),
+                       ::testing::Values(svt_psy_distortion_avx2)));
+
+INSTANTIATE_TEST_SUITE_P(
+    AVX2, PsyDistortionHbdTest,
+    ::testing::Combine(::testing::ValuesIn(kPsyBlockSizes),
+                       ::testing::Values(svt_psy_distor_hbd_avx2)));
+
+INSTANTIATE_TEST_SUITE_P(
+    AVX2, PsyEnergyTest,
+    ::testing::Combine(::testing::ValuesIn(kPsyBlockSizes),
+                       ::testing::Values(svt_psy_ac_energy_avx2)));
+
+INSTANTIATE_TEST_SUITE_P(
+    AVX2, PsyEnergyHbdTest,
+    ::testing::Combine(::testing::ValuesIn(kPsyBlockSizes),
+                       ::testing::Values(svt_psy_ac_energy_hbd_avx2)));
+
+#if EN_AVX512_SUPPORT
+INSTANTIATE_TEST_SUITE_P(
+    AVX512, PsyDistortionTest,
+    ::testing::Combine(::testing::ValuesIn(kPsyBlockSizes),
+                       ::testing::Values(svt_psy_distortion_avx512)));
+
+INSTANTIATE_TEST_SUITE_P(
+    AVX512, PsyDistortionHbdTest,
+    ::testing::Combine(::testing::ValuesIn(kPsyBlockSizes),
+                       ::testing::Values(svt_psy_distor_hbd_avx512)));
+
+INSTANTIATE_TEST_SUITE_P(
+    AVX512, PsyEnergyTest,
+    ::testing::Combine(::testing::ValuesIn(kPsyBlockSizes),
+                       ::testing::Values(svt_psy_ac_energy_avx512)));
+
+INSTANTIATE_TEST_SUITE_P(
+    AVX512, PsyEnergyHbdTest,
+    ::testing::Combine(::testing::ValuesIn(kPsyBlockSizes),
+                       ::testing::Values(svt_psy_ac_energy_hbd_avx512)));
+#endif  // EN_AVX512_SUPPORT
+#endif  // ARCH_X86_64
+
+#if ARCH_AARCH64
+INSTANTIATE_TEST_SUITE_P(
+    NEON, PsyDistortionTest,
+    ::testing::Combine(::testing::ValuesIn(kPsyBlockSizes),
+                       ::testing::Values(svt_psy_distortion_neon)));
+
+INSTANTIATE_TEST_SUITE_P(
+    NEON, PsyDistortionHbdTest,
+    ::testing::Combine(::testing::ValuesIn(kPsyBlockSizes),
+                       ::testing::Values(svt_psy_distor_hbd_neon)));
+
+INSTANTIATE_TEST_SUITE_P(
+    NEON, PsyEnergyTest,
+    ::testing::Combine(::testing::ValuesIn(kPsyBlockSizes),
+                       ::testing::Values(svt_psy_ac_energy_neon)));
+
+INSTANTIATE_TEST_SUITE_P(
+    NEON, PsyEnergyHbdTest,
+    ::testing::Combine(::testing::ValuesIn(kPsyBlockSizes),
+                       ::testing::Values(svt_psy_ac_energy_hbd_neon)));
+#endif  // ARCH_AARCH64
+}  // namespace
@@ -18,6 +18,8 @@
  * @author Cidana-Edmond, Cidana-Ryan, Cidana-Wenyao
  *
  ******************************************************************************/
+#include <vector>
+
 #include "EbSvtAv1Enc.h"
 #include "gtest/gtest.h"
 #include "SvtAv1EncApiTest.h"
@@ -100,6 +102,14 @@ TEST(EncApiTest, check_null_pointer) {
     // return value, just feed nullptr as parameter. release output buffer with
     // null pointer
     svt_av1_enc_release_out_buffer(nullptr);
+    // borrow a zero-copy input picture with null pointer
+    EXPECT_EQ(EB_ErrorBadParameter,
+              svt_av1_enc_get_input_buffer(nullptr, nullptr));
+    EXPECT_EQ(EB_ErrorBadParameter,
+              svt_av1_enc_set_input_release_cb(nullptr, nullptr, nullptr));
+    // estimate memory with null pointer
+    EXPECT_EQ(EB_ErrorBadParameter,
+              svt_av1_enc_estimate_memory(nullptr, nullptr));
     // close encoder with null pointer
     EXPECT_EQ(EB_ErrorBadParameter, svt_av1_enc_deinit(nullptr));
     // destory encoder handle with null pointer
@@ -107,6 +117,345 @@ TEST(EncApiTest, check_null_pointer) {
     SUCCEED();
 }
 
+/** @brief check_memory_estimate is a api test case
+ * EncApiTest.check_memory_estimate is a api test case for the pre-init memory
+ * estimator
+ *
+ * Test strategy: <br>
+ * Estimate the memory of a default configuration at two resolutions, then
+ * initialize an encoder with it and read back the memory it allocated.
+ *
+ * Expected result: <br>
+ * The categories add up to the total, the larger resolution needs more
+ * memory for every picture sized category, and every category of the
+ * estimate is within 2% of the memory of the initialized encoder.
+ *
+ * Test coverage:
+ * svt_av1_enc_estimate_memory, svt_av1_enc_get_stream_info with
+ * SVT_AV1_STREAM_INFO_MEMORY_USAGE.
+ */
+TEST(EncApiTest, check_memory_estimate) {
+    SvtAv1MemoryUsage usage[2];
+    const int widths[2] = {352, 1280};
+    const int heights[2] = {288, 720};
+    for (int i = 0; i < 2; ++i) {
+        SvtAv1Context context;
+        memset(&context, 0, sizeof(context));
+
+        ASSERT_EQ(EB_ErrorNone,
+                  svt_av1_enc_init_handle(
+                      &context.enc_handle, &context, &context.enc_params))
+            << "svt_av1_enc_init_handle failed";
+        context.enc_params.source_width = widths[i];
+        context.enc_params.source_height = heights[i];
+        ASSERT_EQ(EB_ErrorNone,
+                  svt_av1_enc_estimate_memory(&context.enc_params, &usage[i]))
+            << "svt_av1_enc_estimate_memory failed";
+        uint64_t total = 0;
+        for (int c = 0; c < SVT_AV1_MEM_CATEGORIES; ++c)
+            total += usage[i].category[c];
+        EXPECT_EQ(total, usage[i].total);
+
+        ASSERT_EQ(EB_ErrorNone,
+                  svt_av1_enc_set_parameter(context.enc_handle,
+                                            &context.enc_params))
+            << "svt_av1_enc_set_parameter failed";
+        ASSERT_EQ(EB_ErrorNone, svt_av1_enc_init(context.enc_handle))
+            << "svt_av1_enc_init failed";
+        SvtAv1MemoryUsage allocated;
+        svt_av1_enc_get_stream_info(context.enc_handle,
+                                    SVT_AV1_STREAM_INFO_MEMORY_USAGE,
+                                    &allocated);
+        for (int c = 0; c < SVT_AV1_MEM_CATEGORIES; ++c)
+            EXPECT_NEAR((double)usage[i].category[c],
+                        (double)allocated.category[c],
+                        allocated.category[c] / 50.0)
+                << "category " << c << " at " << widths[i] << "x"
+                << heights[i];
+        EXPECT_NEAR((double)usage[i].total,
+                    (double)allocated.total,
+                    allocated.total / 50.0);
+
+        EXPECT_EQ(EB_ErrorNone, svt_av1_enc_deinit(context.enc_handle))
+            << "svt_av1_enc_deinit failed";
+        EXPECT_EQ(EB_ErrorNone, svt_av1_enc_deinit_handle(context.enc_handle))
+            << "svt_av1_enc_deinit_handle failed";
+    }
+    EXPECT_GT(usage[1].category[SVT_AV1_MEM_PICTURES],
+              usage[0].category[SVT_AV1_MEM_PICTURES]);
+    EXPECT_GT(usage[1].category[SVT_AV1_MEM_REFERENCES],
+              usage[0].category[SVT_AV1_MEM_REFERENCES]);
+    EXPECT_GT(usage[1].category[SVT_AV1_MEM_LOOKAHEAD],
+              usage[0].category[SVT_AV1_MEM_LOOKAHEAD]);
+}
+
+/** @brief check_memory_budget is a api test case
+ * EncApiTest.check_memory_budget is a api test case for max_memory_mb
+ *
+ * Test strategy: <br>
+ * Estimate the memory of a 720p configuration at the highest level of
+ * parallelism, and with a budget no configuration can meet to get the
+ * smallest one. Estimate it again with a budget half way between the two,
+ * then initialize an encoder with that budget.
+ *
+ * Expected result: <br>
+ * The budget lowers the estimate, and both the estimate and the memory the
+ * encoder allocates are within the budget. The unreachable budget still
+ * succeeds.
+ *
+ * Test coverage:
+ * svt_av1_enc_estimate_memory with max_memory_mb, svt_av1_enc_init with
+ * max_memory_mb.
+ */
+TEST(EncApiTest, check_memory_budget) {
+    SvtAv1Context context;
+    memset(&context, 0, sizeof(context));
+
+    ASSERT_EQ(EB_ErrorNone,
+              svt_av1_enc_init_handle(
+                  &context.enc_handle, &context, &context.enc_params))
+        << "svt_av1_enc_init_handle failed";
+
+    EbSvtAv1EncConfiguration config = context.enc_params;
+    config.source_width = 1280;
+    config.source_height = 720;
+    config.level_of_parallelism = 6;
+    SvtAv1MemoryUsage full, fitted, smallest;
+    ASSERT_EQ(EB_ErrorNone, svt_av1_enc_estimate_memory(&config, &full));
+    config.max_memory_mb = 1;
+    ASSERT_EQ(EB_ErrorNone, svt_av1_enc_estimate_memory(&config, &smallest));
+    EXPECT_LT(smallest.total, full.total);
+    config.max_memory_mb = (uint32_t)((smallest.total + full.total) >> 21);
+    const uint64_t budget = (uint64_t)config.max_memory_mb << 20;
+    ASSERT_EQ(EB_ErrorNone, svt_av1_enc_estimate_memory(&config, &fitted));
+    EXPECT_LT(fitted.total, full.total);
+    EXPECT_LE(fitted.total, budget);
+    EXPECT_LE(smallest.total, fitted.total);
+
+    context.enc_params = config;
+    ASSERT_EQ(EB_ErrorNone,
+              svt_av1_enc_set_parameter(context.enc_handle,
+                                        &context.enc_params))
+        << "svt_av1_enc_set_parameter failed";
+    ASSERT_EQ(EB_ErrorNone, svt_av1_enc_init(context.enc_handle))
+        << "svt_av1_enc_init failed";
+    SvtAv1MemoryUsage allocated;
+    svt_av1_enc_get_stream_info(
+        context.enc_handle, SVT_AV1_STREAM_INFO_MEMORY_USAGE, &allocated);
+    EXPECT_LE(allocated.total, budget);
+
+    EXPECT_EQ(EB_ErrorNone, svt_av1_enc_deinit(context.enc_handle))
+        << "svt_av1_enc_deinit failed";
+    EXPECT_EQ(EB_ErrorNone, svt_av1_enc_deinit_handle(context.enc_handle))
+        << "svt_av1_enc_deinit_handle failed";
+}
+
+static int zero_copy_release(EbExtFrameBuf *frame_buf, void *private_data) {
+    (void)frame_buf;
+    ++*(int *)private_data;
+    return 0;
+}
+
+static uint8_t test_sample(int frame, int plane, int x, int y) {
+    return (uint8_t)(frame * 7 + plane * 50 + ((x * 3) ^ (y * 5)));
+}
+
+/* Encodes a few synthetic frames, either from the caller's planes with
+ * different cb and cr strides or from borrowed encoder buffers, and returns
+ * the recon and the bitstream. configure, when given, adjusts the default
+ * parameters. */
+static void encode_synthetic(
+    bool zero_copy, std::vector<uint8_t> &recon, std::vector<uint8_t> &stream,
+    int &released, void (*configure)(EbSvtAv1EncConfiguration *) = nullptr) {
+    const int width = 176, height = 144, frames = 3;
+    const int chroma_w = width / 2, chroma_h = height / 2;
+    const size_t frame_size = width * height + 2 * chroma_w * chroma_h;
+    SvtAv1Context context;
+    memset(&context, 0, sizeof(context));
+
+    ASSERT_EQ(EB_ErrorNone,
+              svt_av1_enc_init_handle(
+                  &context.enc_handle, &context, &context.enc_params));
+    context.enc_params.source_width = width;
+    context.enc_params.source_height = height;
+    context.enc_params.enc_mode = MAX_ENC_PRESET;
+    context.enc_params.encoder_bit_depth = 8;
+    context.enc_params.recon_enabled = 1;
+    if (configure)
+        configure(&context.enc_params);
+    ASSERT_EQ(EB_ErrorNone,
+              svt_av1_enc_set_parameter(context.enc_handle,
+                                        &context.enc_params));
+    ASSERT_EQ(EB_ErrorNone, svt_av1_enc_init(context.enc_handle));
+    released = 0;
+    if (zero_copy)
+        ASSERT_EQ(EB_ErrorNone,
+                  svt_av1_enc_set_input_release_cb(
+                      context.enc_handle, zero_copy_release, &released));
+
+    // caller planes, cr is given a larger stride than cb
+    const int strides[3] = {width + 16, chroma_w + 8, chroma_w + 40};
+    std::vector<uint8_t> planes[3];
+    for (int p = 0; p < 3; ++p)
+        planes[p].resize(strides[p] * (p ? chroma_h : height));
+
+    for (int f = 0; f < frames; ++f) {
+        EbBufferHeaderType own_hdr;
+        EbSvtIOFormat own_io;
+        EbBufferHeaderType *hdr = &own_hdr;
+        EbSvtIOFormat *io = &own_io;
+        if (zero_copy) {
+            ASSERT_EQ(EB_ErrorNone,
+                      svt_av1_enc_get_input_buffer(context.enc_handle, &hdr));
+            io = (EbSvtIOFormat *)hdr->p_buffer;
+        } else {
+            memset(&own_hdr, 0, sizeof(own_hdr));
+            memset(&own_io, 0, sizeof(own_io));
+            own_hdr.size = sizeof(own_hdr);
+            own_hdr.p_buffer = (uint8_t *)&own_io;
+            own_hdr.n_alloc_len = own_hdr.n_filled_len = (uint32_t)frame_size;
+            own_hdr.pic_type = EB_AV1_INVALID_PICTURE;
+            own_io.luma = planes[0].data();
+            own_io.cb = planes[1].data();
+            own_io.cr = planes[2].data();
+            own_io.y_stride = strides[0];
+            own_io.cb_stride = strides[1];
+            own_io.cr_stride = strides[2];
+        }
+        uint8_t *dst[3] = {io->luma, io->cb, io->cr};
+        const uint32_t dst_stride[3] = {
+            io->y_stride, io->cb_stride, io->cr_stride};
+        for (int p = 0; p < 3; ++p)
+            for (int y = 0; y < (p ? chroma_h : height); ++y)
+                for (int x = 0; x < (p ? chroma_w : width); ++x)
+                    dst[p][y * dst_stride[p] + x] = test_sample(f, p, x, y);
+        hdr->pts = f;
+        hdr->flags = 0;
+        ASSERT_EQ(EB_ErrorNone,
+                  svt_av1_enc_send_picture(context.enc_handle, hdr));
+    }
+    // a picture borrowed but never sent is given back at deinit
+    if (zero_copy) {
+        EbBufferHeaderType *unsent = nullptr;
+        ASSERT_EQ(EB_ErrorNone,
+                  svt_av1_enc_get_input_buffer(context.enc_handle, &unsent));
+    }
+    EbBufferHeaderType eos;
+    memset(&eos, 0, sizeof(eos));
+    eos.flags = EB_BUFFERFLAG_EOS;
+    ASSERT_EQ(EB_ErrorNone, svt_av1_enc_send_picture(context.enc_handle, &eos));
+
+    std::vector<uint8_t> recon_frame(frame_size);
+    bool done = false;
+    while (!done) {
+        EbBufferHeaderType *pkt = nullptr;
+        ASSERT_EQ(EB_ErrorNone,
+                  svt_av1_enc_get_packet(context.enc_handle, &pkt, 1));
+        stream.insert(stream.end(), pkt->p_buffer,
+                      pkt->p_buffer + pkt->n_filled_len);
+        done = (pkt->flags & EB_BUFFERFLAG_EOS) != 0;
+        svt_av1_enc_release_out_buffer(&pkt);
+
+        EbBufferHeaderType recon_hdr;
+        memset(&recon_hdr, 0, sizeof(recon_hdr));
+        recon_hdr.size = sizeof(recon_hdr);
+        recon_hdr.p_buffer = recon_frame.data();
+        recon_hdr.n_alloc_len = (uint32_t)frame_size;
+        while (svt_av1_get_recon(context.enc_handle, &recon_hdr) ==
+               EB_ErrorNone) {
+            if (recon_hdr.flags & EB_BUFFERFLAG_EOS)
+                break;
+            // the recon has to stay close to the source of its picture
+            ASSERT_EQ(recon_hdr.n_filled_len, frame_size);
+            uint64_t sad = 0;
+            const uint8_t *r = recon_frame.data();
+            for (int p = 0; p < 3; ++p)
+                for (int y = 0; y < (p ? chroma_h : height); ++y)
+                    for (int x = 0; x < (p ? chroma_w : width); ++x, ++r)
+                        sad += abs(*r - test_sample((int)recon_hdr.pts, p, x, y));
+            EXPECT_LT(sad, frame_size * 8) << "pts " << recon_hdr.pts;
+            recon.insert(recon.end(),
+                         recon_frame.begin(),
+                         recon_frame.begin() + recon_hdr.n_filled_len);
+        }
+    }
+    EXPECT_EQ(EB_ErrorNone, svt_av1_enc_deinit(context.enc_handle));
+    EXPECT_EQ(EB_ErrorNone, svt_av1_enc_deinit_handle(context.enc_handle));
+}
+
+/** @brief check_zero_copy_input is a api test case
+ * EncApiTest.check_zero_copy_input is a functional test of the zero-copy
+ * input
+ *
+ * Test strategy: <br>
+ * Encode the same frames once from caller planes whose cb and cr strides
+ * differ and once from borrowed encoder buffers.
+ *
+ * Expected result: <br>
+ * Both encodes give the same recon, close to the source, and the same
+ * bitstream. Every sent borrowed picture is reported back through the release
+ * callback, the one never sent is returned at deinit.
+ *
+ * Test coverage:
+ * svt_av1_enc_get_input_buffer, svt_av1_enc_set_input_release_cb.
+ */
+TEST(EncApiTest, check_zero_copy_input) {
+    std::vector<uint8_t> ref_recon, ref_stream, zc_recon, zc_stream;
+    int released;
+    encode_synthetic(false, ref_recon, ref_stream, released);
+    encode_synthetic(true, zc_recon, zc_stream, released);
+    ASSERT_FALSE(ref_recon.empty());
+    EXPECT_EQ(ref_recon, zc_recon);
+    EXPECT_EQ(ref_stream, zc_stream);
+    EXPECT_EQ(released, 3);
+}
+
+// per SB qindex from variance boost and TPL, with TPL based SB lambdas
+static void configure_sb_delta_q(EbSvtAv1EncConfiguration *cfg,
+                                 uint32_t logical_processors) {
+    cfg->enc_mode = 8;
+    cfg->enable_variance_boost = 1;
+    cfg->enable_adaptive_quantization = 2;
+    cfg->logical_processors = logical_processors;
+}
+
+static void configure_one_band(EbSvtAv1EncConfiguration *cfg) {
+    configure_sb_delta_q(cfg, 1);
+}
+
+static void configure_sb_bands(EbSvtAv1EncConfiguration *cfg) {
+    configure_sb_delta_q(cfg, 8);
+}
+
+/** @brief check_rc_sb_bands is a api test case
+ * EncApiTest.check_rc_sb_bands checks that splitting the SB qindex
+ * derivation of rate control into bands of SB rows does not change it
+ *
+ * Test strategy: <br>
+ * Encode the same frames with per SB delta q on 1 logical processor, where
+ * rate control derives the SB qindex and lambda values in one band, and on 8,
+ * where the SB rows are split over several bands when the machine has at
+ * least 3 cores.
+ *
+ * Expected result: <br>
+ * Both encodes give the same recon and the same bitstream, which carries the
+ * SB qindex values and depends on the SB lambdas.
+ *
+ * Test coverage:
+ * Rate control SB workers.
+ */
+TEST(EncApiTest, check_rc_sb_bands) {
+    std::vector<uint8_t> one_recon, one_stream, bands_recon, bands_stream;
+    int released;
+    encode_synthetic(
+        false, one_recon, one_stream, released, configure_one_band);
+    encode_synthetic(
+        false, bands_recon, bands_stream, released, configure_sb_bands);
+    ASSERT_FALSE(one_stream.empty());
+    EXPECT_EQ(one_recon, bands_recon);
+    EXPECT_EQ(one_stream, bands_stream);
+}
+
 /** @brief check_normal_setup is a api test case
  * EncApiTest.check_normal_setup is a api test case with a normal setup
  * parameters into api functions and expect report for return EB_ErrorNone
@@ -20,6 +20,8 @@
  * - svt_aom_compute_subd_mean_of_squared_values8x8_sse2_intrin
  * - compute_mean8x8_avx2_intrin
  * - svt_compute_interm_var_four8x8_avx2_intrin
+ * - svt_compute_mean_8x8_64x64_avx2
+ * - svt_compute_mean_8x8_64x64_neon
  *
  * @author Cidana-Edmond,Cidana-Ivy
  *
@@ -57,6 +59,7 @@ namespace {
 
 using svt_av1_test_tool::SVTRandom;
 
+#if ARCH_X86_64
 static const int block_size = 8 * 8;
 static const int test_times = 10000;
 static const std::string test_name[2] = {"Noraml Test:\n", "Boundary Test:\n"};
@@ -277,5 +280,86 @@ TEST(ComputeMeanTest, compute_interm_var_four8x8_avx2) {
 TEST(ComputeMeanTest, compute_interm_var_four8x8_sse2) {
     test_mach(svt_compute_interm_var_four8x8_helper_sse2);
 }
+#endif  // ARCH_X86_64
+
+typedef void (*test_compute_mean_8x8_64x64_type)(
+    uint8_t* input_samples, uint32_t input_stride, Bool subsample,
+    uint64_t* mean_of8x8_blocks, uint64_t* mean_of_squared8x8_blocks);
+
+static void test_mean_8x8_64x64(
+    test_compute_mean_8x8_64x64_type compute_mean_8x8_64x64) {
+    SVTRandom rnd[2] = {
+        SVTRandom(8, false),  /**< random generator of normal test vector */
+        SVTRandom(0xE0, 0xFF) /**< random generator of boundary test vector */
+    };
+    const uint32_t stride = 64 + 16;
+    uint8_t input_data[64 * (64 + 16)];
+
+    for (int i = 0; i < 2; i++) {
+        for (int t = 0; t < 100; t++) {
+            for (size_t j = 0; j < sizeof(input_data); j++)
+                input_data[j] = (uint8_t)rnd[i].random();
+
+            for (int subsample = 0; subsample < 2; subsample++) {
+                // reference: the per 8x8 kernels used before fusing
+                uint64_t output_ref[64], output_squared_ref[64];
+                for (int b = 0; b < 64; b++) {
+                    uint8_t* src =
+                        input_data + (b >> 3) * 8 * stride + (b & 7) * 8;
+                    output_ref[b] =
+                        subsample ? svt_compute_sub_mean_8x8_c(src, stride)
+                                  : svt_compute_mean_c(src, stride, 8, 8);
+                    output_squared_ref[b] =
+                        subsample ? svt_aom_compute_sub_mean_squared_values_c(
+                                        src, stride, 8, 8)
+                                  : svt_compute_mean_squared_values_c(
+                                        src, stride, 8, 8);
+                }
+
+                uint64_t output_c[64], output_squared_c[64];
+                uint64_t output_tst[64], output_squared_tst[64];
+                svt_compute_mean_8x8_64x64_c(input_data,
+                                             stride,
+                                             (Bool)subsample,
+                                             output_c,
+                                             output_squared_c);
+                compute_mean_8x8_64x64(input_data,
+                                       stride,
+                                       (Bool)subsample,
+                                       output_tst,
+                                       output_squared_tst);
+
+                ASSERT_EQ(0, memcmp(output_c, output_ref, sizeof(output_ref)))
+                    << "C mean of 8x8 blocks error, subsample " << subsample;
+                ASSERT_EQ(0,
+                          memcmp(output_squared_c,
+                                 output_squared_ref,
+                                 sizeof(output_squared_ref)))
+                    << "C mean of 8x8 squared blocks error, subsample "
+                    << subsample;
+                ASSERT_EQ(0, memcmp(output_tst, output_c, sizeof(output_c)))
+                    << "mean of 8x8 blocks error, subsample " << subsample;
+                ASSERT_EQ(0,
+                          memcmp(output_squared_tst,
+                                 output_squared_c,
+                                 sizeof(output_squared_c)))
+                    << "mean of 8x8 squared blocks error, subsample "
+                    << subsample;
+            }
+        }
+    }
+}
+
+#if ARCH_X86_64
+TEST(ComputeMeanTest, compute_mean_8x8_64x64_avx2) {
+    test_mean_8x8_64x64(svt_compute_mean_8x8_64x64_avx2);
+}
+#endif  // ARCH_X86_64
+
+#if ARCH_AARCH64
+TEST(ComputeMeanTest, compute_mean_8x8_64x64_neon) {
+    test_mean_8x8_64x64(svt_compute_mean_8x8_64x64_neon);
+}
+#endif  // ARCH_AARCH64
 
 }  // namespace
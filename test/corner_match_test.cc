@@ -19,6 +19,9 @@
 #include "unit_test_utility.h"
 #include "acm_random.h"
 #include "corner_match.h"
+extern "C" {
+#include "fast.h"
+}
 
 #define MATCH_SZ 13
 #define MATCH_SZ_BY2 ((MATCH_SZ - 1) / 2)
@@ -148,6 +151,8 @@ void AV1CornerMatchTest::RunCheckOutput(int run_times) {
     delete[] input2;
 }
 
+GTEST_ALLOW_UNINSTANTIATED_PARAMETERIZED_TEST(AV1CornerMatchTest);
+
 TEST_P(AV1CornerMatchTest, CheckOutput) {
     RunCheckOutput(1);
 }
@@ -155,11 +160,157 @@ TEST_P(AV1CornerMatchTest, DISABLED_Speed) {
     RunCheckOutput(1000);
 }
 
+#ifdef ARCH_X86_64
 INSTANTIATE_TEST_SUITE_P(
     AV1CornerMatchTest, AV1CornerMatchTest,
     ::testing::Values(make_tuple(0, &svt_av1_compute_cross_correlation_sse4_1),
                       make_tuple(1, &svt_av1_compute_cross_correlation_sse4_1),
                       make_tuple(0, &svt_av1_compute_cross_correlation_avx2),
                       make_tuple(1, &svt_av1_compute_cross_correlation_avx2)));
+#endif  // ARCH_X86_64
+
+typedef void (*Fast9ScoreFunc)(const uint8_t *im, int stride,
+                               const int *corners_xy, int num_corners, int b,
+                               int *scores);
+typedef tuple<int, Fast9ScoreFunc> Fast9ScoreParam;
+
+#define FAST_BARRIER 18
+
+/**
+ * @brief Unit test for svt_av1_fast9_score:
+ * Score the corners found by the fastfeat detector and random (mostly
+ * non-corner) positions, and check that both the closed form C version and
+ * the SIMD version match the binary search of svt_aom_fast9_score.
+ * Mode 0 uses random noise, mode 1 uses flat blocks with mild noise.
+ */
+class AV1Fast9ScoreTest : public ::testing::TestWithParam<Fast9ScoreParam> {
+  public:
+    virtual void SetUp() {
+        rnd_.Reset(ACMRandom::DeterministicSeed());
+        target_func_ = TEST_GET_PARAM(1);
+    }
+
+  protected:
+    void prepare_image(uint8_t *img, int w, int h) {
+        if (TEST_GET_PARAM(0) == 0) {
+            for (int i = 0; i < w * h; ++i) img[i] = rnd_.Rand8();
+        } else {
+            for (int i = 0; i < h; i += 8)
+                for (int j = 0; j < w; j += 8) {
+                    const int v = rnd_.Rand8();
+                    for (int y = i; y < i + 8; ++y)
+                        for (int x = j; x < j + 8; ++x)
+                            img[y * w + x] =
+                                clip_pixel(v + (rnd_.Rand8() & 7) - 4);
+                }
+        }
+    }
+
+    static uint8_t clip_pixel(int v) {
+        return (uint8_t)(v < 0 ? 0 : v > 255 ? 255 : v);
+    }
+
+    void RunCheckOutput(int run_times) {
+        const int w = 128, h = 128;
+        const int num_random = 1000;
+        uint8_t *img = new uint8_t[w * h];
+        prepare_image(img, w, h);
+
+        int num_detected = 0;
+        xy *detected =
+            svt_aom_fast9_detect(img, w, h, w, FAST_BARRIER, &num_detected);
+        const int num_corners = num_detected + num_random;
+        int *corners = new int[2 * num_corners];
+        for (int i = 0; i < num_detected; ++i) {
+            corners[2 * i] = detected[i].x;
+            corners[2 * i + 1] = detected[i].y;
+        }
+        for (int i = num_detected; i < num_corners; ++i) {
+            corners[2 * i] = 3 + rnd_.PseudoUniform(w - 6);
+            corners[2 * i + 1] = 3 + rnd_.PseudoUniform(h - 6);
+        }
+        free(detected);
+
+        int *ref = svt_aom_fast9_score(
+            img, w, (xy *)corners, num_corners, FAST_BARRIER);
+        int *scores_c = new int[num_corners];
+        int *scores_simd = new int[num_corners];
+        svt_av1_fast9_score_c(
+            img, w, corners, num_corners, FAST_BARRIER, scores_c);
+        target_func_(img, w, corners, num_corners, FAST_BARRIER, scores_simd);
+        for (int i = 0; i < num_corners; ++i) {
+            ASSERT_EQ(scores_c[i], ref[i]) << "corner " << i;
+            ASSERT_EQ(scores_simd[i], ref[i]) << "corner " << i;
+        }
+
+        if (run_times > 1) {
+            uint64_t start_time_seconds, start_time_useconds;
+            uint64_t middle_time_seconds, middle_time_useconds;
+            uint64_t finish_time_seconds, finish_time_useconds;
+
+            svt_av1_get_time(&start_time_seconds, &start_time_useconds);
+            for (int j = 0; j < run_times; j++)
+                free(svt_aom_fast9_score(
+                    img, w, (xy *)corners, num_corners, FAST_BARRIER));
+            svt_av1_get_time(&middle_time_seconds, &middle_time_useconds);
+            for (int j = 0; j < run_times; j++)
+                target_func_(
+                    img, w, corners, num_corners, FAST_BARRIER, scores_simd);
+            svt_av1_get_time(&finish_time_seconds, &finish_time_useconds);
+
+            const double time_c = svt_av1_compute_overall_elapsed_time_ms(
+                start_time_seconds,
+                start_time_useconds,
+                middle_time_seconds,
+                middle_time_useconds);
+            const double time_o = svt_av1_compute_overall_elapsed_time_ms(
+                middle_time_seconds,
+                middle_time_useconds,
+                finish_time_seconds,
+                finish_time_useconds);
+            printf("Average Nanoseconds per Corner (%d corners)\n",
+                   num_corners);
+            printf("    svt_aom_fast9_score : %6.2f\n",
+                   1000000 * time_c / run_times / num_corners);
+            printf(
+                "    svt_av1_fast9_score (SIMD) : %6.2f   (Comparison: "
+                "%5.2fx)\n",
+                1000000 * time_o / run_times / num_corners,
+                time_c / time_o);
+        }
+
+        free(ref);
+        delete[] scores_c;
+        delete[] scores_simd;
+        delete[] corners;
+        delete[] img;
+    }
+
+    Fast9ScoreFunc target_func_;
+    libaom_test::ACMRandom rnd_;
+};
+
+GTEST_ALLOW_UNINSTANTIATED_PARAMETERIZED_TEST(AV1Fast9ScoreTest);
+
+TEST_P(AV1Fast9ScoreTest, CheckOutput) {
+    RunCheckOutput(1);
+}
+TEST_P(AV1Fast9ScoreTest, DISABLED_Speed) {
+    RunCheckOutput(1000);
+}
+
+#ifdef ARCH_X86_64
+INSTANTIATE_TEST_SUITE_P(
+    AVX2, AV1Fast9ScoreTest,
+    ::testing::Values(make_tuple(0, &svt_av1_fast9_score_avx2),
+                      make_tuple(1, &svt_av1_fast9_score_avx2)));
+#endif  // ARCH_X86_64
+
+#ifdef ARCH_AARCH64
+INSTANTIATE_TEST_SUITE_P(
+    NEON, AV1Fast9ScoreTest,
+    ::testing::Values(make_tuple(0, &svt_av1_fast9_score_neon),
+                      make_tuple(1, &svt_av1_fast9_score_neon)));
+#endif  // ARCH_AARCH64
 
 }  // namespace
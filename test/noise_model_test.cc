@@ -33,6 +33,7 @@ void rand_float_array(float *buf, int32_t size, SVTRandom *rnd_float) {
     }
 }
 
+#if ARCH_X86_64
 void rand_u8_array(uint8_t *buf, int32_t size, SVTRandom *rnd) {
     for (int32_t i = 0; i < size; i++) {
         buf[i] = rnd->random();
@@ -44,8 +45,17 @@ void rand_u16_array(uint16_t *buf, int32_t size, SVTRandom *rnd) {
         buf[i] = rnd->random();
     }
 }
+#endif  // ARCH_X86_64
 
-TEST(fg_add_block_observations_internal, AVX2) {
+typedef void (*AddBlockObservationsFunc)(uint32_t n, const double val,
+                                         const double recp_sqr_norm,
+                                         double *buffer, double *buffer_norm,
+                                         double *b, double *A);
+
+class FgAddBlockObservationsTest
+    : public ::testing::TestWithParam<AddBlockObservationsFunc> {};
+
+TEST_P(FgAddBlockObservationsTest, MatchC) {
     SVTRandom rnd_float(-10.0f, 10.0f);
 
     // only input
@@ -77,7 +87,7 @@ TEST(fg_add_block_observations_internal, AVX2) {
 
         svt_av1_add_block_observations_internal_c(
             n, val, recp_sqr, buffer, buffer_norm_ref, b_buff_ref, a_buff_ref);
-        svt_av1_add_block_observations_internal_avx2(
+        GetParam()(
             n, val, recp_sqr, buffer, buffer_norm_mod, b_buff_mod, a_buff_mod);
 
         // compare results
@@ -109,7 +119,13 @@ TEST(fg_add_block_observations_internal, AVX2) {
     delete[] a_buff_mod;
 }
 
-TEST(fg_pointwise_multiply, AVX2) {
+typedef void (*PointwiseMultiplyFunc)(const float *a, float *b, float *c,
+                                      double *b_d, double *c_d, int32_t n);
+
+class FgPointwiseMultiplyTest
+    : public ::testing::TestWithParam<PointwiseMultiplyFunc> {};
+
+TEST_P(FgPointwiseMultiplyTest, MatchC) {
     SVTRandom rnd_float(-10.0f, 10.0f);
 
     // only input
@@ -137,7 +153,7 @@ TEST(fg_pointwise_multiply, AVX2) {
 
         svt_av1_pointwise_multiply_c(
             a_buff, b_buff_ref, c_buff_ref, b_d_buff, c_d_buff, n);
-        svt_av1_pointwise_multiply_avx2(
+        GetParam()(
             a_buff, b_buff_mod, c_buff_mod, b_d_buff, c_d_buff, n);
 
         // compare results
@@ -160,7 +176,15 @@ TEST(fg_pointwise_multiply, AVX2) {
     delete[] c_buff_mod;
 }
 
-TEST(fg_apply_window_to_plane, AVX2) {
+typedef void (*ApplyWindowFunc)(int32_t y_size, int32_t x_size,
+                                float *result_ptr, uint32_t result_stride,
+                                float *block, float *plane,
+                                const float *window_function);
+
+class FgApplyWindowToPlaneTest
+    : public ::testing::TestWithParam<ApplyWindowFunc> {};
+
+TEST_P(FgApplyWindowToPlaneTest, MatchC) {
     SVTRandom rnd_float(-10.0f, 10.0f);
 
     // only input
@@ -184,7 +208,7 @@ TEST(fg_apply_window_to_plane, AVX2) {
 
         svt_av1_apply_window_function_to_plane_c(
             MAX_SIZE, n, out_ref, MAX_SIZE, block, plane, window);
-        svt_av1_apply_window_function_to_plane_avx2(
+        GetParam()(
             MAX_SIZE, n, out_mod, MAX_SIZE, block, plane, window);
 
         // compare results
@@ -202,6 +226,7 @@ TEST(fg_apply_window_to_plane, AVX2) {
     delete[] out_mod;
 }
 
+#if ARCH_X86_64
 TEST(fg_noise_tx_filter, AVX2) {
     SVTRandom rnd_float(-10.0f, 10.0f);
 
@@ -398,4 +423,74 @@ TEST(fg_flat_block_finder_extract_block, hbd_AVX2) {
     delete block_finder;
 }
 
+#endif  // ARCH_X86_64
+
+typedef void (*BlockStatsFunc)(const double *blocks, int32_t block_size,
+                               int32_t num_blocks, double *stats);
+
+class FgFlatBlockFinderBlockStatsTest
+    : public ::testing::TestWithParam<BlockStatsFunc> {};
+
+TEST_P(FgFlatBlockFinderBlockStatsTest, MatchC) {
+    SVTRandom rnd_float(-10.0f, 10.0f);
+    const int32_t block_sizes[] = {8, 16, 32};
+    double *blocks = new double[FLAT_BLOCK_STATS_BATCH * 32 * 32];
+    double stats_ref[5 * FLAT_BLOCK_STATS_BATCH];
+    double stats_mod[5 * FLAT_BLOCK_STATS_BATCH];
+
+    for (int i = 0; i < test_time; i++) {
+        const int32_t block_size = block_sizes[i % 3];
+        // partial batches take the C path
+        const int32_t num_blocks = i < 3 ? 1 + i : FLAT_BLOCK_STATS_BATCH;
+        rand_double_array(
+            blocks, FLAT_BLOCK_STATS_BATCH * block_size * block_size, &rnd_float);
+        memset(stats_ref, 0, sizeof(stats_ref));
+        memset(stats_mod, 0, sizeof(stats_mod));
+
+        svt_aom_flat_block_finder_block_stats_c(
+            blocks, block_size, num_blocks, stats_ref);
+        GetParam()(blocks, block_size, num_blocks, stats_mod);
+
+        ASSERT_EQ(0, memcmp(stats_ref, stats_mod, sizeof(stats_ref)))
+            << "test"
+            << "[" << i << "] "
+            << "flat_block_finder_block_stats mismatch !\n ";
+    }
+
+    delete[] blocks;
+}
+
+GTEST_ALLOW_UNINSTANTIATED_PARAMETERIZED_TEST(FgAddBlockObservationsTest);
+GTEST_ALLOW_UNINSTANTIATED_PARAMETERIZED_TEST(FgPointwiseMultiplyTest);
+GTEST_ALLOW_UNINSTANTIATED_PARAMETERIZED_TEST(FgApplyWindowToPlaneTest);
+GTEST_ALLOW_UNINSTANTIATED_PARAMETERIZED_TEST(FgFlatBlockFinderBlockStatsTest);
+
+#if ARCH_X86_64
+INSTANTIATE_TEST_SUITE_P(
+    AVX2, FgAddBlockObservationsTest,
+    ::testing::Values(svt_av1_add_block_observations_internal_avx2));
+INSTANTIATE_TEST_SUITE_P(AVX2, FgPointwiseMultiplyTest,
+                         ::testing::Values(svt_av1_pointwise_multiply_avx2));
+INSTANTIATE_TEST_SUITE_P(
+    AVX2, FgApplyWindowToPlaneTest,
+    ::testing::Values(svt_av1_apply_window_function_to_plane_avx2));
+INSTANTIATE_TEST_SUITE_P(
+    AVX2, FgFlatBlockFinderBlockStatsTest,
+    ::testing::Values(svt_aom_flat_block_finder_block_stats_avx2));
+#endif  // ARCH_X86_64
+
+#if ARCH_AARCH64
+INSTANTIATE_TEST_SUITE_P(
+    NEON, FgAddBlockObservationsTest,
+    ::testing::Values(svt_av1_add_block_observations_internal_neon));
+INSTANTIATE_TEST_SUITE_P(NEON, FgPointwiseMultiplyTest,
+                         ::testing::Values(svt_av1_pointwise_multiply_neon));
+INSTANTIATE_TEST_SUITE_P(
+    NEON, FgApplyWindowToPlaneTest,
+    ::testing::Values(svt_av1_apply_window_function_to_plane_neon));
+INSTANTIATE_TEST_SUITE_P(
+    NEON, FgFlatBlockFinderBlockStatsTest,
+    ::testing::Values(svt_aom_flat_block_finder_block_stats_neon));
+#endif  // ARCH_AARCH64
+
 }  // namespace
@@ -194,6 +194,61 @@ class SsimTest : public ::testing::TestWithParam<SsimTestParam> {
             return;
     }
 
+    // SSIM of an n x n block from the floating point means, variances and
+    // covariance, with the constants (0.01 * L)^2 and (0.03 * L)^2
+    double reference_ssim(const Sample *s, const Sample *r, int n) {
+        const double max_val = (1 << bd_) - 1;
+        const double c1 = (0.01 * max_val) * (0.01 * max_val);
+        const double c2 = (0.03 * max_val) * (0.03 * max_val);
+        const int count = n * n;
+        double mean_s = 0, mean_r = 0;
+        for (int i = 0; i < count; ++i) {
+            mean_s += s[i];
+            mean_r += r[i];
+        }
+        mean_s /= count;
+        mean_r /= count;
+        double var_s = 0, var_r = 0, cov = 0;
+        for (int i = 0; i < count; ++i) {
+            var_s += (s[i] - mean_s) * (s[i] - mean_s);
+            var_r += (r[i] - mean_r) * (r[i] - mean_r);
+            cov += (s[i] - mean_s) * (r[i] - mean_r);
+        }
+        var_s /= count;
+        var_r /= count;
+        cov /= count;
+        return ((2 * mean_s * mean_r + c1) * (2 * cov + c2)) /
+               ((mean_s * mean_s + mean_r * mean_r + c1) *
+                (var_s + var_r + c2));
+    }
+
+    // the integer kernels only differ from the definition by the rounding of
+    // the constants scaled to the block size
+    void check_reference() {
+        double score_ref, score_simd;
+        run_8x8_test(&score_ref, &score_simd);
+        ASSERT_NEAR(reference_ssim(src_8x8_, rec_8x8_, 8), score_simd, 1e-4);
+        run_4x4_test(&score_ref, &score_simd);
+        ASSERT_NEAR(reference_ssim(src_4x4_, rec_4x4_, 4), score_simd, 1e-4);
+    }
+
+    void run_reference_test(const int run_times) {
+        for (int iter = 0; iter < run_times; ++iter) {
+            prepare_random_data();
+            check_reference();
+            if (HasFatalFailure())
+                return;
+        }
+        for (int src_mode = 0; src_mode < 2; ++src_mode)
+            for (int rec_mode = 0; rec_mode < 2; ++rec_mode) {
+                src_mode ? prepare_extreme_src() : prepare_zero_src();
+                rec_mode ? prepare_extreme_rec() : prepare_zero_rec();
+                check_reference();
+                if (HasFatalFailure())
+                    return;
+            }
+    }
+
   protected:
     int32_t bd_;
     Sample *src_8x8_ = nullptr;
@@ -261,8 +316,132 @@ TEST_P(SsimHbdTest, MatchTestWithExtremeValue) {
 TEST_P(SsimHbdTest, MatchTestWithRandomValue) {
     run_random_test(test_times);
 }
+TEST_P(SsimLbdTest, MatchReference) {
+    run_reference_test(test_times);
+}
+TEST_P(SsimHbdTest, MatchReference) {
+    run_reference_test(test_times);
+}
 
 INSTANTIATE_TEST_SUITE_P(SSIM, SsimLbdTest, ::testing::Values(8));
 INSTANTIATE_TEST_SUITE_P(SSIM, SsimHbdTest, ::testing::Values(10));
 
+typedef void (*Ssim4x4SumsFunc)(const uint8_t *s, uint32_t sp, const uint8_t *r,
+                                uint32_t rp, uint32_t count, uint32_t *sums);
+typedef void (*Ssim4x4SumsHbdFunc)(const uint16_t *s, uint32_t sp,
+                                   const uint16_t *r, uint32_t rp,
+                                   uint32_t count, uint32_t *sums);
+
+// A row of 4x4 blocks from a 72 wide buffer: up to 18 blocks, so every count
+// exercises both the vector loop and the scalar tail
+static const uint32_t sums_stride = 72;
+static const uint32_t sums_max_count = sums_stride / 4;
+
+template <typename Sample, typename Func>
+class Ssim4x4SumsTest
+    : public ::testing::TestWithParam<std::tuple<int, Func>> {
+  public:
+    void SetUp() override {
+        bd_ = std::get<0>(this->GetParam());
+        func_ = std::get<1>(this->GetParam());
+        rnd_ = new SVTRandom(0, (1 << bd_) - 1);
+    }
+
+    void TearDown() override {
+        delete rnd_;
+    }
+
+  protected:
+    virtual void run_ref(uint32_t count, uint32_t *sums) = 0;
+
+    void fill(Sample *buf, int mode) {
+        for (uint32_t i = 0; i < 4 * sums_stride; ++i)
+            buf[i] = mode == 0   ? 0
+                     : mode == 1 ? (Sample)((1 << bd_) - 1)
+                                 : (Sample)rnd_->random();
+    }
+
+    void run_test(int src_mode, int rec_mode) {
+        for (uint32_t count = 1; count <= sums_max_count; ++count) {
+            fill(src_, src_mode);
+            fill(rec_, rec_mode);
+            uint32_t sums_ref[4 * sums_max_count];
+            uint32_t sums_tst[4 * sums_max_count];
+            memset(sums_ref, 0xcd, sizeof(sums_ref));
+            memset(sums_tst, 0xcd, sizeof(sums_tst));
+            run_ref(count, sums_ref);
+            func_(src_, sums_stride, rec_, sums_stride, count, sums_tst);
+            ASSERT_EQ(0, memcmp(sums_ref, sums_tst, sizeof(sums_ref)))
+                << "4x4 sums mismatch with count " << count;
+        }
+    }
+
+    void run_all() {
+        for (int i = 0; i < test_times; ++i) {
+            run_test(2, 2);
+            if (this->HasFatalFailure())
+                return;
+        }
+        for (int src_mode = 0; src_mode < 2; ++src_mode)
+            for (int rec_mode = 0; rec_mode < 2; ++rec_mode) {
+                run_test(src_mode, rec_mode);
+                if (this->HasFatalFailure())
+                    return;
+            }
+    }
+
+    int bd_;
+    Func func_;
+    Sample src_[4 * sums_stride];
+    Sample rec_[4 * sums_stride];
+    SVTRandom *rnd_;
+};
+
+class Ssim4x4SumsLbdTest : public Ssim4x4SumsTest<uint8_t, Ssim4x4SumsFunc> {
+  protected:
+    void run_ref(uint32_t count, uint32_t *sums) override {
+        svt_ssim_4x4_sums_c(
+            src_, sums_stride, rec_, sums_stride, count, sums);
+    }
+};
+
+class Ssim4x4SumsHbdTest
+    : public Ssim4x4SumsTest<uint16_t, Ssim4x4SumsHbdFunc> {
+  protected:
+    void run_ref(uint32_t count, uint32_t *sums) override {
+        svt_ssim_4x4_sums_hbd_c(
+            src_, sums_stride, rec_, sums_stride, count, sums);
+    }
+};
+
+GTEST_ALLOW_UNINSTANTIATED_PARAMETERIZED_TEST(Ssim4x4SumsLbdTest);
+GTEST_ALLOW_UNINSTANTIATED_PARAMETERIZED_TEST(Ssim4x4SumsHbdTest);
+
+TEST_P(Ssim4x4SumsLbdTest, MatchTest) {
+    run_all();
+}
+TEST_P(Ssim4x4SumsHbdTest, MatchTest) {
+    run_all();
+}
+
+#ifdef ARCH_X86_64
+INSTANTIATE_TEST_SUITE_P(
+    AVX2, Ssim4x4SumsLbdTest,
+    ::testing::Values(make_tuple(8, &svt_ssim_4x4_sums_avx2)));
+INSTANTIATE_TEST_SUITE_P(
+    AVX2, Ssim4x4SumsHbdTest,
+    ::testing::Values(make_tuple(10, &svt_ssim_4x4_sums_hbd_avx2),
+                      make_tuple(12, &svt_ssim_4x4_sums_hbd_avx2)));
+#endif  // ARCH_X86_64
+
+#ifdef ARCH_AARCH64
+INSTANTIATE_TEST_SUITE_P(
+    NEON, Ssim4x4SumsLbdTest,
+    ::testing::Values(make_tuple(8, &svt_ssim_4x4_sums_neon)));
+INSTANTIATE_TEST_SUITE_P(
+    NEON, Ssim4x4SumsHbdTest,
+    ::testing::Values(make_tuple(10, &svt_ssim_4x4_sums_hbd_neon),
+                      make_tuple(12, &svt_ssim_4x4_sums_hbd_neon)));
+#endif  // ARCH_AARCH64
+
 }  // namespace